@@ -45,6 +45,11 @@ public:
 
   absl::string_view method() const override { return inner_metadata_->request().methodName(); }
 
+  absl::optional<uint64_t> streamId() const override { return inner_metadata_->requestId(); }
+  void setStreamId(uint64_t stream_id) override {
+    inner_metadata_->mutableContext().setRequestId(stream_id);
+  }
+
   Common::Dubbo::MessageMetadataSharedPtr inner_metadata_;
 };
 
@@ -70,6 +75,11 @@ public:
   void setByReferenceKey(absl::string_view, absl::string_view) override {}
   void setByReference(absl::string_view, absl::string_view) override {}
 
+  absl::optional<uint64_t> streamId() const override { return inner_metadata_->requestId(); }
+  void setStreamId(uint64_t stream_id) override {
+    inner_metadata_->mutableContext().setRequestId(stream_id);
+  }
+
   Status status() const override { return status_; }
 
   Status status_;
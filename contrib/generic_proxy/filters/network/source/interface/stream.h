@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -70,6 +71,22 @@ public:
    */
   virtual void setByReference(absl::string_view key, absl::string_view val) PURE;
 
+  /**
+   * Get the stream id of generic stream. The response of a request carries the same stream id, so
+   * that the requests of many downstream connections can share one upstream connection.
+   *
+   * @return The optional stream id. absl::nullopt means the application protocol cannot multiplex
+   * requests on one connection.
+   */
+  virtual absl::optional<uint64_t> streamId() const { return absl::nullopt; }
+
+  /**
+   * Set the stream id of generic stream. Only called if streamId() returns a value.
+   *
+   * @param stream_id The new stream id.
+   */
+  virtual void setStreamId(uint64_t) {}
+
   // Used for matcher.
   static constexpr absl::string_view name() { return "generic_proxy"; }
 };
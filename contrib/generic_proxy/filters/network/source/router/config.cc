@@ -2,6 +2,8 @@
 
 #include "envoy/registry/registry.h"
 
+#include "source/common/protobuf/utility.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -9,10 +11,21 @@ namespace GenericProxy {
 namespace Router {
 
 FilterFactoryCb
-RouterFactory::createFilterFactoryFromProto(const Protobuf::Message&, const std::string&,
+RouterFactory::createFilterFactoryFromProto(const Protobuf::Message& config, const std::string&,
                                             Server::Configuration::FactoryContext& context) {
-  return [&context](FilterChainFactoryCallbacks& callbacks) {
-    callbacks.addDecoderFilter(std::make_shared<RouterFilter>(context));
+  const auto& typed_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::filters::network::generic_proxy::router::v3::Router&>(
+      config, context.messageValidationVisitor());
+
+  MultiplexedUpstreamsSlotSharedPtr multiplexed_upstreams;
+  if (typed_config.multiplexing()) {
+    multiplexed_upstreams = std::make_shared<MultiplexedUpstreamsSlot>(context.threadLocal());
+    multiplexed_upstreams->set(
+        [](Event::Dispatcher&) { return std::make_shared<MultiplexedUpstreams>(); });
+  }
+
+  return [&context, multiplexed_upstreams](FilterChainFactoryCallbacks& callbacks) {
+    callbacks.addDecoderFilter(std::make_shared<RouterFilter>(context, multiplexed_upstreams));
   };
 }
 
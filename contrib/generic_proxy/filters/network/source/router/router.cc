@@ -1,10 +1,13 @@
 #include "contrib/generic_proxy/filters/network/source/router/router.h"
 
+#include <vector>
+
 #include "envoy/common/conn_pool.h"
 #include "envoy/network/connection.h"
 
 #include "source/common/common/assert.h"
 
+#include "absl/strings/str_cat.h"
 #include "contrib/generic_proxy/filters/network/source/interface/filter.h"
 
 namespace Envoy {
@@ -21,10 +24,163 @@ absl::string_view resetReasonToStringView(StreamResetReason reason) {
 }
 } // namespace
 
+MultiplexedUpstream::~MultiplexedUpstream() {
+  if (conn_pool_handle_ != nullptr) {
+    conn_pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+  }
+  if (conn_data_ != nullptr) {
+    conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void MultiplexedUpstream::newStream(UpstreamRequest& upstream_request) {
+  streams_[upstream_request.parent_.upstream_stream_id_] = &upstream_request;
+
+  if (conn_data_ != nullptr) {
+    upstream_request.onMultiplexedUpstreamReady(upstream_host_);
+    return;
+  }
+
+  if (conn_pool_handle_ == nullptr) {
+    ENVOY_LOG(debug, "generic proxy multiplexed upstream: create upstream connection");
+    // All the router filters of the upstream share the same downstream codec.
+    response_decoder_ = upstream_request.parent_.callbacks_->downstreamCodec().responseDecoder();
+    response_decoder_->setDecoderCallback(*this);
+    conn_pool_handle_ = upstream_request.tcp_data_.newConnection(*this);
+  }
+}
+
+void MultiplexedUpstream::write(Buffer::Instance& buffer) {
+  ASSERT(conn_data_);
+  ENVOY_LOG(trace, "proxying {} bytes", buffer.length());
+  conn_data_->connection().write(buffer, false);
+}
+
+void MultiplexedUpstream::resetStreams(StreamResetReason reason) {
+  // Resetting a stream may destroy the router filters of other streams, which remove their streams
+  // from the map. So the streams are removed one by one.
+  while (!streams_.empty()) {
+    auto iter = streams_.begin();
+    UpstreamRequest* upstream_request = iter->second;
+    streams_.erase(iter);
+    upstream_request->onMultiplexedUpstreamReset(reason, upstream_host_);
+  }
+}
+
+void MultiplexedUpstream::closeConnection() {
+  if (conn_data_ != nullptr) {
+    ENVOY_LOG(debug, "generic proxy multiplexed upstream: close upstream connection");
+    auto conn_data = std::move(conn_data_);
+    conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void MultiplexedUpstream::onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                                        absl::string_view,
+                                        Upstream::HostDescriptionConstSharedPtr host) {
+  conn_pool_handle_ = nullptr;
+  upstream_host_ = host;
+
+  resetStreams(reason == ConnectionPool::PoolFailureReason::Overflow
+                   ? StreamResetReason::Overflow
+                   : StreamResetReason::ConnectionFailure);
+}
+
+void MultiplexedUpstream::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
+                                      Upstream::HostDescriptionConstSharedPtr host) {
+  ENVOY_LOG(debug, "generic proxy multiplexed upstream: tcp connection has ready");
+  conn_pool_handle_ = nullptr;
+  upstream_host_ = host;
+
+  conn_data_ = std::move(conn);
+  conn_data_->addUpstreamCallbacks(*this);
+
+  // Writing a request may complete it or destroy the router filters of other streams, so the
+  // streams are looked up again by their stream ids.
+  std::vector<uint64_t> stream_ids;
+  stream_ids.reserve(streams_.size());
+  for (const auto& stream : streams_) {
+    stream_ids.push_back(stream.first);
+  }
+  for (const uint64_t stream_id : stream_ids) {
+    auto iter = streams_.find(stream_id);
+    if (iter != streams_.end()) {
+      iter->second->onMultiplexedUpstreamReady(host);
+    }
+  }
+}
+
+void MultiplexedUpstream::onUpstreamData(Buffer::Instance& data, bool end_stream) {
+  response_decoder_->decode(data);
+
+  if (end_stream) {
+    resetStreams(StreamResetReason::ProtocolError);
+    closeConnection();
+  }
+}
+
+void MultiplexedUpstream::onEvent(Network::ConnectionEvent event) {
+  switch (event) {
+  case Network::ConnectionEvent::LocalClose:
+    conn_data_.reset();
+    resetStreams(StreamResetReason::LocalReset);
+    break;
+  case Network::ConnectionEvent::RemoteClose:
+    conn_data_.reset();
+    resetStreams(StreamResetReason::ConnectionTermination);
+    break;
+  default:
+    break;
+  }
+}
+
+void MultiplexedUpstream::onDecodingSuccess(ResponsePtr response) {
+  const absl::optional<uint64_t> stream_id = response->streamId();
+  if (!stream_id.has_value()) {
+    ENVOY_LOG(debug, "generic proxy multiplexed upstream: response without stream id");
+    onDecodingFailure();
+    return;
+  }
+
+  auto iter = streams_.find(stream_id.value());
+  if (iter == streams_.end()) {
+    // The stream was reset before the response.
+    ENVOY_LOG(debug, "generic proxy multiplexed upstream: drop response of stream {}",
+              stream_id.value());
+    return;
+  }
+
+  UpstreamRequest* upstream_request = iter->second;
+  streams_.erase(iter);
+  upstream_request->onMultiplexedUpstreamResponse(std::move(response));
+}
+
+void MultiplexedUpstream::onDecodingFailure() {
+  resetStreams(StreamResetReason::ProtocolError);
+  closeConnection();
+}
+
+MultiplexedUpstream& MultiplexedUpstreams::upstream(absl::string_view cluster_name,
+                                                    const Upstream::TcpPoolData& tcp_data) {
+  auto& upstream =
+      upstreams_[absl::StrCat(cluster_name, "/", tcp_data.host()->address()->asString())];
+  if (upstream == nullptr) {
+    upstream = std::make_unique<MultiplexedUpstream>();
+  }
+  return *upstream;
+}
+
 UpstreamRequest::UpstreamRequest(RouterFilter& parent, Upstream::TcpPoolData tcp_data)
     : parent_(parent), tcp_data_(std::move(tcp_data)) {}
 
 void UpstreamRequest::startStream() {
+  if (parent_.multiplexed_request_ != nullptr) {
+    multiplexed_upstream_ = &(*parent_.multiplexed_upstreams_)
+                                 ->upstream(parent_.route_entry_->clusterName(), tcp_data_);
+    multiplexed_upstream_->newStream(*this);
+    return;
+  }
+
   Tcp::ConnectionPool::Cancellable* handle = tcp_data_.newConnection(*this);
   conn_pool_handle_ = handle;
 }
@@ -34,6 +190,13 @@ void UpstreamRequest::resetStream(StreamResetReason reason) {
   ENVOY_LOG(debug, "generic proxy upstream request: reset upstream request");
   stream_reset_ = true;
 
+  if (multiplexed_upstream_ != nullptr) {
+    // The upstream connection is shared by other requests and is kept.
+    multiplexed_upstream_->removeStream(parent_.upstream_stream_id_);
+    parent_.onUpstreamRequestReset(*this, reason);
+    return;
+  }
+
   if (conn_pool_handle_) {
     ASSERT(!conn_data_);
     ENVOY_LOG(debug, "generic proxy upstream request: cacel upstream request");
@@ -58,6 +221,32 @@ void UpstreamRequest::completeUpstreamRequest() {
   conn_data_.reset();
 }
 
+void UpstreamRequest::onMultiplexedUpstreamReady(Upstream::HostDescriptionConstSharedPtr host) {
+  onUpstreamHostSelected(host);
+
+  multiplexed_upstream_->write(parent_.upstream_request_buffer_);
+
+  if (parent_.expect_response_ == false) {
+    response_complete_ = true;
+    multiplexed_upstream_->removeStream(parent_.upstream_stream_id_);
+    parent_.completeDirectly();
+  }
+}
+
+void UpstreamRequest::onMultiplexedUpstreamResponse(ResponsePtr response) {
+  response_complete_ = true;
+  response->setStreamId(parent_.downstream_stream_id_.value());
+  parent_.onUpstreamResponse(std::move(response));
+}
+
+void UpstreamRequest::onMultiplexedUpstreamReset(StreamResetReason reason,
+                                                 Upstream::HostDescriptionConstSharedPtr host) {
+  if (host != nullptr) {
+    onUpstreamHostSelected(host);
+  }
+  resetStream(reason);
+}
+
 void UpstreamRequest::onPoolFailure(ConnectionPool::PoolFailureReason reason, absl::string_view,
                                     Upstream::HostDescriptionConstSharedPtr host) {
   conn_pool_handle_ = nullptr;
@@ -210,9 +399,15 @@ void RouterFilter::resetStream(StreamResetReason reason) {
 
 void RouterFilter::onEncodingSuccess(Buffer::Instance& buffer, bool expect_response) {
   ENVOY_LOG(debug, "upstream request encoding success");
+  if (multiplexed_request_ != nullptr) {
+    // The stream id of the request is only replaced for encoding.
+    multiplexed_request_->setStreamId(downstream_stream_id_.value());
+  }
+
   upstream_request_buffer_.move(buffer);
-  kickOffNewUpstreamRequest();
+  // The upstream connection may be ready when the upstream request is started.
   expect_response_ = expect_response;
+  kickOffNewUpstreamRequest();
 }
 
 void RouterFilter::kickOffNewUpstreamRequest() {
@@ -258,6 +453,15 @@ FilterStatus RouterFilter::onStreamDecoded(Request& request) {
   }
 
   request_encoder_ = callbacks_->downstreamCodec().requestEncoder();
+
+  downstream_stream_id_ = request.streamId();
+  if (multiplexed_upstreams_ != nullptr && downstream_stream_id_.has_value()) {
+    // The request is sent on a connection shared by the router filters of the worker, so it is
+    // encoded with a stream id that is unique in the worker.
+    multiplexed_request_ = &request;
+    upstream_stream_id_ = (*multiplexed_upstreams_)->nextStreamId();
+    request.setStreamId(upstream_stream_id_);
+  }
   request_encoder_->encode(request, *this);
 
   return FilterStatus::StopIteration;
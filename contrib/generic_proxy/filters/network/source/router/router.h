@@ -1,12 +1,18 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+
 #include "envoy/network/connection.h"
 #include "envoy/server/factory_context.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/upstream/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "contrib/generic_proxy/filters/network/source/interface/codec.h"
 #include "contrib/generic_proxy/filters/network/source/interface/filter.h"
 #include "contrib/generic_proxy/filters/network/source/interface/stream.h"
@@ -33,6 +39,83 @@ enum class StreamResetReason : uint32_t {
 };
 
 class RouterFilter;
+class UpstreamRequest;
+
+/**
+ * An upstream connection shared by the requests of all the router filters of a worker to a host.
+ * The requests are written with stream ids that are unique in the worker, and the responses are
+ * dispatched to the requests by their stream ids.
+ */
+class MultiplexedUpstream : public Tcp::ConnectionPool::Callbacks,
+                            public Tcp::ConnectionPool::UpstreamCallbacks,
+                            public ResponseDecoderCallback,
+                            Logger::Loggable<Envoy::Logger::Id::filter> {
+public:
+  ~MultiplexedUpstream() override;
+
+  /**
+   * Adds the stream of an upstream request, and connects to the host if there is no connection.
+   */
+  void newStream(UpstreamRequest& upstream_request);
+  /**
+   * Removes the stream of an upstream request. A response with its stream id is dropped.
+   */
+  void removeStream(uint64_t stream_id) { streams_.erase(stream_id); }
+  void write(Buffer::Instance& buffer);
+
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                     absl::string_view transport_failure_reason,
+                     Upstream::HostDescriptionConstSharedPtr host) override;
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
+                   Upstream::HostDescriptionConstSharedPtr host) override;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+  // ResponseDecoderCallback
+  void onDecodingSuccess(ResponsePtr response) override;
+  void onDecodingFailure() override;
+
+  const absl::flat_hash_map<uint64_t, UpstreamRequest*>& streamsForTest() const {
+    return streams_;
+  }
+
+private:
+  void resetStreams(StreamResetReason reason);
+  void closeConnection();
+
+  absl::flat_hash_map<uint64_t, UpstreamRequest*> streams_;
+
+  Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  Upstream::HostDescriptionConstSharedPtr upstream_host_;
+  ResponseDecoderPtr response_decoder_;
+};
+
+/**
+ * The multiplexed upstreams of a worker, and the stream ids of the requests sent on them.
+ */
+class MultiplexedUpstreams : public ThreadLocal::ThreadLocalObject {
+public:
+  uint64_t nextStreamId() { return next_stream_id_++; }
+
+  /**
+   * @return the multiplexed upstream of the host of the connection pool of the cluster.
+   */
+  MultiplexedUpstream& upstream(absl::string_view cluster_name,
+                                const Upstream::TcpPoolData& tcp_data);
+
+private:
+  uint64_t next_stream_id_{};
+  absl::flat_hash_map<std::string, std::unique_ptr<MultiplexedUpstream>> upstreams_;
+};
+
+using MultiplexedUpstreamsSlot = ThreadLocal::TypedSlot<MultiplexedUpstreams>;
+using MultiplexedUpstreamsSlotSharedPtr = std::shared_ptr<MultiplexedUpstreamsSlot>;
 
 class UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
                         public Tcp::ConnectionPool::UpstreamCallbacks,
@@ -68,6 +151,12 @@ public:
 
   void completeUpstreamRequest();
 
+  // Called by the multiplexed upstream of the request.
+  void onMultiplexedUpstreamReady(Upstream::HostDescriptionConstSharedPtr host);
+  void onMultiplexedUpstreamResponse(ResponsePtr response);
+  void onMultiplexedUpstreamReset(StreamResetReason reason,
+                                  Upstream::HostDescriptionConstSharedPtr host);
+
   bool stream_reset_{};
 
   RouterFilter& parent_;
@@ -81,6 +170,8 @@ public:
   bool response_started_{};
   bool response_complete_{};
   ResponseDecoderPtr response_decoder_;
+
+  MultiplexedUpstream* multiplexed_upstream_{};
 };
 using UpstreamRequestPtr = std::unique_ptr<UpstreamRequest>;
 
@@ -89,7 +180,9 @@ class RouterFilter : public DecoderFilter,
                      public RequestEncoderCallback,
                      Logger::Loggable<Envoy::Logger::Id::filter> {
 public:
-  RouterFilter(Server::Configuration::FactoryContext& context) : context_(context) {}
+  RouterFilter(Server::Configuration::FactoryContext& context,
+               MultiplexedUpstreamsSlotSharedPtr multiplexed_upstreams = nullptr)
+      : context_(context), multiplexed_upstreams_(std::move(multiplexed_upstreams)) {}
 
   // DecoderFilter
   void onDestroy() override;
@@ -114,6 +207,7 @@ public:
 
 private:
   friend class UpstreamRequest;
+  friend class MultiplexedUpstream;
 
   void kickOffNewUpstreamRequest();
   void resetStream(StreamResetReason reason);
@@ -132,6 +226,13 @@ private:
   DecoderFilterCallback* callbacks_{};
 
   Server::Configuration::FactoryContext& context_;
+
+  MultiplexedUpstreamsSlotSharedPtr multiplexed_upstreams_;
+  // The stream id of the request from the downstream, if the request is sent on a multiplexed
+  // upstream with the stream id upstream_stream_id_ instead.
+  absl::optional<uint64_t> downstream_stream_id_;
+  uint64_t upstream_stream_id_{};
+  Request* multiplexed_request_{};
 };
 
 } // namespace Router
@@ -95,6 +95,14 @@ TEST(DubboRequestTest, DubboRequestTest) {
     // Version is not part of attachments. So there are only 4 attachments.
     EXPECT_EQ(4, attachment_size);
   }
+
+  // Stream id is the request id.
+  {
+    EXPECT_EQ(123456, request.streamId().value());
+    request.setStreamId(7);
+    EXPECT_EQ(7, request.streamId().value());
+    EXPECT_EQ(7, request.inner_metadata_->requestId());
+  }
 }
 
 TEST(DubboResponseTest, DubboResponseTest) {
@@ -113,6 +121,15 @@ TEST(DubboResponseTest, DubboResponseTest) {
         createDubboResponse(request, ResponseStatus::Ok, RpcResponseType::ResponseWithValue));
     EXPECT_EQ(StatusCode::kOk, response.status().code());
   }
+
+  // Stream id is the request id of the request.
+  {
+    DubboResponse response(
+        createDubboResponse(request, ResponseStatus::Ok, RpcResponseType::ResponseWithValue));
+    EXPECT_EQ(123456, response.streamId().value());
+    response.setStreamId(7);
+    EXPECT_EQ(7, response.streamId().value());
+  }
   {
     DubboResponse response(
         createDubboResponse(request, ResponseStatus::Ok, RpcResponseType::ResponseWithException));
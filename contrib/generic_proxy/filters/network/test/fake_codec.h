@@ -32,8 +32,11 @@ public:
     setByKey(key, val);
   }
   void setByReference(absl::string_view key, absl::string_view val) override { setByKey(key, val); }
+  absl::optional<uint64_t> streamId() const override { return stream_id_; }
+  void setStreamId(uint64_t stream_id) override { stream_id_ = stream_id; }
 
   absl::flat_hash_map<std::string, std::string> data_;
+  absl::optional<uint64_t> stream_id_;
 };
 
 /**
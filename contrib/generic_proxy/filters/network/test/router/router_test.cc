@@ -450,6 +450,108 @@ TEST_F(RouterFilterTest, UpstreamRequestPoolReadyAndResponseDecodingFailure) {
   upstream_request->onDecodingFailure();
 }
 
+TEST_F(RouterFilterTest, MultiplexedUpstreamRequestsShareConnection) {
+  NiceMock<Network::MockClientConnection> mock_conn;
+
+  auto multiplexed_upstreams =
+      std::make_shared<MultiplexedUpstreamsSlot>(factory_context_.thread_local_);
+  multiplexed_upstreams->set(
+      [](Envoy::Event::Dispatcher&) { return std::make_shared<MultiplexedUpstreams>(); });
+
+  const std::string cluster_name = "cluster_0";
+  EXPECT_CALL(mock_route_entry_, clusterName()).WillRepeatedly(ReturnRef(cluster_name));
+  factory_context_.cluster_manager_.initializeThreadLocalClusters({cluster_name});
+
+  FakeStreamCodecFactory codec_factory;
+  NiceMock<MockDecoderFilterCallback> callbacks[2];
+  std::shared_ptr<RouterFilter> filters[2];
+  FakeStreamCodecFactory::FakeRequest requests[2];
+  for (size_t i = 0; i < 2; i++) {
+    ON_CALL(callbacks[i], routeEntry()).WillByDefault(Return(&mock_route_entry_));
+    ON_CALL(callbacks[i], downstreamCodec()).WillByDefault(ReturnRef(codec_factory));
+    ON_CALL(callbacks[i], dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+    filters[i] = std::make_shared<RouterFilter>(factory_context_, multiplexed_upstreams);
+    filters[i]->setDecoderFilterCallbacks(callbacks[i]);
+    // The requests of different downstream connections may have the same stream id.
+    requests[i].stream_id_ = 7;
+  }
+
+  // Only one upstream connection is created for both requests.
+  EXPECT_CALL(factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_,
+              newConnection(_));
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_EQ(filters[i]->onStreamDecoded(requests[i]), FilterStatus::StopIteration);
+    // The stream id from the downstream is restored after encoding.
+    EXPECT_EQ(7, requests[i].stream_id_.value());
+  }
+
+  MultiplexedUpstream* upstream =
+      filters[0]->upstreamRequestsForTest().front()->multiplexed_upstream_;
+  ASSERT_NE(nullptr, upstream);
+  EXPECT_EQ(upstream, filters[1]->upstreamRequestsForTest().front()->multiplexed_upstream_);
+  EXPECT_EQ(2, upstream->streamsForTest().size());
+
+  EXPECT_CALL(mock_conn, write(_, _)).Times(2);
+  factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_.poolReady(mock_conn);
+
+  // The response is dispatched by the stream id of the second request, and the response carries
+  // the stream id from the downstream.
+  EXPECT_CALL(callbacks[0], upstreamResponse(_)).Times(0);
+  EXPECT_CALL(callbacks[1], upstreamResponse(_)).WillOnce(Invoke([](ResponsePtr response) {
+    EXPECT_EQ(7, response->streamId().value());
+  }));
+  auto response = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+  response->stream_id_ = 1;
+  upstream->onDecodingSuccess(std::move(response));
+  EXPECT_EQ(1, upstream->streamsForTest().size());
+
+  // A response of an unknown stream is dropped.
+  response = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+  response->stream_id_ = 1;
+  upstream->onDecodingSuccess(std::move(response));
+
+  // Destroying a router filter removes its stream but keeps the shared connection.
+  EXPECT_CALL(mock_conn, close(_)).Times(0);
+  filters[0]->onDestroy();
+  EXPECT_TRUE(upstream->streamsForTest().empty());
+  testing::Mock::VerifyAndClearExpectations(&mock_conn);
+}
+
+TEST_F(RouterFilterTest, MultiplexedUpstreamResponseWithoutStreamId) {
+  NiceMock<Network::MockClientConnection> mock_conn;
+
+  auto multiplexed_upstreams =
+      std::make_shared<MultiplexedUpstreamsSlot>(factory_context_.thread_local_);
+  multiplexed_upstreams->set(
+      [](Envoy::Event::Dispatcher&) { return std::make_shared<MultiplexedUpstreams>(); });
+
+  const std::string cluster_name = "cluster_0";
+  EXPECT_CALL(mock_route_entry_, clusterName()).WillRepeatedly(ReturnRef(cluster_name));
+  factory_context_.cluster_manager_.initializeThreadLocalClusters({cluster_name});
+
+  FakeStreamCodecFactory codec_factory;
+  ON_CALL(mock_filter_callback_, routeEntry()).WillByDefault(Return(&mock_route_entry_));
+  ON_CALL(mock_filter_callback_, downstreamCodec()).WillByDefault(ReturnRef(codec_factory));
+  filter_ = std::make_shared<RouterFilter>(factory_context_, multiplexed_upstreams);
+  filter_->setDecoderFilterCallbacks(mock_filter_callback_);
+
+  FakeStreamCodecFactory::FakeRequest request;
+  request.stream_id_ = 7;
+  filter_->onStreamDecoded(request);
+
+  EXPECT_CALL(mock_conn, write(_, _));
+  factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_.poolReady(mock_conn);
+
+  // The shared connection is closed and all the streams are reset.
+  EXPECT_CALL(mock_conn, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(mock_filter_callback_, sendLocalReply(_, _))
+      .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+        EXPECT_EQ(status.message(), "protocol_error");
+      }));
+  filter_->upstreamRequestsForTest().front()->multiplexed_upstream_->onDecodingSuccess(
+      std::make_unique<FakeStreamCodecFactory::FakeResponse>());
+}
+
 } // namespace
 } // namespace Router
 } // namespace GenericProxy
@@ -581,8 +581,9 @@ CAPIStatus Filter::getHeader(absl::string_view key, GoString* goValue) {
 void copyHeaderMapToGo(Http::HeaderMap& m, GoString* go_strs, char* go_buf) {
   auto i = 0;
   m.iterate([&i, &go_strs, &go_buf](const Http::HeaderEntry& header) -> Http::HeaderMap::Iterate {
-    auto key = std::string(header.key().getStringView());
-    auto value = std::string(header.value().getStringView());
+    // Copy straight from the header map into the Go memory, without an intermediate string.
+    const absl::string_view key = header.key().getStringView();
+    const absl::string_view value = header.value().getStringView();
 
     auto len = key.length();
     // go_strs is the heap memory of go, and the length is twice the number of headers. So range it
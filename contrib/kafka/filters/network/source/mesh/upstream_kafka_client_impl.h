@@ -7,6 +7,8 @@
 #include "contrib/kafka/filters/network/source/mesh/librdkafka_utils.h"
 #include "contrib/kafka/filters/network/source/mesh/upstream_kafka_client.h"
 
+#include "absl/container/btree_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -19,6 +21,9 @@ namespace Mesh {
  * Independently running monitoring thread picks up delivery confirmations from producer and uses
  * Dispatcher to notify itself about delivery in worker thread.
  */
+// Unfinished requests, keyed by the payloads of their records that are waiting for delivery.
+using UnfinishedProduceRequests = absl::btree_multimap<const void*, ProduceFinishCbSharedPtr>;
+
 class RichKafkaProducer : public KafkaProducer,
                           public RdKafka::DeliveryReportCb,
                           private Logger::Loggable<Logger::Id::kafka> {
@@ -53,12 +58,14 @@ public:
   // Executed in Envoy worker thread.
   void processDelivery(const DeliveryMemento& memento);
 
-  std::list<ProduceFinishCbSharedPtr>& getUnfinishedRequestsForTest();
+  UnfinishedProduceRequests& getUnfinishedRequestsForTest();
 
 private:
   Event::Dispatcher& dispatcher_;
 
-  std::list<ProduceFinishCbSharedPtr> unfinished_produce_requests_;
+  // A request is registered once for each of its records, so that a delivery confirmation only
+  // needs to be offered to the requests that sent its payload.
+  UnfinishedProduceRequests unfinished_produce_requests_;
 
   // Real Kafka producer (thread-safe).
   // Invoked by Envoy handler thread (to produce), and internal monitoring thread
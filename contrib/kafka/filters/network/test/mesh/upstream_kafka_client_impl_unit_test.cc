@@ -106,7 +106,8 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
 
   // when, then - should process confirmations (notice we pass second memento first).
-  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false)).WillOnce(Return(true));
+  // Only the request that sent the payload is notified.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(true));
   EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
   const DeliveryMemento memento1 = {payloads[1].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento1);
@@ -116,6 +117,32 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
 }
 
+TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveriesOfSamePayload) {
+  // given
+  setupConstructorExpectations();
+  RichKafkaProducer testee = {dispatcher_, thread_factory_, config_, kafka_utils_};
+
+  // when, then - should send request without problems.
+  EXPECT_CALL(producer_, produce("topic", 13, _, _, _, _, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(RdKafka::ERR_NO_ERROR));
+  const std::string payload = "value";
+  auto origin1 = std::make_shared<MockProduceFinishCb>();
+  auto origin2 = std::make_shared<MockProduceFinishCb>();
+  testee.send(origin1, makeRecord(payload));
+  testee.send(origin2, makeRecord(payload));
+  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 2);
+
+  // when, then - requests sharing the payload are asked in order until one accepts.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false)).WillOnce(Return(true));
+  EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
+  const DeliveryMemento memento = {payload.c_str(), RdKafka::ERR_NO_ERROR, 0};
+  testee.processDelivery(memento);
+  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 1);
+  testee.processDelivery(memento);
+  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+}
+
 TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
   // given
   setupConstructorExpectations();
@@ -9,6 +9,7 @@
 #include "envoy/common/exception.h"
 #include "envoy/common/platform.h"
 #include "envoy/common/pure.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/common/assert.h"
@@ -563,6 +564,15 @@ public:
    * @return the number of streams reset
    */
   virtual uint64_t resetAccountsGivenPressure(float pressure) PURE;
+
+  /**
+   * Lets the factory schedule work on the thread using it, such as resetting streams once the
+   * accounts it created are charged more than the configured limit. This is called by the
+   * dispatcher of the thread once it is constructed.
+   *
+   * @param scheduler supplies the callback scheduler of the thread using the factory.
+   */
+  virtual void initializeScheduler(Event::CallbackScheduler& scheduler) PURE;
 };
 
 using WatermarkFactoryPtr = std::unique_ptr<WatermarkFactory>;
@@ -11,6 +11,16 @@ public:
   virtual ~CompressorFactory() = default;
 
   virtual CompressorPtr createCompressor() PURE;
+
+  /**
+   * Creates a compressor spending only a fraction of the configured effort, trading compression
+   * ratio for CPU time, e.g. under overload. Libraries without cheaper settings create their usual
+   * compressor.
+   * @param effort between 0, the cheapest setting of the library, and 1, the configured setting.
+   */
+  virtual CompressorPtr createCompressorWithEffort(float /* effort */) {
+    return createCompressor();
+  }
   virtual const std::string& statsPrefix() const PURE;
   virtual const std::string& contentEncoding() const PURE;
 };
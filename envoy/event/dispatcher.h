@@ -233,12 +233,14 @@ public:
    * @param bind_to_port controls whether the listener binds to a transport port or not.
    * @param ignore_global_conn_limit controls whether the listener is limited by the global
    * connection limit.
+   * @param max_connections_to_accept_per_socket_event bounds the number of connections accepted
+   * each time the listen socket becomes readable.
    * @return Network::ListenerPtr a new listener that is owned by the caller.
    */
-  virtual Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
-                                              Network::TcpListenerCallbacks& cb,
-                                              Runtime::Loader& runtime, bool bind_to_port,
-                                              bool ignore_global_conn_limit) PURE;
+  virtual Network::ListenerPtr
+  createListener(Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
+                 Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit,
+                 uint32_t max_connections_to_accept_per_socket_event) PURE;
 
   /**
    * Creates a logical udp listener on a specific port.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -129,6 +130,10 @@ public:
 
 using InternalListenerConfigOptRef = OptRef<InternalListenerConfig>;
 
+// By default a listener accepts all the connections pending in its backlog on each socket event.
+constexpr uint32_t DefaultMaxConnectionsToAcceptPerSocketEvent =
+    std::numeric_limits<uint32_t>::max();
+
 /**
  * A configuration for an individual listener.
  */
@@ -249,6 +254,12 @@ public:
    * limit.
    */
   virtual bool ignoreGlobalConnLimit() const PURE;
+
+  /**
+   * @return uint32_t the maximum number of connections accepted each time the listen socket becomes
+   * readable.
+   */
+  virtual uint32_t maxConnectionsToAcceptPerSocketEvent() const PURE;
 };
 
 /**
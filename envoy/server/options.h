@@ -240,6 +240,12 @@ public:
    */
   virtual bool cpusetThreadsEnabled() const PURE;
 
+  /**
+   * @return bool indicating whether each worker thread should be pinned to the CPU matching its
+   *         index.
+   */
+  virtual bool pinWorkerThreadsEnabled() const PURE;
+
   /**
    * @return the names of extensions to disable.
    */
@@ -37,6 +37,9 @@ public:
 
   // Overload action to reset streams using excessive memory.
   const std::string ResetStreams = "envoy.overload_actions.reset_high_memory_stream";
+
+  // Overload action to reduce the CPU time spent compressing responses.
+  const std::string ReduceCompressionEffort = "envoy.overload_actions.reduce_compression_effort";
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
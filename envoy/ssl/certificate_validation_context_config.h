@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -94,6 +95,12 @@ public:
    * @return the max depth used when verifying the certificate-chain
    */
   virtual absl::optional<uint32_t> maxVerifyDepth() const PURE;
+
+  /**
+   * @return how long successful trust chain verifications are cached for, or absl::nullopt if they
+   * are not cached.
+   */
+  virtual absl::optional<std::chrono::milliseconds> trustChainVerificationCacheTtl() const PURE;
 };
 
 using CertificateValidationContextConfigPtr = std::unique_ptr<CertificateValidationContextConfig>;
@@ -9,6 +9,7 @@
 #include "envoy/common/pure.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
+#include "envoy/ssl/session_cache.h"
 #include "envoy/ssl/tls_certificate_config.h"
 
 #include "source/common/network/cidr_range.h"
@@ -156,6 +157,15 @@ public:
     MustStaple,
   };
 
+  struct DynamicRecordSizing {
+    // Size of the records written while the connection is warming up.
+    uint32_t initial_record_size_;
+    // Bytes written with records of initial_record_size_ before writing full size records.
+    uint64_t initial_bytes_;
+    // Period without writes after which records of initial_record_size_ are written again.
+    std::chrono::milliseconds idle_timeout_;
+  };
+
   /**
    * @return True if client certificate is required, false otherwise.
    */
@@ -190,6 +200,23 @@ public:
    * downstream TLS handshake, false otherwise.
    */
   virtual bool fullScanCertsOnSNIMismatch() const PURE;
+
+  /**
+   * @return the external cache for stateful sessions, or nullptr if sessions are only cached by
+   * BoringSSL within the process.
+   */
+  virtual SessionCacheSharedPtr sessionCache() const PURE;
+
+  /**
+   * @return True if the context is built on first use rather than upfront, false otherwise.
+   */
+  virtual bool lazyContextInitialization() const PURE;
+
+  /**
+   * @return the settings for writing small records while connections warm up, or nullopt if
+   * records are always written at full size.
+   */
+  virtual const absl::optional<DynamicRecordSizing>& dynamicRecordSizing() const PURE;
 };
 
 using ServerContextConfigPtr = std::unique_ptr<ServerContextConfig>;
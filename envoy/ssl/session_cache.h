@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/config/typed_config.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/protobuf/message_validator.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Server {
+namespace Configuration {
+// Prevent a dependency loop with the forward declaration.
+class TransportSocketFactoryContext;
+} // namespace Configuration
+} // namespace Server
+
+namespace Ssl {
+
+/**
+ * Callbacks for an asynchronous session cache lookup.
+ */
+class SessionCacheLookupCallbacks {
+public:
+  virtual ~SessionCacheLookupCallbacks() = default;
+
+  /**
+   * Called once the lookup has finished, on the dispatcher passed to SessionCache::lookup().
+   * @param session supplies the serialized session, or absl::nullopt if the session was not found
+   *        or the lookup failed.
+   */
+  virtual void onSessionCacheLookupComplete(absl::optional<std::string>&& session) PURE;
+};
+
+/**
+ * An in-flight session cache lookup.
+ */
+class SessionCacheLookup {
+public:
+  virtual ~SessionCacheLookup() = default;
+
+  /**
+   * Cancel the lookup. The callbacks will not be invoked afterwards.
+   */
+  virtual void cancel() PURE;
+};
+
+using SessionCacheLookupPtr = std::unique_ptr<SessionCacheLookup>;
+
+/**
+ * A cache for stateful TLS sessions, possibly shared with other Envoy instances. It is shared by
+ * all workers, so implementations must be thread safe.
+ */
+class SessionCache {
+public:
+  virtual ~SessionCache() = default;
+
+  /**
+   * Store a session. Failures are ignored, the session can just not be resumed.
+   * @param session_id supplies the ID of the session.
+   * @param session supplies the serialized session.
+   * @param timeout supplies how long the session may be resumed for.
+   */
+  virtual void insert(absl::string_view session_id, absl::string_view session,
+                      std::chrono::seconds timeout) PURE;
+
+  /**
+   * Look up a session.
+   * @param session_id supplies the ID of the session.
+   * @param dispatcher supplies the dispatcher of the connection, on which callbacks are invoked.
+   * @param callbacks supplies the callbacks, which may also be invoked before returning.
+   * @return the in-flight lookup, or nullptr if the callbacks have already been invoked.
+   */
+  virtual SessionCacheLookupPtr lookup(absl::string_view session_id,
+                                       Event::Dispatcher& dispatcher,
+                                       SessionCacheLookupCallbacks& callbacks) PURE;
+
+  /**
+   * Remove a session that must no longer be resumed.
+   * @param session_id supplies the ID of the session.
+   */
+  virtual void remove(absl::string_view session_id) PURE;
+};
+
+using SessionCacheSharedPtr = std::shared_ptr<SessionCache>;
+
+class SessionCacheFactory : public Config::TypedFactory {
+public:
+  /**
+   * @return a session cache for a TLS context. Contexts configured alike may share a cache.
+   * @param config supplies the configuration of the cache.
+   * @param factory_context supplies the transport socket factory context.
+   */
+  virtual SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message& config,
+                     Server::Configuration::TransportSocketFactoryContext& factory_context) PURE;
+
+  std::string category() const override { return "envoy.tls.session_cache"; }
+};
+
+} // namespace Ssl
+} // namespace Envoy
@@ -98,6 +98,13 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return whether flush() only needs the metrics that changed since the previous flush. Such
+   *         sinks are handed a snapshot with the counters that were incremented, the used gauges
+   *         whose value changed and the histograms that recorded values during the interval.
+   */
+  virtual bool deltaSnapshots() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
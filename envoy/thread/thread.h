@@ -56,6 +56,8 @@ using ThreadPtr = std::unique_ptr<Thread>;
 // Options specified during thread creation.
 struct Options {
   std::string name_; // A name supplied for the thread. On Linux this is limited to 15 chars.
+  // If set, the thread only runs on the CPU with this index. Only supported on Linux.
+  absl::optional<uint32_t> cpu_;
 };
 
 using OptionsOptConstRef = const absl::optional<Options>&;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -84,6 +85,31 @@ public:
   virtual StatMapPtr latch() PURE;
 };
 
+/**
+ * State that a load balancing policy keeps for a host, e.g. an estimate of the host's latency. The
+ * state is shared by the load balancers of all workers, so implementations must be thread safe.
+ */
+class HostLbPolicyData {
+public:
+  virtual ~HostLbPolicyData() = default;
+
+  /**
+   * Called when a response from the host is complete.
+   * @param response_time supplies the time between the end of the downstream request and the end
+   *        of the upstream response.
+   */
+  virtual void onResponseTime(std::chrono::microseconds response_time) PURE;
+
+  /**
+   * Called when a response from the host carries an ORCA load report, see
+   * https://github.com/cncf/xds/blob/main/xds/data/orca/v3/orca_load_report.proto.
+   * @param report supplies the value of the endpoint-load-metrics response header or trailer.
+   */
+  virtual void onLoadReport(absl::string_view report) PURE;
+};
+
+using HostLbPolicyDataPtr = std::unique_ptr<HostLbPolicyData>;
+
 class ClusterInfo;
 
 /**
@@ -202,6 +228,19 @@ public:
    *         healthy state via an active healthchecking.
    */
   virtual absl::optional<MonotonicTime> lastHcPassTime() const PURE;
+
+  /**
+   * @return the load balancing policy state of the host, or nullptr if no state was installed.
+   */
+  virtual HostLbPolicyData* lbPolicyData() const PURE;
+
+  /**
+   * Install load balancing policy state for the host unless some state was installed already. The
+   * state lives as long as the host. May be called from any thread.
+   * @param lb_policy_data supplies the state to install.
+   * @return the state of the host, which is lb_policy_data unless some state was installed before.
+   */
+  virtual HostLbPolicyData& setLbPolicyData(HostLbPolicyDataPtr&& lb_policy_data) const PURE;
 };
 
 using HostDescriptionConstSharedPtr = std::shared_ptr<const HostDescription>;
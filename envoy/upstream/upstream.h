@@ -892,6 +892,12 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return whether connection pools should preconnect based on their observed stream arrival
+   *         rate and connection establishment latency.
+   */
+  virtual bool adaptivePreconnect() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -447,6 +447,14 @@ std::string EngineBuilder::generateConfigStr() const {
                         &config_template);
   }
 
+  if (stat_sinks.empty()) {
+    // Nothing consumes periodic flushes without sinks, so only flush when the admin /stats
+    // endpoint is queried rather than waking the engine up on a timer.
+    absl::StrReplaceAll(
+        {{"stats_flush_interval: *stats_flush_interval", "stats_flush_on_admin: true"}},
+        &config_template);
+  }
+
   config_builder << config_template;
 
   if (admin_interface_enabled_) {
@@ -902,7 +910,12 @@ std::unique_ptr<envoy::config::bootstrap::v3::Bootstrap> EngineBuilder::generate
           .PackFrom(alpn_options);
 
   // Set up stats.
-  bootstrap->mutable_stats_flush_interval()->set_seconds(stats_flush_seconds_);
+  if (stats_sinks_.empty() && stats_domain_.empty()) {
+    // Nothing consumes periodic flushes without sinks, so avoid the flush timer wakeups.
+    bootstrap->set_stats_flush_on_admin(true);
+  } else {
+    bootstrap->mutable_stats_flush_interval()->set_seconds(stats_flush_seconds_);
+  }
   bootstrap->mutable_stats_sinks();
   auto* list = bootstrap->mutable_stats_config()->mutable_stats_matcher()->mutable_inclusion_list();
   list->add_patterns()->set_prefix("cluster.base.upstream_rq_");
@@ -47,6 +47,8 @@ public:
       int h2_connection_keepalive_idle_interval_milliseconds);
   EngineBuilder&
   addH2ConnectionKeepaliveTimeoutSeconds(int h2_connection_keepalive_timeout_seconds);
+  // Only takes effect when stats sinks or a gRPC stats domain are configured. Otherwise stats are
+  // flushed when the admin interface is queried and no flush timer runs.
   EngineBuilder& addStatsFlushSeconds(int stats_flush_seconds);
   // Configures Envoy to use the PlatformBridge filter named `name`. An instance of
   // envoy_http_filter must be registered as a platform API with the same name.
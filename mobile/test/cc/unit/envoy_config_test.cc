@@ -334,6 +334,25 @@ TEST(TestConfig, AddStatsSinks) {
   TestUtility::loadFromYaml(absl::StrCat(config_header, config_str), bootstrap);
 }
 
+TEST(TestConfig, StatsFlushOnlyWithSinks) {
+  EngineBuilder engine_builder;
+  engine_builder.addStatsFlushSeconds(654);
+
+  std::string config_str = engine_builder.generateConfigStr();
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  TestUtility::loadFromYaml(absl::StrCat(config_header, config_str), bootstrap);
+  EXPECT_TRUE(bootstrap.stats_flush_on_admin());
+  EXPECT_FALSE(bootstrap.has_stats_flush_interval());
+  EXPECT_TRUE(TestUtility::protoEqual(bootstrap, *engine_builder.generateBootstrap()));
+
+  engine_builder.addStatsSinks({statsdSinkConfig(1)});
+  config_str = engine_builder.generateConfigStr();
+  TestUtility::loadFromYaml(absl::StrCat(config_header, config_str), bootstrap);
+  EXPECT_FALSE(bootstrap.stats_flush_on_admin());
+  EXPECT_EQ(bootstrap.stats_flush_interval().seconds(), 654);
+  EXPECT_TRUE(TestUtility::protoEqual(bootstrap, *engine_builder.generateBootstrap()));
+}
+
 TEST(TestConfig, DisableHttp3) {
   EngineBuilder engine_builder;
 
@@ -9,10 +9,15 @@
 #include "source/common/common/lock_guard.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
 namespace AccessLog {
 
+namespace {
+std::atomic<uint64_t> next_file_id{0};
+} // namespace
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -44,7 +49,7 @@ AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatch
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
                                      Thread::ThreadFactory& thread_factory)
-    : file_(std::move(file)), file_lock_(lock),
+    : id_(next_file_id++), file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
         flush_event_.notifyOne();
@@ -87,8 +92,10 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    drainThreadBuffers(about_to_write_buffer_);
+    about_to_write_buffer_.move(flush_buffer_);
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -135,7 +142,8 @@ void AccessLogFileImpl::flushThreadFunc() {
 
       // flush_event_ can be woken up either by large enough flush_buffer or by timer.
       // In case it was timer, flush_buffer_ can be empty.
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (flush_buffer_.length() == 0 && threadBuffersEmpty() && !flush_thread_exit_ &&
+             !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -145,6 +153,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
+      drainThreadBuffers(about_to_write_buffer_);
       about_to_write_buffer_.move(flush_buffer_);
       ASSERT(flush_buffer_.length() == 0);
     }
@@ -181,35 +190,94 @@ void AccessLogFileImpl::flush() {
     // return before the pending data has actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
-      return;
-    }
-
+    drainThreadBuffers(about_to_write_buffer_);
     about_to_write_buffer_.move(flush_buffer_);
     ASSERT(flush_buffer_.length() == 0);
+    if (about_to_write_buffer_.length() == 0) {
+      return;
+    }
   }
 
   doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
-
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  bool notify = false;
+  if (!flush_thread_started_.load(std::memory_order_acquire)) {
+    Thread::LockGuard lock(write_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
+      // The new flush thread writes the data on its first loop.
+      notify = true;
+    }
   }
 
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
+
+  ThreadBuffer& thread_buffer = threadBuffer();
+  if (!thread_buffer.overflowed_.load(std::memory_order_relaxed)) {
+    SpscRingBuffer& ring_buffer = thread_buffer.ring_buffer_;
+    const uint64_t previous_length = ring_buffer.readableBytes();
+    if (ring_buffer.write(data)) {
+      // Only tell the flush thread once per fill of the ring buffer so that the lock is rarely
+      // taken.
+      if (notify || (previous_length <= RING_BUFFER_SIZE / 2 &&
+                     previous_length + data.size() > RING_BUFFER_SIZE / 2)) {
+        Thread::LockGuard lock(write_lock_);
+        flush_event_.notifyOne();
+      }
+      return;
+    }
+    stats_.write_ring_buffer_full_.inc();
+  }
+
+  Thread::LockGuard lock(write_lock_);
+  thread_buffer.overflowed_.store(true, std::memory_order_relaxed);
   flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+  if (notify || flush_buffer_.length() > MIN_FLUSH_SIZE) {
     flush_event_.notifyOne();
   }
 }
 
+AccessLogFileImpl::ThreadBuffer& AccessLogFileImpl::threadBuffer() {
+  // Entries of destroyed files are never looked up again since file IDs are not reused.
+  static thread_local absl::flat_hash_map<uint64_t, ThreadBuffer*> thread_buffers;
+  ThreadBuffer*& thread_buffer = thread_buffers[id_];
+  if (thread_buffer == nullptr) {
+    auto new_thread_buffer = std::make_unique<ThreadBuffer>();
+    thread_buffer = new_thread_buffer.get();
+    Thread::LockGuard lock(thread_buffers_lock_);
+    thread_buffers_.push_back(std::move(new_thread_buffer));
+  }
+  return *thread_buffer;
+}
+
+bool AccessLogFileImpl::threadBuffersEmpty() {
+  Thread::LockGuard lock(thread_buffers_lock_);
+  for (const auto& thread_buffer : thread_buffers_) {
+    if (thread_buffer->ring_buffer_.readableBytes() > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AccessLogFileImpl::drainThreadBuffers(Buffer::Instance& output) {
+  // The ring buffers go before flush_buffer_, which the caller moves next while still holding
+  // write_lock_. A thread only uses flush_buffer_ after filling its ring buffer, and until it was
+  // moved, so this keeps the data of each thread in order.
+  Thread::LockGuard lock(thread_buffers_lock_);
+  for (const auto& thread_buffer : thread_buffers_) {
+    thread_buffer->ring_buffer_.drainTo(output);
+    thread_buffer->overflowed_.store(false, std::memory_order_relaxed);
+  }
+}
+
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
+  flush_thread_started_.store(true, std::memory_order_release);
 }
 
 } // namespace AccessLog
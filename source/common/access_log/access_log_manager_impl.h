@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -11,6 +13,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/spsc_ring_buffer.h"
 #include "source/common/common/thread.h"
 
 #include "absl/container/node_hash_map.h"
@@ -23,6 +26,7 @@ namespace Envoy {
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
   COUNTER(write_failed)                                                                            \
+  COUNTER(write_ring_buffer_full)                                                                  \
   GAUGE(write_total_buffered, Accumulate)
 
 struct AccessLogFileStats {
@@ -61,6 +65,10 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * Each thread writing to the file appends to its own single producer ring buffer, which the flush
+ * thread drains, so that writers logging at high rates don't contend on a common lock. Data that
+ * doesn't fit into the ring buffer of a thread is appended to the buffer shared by all threads.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
@@ -86,6 +94,16 @@ private:
   void flushThreadFunc();
   Api::IoCallBoolResult open();
   void createFlushStructures();
+  struct ThreadBuffer {
+    SpscRingBuffer ring_buffer_{RING_BUFFER_SIZE};
+    // Set, under write_lock_, once data of the thread went to flush_buffer_. The thread then keeps
+    // using flush_buffer_ until the flush thread moved it, so that its data stays in order.
+    std::atomic<bool> overflowed_{};
+  };
+
+  ThreadBuffer& threadBuffer();
+  bool threadBuffersEmpty();
+  void drainThreadBuffers(Buffer::Instance& output);
 
   // return default flags set which used by open
   static Filesystem::FlagSet defaultFlags();
@@ -93,6 +111,14 @@ private:
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
 
+  // Size of the ring buffer of each thread writing to the file. The flush thread is told to flush
+  // once a ring buffer is half full.
+  static const uint64_t RING_BUFFER_SIZE = 1024 * 64;
+
+  // Identifies the file in the ring buffer lookup table of each thread. Unlike the address of the
+  // file, it is never reused.
+  const uint64_t id_;
+
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
@@ -113,6 +139,7 @@ private:
                    // multiple threads to write to the same file at relatively
                    // high performance. It is always local to the process.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_started_{};
   Thread::CondVar flush_event_;
   std::atomic<bool> flush_thread_exit_{};
   std::atomic<bool> reopen_file_{};
@@ -128,6 +155,11 @@ private:
                                             // the lock is released so that flush_buffer_ can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
+  // Buffers of the threads that wrote to the file. The lock is only taken by writers when they add
+  // their buffer, and is acquired after the other locks if several are held. The ring buffers are
+  // only drained while flush_lock_ is held, as there must be a single consumer.
+  Thread::MutexBasicLockable thread_buffers_lock_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_ ABSL_GUARDED_BY(thread_buffers_lock_);
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
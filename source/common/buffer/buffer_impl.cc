@@ -5,6 +5,7 @@
 #include <string>
 
 #include "source/common/common/assert.h"
+#include "source/common/memory/huge_page_region.h"
 
 #include "absl/container/fixed_array.h"
 #include "event2/buffer.h"
@@ -17,11 +18,65 @@ namespace {
 // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
 // may need to be configurable in the future.
 constexpr uint64_t CopyThreshold = 512;
+
+// Default sized slice storage released on this thread. See Slice::allocateStorage().
+struct SliceStorageCache {
+  ~SliceStorageCache();
+
+  absl::InlinedVector<Slice::StoragePtr, Slice::max_cached_storages_> storages_;
+};
+
+// Slices may be destroyed after the cache of their thread, e.g. by static objects destroyed at
+// exit. This flag is trivially destructible and stays usable until the thread is gone.
+thread_local bool slice_storage_cache_destroyed = false;
+thread_local SliceStorageCache slice_storage_cache;
+
+SliceStorageCache::~SliceStorageCache() { slice_storage_cache_destroyed = true; }
 } // namespace
 
-thread_local absl::InlinedVector<Slice::StoragePtr,
-                                 OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
-    OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
+void Slice::StorageDeleter::operator()(uint8_t* storage) const {
+  Memory::HugePageRegion* region = Memory::HugePageRegion::forBuffers();
+  if (region != nullptr && region->owns(storage)) {
+    region->deallocate(storage);
+    return;
+  }
+  delete[] storage;
+}
+
+Slice::StoragePtr Slice::allocateStorage(uint64_t size) {
+  if (size == default_slice_size_) {
+    if (!slice_storage_cache_destroyed) {
+      auto& storages = slice_storage_cache.storages_;
+      if (!storages.empty()) {
+        StoragePtr storage = std::move(storages.back());
+        storages.pop_back();
+        return storage;
+      }
+    }
+    Memory::HugePageRegion* region = Memory::HugePageRegion::forBuffers();
+    if (region != nullptr) {
+      ASSERT(region->blockSize() == default_slice_size_);
+      void* block = region->allocate();
+      if (block != nullptr) {
+        return StoragePtr{static_cast<uint8_t*>(block)};
+      }
+    }
+  }
+  return StoragePtr{new uint8_t[size]};
+}
+
+void Slice::releaseStorage(StoragePtr storage, uint64_t size) {
+  if (size == default_slice_size_ && !slice_storage_cache_destroyed) {
+    auto& storages = slice_storage_cache.storages_;
+    if (storages.size() < max_cached_storages_) {
+      storages.push_back(std::move(storage));
+    }
+  }
+}
+
+uint32_t Slice::cachedStorages() {
+  return slice_storage_cache_destroyed ? 0 : slice_storage_cache.storages_.size();
+}
 
 void OwnedImpl::addImpl(const void* data, uint64_t size) {
   const char* src = static_cast<const char*>(data);
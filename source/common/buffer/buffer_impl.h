@@ -35,7 +35,12 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  // Releases backend storage to wherever allocateStorage() took it from.
+  struct StorageDeleter {
+    void operator()(uint8_t* storage) const;
+  };
+  using StoragePtr = std::unique_ptr<uint8_t[], StorageDeleter>;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -55,7 +60,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -111,6 +116,9 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      if (storage_ != nullptr) {
+        releaseStorage(std::move(storage_), capacity_);
+      }
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -129,7 +137,12 @@ public:
     return *this;
   }
 
-  ~Slice() { callAndClearDrainTrackersAndCharges(); }
+  ~Slice() {
+    callAndClearDrainTrackersAndCharges();
+    if (storage_ != nullptr) {
+      releaseStorage(std::move(storage_), capacity_);
+    }
+  }
 
   /**
    * @return true if the data in the slice is mutable
@@ -348,6 +361,9 @@ public:
 
   static constexpr uint32_t default_slice_size_ = 16384;
 
+  // The maximum number of default sized storages kept in the cache of each thread.
+  static constexpr uint32_t max_cached_storages_ = 32;
+
 public:
   /**
    * Compute a slice size big enough to hold a specified amount of data.
@@ -369,9 +385,33 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
   }
 
+  /**
+   * Allocate backend storage. Storage of the default slice size is taken from the cache of the
+   * calling thread if possible, which avoids a trip through the allocator for the slice size that
+   * streaming traffic churns through. Otherwise it comes from the huge page region for buffers, if
+   * one was set up with Memory::HugePageRegion::initializeForBuffers() and has room left.
+   * @param size the size of the storage in bytes.
+   * @return the new backend storage.
+   */
+  static StoragePtr allocateStorage(uint64_t size);
+
+  /**
+   * Release backend storage allocated with allocateStorage(). Storage of the default slice size is
+   * kept in the cache of the calling thread, up to max_cached_storages_. This is the thread that
+   * last owned the slice, which is not necessarily the one that allocated it.
+   * @param storage the backend storage to release.
+   * @param size the size of the storage in bytes.
+   */
+  static void releaseStorage(StoragePtr storage, uint64_t size);
+
+  /**
+   * @return the number of storages currently held in the cache of the calling thread.
+   */
+  static uint32_t cachedStorages();
+
 protected:
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
@@ -763,32 +803,19 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
+      // Return the storage that was not committed to the cache.
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
         if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
-          }
+          Slice::releaseStorage(std::move(r->mem_), r->len_);
         }
       }
     }
 
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
-
-      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
-      } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
-      }
-
-      return storage;
+      return Slice::newStorage(Slice::default_slice_size_);
     }
 
     absl::Span<Slice::SizedStorage> ownedStorages() override {
@@ -796,19 +823,15 @@ private:
     }
 
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
-
-  private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
+    ~OwnedImplReservationSlicesOwnerSingle() override {
+      if (owned_storage_.mem_ != nullptr) {
+        Slice::releaseStorage(std::move(owned_storage_.mem_), owned_storage_.len_);
+      }
+    }
+
     absl::Span<Slice::SizedStorage> ownedStorages() override {
       return absl::MakeSpan(&owned_storage_, 1);
     }
@@ -9,6 +9,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/stats/symbol_table.h"
 
 namespace Envoy {
 namespace Buffer {
@@ -26,6 +27,11 @@ void WatermarkBuffer::add(const void* data, uint64_t size) {
   checkHighAndOverflowWatermarks();
 }
 
+void WatermarkBuffer::addBufferFragment(BufferFragment& fragment) {
+  OwnedImpl::addBufferFragment(fragment);
+  checkHighAndOverflowWatermarks();
+}
+
 void WatermarkBuffer::add(absl::string_view data) {
   OwnedImpl::add(data);
   checkHighAndOverflowWatermarks();
@@ -231,11 +237,90 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   return num_streams_reset;
 }
 
+void WatermarkBufferFactory::initializeScheduler(Event::CallbackScheduler& scheduler) {
+  // A factory shared by dispatchers, which only happens in tests, keeps the first scheduler.
+  if (max_total_balance_ == 0 || reset_largest_accounts_cb_ != nullptr) {
+    return;
+  }
+  reset_largest_accounts_cb_ =
+      scheduler.createSchedulableCallback([this]() { resetLargestAccounts(); });
+}
+
+void WatermarkBufferFactory::onAccountCharged(uint64_t amount) {
+  if (balance_gauge_ != nullptr) {
+    balance_gauge_->add(amount);
+  }
+  if (max_total_balance_ == 0) {
+    return;
+  }
+  total_balance_ += amount;
+  if (total_balance_ > max_total_balance_ && !over_max_total_balance_ &&
+      reset_largest_accounts_cb_ != nullptr) {
+    over_max_total_balance_ = true;
+    // The account is being charged from within the stream, which can't be reset right here.
+    reset_largest_accounts_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void WatermarkBufferFactory::onAccountCredited(uint64_t amount) {
+  if (balance_gauge_ != nullptr) {
+    balance_gauge_->sub(amount);
+  }
+  if (max_total_balance_ == 0) {
+    return;
+  }
+  ASSERT(total_balance_ >= amount);
+  total_balance_ -= amount;
+  if (total_balance_ <= max_total_balance_) {
+    over_max_total_balance_ = false;
+  }
+}
+
+void WatermarkBufferFactory::resetLargestAccounts() {
+  for (uint32_t bucket = BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_; bucket-- > 0;) {
+    auto& accounts = size_class_account_sets_[bucket];
+    if (accounts.empty()) {
+      continue;
+    }
+    ENVOY_LOG_MISC(warn, "accounts hold {} bytes, over the maximum of {}: resetting {} streams in "
+                         "bucket {}.",
+                   total_balance_, max_total_balance_, accounts.size(), bucket);
+    uint32_t num_streams_reset = 0;
+    auto it = accounts.begin();
+    while (it != accounts.end() && num_streams_reset < kMaxNumberOfStreamsToResetPerInvocation) {
+      auto next = std::next(it);
+      // This will trigger an erase, which invalidates the iterator *it*. *next* is still valid.
+      (*it)->resetDownstream();
+      it = next;
+      ++num_streams_reset;
+    }
+    return;
+  }
+}
+
 WatermarkBufferFactory::WatermarkBufferFactory(
     const envoy::config::overload::v3::BufferFactoryConfig& config)
     : bitshift_(config.minimum_account_to_track_power_of_two()
                     ? config.minimum_account_to_track_power_of_two() - 1
-                    : kEffectivelyDisableTrackingBitshift) {}
+                    : kEffectivelyDisableTrackingBitshift),
+      max_total_balance_(
+          config.has_max_worker_account_bytes() ? config.max_worker_account_bytes().value() : 0) {}
+
+WatermarkBufferFactory::WatermarkBufferFactory(
+    const envoy::config::overload::v3::BufferFactoryConfig& config, Stats::Scope& scope)
+    : bitshift_(config.minimum_account_to_track_power_of_two()
+                    ? config.minimum_account_to_track_power_of_two() - 1
+                    : kEffectivelyDisableTrackingBitshift),
+      max_total_balance_(
+          config.has_max_worker_account_bytes() ? config.max_worker_account_bytes().value() : 0),
+      // Without tracking no account is created, so there is nothing to report.
+      balance_gauge_(bitshift_ == kEffectivelyDisableTrackingBitshift
+                         ? nullptr
+                         : &scope.gaugeFromStatName(
+                               Stats::StatNameManagedStorage("server.memory_buffer_accounts",
+                                                             scope.symbolTable())
+                                   .statName(),
+                               Stats::Gauge::ImportMode::NeverImport)) {}
 
 WatermarkBufferFactory::~WatermarkBufferFactory() {
   for (auto& account_set : size_class_account_sets_) {
@@ -279,6 +364,7 @@ void BufferMemoryAccountImpl::updateAccountClass() {
 void BufferMemoryAccountImpl::credit(uint64_t amount) {
   ASSERT(buffer_memory_allocated_ >= amount);
   buffer_memory_allocated_ -= amount;
+  factory_->onAccountCredited(amount);
   updateAccountClass();
 }
 
@@ -286,6 +372,7 @@ void BufferMemoryAccountImpl::charge(uint64_t amount) {
   // Check overflow
   ASSERT(std::numeric_limits<uint64_t>::max() - buffer_memory_allocated_ >= amount);
   buffer_memory_allocated_ += amount;
+  factory_->onAccountCharged(amount);
   updateAccountClass();
 }
 
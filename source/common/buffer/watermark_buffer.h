@@ -6,6 +6,8 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
 #include "envoy/config/overload/v3/overload.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats.h"
 
 #include "source/common/buffer/buffer_impl.h"
 
@@ -30,6 +32,7 @@ public:
   // Override all functions from Instance which can result in changing the size
   // of the underlying buffer.
   void add(const void* data, uint64_t size) override;
+  void addBufferFragment(BufferFragment& fragment) override;
   void add(absl::string_view data) override;
   void add(const Instance& data) override;
   void prepend(absl::string_view data) override;
@@ -181,6 +184,12 @@ private:
  *    *BufferMemoryAccountImpl::balanceToClassIndex()* for details on the memory
  *    class for a given account balance.
  *
+ * If a maximum for the balance of all the accounts is configured, the factory
+ * also sums the balances of its accounts, and once they are over the maximum it
+ * resets the streams of the most expensive bucket on the next iteration of the
+ * event loop of its thread, rather than waiting for the overload manager. No
+ * more streams are reset until the balances drop back under the maximum.
+ *
  * TODO(kbaichoo): Update this documentation when we make the minimum account
  * threshold configurable.
  *
@@ -188,6 +197,10 @@ private:
 class WatermarkBufferFactory : public WatermarkFactory {
 public:
   WatermarkBufferFactory(const envoy::config::overload::v3::BufferFactoryConfig& config);
+  // The balances of the accounts are also added to the server.memory_buffer_accounts gauge of the
+  // scope, which is shared by the factories of all the workers.
+  WatermarkBufferFactory(const envoy::config::overload::v3::BufferFactoryConfig& config,
+                         Stats::Scope& scope);
 
   // Buffer::WatermarkFactory
   ~WatermarkBufferFactory() override;
@@ -200,6 +213,12 @@ public:
 
   BufferMemoryAccountSharedPtr createAccount(Http::StreamResetHandler& reset_handler) override;
   uint64_t resetAccountsGivenPressure(float pressure) override;
+  void initializeScheduler(Event::CallbackScheduler& scheduler) override;
+
+  // Called by BufferMemoryAccountImpls created by the factory when they are
+  // charged or credited.
+  void onAccountCharged(uint64_t amount);
+  void onAccountCredited(uint64_t amount);
 
   // Called by BufferMemoryAccountImpls created by the factory on account class
   // updated.
@@ -221,6 +240,19 @@ protected:
   // How much to bit shift right balances to test whether the account should be
   // tracked in *size_class_account_sets_*.
   const uint32_t bitshift_;
+
+private:
+  // Resets the streams of the most expensive bucket holding any.
+  void resetLargestAccounts();
+
+  // The maximum for the sum of the balances of the accounts, or 0 if there is
+  // none, in which case the balances are not summed.
+  const uint64_t max_total_balance_;
+  uint64_t total_balance_{};
+  Stats::Gauge* const balance_gauge_{};
+  Event::SchedulableCallbackPtr reset_largest_accounts_cb_;
+  // Whether the accounts went over the maximum since they were last under it.
+  bool over_max_total_balance_{};
 };
 
 } // namespace Buffer
@@ -44,7 +44,11 @@ bool checkForTtl(absl::string_view& contents) {
 KeyValueStoreBase::KeyValueStoreBase(Event::Dispatcher& dispatcher,
                                      std::chrono::milliseconds flush_interval, uint32_t max_entries)
     : max_entries_(max_entries), flush_timer_(dispatcher.createTimer([this, flush_interval]() {
-        flush();
+        // Only rewrite the store when it changed since the last periodic flush.
+        if (dirty_) {
+          dirty_ = false;
+          flush();
+        }
         flush_timer_->enableTimer(flush_interval);
       })),
       ttl_manager_([this](const std::vector<std::string>& expired) { onExpiredKeys(expired); },
@@ -123,6 +127,7 @@ void KeyValueStoreBase::addOrUpdate(absl::string_view key_view, absl::string_vie
     store_.pop_front();
   }
 
+  dirty_ = true;
   if (!flush_timer_->enabled()) {
     flush();
   }
@@ -133,6 +138,7 @@ void KeyValueStoreBase::onExpiredKeys(const std::vector<std::string>& keys) {
   for (const auto& key : keys) {
     store_.erase(std::string(key));
   }
+  dirty_ = true;
   if (!flush_timer_->enabled()) {
     flush();
   }
@@ -142,6 +148,7 @@ void KeyValueStoreBase::remove(absl::string_view key) {
   ENVOY_BUG(!under_iterate_, "remove under the stack of iterate");
   ttl_manager_.clear(std::string(key));
   store_.erase(std::string(key));
+  dirty_ = true;
   if (!flush_timer_->enabled()) {
     flush();
   }
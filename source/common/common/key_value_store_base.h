@@ -56,6 +56,8 @@ private:
   const Event::TimerPtr flush_timer_;
   Config::TtlManager ttl_manager_;
   KeyValueMap store_;
+  // Whether the store changed since the last periodic flush.
+  bool dirty_{};
   // Used for validation only.
   mutable bool under_iterate_{};
   TimeSource& time_source_;
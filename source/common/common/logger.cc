@@ -76,23 +76,45 @@ void StderrSinkDelegate::flush() {
   std::cerr << std::flush;
 }
 
+namespace {
+
+// A thread's copy of the formatter of a DelegatingLogSink, see
+// DelegatingLogSink::threadLocalFormatter().
+struct ThreadLocalFormatter {
+  uint64_t generation_{0};
+  std::unique_ptr<spdlog::formatter> formatter_;
+};
+
+std::atomic<uint64_t> next_formatter_generation{1};
+
+} // namespace
+
 void DelegatingLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
   absl::MutexLock lock(&format_mutex_);
   formatter_ = std::move(formatter);
+  formatter_generation_ = next_formatter_generation++;
+}
+
+spdlog::formatter* DelegatingLogSink::threadLocalFormatter() {
+  static thread_local ThreadLocalFormatter thread_local_formatter;
+  if (thread_local_formatter.generation_ != formatter_generation_) {
+    absl::MutexLock lock(&format_mutex_);
+    thread_local_formatter.formatter_ = formatter_ ? formatter_->clone() : nullptr;
+    thread_local_formatter.generation_ = formatter_generation_;
+  }
+  return thread_local_formatter.formatter_.get();
 }
 
 void DelegatingLogSink::log(const spdlog::details::log_msg& msg) {
-  absl::ReleasableMutexLock lock(&format_mutex_);
   absl::string_view msg_view = absl::string_view(msg.payload.data(), msg.payload.size());
 
   // This memory buffer must exist in the scope of the entire function,
   // otherwise the string_view will refer to memory that is already free.
   spdlog::memory_buf_t formatted;
-  if (formatter_) {
-    formatter_->format(msg, formatted);
+  if (spdlog::formatter* formatter = threadLocalFormatter(); formatter != nullptr) {
+    formatter->format(msg, formatted);
     msg_view = absl::string_view(formatted.data(), formatted.size());
   }
-  lock.Release();
 
   auto log_to_sink = [this, msg_view, msg](SinkDelegate& sink) {
     if (should_escape_) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdint>
@@ -265,11 +266,17 @@ private:
   SinkDelegate** tlsSink();
   void setTlsDelegate(SinkDelegate* sink);
   SinkDelegate* tlsDelegate();
+  // Returns the calling thread's copy of formatter_, or nullptr if there is no formatter.
+  // Formatters are not thread safe, so each thread formats with its own copy rather than all
+  // threads serializing on format_mutex_. The copy is made again whenever formatter_ is replaced.
+  spdlog::formatter* threadLocalFormatter();
 
   SinkDelegate* sink_ ABSL_GUARDED_BY(sink_mutex_){nullptr};
   absl::Mutex sink_mutex_;
   std::unique_ptr<StderrSinkDelegate> stderr_sink_; // Builtin sink to use as a last resort.
   std::unique_ptr<spdlog::formatter> formatter_ ABSL_GUARDED_BY(format_mutex_);
+  // Identifies the current formatter_. Unique across all sinks, 0 when no formatter was ever set.
+  std::atomic<uint64_t> formatter_generation_{0};
   absl::Mutex format_mutex_;
   bool should_escape_{false};
 };
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+
+// Hands out fixed size memory blocks from slabs that grow geometrically, so
+// that node based containers holding a handful to a few dozen elements need a
+// few slab allocations instead of one heap allocation per element. Released
+// blocks are kept on a free list for reuse, and all memory is returned when the
+// pool is destroyed.
+//
+// The block size is that of the first allocation. Allocations of any other size
+// are passed through to the global allocator, so that a pool can back an
+// allocator which is rebound to several types. The pool must outlive every
+// block allocated from it and is not thread safe.
+class NodePool : NonCopyable {
+public:
+  explicit NodePool(uint32_t initial_slab_nodes = 4, uint32_t max_slab_nodes = 32)
+      : next_slab_nodes_(initial_slab_nodes), max_slab_nodes_(max_slab_nodes) {
+    ASSERT(initial_slab_nodes > 0 && initial_slab_nodes <= max_slab_nodes);
+  }
+
+  void* allocate(size_t size, size_t alignment) {
+    if (node_size_ == 0 && alignment <= alignof(std::max_align_t)) {
+      node_size_ = size;
+    }
+    if (size != node_size_ || alignment > alignof(std::max_align_t)) {
+      return ::operator new(size);
+    }
+    if (free_list_ != nullptr) {
+      FreeNode* node = free_list_;
+      free_list_ = node->next_;
+      return node;
+    }
+    if (slab_remaining_ == 0) {
+      newSlab();
+    }
+    void* node = slab_cursor_;
+    slab_cursor_ += nodeStride();
+    --slab_remaining_;
+    return node;
+  }
+
+  void deallocate(void* p, size_t size) {
+    if (size != node_size_) {
+      ::operator delete(p);
+      return;
+    }
+    FreeNode* node = static_cast<FreeNode*>(p);
+    node->next_ = free_list_;
+    free_list_ = node;
+  }
+
+  /**
+   * @return the number of slabs allocated so far.
+   */
+  size_t numSlabs() const { return slabs_.size(); }
+
+private:
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  // Keeps every block in a slab suitably aligned and large enough to hold a free list link.
+  size_t nodeStride() const {
+    constexpr size_t alignment = alignof(std::max_align_t);
+    const size_t size = std::max(node_size_, sizeof(FreeNode));
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  void newSlab() {
+    // operator new[] returns memory aligned for std::max_align_t.
+    slabs_.emplace_back(new char[nodeStride() * next_slab_nodes_]);
+    slab_cursor_ = slabs_.back().get();
+    slab_remaining_ = next_slab_nodes_;
+    next_slab_nodes_ = std::min(next_slab_nodes_ * 2, max_slab_nodes_);
+  }
+
+  size_t node_size_{0};
+  FreeNode* free_list_{nullptr};
+  char* slab_cursor_{nullptr};
+  uint32_t slab_remaining_{0};
+  uint32_t next_slab_nodes_;
+  const uint32_t max_slab_nodes_;
+  absl::InlinedVector<std::unique_ptr<char[]>, 4> slabs_;
+};
+
+// Standard library allocator drawing from a NodePool, e.g. for std::list.
+template <class T> class NodePoolAllocator {
+public:
+  using value_type = T;
+
+  explicit NodePoolAllocator(NodePool& pool) : pool_(&pool) {}
+  template <class U> NodePoolAllocator(const NodePoolAllocator<U>& other) : pool_(other.pool_) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T* p, size_t n) { pool_->deallocate(p, n * sizeof(T)); }
+
+  template <class U> bool operator==(const NodePoolAllocator<U>& other) const {
+    return pool_ == other.pool_;
+  }
+  template <class U> bool operator!=(const NodePoolAllocator<U>& other) const {
+    return pool_ != other.pool_;
+  }
+
+private:
+  template <class U> friend class NodePoolAllocator;
+
+  NodePool* pool_;
+};
+
+} // namespace Envoy
@@ -4,6 +4,7 @@
 #include "absl/strings/str_cat.h"
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/syscall.h>
 #endif
 
@@ -39,8 +40,10 @@ class ThreadImplPosix : public Thread {
 public:
   ThreadImplPosix(std::function<void()> thread_routine, OptionsOptConstRef options)
       : thread_routine_(std::move(thread_routine)) {
+    absl::optional<uint32_t> cpu;
     if (options) {
       name_ = options->name_.substr(0, PTHREAD_MAX_THREADNAME_LEN_INCLUDING_NULL_BYTE - 1);
+      cpu = options->cpu_;
     }
     RELEASE_ASSERT(Logger::Registry::initialized(), "");
     const int rc = pthread_create(
@@ -52,6 +55,10 @@ public:
         this);
     RELEASE_ASSERT(rc == 0, "");
 
+    if (cpu.has_value()) {
+      setCpuAffinity(cpu.value());
+    }
+
 #if SUPPORTS_PTHREAD_NAMING
     // If the name was not specified, get it from the OS. If the name was
     // specified, write it into the thread, and assert that the OS sees it the
@@ -93,6 +100,27 @@ public:
   }
 
 private:
+  // Pins the thread to a single CPU. Failing to do so is not fatal: the thread then keeps running
+  // on any CPU allowed by the process.
+  void setCpuAffinity(uint32_t cpu) {
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+      ENVOY_LOG_MISC(warn, "Cannot pin thread `{}' to CPU {}: CPU index is too large", name_, cpu);
+      return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    const int set_affinity_rc = pthread_setaffinity_np(thread_handle_, sizeof(cpu_set), &cpu_set);
+    if (set_affinity_rc != 0) {
+      ENVOY_LOG_MISC(warn, "Error {} pinning thread `{}' to CPU {}", set_affinity_rc, name_, cpu);
+    }
+#else
+    ENVOY_LOG_MISC(warn, "Pinning thread `{}' to CPU {} is not supported on this platform", name_,
+                   cpu);
+#endif
+  }
+
 #if SUPPORTS_PTHREAD_NAMING
   // Attempts to get the name from the operating system, returning true and
   // updating 'name' if successful. Note that during normal operation this
@@ -8,20 +8,74 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/macros.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Regex {
 
+namespace {
+
+// Compiled regexes by pattern. RE2 objects are immutable once built, so the matchers compiled from
+// the same pattern, such as a header matcher repeated across many routes, share one program instead
+// of each compiling and holding their own. Entries are removed when their last matcher goes away.
+class CompiledRegexCache {
+public:
+  std::shared_ptr<const re2::RE2> get(const std::string& regex) {
+    {
+      absl::MutexLock lock(&mutex_);
+      auto it = regexes_.find(regex);
+      if (it != regexes_.end()) {
+        std::shared_ptr<const re2::RE2> compiled = it->second.lock();
+        if (compiled != nullptr) {
+          return compiled;
+        }
+      }
+    }
+
+    // Compile without holding the lock, so that other patterns can be looked up meanwhile.
+    std::shared_ptr<const re2::RE2> compiled(new re2::RE2(regex, re2::RE2::Quiet),
+                                             [this](const re2::RE2* program) {
+                                               release(program);
+                                               delete program;
+                                             });
+    if (compiled->ok()) {
+      absl::MutexLock lock(&mutex_);
+      regexes_[regex] = compiled;
+    }
+    return compiled;
+  }
+
+private:
+  void release(const re2::RE2* compiled) {
+    absl::MutexLock lock(&mutex_);
+    auto it = regexes_.find(compiled->pattern());
+    // The entry may already point to a program compiled again after this one expired.
+    if (it != regexes_.end() && it->second.expired()) {
+      regexes_.erase(it);
+    }
+  }
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<const re2::RE2>> regexes_ ABSL_GUARDED_BY(mutex_);
+};
+
+CompiledRegexCache& compiledRegexCache() { MUTABLE_CONSTRUCT_ON_FIRST_USE(CompiledRegexCache); }
+
+} // namespace
+
 CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
                                                  bool do_program_size_check)
-    : regex_(regex, re2::RE2::Quiet) {
-  if (!regex_.ok()) {
-    throw EnvoyException(regex_.error());
+    : regex_(compiledRegexCache().get(regex)) {
+  if (!regex_->ok()) {
+    throw EnvoyException(regex_->error());
   }
 
   if (do_program_size_check && Runtime::isRuntimeInitialized()) {
-    const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+    const uint32_t regex_program_size = static_cast<uint32_t>(regex_->ProgramSize());
     const uint32_t max_program_size_error_level =
         Runtime::getInteger("re2.max_program_size.error_level", 100);
     if (regex_program_size > max_program_size_error_level) {
@@ -45,7 +99,7 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
 CompiledGoogleReMatcher::CompiledGoogleReMatcher(
     const envoy::type::matcher::v3::RegexMatcher& config)
     : CompiledGoogleReMatcher(config.regex(), !config.google_re2().has_max_program_size()) {
-  const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+  const uint32_t regex_program_size = static_cast<uint32_t>(regex_->ProgramSize());
 
   // Check if the deprecated field max_program_size is set first, and follow the old logic if so.
   if (config.google_re2().has_max_program_size()) {
@@ -29,19 +29,20 @@ public:
 
   // CompiledMatcher
   bool match(absl::string_view value) const override {
-    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), regex_);
+    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), *regex_);
   }
 
   // CompiledMatcher
   std::string replaceAll(absl::string_view value, absl::string_view substitution) const override {
     std::string result = std::string(value);
-    re2::RE2::GlobalReplace(&result, regex_,
+    re2::RE2::GlobalReplace(&result, *regex_,
                             re2::StringPiece(substitution.data(), substitution.size()));
     return result;
   }
 
 private:
-  const re2::RE2 regex_;
+  // Shared with the other matchers compiled from the same pattern.
+  const std::shared_ptr<const re2::RE2> regex_;
 };
 
 class GoogleReEngine : public Engine {
@@ -0,0 +1,50 @@
+#include "source/common/common/spsc_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+
+SpscRingBuffer::SpscRingBuffer(uint64_t capacity)
+    : capacity_(capacity), data_(new char[capacity]) {
+  ASSERT(capacity_ > 0 && (capacity_ & (capacity_ - 1)) == 0);
+}
+
+bool SpscRingBuffer::write(absl::string_view data) {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  if (capacity_ - (head - tail) < data.size()) {
+    return false;
+  }
+
+  const uint64_t offset = head & (capacity_ - 1);
+  const uint64_t first = std::min<uint64_t>(data.size(), capacity_ - offset);
+  memcpy(data_.get() + offset, data.data(), first);
+  memcpy(data_.get(), data.data() + first, data.size() - first);
+  // Publishes the copied data to the consumer.
+  head_.store(head + data.size(), std::memory_order_release);
+  return true;
+}
+
+uint64_t SpscRingBuffer::drainTo(Buffer::Instance& output) {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  const uint64_t length = head - tail;
+  if (length == 0) {
+    return 0;
+  }
+
+  const uint64_t offset = tail & (capacity_ - 1);
+  const uint64_t first = std::min<uint64_t>(length, capacity_ - offset);
+  output.add(data_.get() + offset, first);
+  if (first < length) {
+    output.add(data_.get(), length - first);
+  }
+  // Hands the space back to the producer once the data has been copied out.
+  tail_.store(head, std::memory_order_release);
+  return length;
+}
+
+} // namespace Envoy
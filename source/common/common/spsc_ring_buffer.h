@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/buffer/buffer.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+
+/**
+ * A fixed capacity byte ring buffer with a single producer thread and a single consumer thread.
+ * Neither side ever blocks or takes a lock, which makes it suitable for handing data from a
+ * worker thread to a background thread.
+ */
+class SpscRingBuffer {
+public:
+  /**
+   * @param capacity supplies the capacity in bytes. It must be a power of two.
+   */
+  explicit SpscRingBuffer(uint64_t capacity);
+
+  /**
+   * Append data to the ring. Must only be called from the producer thread.
+   * @param data supplies the data to append.
+   * @return false if there isn't room for all of the data, in which case nothing is appended.
+   */
+  bool write(absl::string_view data);
+
+  /**
+   * Move all the data appended so far to a buffer. Must only be called from the consumer thread.
+   * @param output supplies the buffer to append the data to.
+   * @return the number of bytes moved.
+   */
+  uint64_t drainTo(Buffer::Instance& output);
+
+  /**
+   * @return the number of bytes that were appended but not drained yet. This is a snapshot that
+   *         may be stale by the time it is used if the other side is active.
+   */
+  uint64_t readableBytes() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  uint64_t capacity() const { return capacity_; }
+
+private:
+  const uint64_t capacity_;
+  const std::unique_ptr<char[]> data_;
+  // Both positions grow monotonically and are reduced modulo the capacity when indexing. They are
+  // on separate cache lines so that the producer and the consumer don't invalidate each other's
+  // lines on every access.
+  alignas(64) std::atomic<uint64_t> head_{0}; // Only written by the producer.
+  alignas(64) std::atomic<uint64_t> tail_{0}; // Only written by the consumer.
+};
+
+} // namespace Envoy
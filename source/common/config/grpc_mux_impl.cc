@@ -7,6 +7,7 @@
 #include "source/common/config/xds_source_id.h"
 #include "source/common/memory/utils.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/btree_map.h"
 #include "absl/container/node_hash_set.h"
@@ -290,7 +291,13 @@ void GrpcMuxImpl::onDiscoveryResponse(
   same_type_resume = pause(type_url);
   TRY_ASSERT_MAIN_THREAD {
     std::vector<DecodedResourcePtr> resources;
-    OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+    OpaqueResourceDecoder* resource_decoder = api_state.watches_.front()->resource_decoder_.get();
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.xds_reuse_unchanged_resources")) {
+      api_state.reusing_decoder_.startResponse(api_state.watches_.front()->resource_decoder_);
+      resource_decoder = &api_state.reusing_decoder_;
+    } else {
+      api_state.reusing_decoder_.clear();
+    }
 
     for (const auto& resource : message->resources()) {
       // TODO(snowp): Check the underlying type when the resource is a Resource.
@@ -302,7 +309,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
       }
 
       auto decoded_resource =
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
+          DecodedResourceImpl::fromResource(*resource_decoder, resource, message->version_info());
 
       if (!isHeartbeatResource(type_url, *decoded_resource)) {
         resources.emplace_back(std::move(decoded_resource));
@@ -311,6 +318,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
 
     processDiscoveryResources(resources, api_state, type_url, message->version_info(),
                               /*call_delegate=*/true);
+    api_state.reusing_decoder_.finishResponse(/*accepted=*/true);
 
     // Processing point when resources are successfully ingested.
     if (xds_config_tracker_.has_value()) {
@@ -319,6 +327,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
   }
   END_TRY
   catch (const EnvoyException& e) {
+    api_state.reusing_decoder_.finishResponse(/*accepted=*/false);
     for (auto watch : api_state.watches_) {
       watch->callbacks_.onConfigUpdateFailed(
           Envoy::Config::ConfigUpdateFailureReason::UpdateRejected, &e);
@@ -21,6 +21,7 @@
 #include "source/common/config/api_version.h"
 #include "source/common/config/custom_config_validators.h"
 #include "source/common/config/grpc_stream.h"
+#include "source/common/config/reusing_resource_decoder.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_context_params.h"
@@ -184,6 +185,8 @@ private:
     // The identifier for the server that sent the most recent response, or
     // empty if there is none.
     std::string control_plane_identifier_{};
+    // Reuses the resources which are unchanged since the previous response.
+    ReusingResourceDecoder reusing_decoder_;
   };
 
   bool isHeartbeatResource(const std::string& type_url, const DecodedResource& resource) {
@@ -0,0 +1,71 @@
+#include "source/common/config/reusing_resource_decoder.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Config {
+
+void ReusingResourceDecoder::startResponse(OpaqueResourceDecoderSharedPtr decoder) {
+  ASSERT(decoder_ == nullptr);
+  if (decoder != previous_decoder_) {
+    previous_.clear();
+    previous_decoder_ = decoder;
+  }
+  decoder_ = std::move(decoder);
+}
+
+void ReusingResourceDecoder::finishResponse(bool accepted) {
+  if (decoder_ == nullptr) {
+    return;
+  }
+  if (accepted) {
+    previous_.swap(current_);
+  } else {
+    previous_.merge(current_);
+  }
+  current_.clear();
+  decoder_ = nullptr;
+}
+
+void ReusingResourceDecoder::clear() {
+  previous_.clear();
+  current_.clear();
+  previous_decoder_ = nullptr;
+}
+
+ProtobufTypes::MessagePtr ReusingResourceDecoder::decodeResource(const ProtobufWkt::Any& resource) {
+  ASSERT(decoder_ != nullptr);
+  // A synthetic empty resource is not worth remembering.
+  if (resource.type_url().empty()) {
+    return decoder_->decodeResource(resource);
+  }
+
+  auto it = current_.find(resource.value());
+  if (it == current_.end()) {
+    auto previous_it = previous_.find(resource.value());
+    if (previous_it != previous_.end()) {
+      it = current_.insert(previous_.extract(previous_it)).position;
+    }
+  }
+  if (it != current_.end() && it->second.type_url_ == resource.type_url()) {
+    return copy(*it->second.message_);
+  }
+
+  ProtobufTypes::MessagePtr message = decoder_->decodeResource(resource);
+  current_.insert_or_assign(resource.value(), DecodedPayload{resource.type_url(), copy(*message)});
+  return message;
+}
+
+std::string ReusingResourceDecoder::resourceName(const Protobuf::Message& resource) {
+  ASSERT(decoder_ != nullptr);
+  return decoder_->resourceName(resource);
+}
+
+ProtobufTypes::MessagePtr ReusingResourceDecoder::copy(const Protobuf::Message& message) {
+  ProtobufTypes::MessagePtr copied(message.New());
+  copied->CopyFrom(message);
+  return copied;
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/config/subscription.h"
+
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Decodes the resources of the state of the world responses of a type. The resources whose payload
+ * is unchanged since the previous response are copied from the resources decoded for it, rather
+ * than decoded and validated again. Only the resources of the last accepted response are kept, as
+ * each response carries the whole state of the type.
+ */
+class ReusingResourceDecoder : public OpaqueResourceDecoder {
+public:
+  /**
+   * Starts the decoding of a response.
+   * @param decoder supplies the decoder of the watches of the type, which decodes the resources
+   *        whose payload changed. The resources are not reused across decoders.
+   */
+  void startResponse(OpaqueResourceDecoderSharedPtr decoder);
+
+  /**
+   * Finishes the decoding of a response. The resources of the previous responses which were not in
+   * the response are dropped if it was accepted, and kept if it was rejected, as the next response
+   * may still carry them. Does nothing if no response is being decoded.
+   * @param accepted supplies whether the response was accepted.
+   */
+  void finishResponse(bool accepted);
+
+  /**
+   * Drops all the decoded resources.
+   */
+  void clear();
+
+  /**
+   * @return the number of decoded resources kept for the next response.
+   */
+  size_t size() const { return previous_.size(); }
+
+  // Config::OpaqueResourceDecoder
+  ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) override;
+  std::string resourceName(const Protobuf::Message& resource) override;
+
+private:
+  struct DecodedPayload {
+    std::string type_url_;
+    ProtobufTypes::MessagePtr message_;
+  };
+  // Keyed by the serialized payload of the resource.
+  using DecodedPayloads = absl::flat_hash_map<std::string, DecodedPayload>;
+
+  static ProtobufTypes::MessagePtr copy(const Protobuf::Message& message);
+
+  // Set while a response is decoded.
+  OpaqueResourceDecoderSharedPtr decoder_;
+  // The decoder of the kept resources.
+  OpaqueResourceDecoderSharedPtr previous_decoder_;
+  DecodedPayloads previous_;
+  DecodedPayloads current_;
+};
+
+} // namespace Config
+} // namespace Envoy
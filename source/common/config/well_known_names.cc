@@ -16,9 +16,6 @@ std::string expandRegex(const std::string& regex) {
   return absl::StrReplaceAll(
       regex, {// Regex to look for either IPv4 or IPv6 addresses plus port number after underscore.
               {"<ADDRESS>", R"((?:(?:\d{1,3}\.\d{1,3}\.\d{1,3}\.\d{1,3}|\[[a-fA-F_\d]+\])_\d+))"},
-              // Cipher names can contain alphanumerics with dashes and
-              // underscores.
-              {"<CIPHER>", R"([\w-]+)"},
               // A generic name can contain any character except dots.
               {"<TAG_VALUE>", TAG_VALUE_REGEX},
               // Route names may contain dots in addition to alphanumerics and
@@ -81,8 +78,8 @@ TagNameValues::TagNameValues() {
 
   // http.[<stat_prefix>.]dynamodb.table.(<table_name>.)* or
   // http.[<stat_prefix>.]dynamodb.error.(<table_name>.)*
-  addRe2(DYNAMO_TABLE, R"(^http\.<TAG_VALUE>\.dynamodb.(?:table|error)\.((<TAG_VALUE>)\.))",
-         ".dynamodb.");
+  addTokenized(DYNAMO_TABLE, "http.*.dynamodb.table.$.*.**");
+  addTokenized(DYNAMO_TABLE, "http.*.dynamodb.error.$.*.**");
 
   // mongo.[<stat_prefix>.]collection.(<collection>.)query.*
   addTokenized(MONGO_COLLECTION, "mongo.*.collection.$.**.query.*");
@@ -103,11 +100,10 @@ TagNameValues::TagNameValues() {
   addTokenized(FAULT_DOWNSTREAM_CLUSTER, "http.*.fault.$.**");
 
   // listener.[<address>.]ssl.cipher.(<cipher>)
-  addRe2(SSL_CIPHER, R"(^listener\..*?\.ssl\.cipher(\.(<CIPHER>))$)");
+  addTokenized(SSL_CIPHER, "listener.*.**.ssl.cipher.$");
 
   // cluster.[<cluster_name>.]ssl.ciphers.(<cipher>)
-  addRe2(SSL_CIPHER_SUITE, R"(^cluster\.<TAG_VALUE>\.ssl\.ciphers(\.(<CIPHER>))$)",
-         ".ssl.ciphers.");
+  addTokenized(SSL_CIPHER_SUITE, "cluster.*.ssl.ciphers.$");
 
   // cluster.[<route_target_cluster>.]grpc.(<grpc_service>.)*
   addTokenized(GRPC_BRIDGE_SERVICE, "cluster.*.grpc.$.**");
@@ -128,9 +124,8 @@ TagNameValues::TagNameValues() {
   addTokenized(CLUSTER_NAME, "cluster.$.**");
 
   // listener.[<address>.]http.(<stat_prefix>.)*
-  // The <address> part can be anything here (.*?) for the sake of a simpler
-  // internal state of the regex which performs better.
-  addRe2(HTTP_CONN_MANAGER_PREFIX, R"(^listener\..*?\.http\.((<TAG_VALUE>)\.))", ".http.");
+  // The <address> part can be any number of tokens, as IPv4 addresses contain dots.
+  addTokenized(HTTP_CONN_MANAGER_PREFIX, "listener.*.**.http.$.*.**");
 
   // Extract ext_authz stat_prefix field
   // cluster.[<cluster>.]ext_authz.[<ext_authz_prefix>.]*
@@ -1,7 +1,9 @@
 #include "source/common/config/xds_mux/sotw_subscription_state.h"
 
+#include "source/common/common/cleanup.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_source_id.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Config {
@@ -46,6 +48,15 @@ void SotwSubscriptionState::markStreamFresh() {
 void SotwSubscriptionState::handleGoodResponse(
     const envoy::service::discovery::v3::DiscoveryResponse& message) {
   std::vector<DecodedResourcePtr> non_heartbeat_resources;
+  OpaqueResourceDecoder* resource_decoder = resource_decoder_.get();
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.xds_reuse_unchanged_resources")) {
+    reusing_decoder_.startResponse(resource_decoder_);
+    resource_decoder = &reusing_decoder_;
+  } else {
+    reusing_decoder_.clear();
+  }
+  bool accepted = false;
+  Cleanup finish_response([this, &accepted]() { reusing_decoder_.finishResponse(accepted); });
 
   {
     const auto scoped_update = ttl_.scopedTtlUpdate();
@@ -59,7 +70,7 @@ void SotwSubscriptionState::handleGoodResponse(
       }
 
       auto decoded_resource =
-          DecodedResourceImpl::fromResource(*resource_decoder_, any, message.version_info());
+          DecodedResourceImpl::fromResource(*resource_decoder, any, message.version_info());
       setResourceTtl(*decoded_resource);
       if (isHeartbeatResource(*decoded_resource, message.version_info())) {
         continue;
@@ -72,6 +83,7 @@ void SotwSubscriptionState::handleGoodResponse(
   // support passing of decoded resources. This would also avoid a resource copy above.
   callbacks().onConfigUpdate(non_heartbeat_resources, message.version_info());
   // Now that we're passed onConfigUpdate() without an exception thrown, we know we're good.
+  accepted = true;
   last_good_version_info_ = message.version_info();
   last_good_nonce_ = message.nonce();
 
@@ -6,6 +6,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hash.h"
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/reusing_resource_decoder.h"
 #include "source/common/config/xds_mux/subscription_state.h"
 
 #include "absl/types/optional.h"
@@ -53,6 +54,8 @@ private:
   bool isHeartbeatResource(const DecodedResource& resource, const std::string& version);
 
   OpaqueResourceDecoderSharedPtr resource_decoder_;
+  // Reuses the resources which are unchanged since the previous response.
+  ReusingResourceDecoder reusing_decoder_;
 
   // The version_info carried by the last accepted DiscoveryResponse.
   // Remains empty until one is accepted.
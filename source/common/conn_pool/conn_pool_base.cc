@@ -1,5 +1,7 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <algorithm>
+
 #include "source/common/common/assert.h"
 #include "source/common/common/debug_recursion_checker.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -17,6 +19,19 @@ namespace {
   }
   return ret;
 }
+
+// Weight of a new sample in the adaptive preconnect moving averages.
+constexpr double AdaptivePreconnectEwmaWeight = 0.2;
+// Adaptive preconnect anticipates at most this many streams per stream in flight, the same limit
+// that applies to per_upstream_preconnect_ratio.
+constexpr double MaxAdaptivePreconnectRatio = 3.0;
+
+double updateEwma(double average, double sample) {
+  if (average == 0) {
+    return sample;
+  }
+  return AdaptivePreconnectEwmaWeight * sample + (1 - AdaptivePreconnectEwmaWeight) * average;
+}
 } // namespace
 
 ConnPoolImplBase::ConnPoolImplBase(
@@ -98,7 +113,8 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
     return shouldConnect(pending_streams_.size(), num_active_streams_, connecting_stream_capacity_,
-                         perUpstreamPreconnectRatio());
+                         perUpstreamPreconnectRatio()) ||
+           shouldAdaptivelyPreconnect();
   }
 }
 
@@ -106,6 +122,32 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+bool ConnPoolImplBase::shouldAdaptivelyPreconnect() const {
+  if (!host_->cluster().adaptivePreconnect() || stream_interval_ewma_ == 0) {
+    return false;
+  }
+  // The number of streams expected to arrive while a new connection is being established.
+  const size_t streams = pending_streams_.size() + num_active_streams_;
+  const double anticipated_streams = std::min(connect_latency_ewma_ / stream_interval_ewma_,
+                                              streams * (MaxAdaptivePreconnectRatio - 1));
+  return streams + anticipated_streams > connecting_stream_capacity_ + num_active_streams_;
+}
+
+void ConnPoolImplBase::recordStreamArrival() {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (last_stream_time_.has_value()) {
+    const std::chrono::duration<double> interval = now - last_stream_time_.value();
+    // Streams arriving within the same clock tick still count towards the rate.
+    stream_interval_ewma_ = updateEwma(stream_interval_ewma_, std::max(interval.count(), 1e-6));
+  }
+  last_stream_time_ = now;
+}
+
+void ConnPoolImplBase::recordConnectLatency(std::chrono::milliseconds latency) {
+  const std::chrono::duration<double> seconds = latency;
+  connect_latency_ewma_ = updateEwma(connect_latency_ewma_, seconds.count());
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ASSERT(!is_draining_for_deletion_);
   ConnPoolImplBase::ConnectionResult result;
@@ -260,6 +302,10 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(static_cast<ssize_t>(connecting_stream_capacity_) ==
          connectingCapacity(connecting_clients_) +
              connectingCapacity(early_data_clients_)); // O(n) debug check.
+  if (host_->cluster().adaptivePreconnect()) {
+    recordStreamArrival();
+  }
+
   if (!ready_clients_.empty()) {
     ActiveClient& client = *ready_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing fully connected connection", client);
@@ -564,6 +610,9 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ASSERT(connecting_stream_capacity_ >= client.currentUnusedCapacity());
     connecting_stream_capacity_ -= client.currentUnusedCapacity();
     client.has_handshake_completed_ = true;
+    if (host_->cluster().adaptivePreconnect()) {
+      recordConnectLatency(client.conn_connect_ms_->elapsed());
+    }
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
     if (client.state() == ActiveClient::State::Connecting ||
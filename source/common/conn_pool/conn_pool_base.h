@@ -11,6 +11,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -342,6 +343,14 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // Determines if adaptive preconnect wants more capacity for the streams that are expected to
+  // arrive while a new connection is being established.
+  bool shouldAdaptivelyPreconnect() const;
+
+  // Updates the adaptive preconnect averages.
+  void recordStreamArrival();
+  void recordConnectLatency(std::chrono::milliseconds latency);
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -398,6 +407,12 @@ private:
   // The number of streams currently attached to clients.
   uint32_t num_active_streams_{0};
 
+  // Adaptive preconnect state. Exponentially weighted moving averages, in seconds, of the time
+  // between new streams and of the time it takes to establish a connection.
+  absl::optional<MonotonicTime> last_stream_time_;
+  double stream_interval_ewma_{0};
+  double connect_latency_ewma_{0};
+
   // Whether the connection pool is currently in the process of closing
   // all connections so that it can be gracefully deleted.
   bool is_draining_for_deletion_{false};
@@ -9,8 +9,27 @@
 namespace Envoy {
 namespace Event {
 
-TimerImpl::TimerImpl(Libevent::BasePtr& libevent, TimerCb cb, Dispatcher& dispatcher)
-    : cb_(cb), dispatcher_(dispatcher) {
+const timeval* CommonTimeouts::find(std::chrono::milliseconds d) {
+  if (d.count() <= 0 || d.count() % 1000 != 0) {
+    return nullptr;
+  }
+  auto it = timeouts_.find(d.count());
+  if (it != timeouts_.end()) {
+    return it->second;
+  }
+  if (timeouts_.size() >= MaxCommonTimeouts) {
+    return nullptr;
+  }
+  timeval tv;
+  TimerUtils::durationToTimeval(d, tv);
+  const timeval* common_timeout = event_base_init_common_timeout(&base_, &tv);
+  timeouts_.emplace(d.count(), common_timeout);
+  return common_timeout;
+}
+
+TimerImpl::TimerImpl(Libevent::BasePtr& libevent, TimerCb cb, Dispatcher& dispatcher,
+                     CommonTimeouts* common_timeouts)
+    : cb_(cb), dispatcher_(dispatcher), common_timeouts_(common_timeouts) {
   ASSERT(cb_);
   evtimer_assign(
       &raw_event_, libevent.get(),
@@ -33,6 +52,13 @@ void TimerImpl::disableTimer() {
 }
 
 void TimerImpl::enableTimer(const std::chrono::milliseconds d, const ScopeTrackedObject* object) {
+  if (common_timeouts_ != nullptr) {
+    const timeval* common_timeout = common_timeouts_->find(d);
+    if (common_timeout != nullptr) {
+      internalEnableTimer(*common_timeout, object);
+      return;
+    }
+  }
   timeval tv;
   TimerUtils::durationToTimeval(d, tv);
   internalEnableTimer(tv, object);
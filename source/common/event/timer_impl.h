@@ -9,6 +9,8 @@
 #include "source/common/event/event_impl_base.h"
 #include "source/common/event/libevent.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Event {
 
@@ -47,12 +49,43 @@ public:
   }
 };
 
+/**
+ * The libevent common timeouts of an event base, by duration. libevent keeps the timers enabled
+ * with a common timeout in a queue per duration, in which enabling and disabling a timer is O(1),
+ * rather than in its timer heap. That suits timers such as idle timeouts, which are re-enabled
+ * often and with one of a few configured durations.
+ */
+class CommonTimeouts {
+public:
+  explicit CommonTimeouts(event_base& base) : base_(base) {}
+
+  /**
+   * @param d supplies the duration of a timer.
+   * @return the common timeout to enable the timer with, or nullptr if the duration is not a whole
+   * number of seconds or too many common timeouts are in use.
+   */
+  const timeval* find(std::chrono::milliseconds d);
+
+private:
+  // libevent allows 256 common timeouts per event base. Durations computed at runtime, e.g. from
+  // deadlines, are rarely whole seconds, so far fewer than this are expected to be in use.
+  static constexpr size_t MaxCommonTimeouts = 64;
+
+  event_base& base_;
+  absl::flat_hash_map<int64_t, const timeval*> timeouts_;
+};
+
 /**
  * libevent implementation of Timer.
  */
 class TimerImpl : public Timer, ImplBase {
 public:
-  TimerImpl(Libevent::BasePtr& libevent, TimerCb cb, Event::Dispatcher& dispatcher);
+  /**
+   * @param common_timeouts supplies the common timeouts of the event base to enable the timer with
+   * when its duration has one, or nullptr to always use the timer heap of the event base.
+   */
+  TimerImpl(Libevent::BasePtr& libevent, TimerCb cb, Event::Dispatcher& dispatcher,
+            CommonTimeouts* common_timeouts = nullptr);
 
   // Timer
   void disableTimer() override;
@@ -66,6 +99,7 @@ private:
   void internalEnableTimer(const timeval& tv, const ScopeTrackedObject* scope);
   TimerCb cb_;
   Dispatcher& dispatcher_;
+  CommonTimeouts* const common_timeouts_;
   // This has to be atomic for alarms which are handled out of thread, for
   // example if the DispatcherImpl::post is called by two threads, they race to
   // both set this to null.
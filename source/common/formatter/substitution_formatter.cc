@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -17,6 +18,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/json_escape_string.h"
 #include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/metadata.h"
@@ -51,6 +53,23 @@ void truncate(std::string& str, absl::optional<uint32_t> max_length) {
   str = str.substr(0, max_length.value());
 }
 
+void appendJsonEscaped(std::string& out, absl::string_view value) {
+  const uint64_t extra_space = JsonEscaper::extraSpace(value);
+  if (extra_space == 0) {
+    out.append(value.data(), value.size());
+    return;
+  }
+  out.append(JsonEscaper::escapeString(value, extra_space));
+}
+
+// Remembers the largest output seen so far. The hint only ever grows, so it is written rarely and
+// workers sharing a formatter do not contend on it.
+void updateSizeHint(std::atomic<size_t>& size_hint, size_t size) {
+  if (size > size_hint.load(std::memory_order_relaxed)) {
+    size_hint.store(size, std::memory_order_relaxed);
+  }
+}
+
 // Matches newline pattern in a system time format string (e.g. start time)
 const std::regex& getSystemTimeFormatNewlinePattern() {
   CONSTRUCT_ON_FIRST_USE(std::regex, "%[-_0^#]*[1-9]*(E|O)?n");
@@ -116,12 +135,27 @@ const std::string SubstitutionFormatUtils::getHostnameOrDefault() {
 FormatterImpl::FormatterImpl(const std::string& format, bool omit_empty_values)
     : empty_value_string_(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueString) {
   providers_ = SubstitutionFormatParser::parse(format);
+  compile();
 }
 
 FormatterImpl::FormatterImpl(const std::string& format, bool omit_empty_values,
                              const std::vector<CommandParserPtr>& command_parsers)
     : empty_value_string_(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueString) {
   providers_ = SubstitutionFormatParser::parse(format, command_parsers);
+  compile();
+}
+
+void FormatterImpl::compile() {
+  for (const FormatterProviderPtr& provider : providers_) {
+    const auto* plain_string = dynamic_cast<const PlainStringFormatter*>(provider.get());
+    if (plain_string == nullptr) {
+      steps_.push_back({EMPTY_STRING, provider.get()});
+    } else if (!steps_.empty() && steps_.back().provider_ == nullptr) {
+      steps_.back().literal_.append(plain_string->value());
+    } else {
+      steps_.push_back({plain_string->value(), nullptr});
+    }
+  }
 }
 
 std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
@@ -130,28 +164,177 @@ std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
                                   const StreamInfo::StreamInfo& stream_info,
                                   absl::string_view local_reply_body) const {
   std::string log_line;
-  log_line.reserve(256);
+  log_line.reserve(size_hint_.load(std::memory_order_relaxed));
 
-  for (const FormatterProviderPtr& provider : providers_) {
-    const auto bit = provider->format(request_headers, response_headers, response_trailers,
-                                      stream_info, local_reply_body);
-    log_line += bit.value_or(empty_value_string_);
+  for (const FormatStep& step : steps_) {
+    if (step.provider_ == nullptr) {
+      log_line.append(step.literal_);
+      continue;
+    }
+    const auto bit = step.provider_->format(request_headers, response_headers, response_trailers,
+                                            stream_info, local_reply_body);
+    log_line.append(bit.has_value() ? bit.value() : empty_value_string_);
   }
 
+  updateSizeHint(size_hint_, log_line.size());
   return log_line;
 }
 
+JsonFormatterImpl::JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping,
+                                     bool preserve_types, bool omit_empty_values)
+    : JsonFormatterImpl(format_mapping, preserve_types, omit_empty_values, {}) {}
+
+JsonFormatterImpl::JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping,
+                                     bool preserve_types, bool omit_empty_values,
+                                     const std::vector<CommandParserPtr>& commands)
+    : omit_empty_values_(omit_empty_values), preserve_types_(preserve_types) {
+  if (!compileFlatFormat(format_mapping, commands)) {
+    struct_formatter_ = std::make_unique<const StructFormatter>(format_mapping, preserve_types,
+                                                                omit_empty_values, commands);
+  }
+}
+
+bool JsonFormatterImpl::compileFlatFormat(const ProtobufWkt::Struct& format_mapping,
+                                          const std::vector<CommandParserPtr>& commands) {
+  for (const auto& pair : format_mapping.fields()) {
+    const auto kind = pair.second.kind_case();
+    if (kind != ProtobufWkt::Value::kStringValue && kind != ProtobufWkt::Value::kNumberValue) {
+      return false;
+    }
+  }
+
+  // Emit keys in sorted order like the StructFormatter does.
+  std::map<std::string, const ProtobufWkt::Value*> sorted_fields;
+  for (const auto& pair : format_mapping.fields()) {
+    sorted_fields.emplace(pair.first, &pair.second);
+  }
+  flat_fields_.reserve(sorted_fields.size());
+  for (const auto& pair : sorted_fields) {
+    JsonField field;
+    field.key_.push_back('"');
+    appendJsonEscaped(field.key_, pair.first);
+    field.key_.append("\":");
+    if (pair.second->kind_case() == ProtobufWkt::Value::kStringValue) {
+      field.providers_ = SubstitutionFormatParser::parse(pair.second->string_value(), commands);
+    } else {
+      field.providers_.push_back(std::make_unique<PlainNumberFormatter>(pair.second->number_value()));
+    }
+    flat_fields_.push_back(std::move(field));
+  }
+  return true;
+}
+
+void JsonFormatterImpl::appendValue(std::string& log_line, const ProtobufWkt::Value& value) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kStringValue:
+    log_line.push_back('"');
+    appendJsonEscaped(log_line, value.string_value());
+    log_line.push_back('"');
+    return;
+  case ProtobufWkt::Value::kBoolValue:
+    log_line.append(value.bool_value() ? "true" : "false");
+    return;
+  case ProtobufWkt::Value::kNullValue:
+    log_line.append("null");
+    return;
+  case ProtobufWkt::Value::kNumberValue: {
+    // Integers below 1e15 are printed in full by the protobuf JSON printer as well. Everything
+    // else is left to the printer to get the exact same rendering.
+    const double number = value.number_value();
+    if (std::abs(number) < 1e15 && number == std::trunc(number) &&
+        !(number == 0 && std::signbit(number))) {
+      absl::StrAppend(&log_line, static_cast<int64_t>(number));
+      return;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  log_line.append(MessageUtil::getJsonStringFromMessageOrDie(value, false, true));
+}
+
+void JsonFormatterImpl::formatFlat(std::string& log_line,
+                                   const Http::RequestHeaderMap& request_headers,
+                                   const Http::ResponseHeaderMap& response_headers,
+                                   const Http::ResponseTrailerMap& response_trailers,
+                                   const StreamInfo::StreamInfo& stream_info,
+                                   absl::string_view local_reply_body) const {
+  const std::string& empty_value =
+      omit_empty_values_ ? EMPTY_STRING : DefaultUnspecifiedValueString;
+  bool first = true;
+  log_line.push_back('{');
+  for (const JsonField& field : flat_fields_) {
+    // This mirrors StructFormatter::providersCallback(): a single provider keeps its type if types
+    // are preserved and a missing value is either omitted or rendered as "-" (or null if types are
+    // preserved). Concatenated values are always rendered as strings.
+    if (field.providers_.size() == 1) {
+      const FormatterProviderPtr& provider = field.providers_.front();
+      if (preserve_types_) {
+        const ProtobufWkt::Value value = provider->formatValue(
+            request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+        if (omit_empty_values_ && value.kind_case() == ProtobufWkt::Value::kNullValue) {
+          continue;
+        }
+        if (!first) {
+          log_line.push_back(',');
+        }
+        log_line.append(field.key_);
+        appendValue(log_line, value);
+        first = false;
+        continue;
+      }
+
+      const auto value = provider->format(request_headers, response_headers, response_trailers,
+                                          stream_info, local_reply_body);
+      if (omit_empty_values_ && !value.has_value()) {
+        continue;
+      }
+      if (!first) {
+        log_line.push_back(',');
+      }
+      log_line.append(field.key_);
+      log_line.push_back('"');
+      appendJsonEscaped(log_line, value.has_value() ? value.value() : DefaultUnspecifiedValueString);
+    } else {
+      if (!first) {
+        log_line.push_back(',');
+      }
+      log_line.append(field.key_);
+      log_line.push_back('"');
+      // Escaping each part is the same as escaping the concatenation.
+      for (const FormatterProviderPtr& provider : field.providers_) {
+        const auto bit = provider->format(request_headers, response_headers, response_trailers,
+                                          stream_info, local_reply_body);
+        appendJsonEscaped(log_line, bit.has_value() ? bit.value() : empty_value);
+      }
+    }
+    log_line.push_back('"');
+    first = false;
+  }
+  log_line.append("}\n");
+}
+
 std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_headers,
                                       const Http::ResponseHeaderMap& response_headers,
                                       const Http::ResponseTrailerMap& response_trailers,
                                       const StreamInfo::StreamInfo& stream_info,
                                       absl::string_view local_reply_body) const {
-  const ProtobufWkt::Struct output_struct = struct_formatter_.format(
-      request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+  if (struct_formatter_ != nullptr) {
+    const ProtobufWkt::Struct output_struct = struct_formatter_->format(
+        request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+
+    const std::string log_line =
+        MessageUtil::getJsonStringFromMessageOrDie(output_struct, false, true);
+    return absl::StrCat(log_line, "\n");
+  }
 
-  const std::string log_line =
-      MessageUtil::getJsonStringFromMessageOrDie(output_struct, false, true);
-  return absl::StrCat(log_line, "\n");
+  std::string log_line;
+  log_line.reserve(size_hint_.load(std::memory_order_relaxed));
+  formatFlat(log_line, request_headers, response_headers, response_trailers, stream_info,
+             local_reply_body);
+  updateSizeHint(size_hint_, log_line.size());
+  return log_line;
 }
 
 StructFormatter::StructFormatter(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -152,8 +153,20 @@ public:
                      absl::string_view local_reply_body) const override;
 
 private:
+  // A step of the compiled format string. Literal steps have no provider. Adjacent literals are
+  // merged into one step so that each of them is appended with a single copy.
+  struct FormatStep {
+    std::string literal_;
+    const FormatterProvider* provider_{};
+  };
+
+  void compile();
+
   const std::string& empty_value_string_;
   std::vector<FormatterProviderPtr> providers_;
+  std::vector<FormatStep> steps_;
+  // The largest line formatted so far, used to size the output up front.
+  mutable std::atomic<size_t> size_hint_{256};
 };
 
 // Helper classes for StructFormatter::StructFormatMapVisitor.
@@ -244,11 +257,9 @@ using StructFormatterPtr = std::unique_ptr<StructFormatter>;
 class JsonFormatterImpl : public Formatter {
 public:
   JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
-                    bool omit_empty_values)
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values) {}
+                    bool omit_empty_values);
   JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
-                    bool omit_empty_values, const std::vector<CommandParserPtr>& commands)
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands) {}
+                    bool omit_empty_values, const std::vector<CommandParserPtr>& commands);
 
   // Formatter::format
   std::string format(const Http::RequestHeaderMap& request_headers,
@@ -258,7 +269,32 @@ public:
                      absl::string_view local_reply_body) const override;
 
 private:
-  const StructFormatter struct_formatter_;
+  // A top level field of a flat format. The key is escaped and quoted once, e.g. `"key":`.
+  struct JsonField {
+    std::string key_;
+    std::vector<FormatterProviderPtr> providers_;
+  };
+
+  /**
+   * Compile formats that only map keys to format strings or numbers into a list of fields that is
+   * written out directly, bypassing the Struct and most of the protobuf JSON printer.
+   * @return whether the format was compiled.
+   */
+  bool compileFlatFormat(const ProtobufWkt::Struct& format_mapping,
+                         const std::vector<CommandParserPtr>& commands);
+  static void appendValue(std::string& log_line, const ProtobufWkt::Value& value);
+  void formatFlat(std::string& log_line, const Http::RequestHeaderMap& request_headers,
+                  const Http::ResponseHeaderMap& response_headers,
+                  const Http::ResponseTrailerMap& response_trailers,
+                  const StreamInfo::StreamInfo& stream_info,
+                  absl::string_view local_reply_body) const;
+
+  const bool omit_empty_values_;
+  const bool preserve_types_;
+  std::vector<JsonField> flat_fields_;
+  // Only set if the format could not be compiled into flat_fields_.
+  std::unique_ptr<const StructFormatter> struct_formatter_;
+  mutable std::atomic<size_t> size_hint_{256};
 };
 
 /**
@@ -277,6 +313,8 @@ public:
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
 
+  const std::string& value() const { return str_.string_value(); }
+
 private:
   ProtobufWkt::Value str_;
 };
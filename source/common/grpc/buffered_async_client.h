@@ -14,6 +14,15 @@ namespace Grpc {
 
 enum class BufferState { Buffered, PendingFlush };
 
+// What to do with a message that does not fit in the buffer.
+enum class BufferOverflowPolicy {
+  // Reject the message.
+  RejectNewest,
+  // Drop the oldest messages that are not being sent to make room for the message. The message is
+  // rejected if that is not enough.
+  DropOldest,
+};
+
 // This class wraps bidirectional gRPC and provides message arrival guarantee.
 // It stores messages to be sent or in the process of being sent in a buffer,
 // and can track the status of the message based on the ID assigned to each message.
@@ -23,9 +32,10 @@ public:
   BufferedAsyncClient(uint32_t max_buffer_bytes, const Protobuf::MethodDescriptor& service_method,
                       Grpc::AsyncStreamCallbacks<ResponseType>& callbacks,
                       const Grpc::AsyncClient<RequestType, ResponseType>& client,
-                      Event::Dispatcher& dispatcher, std::chrono::milliseconds message_timeout_msec)
-      : max_buffer_bytes_(max_buffer_bytes), service_method_(service_method), callbacks_(callbacks),
-        client_(client),
+                      Event::Dispatcher& dispatcher, std::chrono::milliseconds message_timeout_msec,
+                      BufferOverflowPolicy overflow_policy = BufferOverflowPolicy::RejectNewest)
+      : max_buffer_bytes_(max_buffer_bytes), overflow_policy_(overflow_policy),
+        service_method_(service_method), callbacks_(callbacks), client_(client),
         ttl_manager_(
             dispatcher, [this](uint64_t id) { onError(id); }, message_timeout_msec) {}
 
@@ -36,10 +46,12 @@ public:
   }
 
   // It push message into internal message buffer.
-  // If the buffer is full, it will return absl::nullopt.
+  // If the buffer is full, and room can not be made for the message according to the overflow
+  // policy, it will return absl::nullopt.
   absl::optional<uint64_t> bufferMessage(RequestType& message) {
     const auto buffer_size = message.ByteSizeLong();
-    if (current_buffer_bytes_ + buffer_size > max_buffer_bytes_) {
+    if (current_buffer_bytes_ + buffer_size > max_buffer_bytes_ &&
+        !dropOldestMessages(buffer_size)) {
       return absl::nullopt;
     }
 
@@ -94,6 +106,9 @@ public:
 
   bool hasActiveStream() { return active_stream_ != nullptr; }
 
+  // The number of messages dropped to make room for newer ones.
+  uint64_t droppedMessageCount() const { return dropped_message_count_; }
+
   const absl::btree_map<uint64_t, std::pair<BufferState, RequestType>>& messageBuffer() {
     return message_buffer_;
   }
@@ -118,9 +133,45 @@ private:
     }
   }
 
+  // Drops the oldest buffered messages until a message of the given size fits, if the overflow
+  // policy allows it. Nothing is dropped if the message would not fit anyway.
+  bool dropOldestMessages(uint64_t buffer_size) {
+    if (overflow_policy_ != BufferOverflowPolicy::DropOldest || buffer_size > max_buffer_bytes_) {
+      return false;
+    }
+    const uint64_t bytes_to_free = current_buffer_bytes_ + buffer_size - max_buffer_bytes_;
+    uint64_t droppable_bytes = 0;
+    for (const auto& it : message_buffer_) {
+      if (droppable_bytes >= bytes_to_free) {
+        break;
+      }
+      if (it.second.first == BufferState::Buffered) {
+        droppable_bytes += it.second.second.ByteSizeLong();
+      }
+    }
+    if (droppable_bytes < bytes_to_free) {
+      return false;
+    }
+
+    uint64_t freed_bytes = 0;
+    for (auto it = message_buffer_.begin(); freed_bytes < bytes_to_free;) {
+      if (it->second.first != BufferState::Buffered) {
+        ++it;
+        continue;
+      }
+      const auto message_size = it->second.second.ByteSizeLong();
+      freed_bytes += message_size;
+      current_buffer_bytes_ -= message_size;
+      ++dropped_message_count_;
+      it = message_buffer_.erase(it);
+    }
+    return true;
+  }
+
   uint64_t publishId() { return next_message_id_++; }
 
   const uint32_t max_buffer_bytes_ = 0;
+  const BufferOverflowPolicy overflow_policy_;
   const Protobuf::MethodDescriptor& service_method_;
   Grpc::AsyncStreamCallbacks<ResponseType>& callbacks_;
   Grpc::AsyncClient<RequestType, ResponseType> client_;
@@ -128,6 +179,7 @@ private:
   absl::btree_map<uint64_t, std::pair<BufferState, RequestType>> message_buffer_;
   uint32_t current_buffer_bytes_ = 0;
   uint64_t next_message_id_ = 0;
+  uint64_t dropped_message_count_ = 0;
   BufferedMessageTtlManager ttl_manager_;
 };
 
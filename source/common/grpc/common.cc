@@ -160,13 +160,17 @@ Buffer::InstancePtr Common::serializeToGrpcFrame(const Protobuf::Message& messag
 Buffer::InstancePtr Common::serializeMessage(const Protobuf::Message& message) {
   auto body = std::make_unique<Buffer::OwnedImpl>();
   const uint32_t size = message.ByteSize();
-  auto reservation = body->reserveSingleSlice(size);
-  ASSERT(reservation.slice().len_ >= size);
-  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_);
+  // Leave room for the 5 byte header in front of the message, so that prependGrpcFrameHeader
+  // writes it into the same slice instead of allocating another one.
+  const uint32_t alloc_size = size + 5;
+  auto reservation = body->reserveSingleSlice(alloc_size);
+  ASSERT(reservation.slice().len_ >= alloc_size);
+  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_) + 5;
   Protobuf::io::ArrayOutputStream stream(current, size, -1);
   Protobuf::io::CodedOutputStream codec_stream(&stream);
   message.SerializeWithCachedSizes(&codec_stream);
-  reservation.commit(size);
+  reservation.commit(alloc_size);
+  body->drain(5);
   return body;
 }
 
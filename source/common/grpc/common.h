@@ -133,7 +133,8 @@ public:
   static Buffer::InstancePtr serializeToGrpcFrame(const Protobuf::Message& message);
 
   /**
-   * Serialize protobuf message. Without grpc header.
+   * Serialize protobuf message. Without grpc header. The header can be added with
+   * prependGrpcFrameHeader without copying the message.
    */
   static Buffer::InstancePtr serializeMessage(const Protobuf::Message& message);
 
@@ -46,6 +46,7 @@
 #include "source/common/local_reply/local_reply.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/router/scoped_rds.h"
+#include "source/common/stats/timespan_impl.h"
 #include "source/common/stream_info/stream_info_impl.h"
 #include "source/common/tracing/http_tracer_impl.h"
 
@@ -269,7 +270,7 @@ private:
       state_.codec_saw_local_complete_ = true;
       filter_manager_.streamInfo().downstreamTiming().onLastDownstreamTxByteSent(
           connection_manager_.time_source_);
-      request_response_timespan_->complete();
+      request_response_timespan_.complete();
       connection_manager_.doEndStream(*this);
     }
     void onDecoderFilterBelowWriteBufferLowWatermark() override;
@@ -400,7 +401,9 @@ private:
     Router::ScopedConfigConstSharedPtr snapped_scoped_routes_config_;
     Tracing::SpanPtr active_span_;
     ResponseEncoder* response_encoder_{};
-    Stats::TimespanPtr request_response_timespan_;
+    // Members below that live as long as the stream are held by value rather than on the heap to
+    // keep per-stream allocations down.
+    Stats::HistogramCompletableTimespanImpl request_response_timespan_;
     // Per-stream idle timeout. This timer gets reset whenever activity occurs on the stream, and,
     // when triggered, will close the stream.
     Event::TimerPtr stream_idle_timer_;
@@ -419,7 +422,7 @@ private:
     absl::optional<Router::RouteConstSharedPtr> cached_route_;
     absl::optional<Upstream::ClusterInfoConstSharedPtr> cached_cluster_info_;
     const std::string* decorated_operation_{nullptr};
-    std::unique_ptr<RdsRouteConfigUpdateRequester> route_config_update_requester_;
+    absl::optional<RdsRouteConfigUpdateRequester> route_config_update_requester_;
     std::unique_ptr<Tracing::CustomTagMap> tracing_custom_tags_{nullptr};
     Http::HeaderValidatorPtr header_validator_;
 
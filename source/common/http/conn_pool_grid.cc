@@ -117,7 +117,7 @@ ConnectivityGrid::StreamCreationResult ConnectivityGrid::WrapperCallbacks::newSt
   auto attempt = std::make_unique<ConnectionAttemptCallbacks>(*this, current_);
   LinkedList::moveIntoList(std::move(attempt), connection_attempts_);
   if (!next_attempt_timer_->enabled()) {
-    next_attempt_timer_->enableTimer(grid_.next_attempt_duration_);
+    next_attempt_timer_->enableTimer(grid_.nextAttemptDuration());
   }
   // Note that in the case of immediate attempt/failure, newStream will delete this.
   return connection_attempts_.front()->newStream();
@@ -213,8 +213,7 @@ ConnectivityGrid::ConnectivityGrid(
     Stats::Scope& scope, Http::PersistentQuicInfo& quic_info)
     : dispatcher_(dispatcher), random_generator_(random_generator), host_(host),
       priority_(priority), options_(options), transport_socket_options_(transport_socket_options),
-      state_(state), next_attempt_duration_(std::chrono::milliseconds(kDefaultTimeoutMs)),
-      time_source_(time_source), alternate_protocols_(alternate_protocols),
+      state_(state), time_source_(time_source), alternate_protocols_(alternate_protocols),
       quic_stat_names_(quic_stat_names), scope_(scope),
       // TODO(RyanTheOptimist): Figure out how scheme gets plumbed in here.
       origin_("https", getSni(transport_socket_options, host_->transportSocketFactory()),
@@ -224,11 +223,6 @@ ConnectivityGrid::ConnectivityGrid(
   // HTTP/3.
   ASSERT(connectivity_options.protocols_.size() == 3);
   ASSERT(alternate_protocols);
-  std::chrono::milliseconds rtt =
-      std::chrono::duration_cast<std::chrono::milliseconds>(alternate_protocols_->getSrtt(origin_));
-  if (rtt.count() != 0) {
-    next_attempt_duration_ = std::chrono::milliseconds(rtt.count() * 2);
-  }
 }
 
 ConnectivityGrid::~ConnectivityGrid() {
@@ -370,6 +364,17 @@ absl::optional<ConnectivityGrid::PoolIterator> ConnectivityGrid::nextPool(PoolIt
   return createNextPool();
 }
 
+std::chrono::milliseconds ConnectivityGrid::nextAttemptDuration() const {
+  // The srtt is looked up for each attempt, as it is only cached once a connection to the origin
+  // has been established, which is usually after the grid was created.
+  std::chrono::milliseconds rtt =
+      std::chrono::duration_cast<std::chrono::milliseconds>(alternate_protocols_->getSrtt(origin_));
+  if (rtt.count() != 0) {
+    return std::chrono::milliseconds(rtt.count() * 2);
+  }
+  return std::chrono::milliseconds(kDefaultTimeoutMs);
+}
+
 bool ConnectivityGrid::isPoolHttp3(const ConnectionPool::Instance& pool) {
   return &pool == pools_.begin()->get();
 }
@@ -201,6 +201,10 @@ private:
   // have been created.
   virtual absl::optional<PoolIterator> createNextPool();
 
+  // Returns how long to wait for a connection attempt before attempting the next pool, based on
+  // the srtt of the origin if it is known.
+  std::chrono::milliseconds nextAttemptDuration() const;
+
   // This batch of member variables are latched objects required for pool creation.
   Event::Dispatcher& dispatcher_;
   Random::RandomGenerator& random_generator_;
@@ -209,7 +213,6 @@ private:
   const Network::ConnectionSocket::OptionsSharedPtr options_;
   const Network::TransportSocketOptionsConstSharedPtr transport_socket_options_;
   Upstream::ClusterConnectivityState& state_;
-  std::chrono::milliseconds next_attempt_duration_;
   TimeSource& time_source_;
   HttpServerPropertiesCacheSharedPtr alternate_protocols_;
 
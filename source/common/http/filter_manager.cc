@@ -497,6 +497,28 @@ void FilterManager::applyFilterFactoryCb(FilterContext context, FilterFactoryCb&
   factory(callbacks);
 }
 
+void FilterManager::recordFilterTiming() {
+  const auto record = [this](const ActiveStreamFilterBase& filter, absl::string_view name) {
+    // Filters whose callbacks were never called, e.g. as the stream was reset, are not recorded.
+    if (filter.time_spent_.count() == 0) {
+      return;
+    }
+    Stats::Utility::histogramFromElements(
+        filter_timing_->scope_,
+        {filter_timing_->prefix_, Stats::DynamicName("filter_timing"),
+         Stats::DynamicName(filter.filter_context_.config_name), Stats::DynamicName(name)},
+        Stats::Histogram::Unit::Microseconds)
+        .recordValue(
+            std::chrono::duration_cast<std::chrono::microseconds>(filter.time_spent_).count());
+  };
+  for (const auto& filter : decoder_filters_) {
+    record(*filter, "decode_time_us");
+  }
+  for (const auto& filter : encoder_filters_) {
+    record(*filter, "encode_time_us");
+  }
+}
+
 void FilterManager::maybeContinueDecoding(
     const std::list<ActiveStreamDecoderFilterPtr>::iterator& continue_data_entry) {
   if (continue_data_entry != decoder_filters_.end()) {
@@ -521,7 +543,11 @@ void FilterManager::decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHead
     ASSERT(!(state_.filter_call_state_ & FilterCallState::DecodeHeaders));
     state_.filter_call_state_ |= FilterCallState::DecodeHeaders;
     (*entry)->end_stream_ = (end_stream && continue_data_entry == decoder_filters_.end());
-    FilterHeadersStatus status = (*entry)->decodeHeaders(headers, (*entry)->end_stream_);
+    FilterHeadersStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->decodeHeaders(headers, (*entry)->end_stream_);
+    }
     state_.filter_call_state_ &= ~FilterCallState::DecodeHeaders;
     if (state_.decoder_filter_chain_aborted_) {
       executeLocalReplyIfPrepared();
@@ -659,7 +685,11 @@ void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instan
 
     state_.filter_call_state_ |= FilterCallState::DecodeData;
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.requestTrailers();
-    FilterDataStatus status = (*entry)->handle_->decodeData(data, (*entry)->end_stream_);
+    FilterDataStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->decodeData(data, (*entry)->end_stream_);
+    }
     if ((*entry)->end_stream_) {
       (*entry)->handle_->decodeComplete();
     }
@@ -753,7 +783,11 @@ void FilterManager::decodeTrailers(ActiveStreamDecoderFilter* filter, RequestTra
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::DecodeTrailers));
     state_.filter_call_state_ |= FilterCallState::DecodeTrailers;
-    FilterTrailersStatus status = (*entry)->handle_->decodeTrailers(trailers);
+    FilterTrailersStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->decodeTrailers(trailers);
+    }
     (*entry)->handle_->decodeComplete();
     (*entry)->end_stream_ = true;
     state_.filter_call_state_ &= ~FilterCallState::DecodeTrailers;
@@ -792,7 +826,11 @@ void FilterManager::decodeMetadata(ActiveStreamDecoderFilter* filter, MetadataMa
       return;
     }
 
-    FilterMetadataStatus status = (*entry)->handle_->decodeMetadata(metadata_map);
+    FilterMetadataStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->decodeMetadata(metadata_map);
+    }
     ASSERT(!hasPreparedLocalReply(), "Sending Local Reply from Metadata is not yet supported.");
     ENVOY_STREAM_LOG(trace, "decode metadata called: filter={} status={}, metadata: {}", *this,
                      (*entry)->filter_context_.config_name, static_cast<uint64_t>(status),
@@ -1062,7 +1100,11 @@ void FilterManager::encode1xxHeaders(ActiveStreamEncoderFilter* filter,
   for (; entry != encoder_filters_.end(); entry++) {
     ASSERT(!(state_.filter_call_state_ & FilterCallState::Encode1xxHeaders));
     state_.filter_call_state_ |= FilterCallState::Encode1xxHeaders;
-    const Filter1xxHeadersStatus status = (*entry)->handle_->encode1xxHeaders(headers);
+    Filter1xxHeadersStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->encode1xxHeaders(headers);
+    }
     state_.filter_call_state_ &= ~FilterCallState::Encode1xxHeaders;
 
     ENVOY_STREAM_LOG(trace, "encode 1xx continue headers called: filter={} status={}", *this,
@@ -1112,7 +1154,11 @@ void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHea
     ASSERT(!(state_.filter_call_state_ & FilterCallState::EncodeHeaders));
     state_.filter_call_state_ |= FilterCallState::EncodeHeaders;
     (*entry)->end_stream_ = (end_stream && continue_data_entry == encoder_filters_.end());
-    FilterHeadersStatus status = (*entry)->handle_->encodeHeaders(headers, (*entry)->end_stream_);
+    FilterHeadersStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->encodeHeaders(headers, (*entry)->end_stream_);
+    }
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace,
                        "encodeHeaders filter iteration aborted due to local reply: filter={}",
@@ -1196,7 +1242,11 @@ void FilterManager::encodeMetadata(ActiveStreamEncoderFilter* filter,
       return;
     }
 
-    FilterMetadataStatus status = (*entry)->handle_->encodeMetadata(*metadata_map_ptr);
+    FilterMetadataStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->encodeMetadata(*metadata_map_ptr);
+    }
     ENVOY_STREAM_LOG(trace, "encode metadata called: filter={} status={}", *this,
                      (*entry)->filter_context_.config_name, static_cast<uint64_t>(status));
   }
@@ -1275,7 +1325,11 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
     recordLatestDataFilter(entry, state_.latest_data_encoding_filter_, encoder_filters_);
 
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.responseTrailers();
-    FilterDataStatus status = (*entry)->handle_->encodeData(data, (*entry)->end_stream_);
+    FilterDataStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->encodeData(data, (*entry)->end_stream_);
+    }
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace, "encodeData filter iteration aborted due to local reply: filter={}",
                        *this, (*entry)->filter_context_.config_name);
@@ -1329,7 +1383,11 @@ void FilterManager::encodeTrailers(ActiveStreamEncoderFilter* filter,
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::EncodeTrailers));
     state_.filter_call_state_ |= FilterCallState::EncodeTrailers;
-    FilterTrailersStatus status = (*entry)->handle_->encodeTrailers(trailers);
+    FilterTrailersStatus status;
+    {
+      FilterCallbackTimer timer(filterTimingTimeSource(), (*entry)->time_spent_);
+      status = (*entry)->handle_->encodeTrailers(trailers);
+    }
     (*entry)->handle_->encodeComplete();
     (*entry)->end_stream_ = true;
     state_.filter_call_state_ &= ~FilterCallState::EncodeTrailers;
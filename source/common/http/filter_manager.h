@@ -5,6 +5,7 @@
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
+#include "envoy/common/time.h"
 #include "envoy/extensions/filters/network/http_connection_manager/v3/http_connection_manager.pb.h"
 #include "envoy/extensions/filters/network/http_connection_manager/v3/http_connection_manager.pb.validate.h"
 #include "envoy/http/filter.h"
@@ -12,6 +13,7 @@
 #include "envoy/matcher/matcher.h"
 #include "envoy/network/socket.h"
 #include "envoy/protobuf/message_validator.h"
+#include "envoy/stats/scope.h"
 
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/dump_state_utils.h"
@@ -25,8 +27,11 @@
 #include "source/common/local_reply/local_reply.h"
 #include "source/common/matcher/matcher.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/stats/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -35,6 +40,30 @@ class DownstreamFilterManager;
 
 struct ActiveStreamFilterBase;
 
+/**
+ * Adds the time spent in its scope to the time spent in the callbacks of a filter, when filter
+ * timing is enabled for the stream.
+ */
+class FilterCallbackTimer {
+public:
+  FilterCallbackTimer(TimeSource* time_source, std::chrono::nanoseconds& time_spent)
+      : time_source_(time_source), time_spent_(time_spent) {
+    if (time_source_ != nullptr) {
+      start_ = time_source_->monotonicTime();
+    }
+  }
+  ~FilterCallbackTimer() {
+    if (time_source_ != nullptr) {
+      time_spent_ += time_source_->monotonicTime() - start_;
+    }
+  }
+
+private:
+  TimeSource* const time_source_;
+  std::chrono::nanoseconds& time_spent_;
+  MonotonicTime start_;
+};
+
 /**
  * Base class wrapper for both stream encoder and decoder filters.
  *
@@ -149,6 +178,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   IterationState iteration_state_{};
 
   const FilterContext filter_context_;
+  // The time spent in the decode or encode callbacks of the filter, when filter timing is enabled.
+  std::chrono::nanoseconds time_spent_{};
 
   // If the filter resumes iteration from a StopAllBuffer/Watermark state, the current filter
   // hasn't parsed data and trailers. As a result, the filter iteration should start with the
@@ -690,6 +721,9 @@ public:
 
   void destroyFilters() {
     state_.destroyed_ = true;
+    if (filter_timing_.has_value()) {
+      recordFilterTiming();
+    }
 
     for (auto& filter : decoder_filters_) {
       filter->handle_->onDestroy();
@@ -703,6 +737,17 @@ public:
     }
   }
 
+  /**
+   * Enables the timing of the decode and encode callbacks of the filters. The time spent in the
+   * callbacks of each filter is recorded when the filters are destroyed, in the
+   * <prefix>filter_timing.<filter config name>.<decode|encode>_time_us histograms.
+   * @param scope the scope of the histograms.
+   * @param prefix the prefix of the histograms.
+   */
+  void enableFilterTiming(Stats::Scope& scope, Stats::StatName prefix) {
+    filter_timing_.emplace(FilterTiming{scope, prefix});
+  }
+
   /**
    * Decodes the provided headers starting at the first filter in the chain.
    * @param headers the headers to decode.
@@ -981,7 +1026,7 @@ private:
 
   std::list<ActiveStreamDecoderFilterPtr> decoder_filters_;
   std::list<ActiveStreamEncoderFilterPtr> encoder_filters_;
-  std::list<StreamFilterBase*> filters_;
+  absl::InlinedVector<StreamFilterBase*, 8> filters_;
   std::list<AccessLog::InstanceSharedPtr> access_log_handlers_;
 
   // Stores metadata added in the decoding filter that is being processed. Will be cleared before
@@ -998,6 +1043,20 @@ private:
   absl::optional<absl::string_view> upstream_override_host_;
 
   const FilterChainFactory& filter_chain_factory_;
+
+  struct FilterTiming {
+    Stats::Scope& scope_;
+    const Stats::StatName prefix_;
+  };
+  absl::optional<FilterTiming> filter_timing_;
+
+  // @return the time source to time the callbacks of the filters with, or nullptr when filter
+  // timing is disabled.
+  TimeSource* filterTimingTimeSource() {
+    return filter_timing_.has_value() ? &dispatcher_.timeSource() : nullptr;
+  }
+  void recordFilterTiming();
+
   // TODO(snowp): Once FM has been moved to its own file we'll make these private classes of FM,
   // at which point they no longer need to be friends.
   friend ActiveStreamFilterBase;
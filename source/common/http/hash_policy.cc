@@ -11,6 +11,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Http {
@@ -139,12 +140,22 @@ public:
     absl::optional<uint64_t> hash;
 
     const HeaderEntry* header = headers.Path();
-    if (header) {
-      Http::Utility::QueryParams query_parameters =
-          Http::Utility::parseQueryString(header->value().getStringView());
-      const auto& iter = query_parameters.find(parameter_name_);
-      if (iter != query_parameters.end()) {
-        hash = HashUtil::xxHash64(iter->second);
+    if (header == nullptr) {
+      return hash;
+    }
+    const absl::string_view path = header->value().getStringView();
+    const size_t query_start = path.find('?');
+    if (query_start == absl::string_view::npos) {
+      return hash;
+    }
+    // Scan the query string in place rather than parsing all of it into a map. The first
+    // occurrence of the parameter is hashed, and a parameter without '=' has an empty value.
+    for (const absl::string_view param : absl::StrSplit(path.substr(query_start + 1), '&')) {
+      const std::pair<absl::string_view, absl::string_view> name_value =
+          absl::StrSplit(param, absl::MaxSplits('=', 1));
+      if (name_value.first == parameter_name_) {
+        hash = HashUtil::xxHash64(name_value.second);
+        break;
       }
     }
     return hash;
@@ -10,6 +10,7 @@
 #include "envoy/common/optref.h"
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/node_pool.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
@@ -107,6 +108,11 @@ public:
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
 
 protected:
+  struct HeaderEntryImpl;
+  // Header entries are allocated from a per-map NodePool, so that a typical request with 10-30
+  // headers needs a handful of slab allocations rather than one allocation per header.
+  using HeaderEntryList = std::list<HeaderEntryImpl, NodePoolAllocator<HeaderEntryImpl>>;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -122,9 +128,9 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderEntryList::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderNode = HeaderEntryList::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -135,12 +141,19 @@ protected:
     const LowerCaseString* key_;
   };
 
+  /**
+   * An O(1) header of the static lookup table: its slot in the inline headers and its name.
+   */
+  struct StaticLookupEntry {
+    size_t index_;
+    const LowerCaseString* key_;
+  };
+
   /**
    * Base class for a static lookup table that converts a string key into an O(1) header.
    */
   template <class Interface>
-  struct StaticLookupTable
-      : public TrieLookupTable<std::function<StaticLookupResponse(HeaderMapImpl&)>> {
+  struct StaticLookupTable : public TrieLookupTable<const StaticLookupEntry*> {
     StaticLookupTable();
 
     void finalizeTable() {
@@ -148,12 +161,15 @@ protected:
       auto& headers = CustomInlineHeaderRegistry::headers<Interface::header_map_type>();
       size_ = headers.size();
       for (const auto& header : headers) {
-        this->add(header.first.get().c_str(), [&header](HeaderMapImpl& h) -> StaticLookupResponse {
-          return {&h.inlineHeaders()[header.second], &header.first};
-        });
+        addEntry(header.first.get(), header.second, header.first);
       }
     }
 
+    void addEntry(absl::string_view key, size_t index, const LowerCaseString& header) {
+      entries_.push_back({index, &header});
+      this->add(key, &entries_.back());
+    }
+
     static size_t size() {
       // The size of the lookup table is finalized when the singleton lookup table is created. This
       // allows for late binding of custom headers as well as envoy header prefix changes. This
@@ -167,15 +183,17 @@ protected:
 
     static absl::optional<StaticLookupResponse> lookup(HeaderMapImpl& header_map,
                                                        absl::string_view key) {
-      const auto& entry = ConstSingleton<StaticLookupTable>::get().find(key);
+      const StaticLookupEntry* entry = ConstSingleton<StaticLookupTable>::get().find(key);
       if (entry != nullptr) {
-        return entry(header_map);
+        return StaticLookupResponse{&header_map.inlineHeaders()[entry->index_], entry->key_};
       } else {
         return absl::nullopt;
       }
     }
 
     size_t size_;
+    // The entries the trie points to. A list keeps their addresses stable as more are added.
+    std::list<StaticLookupEntry> entries_;
   };
 
   /**
@@ -197,7 +215,9 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    HeaderList()
+        : headers_(NodePoolAllocator<HeaderEntryImpl>(pool_)), pseudo_headers_end_(headers_.end()) {
+    }
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -287,12 +307,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -304,7 +324,9 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // Must outlive headers_.
+    NodePool pool_;
+    HeaderEntryList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
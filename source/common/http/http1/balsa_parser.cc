@@ -1,11 +1,11 @@
 #include "source/common/http/http1/balsa_parser.h"
 
 #include <algorithm>
-#include <cctype>
+#include <array>
 #include <cstdint>
+#include <cstring>
 
 #include "source/common/common/assert.h"
-#include "source/common/common/regex.h"
 #include "source/common/http/headers.h"
 
 #include "absl/strings/match.h"
@@ -46,36 +46,96 @@ bool isMethodValid(absl::string_view method) {
   return std::binary_search(begin, end, method);
 }
 
+// Character classes used by URL validation. These are lookup tables rather than <cctype>
+// predicates so that the checks do not depend on the locale and compile to a single load.
+enum CharClass : uint8_t {
+  PathQueryChar = 1 << 0,
+  SchemeSuffixChar = 1 << 1,
+  HostChar = 1 << 2,
+};
+
+constexpr std::array<uint8_t, 256> buildCharClassTable() {
+  std::array<uint8_t, 256> table{};
+  // Same set of characters are allowed for path and query.
+  table[9] |= PathQueryChar;
+  table[12] |= PathQueryChar;
+  for (int c = '!'; c <= 126; ++c) {
+    table[c] |= PathQueryChar;
+  }
+  // Scheme started with an alpha character and the rest of it is alpha, digit, '+', '-' or '.'.
+  for (int c = 0; c < 256; ++c) {
+    const bool alpha = ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+    const bool digit = '0' <= c && c <= '9';
+    if (alpha || digit || c == '+' || c == '-' || c == '.') {
+      table[c] |= SchemeSuffixChar;
+    }
+    if (alpha || digit) {
+      table[c] |= HostChar;
+    }
+  }
+  for (const char c : absl::string_view("!$%&'()*+,-.:;=@[]_~")) {
+    table[static_cast<uint8_t>(c)] |= HostChar;
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> kCharClassTable = buildCharClassTable();
+
+bool hasCharClass(char c, CharClass char_class) {
+  return (kCharClassTable[static_cast<uint8_t>(c)] & char_class) != 0;
+}
+
+bool isAlpha(char c) { return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'); }
+
+// Returns true if every byte of `word` is in the range ['!', '~'], i.e. a visible ASCII
+// character. Such bytes are always valid path and query characters.
+bool allBytesVisible(uint64_t word) {
+  constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  // The high bit of a byte is set in `below` only if some byte is less than '!'.
+  const uint64_t below = (word - kOnes * '!') & ~word & kHighBits;
+  // The high bit of a byte is set in `above` only if some byte is greater than '~'.
+  const uint64_t above = ((word + kOnes * (127 - '~')) | word) & kHighBits;
+  return (below | above) == 0;
+}
+
+// Validates path and query characters eight bytes at a time. Words which contain a byte outside
+// of the visible ASCII range are rechecked byte by byte, since tab and form feed are also allowed.
+bool isValidPathQuery(absl::string_view path_query) {
+  const char* it = path_query.data();
+  const char* const end = it + path_query.size();
+  for (; end - it >= static_cast<ptrdiff_t>(sizeof(uint64_t)); it += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, it, sizeof(word));
+    if (!allBytesVisible(word) &&
+        !std::all_of(it, it + sizeof(uint64_t),
+                     [](char c) { return hasCharClass(c, PathQueryChar); })) {
+      return false;
+    }
+  }
+  return std::all_of(it, end, [](char c) { return hasCharClass(c, PathQueryChar); });
+}
+
 // This method is crafted to match the URL validation behavior of the http-parser library.
 bool isUrlValid(absl::string_view url, bool is_connect) {
   if (url.empty()) {
     return false;
   }
 
-  // Same set of characters are allowed for path and query.
-  const auto is_valid_path_query_char = [](char c) {
-    return c == 9 || c == 12 || ('!' <= c && c <= 126);
-  };
-
   // The URL may start with a path.
-  if (auto it = url.begin(); *it == '/' || *it == '*') {
-    ++it;
-    return std::all_of(it, url.end(), is_valid_path_query_char);
+  if (const char first = url.front(); first == '/' || first == '*') {
+    return isValidPathQuery(url.substr(1));
   }
 
   // If method is not CONNECT, parse scheme.
   if (!is_connect) {
     // Scheme must start with alpha and be non-empty.
     auto it = url.begin();
-    if (!std::isalpha(*it)) {
+    if (!isAlpha(*it)) {
       return false;
     }
     ++it;
-    // Scheme started with an alpha character and the rest of it is alpha, digit, '+', '-' or '.'.
-    const auto is_scheme_suffix = [](char c) {
-      return std::isalpha(c) || std::isdigit(c) || c == '+' || c == '-' || c == '.';
-    };
-    it = std::find_if_not(it, url.end(), is_scheme_suffix);
+    it = std::find_if_not(it, url.end(), [](char c) { return hasCharClass(c, SchemeSuffixChar); });
     url.remove_prefix(it - url.begin());
     if (!absl::StartsWith(url, kColonSlashSlash)) {
       return false;
@@ -83,40 +143,31 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
     url.remove_prefix(kColonSlashSlash.length());
   }
 
-  // Path and query start with the first '/' or '?' character.
-  const auto is_path_query_start = [](char c) { return c == '/' || c == '?'; };
-
-  // Divide the rest of the URL into two sections: host, and path/query/fragments.
-  auto path_query_begin = std::find_if(url.begin(), url.end(), is_path_query_start);
-  const absl::string_view host = url.substr(0, path_query_begin - url.begin());
-  const absl::string_view path_query = url.substr(path_query_begin - url.begin());
-
-  const auto valid_host_char = [](char c) {
-    return std::isalnum(c) || c == '!' || c == '$' || c == '%' || c == '&' || c == '\'' ||
-           c == '(' || c == ')' || c == '*' || c == '+' || c == ',' || c == '-' || c == '.' ||
-           c == ':' || c == ';' || c == '=' || c == '@' || c == '[' || c == ']' || c == '_' ||
-           c == '~';
-  };
+  // Divide the rest of the URL into two sections: host, and path/query/fragments. Path and query
+  // start with the first '/' or '?' character.
+  const size_t path_query_begin = std::min(url.find_first_of("/?"), url.size());
+  const absl::string_view host = url.substr(0, path_query_begin);
+  const absl::string_view path_query = url.substr(path_query_begin);
 
   // Match http-parser's quirk of allowing any number of '@' characters in host
   // as long as they are not consecutive.
-  return std::all_of(host.begin(), host.end(), valid_host_char) && !absl::StrContains(host, "@@") &&
-         std::all_of(path_query.begin(), path_query.end(), is_valid_path_query_char);
+  return std::all_of(host.begin(), host.end(),
+                     [](char c) { return hasCharClass(c, HostChar); }) &&
+         !absl::StrContains(host, "@@") && isValidPathQuery(path_query);
 }
 
 bool isVersionValid(absl::string_view version_input) {
   // HTTP-version is defined at
   // https://www.rfc-editor.org/rfc/rfc9112.html#section-2.3. HTTP/0.9 requests
   // have no http-version, so empty `version_input` is also accepted.
-
-  static const auto regex = [] {
-    envoy::type::matcher::v3::RegexMatcher matcher;
-    *matcher.mutable_google_re2() = envoy::type::matcher::v3::RegexMatcher::GoogleRE2();
-    matcher.set_regex("|HTTP/[0-9]\\.[0-9]");
-    return Regex::Utility::parseRegex(matcher);
-  }();
-
-  return regex->match(version_input);
+  // This is equivalent to a full match of the regex "|HTTP/[0-9]\.[0-9]", without the cost of
+  // running a regex for every message.
+  if (version_input.empty()) {
+    return true;
+  }
+  const auto is_digit = [](char c) { return '0' <= c && c <= '9'; };
+  return version_input.size() == 8 && absl::StartsWith(version_input, "HTTP/") &&
+         is_digit(version_input[5]) && version_input[6] == '.' && is_digit(version_input[7]);
 }
 
 } // anonymous namespace
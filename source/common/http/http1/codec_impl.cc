@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
@@ -97,6 +98,50 @@ static constexpr absl::string_view LAST_CHUNK = "0\r\n";
 static constexpr absl::string_view SPACE = " ";
 static constexpr absl::string_view COLON_SPACE = ": ";
 
+namespace {
+
+// Gathers a block of encoded headers, so that it is copied into the output buffer at once instead
+// of one header at a time.
+class HeaderBlockBuilder {
+public:
+  // |max_headers| bounds the number of headers added to the block.
+  HeaderBlockBuilder(HeaderKeyFormatterOptConstRef formatter, size_t max_headers)
+      : formatter_(formatter) {
+    fragments_.reserve(max_headers * 4 + 1);
+    if (formatter_.has_value()) {
+      // The fragments point into the formatted keys, which must not be moved.
+      formatted_keys_.reserve(max_headers);
+    }
+  }
+
+  void add(absl::string_view key, absl::string_view value) {
+    ASSERT(!key.empty());
+    if (formatter_.has_value()) {
+      ASSERT(formatted_keys_.size() < formatted_keys_.capacity());
+      formatted_keys_.push_back(formatter_->format(key));
+      key = formatted_keys_.back();
+    }
+    fragments_.insert(fragments_.end(), {key, COLON_SPACE, value, CRLF});
+    header_size_ += key.size() + COLON_SPACE.size() + value.size() + CRLF.size();
+  }
+
+  // Terminate the block and copy it into the buffer.
+  // @return the size of the headers, excluding the terminating CRLF.
+  uint64_t finish(Buffer::Instance& buffer) {
+    fragments_.push_back(CRLF);
+    buffer.addFragments(fragments_);
+    return header_size_;
+  }
+
+private:
+  HeaderKeyFormatterOptConstRef formatter_;
+  std::vector<std::string> formatted_keys_;
+  std::vector<absl::string_view> fragments_;
+  uint64_t header_size_{};
+};
+
+} // namespace
+
 StreamEncoderImpl::StreamEncoderImpl(ConnectionImpl& connection,
                                      StreamInfo::BytesMeterSharedPtr&& bytes_meter)
     : connection_(connection), disable_chunk_encoding_(false), chunk_encoding_(true),
@@ -110,23 +155,6 @@ StreamEncoderImpl::StreamEncoderImpl(ConnectionImpl& connection,
   }
 }
 
-void StreamEncoderImpl::encodeHeader(absl::string_view key, absl::string_view value) {
-  ASSERT(!key.empty());
-
-  const uint64_t header_size = connection_.buffer().addFragments({key, COLON_SPACE, value, CRLF});
-
-  bytes_meter_->addHeaderBytesSent(header_size);
-}
-
-void StreamEncoderImpl::encodeFormattedHeader(absl::string_view key, absl::string_view value,
-                                              HeaderKeyFormatterOptConstRef formatter) {
-  if (formatter.has_value()) {
-    encodeHeader(formatter->format(key), value);
-  } else {
-    encodeHeader(key, value);
-  }
-}
-
 void ResponseEncoderImpl::encode1xxHeaders(const ResponseHeaderMap& headers) {
   ASSERT(HeaderUtility::isSpecial1xx(headers));
   encodeHeaders(headers, false);
@@ -142,8 +170,10 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
 
   const Http::HeaderValues& header_values = Http::Headers::get();
   bool saw_content_length = false;
+  // Content-Length or Transfer-Encoding may be added below.
+  HeaderBlockBuilder header_block(formatter, headers.size() + 1);
   headers.iterate(
-      [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
+      [&header_values, &header_block](const HeaderEntry& header) -> HeaderMap::Iterate {
         absl::string_view key_to_use = header.key().getStringView();
         uint32_t key_size_to_use = header.key().size();
         // Translate :authority -> host so that upper layers do not need to deal with this.
@@ -157,7 +187,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
           return HeaderMap::Iterate::Continue;
         }
 
-        encodeFormattedHeader(key_to_use, header.value().getStringView(), formatter);
+        header_block.add(key_to_use, header.value().getStringView());
 
         return HeaderMap::Iterate::Continue;
       });
@@ -199,7 +229,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // body, per https://tools.ietf.org/html/rfc7230#section-3.3.2
       if (!status || (*status >= 200 && *status != 204)) {
         if (!bodiless_request) {
-          encodeFormattedHeader(header_values.ContentLength.get(), "0", formatter);
+          header_block.add(header_values.ContentLength.get(), "0");
         }
       }
       chunk_encoding_ = false;
@@ -209,8 +239,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // For responses to connect requests, do not send the chunked encoding header:
       // https://tools.ietf.org/html/rfc7231#section-4.3.6.
       if (!is_response_to_connect_request_) {
-        encodeFormattedHeader(header_values.TransferEncoding.get(),
-                              header_values.TransferEncodingValues.Chunked, formatter);
+        header_block.add(header_values.TransferEncoding.get(),
+                         header_values.TransferEncodingValues.Chunked);
       }
       // We do not apply chunk encoding for HTTP upgrades, including CONNECT style upgrades.
       // If there is a body in a response on the upgrade path, the chunks will be
@@ -224,7 +254,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  bytes_meter_->addHeaderBytesSent(header_block.finish(connection_.buffer()));
 
   if (end_stream) {
     endEncode();
@@ -272,13 +302,13 @@ void StreamEncoderImpl::encodeTrailersBase(const HeaderMap& trailers) {
     connection_.buffer().add(LAST_CHUNK);
 
     // TODO(mattklein123): Wire up the formatter if someone actually asks for this (very unlikely).
-    trailers.iterate([this](const HeaderEntry& header) -> HeaderMap::Iterate {
-      encodeFormattedHeader(header.key().getStringView(), header.value().getStringView(),
-                            HeaderKeyFormatterOptConstRef());
+    HeaderBlockBuilder trailer_block(HeaderKeyFormatterOptConstRef(), trailers.size());
+    trailers.iterate([&trailer_block](const HeaderEntry& header) -> HeaderMap::Iterate {
+      trailer_block.add(header.key().getStringView(), header.value().getStringView());
       return HeaderMap::Iterate::Continue;
     });
 
-    connection_.buffer().add(CRLF);
+    bytes_meter_->addHeaderBytesSent(trailer_block.finish(connection_.buffer()));
   }
 
   flushOutput();
@@ -102,21 +102,11 @@ protected:
   bool is_response_to_connect_request_ : 1;
 
 private:
-  /**
-   * Called to encode an individual header.
-   * @param key supplies the header to encode as a string_view.
-   * @param value supplies the value to encode as a string_view.
-   */
-  void encodeHeader(absl::string_view key, absl::string_view value);
-
   /**
    * Called to finalize a stream encode.
    */
   void endEncode();
 
-  void encodeFormattedHeader(absl::string_view key, absl::string_view value,
-                             HeaderKeyFormatterOptConstRef formatter);
-
   void flushOutput(bool end_encode = false);
 
   absl::string_view details_;
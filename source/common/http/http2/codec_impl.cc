@@ -73,6 +73,11 @@ public:
   }
 };
 
+// With zero copy DATA receive, payloads of at least this many bytes reference the received slice
+// instead of being copied. This bounds how much of a pinned slice isn't seen by the stream's
+// watermark buffer. Smaller payloads are cheaper to copy than to reference.
+constexpr size_t ZeroCopyDataReceiveMinBytes = 8 * 1024;
+
 int reasonToReset(StreamResetReason reason) {
   switch (reason) {
   case StreamResetReason::LocalRefusedStreamReset:
@@ -143,14 +148,6 @@ void ProdNghttp2SessionFactory::init(ConnectionImpl* connection,
   connection->sendSettings(options, true);
 }
 
-/**
- * Helper to remove const during a cast. nghttp2 takes non-const pointers for headers even though
- * it copies them.
- */
-template <typename T> static T* removeConst(const void* object) {
-  return const_cast<T*>(reinterpret_cast<const T*>(object));
-}
-
 ConnectionImpl::StreamImpl::StreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
     : MultiplexedStreamImplBase(parent.connection_.dispatcher()), parent_(parent),
       pending_recv_data_(parent_.connection_.dispatcher().getWatermarkFactory().createBuffer(
@@ -199,30 +196,6 @@ void ConnectionImpl::ServerStreamImpl::destroy() {
   StreamImpl::destroy();
 }
 
-static void insertHeader(std::vector<nghttp2_nv>& headers, const HeaderEntry& header) {
-  uint8_t flags = 0;
-  if (header.key().isReference()) {
-    flags |= NGHTTP2_NV_FLAG_NO_COPY_NAME;
-  }
-  if (header.value().isReference()) {
-    flags |= NGHTTP2_NV_FLAG_NO_COPY_VALUE;
-  }
-  const absl::string_view header_key = header.key().getStringView();
-  const absl::string_view header_value = header.value().getStringView();
-  headers.push_back({removeConst<uint8_t>(header_key.data()),
-                     removeConst<uint8_t>(header_value.data()), header_key.size(),
-                     header_value.size(), flags});
-}
-
-void ConnectionImpl::StreamImpl::buildHeaders(std::vector<nghttp2_nv>& final_headers,
-                                              const HeaderMap& headers) {
-  final_headers.reserve(headers.size());
-  headers.iterate([&final_headers](const HeaderEntry& header) -> HeaderMap::Iterate {
-    insertHeader(final_headers, header);
-    return HeaderMap::Iterate::Continue;
-  });
-}
-
 http2::adapter::HeaderRep getRep(const HeaderString& str) {
   if (str.isReference()) {
     return str.getStringView();
@@ -231,9 +204,10 @@ http2::adapter::HeaderRep getRep(const HeaderString& str) {
   }
 }
 
-std::vector<http2::adapter::Header>
+const std::vector<http2::adapter::Header>&
 ConnectionImpl::StreamImpl::buildHeaders(const HeaderMap& headers) {
-  std::vector<http2::adapter::Header> out;
+  std::vector<http2::adapter::Header>& out = parent_.header_block_;
+  ASSERT(out.empty());
   out.reserve(headers.size());
   headers.iterate([&out](const HeaderEntry& header) -> HeaderMap::Iterate {
     out.push_back({getRep(header.key()), getRep(header.value())});
@@ -611,8 +585,8 @@ void ConnectionImpl::StreamImpl::submitTrailers(const HeaderMap& trailers) {
     return;
   }
 
-  std::vector<http2::adapter::Header> final_headers = buildHeaders(trailers);
-  parent_.adapter_->SubmitTrailer(stream_id_, final_headers);
+  parent_.adapter_->SubmitTrailer(stream_id_, buildHeaders(trailers));
+  parent_.header_block_.clear();
 }
 
 std::pair<int64_t, bool>
@@ -660,6 +634,7 @@ void ConnectionImpl::ClientStreamImpl::submitHeaders(const HeaderMap& headers, b
   stream_id_ = parent_.adapter_->SubmitRequest(
       buildHeaders(headers), end_stream ? nullptr : std::make_unique<StreamDataFrameSource>(*this),
       base());
+  parent_.header_block_.clear();
   ASSERT(stream_id_ > 0);
 }
 
@@ -668,6 +643,7 @@ void ConnectionImpl::ServerStreamImpl::submitHeaders(const HeaderMap& headers, b
   parent_.adapter_->SubmitResponse(stream_id_, buildHeaders(headers),
                                    end_stream ? nullptr
                                               : std::make_unique<StreamDataFrameSource>(*this));
+  parent_.header_block_.clear();
 }
 
 void ConnectionImpl::StreamImpl::onPendingFlushTimer() {
@@ -819,6 +795,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
                                const uint32_t max_headers_kb, const uint32_t max_headers_count)
     : use_oghttp2_library_(
           Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_use_oghttp2")),
+      zero_copy_data_receive_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_zero_copy_data_receive")),
       stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
       max_headers_count_(max_headers_count),
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
@@ -916,10 +894,18 @@ Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
   Cleanup cleanup([this]() {
     dispatching_ = false;
     current_slice_ = nullptr;
+    current_slice_buffer_.reset();
     current_stream_id_.reset();
   });
   last_received_data_time_ = connection_.dispatcher().timeSource().monotonicTime();
+  const uint64_t length = data.length();
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    if (zero_copy_data_receive_) {
+      // Take ownership of the slice so that DATA payloads can reference it. Moving a whole slice
+      // does not copy it, and the slices are dispatched in order, so it is always the front one.
+      current_slice_buffer_ = std::make_shared<Buffer::OwnedImpl>();
+      current_slice_buffer_->move(data, slice.len_);
+    }
     current_slice_ = &slice;
     dispatching_ = true;
     ssize_t rc;
@@ -940,11 +926,12 @@ Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
     }
 
     current_slice_ = nullptr;
+    current_slice_buffer_.reset();
     dispatching_ = false;
     current_stream_id_.reset();
   }
 
-  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, data.length());
+  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, length);
   data.drain(data.length());
 
   // Decoding incoming frames can generate outbound frames so flush pending.
@@ -976,7 +963,22 @@ int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   StreamImpl* stream = getStream(stream_id);
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
-  stream->pending_recv_data_->add(data, len);
+  if (current_slice_buffer_ != nullptr && len >= ZeroCopyDataReceiveMinBytes &&
+      stream->buffer_memory_account_ == nullptr &&
+      data >= static_cast<const uint8_t*>(current_slice_->mem_) &&
+      data + len <= static_cast<const uint8_t*>(current_slice_->mem_) + current_slice_->len_) {
+    // Reference the received bytes instead of copying them. Streams that are charged to a memory
+    // account always copy, as only owned slices are charged.
+    auto* data_fragment = new Buffer::BufferFragmentImpl(
+        data, len,
+        [slice_buffer = current_slice_buffer_](const void*, size_t,
+                                               const Buffer::BufferFragmentImpl* fragment) {
+          delete fragment;
+        });
+    stream->pending_recv_data_->addBufferFragment(*data_fragment);
+  } else {
+    stream->pending_recv_data_->add(data, len);
+  }
   // Update the window to the peer unless some consumer of this stream's data has hit a flow control
   // limit and disabled reads on this stream
   if (stream->shouldAllowPeerAdditionalStreamWindow()) {
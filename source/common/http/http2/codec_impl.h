@@ -213,8 +213,9 @@ protected:
 
     StreamImpl* base() { return this; }
     void resetStreamWorker(StreamResetReason reason);
-    static void buildHeaders(std::vector<nghttp2_nv>& final_headers, const HeaderMap& headers);
-    static std::vector<http2::adapter::Header> buildHeaders(const HeaderMap& headers);
+    // Builds the header block to submit into the connection's reused header vector, which the
+    // caller clears once the adapter has taken the headers.
+    const std::vector<http2::adapter::Header>& buildHeaders(const HeaderMap& headers);
     void saveHeader(HeaderString&& name, HeaderString&& value);
     void encodeHeadersBase(const HeaderMap& headers, bool end_stream);
     virtual void submitHeaders(const HeaderMap& headers, bool end_stream) PURE;
@@ -603,6 +604,8 @@ protected:
 
   // Whether to use the new HTTP/2 library.
   const bool use_oghttp2_library_;
+  // Whether large DATA payloads reference the received slices instead of being copied.
+  const bool zero_copy_data_receive_;
   static Http2Callbacks http2_callbacks_;
 
   // If deferred processing, the streams will be in LRU order based on when the
@@ -616,6 +619,9 @@ protected:
   absl::optional<int32_t> current_stream_id_;
   std::unique_ptr<http2::adapter::Http2VisitorInterface> visitor_;
   std::unique_ptr<http2::adapter::Http2Adapter> adapter_;
+  // Scratch vector for the header blocks submitted to the adapter. The adapter copies the headers
+  // on submission, so the vector is cleared afterwards and its capacity reused for the next block.
+  std::vector<http2::adapter::Header> header_block_;
 
   CodecStats& stats_;
   Network::Connection& connection_;
@@ -692,6 +698,9 @@ private:
 
   // Tracks the current slice we're processing in the dispatch loop.
   const Buffer::RawSlice* current_slice_ = nullptr;
+  // Owns the current slice while zero copy DATA receive is enabled. DATA payloads that reference it
+  // keep it alive after dispatch.
+  std::shared_ptr<Buffer::OwnedImpl> current_slice_buffer_;
   // Streams that are pending deferred reset. Using an ordered map provides determinism in the rare
   // case where there are multiple streams waiting for deferred reset. The stream id is also used to
   // remove streams from the map when they are closed in order to avoid calls to resetStreamWorker
@@ -218,6 +218,9 @@ HttpServerPropertiesCacheImpl::setPropertiesImpl(const Origin& origin,
     if (origin_data.srtt.count()) {
       entry_it->second.srtt = origin_data.srtt;
     }
+    if (origin_data.concurrent_streams) {
+      entry_it->second.concurrent_streams = origin_data.concurrent_streams;
+    }
     if (origin_data.h3_status_tracker) {
       entry_it->second.h3_status_tracker = std::move(origin_data.h3_status_tracker);
     }
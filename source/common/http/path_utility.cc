@@ -42,16 +42,20 @@ bool PathUtil::canonicalPath(RequestHeaderMap& headers) {
   const auto original_path = headers.getPathValue();
   // canonicalPath is supposed to apply on path component in URL instead of :path header
   const auto query_pos = original_path.find('?');
-  auto normalized_path_opt = canonicalizePath(
+  const absl::string_view original_path_component =
       query_pos == original_path.npos
           ? original_path
-          : absl::string_view(original_path.data(), query_pos) // '?' is not included
-  );
+          : absl::string_view(original_path.data(), query_pos); // '?' is not included
+  auto normalized_path_opt = canonicalizePath(original_path_component);
 
   if (!normalized_path_opt.has_value()) {
     return false;
   }
   auto& normalized_path = normalized_path_opt.value();
+  // Most paths are already canonical, leave the header untouched rather than rebuilding it.
+  if (normalized_path == original_path_component) {
+    return true;
+  }
   const absl::string_view query_suffix =
       query_pos == original_path.npos
           ? absl::string_view{}
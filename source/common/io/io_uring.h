@@ -79,6 +79,26 @@ public:
   virtual IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                       off_t offset, void* user_data) PURE;
 
+  /**
+   * Prepares a read into a buffer registered with registerBuffers() and puts it into the
+   * submission queue. If fixed_file is true, fd is an index into the file table registered with
+   * registerFileTable() rather than a file descriptor.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareReadFixed(os_fd_t fd, bool fixed_file, void* buf, unsigned nbytes,
+                                         off_t offset, int buf_index, void* user_data) PURE;
+
+  /**
+   * Prepares a writev system call on a file of the table registered with registerFileTable() and
+   * puts it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareWritevFixedFile(unsigned file_index, const struct iovec* iovecs,
+                                               unsigned nr_vecs, off_t offset,
+                                               void* user_data) PURE;
+
   /**
    * Prepares a close system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -95,8 +115,34 @@ public:
    * with the forEveryCompletion() method and try again.
    */
   virtual IoUringResult submit() PURE;
+
+  /**
+   * Registers buffers with the ring, so that the kernel maps them once rather than for every
+   * request reading into them. They can be registered once per ring, and stay registered until
+   * the ring is destroyed.
+   * Returns IoUringResult::Failed if the buffers could not be registered, for example because
+   * they exceed the locked memory limit, and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult registerBuffers(const struct iovec* iovecs, unsigned nr_iovecs) PURE;
+
+  /**
+   * Registers an empty table of files with the ring. Requests on a file of the table don't take a
+   * reference to the file each time. The table can be registered once per ring.
+   * Returns IoUringResult::Failed if the table could not be registered and IoUringResult::Ok
+   * otherwise.
+   */
+  virtual IoUringResult registerFileTable(unsigned size) PURE;
+
+  /**
+   * Sets an entry of the table registered with registerFileTable() to a file descriptor, or
+   * clears it if fd is INVALID_SOCKET. Requests already submitted on the entry are not affected.
+   * Returns IoUringResult::Failed if the entry could not be set and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult setRegisteredFile(unsigned index, os_fd_t fd) PURE;
 };
 
+using IoUringPtr = std::unique_ptr<IoUring>;
+
 /**
  * Abstract factory for IoUring wrappers.
  */
@@ -1,6 +1,7 @@
 #include "source/common/io/io_uring_impl.h"
 
 #include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace Envoy {
 namespace Io {
@@ -56,6 +57,7 @@ os_fd_t IoUringImpl::registerEventfd() {
 void IoUringImpl::unregisterEventfd() {
   int res = io_uring_unregister_eventfd(&ring_);
   RELEASE_ASSERT(res == 0, fmt::format("unable to unregister eventfd: {}", errorDetails(-res)));
+  ::close(event_fd_);
   SET_SOCKET_INVALID(event_fd_);
 }
 
@@ -126,6 +128,36 @@ IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareReadFixed(os_fd_t fd, bool fixed_file, void* buf,
+                                            unsigned nbytes, off_t offset, int buf_index,
+                                            void* user_data) {
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_read_fixed(sqe, fd, buf, nbytes, offset, buf_index);
+  if (fixed_file) {
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareWritevFixedFile(unsigned file_index, const struct iovec* iovecs,
+                                                  unsigned nr_vecs, off_t offset,
+                                                  void* user_data) {
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_writev(sqe, file_index, iovecs, nr_vecs, offset);
+  sqe->flags |= IOSQE_FIXED_FILE;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareClose(os_fd_t fd, void* user_data) {
   struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
   if (sqe == nullptr) {
@@ -143,5 +175,21 @@ IoUringResult IoUringImpl::submit() {
   return res == -EBUSY ? IoUringResult::Busy : IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::registerBuffers(const struct iovec* iovecs, unsigned nr_iovecs) {
+  return io_uring_register_buffers(&ring_, iovecs, nr_iovecs) == 0 ? IoUringResult::Ok
+                                                                    : IoUringResult::Failed;
+}
+
+IoUringResult IoUringImpl::registerFileTable(unsigned size) {
+  return io_uring_register_files_sparse(&ring_, size) == 0 ? IoUringResult::Ok
+                                                             : IoUringResult::Failed;
+}
+
+IoUringResult IoUringImpl::setRegisteredFile(unsigned index, os_fd_t fd) {
+  // io_uring_register_files_update() returns the number of updated entries.
+  int res = io_uring_register_files_update(&ring_, index, &fd, 1);
+  return res == 1 ? IoUringResult::Ok : IoUringResult::Failed;
+}
+
 } // namespace Io
 } // namespace Envoy
@@ -28,8 +28,15 @@ public:
                              void* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, void* user_data) override;
+  IoUringResult prepareReadFixed(os_fd_t fd, bool fixed_file, void* buf, unsigned nbytes,
+                                 off_t offset, int buf_index, void* user_data) override;
+  IoUringResult prepareWritevFixedFile(unsigned file_index, const struct iovec* iovecs,
+                                       unsigned nr_vecs, off_t offset, void* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, void* user_data) override;
   IoUringResult submit() override;
+  IoUringResult registerBuffers(const struct iovec* iovecs, unsigned nr_iovecs) override;
+  IoUringResult registerFileTable(unsigned size) override;
+  IoUringResult setRegisteredFile(unsigned index, os_fd_t fd) override;
 
 private:
   const uint32_t io_uring_size_;
@@ -0,0 +1,116 @@
+#include "source/common/io/io_uring_worker_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Io {
+
+IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr io_uring, Event::Dispatcher& dispatcher)
+    : io_uring_(std::move(io_uring)), submit_cb_(dispatcher.createSchedulableCallback([this]() {
+        submit();
+      })) {
+  const os_fd_t event_fd = io_uring_->registerEventfd();
+  file_event_ = dispatcher.createFileEvent(
+      event_fd, [this](uint32_t) { onEventfdReadable(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+}
+
+IoUringWorkerImpl::~IoUringWorkerImpl() {
+  submit_cb_->cancel();
+  file_event_.reset();
+  io_uring_->unregisterEventfd();
+}
+
+template <class PrepareFn>
+IoUringResult IoUringWorkerImpl::prepare(PrepareFn prepare_fn, RequestCompletionCb cb) {
+  auto it = requests_.emplace(requests_.end());
+  it->cb_ = std::move(cb);
+  it->self_ = it;
+
+  IoUringResult result = prepare_fn(&*it);
+  if (result == IoUringResult::Failed) {
+    // The submission queue is full. Hand the queued entries to the kernel and try once more.
+    submit_cb_->cancel();
+    submit();
+    result = prepare_fn(&*it);
+  }
+  if (result == IoUringResult::Failed) {
+    requests_.erase(it);
+    return result;
+  }
+
+  if (!submit_cb_->enabled()) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+  }
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringWorkerImpl::accept(os_fd_t fd, struct sockaddr* remote_addr,
+                                        socklen_t* remote_addr_len, RequestCompletionCb cb) {
+  return prepare(
+      [&](void* user_data) {
+        return io_uring_->prepareAccept(fd, remote_addr, remote_addr_len, user_data);
+      },
+      std::move(cb));
+}
+
+IoUringResult IoUringWorkerImpl::connect(os_fd_t fd,
+                                         const Network::Address::InstanceConstSharedPtr& address,
+                                         RequestCompletionCb cb) {
+  return prepare(
+      [&](void* user_data) { return io_uring_->prepareConnect(fd, address, user_data); },
+      std::move(cb));
+}
+
+IoUringResult IoUringWorkerImpl::readv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                                       off_t offset, RequestCompletionCb cb) {
+  return prepare(
+      [&](void* user_data) {
+        return io_uring_->prepareReadv(fd, iovecs, nr_vecs, offset, user_data);
+      },
+      std::move(cb));
+}
+
+IoUringResult IoUringWorkerImpl::writev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                                        off_t offset, RequestCompletionCb cb) {
+  return prepare(
+      [&](void* user_data) {
+        return io_uring_->prepareWritev(fd, iovecs, nr_vecs, offset, user_data);
+      },
+      std::move(cb));
+}
+
+IoUringResult IoUringWorkerImpl::close(os_fd_t fd, RequestCompletionCb cb) {
+  return prepare([&](void* user_data) { return io_uring_->prepareClose(fd, user_data); },
+                 std::move(cb));
+}
+
+void IoUringWorkerImpl::submit() {
+  // When too many requests are in flight the kernel refuses new entries until completions are
+  // reaped. The remaining entries are then submitted after the next batch of completions.
+  submit_deferred_ = io_uring_->submit() == IoUringResult::Busy;
+  if (submit_deferred_) {
+    ENVOY_LOG_MISC(trace, "io_uring submission deferred until completions are reaped");
+  }
+}
+
+void IoUringWorkerImpl::onEventfdReadable() {
+  io_uring_->forEveryCompletion([this](void* user_data, int32_t result) {
+    ASSERT(user_data != nullptr);
+    Request* request = static_cast<Request*>(user_data);
+    // Release the request before running the callback so that the callback may safely prepare
+    // new requests or destroy objects the request refers to.
+    RequestCompletionCb cb = std::move(request->cb_);
+    requests_.erase(request->self_);
+    cb(result);
+  });
+
+  // Submit entries that could not be handed to the kernel while the completion queue was busy.
+  if (submit_deferred_ && !submit_cb_->enabled()) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+} // namespace Io
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <list>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+#include "envoy/event/schedulable_cb.h"
+
+#include "source/common/io/io_uring.h"
+
+namespace Envoy {
+namespace Io {
+
+/**
+ * Callback invoked when a request submitted through an IoUringWorker completes.
+ * @param result is the return code of the submitted system call.
+ */
+using RequestCompletionCb = std::function<void(int32_t result)>;
+
+/**
+ * Drives an IoUring from a dispatcher. The ring's eventfd is registered with the dispatcher so that
+ * completions are delivered on the dispatcher thread, and requests prepared while handling events
+ * are submitted to the kernel with a single io_uring_enter() call at the end of the current event
+ * loop iteration instead of one system call per request.
+ *
+ * This is the event loop integration an io_uring based IoHandle is built on.
+ */
+class IoUringWorkerImpl {
+public:
+  IoUringWorkerImpl(IoUringPtr io_uring, Event::Dispatcher& dispatcher);
+  ~IoUringWorkerImpl();
+
+  /**
+   * Each method below prepares the corresponding system call and arranges for it to be
+   * submitted. The completion callback is invoked on the dispatcher thread once the request
+   * completes. Returns IoUringResult::Failed if the request could not be queued even after
+   * flushing the submission queue, in which case the callback is never invoked.
+   */
+  IoUringResult accept(os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
+                       RequestCompletionCb cb);
+  IoUringResult connect(os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
+                        RequestCompletionCb cb);
+  IoUringResult readv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
+                      RequestCompletionCb cb);
+  IoUringResult writev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
+                       RequestCompletionCb cb);
+  IoUringResult close(os_fd_t fd, RequestCompletionCb cb);
+
+  /**
+   * @return the number of requests that have been prepared but have not completed yet.
+   */
+  uint64_t pendingRequests() const { return requests_.size(); }
+
+private:
+  struct Request {
+    RequestCompletionCb cb_;
+    std::list<Request>::iterator self_;
+  };
+
+  template <class PrepareFn> IoUringResult prepare(PrepareFn prepare_fn, RequestCompletionCb cb);
+  void submit();
+  void onEventfdReadable();
+
+  IoUringPtr io_uring_;
+  Event::FileEventPtr file_event_;
+  Event::SchedulableCallbackPtr submit_cb_;
+  // Requests are owned here so that they are released if the worker goes away before the kernel
+  // reports their completion. std::list keeps the addresses used as user data stable.
+  std::list<Request> requests_;
+  bool submit_deferred_{};
+};
+
+} // namespace Io
+} // namespace Envoy
@@ -47,6 +47,54 @@ static constexpr uint32_t needs_slow_sanitizer[256] = {
 // SPELLCHECKER(on)
 // clang-format on
 
+namespace {
+
+// Escapes a string containing only 7-bit ascii exactly as the Nlohmann serializer
+// would. There is no utf-8 to validate, so this can't fail, and runs of
+// characters that need no escape are copied at once.
+void sanitizeAscii(std::string& buffer, absl::string_view str) {
+  buffer.clear();
+  size_t run_start = 0;
+  for (size_t i = 0; i < str.size(); ++i) {
+    const char c = str[i];
+    // Nlohmann passes DEL through unescaped.
+    if (!needs_slow_sanitizer[static_cast<uint8_t>(c)] || c == '\177') {
+      continue;
+    }
+    buffer.append(str.data() + run_start, i - run_start);
+    run_start = i + 1;
+    switch (c) {
+    case '"':
+      buffer.append("\\\"");
+      break;
+    case '\\':
+      buffer.append("\\\\");
+      break;
+    case '\b':
+      buffer.append("\\b");
+      break;
+    case '\f':
+      buffer.append("\\f");
+      break;
+    case '\n':
+      buffer.append("\\n");
+      break;
+    case '\r':
+      buffer.append("\\r");
+      break;
+    case '\t':
+      buffer.append("\\t");
+      break;
+    default:
+      buffer.append(absl::StrFormat("\\u%04x", static_cast<uint32_t>(c)));
+      break;
+    }
+  }
+  buffer.append(str.data() + run_start, str.size() - run_start);
+}
+
+} // namespace
+
 absl::string_view sanitize(std::string& buffer, absl::string_view str) {
   // Fast-path to see whether any escapes or utf-encoding are needed. If str has
   // only unescaped ascii characters, we can simply return it.
@@ -57,14 +105,21 @@ absl::string_view sanitize(std::string& buffer, absl::string_view str) {
   // compiler.
   static_assert(ARRAY_SIZE(needs_slow_sanitizer) == 256);
   uint32_t need_slow = 0;
+  uint8_t high_bits = 0;
   for (char c : str) {
     // We need to escape control characters, characters >= 127, and double-quote
     // and backslash.
     need_slow |= needs_slow_sanitizer[static_cast<uint8_t>(c)];
+    high_bits |= static_cast<uint8_t>(c);
   }
   if (need_slow == 0) {
     return str; // Fast path, should be executed most of the time.
   }
+  if ((high_bits & 0x80) == 0) {
+    // Only ascii escapes are needed, such as quotes in a header value.
+    sanitizeAscii(buffer, str);
+    return buffer;
+  }
   TRY_ASSERT_MAIN_THREAD {
     // The Nlohmann JSON library supports serialization and is not too slow. A
     // hand-rolled sanitizer can be a little over 2x faster at the cost of added
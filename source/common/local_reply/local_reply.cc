@@ -18,9 +18,9 @@ namespace LocalReply {
 
 class BodyFormatter {
 public:
-  BodyFormatter()
-      : formatter_(std::make_unique<Envoy::Formatter::FormatterImpl>("%LOCAL_REPLY_BODY%")),
-        content_type_(Http::Headers::get().ContentTypeValues.Text) {}
+  // The default formatter is "%LOCAL_REPLY_BODY%", which leaves the body as is, so it is applied
+  // without running a formatter that would copy the body into a new string.
+  BodyFormatter() : content_type_(Http::Headers::get().ContentTypeValues.Text) {}
 
   BodyFormatter(const envoy::config::core::v3::SubstitutionFormatString& config,
                 Server::Configuration::CommonFactoryContext& context)
@@ -37,12 +37,15 @@ public:
               const Http::ResponseTrailerMap& response_trailers,
               const StreamInfo::StreamInfo& stream_info, std::string& body,
               absl::string_view& content_type) const {
-    body =
-        formatter_->format(request_headers, response_headers, response_trailers, stream_info, body);
+    if (formatter_ != nullptr) {
+      body = formatter_->format(request_headers, response_headers, response_trailers, stream_info,
+                                body);
+    }
     content_type = content_type_;
   }
 
 private:
+  // Null for the default formatter.
   const Formatter::FormatterPtr formatter_;
   const std::string content_type_;
 };
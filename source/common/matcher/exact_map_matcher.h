@@ -21,13 +21,13 @@ public:
   }
 
 protected:
-  absl::optional<OnMatch<DataType>> doMatch(const std::string& data) override {
+  const OnMatch<DataType>* doMatch(const std::string& data) override {
     const auto itr = children_.find(data);
     if (itr != children_.end()) {
-      return itr->second;
+      return &itr->second;
     }
 
-    return absl::nullopt;
+    return nullptr;
   }
 
 private:
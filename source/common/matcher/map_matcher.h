@@ -31,8 +31,8 @@ public:
       return {MatchState::MatchComplete, on_no_match_};
     }
 
-    const auto result = doMatch(*input.data_);
-    if (result) {
+    const OnMatch<DataType>* result = doMatch(*input.data_);
+    if (result != nullptr) {
       if (result->matcher_) {
         return result->matcher_->match(data);
       } else {
@@ -54,8 +54,9 @@ protected:
 
   // The inner match method. Attempts to match against the resulting data string. If the match
   // result was determined, the OnMatch will be returned. If a match result was determined to be no
-  // match, {} will be returned.
-  virtual absl::optional<OnMatch<DataType>> doMatch(const std::string& data) PURE;
+  // match, nullptr will be returned. The OnMatch is owned by the matcher, so that matching does not
+  // copy its action callback and sub-tree.
+  virtual const OnMatch<DataType>* doMatch(const std::string& data) PURE;
 };
 
 } // namespace Matcher
@@ -21,13 +21,8 @@ public:
   }
 
 protected:
-  absl::optional<OnMatch<DataType>> doMatch(const std::string& data) override {
-    const auto result = children_.findLongestPrefix(data.c_str());
-    if (result) {
-      return *result;
-    }
-
-    return absl::nullopt;
+  const OnMatch<DataType>* doMatch(const std::string& data) override {
+    return children_.findLongestPrefix(data.c_str()).get();
   }
 
 private:
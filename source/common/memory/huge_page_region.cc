@@ -0,0 +1,117 @@
+#include "source/common/memory/huge_page_region.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Envoy {
+namespace Memory {
+
+std::atomic<HugePageRegion*> HugePageRegion::buffers_{nullptr};
+
+HugePageRegion::~HugePageRegion() {
+#if defined(__linux__)
+  ::munmap(base_, size_);
+#endif
+}
+
+std::unique_ptr<HugePageRegion> HugePageRegion::create(uint64_t size, uint64_t block_size,
+                                                       bool explicit_huge_pages) {
+  ASSERT(block_size > 0 && HugePageSize % block_size == 0);
+#if defined(__linux__)
+  size = (size + HugePageSize - 1) / HugePageSize * HugePageSize;
+  if (size == 0) {
+    return nullptr;
+  }
+
+  uint8_t* base;
+  if (explicit_huge_pages) {
+    // Mappings from the huge page pool are always aligned to the huge page size.
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping == MAP_FAILED) {
+      ENVOY_LOG_MISC(warn, "unable to map {} bytes of explicit huge pages: {}", size,
+                     errorDetails(errno));
+      return nullptr;
+    }
+    base = static_cast<uint8_t*>(mapping);
+  } else {
+    // Over-map by one huge page so the region can start on a huge page boundary, which is
+    // required for the kernel to back it with huge pages.
+    void* mapping = ::mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      ENVOY_LOG_MISC(warn, "unable to map {} bytes for huge pages: {}", size, errorDetails(errno));
+      return nullptr;
+    }
+    uint8_t* const start = static_cast<uint8_t*>(mapping);
+    base = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(start) + HugePageSize - 1) &
+                                      ~(HugePageSize - 1));
+    if (base != start) {
+      ::munmap(start, base - start);
+    }
+    const uint64_t tail = HugePageSize - (base - start);
+    if (tail != 0) {
+      ::munmap(base + size, tail);
+    }
+    if (::madvise(base, size, MADV_HUGEPAGE) != 0) {
+      // The region still works, it's just backed by regular pages.
+      ENVOY_LOG_MISC(warn, "transparent huge pages are not available: {}", errorDetails(errno));
+    }
+  }
+  return std::unique_ptr<HugePageRegion>(new HugePageRegion(base, size, block_size));
+#else
+  UNREFERENCED_PARAMETER(size);
+  UNREFERENCED_PARAMETER(explicit_huge_pages);
+  ENVOY_LOG_MISC(warn, "huge page regions are not supported on this platform");
+  return nullptr;
+#endif
+}
+
+void* HugePageRegion::allocate() {
+  void* block;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!free_blocks_.empty()) {
+      block = free_blocks_.back();
+      free_blocks_.pop_back();
+    } else if (next_ + block_size_ <= size_) {
+      block = base_ + next_;
+      next_ += block_size_;
+      committed_bytes_.store(next_, std::memory_order_relaxed);
+    } else {
+      return nullptr;
+    }
+  }
+  allocated_bytes_.fetch_add(block_size_, std::memory_order_relaxed);
+  return block;
+}
+
+void HugePageRegion::deallocate(void* block) {
+  ASSERT(owns(block));
+  ASSERT((static_cast<uint8_t*>(block) - base_) % block_size_ == 0);
+  allocated_bytes_.fetch_sub(block_size_, std::memory_order_relaxed);
+  absl::MutexLock lock(&mutex_);
+  free_blocks_.push_back(block);
+}
+
+bool HugePageRegion::initializeForBuffers(uint64_t size, uint64_t block_size,
+                                          bool explicit_huge_pages) {
+  if (forBuffers() != nullptr) {
+    return true;
+  }
+  std::unique_ptr<HugePageRegion> region = create(size, block_size, explicit_huge_pages);
+  if (region == nullptr) {
+    return false;
+  }
+  // Intentionally leaked: slices may still refer to the region while the process exits.
+  buffers_.store(region.release(), std::memory_order_release);
+  return true;
+}
+
+} // namespace Memory
+} // namespace Envoy
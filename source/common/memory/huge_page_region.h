@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * A dedicated region of memory backed by 2MB huge pages and carved into blocks of a fixed size.
+ * Backing frequently allocated memory with huge pages reduces TLB misses when that memory is
+ * touched at high rates, e.g. buffer slices on high throughput proxies.
+ *
+ * Blocks are handed out from the start of the region and recycled through a free list once
+ * released, so at most size() bytes are ever mapped. Users must fall back to the heap once the
+ * region is exhausted.
+ */
+class HugePageRegion {
+public:
+  static constexpr uint64_t HugePageSize = 2 * 1024 * 1024;
+
+  ~HugePageRegion();
+
+  /**
+   * Map a new region. Only supported on Linux.
+   * @param size supplies the size of the region in bytes. It is rounded up to a multiple of
+   *        HugePageSize.
+   * @param block_size supplies the size of the blocks. It must divide HugePageSize.
+   * @param explicit_huge_pages supplies whether to map the region from the pool of explicitly
+   *        reserved huge pages (MAP_HUGETLB) rather than relying on transparent huge pages.
+   * @return the region, or nullptr if it could not be mapped.
+   */
+  static std::unique_ptr<HugePageRegion> create(uint64_t size, uint64_t block_size,
+                                                bool explicit_huge_pages);
+
+  /**
+   * @return a block of block_size() bytes, or nullptr if the region is exhausted.
+   */
+  void* allocate();
+
+  /**
+   * Release a block returned by allocate().
+   */
+  void deallocate(void* block);
+
+  /**
+   * @return whether the memory is part of the region.
+   */
+  bool owns(const void* p) const {
+    const uint8_t* byte = static_cast<const uint8_t*>(p);
+    return byte >= base_ && byte < base_ + size_;
+  }
+
+  uint64_t size() const { return size_; }
+  uint64_t blockSize() const { return block_size_; }
+
+  /**
+   * @return the number of bytes currently handed out by allocate().
+   */
+  uint64_t allocatedBytes() const { return allocated_bytes_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the number of bytes of the region that have been touched and are therefore likely
+   *         backed by physical memory.
+   */
+  uint64_t committedBytes() const { return committed_bytes_.load(std::memory_order_relaxed); }
+
+  /**
+   * Set up the process wide region that backs buffer slice storage. The region lives until the
+   * process exits, since buffers may outlive any owner. Must be called before other threads
+   * allocate buffers. Subsequent calls keep the existing region.
+   * @return whether a region is available.
+   */
+  static bool initializeForBuffers(uint64_t size, uint64_t block_size, bool explicit_huge_pages);
+
+  /**
+   * @return the process wide region that backs buffer slice storage, or nullptr if there is none.
+   */
+  static HugePageRegion* forBuffers() { return buffers_.load(std::memory_order_acquire); }
+
+private:
+  HugePageRegion(uint8_t* base, uint64_t size, uint64_t block_size)
+      : base_(base), size_(size), block_size_(block_size) {}
+
+  static std::atomic<HugePageRegion*> buffers_;
+
+  uint8_t* const base_;
+  const uint64_t size_;
+  const uint64_t block_size_;
+  absl::Mutex mutex_;
+  // Offset of the first block that was never handed out.
+  uint64_t next_ ABSL_GUARDED_BY(mutex_){0};
+  std::vector<void*> free_blocks_ ABSL_GUARDED_BY(mutex_);
+  std::atomic<uint64_t> allocated_bytes_{0};
+  std::atomic<uint64_t> committed_bytes_{0};
+};
+
+} // namespace Memory
+} // namespace Envoy
@@ -3,6 +3,34 @@
 #include <cstdint>
 
 #include "source/common/common/logger.h"
+#include "source/common/memory/huge_page_region.h"
+
+#if defined(TCMALLOC) || defined(GPERFTOOLS_TCMALLOC)
+namespace Envoy {
+namespace Memory {
+namespace {
+
+// Buffer memory in the huge page region doesn't come from the heap, so it's added to the allocator
+// numbers to keep the totals correct.
+uint64_t bufferRegionAllocatedBytes() {
+  const HugePageRegion* region = HugePageRegion::forBuffers();
+  return region != nullptr ? region->allocatedBytes() : 0;
+}
+
+uint64_t bufferRegionReservedBytes() {
+  const HugePageRegion* region = HugePageRegion::forBuffers();
+  return region != nullptr ? region->size() : 0;
+}
+
+uint64_t bufferRegionPhysicalBytes() {
+  const HugePageRegion* region = HugePageRegion::forBuffers();
+  return region != nullptr ? region->committedBytes() : 0;
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
+#endif
 
 #if defined(TCMALLOC)
 
@@ -13,7 +41,8 @@ namespace Memory {
 
 uint64_t Stats::totalCurrentlyAllocated() {
   return tcmalloc::MallocExtension::GetNumericProperty("generic.current_allocated_bytes")
-      .value_or(0);
+             .value_or(0) +
+         bufferRegionAllocatedBytes();
 }
 
 uint64_t Stats::totalCurrentlyReserved() {
@@ -21,7 +50,8 @@ uint64_t Stats::totalCurrentlyReserved() {
   // changed: it doesn't include unmapped bytes.
   return tcmalloc::MallocExtension::GetNumericProperty("generic.heap_size").value_or(0) +
          tcmalloc::MallocExtension::GetNumericProperty("tcmalloc.pageheap_unmapped_bytes")
-             .value_or(0);
+             .value_or(0) +
+         bufferRegionReservedBytes();
 }
 
 uint64_t Stats::totalThreadCacheBytes() {
@@ -39,7 +69,8 @@ uint64_t Stats::totalPageHeapUnmapped() {
 }
 
 uint64_t Stats::totalPhysicalBytes() {
-  return tcmalloc::MallocExtension::GetProperties()["generic.physical_memory_used"].value;
+  return tcmalloc::MallocExtension::GetProperties()["generic.physical_memory_used"].value +
+         bufferRegionPhysicalBytes();
 }
 
 void Stats::dumpStatsToLog() {
@@ -59,13 +90,13 @@ namespace Memory {
 uint64_t Stats::totalCurrentlyAllocated() {
   size_t value = 0;
   MallocExtension::instance()->GetNumericProperty("generic.current_allocated_bytes", &value);
-  return value;
+  return value + bufferRegionAllocatedBytes();
 }
 
 uint64_t Stats::totalCurrentlyReserved() {
   size_t value = 0;
   MallocExtension::instance()->GetNumericProperty("generic.heap_size", &value);
-  return value;
+  return value + bufferRegionReservedBytes();
 }
 
 uint64_t Stats::totalThreadCacheBytes() {
@@ -90,7 +121,7 @@ uint64_t Stats::totalPageHeapUnmapped() {
 uint64_t Stats::totalPhysicalBytes() {
   size_t value = 0;
   MallocExtension::instance()->GetNumericProperty("generic.total_physical_bytes", &value);
-  return value;
+  return value + bufferRegionPhysicalBytes();
 }
 
 void Stats::dumpStatsToLog() {
@@ -328,7 +328,14 @@ void Ipv6Instance::initHelper(const sockaddr_in6& address, bool v6only) {
   ip_.ipv6_.address_ = address;
   ip_.friendly_address_ = ip_.ipv6_.makeFriendlyAddress();
   ip_.ipv6_.v6only_ = v6only;
-  friendly_name_ = fmt::format("[{}]:{}", ip_.friendly_address_, ip_.port());
+
+  // As for IPv4, reserve+append avoids the intermediate buffer of fmt::format.
+  fmt::format_int port(ip_.port());
+  friendly_name_.reserve(ip_.friendly_address_.size() + 3 + port.size());
+  friendly_name_.push_back('[');
+  friendly_name_.append(ip_.friendly_address_);
+  friendly_name_.append("]:");
+  friendly_name_.append(port.data(), port.size());
 }
 
 PipeInstance::PipeInstance(const sockaddr_un* address, socklen_t ss_len, mode_t mode,
@@ -170,8 +170,10 @@ public:
     //
     // The Nilsson and Karlsson paper linked in lc_trie.h has a more thorough example.
 
-    ipv4_trie_.reset(new LcTrieInternal<Ipv4>(ipv4_prefixes, fill_factor, root_branching_factor));
-    ipv6_trie_.reset(new LcTrieInternal<Ipv6>(ipv6_prefixes, fill_factor, root_branching_factor));
+    ipv4_trie_.reset(
+        new LcTrieInternal<Ipv4>(std::move(ipv4_prefixes), fill_factor, root_branching_factor));
+    ipv6_trie_.reset(
+        new LcTrieInternal<Ipv6>(std::move(ipv6_prefixes), fill_factor, root_branching_factor));
   }
 
   /**
@@ -416,14 +418,15 @@ private:
   public:
     /**
      * Construct a LC-Trie for IpType.
-     * @param data supplies a vector of data and CIDR ranges (in IpPrefix format).
+     * @param data supplies a vector of data and CIDR ranges (in IpPrefix format). The trie takes
+     *             ownership of the prefixes rather than copying them and their data sets.
      * @param fill_factor supplies the fraction of completeness to use when calculating the branch
      *                    value for a sub-trie.
      * @param root_branching_factor supplies the branching factor at the root. The paper suggests
      *                              for large LC-Tries to use the value '16' for the root
      *                              branching factor. It reduces the depth of the trie.
      */
-    LcTrieInternal(std::vector<IpPrefix<IpType>>& data, double fill_factor,
+    LcTrieInternal(std::vector<IpPrefix<IpType>>&& data, double fill_factor,
                    uint32_t root_branching_factor);
 
     /**
@@ -439,12 +442,12 @@ private:
      * Builds the Level Compressed Trie, by first sorting the data, removing duplicated
      * prefixes and invoking buildRecursive() to build the trie.
      */
-    void build(std::vector<IpPrefix<IpType>>& data) {
+    void build(std::vector<IpPrefix<IpType>>&& data) {
       if (data.empty()) {
         return;
       }
 
-      ip_prefixes_ = data;
+      ip_prefixes_ = std::move(data);
       std::sort(ip_prefixes_.begin(), ip_prefixes_.end());
 
       // Build the trie_.
@@ -700,11 +703,10 @@ private:
 
 template <class T>
 template <class IpType, uint32_t address_size>
-LcTrie<T>::LcTrieInternal<IpType, address_size>::LcTrieInternal(std::vector<IpPrefix<IpType>>& data,
-                                                                double fill_factor,
-                                                                uint32_t root_branching_factor)
+LcTrie<T>::LcTrieInternal<IpType, address_size>::LcTrieInternal(
+    std::vector<IpPrefix<IpType>>&& data, double fill_factor, uint32_t root_branching_factor)
     : fill_factor_(fill_factor), root_branching_factor_(root_branching_factor) {
-  build(data);
+  build(std::move(data));
 }
 
 template <class T>
@@ -0,0 +1,43 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scalar_to_byte_vector.h"
+
+namespace Envoy {
+namespace Network {
+
+ReusePortCpuSteeringOptionImpl::ReusePortCpuSteeringOptionImpl(uint32_t socket_count)
+    : socket_count_(socket_count) {
+  ASSERT(socket_count_ > 0);
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // SPELLCHECKER(off)
+  filter_ = {
+      {0x20, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)}, // ld cpu
+      {0x94, 0, 0, socket_count_},                                  // mod #socket_count
+      {0x16, 0, 0, 0000000000},                                     // ret a
+  };
+  // SPELLCHECKER(on)
+  prog_.len = filter_.size();
+  prog_.filter = filter_.data();
+  option_ = std::make_unique<SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_BOUND, ENVOY_ATTACH_REUSEPORT_CBPF,
+      absl::string_view(reinterpret_cast<char*>(&prog_), sizeof(prog_)));
+#else
+  // The option name has no value on this platform, so isSupported() returns false.
+  option_ = std::make_unique<SocketOptionImpl>(envoy::config::core::v3::SocketOption::STATE_BOUND,
+                                               Network::SocketOptionName(), 0);
+#endif
+}
+
+void ReusePortCpuSteeringOptionImpl::hashKey(std::vector<uint8_t>& hash_key) const {
+  // The option value embeds the address of the program, so hash the program parameters instead.
+  if (isSupported()) {
+    const Network::SocketOptionName optname = ENVOY_ATTACH_REUSEPORT_CBPF;
+    pushScalarToByteVector(optname.level(), hash_key);
+    pushScalarToByteVector(optname.option(), hash_key);
+    pushScalarToByteVector(socket_count_, hash_key);
+  }
+}
+
+} // namespace Network
+} // namespace Envoy
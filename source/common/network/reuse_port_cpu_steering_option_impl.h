@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/network/listen_socket.h"
+
+#include "source/common/network/socket_option_impl.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Attaches a classic BPF program to the SO_REUSEPORT group of a listen socket. The program selects
+ * the socket whose index in the group equals the CPU that received the packet modulo the number of
+ * sockets. If worker N owns the N-th socket of the group and runs pinned to CPU N, a connection or
+ * datagram is then processed on the CPU that services the interrupts of its NIC receive queue.
+ */
+class ReusePortCpuSteeringOptionImpl : public Socket::Option {
+public:
+  /**
+   * @param socket_count supplies the number of sockets in the SO_REUSEPORT group.
+   */
+  explicit ReusePortCpuSteeringOptionImpl(uint32_t socket_count);
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override {
+    return option_->setOption(socket, state);
+  }
+  void hashKey(std::vector<uint8_t>& hash_key) const override;
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override {
+    return option_->getOptionDetails(socket, state);
+  }
+  bool isSupported() const override { return option_->isSupported(); }
+
+private:
+  const uint32_t socket_count_;
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // The option value refers to the program, so both must live as long as the option.
+  std::vector<sock_filter> filter_;
+  sock_fprog prog_;
+#endif
+  std::unique_ptr<SocketOptionImpl> option_;
+};
+
+} // namespace Network
+} // namespace Envoy
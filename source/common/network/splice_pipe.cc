@@ -0,0 +1,116 @@
+#include "source/common/network/splice_pipe.h"
+
+#include <algorithm>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace Network {
+
+bool SplicePipe::isSupported() {
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+SplicePipePtr SplicePipe::create(uint32_t buffer_limit, WatermarkCallback above_high_watermark,
+                                 WatermarkCallback below_low_watermark) {
+#if defined(__linux__)
+  int fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(debug, "failed to create splice pipe: {}", errorDetails(result.errno_));
+    return nullptr;
+  }
+  return SplicePipePtr{new SplicePipe(fds[0], fds[1], buffer_limit,
+                                      std::move(above_high_watermark),
+                                      std::move(below_low_watermark))};
+#else
+  UNREFERENCED_PARAMETER(buffer_limit);
+  UNREFERENCED_PARAMETER(above_high_watermark);
+  UNREFERENCED_PARAMETER(below_low_watermark);
+  return nullptr;
+#endif
+}
+
+SplicePipe::SplicePipe(os_fd_t read_fd, os_fd_t write_fd, uint32_t buffer_limit,
+                       WatermarkCallback above_high_watermark,
+                       WatermarkCallback below_low_watermark)
+    : read_fd_(read_fd), write_fd_(write_fd), high_watermark_(buffer_limit),
+      low_watermark_(buffer_limit / 2), above_high_watermark_(std::move(above_high_watermark)),
+      below_low_watermark_(std::move(below_low_watermark)) {}
+
+SplicePipe::~SplicePipe() {
+  Api::OsSysCallsSingleton::get().close(read_fd_);
+  Api::OsSysCallsSingleton::get().close(write_fd_);
+}
+
+Api::IoCallUint64Result SplicePipe::spliceFrom(IoHandle& source, uint64_t max_length) {
+  Api::IoCallUint64Result result = splice(source.fdDoNotUse(), write_fd_, max_length);
+  if (result.ok()) {
+    buffered_bytes_ += result.return_value_;
+    checkHighWatermark();
+  }
+  return result;
+}
+
+Api::IoCallUint64Result SplicePipe::spliceTo(IoHandle& destination, uint64_t max_length) {
+  Api::IoCallUint64Result result =
+      splice(read_fd_, destination.fdDoNotUse(), std::min(max_length, buffered_bytes_));
+  if (result.ok()) {
+    ASSERT(result.return_value_ <= buffered_bytes_);
+    buffered_bytes_ -= result.return_value_;
+    checkLowWatermark();
+  }
+  return result;
+}
+
+Api::IoCallUint64Result SplicePipe::splice(os_fd_t fd_in, os_fd_t fd_out, uint64_t max_length) {
+#if defined(__linux__)
+  const Api::SysCallSizeResult result = Api::LinuxOsSysCallsSingleton::get().splice(
+      fd_in, nullptr, fd_out, nullptr, max_length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (result.return_value_ >= 0) {
+    return {static_cast<uint64_t>(result.return_value_),
+            Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+  return {0, result.errno_ == SOCKET_ERROR_AGAIN
+                 ? Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                                   IoSocketError::deleteIoError)
+                 : Api::IoErrorPtr(new IoSocketError(result.errno_), IoSocketError::deleteIoError)};
+#else
+  UNREFERENCED_PARAMETER(fd_in);
+  UNREFERENCED_PARAMETER(fd_out);
+  UNREFERENCED_PARAMETER(max_length);
+  PANIC("not implemented");
+#endif
+}
+
+void SplicePipe::checkHighWatermark() {
+  if (high_watermark_ == 0 || above_high_watermark_called_ || buffered_bytes_ <= high_watermark_) {
+    return;
+  }
+  above_high_watermark_called_ = true;
+  above_high_watermark_();
+}
+
+void SplicePipe::checkLowWatermark() {
+  if (!above_high_watermark_called_ || buffered_bytes_ > low_watermark_) {
+    return;
+  }
+  above_high_watermark_called_ = false;
+  below_low_watermark_();
+}
+
+} // namespace Network
+} // namespace Envoy
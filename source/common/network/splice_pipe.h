@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "envoy/api/io_error.h"
+#include "envoy/common/platform.h"
+#include "envoy/network/io_handle.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Network {
+
+class SplicePipe;
+using SplicePipePtr = std::unique_ptr<SplicePipe>;
+
+/**
+ * A kernel pipe used to move bytes between two file descriptors with splice(2), so that the
+ * payload never has to be copied into user space. Bytes are spliced from a source descriptor into
+ * the pipe and from the pipe into a destination descriptor; the pipe keeps track of how many bytes
+ * are in flight and raises watermark callbacks with the same semantics as
+ * Buffer::WatermarkBuffer: the high watermark callback fires when the buffered bytes exceed the
+ * limit and the low watermark callback fires once they drop to half of the limit.
+ *
+ * This is only supported on Linux; create() returns nullptr elsewhere.
+ */
+class SplicePipe : NonCopyable, Logger::Loggable<Logger::Id::connection> {
+public:
+  using WatermarkCallback = std::function<void()>;
+
+  /**
+   * @param buffer_limit supplies the number of buffered bytes above which the high watermark
+   *        callback fires. 0 disables watermark callbacks.
+   * @param above_high_watermark supplies the callback invoked when the limit is exceeded.
+   * @param below_low_watermark supplies the callback invoked when buffered bytes drop back to half
+   *        of the limit.
+   * @return a new pipe, or nullptr if splicing is not supported or the pipe could not be created.
+   */
+  static SplicePipePtr create(uint32_t buffer_limit, WatermarkCallback above_high_watermark,
+                              WatermarkCallback below_low_watermark);
+
+  /**
+   * @return true if splice(2) is available on this platform.
+   */
+  static bool isSupported();
+
+  ~SplicePipe();
+
+  /**
+   * Move up to max_length bytes from the source into the pipe.
+   * @param source supplies the handle to read from.
+   * @param max_length supplies the maximum number of bytes to move.
+   * @return the number of bytes moved, 0 with no error on end of stream, or an error (e.g. Again
+   *         if either the source has no data or the pipe is full).
+   */
+  Api::IoCallUint64Result spliceFrom(IoHandle& source, uint64_t max_length);
+
+  /**
+   * Move up to max_length buffered bytes from the pipe into the destination.
+   * @param destination supplies the handle to write to.
+   * @param max_length supplies the maximum number of bytes to move.
+   * @return the number of bytes moved or an error (e.g. Again if the destination is full).
+   */
+  Api::IoCallUint64Result spliceTo(IoHandle& destination, uint64_t max_length);
+
+  /**
+   * @return the number of bytes spliced into the pipe that have not been spliced out yet.
+   */
+  uint64_t bufferedBytes() const { return buffered_bytes_; }
+
+  /**
+   * @return true if the buffered bytes exceeded the limit and have not dropped to the low
+   *         watermark since.
+   */
+  bool aboveHighWatermark() const { return above_high_watermark_called_; }
+
+private:
+  SplicePipe(os_fd_t read_fd, os_fd_t write_fd, uint32_t buffer_limit,
+             WatermarkCallback above_high_watermark, WatermarkCallback below_low_watermark);
+
+  Api::IoCallUint64Result splice(os_fd_t fd_in, os_fd_t fd_out, uint64_t max_length);
+  void checkHighWatermark();
+  void checkLowWatermark();
+
+  const os_fd_t read_fd_;
+  const os_fd_t write_fd_;
+  const uint32_t high_watermark_;
+  const uint32_t low_watermark_;
+  const WatermarkCallback above_high_watermark_;
+  const WatermarkCallback below_low_watermark_;
+  uint64_t buffered_bytes_{0};
+  bool above_high_watermark_called_{false};
+};
+
+} // namespace Network
+} // namespace Envoy
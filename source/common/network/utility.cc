@@ -616,14 +616,22 @@ Api::IoCallUint64Result Utility::readFromSocket(IoHandle& handle,
       return result;
     }
 
-    // Segment the buffer read by the recvmsg syscall into gso_sized sub buffers.
-    // TODO(mattklein123): The following code should be optimized to avoid buffer copies, either by
-    // switching to slices or by using a CoW buffer type.
-    while (buffer->length() > 0) {
-      const uint64_t bytes_to_copy = std::min(buffer->length(), gso_size);
+    // Segment the buffer read by the recvmsg syscall into gso_sized sub buffers. The sub buffers
+    // reference the storage of the coalesced datagram rather than copying it, which is kept alive
+    // until the last of them is released.
+    const uint64_t total_length = buffer->length();
+    const uint8_t* data = static_cast<const uint8_t*>(buffer->linearize(total_length));
+    std::shared_ptr<const Buffer::Instance> storage = std::move(buffer);
+    for (uint64_t offset = 0; offset < total_length; offset += gso_size) {
+      const uint64_t segment_size = std::min(total_length - offset, gso_size);
+      auto* fragment = new Buffer::BufferFragmentImpl(
+          data + offset, segment_size,
+          [storage](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+            delete fragment;
+          });
       Buffer::InstancePtr sub_buffer = std::make_unique<Buffer::OwnedImpl>();
-      sub_buffer->move(*buffer, bytes_to_copy);
-      passPayloadToProcessor(bytes_to_copy, std::move(sub_buffer), output.msg_[0].peer_address_,
+      sub_buffer->addBufferFragment(*fragment);
+      passPayloadToProcessor(segment_size, std::move(sub_buffer), output.msg_[0].peer_address_,
                              output.msg_[0].local_address_, udp_packet_processor, receive_time);
     }
 
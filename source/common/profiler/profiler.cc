@@ -62,17 +62,51 @@ bool Heap::stopProfiler() { return false; }
 
 #ifdef TCMALLOC
 
+#include "source/common/common/macros.h"
+
+#include "absl/types/optional.h"
 #include "tcmalloc/malloc_extension.h"
 #include "tcmalloc/profile_marshaler.h"
 
 namespace Envoy {
 namespace Profiler {
+namespace {
+
+// The token of the running allocation profiler. It is only used from the admin handlers, which all
+// run on the main thread.
+absl::optional<tcmalloc::MallocExtension::AllocationProfilingToken>& allocationProfilingToken() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(
+      absl::optional<tcmalloc::MallocExtension::AllocationProfilingToken>);
+}
+
+} // namespace
 
 absl::StatusOr<std::string> TcmallocProfiler::tcmallocHeapProfile() {
   auto profile = tcmalloc::MallocExtension::SnapshotCurrent(tcmalloc::ProfileType::kHeap);
   return tcmalloc::Marshal(profile);
 }
 
+absl::Status TcmallocProfiler::startAllocationProfiler() {
+  if (isAllocationProfilerStarted()) {
+    return absl::FailedPreconditionError("Allocation profiler is already started");
+  }
+  allocationProfilingToken() = tcmalloc::MallocExtension::StartAllocationProfiling();
+  return absl::OkStatus();
+}
+
+bool TcmallocProfiler::isAllocationProfilerStarted() {
+  return allocationProfilingToken().has_value();
+}
+
+absl::StatusOr<std::string> TcmallocProfiler::stopAllocationProfiler() {
+  if (!isAllocationProfilerStarted()) {
+    return absl::FailedPreconditionError("Allocation profiler is not started");
+  }
+  auto profile = std::move(*allocationProfilingToken()).Stop();
+  allocationProfilingToken().reset();
+  return tcmalloc::Marshal(profile);
+}
+
 } // namespace Profiler
 } // namespace Envoy
 
@@ -86,6 +120,18 @@ absl::StatusOr<std::string> TcmallocProfiler::tcmallocHeapProfile() {
                       "Heap profile is not implemented in current build");
 }
 
+absl::Status TcmallocProfiler::startAllocationProfiler() {
+  return absl::Status(absl::StatusCode::kUnimplemented,
+                      "Allocation profile is not implemented in current build");
+}
+
+bool TcmallocProfiler::isAllocationProfilerStarted() { return false; }
+
+absl::StatusOr<std::string> TcmallocProfiler::stopAllocationProfiler() {
+  return absl::Status(absl::StatusCode::kUnimplemented,
+                      "Allocation profile is not implemented in current build");
+}
+
 } // namespace Profiler
 } // namespace Envoy
 
@@ -72,6 +72,23 @@ public:
   TcmallocProfiler() = default;
 
   static absl::StatusOr<std::string> tcmallocHeapProfile();
+
+  /**
+   * Start sampling the allocations made from now on, at the sampling rate of tcmalloc.
+   * @return absl::Status failing if the build does not support it or it is already started.
+   */
+  static absl::Status startAllocationProfiler();
+
+  /**
+   * @return whether the allocation profiler is started or not.
+   */
+  static bool isAllocationProfilerStarted();
+
+  /**
+   * Stop the allocation profiler.
+   * @return the profile of the allocations sampled since it was started, in the pprof format.
+   */
+  static absl::StatusOr<std::string> stopAllocationProfiler();
 };
 
 } // namespace Profiler
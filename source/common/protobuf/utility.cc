@@ -15,7 +15,9 @@
 #include "source/common/protobuf/visitor.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "udpa/annotations/sensitive.pb.h"
 #include "udpa/annotations/status.pb.h"
 #include "validate/validate.h"
@@ -107,6 +109,140 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
   return value;
 }
 
+// Appends the string to the JSON as a JSON string.
+void appendJsonString(absl::string_view str, std::string& json) {
+  json.push_back('"');
+  for (const char c : str) {
+    switch (c) {
+    case '"':
+      json.append("\\\"");
+      break;
+    case '\\':
+      json.append("\\\\");
+      break;
+    case '\n':
+      json.append("\\n");
+      break;
+    case '\r':
+      json.append("\\r");
+      break;
+    case '\t':
+      json.append("\\t");
+      break;
+    default:
+      if (static_cast<uint8_t>(c) < 0x20) {
+        absl::StrAppend(&json, "\\u00", absl::Hex(static_cast<uint8_t>(c), absl::kZeroPad2));
+      } else {
+        json.push_back(c);
+      }
+    }
+  }
+  json.push_back('"');
+}
+
+// Appends the JSON of the YAML node to the JSON string. Scalars are converted like in
+// parseYamlNode(), so that it is equivalent to printing the ProtobufWkt::Value of the node as JSON
+// without building it.
+void appendYamlNodeAsJson(const YAML::Node& node, std::string& json) {
+  switch (node.Type()) {
+  case YAML::NodeType::Null:
+    json.append("null");
+    break;
+  case YAML::NodeType::Scalar: {
+    if (node.Tag() == "!") {
+      appendJsonString(node.Scalar(), json);
+      break;
+    }
+    bool bool_value;
+    if (YAML::convert<bool>::decode(node, bool_value)) {
+      json.append(bool_value ? "true" : "false");
+      break;
+    }
+    int64_t int_value;
+    if (YAML::convert<int64_t>::decode(node, int_value)) {
+      if (std::numeric_limits<int32_t>::min() <= int_value &&
+          std::numeric_limits<int32_t>::max() >= int_value) {
+        absl::StrAppend(&json, int_value);
+      } else {
+        appendJsonString(std::to_string(int_value), json);
+      }
+      break;
+    }
+    appendJsonString(node.Scalar(), json);
+    break;
+  }
+  case YAML::NodeType::Sequence: {
+    json.push_back('[');
+    bool first = true;
+    for (const auto& it : node) {
+      if (!first) {
+        json.push_back(',');
+      }
+      first = false;
+      appendYamlNodeAsJson(it, json);
+    }
+    json.push_back(']');
+    break;
+  }
+  case YAML::NodeType::Map: {
+    // Like the fields of a ProtobufWkt::Struct, the last of duplicate keys wins.
+    std::vector<std::pair<std::string, YAML::Node>> fields;
+    absl::flat_hash_map<std::string, size_t> field_indexes;
+    for (const auto& it : node) {
+      if (it.first.Tag() == "!ignore") {
+        continue;
+      }
+      std::string key = it.first.as<std::string>();
+      const auto [index, inserted] = field_indexes.try_emplace(key, fields.size());
+      if (inserted) {
+        fields.emplace_back(std::move(key), it.second);
+      } else {
+        fields[index->second].second = it.second;
+      }
+    }
+    json.push_back('{');
+    bool first = true;
+    for (const auto& [key, value] : fields) {
+      if (!first) {
+        json.push_back(',');
+      }
+      first = false;
+      appendJsonString(key, json);
+      json.push_back(':');
+      appendYamlNodeAsJson(value, json);
+    }
+    json.push_back('}');
+    break;
+  }
+  case YAML::NodeType::Undefined:
+    throw EnvoyException("Undefined YAML value");
+  }
+}
+
+// Converts YAML whose top level node is a map or a sequence to JSON, directly from the YAML nodes.
+// Returns an empty string if the top level node is neither.
+std::string yamlToJson(const std::string& yaml) {
+  TRY_ASSERT_MAIN_THREAD {
+    const YAML::Node node = YAML::Load(yaml);
+    if (node.Type() != YAML::NodeType::Map && node.Type() != YAML::NodeType::Sequence) {
+      return "";
+    }
+    std::string json;
+    appendYamlNodeAsJson(node, json);
+    return json;
+  }
+  END_TRY
+  catch (YAML::ParserException& e) {
+    throw EnvoyException(e.what());
+  }
+  catch (YAML::BadConversion& e) {
+    throw EnvoyException(e.what());
+  }
+  catch (std::exception& e) {
+    throw EnvoyException(fmt::format("Unexpected YAML exception: {}", +e.what()));
+  }
+}
+
 void jsonConvertInternal(const Protobuf::Message& source,
                          ProtobufMessage::ValidationVisitor& validation_visitor,
                          Protobuf::Message& dest) {
@@ -180,7 +316,8 @@ uint64_t convertPercent(double percent, uint64_t max_value) {
   return max_value * (percent / 100.0);
 }
 
-bool evaluateFractionalPercent(envoy::type::v3::FractionalPercent percent, uint64_t random_value) {
+bool evaluateFractionalPercent(const envoy::type::v3::FractionalPercent& percent,
+                               uint64_t random_value) {
   return random_value % fractionalPercentDenominatorToInt(percent.denominator()) <
          percent.numerator();
 }
@@ -295,13 +432,13 @@ void MessageUtil::loadFromJson(const std::string& json, ProtobufWkt::Struct& mes
 
 void MessageUtil::loadFromYaml(const std::string& yaml, Protobuf::Message& message,
                                ProtobufMessage::ValidationVisitor& validation_visitor) {
-  ProtobufWkt::Value value = ValueUtil::loadFromYaml(yaml);
-  if (value.kind_case() == ProtobufWkt::Value::kStructValue ||
-      value.kind_case() == ProtobufWkt::Value::kListValue) {
-    jsonConvertInternal(value, validation_visitor, message);
-    return;
+  // Going directly from YAML to JSON avoids building a ProtobufWkt::Value of the whole YAML and
+  // printing it as JSON through proto reflection, which dominates the loading of large bootstraps.
+  const std::string json = yamlToJson(yaml);
+  if (json.empty()) {
+    throw EnvoyException("Unable to convert YAML as JSON: " + yaml);
   }
-  throw EnvoyException("Unable to convert YAML as JSON: " + yaml);
+  loadFromJson(json, message, validation_visitor);
 }
 
 void MessageUtil::loadFromFile(const std::string& path, Protobuf::Message& message,
@@ -85,7 +85,8 @@ uint64_t convertPercent(double percent, uint64_t max_value);
  * @param random_value supplies a numerical value to use to evaluate the event.
  * @return bool decision about whether the event should occur.
  */
-bool evaluateFractionalPercent(envoy::type::v3::FractionalPercent percent, uint64_t random_value);
+bool evaluateFractionalPercent(const envoy::type::v3::FractionalPercent& percent,
+                               uint64_t random_value);
 
 /**
  * Convert a fractional percent denominator enum into an integer.
@@ -245,14 +245,7 @@ void EnvoyQuicClientStream::OnBodyAvailable() {
   Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
   // TODO(danzh): check Envoy per stream buffer limit.
   // Currently read out all the data.
-  while (HasBytesToRead()) {
-    iovec iov;
-    int num_regions = GetReadableRegions(&iov, 1);
-    ASSERT(num_regions > 0);
-    size_t bytes_read = iov.iov_len;
-    buffer->add(iov.iov_base, bytes_read);
-    MarkConsumed(bytes_read);
-  }
+  readBody(*this, *buffer);
   ASSERT(buffer->length() == 0 || !end_stream_decoded_);
 
   bool fin_read_and_no_trailers = IsDoneReading();
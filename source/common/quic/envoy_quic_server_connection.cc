@@ -29,6 +29,11 @@ EnvoyQuicServerConnection::EnvoyQuicServerConnection(
     set_defer_send_in_response_to_packets(GetQuicFlag(quic_defer_send_in_response));
   }
 #endif
+  if (writer != nullptr && writer->SupportsReleaseTime()) {
+    // The connection only computes release times for its packets when it has options to pass
+    // them in. It then sends ahead of its pacing rate and lets the kernel pace the packets.
+    set_per_packet_options(&packet_options_);
+  }
 }
 
 bool EnvoyQuicServerConnection::OnPacketHeader(const quic::QuicPacketHeader& header) {
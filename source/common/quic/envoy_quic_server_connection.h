@@ -1,15 +1,27 @@
 #pragma once
 
+#include <memory>
+
 #include "envoy/network/listener.h"
 
 #include "source/common/quic/envoy_quic_utils.h"
 #include "source/common/quic/quic_network_connection.h"
 
 #include "quiche/quic/core/quic_connection.h"
+#include "quiche/quic/core/quic_packet_writer.h"
 
 namespace Envoy {
 namespace Quic {
 
+// Receives the release time of each packet from the connection when the writer supports release
+// times.
+class EnvoyQuicPacketOptions : public quic::PerPacketOptions {
+public:
+  std::unique_ptr<quic::PerPacketOptions> Clone() const override {
+    return std::make_unique<EnvoyQuicPacketOptions>(*this);
+  }
+};
+
 class EnvoyQuicServerConnection : public quic::QuicConnection, public QuicNetworkConnection {
 public:
   EnvoyQuicServerConnection(const quic::QuicConnectionId& server_connection_id,
@@ -33,6 +45,7 @@ public:
 
 private:
   const bool defer_send_;
+  EnvoyQuicPacketOptions packet_options_;
 };
 
 // An implementation that issues connection IDs with stable first 4 types.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/config/core/v3/protocol.pb.h"
 #include "envoy/event/dispatcher.h"
@@ -157,6 +159,32 @@ protected:
 
   StreamInfo::BytesMeterSharedPtr& mutableBytesMeter() { return bytes_meter_; }
 
+  // Read out all the body received by a QUIC stream into the buffer. The stream sequencer reuses
+  // its blocks once the body is consumed, so the body has to be copied. Each batch of readable
+  // regions is copied into a single slice and consumed at once.
+  template <class QuicSpdyStreamType>
+  static void readBody(QuicSpdyStreamType& stream, Buffer::Instance& buffer) {
+    constexpr size_t MaxRegions = 8;
+    iovec iovs[MaxRegions];
+    while (stream.HasBytesToRead()) {
+      const int num_regions = stream.GetReadableRegions(iovs, MaxRegions);
+      ASSERT(num_regions > 0);
+      size_t bytes_to_read = 0;
+      for (int i = 0; i < num_regions; ++i) {
+        bytes_to_read += iovs[i].iov_len;
+      }
+      Buffer::ReservationSingleSlice reservation = buffer.reserveSingleSlice(bytes_to_read);
+      ASSERT(reservation.slice().len_ >= bytes_to_read);
+      uint8_t* current = static_cast<uint8_t*>(reservation.slice().mem_);
+      for (int i = 0; i < num_regions; ++i) {
+        memcpy(current, iovs[i].iov_base, iovs[i].iov_len); // NOLINT(safe-memcpy)
+        current += iovs[i].iov_len;
+      }
+      reservation.commit(bytes_to_read);
+      stream.MarkConsumed(bytes_to_read);
+    }
+  }
+
   // True once end of stream is propagated to Envoy. Envoy doesn't expect to be
   // notified more than once about end of stream. So once this is true, no need
   // to set it in the callback to Envoy stream any more.
@@ -3,6 +3,8 @@
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/quic/envoy_quic_utils.h"
 
+#include "quiche/quic/platform/api/quic_flags.h"
+
 namespace Envoy {
 namespace Quic {
 namespace {
@@ -44,9 +46,11 @@ Api::IoCallUint64Result convertQuicWriteResult(quic::WriteResult quic_result, si
 
 } // namespace
 
-// Initialize QuicGsoBatchWriter, set io_handle_ and stats_
+// Initialize QuicGsoBatchWriter, set io_handle_ and stats_. The fq qdisc expects release times
+// from the monotonic clock.
 UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope)
-    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse()), stats_(generateStats(scope)) {}
+    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse(), CLOCK_MONOTONIC),
+      stats_(generateStats(scope)) {}
 
 Api::IoCallUint64Result
 UdpGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Network::Address::Ip* local_ip,
@@ -57,8 +61,8 @@ UdpGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Network::Ad
   ASSERT(buffer.getRawSlices().size() == 1);
   size_t payload_len = static_cast<size_t>(buffer.frontSlice().len_);
 
-  // TODO(yugant): Currently we do not use PerPacketOptions with Quic, we may want to
-  // specify this parameter here at a later stage.
+  // QUIC connections use this writer directly as a quic::QuicPacketWriter, so the packets written
+  // here have no release time.
   quic::WriteResult quic_result = WritePacket(static_cast<char*>(buffer.frontSlice().mem_),
                                               payload_len, self_addr.host(), peer_addr,
                                               /*quic::PerPacketOptions=*/nullptr);
@@ -107,6 +111,14 @@ UdpGsoBatchWriterStats UdpGsoBatchWriter::generateStats(Stats::Scope& scope) {
       UDP_GSO_BATCH_WRITER_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope), POOL_HISTOGRAM(scope))};
 }
 
+UdpGsoBatchWriterFactory::UdpGsoBatchWriterFactory(bool enable_pacing_offload) {
+  if (enable_pacing_offload) {
+    // With this flag QUICHE enables SO_TXTIME on the sockets of the writers, and the writers
+    // report the support of release times to the connections.
+    SetQuicRestartFlag(quic_support_release_time_for_gso, true);
+  }
+}
+
 Network::UdpPacketWriterPtr
 UdpGsoBatchWriterFactory::createUdpPacketWriter(Network::IoHandle& io_handle, Stats::Scope& scope) {
   return std::make_unique<UdpGsoBatchWriter>(io_handle, scope);
@@ -53,6 +53,8 @@ struct UdpGsoBatchWriterStats {
 /**
  * UdpPacketWriter implementation based on quic::QuicGsoBatchWriter to send packets
  * in batches, using UDP socket's generic segmentation offload(GSO) capability.
+ * If release times are supported, QUIC connections pass the paced send time of each
+ * packet, and the batches are written with SO_TXTIME so that the qdisc paces them.
  */
 class UdpGsoBatchWriter : public quic::QuicGsoBatchWriter, public Network::UdpPacketWriter {
 public:
@@ -92,6 +94,12 @@ private:
 
 class UdpGsoBatchWriterFactory : public Network::UdpPacketWriterFactory {
 public:
+  /**
+   * @param enable_pacing_offload if true, writers send packets with the release time computed by
+   *        the QUIC pacing, so that the qdisc paces them.
+   */
+  explicit UdpGsoBatchWriterFactory(bool enable_pacing_offload = false);
+
   Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle& io_handle,
                                                     Stats::Scope& scope) override;
 
@@ -1737,7 +1737,8 @@ PathSeparatedPrefixRouteEntryImpl::matches(const Http::RequestHeaderMap& headers
 
 VirtualHostImpl::VirtualHostImpl(
     const envoy::config::route::v3::VirtualHost& virtual_host,
-    const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+    const OptionalHttpFilters& optional_http_filters,
+    const CommonConfigSharedPtr& global_route_config,
     Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
     ProtobufMessage::ValidationVisitor& validator,
     const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters)
@@ -1795,7 +1796,7 @@ VirtualHostImpl::VirtualHostImpl(
 
   // Inherit policies from the global config.
   if (shadow_policies_.empty()) {
-    shadow_policies_ = global_route_config_.shadowPolicies();
+    shadow_policies_ = global_route_config_->shadowPolicies();
   }
 
   if (virtual_host.has_matcher() && !virtual_host.routes().empty()) {
@@ -1820,6 +1821,7 @@ VirtualHostImpl::VirtualHostImpl(
       routes_.emplace_back(createAndValidateRoute(route, *this, optional_http_filters,
                                                   factory_context, validator, validation_clusters));
     }
+    buildPathRouteIndex(virtual_host.routes());
   }
 
   if (!virtual_host.virtual_clusters().empty()) {
@@ -1854,19 +1856,19 @@ VirtualHostImpl::VirtualClusterEntry::VirtualClusterEntry(
   headers_ = Http::HeaderUtility::buildHeaderDataVector(virtual_cluster.headers());
 }
 
-const Config& VirtualHostImpl::routeConfig() const { return global_route_config_; }
+const CommonConfig& VirtualHostImpl::routeConfig() const { return *global_route_config_; }
 
 const RouteSpecificFilterConfig*
 VirtualHostImpl::mostSpecificPerFilterConfig(const std::string& name) const {
   auto* per_filter_config = per_filter_configs_.get(name);
   return per_filter_config != nullptr ? per_filter_config
-                                      : global_route_config_.perFilterConfig(name);
+                                      : global_route_config_->perFilterConfig(name);
 }
 void VirtualHostImpl::traversePerFilterConfig(
     const std::string& filter_name,
     std::function<void(const Router::RouteSpecificFilterConfig&)> cb) const {
   // Parent first.
-  if (auto* maybe_rc_config = global_route_config_.perFilterConfig(filter_name);
+  if (auto* maybe_rc_config = global_route_config_->perFilterConfig(filter_name);
       maybe_rc_config != nullptr) {
     cb(*maybe_rc_config);
   }
@@ -1900,9 +1902,10 @@ const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
 
 RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& route_config,
                            const OptionalHttpFilters& optional_http_filters,
-                           const ConfigImpl& global_route_config,
+                           const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
-                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters)
+                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           const RouteMatcher* previous, bool reuse_virtual_hosts)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -1911,9 +1914,25 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
     validation_clusters = factory_context.clusterManager().clusters();
   }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, optional_http_filters, global_route_config, factory_context,
-        *vhost_scope_, validator, validation_clusters);
+    VirtualHostSharedPtr virtual_host;
+    absl::optional<uint64_t> hash;
+    if (reuse_virtual_hosts) {
+      hash = MessageUtil::hash(virtual_host_config);
+      if (previous != nullptr) {
+        const auto it = previous->virtual_hosts_by_hash_.find(*hash);
+        if (it != previous->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(
+          virtual_host_config, optional_http_filters, global_route_config, factory_context,
+          *vhost_scope_, validator, validation_clusters);
+    }
+    if (hash.has_value()) {
+      virtual_hosts_by_hash_.emplace(*hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const std::string domain = Http::LowerCaseString(domain_name).get();
       bool duplicate_found = false;
@@ -2001,34 +2020,28 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     ENVOY_LOG(debug, "failed to match incoming request: {}", static_cast<int>(match.match_state_));
 
     return nullptr;
+  } else if (path_route_index_ != nullptr && headers.Path() != nullptr) {
+    // Only the routes whose path specifier may match the request path are evaluated, in route
+    // table order, so the result is the same as with the linear scan below.
+    absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+    if (global_route_config_->ignorePathParametersInPathMatching()) {
+      path = path.substr(0, path.find_first_of(';'));
+    }
+    PathRouteIndex::Candidates candidates;
+    path_route_index_->findCandidates(path, candidates);
+    RouteConstSharedPtr result;
+    for (const uint32_t index : candidates) {
+      if (evaluateRoute(index, cb, headers, stream_info, random_value, result)) {
+        return result;
+      }
+    }
   } else {
     // Check for a route that matches the request.
-    for (auto route = routes_.begin(); route != routes_.end(); ++route) {
-      if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
-        continue;
+    RouteConstSharedPtr result;
+    for (size_t index = 0; index < routes_.size(); ++index) {
+      if (evaluateRoute(index, cb, headers, stream_info, random_value, result)) {
+        return result;
       }
-
-      RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
-      if (nullptr == route_entry) {
-        continue;
-      }
-
-      if (cb) {
-        RouteEvalStatus eval_status = (std::next(route) == routes_.end())
-                                          ? RouteEvalStatus::NoMoreRoutes
-                                          : RouteEvalStatus::HasMoreRoutes;
-        RouteMatchStatus match_status = cb(route_entry, eval_status);
-        if (match_status == RouteMatchStatus::Accept) {
-          return route_entry;
-        }
-        if (match_status == RouteMatchStatus::Continue &&
-            eval_status == RouteEvalStatus::NoMoreRoutes) {
-          return nullptr;
-        }
-        continue;
-      }
-
-      return route_entry;
     }
   }
 
@@ -2103,6 +2116,89 @@ const Envoy::Config::TypedMetadataImpl<Envoy::Config::TypedMetadataFactory>
 const std::shared_ptr<const SslRedirectRoute> VirtualHostImpl::SSL_REDIRECT_ROUTE{
     new SslRedirectRoute()};
 
+bool VirtualHostImpl::evaluateRoute(size_t index, const RouteCallback& cb,
+                                    const Http::RequestHeaderMap& headers,
+                                    const StreamInfo::StreamInfo& stream_info,
+                                    uint64_t random_value, RouteConstSharedPtr& result) const {
+  const RouteEntryImplBaseConstSharedPtr& route = routes_[index];
+  if (!headers.Path() && !route->supportsPathlessHeaders()) {
+    return false;
+  }
+
+  RouteConstSharedPtr route_entry = route->matches(headers, stream_info, random_value);
+  if (nullptr == route_entry) {
+    return false;
+  }
+
+  if (cb) {
+    RouteEvalStatus eval_status = (index + 1 == routes_.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                                : RouteEvalStatus::HasMoreRoutes;
+    RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      result = std::move(route_entry);
+      return true;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      result = nullptr;
+      return true;
+    }
+    return false;
+  }
+
+  result = std::move(route_entry);
+  return true;
+}
+
+void VirtualHostImpl::buildPathRouteIndex(
+    const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& route_configs) {
+  if (routes_.empty() ||
+      !Runtime::runtimeFeatureEnabled("envoy.reloadable_features.compiled_route_path_index")) {
+    return;
+  }
+  ASSERT(static_cast<size_t>(route_configs.size()) == routes_.size());
+
+  auto index = std::make_unique<PathRouteIndex>();
+  for (size_t i = 0; i < routes_.size(); ++i) {
+    const RouteEntryImplBase& route = *routes_[i];
+    if (route.matchType() == PathMatchType::Regex) {
+      // Regexes can only be evaluated as a set if they are compiled by RE2, either explicitly or
+      // through the default regex engine.
+      if (route_configs[i].match().safe_regex().has_google_re2() ||
+          dynamic_cast<const Regex::GoogleReEngine*>(&Regex::EngineSingleton::get()) != nullptr) {
+        index->addRegex(route.matcher(), i);
+      } else {
+        index->addUnindexed(i);
+      }
+      continue;
+    }
+    if (!route.case_sensitive()) {
+      index->addUnindexed(i);
+      continue;
+    }
+    switch (route.matchType()) {
+    case PathMatchType::Exact:
+      index->add(PathRouteIndex::KeyType::Exact, route.matcher(), i);
+      break;
+    case PathMatchType::Prefix:
+      index->add(PathRouteIndex::KeyType::Prefix, route.matcher(), i);
+      break;
+    case PathMatchType::PathSeparatedPrefix:
+      index->add(PathRouteIndex::KeyType::PathSeparatedPrefix, route.matcher(), i);
+      break;
+    default:
+      index->addUnindexed(i);
+      break;
+    }
+  }
+  index->finalize();
+
+  // The index cannot prune anything if no route was indexed.
+  if (index->unindexedSize() != routes_.size()) {
+    path_route_index_ = std::move(index);
+  }
+}
+
 const VirtualCluster*
 VirtualHostImpl::virtualClusterFromEntries(const Http::HeaderMap& headers) const {
   for (const VirtualClusterEntry& entry : virtual_clusters_) {
@@ -2118,14 +2214,15 @@ VirtualHostImpl::virtualClusterFromEntries(const Http::HeaderMap& headers) const
   return nullptr;
 }
 
-ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
-                       const OptionalHttpFilters& optional_http_filters,
-                       Server::Configuration::ServerFactoryContext& factory_context,
-                       ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default)
+CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                                   const OptionalHttpFilters& optional_http_filters,
+                                   Server::Configuration::ServerFactoryContext& factory_context,
+                                   ProtobufMessage::ValidationVisitor& validator,
+                                   absl::optional<uint64_t> config_hash)
     : name_(config.name()), symbol_table_(factory_context.scope().symbolTable()),
       per_filter_configs_(config.typed_per_filter_config(), optional_http_filters, factory_context,
                           validator),
+      config_hash_(config_hash),
       max_direct_response_body_size_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_direct_response_body_size_bytes,
                                           DEFAULT_MAX_DIRECT_RESPONSE_BODY_SIZE_BYTES)),
@@ -2146,10 +2243,6 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
     cluster_specifier_plugins_.emplace(plugin_proto.extension().name(), std::move(plugin));
   }
 
-  route_matcher_ = std::make_unique<RouteMatcher>(
-      config, optional_http_filters, *this, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
-
   for (const std::string& header : config.internal_only_headers()) {
     internal_only_headers_.push_back(Http::LowerCaseString(header));
   }
@@ -2165,7 +2258,7 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
 }
 
 ClusterSpecifierPluginSharedPtr
-ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
+CommonConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   auto iter = cluster_specifier_plugins_.find(provider);
   if (iter == cluster_specifier_plugins_.end() || iter->second == nullptr) {
     throw EnvoyException(
@@ -2174,6 +2267,54 @@ ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   return iter->second;
 }
 
+uint64_t CommonConfigImpl::hashConfig(const envoy::config::route::v3::RouteConfiguration& config) {
+  // Copy every field but the virtual hosts, which are most of a large route configuration.
+  Protobuf::FieldMask mask;
+  const Protobuf::Descriptor* descriptor = config.GetDescriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const Protobuf::FieldDescriptor* field = descriptor->field(i);
+    if (field->number() != envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+      mask.add_paths(field->name());
+    }
+  }
+  envoy::config::route::v3::RouteConfiguration common_config;
+  Protobuf::util::FieldMaskUtil::MergeMessageTo(config, mask, {}, &common_config);
+  return MessageUtil::hash(common_config);
+}
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       const OptionalHttpFilters& optional_http_filters,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, const ConfigImpl* previous_config) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  // The clusters referenced by a reused virtual host would not be validated again.
+  const bool reuse_virtual_hosts =
+      !validate_clusters &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts");
+
+  const RouteMatcher* previous_route_matcher = nullptr;
+  absl::optional<uint64_t> config_hash;
+  if (reuse_virtual_hosts) {
+    config_hash = CommonConfigImpl::hashConfig(config);
+    // The virtual hosts depend on the common config, so they are only reused along with it.
+    if (previous_config != nullptr &&
+        previous_config->shared_config_->configHash() == config_hash) {
+      shared_config_ = previous_config->shared_config_;
+      previous_route_matcher = previous_config->route_matcher_.get();
+    }
+  }
+  if (shared_config_ == nullptr) {
+    shared_config_ = std::make_shared<CommonConfigImpl>(config, optional_http_filters,
+                                                        factory_context, validator, config_hash);
+  }
+
+  route_matcher_ = std::make_unique<RouteMatcher>(config, optional_http_filters, shared_config_,
+                                                  factory_context, validator, validate_clusters,
+                                                  previous_route_matcher, reuse_virtual_hosts);
+}
+
 RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
                                       const Http::RequestHeaderMap& headers,
                                       const StreamInfo::StreamInfo& stream_info,
@@ -2236,6 +2377,11 @@ PerFilterConfigs::PerFilterConfigs(
 }
 
 const RouteSpecificFilterConfig* PerFilterConfigs::get(const std::string& name) const {
+  // Most routes, virtual hosts and route configurations have no per filter configs, and every
+  // filter of every request looks up each of these levels, so skip hashing the name.
+  if (configs_.empty()) {
+    return nullptr;
+  }
   auto it = configs_.find(name);
   return it == configs_.end() ? nullptr : it->second.get();
 }
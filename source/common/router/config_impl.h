@@ -31,10 +31,12 @@
 #include "source/common/router/header_formatter.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/router/path_route_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -94,7 +96,7 @@ private:
                                   Server::Configuration::ServerFactoryContext& factory_context,
                                   ProtobufMessage::ValidationVisitor& validator);
 
-  absl::node_hash_map<std::string, RouteSpecificFilterConfigConstSharedPtr> configs_;
+  absl::flat_hash_map<std::string, RouteSpecificFilterConfigConstSharedPtr> configs_;
 };
 
 class RouteEntryImplBase;
@@ -214,7 +216,9 @@ using CorsPolicyImpl = CorsPolicyImplBase<envoy::config::route::v3::CorsPolicy>;
 using RetryPolicyConstOptRef = const OptRef<const envoy::config::route::v3::RetryPolicy>;
 using HedgePolicyConstOptRef = const OptRef<const envoy::config::route::v3::HedgePolicy>;
 
-class ConfigImpl;
+class CommonConfigImpl;
+using CommonConfigSharedPtr = std::shared_ptr<const CommonConfigImpl>;
+
 /**
  * Holds all routing configuration for an entire virtual host.
  */
@@ -222,7 +226,8 @@ class VirtualHostImpl : public VirtualHost, Logger::Loggable<Logger::Id::router>
 public:
   VirtualHostImpl(
       const envoy::config::route::v3::VirtualHost& virtual_host,
-      const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+      const OptionalHttpFilters& optional_http_filters,
+      const CommonConfigSharedPtr& global_route_config,
       Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
       ProtobufMessage::ValidationVisitor& validator,
       const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters);
@@ -232,7 +237,7 @@ public:
                                           const StreamInfo::StreamInfo& stream_info,
                                           uint64_t random_value) const;
   const VirtualCluster* virtualClusterFromEntries(const Http::HeaderMap& headers) const;
-  const ConfigImpl& globalRouteConfig() const { return global_route_config_; }
+  const CommonConfigImpl& globalRouteConfig() const { return *global_route_config_; }
   const HeaderParser& requestHeaderParser() const {
     if (request_headers_parser_ != nullptr) {
       return *request_headers_parser_;
@@ -255,7 +260,7 @@ public:
     }
     return DefaultRateLimitPolicy::get();
   }
-  const Config& routeConfig() const override;
+  const CommonConfig& routeConfig() const override;
   const RouteSpecificFilterConfig* mostSpecificPerFilterConfig(const std::string&) const override;
   bool includeAttemptCountInRequest() const override { return include_attempt_count_in_request_; }
   bool includeAttemptCountInResponse() const override { return include_attempt_count_in_response_; }
@@ -323,15 +328,25 @@ private:
 
   static const std::shared_ptr<const SslRedirectRoute> SSL_REDIRECT_ROUTE;
 
+  // Builds path_route_index_ over routes_ if the compiled route index is enabled.
+  void buildPathRouteIndex(
+      const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& route_configs);
+  // Evaluates the route at |index| in routes_. Returns true if route selection is complete, in
+  // which case |result| holds the selected route (which may be nullptr).
+  bool evaluateRoute(size_t index, const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+                     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
+                     RouteConstSharedPtr& result) const;
+
   const Stats::StatNameManagedStorage stat_name_storage_;
   Stats::ScopeSharedPtr vcluster_scope_;
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const PathRouteIndex> path_route_index_;
   std::vector<VirtualClusterEntry> virtual_clusters_;
   std::unique_ptr<const RateLimitPolicyImpl> rate_limit_policy_;
   std::vector<ShadowPolicyPtr> shadow_policies_;
   std::unique_ptr<const CorsPolicyImpl> cors_policy_;
-  const ConfigImpl& global_route_config_; // See note in RouteEntryImplBase::clusterEntry() on why
-                                          // raw ref to the top level config is currently safe.
+  // Shared with the route configurations which reuse this virtual host.
+  const CommonConfigSharedPtr global_route_config_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
   PerFilterConfigs per_filter_configs_;
@@ -644,6 +659,7 @@ public:
                      ProtobufMessage::ValidationVisitor& validator);
 
   bool isDirectResponse() const { return direct_response_code_.has_value(); }
+  bool case_sensitive() const { return case_sensitive_; }
 
   bool isRedirect() const {
     if (!isDirectResponse()) {
@@ -1068,7 +1084,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    uint64_t random_value) const;
 
@@ -1482,11 +1497,19 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous supplies the route matcher of the previous version of the route
+   *        configuration, whose virtual hosts are reused when their config is unchanged, or
+   *        nullptr. It must share the global config of this one.
+   * @param reuse_virtual_hosts supplies whether to keep the hashes of the virtual hosts, so that
+   *        the next version of the route configuration can reuse them.
+   */
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const OptionalHttpFilters& optional_http_filters,
-               const ConfigImpl& global_http_config,
+               const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
-               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               const RouteMatcher* previous, bool reuse_virtual_hosts);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1517,18 +1540,23 @@ private:
   WildcardVirtualHosts wildcard_virtual_host_prefixes_;
 
   VirtualHostSharedPtr default_virtual_host_;
+  // The virtual hosts by the hash of their config, if they may be reused.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> virtual_hosts_by_hash_;
   const bool ignore_port_in_host_matching_{false};
 };
 
 /**
- * Implementation of Config that reads from a proto file.
+ * The part of a route configuration which is not specific to its virtual hosts. It is shared by
+ * the virtual hosts, so they can be reused by the next version of the route configuration when
+ * neither this part nor their own config changed.
  */
-class ConfigImpl : public Config {
+class CommonConfigImpl : public CommonConfig {
 public:
-  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
-             const OptionalHttpFilters& optional_http_filters,
-             Server::Configuration::ServerFactoryContext& factory_context,
-             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+  CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                   const OptionalHttpFilters& optional_http_filters,
+                   Server::Configuration::ServerFactoryContext& factory_context,
+                   ProtobufMessage::ValidationVisitor& validator,
+                   absl::optional<uint64_t> config_hash);
 
   const HeaderParser& requestHeaderParser() const {
     if (request_headers_parser_ != nullptr) {
@@ -1543,12 +1571,85 @@ public:
     return HeaderParser::defaultParser();
   }
 
+  const RouteSpecificFilterConfig* perFilterConfig(const std::string& name) const {
+    return per_filter_configs_.get(name);
+  }
+
+  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
+
+  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
+  bool ignorePathParametersInPathMatching() const {
+    return ignore_path_parameters_in_path_matching_;
+  }
+
+  /**
+   * @return the hash of the fields of the route configuration other than its virtual hosts, if
+   *         its virtual hosts may be reused.
+   */
+  const absl::optional<uint64_t>& configHash() const { return config_hash_; }
+
+  /**
+   * @return the hash of the fields of the route configuration other than its virtual hosts.
+   */
+  static uint64_t hashConfig(const envoy::config::route::v3::RouteConfiguration& config);
+
+  // Router::CommonConfig
+  const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
+    return internal_only_headers_;
+  }
+  const std::string& name() const override { return name_; }
+  bool usesVhds() const override { return uses_vhds_; }
+  bool mostSpecificHeaderMutationsWins() const override {
+    return most_specific_header_mutations_wins_;
+  }
+  uint32_t maxDirectResponseBodySizeBytes() const override {
+    return max_direct_response_body_size_bytes_;
+  }
+
+private:
+  std::list<Http::LowerCaseString> internal_only_headers_;
+  HeaderParserPtr request_headers_parser_;
+  HeaderParserPtr response_headers_parser_;
+  const std::string name_;
+  Stats::SymbolTable& symbol_table_;
+  std::vector<ShadowPolicyPtr> shadow_policies_;
+  // Cluster specifier plugins/providers.
+  absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
+  PerFilterConfigs per_filter_configs_;
+  const absl::optional<uint64_t> config_hash_;
+  // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
+  const uint32_t max_direct_response_body_size_bytes_;
+  const bool uses_vhds_ : 1;
+  const bool most_specific_header_mutations_wins_ : 1;
+  const bool ignore_path_parameters_in_path_matching_ : 1;
+};
+
+/**
+ * Implementation of Config that reads from a proto file.
+ */
+class ConfigImpl : public Config {
+public:
+  /**
+   * @param previous_config supplies the previous version of the route configuration, whose
+   *        unchanged virtual hosts are reused, or nullptr.
+   */
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             const OptionalHttpFilters& optional_http_filters,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config = nullptr);
+
+  const HeaderParser& requestHeaderParser() const { return shared_config_->requestHeaderParser(); }
+  const HeaderParser& responseHeaderParser() const {
+    return shared_config_->responseHeaderParser();
+  }
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
 
   const RouteSpecificFilterConfig* perFilterConfig(const std::string& name) const {
-    return per_filter_configs_.get(name);
+    return shared_config_->perFilterConfig(name);
   }
 
   // Router::Config
@@ -1563,44 +1664,35 @@ public:
                             uint64_t random_value) const override;
 
   const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
-    return internal_only_headers_;
+    return shared_config_->internalOnlyHeaders();
   }
 
-  const std::string& name() const override { return name_; }
+  const std::string& name() const override { return shared_config_->name(); }
 
-  bool usesVhds() const override { return uses_vhds_; }
+  bool usesVhds() const override { return shared_config_->usesVhds(); }
 
   bool mostSpecificHeaderMutationsWins() const override {
-    return most_specific_header_mutations_wins_;
+    return shared_config_->mostSpecificHeaderMutationsWins();
   }
 
   uint32_t maxDirectResponseBodySizeBytes() const override {
-    return max_direct_response_body_size_bytes_;
+    return shared_config_->maxDirectResponseBodySizeBytes();
   }
 
-  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
+  const std::vector<ShadowPolicyPtr>& shadowPolicies() const {
+    return shared_config_->shadowPolicies();
+  }
 
-  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
+  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const {
+    return shared_config_->clusterSpecifierPlugin(provider);
+  }
   bool ignorePathParametersInPathMatching() const {
-    return ignore_path_parameters_in_path_matching_;
+    return shared_config_->ignorePathParametersInPathMatching();
   }
 
 private:
+  CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
-  std::list<Http::LowerCaseString> internal_only_headers_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
-  const std::string name_;
-  Stats::SymbolTable& symbol_table_;
-  std::vector<ShadowPolicyPtr> shadow_policies_;
-  // Cluster specifier plugins/providers.
-  absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
-  PerFilterConfigs per_filter_configs_;
-  // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
-  const uint32_t max_direct_response_body_size_bytes_;
-  const bool uses_vhds_ : 1;
-  const bool most_specific_header_mutations_wins_ : 1;
-  const bool ignore_path_parameters_in_path_matching_ : 1;
 };
 
 /**
@@ -110,6 +110,12 @@ public:
   Http::HeaderTransforms getHeaderTransforms(const StreamInfo::StreamInfo& stream_info,
                                              bool do_formatting = true) const;
 
+  /**
+   * @return whether the parser adds and removes no headers, so that evaluating headers with it is
+   * a no-op.
+   */
+  bool empty() const { return headers_to_add_.empty() && headers_to_remove_.empty(); }
+
   static std::string translateMetadataFormat(const std::string& header_value);
   static std::string translatePerRequestState(const std::string& header_value);
 
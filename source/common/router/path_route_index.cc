@@ -0,0 +1,157 @@
+#include "source/common/router/path_route_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+// The root node is never a child, so its index doubles as the "no child" marker.
+constexpr uint32_t NoChild = 0;
+} // namespace
+
+uint32_t PathRouteIndex::findChild(uint32_t node, uint8_t c) const {
+  const auto& children = nodes_[node].children_;
+  auto it = std::lower_bound(
+      children.begin(), children.end(), c,
+      [](const std::pair<uint8_t, uint32_t>& child, uint8_t value) { return child.first < value; });
+  if (it == children.end() || it->first != c) {
+    return NoChild;
+  }
+  return it->second;
+}
+
+uint32_t PathRouteIndex::findOrCreateChild(uint32_t node, uint8_t c) {
+  const uint32_t existing = findChild(node, c);
+  if (existing != NoChild) {
+    return existing;
+  }
+  const uint32_t child = nodes_.size();
+  nodes_.emplace_back();
+  auto& children = nodes_[node].children_;
+  auto it = std::lower_bound(
+      children.begin(), children.end(), c,
+      [](const std::pair<uint8_t, uint32_t>& child, uint8_t value) { return child.first < value; });
+  children.emplace(it, c, child);
+  return child;
+}
+
+PathRouteIndex::Terminal& PathRouteIndex::terminal(uint32_t node) {
+  if (nodes_[node].terminal_ == NoTerminal) {
+    nodes_[node].terminal_ = terminals_.size();
+    terminals_.emplace_back();
+  }
+  return terminals_[nodes_[node].terminal_];
+}
+
+void PathRouteIndex::add(KeyType type, absl::string_view key, uint32_t route_index) {
+  uint32_t node = 0;
+  for (const uint8_t c : key) {
+    node = findOrCreateChild(node, c);
+  }
+
+  Terminal& entry = terminal(node);
+  switch (type) {
+  case KeyType::Exact:
+    entry.exact_.push_back(route_index);
+    break;
+  case KeyType::Prefix:
+    entry.prefix_.push_back(route_index);
+    break;
+  case KeyType::PathSeparatedPrefix:
+    entry.path_separated_prefix_.push_back(route_index);
+    break;
+  }
+}
+
+void PathRouteIndex::addUnindexed(uint32_t route_index) {
+  ASSERT(unindexed_.empty() || unindexed_.back() < route_index);
+  unindexed_.push_back(route_index);
+}
+
+void PathRouteIndex::addRegex(const std::string& regex, uint32_t route_index) {
+  if (regex_set_ == nullptr) {
+    regex_set_ = std::make_unique<re2::RE2::Set>(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH);
+  }
+  // Each route regex has already been compiled on its own, so this only fails in unexpected
+  // cases. The route is then evaluated like any other unindexed route.
+  if (regex_set_->Add(re2::StringPiece(regex.data(), regex.size()), nullptr) < 0) {
+    addUnindexed(route_index);
+    return;
+  }
+  regex_routes_.push_back(route_index);
+}
+
+void PathRouteIndex::finalize() {
+  if (regex_set_ == nullptr) {
+    return;
+  }
+  if (regex_routes_.empty()) {
+    regex_set_.reset();
+    return;
+  }
+  if (regex_set_->Compile()) {
+    return;
+  }
+
+  // The set exceeded the RE2 memory budget. Fall back to evaluating each regex route.
+  std::vector<uint32_t> unindexed;
+  unindexed.reserve(unindexed_.size() + regex_routes_.size());
+  std::merge(unindexed_.begin(), unindexed_.end(), regex_routes_.begin(), regex_routes_.end(),
+             std::back_inserter(unindexed));
+  unindexed_ = std::move(unindexed);
+  regex_routes_.clear();
+  regex_set_.reset();
+}
+
+void PathRouteIndex::findCandidates(absl::string_view path, Candidates& candidates) const {
+  candidates.assign(unindexed_.begin(), unindexed_.end());
+
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()), &matches, &error_info)) {
+      for (const int match : matches) {
+        candidates.push_back(regex_routes_[match]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The set could not be evaluated for this input, e.g. the DFA ran out of memory. Let every
+      // regex route decide on its own.
+      candidates.insert(candidates.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+
+  uint32_t node = 0;
+  size_t depth = 0;
+  while (true) {
+    const uint32_t terminal_index = nodes_[node].terminal_;
+    if (terminal_index != NoTerminal) {
+      const Terminal& entry = terminals_[terminal_index];
+      candidates.insert(candidates.end(), entry.prefix_.begin(), entry.prefix_.end());
+      if (depth == path.size() || path[depth] == '/') {
+        candidates.insert(candidates.end(), entry.path_separated_prefix_.begin(),
+                          entry.path_separated_prefix_.end());
+      }
+      if (depth == path.size()) {
+        candidates.insert(candidates.end(), entry.exact_.begin(), entry.exact_.end());
+      }
+    }
+    if (depth == path.size()) {
+      break;
+    }
+    node = findChild(node, static_cast<uint8_t>(path[depth]));
+    if (node == NoChild) {
+      break;
+    }
+    ++depth;
+  }
+
+  // Each route appears in at most one list, so sorting is enough to restore route table order.
+  std::sort(candidates.begin(), candidates.end());
+}
+
+} // namespace Router
+} // namespace Envoy
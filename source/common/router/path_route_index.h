@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * A compiled index over the path specifiers of an ordered route table. Routes whose path
+ * specifier is an exact path, a prefix or a path separated prefix are stored in a character trie
+ * keyed by the specifier; all other routes are recorded as unindexed. A lookup returns, in
+ * ascending route order, every route whose path specifier may match the supplied path, so that
+ * callers can run the full route match on a small candidate set while keeping the first-match
+ * semantics of the linear route scan.
+ *
+ * The index only covers case sensitive path specifiers. Callers are expected to add routes with
+ * case insensitive path specifiers via addUnindexed().
+ *
+ * Routes matching the full path against an RE2 regular expression may be added via addRegex().
+ * Their regular expressions are compiled into a single RE2::Set by finalize(), which lets a lookup
+ * evaluate all of them in one pass instead of running one regex per route.
+ */
+class PathRouteIndex {
+public:
+  enum class KeyType : uint8_t { Exact, Prefix, PathSeparatedPrefix };
+
+  using Candidates = absl::InlinedVector<uint32_t, 8>;
+
+  /**
+   * Add a route to the trie.
+   * @param type supplies how the key is matched against the request path.
+   * @param key supplies the path specifier of the route.
+   * @param route_index supplies the position of the route in the route table.
+   */
+  void add(KeyType type, absl::string_view key, uint32_t route_index);
+
+  /**
+   * Add a route whose path specifier cannot be indexed. Such a route is always returned as a
+   * candidate.
+   * @param route_index supplies the position of the route in the route table.
+   */
+  void addUnindexed(uint32_t route_index);
+
+  /**
+   * Add a route whose path specifier is an RE2 regular expression that must match the full path.
+   * @param regex supplies the regular expression of the route.
+   * @param route_index supplies the position of the route in the route table.
+   */
+  void addRegex(const std::string& regex, uint32_t route_index);
+
+  /**
+   * Compile the regular expressions added via addRegex(). Must be called once after all routes
+   * have been added and before findCandidates(). If the regular expressions cannot be compiled
+   * into a set, the corresponding routes are treated as unindexed.
+   */
+  void finalize();
+
+  /**
+   * Find all routes that may match the path.
+   * @param path supplies the request path, with the query string, fragment and (if configured)
+   *        path parameters already removed.
+   * @param candidates receives the candidate route indexes in ascending order.
+   */
+  void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+  /**
+   * @return the number of routes that are always returned as candidates.
+   */
+  size_t unindexedSize() const { return unindexed_.size(); }
+
+  /**
+   * @return the number of routes whose regular expressions are evaluated as a single set.
+   */
+  size_t regexSetSize() const { return regex_set_ != nullptr ? regex_routes_.size() : 0; }
+
+private:
+  static constexpr uint32_t NoTerminal = UINT32_MAX;
+
+  struct Terminal {
+    std::vector<uint32_t> exact_;
+    std::vector<uint32_t> prefix_;
+    std::vector<uint32_t> path_separated_prefix_;
+  };
+
+  struct Node {
+    // Sorted by character for binary search.
+    std::vector<std::pair<uint8_t, uint32_t>> children_;
+    uint32_t terminal_{NoTerminal};
+  };
+
+  uint32_t findChild(uint32_t node, uint8_t c) const;
+  uint32_t findOrCreateChild(uint32_t node, uint8_t c);
+  Terminal& terminal(uint32_t node);
+
+  std::vector<Node> nodes_{1};
+  std::vector<Terminal> terminals_;
+  std::vector<uint32_t> unindexed_;
+  // Route indexes of the regexes added to regex_set_, in the order they were added.
+  std::vector<uint32_t> regex_routes_;
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+};
+
+} // namespace Router
+} // namespace Envoy
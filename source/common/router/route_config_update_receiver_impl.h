@@ -32,6 +32,9 @@ public:
 private:
   const OptionalHttpFilters optional_http_filters_;
   ProtobufMessage::ValidationVisitor& validator_;
+  // The last config created, whose unchanged virtual hosts the next one reuses. It is not kept
+  // alive here once its provider replaced it.
+  mutable std::weak_ptr<const ConfigImpl> last_config_;
 };
 
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
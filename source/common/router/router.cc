@@ -20,6 +20,7 @@
 #include "source/common/common/cleanup.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/scope_tracker.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
@@ -62,6 +63,23 @@ bool schemeIsHttp(const Http::RequestHeaderMap& downstream_headers,
 
 constexpr uint64_t TimeoutPrecisionFactor = 100;
 
+const Http::LowerCaseString& endpointLoadMetricsHeader() {
+  CONSTRUCT_ON_FIRST_USE(Http::LowerCaseString, "endpoint-load-metrics");
+}
+
+// Hand an ORCA load report that the host attached to the response to the load balancing policy. The
+// header is only looked up if the policy keeps state for the host.
+void reportEndpointLoad(const Upstream::HostDescription& host, const Http::HeaderMap& headers) {
+  Upstream::HostLbPolicyData* lb_policy_data = host.lbPolicyData();
+  if (lb_policy_data == nullptr) {
+    return;
+  }
+  const Http::HeaderMap::GetResult report = headers.get(endpointLoadMetricsHeader());
+  if (!report.empty()) {
+    lb_policy_data->onLoadReport(report[0]->value().getStringView());
+  }
+}
+
 } // namespace
 
 // Express percentage as [0, TimeoutPrecisionFactor] because stats do not accept floating point
@@ -287,7 +305,9 @@ Filter::~Filter() {
   // Unregister from shadow stream notifications and cancel active streams.
   for (auto* shadow_stream : shadow_streams_) {
     shadow_stream->removeDestructorCallback();
-    shadow_stream->removeWatermarkCallbacks();
+    if (!abandon_shadows_above_high_watermark_) {
+      shadow_stream->removeWatermarkCallbacks();
+    }
     shadow_stream->cancel();
   }
 }
@@ -744,7 +764,9 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
           shadow_streams_.insert(shadow_stream);
           shadow_stream->setDestructorCallback(
               [this, shadow_stream]() { shadow_streams_.erase(shadow_stream); });
-          shadow_stream->setWatermarkCallbacks(*callbacks_);
+          if (!abandon_shadows_above_high_watermark_) {
+            shadow_stream->setWatermarkCallbacks(*callbacks_);
+          }
         }
       }
     }
@@ -833,13 +855,27 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
   // already.
   ASSERT(buffering || !upstream_requests_.empty());
 
-  for (auto* shadow_stream : shadow_streams_) {
+  for (auto it = shadow_streams_.begin(); it != shadow_streams_.end();) {
+    Http::AsyncClient::OngoingRequest* shadow_stream = *it;
+    if (abandon_shadows_above_high_watermark_ && shadow_stream->isAboveWriteBufferHighWatermark()) {
+      // The shadow can not keep up with the request, so it is given up on rather than slowing the
+      // request down.
+      ENVOY_STREAM_LOG(debug, "abandoning shadow stream above its high watermark", *callbacks_);
+      cluster_->trafficStats()->retry_or_shadow_abandoned_.inc();
+      shadow_stream->removeDestructorCallback();
+      shadow_stream->cancel();
+      shadow_streams_.erase(it++);
+      continue;
+    }
     if (end_stream) {
       shadow_stream->removeDestructorCallback();
-      shadow_stream->removeWatermarkCallbacks();
+      if (!abandon_shadows_above_high_watermark_) {
+        shadow_stream->removeWatermarkCallbacks();
+      }
     }
     Buffer::OwnedImpl copy(data);
     shadow_stream->sendData(copy, end_stream);
+    ++it;
   }
   if (end_stream) {
     shadow_streams_.clear();
@@ -887,7 +923,9 @@ Http::FilterTrailersStatus Filter::decodeTrailers(Http::RequestTrailerMap& trail
   }
   for (auto* shadow_stream : shadow_streams_) {
     shadow_stream->removeDestructorCallback();
-    shadow_stream->removeWatermarkCallbacks();
+    if (!abandon_shadows_above_high_watermark_) {
+      shadow_stream->removeWatermarkCallbacks();
+    }
     shadow_stream->captureAndSendTrailers(
         Http::createHeaderMap<Http::RequestTrailerMapImpl>(*shadow_trailers_));
   }
@@ -1435,6 +1473,7 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
                                UpstreamRequest& upstream_request, bool end_stream) {
   ENVOY_STREAM_LOG(debug, "upstream headers complete: end_stream={}", *callbacks_, end_stream);
 
+  reportEndpointLoad(*upstream_request.upstreamHost(), *headers);
   modify_headers_(*headers);
   // When grpc-status appears in response headers, convert grpc-status to HTTP status code
   // for outlier detection. This does not currently change any stats or logging and does not
@@ -1605,6 +1644,7 @@ void Filter::onUpstreamTrailers(Http::ResponseTrailerMapPtr&& trailers,
   // streams.
   ASSERT(upstream_requests_.size() == 1);
 
+  reportEndpointLoad(*upstream_request.upstreamHost(), *trailers);
   if (upstream_request.grpcRqSuccessDeferred()) {
     absl::optional<Grpc::Status::GrpcStatus> grpc_status = Grpc::Common::getGrpcStatus(*trailers);
     if (grpc_status &&
@@ -1629,8 +1669,16 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
     upstream_request.resetStream();
   }
   Event::Dispatcher& dispatcher = callbacks_->dispatcher();
-  std::chrono::milliseconds response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-      dispatcher.timeSource().monotonicTime() - downstream_request_complete_time_);
+  const MonotonicTime now = dispatcher.timeSource().monotonicTime();
+  std::chrono::milliseconds response_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - downstream_request_complete_time_);
+
+  // Feed latency aware load balancing policies, which need more than millisecond granularity.
+  Upstream::HostLbPolicyData* lb_policy_data = upstream_request.upstreamHost()->lbPolicyData();
+  if (lb_policy_data != nullptr && DateUtil::timePointValid(downstream_request_complete_time_)) {
+    lb_policy_data->onResponseTime(std::chrono::duration_cast<std::chrono::microseconds>(
+        now - downstream_request_complete_time_));
+  }
 
   Upstream::ClusterTimeoutBudgetStatsOptRef tb_stats = cluster()->timeoutBudgetStats();
   if (tb_stats.has_value()) {
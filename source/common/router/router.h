@@ -367,7 +367,9 @@ public:
       : config_(config), stats_(stats), downstream_1xx_headers_encoded_(false),
         downstream_response_started_(false), downstream_end_stream_(false), is_retry_(false),
         request_buffer_overflowed_(false), streaming_shadows_(Runtime::runtimeFeatureEnabled(
-                                               "envoy.reloadable_features.streaming_shadow")) {}
+                                               "envoy.reloadable_features.streaming_shadow")),
+        abandon_shadows_above_high_watermark_(Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.abandon_shadows_above_high_watermark")) {}
 
   ~Filter() override;
 
@@ -664,6 +666,9 @@ private:
   // Set of ongoing shadow streams which have not yet received end stream.
   absl::flat_hash_set<Http::AsyncClient::OngoingRequest*> shadow_streams_;
   const bool streaming_shadows_;
+  // Whether a shadow stream above its high watermark is abandoned, rather than applying
+  // back-pressure to the downstream request.
+  const bool abandon_shadows_above_high_watermark_;
 };
 
 class ProdFilter : public Filter {
@@ -5,6 +5,8 @@
 
 #include "source/common/protobuf/utility.h"
 
+#include "absl/strings/str_split.h"
+
 namespace Envoy {
 namespace Router {
 
@@ -21,7 +23,8 @@ bool ScopeKey::operator==(const ScopeKey& other) const {
 HeaderValueExtractorImpl::HeaderValueExtractorImpl(
     ScopedRoutes::ScopeKeyBuilder::FragmentBuilder&& config)
     : FragmentBuilderBase(std::move(config)),
-      header_value_extractor_config_(config_.header_value_extractor()) {
+      header_value_extractor_config_(config_.header_value_extractor()),
+      header_name_(header_value_extractor_config_.name()) {
   ASSERT(config_.type_case() ==
              ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::kHeaderValueExtractor,
          "header_value_extractor is not set.");
@@ -42,34 +45,42 @@ HeaderValueExtractorImpl::HeaderValueExtractorImpl(
 
 std::unique_ptr<ScopeKeyFragmentBase>
 HeaderValueExtractorImpl::computeFragment(const Http::HeaderMap& headers) const {
-  const auto header_entry =
-      headers.get(Envoy::Http::LowerCaseString(header_value_extractor_config_.name()));
+  const auto header_entry = headers.get(header_name_);
   if (header_entry.empty()) {
     return nullptr;
   }
 
   // This is an implicitly untrusted header, so per the API documentation only the first
   // value is used.
-  std::vector<absl::string_view> elements{header_entry[0]->value().getStringView()};
-  if (header_value_extractor_config_.element_separator().length() > 0) {
-    elements = absl::StrSplit(header_entry[0]->value().getStringView(),
-                              header_value_extractor_config_.element_separator());
-  }
+  const absl::string_view header_value = header_entry[0]->value().getStringView();
+  const std::string& element_separator = header_value_extractor_config_.element_separator();
+  // The elements are visited as they are split rather than collected first, and the scan stops at
+  // the element looked for.
   switch (header_value_extractor_config_.extract_type_case()) {
   case ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::HeaderValueExtractor::kElement:
-    for (const auto& element : elements) {
-      std::pair<absl::string_view, absl::string_view> key_value = absl::StrSplit(
-          element, absl::MaxSplits(header_value_extractor_config_.element().separator(), 1));
-      if (key_value.first == header_value_extractor_config_.element().key()) {
-        return std::make_unique<StringKeyFragment>(key_value.second);
+    if (element_separator.empty()) {
+      return elementFragment(header_value);
+    }
+    for (const absl::string_view element : absl::StrSplit(header_value, element_separator)) {
+      std::unique_ptr<ScopeKeyFragmentBase> fragment = elementFragment(element);
+      if (fragment != nullptr) {
+        return fragment;
       }
     }
     break;
-  case ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::HeaderValueExtractor::kIndex:
-    if (header_value_extractor_config_.index() < elements.size()) {
-      return std::make_unique<StringKeyFragment>(elements[header_value_extractor_config_.index()]);
+  case ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::HeaderValueExtractor::kIndex: {
+    if (element_separator.empty()) {
+      // Without a separator the whole value is the only element, and the index is 0.
+      return std::make_unique<StringKeyFragment>(header_value);
+    }
+    uint32_t index = 0;
+    for (const absl::string_view element : absl::StrSplit(header_value, element_separator)) {
+      if (index++ == header_value_extractor_config_.index()) {
+        return std::make_unique<StringKeyFragment>(element);
+      }
     }
     break;
+  }
   case ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::HeaderValueExtractor::EXTRACT_TYPE_NOT_SET:
     PANIC("not reached");
   }
@@ -77,6 +88,16 @@ HeaderValueExtractorImpl::computeFragment(const Http::HeaderMap& headers) const
   return nullptr;
 }
 
+std::unique_ptr<ScopeKeyFragmentBase>
+HeaderValueExtractorImpl::elementFragment(absl::string_view element) const {
+  std::pair<absl::string_view, absl::string_view> key_value = absl::StrSplit(
+      element, absl::MaxSplits(header_value_extractor_config_.element().separator(), 1));
+  if (key_value.first == header_value_extractor_config_.element().key()) {
+    return std::make_unique<StringKeyFragment>(key_value.second);
+  }
+  return nullptr;
+}
+
 ScopedRouteInfo::ScopedRouteInfo(envoy::config::route::v3::ScopedRouteConfiguration config_proto,
                                  ConfigConstSharedPtr route_config)
     : config_proto_(config_proto), route_config_(route_config),
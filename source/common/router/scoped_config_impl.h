@@ -48,8 +48,12 @@ public:
   computeFragment(const Http::HeaderMap& headers) const override;
 
 private:
+  // Returns the value of the element if its key is the configured one, nullptr otherwise.
+  std::unique_ptr<ScopeKeyFragmentBase> elementFragment(absl::string_view element) const;
+
   const ScopedRoutes::ScopeKeyBuilder::FragmentBuilder::HeaderValueExtractor&
       header_value_extractor_config_;
+  const Http::LowerCaseString header_name_;
 };
 
 /**
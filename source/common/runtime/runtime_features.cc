@@ -86,6 +86,16 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_unified_mux);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_defer_processing_backedup_streams);
 // TODO(birenroy) flip after a burn-in period
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_use_oghttp2);
+// Flip to true once the memory use of receive slices pinned by DATA payloads has been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_zero_copy_data_receive);
+// Flip to true once kernel TLS transmit offload has been validated on more kernels and NICs.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_tls_kernel_tx_offload);
+// Flip to true once the memory kept to reuse unchanged xDS resources has been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_xds_reuse_unchanged_resources);
+// Flip to true once the reuse of unchanged virtual hosts across RDS updates has been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_rds_reuse_unchanged_virtual_hosts);
+// Flip to true once timers on libevent common timeouts have been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_libevent_common_timeouts);
 // TODO(bencebeky): Finish BalsaParser implementation, then enable by default. See issue #21245.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_http1_use_balsa_parser);
 // Used to track if runtime is initialized.
@@ -100,6 +110,15 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_no_delay_close_for_upgrades);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_use_api_listener);
 // TODO(pradeepcrao) reset this to true after 2 releases (1.27)
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_enable_include_histograms);
+// Flip to true once the compiled route path index has had production soak time.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_compiled_route_path_index);
+// Flip to true once the user space events of internal connections have been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_user_space_events_in_current_iteration);
+// Flip to true once abandoning shadows under back-pressure has been validated with streaming
+// shadows.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_abandon_shadows_above_high_watermark);
+// Flip to true once collapsing identical in flight c-ares queries has been soaked.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_cares_collapse_in_flight_queries);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
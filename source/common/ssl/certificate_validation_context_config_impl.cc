@@ -9,6 +9,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
 
 #include "spdlog/spdlog.h"
 
@@ -42,7 +43,9 @@ CertificateValidationContextConfigImpl::CertificateValidationContextConfigImpl(
       api_(api), only_verify_leaf_cert_crl_(config.only_verify_leaf_cert_crl()),
       max_verify_depth_(config.has_max_verify_depth()
                             ? absl::optional<uint32_t>(config.max_verify_depth().value())
-                            : absl::nullopt) {
+                            : absl::nullopt),
+      trust_chain_verification_cache_ttl_(
+          PROTOBUF_GET_OPTIONAL_MS(config, trust_chain_verification_cache_ttl)) {
   if (ca_cert_.empty() && custom_validator_config_ == absl::nullopt) {
     if (!certificate_revocation_list_.empty()) {
       throw EnvoyException(fmt::format("Failed to load CRL from {} without trusted CA",
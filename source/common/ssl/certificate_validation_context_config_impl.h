@@ -53,6 +53,10 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  absl::optional<std::chrono::milliseconds> trustChainVerificationCacheTtl() const override {
+    return trust_chain_verification_cache_ttl_;
+  }
+
 private:
   static std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>
   getSubjectAltNameMatchers(
@@ -72,6 +76,7 @@ private:
   Api::Api& api_;
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
+  absl::optional<std::chrono::milliseconds> trust_chain_verification_cache_ttl_;
 };
 
 } // namespace Ssl
@@ -78,9 +78,13 @@ void StatMerger::mergeCounters(const Protobuf::Map<std::string, uint64_t>& count
                                const DynamicsMap& dynamic_map) {
   for (const auto& counter : counter_deltas) {
     const std::string& name = counter.first;
-    StatMerger::DynamicContext dynamic_context(temp_scope_->symbolTable());
-    StatName stat_name = dynamic_context.makeDynamicStatName(name, dynamic_map);
-    temp_scope_->counterFromStatName(stat_name).add(counter.second);
+    auto [iter, inserted] = counters_.try_emplace(name, nullptr);
+    if (inserted) {
+      StatMerger::DynamicContext dynamic_context(temp_scope_->symbolTable());
+      StatName stat_name = dynamic_context.makeDynamicStatName(name, dynamic_map);
+      iter->second = &temp_scope_->counterFromStatName(stat_name);
+    }
+    iter->second->add(counter.second);
   }
 }
 
@@ -107,20 +111,24 @@ void StatMerger::mergeGauges(const Protobuf::Map<std::string, uint64_t>& gauges,
     // 3b. Child later initializes gauges as Accumulate: the parent value is
     //     retained.
 
-    StatMerger::DynamicContext dynamic_context(temp_scope_->symbolTable());
-    StatName stat_name = dynamic_context.makeDynamicStatName(gauge.first, dynamic_map);
-    GaugeOptConstRef gauge_opt = temp_scope_->findGauge(stat_name);
+    auto [iter, inserted] = gauges_.try_emplace(gauge.first, nullptr);
+    if (inserted) {
+      StatMerger::DynamicContext dynamic_context(temp_scope_->symbolTable());
+      StatName stat_name = dynamic_context.makeDynamicStatName(gauge.first, dynamic_map);
+      GaugeOptConstRef gauge_opt = temp_scope_->findGauge(stat_name);
 
-    Gauge::ImportMode import_mode = Gauge::ImportMode::Uninitialized;
-    if (gauge_opt) {
-      import_mode = gauge_opt->get().importMode();
-      if (import_mode == Gauge::ImportMode::NeverImport) {
-        continue;
+      Gauge::ImportMode import_mode = Gauge::ImportMode::Uninitialized;
+      if (gauge_opt) {
+        import_mode = gauge_opt->get().importMode();
       }
+
+      // TODO(snowp): Propagate tag values during hot restarts.
+      iter->second = &temp_scope_->gaugeFromStatName(stat_name, import_mode);
     }
 
-    // TODO(snowp): Propagate tag values during hot restarts.
-    auto& gauge_ref = temp_scope_->gaugeFromStatName(stat_name, import_mode);
+    // The child may initialize the gauge as NeverImport between merges, so the import mode is
+    // checked on each merge.
+    Gauge& gauge_ref = *iter->second;
     if (gauge_ref.importMode() == Gauge::ImportMode::NeverImport) {
       // On the first iteration through the loop, the gauge will not be loaded into the scope
       // cache even though it might exist in another scope. Thus, we need to check again for
@@ -78,6 +78,11 @@ private:
                    const DynamicsMap& dynamics_map);
 
   StatNameHashSet parent_gauges_;
+  // The stats merged so far, by the names the parent sends them with. The parent sends the names
+  // of all its stats on each merge, so this saves encoding them into StatNames and looking them
+  // up in temp_scope_ again. The stats are kept alive by temp_scope_.
+  absl::flat_hash_map<std::string, Counter*> counters_;
+  absl::flat_hash_map<std::string, Gauge*> gauges_;
   // A stats Scope for our in-the-merging-process counters to live in. Scopes conceptually hold
   // shared_ptrs to the stats that live in them, with the question of which stats are living in a
   // given scope determined by which stat names have been accessed via that scope. E.g., if you
@@ -1,5 +1,6 @@
 #include "source/common/stats/stats_matcher_impl.h"
 
+#include <algorithm>
 #include <regex>
 #include <string>
 
@@ -12,6 +13,15 @@
 namespace Envoy {
 namespace Stats {
 
+namespace {
+
+// Returns the symbol encoding of the stat name, excluding its size.
+absl::string_view encodingOf(StatName stat_name) {
+  return {reinterpret_cast<const char*>(stat_name.data()), stat_name.dataSize()};
+}
+
+} // namespace
+
 // TODO(ambuc): Refactor this into common/matchers.cc, since StatsMatcher is really just a thin
 // wrapper around what might be called a StringMatcherList.
 StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig& config,
@@ -63,7 +73,15 @@ void StatsMatcherImpl::optimizeLastMatcher() {
   std::string prefix;
   if (matchers_.back().getCaseSensitivePrefixMatch(prefix) && absl::EndsWith(prefix, ".") &&
       prefix.size() > 1) {
-    prefixes_.push_back(stat_name_pool_->add(prefix.substr(0, prefix.size() - 1)));
+    const absl::string_view encoding =
+        encodingOf(stat_name_pool_->add(prefix.substr(0, prefix.size() - 1)));
+    if (prefixes_.insert(encoding).second) {
+      const auto pos =
+          std::lower_bound(prefix_lengths_.begin(), prefix_lengths_.end(), encoding.size());
+      if (pos == prefix_lengths_.end() || *pos != encoding.size()) {
+        prefix_lengths_.insert(pos, encoding.size());
+      }
+    }
     matchers_.pop_back();
   }
 }
@@ -84,8 +102,16 @@ StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const
 }
 
 bool StatsMatcherImpl::fastRejectMatch(StatName stat_name) const {
-  return std::any_of(prefixes_.begin(), prefixes_.end(),
-                     [stat_name](StatName prefix) { return stat_name.startsWith(prefix); });
+  const absl::string_view encoding = encodingOf(stat_name);
+  for (const size_t length : prefix_lengths_) {
+    if (length > encoding.size()) {
+      break;
+    }
+    if (prefixes_.contains(encoding.substr(0, length))) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) const {
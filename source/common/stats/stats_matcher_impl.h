@@ -10,6 +10,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -53,7 +54,13 @@ private:
   std::unique_ptr<StatNamePool> stat_name_pool_;
 
   std::vector<Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>> matchers_;
-  std::vector<StatName> prefixes_;
+
+  // The encodings of the token prefixes, backed by stat_name_pool_, and their distinct lengths in
+  // increasing order. The varint encoding of symbols is prefix-free, so a StatName starts with a
+  // prefix made of symbols exactly when its encoding starts with the encoding of the prefix. That
+  // lets a stat be checked against all the prefixes with one lookup per distinct length.
+  absl::flat_hash_set<absl::string_view> prefixes_;
+  std::vector<size_t> prefix_lengths_;
 };
 
 } // namespace Stats
@@ -261,7 +261,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -312,10 +312,21 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
 
+  // In the common case all tokens have been symbolized already, and the
+  // reference counts can be bumped with the lock held in shared mode. Recording
+  // recent lookups modifies the table, so that always takes the slow path.
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    if (recent_lookups_.capacity() == 0 && addReferencesIfPresent(tokens, symbols)) {
+      encoding.addSymbols(symbols);
+      return;
+    }
+  }
+
   // Now take the lock and populate the Symbol objects, which involves bumping
   // ref-counts in this.
   {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&lock_);
     recent_lookups_.lookup(name);
     for (auto& token : tokens) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
@@ -330,8 +341,29 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   encoding.addSymbols(symbols);
 }
 
+bool SymbolTable::addReferencesIfPresent(const std::vector<absl::string_view>& tokens,
+                                         std::vector<Symbol>& symbols) {
+  absl::InlinedVector<SharedSymbol*, 8> shared_symbols;
+  shared_symbols.reserve(tokens.size());
+  for (const absl::string_view token : tokens) {
+    auto encode_find = encode_map_.find(token);
+    if (encode_find == encode_map_.end()) {
+      return false;
+    }
+    shared_symbols.push_back(&encode_find->second);
+  }
+
+  // The maps cannot be modified while we hold the lock, so the pointers remain
+  // valid, and the symbols cannot be released before we take our references.
+  for (SharedSymbol* shared_symbol : shared_symbols) {
+    shared_symbol->ref_count_.fetch_add(1, std::memory_order_relaxed);
+    symbols.push_back(shared_symbol->symbol_);
+  }
+  return true;
+}
+
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -344,7 +376,9 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  // The caller holds a reference on every symbol, so none of them can be
+  // released concurrently.
+  absl::ReaderMutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
     auto decode_search = decode_map_.find(symbol);
 
@@ -358,7 +392,7 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
 
-    ++encode_search->second.ref_count_;
+    encode_search->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -366,21 +400,41 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
+  // Drop the references with the lock held in shared mode, remembering the
+  // symbols that are no longer referenced.
+  SymbolVec unreferenced;
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    for (Symbol symbol : symbols) {
+      auto decode_search = decode_map_.find(symbol);
+      ASSERT(decode_search != decode_map_.end());
+
+      auto encode_search = encode_map_.find(decode_search->second->toStringView());
+      ASSERT(encode_search != encode_map_.end());
 
+      if (encode_search->second.ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        unreferenced.push_back(symbol);
+      }
+    }
+  }
+  if (unreferenced.empty()) {
+    return;
+  }
+
+  // If that was the last remaining client usage of a symbol, erase the current
+  // mappings and add the now-unused symbol to the reuse pool. Another thread may
+  // have encoded the same token between dropping the shared lock and acquiring
+  // the exclusive one, or even released and re-created it under the same
+  // symbol, so only erase symbols that are still unreferenced.
+  absl::MutexLock lock(&lock_);
+  for (Symbol symbol : unreferenced) {
+    auto decode_search = decode_map_.find(symbol);
+    if (decode_search == decode_map_.end()) {
+      continue;
+    }
     auto encode_search = encode_map_.find(decode_search->second->toStringView());
     ASSERT(encode_search != encode_map_.end());
-
-    // If that was the last remaining client usage of the symbol, erase the
-    // current mappings and add the now-unused symbol to the reuse pool.
-    //
-    // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
-    // symbol_table_speed_test.cc, relative to breaking out the decrement into a
-    // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
+    if (encode_search->second.ref_count_.load(std::memory_order_relaxed) == 0) {
       decode_map_.erase(decode_search);
       encode_map_.erase(encode_search);
       pool_.push(symbol);
@@ -395,7 +449,7 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   // We don't want to hold lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
@@ -445,17 +499,17 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.setCapacity(capacity);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.clear();
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return recent_lookups_.capacity();
 }
 
@@ -486,13 +540,13 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
     // If the insertion didn't take place, return the actual value at that location and up the
     // refcount at that location
     result = encode_find->second.symbol_;
-    ++(encode_find->second.ref_count_);
+    encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
   return result;
 }
 
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -513,12 +567,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -548,7 +602,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -557,7 +611,7 @@ void SymbolTable::debugPrint() const {
   for (Symbol symbol : symbols) {
     const InlineString& token = *decode_map_.find(symbol)->second;
     const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_.load());
   }
 }
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -349,7 +351,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +399,23 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol), ref_count_(1) {}
+    // The maps only move their values while rehashing, which requires lock_ to be held
+    // exclusively, so nothing can be racing on ref_count_.
+    SharedSymbol(SharedSymbol&& other) noexcept
+        : symbol_(other.symbol_), ref_count_(other.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_;
+    // Reference counts are atomic so that they can be adjusted while lock_ is held in shared
+    // mode. Reaching zero only marks the symbol for removal; it is removed under the exclusive
+    // lock, and only if nobody picked it up again in the meantime.
+    std::atomic<uint32_t> ref_count_;
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // The maps are only modified while this is held exclusively. Encoding names
+  // whose tokens are all known already, incrementing reference counts and
+  // decrements that do not release a symbol only need it in shared mode, so
+  // threads concurrently creating stats for existing names do not serialize.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -434,7 +446,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -450,8 +462,19 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
+  /**
+   * Looks up the symbols of all tokens and, if every token has one already,
+   * takes a reference on each of them.
+   *
+   * @param tokens the tokens to look up.
+   * @param symbols receives the symbols of the tokens.
+   * @return whether all tokens were found. If not, no reference was taken.
+   */
+  bool addReferencesIfPresent(const std::vector<absl::string_view>& tokens,
+                              std::vector<Symbol>& symbols) ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
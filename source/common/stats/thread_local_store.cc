@@ -97,6 +97,7 @@ void ThreadLocalStoreImpl::setStatsMatcher(StatsMatcherPtr&& stats_matcher) {
       uint32_t erased = histogram_set_.erase(deleted_histograms_[i].get());
       ASSERT(erased == 1);
       sinked_histograms_.erase(deleted_histograms_[i].get());
+      histograms_by_id_.erase(static_cast<ParentHistogramImpl&>(*deleted_histograms_[i]).id());
     }
   }
 }
@@ -228,6 +229,9 @@ void ThreadLocalStoreImpl::shutdownThreading() {
   }
   histogram_set_.clear();
   sinked_histograms_.clear();
+  histograms_by_id_.clear();
+  histograms_to_merge_.clear();
+  histograms_with_interval_values_.clear();
 }
 
 void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
@@ -235,10 +239,17 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
     ASSERT(!merge_in_progress_);
     merge_in_progress_ = true;
     tls_cache_->runOnAllThreads(
-        [](OptRef<TlsCache> tls_cache) {
+        [this](OptRef<TlsCache> tls_cache) {
+          std::vector<uint64_t> used_histograms;
           for (const auto& id_hist : tls_cache->tls_histogram_cache_) {
             const TlsHistogramSharedPtr& tls_hist = id_hist.second;
-            tls_hist->beginMerge();
+            if (tls_hist->beginMerge()) {
+              used_histograms.push_back(id_hist.first);
+            }
+          }
+          if (!used_histograms.empty()) {
+            Thread::LockGuard lock(hist_mutex_);
+            histograms_to_merge_.insert(used_histograms.begin(), used_histograms.end());
           }
         },
         [this, merge_complete_cb]() -> void { mergeInternal(merge_complete_cb); });
@@ -250,7 +261,27 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
 
 void ThreadLocalStoreImpl::mergeInternal(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
-    forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
+    {
+      // Only visit histograms with new values or whose interval statistics need to be reset. The
+      // statistics of all other histograms would not change.
+      Thread::LockGuard lock(hist_mutex_);
+      histograms_to_merge_.insert(histograms_with_interval_values_.begin(),
+                                  histograms_with_interval_values_.end());
+      histograms_with_interval_values_.clear();
+      for (const uint64_t id : histograms_to_merge_) {
+        auto iter = histograms_by_id_.find(id);
+        if (iter == histograms_by_id_.end()) {
+          // The histogram was released since the values were recorded.
+          continue;
+        }
+        ParentHistogramImpl* histogram = iter->second;
+        histogram->merge();
+        if (histogram->intervalHasValues()) {
+          histograms_with_interval_values_.push_back(id);
+        }
+      }
+      histograms_to_merge_.clear();
+    }
     merge_complete_cb();
     merge_in_progress_ = false;
   }
@@ -681,6 +712,7 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
                                        *buckets, parent_.next_histogram_id_++);
         if (!parent_.shutting_down_) {
           parent_.histogram_set_.insert(stat.get());
+          parent_.histograms_by_id_.emplace(stat->id(), stat.get());
           if (parent_.sink_predicates_.has_value() &&
               parent_.sink_predicates_->includeHistogram(*stat)) {
             parent_.sinked_histograms_.insert(stat.get());
@@ -796,6 +828,16 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
   return *hist_tls_ptr;
 }
 
+namespace {
+
+// The number of bins initially allocated for each of the two histograms of a thread-local
+// histogram. There is one thread-local histogram per histogram and worker, and most of them only
+// ever record a handful of distinct bins, so they start small rather than with the library default
+// of 100 bins. A histogram that needs more bins grows as values are recorded.
+constexpr int ThreadLocalHistogramInitialBins = 8;
+
+} // namespace
+
 ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit,
                                                    StatName tag_extracted_name,
                                                    const StatNameTagVector& stat_name_tags,
@@ -803,8 +845,8 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
       current_active_(0), used_(false), created_thread_id_(std::this_thread::get_id()),
       symbol_table_(symbol_table) {
-  histograms_[0] = hist_alloc();
-  histograms_[1] = hist_alloc();
+  histograms_[0] = hist_alloc_nbins(ThreadLocalHistogramInitialBins);
+  histograms_[1] = hist_alloc_nbins(ThreadLocalHistogramInitialBins);
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
@@ -816,6 +858,7 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
   hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  active_has_values_ = true;
   used_ = true;
 }
 
@@ -885,6 +928,7 @@ bool ThreadLocalStoreImpl::decHistogramRefCount(ParentHistogramImpl& hist,
       const size_t count = histogram_set_.erase(hist.statName());
       ASSERT(shutting_down_ || count == 1);
       sinked_histograms_.erase(&hist);
+      histograms_by_id_.erase(hist.id());
     }
     return true;
   }
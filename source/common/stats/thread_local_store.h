@@ -21,6 +21,7 @@
 #include "source/common/stats/utility.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "circllhist.h"
 
 namespace Envoy {
@@ -42,11 +43,16 @@ public:
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
    * not have to lock the histogram in high throughput TLS writes.
+   * @return whether values were recorded since the previous swap, i.e. whether the histogram that
+   *         is now inactive must be merged.
    */
-  void beginMerge() {
+  bool beginMerge() {
     // This switches the current_active_ between 1 and 0.
     ASSERT(std::this_thread::get_id() == created_thread_id_);
     current_active_ = otherHistogramIndex();
+    const bool has_values = active_has_values_;
+    active_has_values_ = false;
+    return has_values;
   }
 
   // Stats::Histogram
@@ -66,6 +72,8 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_;
   histogram_t* histograms_[2];
+  // Only accessed by the thread that owns the histogram.
+  bool active_has_values_{false};
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -99,6 +107,11 @@ public:
    */
   void merge() override;
 
+  /**
+   * @return whether the last merge collected any values into the interval histogram.
+   */
+  bool intervalHasValues() const { return interval_statistics_.sampleCount() > 0; }
+
   const HistogramStatistics& intervalStatistics() const override { return interval_statistics_; }
   const HistogramStatistics& cumulativeStatistics() const override {
     return cumulative_statistics_;
@@ -119,6 +132,8 @@ public:
   void setShuttingDown(bool shutting_down) { shutting_down_ = shutting_down; }
   bool shuttingDown() const { return shutting_down_; }
 
+  uint64_t id() const { return id_; }
+
 private:
   bool usedLockHeld() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
 
@@ -523,6 +538,15 @@ private:
   StatSet<ParentHistogramImpl> histogram_set_ ABSL_GUARDED_BY(hist_mutex_);
   StatSet<ParentHistogramImpl> sinked_histograms_ ABSL_GUARDED_BY(hist_mutex_);
 
+  // Histograms in histogram_set_ by ID, so that a merge can visit only the histograms reported by
+  // the workers rather than every histogram in the store.
+  absl::flat_hash_map<uint64_t, ParentHistogramImpl*> histograms_by_id_ ABSL_GUARDED_BY(hist_mutex_);
+  // IDs of histograms that must be merged in the merge in progress: those with values recorded on
+  // any thread since the previous merge, and those whose previous interval was not empty, so that
+  // their interval statistics are reset.
+  absl::flat_hash_set<uint64_t> histograms_to_merge_ ABSL_GUARDED_BY(hist_mutex_);
+  std::vector<uint64_t> histograms_with_interval_values_ ABSL_GUARDED_BY(hist_mutex_);
+
   // Retain storage for deleted stats; these are no longer in maps because the
   // matcher-pattern was established after they were created. Since the stats
   // are held by reference in code that expects them to be there, we can't
@@ -242,11 +242,13 @@ struct StreamInfoImpl : public StreamInfo {
 
   Router::RouteConstSharedPtr route() const override { return route_; }
 
-  envoy::config::core::v3::Metadata& dynamicMetadata() override { return metadata_; };
-  const envoy::config::core::v3::Metadata& dynamicMetadata() const override { return metadata_; };
+  envoy::config::core::v3::Metadata& dynamicMetadata() override { return lazyMetadata(); };
+  const envoy::config::core::v3::Metadata& dynamicMetadata() const override {
+    return lazyMetadata();
+  };
 
   void setDynamicMetadata(const std::string& name, const ProtobufWkt::Struct& value) override {
-    (*metadata_.mutable_filter_metadata())[name].MergeFrom(value);
+    (*lazyMetadata().mutable_filter_metadata())[name].MergeFrom(value);
   };
 
   const FilterStateSharedPtr& filterState() override { return filter_state_; }
@@ -357,7 +359,12 @@ struct StreamInfoImpl : public StreamInfo {
     response_flags_ = info.responseFlags();
     health_check_request_ = info.healthCheck();
     route_ = info.route();
-    metadata_ = info.dynamicMetadata();
+    const auto& metadata = info.dynamicMetadata();
+    if (metadata.filter_metadata().empty() && metadata.typed_filter_metadata().empty()) {
+      metadata_.reset();
+    } else {
+      lazyMetadata() = metadata;
+    }
     filter_state_ = info.filterState();
     request_headers_ = request_headers;
     upstream_cluster_info_ = info.upstreamClusterInfo();
@@ -387,7 +394,9 @@ struct StreamInfoImpl : public StreamInfo {
   uint64_t response_flags_{};
   bool health_check_request_{};
   Router::RouteConstSharedPtr route_;
-  envoy::config::core::v3::Metadata metadata_{};
+  // Dynamic metadata is only used by some filters and loggers, and is large, so it is allocated
+  // on first access. The const accessor allocates too so that references to it stay valid.
+  mutable std::unique_ptr<envoy::config::core::v3::Metadata> metadata_;
   FilterStateSharedPtr filter_state_;
   std::string route_name_;
   absl::optional<uint32_t> attempt_count_;
@@ -396,6 +405,13 @@ struct StreamInfoImpl : public StreamInfo {
   absl::optional<std::string> virtual_cluster_name_;
 
 private:
+  envoy::config::core::v3::Metadata& lazyMetadata() const {
+    if (metadata_ == nullptr) {
+      metadata_ = std::make_unique<envoy::config::core::v3::Metadata>();
+    }
+    return *metadata_;
+  }
+
   static Network::ConnectionInfoProviderSharedPtr emptyDownstreamAddressProvider() {
     MUTABLE_CONSTRUCT_ON_FIRST_USE(
         Network::ConnectionInfoProviderSharedPtr,
@@ -14,10 +14,26 @@ namespace Envoy {
 namespace ThreadLocal {
 
 thread_local InstanceImpl::ThreadLocalData InstanceImpl::thread_local_data_;
+thread_local InstanceImpl::UpdateBatchState InstanceImpl::update_batch_state_;
+
+InstanceImpl::UpdateBatch::UpdateBatch() { ++update_batch_state_.depth_; }
+
+InstanceImpl::UpdateBatch::~UpdateBatch() {
+  ASSERT(update_batch_state_.depth_ > 0);
+  if (--update_batch_state_.depth_ > 0) {
+    return;
+  }
+  std::vector<InstanceImpl*> pending_instances;
+  pending_instances.swap(update_batch_state_.pending_instances_);
+  for (InstanceImpl* instance : pending_instances) {
+    instance->flushBatchedCallbacks();
+  }
+}
 
 InstanceImpl::~InstanceImpl() {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(shutdown_);
+  ASSERT(batched_callbacks_.empty());
   thread_local_data_.data_.clear();
 }
 
@@ -94,6 +110,9 @@ void InstanceImpl::SlotImpl::set(InitializeCb cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!parent_.shutdown_);
 
+  // The callback is different for each worker, so it is posted directly, after the callbacks
+  // batched so far.
+  parent_.flushBatchedCallbacks();
   for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
     // See the header file comments for still_alive_guard_ for why we capture index_.
     dispatcher.post(wrapCallback(
@@ -108,6 +127,8 @@ void InstanceImpl::registerThread(Event::Dispatcher& dispatcher, bool main_threa
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
 
+  // A new worker must not run the callbacks batched for the slots it doesn't have yet.
+  flushBatchedCallbacks();
   if (main_thread) {
     main_thread_dispatcher_ = &dispatcher;
     thread_local_data_.dispatcher_ = &dispatcher;
@@ -149,9 +170,7 @@ void InstanceImpl::runOnAllThreads(Event::PostCb cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
 
-  for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post(cb);
-  }
+  postToWorkers(cb);
 
   // Handle main thread.
   cb();
@@ -171,8 +190,47 @@ void InstanceImpl::runOnAllThreads(Event::PostCb cb, Event::PostCb all_threads_c
                                     delete cb;
                                   });
 
+  postToWorkers([cb_guard]() -> void { (*cb_guard)(); });
+}
+
+void InstanceImpl::postToWorkers(Event::PostCb cb) {
+  if (update_batch_state_.depth_ > 0) {
+    if (batched_callbacks_.empty()) {
+      update_batch_state_.pending_instances_.push_back(this);
+    }
+    batched_callbacks_.push_back(std::move(cb));
+    return;
+  }
+
+  for (Event::Dispatcher& dispatcher : registered_threads_) {
+    dispatcher.post(cb);
+  }
+}
+
+void InstanceImpl::flushBatchedCallbacks() {
+  if (batched_callbacks_.empty()) {
+    return;
+  }
+  // The workers share the batch, which is released once the last of them has run it, so that
+  // completion callbacks still run after all the workers are done.
+  auto callbacks =
+      std::make_shared<const std::vector<Event::PostCb>>(std::move(batched_callbacks_));
+  batched_callbacks_.clear();
+  auto it = std::find(update_batch_state_.pending_instances_.begin(),
+                      update_batch_state_.pending_instances_.end(), this);
+  if (it != update_batch_state_.pending_instances_.end()) {
+    update_batch_state_.pending_instances_.erase(it);
+  }
+  if (shutdown_) {
+    return;
+  }
+
   for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post([cb_guard]() -> void { (*cb_guard)(); });
+    dispatcher.post([callbacks]() -> void {
+      for (const Event::PostCb& cb : *callbacks) {
+        cb();
+      }
+    });
   }
 }
 
@@ -29,6 +29,19 @@ public:
   Event::Dispatcher& dispatcher() override;
   bool isShutdown() const override { return shutdown_; }
 
+  /**
+   * While an UpdateBatch exists on the main thread, the callbacks that slot updates post to the
+   * worker threads are queued instead, and each worker gets a single post running all of them
+   * when the outermost batch is destroyed. The main thread still runs its part of each update
+   * right away. Only posts made by slots are batched, so code that relies on a slot update having
+   * reached the workers before its own posts to their dispatchers must not run inside a batch.
+   */
+  class UpdateBatch : public NonCopyable {
+  public:
+    UpdateBatch();
+    ~UpdateBatch();
+  };
+
 private:
   // On destruction returns the slot index to the deferred delete queue (detaches it). This allows
   // a slot to be destructed on the main thread while controlling the lifetime of the underlying
@@ -71,12 +84,21 @@ private:
     std::vector<ThreadLocalObjectSharedPtr> data_;
   };
 
+  // The update batches of the main thread, and the instances with callbacks queued by them.
+  struct UpdateBatchState {
+    uint32_t depth_{};
+    std::vector<InstanceImpl*> pending_instances_;
+  };
+
   void removeSlot(uint32_t slot);
   void runOnAllThreads(Event::PostCb cb);
   void runOnAllThreads(Event::PostCb cb, Event::PostCb main_callback);
+  void postToWorkers(Event::PostCb cb);
+  void flushBatchedCallbacks();
   static void setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object);
 
   static thread_local ThreadLocalData thread_local_data_;
+  static thread_local UpdateBatchState update_batch_state_;
 
   Thread::MainThread main_thread_;
   std::vector<Slot*> slots_;
@@ -84,6 +106,8 @@ private:
   std::list<uint32_t> free_slot_indexes_;
   std::list<std::reference_wrapper<Event::Dispatcher>> registered_threads_;
   Event::Dispatcher* main_thread_dispatcher_{};
+  // The worker callbacks queued by the current update batch.
+  std::vector<Event::PostCb> batched_callbacks_;
   std::atomic<bool> shutdown_{};
 
   // Test only.
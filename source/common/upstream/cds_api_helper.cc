@@ -8,6 +8,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/config/resource_name.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/thread_local/thread_local_impl.h"
 
 #include "absl/container/flat_hash_set.h"
 
@@ -28,6 +29,9 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
     maybe_resume_eds_leds_sds = cm_.adsMux()->pause(paused_xds_types);
   }
 
+  // Each worker gets the thread local updates of all the clusters in a single post.
+  ThreadLocal::InstanceImpl::UpdateBatch tls_update_batch;
+
   ENVOY_LOG(info, "{}: add {} cluster(s), remove {} cluster(s)", name_, added_resources.size(),
             removed_resources.size());
 
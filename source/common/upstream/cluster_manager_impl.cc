@@ -367,10 +367,11 @@ ClusterManagerImpl::ClusterManagerImpl(
       primary_clusters_.insert(cluster.name());
     }
   }
-  // Load all the primary clusters.
+  // Load all the primary clusters. Static clusters are never updated, so the hash of their
+  // config, which is costly to compute for large bootstraps, is not needed.
   for (const auto& cluster : bootstrap.static_resources().clusters()) {
     if (is_primary_cluster(cluster)) {
-      loadCluster(cluster, MessageUtil::hash(cluster), "", false, active_clusters_);
+      loadCluster(cluster, /*cluster_hash=*/0, "", false, active_clusters_);
     }
   }
 
@@ -458,7 +459,7 @@ ClusterManagerImpl::ClusterManagerImpl(
     if (cluster.type() == envoy::config::cluster::v3::Cluster::EDS &&
         !Config::SubscriptionFactory::isPathBasedConfigSource(
             cluster.eds_cluster_config().eds_config().config_source_specifier_case())) {
-      loadCluster(cluster, MessageUtil::hash(cluster), "", false, active_clusters_);
+      loadCluster(cluster, /*cluster_hash=*/0, "", false, active_clusters_);
     }
   }
 
@@ -1101,8 +1102,13 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
 
   HostMapConstSharedPtr host_map = cm_cluster.cluster().prioritySet().crossPriorityHostMap();
 
+  // The callback is copied for every worker, so share a single immutable copy of the update,
+  // including the added and removed host vectors, across all threads instead of capturing it by
+  // value. On cluster creation hosts_added_ holds every host of the cluster.
+  auto shared_params = std::make_shared<const ThreadLocalClusterUpdateParams>(std::move(params));
+
   pending_cluster_creations_.erase(cm_cluster.cluster().info()->name());
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
+  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(shared_params),
                         add_or_update_cluster, load_balancer_factory, map = std::move(host_map)](
                            OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     ThreadLocalClusterManagerImpl::ClusterEntry* new_cluster = nullptr;
@@ -1118,7 +1124,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
       cluster_manager->thread_local_clusters_[info->name()].reset(new_cluster);
     }
 
-    for (const auto& per_priority : params.per_priority_update_params_) {
+    for (const auto& per_priority : params->per_priority_update_params_) {
       cluster_manager->updateClusterMembership(
           info->name(), per_priority.priority_, per_priority.update_hosts_params_,
           per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
@@ -1737,11 +1743,22 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::httpConnPoolIsIdle(
   }
 }
 
-HostConstSharedPtr ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::chooseHost(
+HostConstSharedPtr
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::selectOverrideHost(
     LoadBalancerContext* context) {
+  // The host map is shared by all workers, so only take a reference to it when there is an
+  // override host to look up rather than contending on its reference count for every request.
+  if (context == nullptr || !context->overrideHostToSelect().has_value()) {
+    return nullptr;
+  }
   auto cross_priority_host_map = priority_set_.crossPriorityHostMap();
-  HostConstSharedPtr host = HostUtility::selectOverrideHost(cross_priority_host_map.get(),
-                                                            override_host_statuses_, context);
+  return HostUtility::selectOverrideHost(cross_priority_host_map.get(), override_host_statuses_,
+                                         context);
+}
+
+HostConstSharedPtr ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::chooseHost(
+    LoadBalancerContext* context) {
+  HostConstSharedPtr host = selectOverrideHost(context);
   if (host != nullptr) {
     return host;
   }
@@ -1750,9 +1767,7 @@ HostConstSharedPtr ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEnt
 
 HostConstSharedPtr ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::peekAnotherHost(
     LoadBalancerContext* context) {
-  auto cross_priority_host_map = priority_set_.crossPriorityHostMap();
-  HostConstSharedPtr host = HostUtility::selectOverrideHost(cross_priority_host_map.get(),
-                                                            override_host_statuses_, context);
+  HostConstSharedPtr host = selectOverrideHost(context);
   if (host != nullptr) {
     return host;
   }
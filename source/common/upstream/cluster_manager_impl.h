@@ -553,6 +553,9 @@ private:
 
       HostConstSharedPtr chooseHost(LoadBalancerContext* context);
       HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context);
+      // Returns the override host requested by the context, e.g. by a stateful session, if it is
+      // in the cluster and has an allowed status.
+      HostConstSharedPtr selectOverrideHost(LoadBalancerContext* context);
 
       ThreadLocalClusterManagerImpl& parent_;
       PrioritySetImpl priority_set_;
@@ -652,6 +655,8 @@ private:
           version_info_(version_info), added_via_api_(added_via_api), cluster_(std::move(cluster)),
           last_updated_(time_source.systemTime()) {}
 
+    // Clusters which were not added via the API are never updated, and their config hash is not
+    // set.
     bool blockUpdate(uint64_t hash) { return !added_via_api_ || config_hash_ == hash; }
 
     // ClusterManagerCluster
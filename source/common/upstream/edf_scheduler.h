@@ -1,12 +1,16 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
-#include <queue>
+#include <list>
+#include <vector>
 
 #include "envoy/upstream/scheduler.h"
 
 #include "source/common/common/assert.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -58,12 +62,55 @@ public:
     const double deadline = current_time_ + 1.0 / weight;
     EDF_TRACE("Insertion {} in queue with deadline {} and weight {}.",
               static_cast<const void*>(entry.get()), deadline, weight);
-    queue_.push({deadline, order_offset_++, entry});
-    ASSERT(queue_.top().deadline_ >= current_time_);
+    queue_.push_back({deadline, order_offset_++, entry});
+    std::push_heap(queue_.begin(), queue_.end());
+    ASSERT(queue_.front().deadline_ >= current_time_);
   }
 
   bool empty() const override { return queue_.empty(); }
 
+  /**
+   * Updates the scheduler to hold exactly the given entries. Entries that are already scheduled keep
+   * their deadline, entries that are no longer present are dropped and new entries are added with
+   * a deadline based on the current time. This costs O(n) plus O(log n) per new entry, whereas
+   * rebuilding the scheduler costs O(n log n) and resets the position of every entry.
+   * @param entries supplies the entries that should be scheduled. T may be a non-const C.
+   * @param calculate_weight supplies the weight of new entries.
+   */
+  template <class T>
+  void update(const std::vector<std::shared_ptr<T>>& entries,
+              const std::function<double(const C&)>& calculate_weight) {
+    absl::flat_hash_set<const C*> present;
+    present.reserve(entries.size());
+    for (const auto& entry : entries) {
+      present.insert(entry.get());
+    }
+
+    absl::flat_hash_set<const C*> scheduled;
+    scheduled.reserve(queue_.size());
+    queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+                                [&present, &scheduled](const EdfEntry& edf_entry) {
+                                  const std::shared_ptr<C> entry = edf_entry.entry_.lock();
+                                  if (entry == nullptr || !present.contains(entry.get())) {
+                                    return true;
+                                  }
+                                  scheduled.insert(entry.get());
+                                  return false;
+                                }),
+                 queue_.end());
+    std::make_heap(queue_.begin(), queue_.end());
+    prepick_list_.remove_if([&present](const std::weak_ptr<C>& weak_entry) {
+      const std::shared_ptr<C> entry = weak_entry.lock();
+      return entry == nullptr || !present.contains(entry.get());
+    });
+
+    for (const auto& entry : entries) {
+      if (!scheduled.contains(entry.get())) {
+        add(calculate_weight(*entry), entry);
+      }
+    }
+  }
+
 private:
   /**
    * Clears expired entries and pops the next unexpired entry in the queue.
@@ -75,28 +122,33 @@ private:
         EDF_TRACE("Queue is empty.");
         return nullptr;
       }
-      const EdfEntry& edf_entry = queue_.top();
+      const EdfEntry& edf_entry = queue_.front();
       // Entry has been removed, let's see if there's another one.
       std::shared_ptr<C> ret = edf_entry.entry_.lock();
       if (!ret) {
         EDF_TRACE("Entry has expired, repick.");
-        queue_.pop();
+        popHeap();
         continue;
       }
       ASSERT(edf_entry.deadline_ >= current_time_);
       current_time_ = edf_entry.deadline_;
       EDF_TRACE("Picked {}, current_time_={}.", static_cast<const void*>(ret.get()), current_time_);
-      queue_.pop();
+      popHeap();
       return ret;
     }
   }
 
+  void popHeap() {
+    std::pop_heap(queue_.begin(), queue_.end());
+    queue_.pop_back();
+  }
+
   struct EdfEntry {
     double deadline_;
     // Tie breaker for entries with the same deadline. This is used to provide FIFO behavior.
     uint64_t order_offset_;
-    // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
-    // be lazily unloaded from the queue.
+    // We only hold a weak pointer, so entries whose owner goes away are lazily unloaded from the
+    // queue without a call to update().
     std::weak_ptr<C> entry_;
 
     // Flip < direction to make this a min queue.
@@ -113,8 +165,9 @@ private:
   // Offset used during addition to break ties when entries have the same weight but should reflect
   // FIFO insertion order in picks.
   uint64_t order_offset_{};
-  // Min priority queue for EDF.
-  std::priority_queue<EdfEntry> queue_;
+  // Min heap for EDF. This is a plain vector rather than a std::priority_queue so that update() can
+  // filter it in place.
+  std::vector<EdfEntry> queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
 };
 
@@ -371,21 +371,27 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onInterval() {
   request_encoder->getStream().addCallbacks(*this);
   request_in_flight_ = true;
 
-  const auto request_headers = Http::createHeaderMap<Http::RequestHeaderMapImpl>(
-      {{Http::Headers::get().Method, envoy::config::core::v3::RequestMethod_Name(parent_.method_)},
-       {Http::Headers::get().Host, hostname_},
-       {Http::Headers::get().Path, parent_.path_},
-       {Http::Headers::get().UserAgent, Http::Headers::get().UserAgentValues.EnvoyHealthChecker}});
+  // The values outlive the request headers, so they are referenced rather than copied for each
+  // health check.
+  const auto request_headers = Http::RequestHeaderMapImpl::create();
+  request_headers->setReferenceMethod(envoy::config::core::v3::RequestMethod_Name(parent_.method_));
+  request_headers->setReferenceHost(hostname_);
+  request_headers->setReferencePath(parent_.path_);
+  request_headers->setReferenceUserAgent(Http::Headers::get().UserAgentValues.EnvoyHealthChecker);
   Router::FilterUtility::setUpstreamScheme(
       *request_headers,
       // Here there is no downstream connection so scheme will be based on
       // upstream crypto
       host_->transportSocketFactory().implementsSecureTransport());
-  StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
-                                         local_connection_info_provider_);
-  stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
-  stream_info.upstreamInfo()->setUpstreamHost(host_);
-  parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  // Health checks are all sent from the main thread, so don't build a stream info for each one
+  // unless there are headers to evaluate with it.
+  if (!parent_.request_headers_parser_->empty()) {
+    StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
+                                           local_connection_info_provider_);
+    stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+    stream_info.upstreamInfo()->setUpstreamHost(host_);
+    parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  }
   auto status = request_encoder->encodeHeaders(*request_headers, true);
   // Encoding will only fail if required request headers are missing.
   ASSERT(status.ok());
@@ -815,11 +821,13 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onInterval() {
   headers_message->headers().setReferenceUserAgent(
       Http::Headers::get().UserAgentValues.EnvoyHealthChecker);
 
-  StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, parent_.dispatcher_.timeSource(),
-                                         local_connection_info_provider_);
-  stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
-  stream_info.upstreamInfo()->setUpstreamHost(host_);
-  parent_.request_headers_parser_->evaluateHeaders(headers_message->headers(), stream_info);
+  if (!parent_.request_headers_parser_->empty()) {
+    StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, parent_.dispatcher_.timeSource(),
+                                           local_connection_info_provider_);
+    stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+    stream_info.upstreamInfo()->setUpstreamHost(host_);
+    parent_.request_headers_parser_->evaluateHeaders(headers_message->headers(), stream_info);
+  }
 
   Grpc::Common::toGrpcTimeout(parent_.timeout_, headers_message->headers());
 
@@ -61,20 +61,6 @@ std::pair<int32_t, size_t> distributeLoad(PriorityLoad& per_priority_load,
   return {first_available_priority, total_load};
 }
 
-// Returns true if the weights of all the hosts in the HostVector are equal.
-bool hostWeightsAreEqual(const HostVector& hosts) {
-  if (hosts.size() <= 1) {
-    return true;
-  }
-  const uint32_t weight = hosts[0]->weight();
-  for (size_t i = 1; i < hosts.size(); ++i) {
-    if (hosts[i]->weight() != weight) {
-      return false;
-    }
-  }
-  return true;
-}
-
 } // namespace
 
 absl::optional<envoy::extensions::load_balancing_policies::common::v3::LocalityLbConfig>
@@ -828,8 +814,7 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
   const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
-    // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    auto& scheduler = scheduler_[source];
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -841,8 +826,22 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
     // host selection with lower memory and CPU overhead.
     if (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart()) {
       // Skip edf creation.
+      scheduler = Scheduler{};
+      return;
+    }
+
+    // For large host sets only a few hosts usually change per update, so update the existing
+    // schedule in place instead of rebuilding it. Hosts that are kept retain their deadline, and
+    // reweighted hosts pick up their new weight the next time they are picked. Slow start weights
+    // depend on the time of the refresh, so the schedule is always rebuilt in that case.
+    if (scheduler.edf_ != nullptr && !isSlowStartEnabled() &&
+        hosts.size() >= IncrementalSchedulerUpdateMinHosts) {
+      scheduler.edf_->update(hosts, [this](const Host& host) { return hostWeight(host); });
       return;
     }
+
+    // Nuke existing scheduler if it exists.
+    scheduler = Scheduler{};
     scheduler.edf_ = std::make_unique<EdfScheduler<const Host>>();
 
     // Populate scheduler with host list.
@@ -963,6 +962,19 @@ HostConstSharedPtr EdfLoadBalancerBase::chooseHostOnce(LoadBalancerContext* cont
   }
 }
 
+bool EdfLoadBalancerBase::hostWeightsAreEqual(const HostVector& hosts) const {
+  if (hosts.size() <= 1) {
+    return true;
+  }
+  const uint32_t weight = hosts[0]->weight();
+  for (size_t i = 1; i < hosts.size(); ++i) {
+    if (hosts[i]->weight() != weight) {
+      return false;
+    }
+  }
+  return true;
+}
+
 double EdfLoadBalancerBase::applyAggressionFactor(double time_factor) {
   if (aggression_ == 1.0 || time_factor == 1.0) {
     return time_factor;
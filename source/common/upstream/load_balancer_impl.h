@@ -480,6 +480,10 @@ protected:
     std::unique_ptr<EdfScheduler<const Host>> edf_;
   };
 
+  // Host sets of at least this size update an existing EDF schedule in place on refresh rather than
+  // rebuilding it.
+  static constexpr size_t IncrementalSchedulerUpdateMinHosts = 1024;
+
   void initialize();
 
   virtual void refresh(uint32_t priority);
@@ -499,6 +503,10 @@ protected:
   double applyAggressionFactor(double time_factor);
   double applySlowStartFactor(double host_weight, const Host& host);
 
+  // @return whether all hosts weigh the same, in which case they are picked without an EDF
+  // schedule. By default the load balancing weights of the hosts are compared.
+  virtual bool hostWeightsAreEqual(const HostVector& hosts) const;
+
 private:
   friend class EdfLoadBalancerBasePeer;
   virtual void refreshHostSource(const HostsSource& source) PURE;
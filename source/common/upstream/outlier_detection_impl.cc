@@ -351,8 +351,8 @@ void DetectorImpl::armIntervalTimer() {
       runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs())));
 }
 
-void DetectorImpl::checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor,
-                                       MonotonicTime now) {
+void DetectorImpl::checkHostForUneject(const HostSharedPtr& host,
+                                       DetectorHostMonitorImpl* monitor, MonotonicTime now) {
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
     // Node seems to be healthy and was not ejected since the last check.
     if (monitor->ejectTimeBackoff() != 0) {
@@ -628,10 +628,9 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
   // threshold returned = 52
   double mean = success_rate_sum / valid_success_rate_hosts.size();
   double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
+  for (const HostSuccessRatePair& v : valid_success_rate_hosts) {
+    variance += std::pow(v.success_rate_ - mean, 2);
+  }
   variance /= valid_success_rate_hosts.size();
   double stdev = std::sqrt(variance);
 
@@ -686,11 +685,11 @@ void DetectorImpl::processSuccessRateEjections(
       }
 
       if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_success_rate_hosts.emplace_back(host.first, success_rate);
         success_rate_sum += success_rate;
       }
       if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_failure_percentage_hosts.emplace_back(host.first, success_rate);
       }
     }
   }
@@ -742,7 +741,7 @@ void DetectorImpl::processSuccessRateEjections(
 void DetectorImpl::onIntervalTimer() {
   MonotonicTime now = time_source_.monotonicTime();
 
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     checkHostForUneject(host.first, host.second, now);
 
     // Need to update the writer bucket to keep the data valid.
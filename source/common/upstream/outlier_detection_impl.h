@@ -45,7 +45,7 @@ public:
  */
 struct HostSuccessRatePair {
   HostSuccessRatePair(HostSharedPtr host, double success_rate)
-      : host_(host), success_rate_(success_rate) {}
+      : host_(std::move(host)), success_rate_(success_rate) {}
   HostSharedPtr host_;
   double success_rate_;
 };
@@ -421,7 +421,8 @@ private:
 
   void addHostMonitor(HostSharedPtr host);
   void armIntervalTimer();
-  void checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor, MonotonicTime now);
+  void checkHostForUneject(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor,
+                           MonotonicTime now);
   void ejectHost(HostSharedPtr host, envoy::data::cluster::v3::OutlierEjectionType type);
   static DetectionStats generateStats(Stats::Scope& scope);
   void initialize(Cluster& cluster);
@@ -27,13 +27,11 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
   // BasicResourceLimitImpl
   void inc() override {
     BasicResourceLimitImpl::inc();
-    updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateGauges();
   }
   void decBy(uint64_t amount) override {
     BasicResourceLimitImpl::decBy(amount);
-    updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateGauges();
   }
 
   /**
@@ -41,13 +39,22 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
    * though atomics are used, it is possible for the current resource count
    * to be greater than the supplied max.
    */
-  void updateRemaining() {
+  void updateGauges() {
     /**
      * We cannot use std::max here because max() and current_ are
      * unsigned and subtracting them may overflow.
      */
+    const uint64_t max_copy = max();
     const uint64_t current_copy = current_;
-    remaining_.set(max() > current_copy ? max() - current_copy : 0);
+    remaining_.set(max_copy > current_copy ? max_copy - current_copy : 0);
+    /**
+     * The circuit breaker is rarely open, so the gauge is only written when its state changes,
+     * to avoid writing a cache line shared by all the workers on every inc() and dec().
+     */
+    const uint64_t open = current_copy < max_copy ? 0 : 1;
+    if (!open_gauge_.used() || open_gauge_.value() != open) {
+      open_gauge_.set(open);
+    }
   }
 
   /**
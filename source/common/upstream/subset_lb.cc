@@ -693,7 +693,7 @@ void SubsetLoadBalancer::purgeEmptySubsets(LbSubsetMap& subsets) {
 SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalancer& subset_lb,
                                                            bool locality_weight_aware,
                                                            bool scale_locality_weight)
-    : original_priority_set_(subset_lb.original_priority_set_),
+    : subset_lb_(subset_lb), original_priority_set_(subset_lb.original_priority_set_),
       locality_weight_aware_(locality_weight_aware), scale_locality_weight_(scale_locality_weight) {
   // Create at least one host set.
   getOrCreateHostSet(0);
@@ -720,25 +720,8 @@ SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalan
     break;
 
   case LoadBalancerType::RingHash:
-    // TODO(mattklein123): The ring hash LB is thread aware, but currently the subset LB is not.
-    // We should make the subset LB thread aware since the calculations are costly, and then we
-    // can also use a thread aware sub-LB properly. The following works fine but is not optimal.
-    thread_aware_lb_ = std::make_unique<RingHashLoadBalancer>(
-        *this, subset_lb.stats_, subset_lb.scope_, subset_lb.runtime_, subset_lb.random_,
-        subset_lb.lbRingHashConfig(), subset_lb.common_config_);
-    thread_aware_lb_->initialize();
-    lb_ = thread_aware_lb_->factory()->create();
-    break;
-
   case LoadBalancerType::Maglev:
-    // TODO(mattklein123): The Maglev LB is thread aware, but currently the subset LB is not.
-    // We should make the subset LB thread aware since the calculations are costly, and then we
-    // can also use a thread aware sub-LB properly. The following works fine but is not optimal.
-    thread_aware_lb_ = std::make_unique<MaglevLoadBalancer>(
-        *this, subset_lb.stats_, subset_lb.scope_, subset_lb.runtime_, subset_lb.random_,
-        subset_lb.lbMaglevConfig(), subset_lb.common_config_);
-    thread_aware_lb_->initialize();
-    lb_ = thread_aware_lb_->factory()->create();
+    // Built on first use, see lb().
     break;
 
   case LoadBalancerType::OriginalDst:
@@ -751,6 +734,30 @@ SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalan
   triggerCallbacks();
 }
 
+LoadBalancer& SubsetLoadBalancer::PrioritySubsetImpl::lb() {
+  if (lb_ != nullptr) {
+    return *lb_;
+  }
+
+  // TODO(mattklein123): The ring hash and Maglev LBs are thread aware, but currently the subset
+  // LB is not. We should make the subset LB thread aware since the calculations are costly, and
+  // then we can also use a thread aware sub-LB properly. Until then the ring is built lazily so
+  // it is only paid for by subsets that are actually selected.
+  if (subset_lb_.lb_type_ == LoadBalancerType::RingHash) {
+    thread_aware_lb_ = std::make_unique<RingHashLoadBalancer>(
+        *this, subset_lb_.stats_, subset_lb_.scope_, subset_lb_.runtime_, subset_lb_.random_,
+        subset_lb_.lbRingHashConfig(), subset_lb_.common_config_);
+  } else {
+    ASSERT(subset_lb_.lb_type_ == LoadBalancerType::Maglev);
+    thread_aware_lb_ = std::make_unique<MaglevLoadBalancer>(
+        *this, subset_lb_.stats_, subset_lb_.scope_, subset_lb_.runtime_, subset_lb_.random_,
+        subset_lb_.lbMaglevConfig(), subset_lb_.common_config_);
+  }
+  thread_aware_lb_->initialize();
+  lb_ = thread_aware_lb_->factory()->create();
+  return *lb_;
+}
+
 // Given all hosts that that belong in this subset, hosts_added and hosts_removed, update the
 // underlying HostSet. The hosts_added Hosts and hosts_removed Hosts have been filtered to match
 // hosts that belong in this subset.
@@ -871,6 +878,13 @@ void SubsetLoadBalancer::PrioritySubsetImpl::update(uint32_t priority,
                                                     const HostHashSet& matching_hosts,
                                                     const HostVector& hosts_added,
                                                     const HostVector& hosts_removed) {
+  // Drop the thread aware LB rather than letting it rebuild its ring for the new hosts. It is
+  // built again the next time this subset is selected.
+  if (thread_aware_lb_ != nullptr) {
+    lb_.reset();
+    thread_aware_lb_.reset();
+  }
+
   const auto& host_subset = getOrCreateHostSet(priority);
   updateSubset(priority, matching_hosts, hosts_added, hosts_removed);
 
@@ -880,13 +894,6 @@ void SubsetLoadBalancer::PrioritySubsetImpl::update(uint32_t priority,
       empty_ &= host_set->hosts().empty();
     }
   }
-
-  // Create a new worker local LB if needed.
-  // TODO(mattklein123): See the PrioritySubsetImpl constructor for additional comments on how
-  // we can do better here.
-  if (thread_aware_lb_ != nullptr) {
-    lb_ = thread_aware_lb_->factory()->create();
-  }
 }
 
 SubsetLoadBalancer::LoadBalancerContextWrapper::LoadBalancerContextWrapper(
@@ -116,20 +116,25 @@ private:
       runUpdateCallbacks(hosts_added, hosts_removed);
     }
 
-    // Thread aware LB if applicable.
-    ThreadAwareLoadBalancerPtr thread_aware_lb_;
-    // Current active LB.
-    LoadBalancerPtr lb_;
+    // Returns the worker local LB. Thread aware LBs (ring hash and Maglev) are only built the
+    // first time the subset is used after an update, so subsets that are never selected don't
+    // pay for a ring on every host update.
+    LoadBalancer& lb();
 
   protected:
     HostSetImplPtr createHostSet(uint32_t priority,
                                  absl::optional<uint32_t> overprovisioning_factor) override;
 
   private:
+    const SubsetLoadBalancer& subset_lb_;
     const PrioritySet& original_priority_set_;
     const bool locality_weight_aware_;
     const bool scale_locality_weight_;
     bool empty_ = true;
+    // Thread aware LB if applicable.
+    ThreadAwareLoadBalancerPtr thread_aware_lb_;
+    // Current active LB.
+    LoadBalancerPtr lb_;
   };
 
   using HostSubsetImplPtr = std::unique_ptr<HostSubsetImpl>;
@@ -207,7 +212,7 @@ private:
   class LbSubset {
   public:
     virtual ~LbSubset() = default;
-    virtual HostConstSharedPtr chooseHost(LoadBalancerContext* context) const PURE;
+    virtual HostConstSharedPtr chooseHost(LoadBalancerContext* context) PURE;
     virtual void pushHost(uint32_t priority, HostSharedPtr host) PURE;
     virtual void finalize(uint32_t priority) PURE;
     virtual bool active() const PURE;
@@ -221,8 +226,8 @@ private:
         : subset_(subset_lb, locality_weight_aware, scale_locality_weight) {}
 
     // Subset
-    HostConstSharedPtr chooseHost(LoadBalancerContext* context) const override {
-      return subset_.lb_->chooseHost(context);
+    HostConstSharedPtr chooseHost(LoadBalancerContext* context) override {
+      return subset_.lb().chooseHost(context);
     }
     void pushHost(uint32_t priority, HostSharedPtr host) override {
       while (host_sets_.size() <= priority) {
@@ -267,7 +272,7 @@ private:
 
   class SingleHostLbSubset : public LbSubset {
     // Subset
-    HostConstSharedPtr chooseHost(LoadBalancerContext*) const override { return subset_; }
+    HostConstSharedPtr chooseHost(LoadBalancerContext*) override { return subset_; }
     // This is called at most once for every update for single host subset.
     void pushHost(uint32_t priority, HostSharedPtr host) override {
       new_hosts_[priority] = std::move(host);
@@ -249,10 +249,14 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   // next one in the ring. The random sequence is seeded by the hash, so the same input gets the
   // same sequence of hosts all the time.
   const uint32_t num_hosts = normalized_host_weights_.size();
-  auto host_index = std::vector<uint32_t>(num_hosts);
-  for (uint32_t i = 0; i < num_hosts; i++) {
-    host_index[i] = i;
-  }
+  // Host indexes of the positions touched by the shuffle below. Positions that were never swapped
+  // hold their own index, so only the probed part of the shuffle is materialized rather than an
+  // index of every host in the cluster.
+  absl::flat_hash_map<uint32_t, uint32_t> host_index;
+  const auto host_index_at = [&host_index](uint32_t position) -> uint32_t {
+    const auto it = host_index.find(position);
+    return it == host_index.end() ? position : it->second;
+  };
 
   // Not using Random::RandomGenerator as it does not take a seed. Seeded RNG is a requirement
   // here as we need the same shuffle sequence for the same hash every time.
@@ -273,11 +277,14 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   HostConstSharedPtr alt_host, least_overloaded_host = host;
   double least_overload_factor = overload_factor;
   for (uint32_t i = 0; i < num_hosts; i++) {
-    // The random shuffle algorithm
+    // The random shuffle algorithm. Position i is never visited again, so only position i + j
+    // needs to remember the swap.
     const uint32_t j = uniform_int(random, num_hosts - i);
-    std::swap(host_index[i], host_index[i + j]);
+    const uint32_t k = host_index_at(i + j);
+    if (j != 0) {
+      host_index[i + j] = host_index_at(i);
+    }
 
-    const uint32_t k = host_index[i];
     alt_host = normalized_host_weights_[k].first;
     if (alt_host == host) {
       continue;
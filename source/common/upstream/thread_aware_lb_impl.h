@@ -10,6 +10,7 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/upstream/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 
@@ -17,7 +18,7 @@ namespace Envoy {
 namespace Upstream {
 
 using NormalizedHostWeightVector = std::vector<std::pair<HostConstSharedPtr, double>>;
-using NormalizedHostWeightMap = std::map<HostConstSharedPtr, double>;
+using NormalizedHostWeightMap = absl::flat_hash_map<HostConstSharedPtr, double>;
 
 class ThreadAwareLoadBalancerBase : public LoadBalancerBase, public ThreadAwareLoadBalancer {
 public:
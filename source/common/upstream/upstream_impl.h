@@ -153,6 +153,7 @@ public:
       const envoy::config::core::v3::Locality& locality,
       const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
       uint32_t priority, TimeSource& time_source);
+  ~HostDescriptionImpl() override { delete lb_policy_data_.load(); }
 
   Network::UpstreamTransportSocketFactory& transportSocketFactory() const override {
     absl::ReaderMutexLock lock(&metadata_mutex_);
@@ -229,6 +230,17 @@ public:
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const;
   absl::optional<MonotonicTime> lastHcPassTime() const override { return last_hc_pass_time_; }
+  HostLbPolicyData* lbPolicyData() const override {
+    return lb_policy_data_.load(std::memory_order_acquire);
+  }
+  HostLbPolicyData& setLbPolicyData(HostLbPolicyDataPtr&& lb_policy_data) const override {
+    HostLbPolicyData* existing = nullptr;
+    if (lb_policy_data_.compare_exchange_strong(existing, lb_policy_data.get(),
+                                                std::memory_order_acq_rel)) {
+      return *lb_policy_data.release();
+    }
+    return *existing;
+  }
 
   void setAddressList(const std::vector<Network::Address::InstanceConstSharedPtr>& address_list) {
     address_list_ = address_list;
@@ -274,6 +286,8 @@ private:
       socket_factory_ ABSL_GUARDED_BY(metadata_mutex_);
   const MonotonicTime creation_time_;
   absl::optional<MonotonicTime> last_hc_pass_time_;
+  // Owned by the host. An atomic raw pointer so that workers can install the state lock free.
+  mutable std::atomic<HostLbPolicyData*> lb_policy_data_{nullptr};
 };
 
 /**
@@ -756,6 +770,7 @@ public:
   }
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  bool adaptivePreconnect() const override { return adaptive_preconnect_; }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -959,6 +974,7 @@ private:
   absl::optional<std::chrono::milliseconds> max_connection_duration_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const bool adaptive_preconnect_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable LazyClusterTrafficStats traffic_stats_;
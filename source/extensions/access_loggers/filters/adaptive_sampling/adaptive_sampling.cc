@@ -0,0 +1,88 @@
+#include "source/extensions/access_loggers/filters/adaptive_sampling/adaptive_sampling.h"
+
+#include <algorithm>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+AdaptiveSamplingFilter::AdaptiveSamplingFilter(
+    const envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling&
+        config,
+    Runtime::Loader& runtime, Random::RandomGenerator& random)
+    : runtime_(runtime), random_(random),
+      target_runtime_key_(config.target_logs_per_second().runtime_key()),
+      default_target_logs_per_second_(config.target_logs_per_second().default_value()),
+      window_(std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, window, 1000))),
+      always_log_errors_(config.always_log_errors()),
+      always_log_duration_(config.has_always_log_duration()
+                               ? absl::make_optional(std::chrono::milliseconds(
+                                     DurationUtil::durationToMilliseconds(
+                                         config.always_log_duration())))
+                               : absl::nullopt),
+      always_log_response_codes_(config.always_log_response_codes().begin(),
+                                 config.always_log_response_codes().end()) {}
+
+bool AdaptiveSamplingFilter::alwaysLog(const StreamInfo::StreamInfo& info) const {
+  const absl::optional<uint32_t> response_code = info.responseCode();
+  if (always_log_errors_ &&
+      (!response_code.has_value() || response_code.value() >= 500 || info.hasAnyResponseFlag())) {
+    return true;
+  }
+  if (response_code.has_value() && always_log_response_codes_.contains(response_code.value())) {
+    return true;
+  }
+  if (always_log_duration_.has_value()) {
+    const absl::optional<std::chrono::nanoseconds> duration = info.requestComplete();
+    if (duration.has_value() && duration.value() >= always_log_duration_.value()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t AdaptiveSamplingFilter::countRequest(MonotonicTime now) const {
+  const uint64_t index = now.time_since_epoch() / window_;
+  uint64_t current_index = window_index_.load(std::memory_order_relaxed);
+  if (index > current_index &&
+      window_index_.compare_exchange_strong(current_index, index, std::memory_order_relaxed)) {
+    // The previous count only describes the current rate if the windows are adjacent.
+    const uint64_t requests = window_requests_.exchange(0, std::memory_order_relaxed);
+    previous_window_requests_.store(index == current_index + 1 ? requests : 0,
+                                    std::memory_order_relaxed);
+  }
+  const uint64_t requests = window_requests_.fetch_add(1, std::memory_order_relaxed) + 1;
+  return std::max(requests, previous_window_requests_.load(std::memory_order_relaxed));
+}
+
+bool AdaptiveSamplingFilter::evaluate(const StreamInfo::StreamInfo& info,
+                                      const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                      const Http::ResponseTrailerMap&) const {
+  if (alwaysLog(info)) {
+    return true;
+  }
+
+  const MonotonicTime now =
+      info.startTimeMonotonic() + info.requestComplete().value_or(std::chrono::nanoseconds(0));
+  const uint64_t window_requests = countRequest(now);
+  const uint64_t target_logs_per_second =
+      runtime_.snapshot().getInteger(target_runtime_key_, default_target_logs_per_second_);
+  const double target_logs_per_window =
+      target_logs_per_second * std::chrono::duration<double>(window_).count();
+  if (window_requests <= target_logs_per_window) {
+    return true;
+  }
+
+  const uint64_t keep = target_logs_per_window / window_requests * RatioDenominator;
+  return random_.random() % RatioDenominator < keep;
+}
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
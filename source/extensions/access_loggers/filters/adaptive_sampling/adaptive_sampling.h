@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/common/random_generator.h"
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.h"
+#include "envoy/runtime/runtime.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+/**
+ * Access log filter that lowers the sampling ratio as the request rate goes up, so that the access
+ * log receives a bounded number of entries while requests that must not be missed are always
+ * logged.
+ *
+ * The filter is shared by all workers. Rates are tracked in fixed windows with relaxed atomics, so
+ * concurrent requests at a window boundary may be counted in either window.
+ */
+class AdaptiveSamplingFilter : public AccessLog::Filter {
+public:
+  AdaptiveSamplingFilter(
+      const envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling&
+          config,
+      Runtime::Loader& runtime, Random::RandomGenerator& random);
+
+  // AccessLog::Filter
+  bool evaluate(const StreamInfo::StreamInfo& info, const Http::RequestHeaderMap& request_headers,
+                const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap& response_trailers) const override;
+
+  // The resolution of the sampling decision.
+  static constexpr uint64_t RatioDenominator = 1000000;
+
+private:
+  bool alwaysLog(const StreamInfo::StreamInfo& info) const;
+  // Counts the request in its window and returns the number of requests seen in the previous
+  // window, or in the current one if there were more so far.
+  uint64_t countRequest(MonotonicTime now) const;
+
+  Runtime::Loader& runtime_;
+  Random::RandomGenerator& random_;
+  const std::string target_runtime_key_;
+  const uint32_t default_target_logs_per_second_;
+  const std::chrono::nanoseconds window_;
+  const bool always_log_errors_;
+  const absl::optional<std::chrono::milliseconds> always_log_duration_;
+  const absl::flat_hash_set<uint32_t> always_log_response_codes_;
+
+  mutable std::atomic<uint64_t> window_index_{0};
+  mutable std::atomic<uint64_t> window_requests_{0};
+  mutable std::atomic<uint64_t> previous_window_requests_{0};
+};
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,42 @@
+#include "source/extensions/access_loggers/filters/adaptive_sampling/config.h"
+
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.h"
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.validate.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/filters/adaptive_sampling/adaptive_sampling.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+Envoy::AccessLog::FilterPtr AdaptiveSamplingFilterFactory::createFilter(
+    const envoy::config::accesslog::v3::ExtensionFilter& config, Runtime::Loader& runtime,
+    Random::RandomGenerator& random) {
+  auto factory_config = Config::Utility::translateToFactoryConfig(
+      config, ProtobufMessage::getNullValidationVisitor(), *this);
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling&>(
+      *factory_config, ProtobufMessage::getNullValidationVisitor());
+  return std::make_unique<AdaptiveSamplingFilter>(proto_config, runtime, random);
+}
+
+ProtobufTypes::MessagePtr AdaptiveSamplingFilterFactory::createEmptyConfigProto() {
+  return std::make_unique<
+      envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling>();
+}
+
+/**
+ * Static registration for the adaptive sampling access log filter. @see RegisterFactory.
+ */
+REGISTER_FACTORY(AdaptiveSamplingFilterFactory, Envoy::AccessLog::ExtensionFilterFactory);
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
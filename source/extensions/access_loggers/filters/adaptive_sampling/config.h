@@ -0,0 +1,29 @@
+#pragma once
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/access_log/access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+class AdaptiveSamplingFilterFactory : public Envoy::AccessLog::ExtensionFilterFactory {
+public:
+  Envoy::AccessLog::FilterPtr
+  createFilter(const envoy::config::accesslog::v3::ExtensionFilter& config,
+               Runtime::Loader& runtime, Random::RandomGenerator& random) override;
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override;
+  std::string name() const override {
+    return "envoy.access_loggers.extension_filters.adaptive_sampling";
+  }
+};
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
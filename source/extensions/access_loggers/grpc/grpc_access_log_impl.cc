@@ -5,6 +5,7 @@
 #include "envoy/grpc/async_client_manager.h"
 #include "envoy/local_info/local_info.h"
 
+#include "source/common/common/assert.h"
 #include "source/common/config/utility.h"
 #include "source/common/grpc/typed_async_client.h"
 
@@ -24,12 +25,37 @@ GrpcAccessLoggerImpl::GrpcAccessLoggerImpl(
                            "envoy.service.accesslog.v3.AccessLogService.StreamAccessLogs")),
       log_name_(config.log_name()), local_info_(local_info) {}
 
+namespace {
+
+// Entries are serialized as soon as they are logged and kept as unknown `log_entry` fields of the
+// batch, which are written out verbatim with the rest of the message. This produces the same wire
+// format as repeated `log_entry` fields while only holding on to one string per entry instead of a
+// tree of messages, and reuses the sizes computed when the entry was logged.
+void appendSerializedEntry(Protobuf::UnknownFieldSet& entries, int field_number,
+                           const Protobuf::Message& entry) {
+  // The entry size was computed and cached by GrpcAccessLogger::log().
+  ASSERT(static_cast<size_t>(entry.GetCachedSize()) == entry.ByteSizeLong());
+  std::string* bytes = entries.AddLengthDelimited(field_number);
+  bytes->resize(entry.GetCachedSize());
+  entry.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(bytes->data()));
+}
+
+} // namespace
+
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::HTTPAccessLogEntry&& entry) {
-  message_.mutable_http_logs()->mutable_log_entry()->Add(std::move(entry));
+  appendSerializedEntry(
+      *message_.mutable_http_logs()->mutable_unknown_fields(),
+      envoy::service::accesslog::v3::StreamAccessLogsMessage::HTTPAccessLogEntries::
+          kLogEntryFieldNumber,
+      entry);
 }
 
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) {
-  message_.mutable_tcp_logs()->mutable_log_entry()->Add(std::move(entry));
+  appendSerializedEntry(
+      *message_.mutable_tcp_logs()->mutable_unknown_fields(),
+      envoy::service::accesslog::v3::StreamAccessLogsMessage::TCPAccessLogEntries::
+          kLogEntryFieldNumber,
+      entry);
 }
 
 bool GrpcAccessLoggerImpl::isEmpty() {
@@ -124,6 +124,10 @@ public:
   }
   uint32_t priority() const override { return logical_host_->priority(); }
   void priority(uint32_t) override {}
+  HostLbPolicyData* lbPolicyData() const override { return logical_host_->lbPolicyData(); }
+  HostLbPolicyData& setLbPolicyData(HostLbPolicyDataPtr&& lb_policy_data) const override {
+    return logical_host_->setLbPolicyData(std::move(lb_policy_data));
+  }
 
 private:
   const Network::Address::InstanceConstSharedPtr address_;
@@ -46,6 +46,12 @@ EdsClusterImpl::EdsClusterImpl(
 void EdsClusterImpl::startPreInit() { subscription_->start({cluster_name_}); }
 
 void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& host_update_cb) {
+  // Get the map of all the latest existing hosts, which is used to reuse unchanged hosts while the
+  // endpoints are processed and to filter out the existing hosts in the process of updating
+  // cluster memberships.
+  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
+  ASSERT(all_hosts != nullptr);
+
   absl::flat_hash_set<std::string> all_new_hosts;
   PriorityStateManager priority_state_manager(parent_, parent_.local_info_, &host_update_cb);
   for (const auto& locality_lb_endpoint : cluster_load_assignment_.endpoints()) {
@@ -65,12 +71,12 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
       for (const auto& [_, lb_endpoint] :
            parent_.leds_localities_[leds_config]->getEndpointsMap()) {
         updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+                                *all_hosts, all_new_hosts);
       }
     } else {
       for (const auto& lb_endpoint : locality_lb_endpoint.lb_endpoints()) {
         updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+                                *all_hosts, all_new_hosts);
       }
     }
   }
@@ -78,11 +84,6 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
   // Track whether we rebuilt any LB structures.
   bool cluster_rebuilt = false;
 
-  // Get the map of all the latest existing hosts, which is used to filter out the existing
-  // hosts in the process of updating cluster memberships.
-  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
-  ASSERT(all_hosts != nullptr);
-
   const uint32_t overprovisioning_factor = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
       cluster_load_assignment_.policy(), overprovisioning_factor, kDefaultOverProvisioningFactor);
 
@@ -131,7 +132,8 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
 void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
     const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
     const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
-    PriorityStateManager& priority_state_manager, absl::flat_hash_set<std::string>& all_new_hosts) {
+    PriorityStateManager& priority_state_manager, const HostMap& all_hosts,
+    absl::flat_hash_set<std::string>& all_new_hosts) {
   const auto address = parent_.resolveProtoAddress(lb_endpoint.endpoint().address());
   // When the configuration contains duplicate hosts, only the first one will be retained.
   const auto address_as_string = address->asString();
@@ -139,18 +141,68 @@ void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
     return;
   }
 
-  priority_state_manager.registerHostForPriority(lb_endpoint.endpoint().hostname(), address,
-                                                 locality_lb_endpoint, lb_endpoint,
-                                                 parent_.time_source_);
+  // Most endpoints of a large assignment are usually unchanged. Register the existing host for
+  // them directly rather than building a new host that updateDynamicHostList() would discard in
+  // favor of the existing one anyway.
+  const auto existing_host = all_hosts.find(address_as_string);
+  if (existing_host != all_hosts.end() &&
+      hostIsUnchanged(*existing_host->second, lb_endpoint, locality_lb_endpoint)) {
+    priority_state_manager.registerHostForPriority(existing_host->second, locality_lb_endpoint);
+  } else {
+    priority_state_manager.registerHostForPriority(lb_endpoint.endpoint().hostname(), address,
+                                                   locality_lb_endpoint, lb_endpoint,
+                                                   parent_.time_source_);
+  }
   all_new_hosts.emplace(address_as_string);
 }
 
+bool EdsClusterImpl::BatchUpdateHelper::hostIsUnchanged(
+    const Host& host, const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
+    const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint) const {
+  // This must be at least as strict as the in-place update of BaseDynamicClusterImpl::
+  // updateDynamicHostList(), so that registering the existing host leaves the update unchanged.
+  const auto& endpoint = lb_endpoint.endpoint();
+  const auto& health_check_config = endpoint.health_check_config();
+  if (host.hostname() != endpoint.hostname() ||
+      host.weight() != std::max(1U, lb_endpoint.load_balancing_weight().value()) ||
+      host.priority() != locality_lb_endpoint.priority() ||
+      !LocalityEqualTo()(host.locality(), locality_lb_endpoint.locality())) {
+    return false;
+  }
+
+  // The health check address is derived from the host address unless it is configured
+  // explicitly, in which case a new host is built to compare the resolved address.
+  if (health_check_config.has_address() || health_check_config.port_value() != 0 ||
+      host.healthCheckAddress() != host.address() ||
+      host.hostnameForHealthChecks() != health_check_config.hostname() ||
+      host.disableActiveHealthCheck() != health_check_config.disable_active_health_check()) {
+    return false;
+  }
+
+  // See HostImpl::setEdsHealthFlag().
+  const auto health_status = lb_endpoint.health_status();
+  const bool failed_eds_health = health_status == envoy::config::core::v3::UNHEALTHY ||
+                                 health_status == envoy::config::core::v3::DRAINING ||
+                                 health_status == envoy::config::core::v3::TIMEOUT;
+  const bool degraded_eds_health = health_status == envoy::config::core::v3::DEGRADED;
+  if (host.healthFlagGet(Host::HealthFlag::FAILED_EDS_HEALTH) != failed_eds_health ||
+      host.healthFlagGet(Host::HealthFlag::DEGRADED_EDS_HEALTH) != degraded_eds_health) {
+    return false;
+  }
+
+  if (!lb_endpoint.has_metadata()) {
+    return host.metadata() == nullptr;
+  }
+  return host.metadata() != nullptr &&
+         Protobuf::util::MessageDifferencer::Equivalent(*host.metadata(), lb_endpoint.metadata());
+}
+
 void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& resources,
                                     const std::string&) {
   if (!validateUpdateSize(resources.size())) {
     return;
   }
-  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment =
+  const auto& cluster_load_assignment =
       dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(
           resources[0].get().resource());
   if (cluster_load_assignment.cluster_name() != cluster_name_) {
@@ -207,14 +259,14 @@ void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef
     return cla_leds_configs.find(leds_config) == cla_leds_configs.end();
   });
 
-  // In case LEDS is used, store the cluster load assignment as a field
-  // (optimize for no-copy).
-  envoy::config::endpoint::v3::ClusterLoadAssignment* used_load_assignment;
+  // In case LEDS is used, store the cluster load assignment as a field. Otherwise the decoded
+  // resource outlives the update below, so the assignment is used without a copy.
+  const envoy::config::endpoint::v3::ClusterLoadAssignment* used_load_assignment;
   if (cla_leds_configs.empty()) {
     cluster_load_assignment_ = absl::nullopt;
     used_load_assignment = &cluster_load_assignment;
   } else {
-    cluster_load_assignment_ = std::move(cluster_load_assignment);
+    cluster_load_assignment_ = cluster_load_assignment;
     used_load_assignment = &cluster_load_assignment_.value();
   }
 
@@ -79,8 +79,13 @@ private:
     void updateLocalityEndpoints(
         const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
         const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
-        PriorityStateManager& priority_state_manager,
+        PriorityStateManager& priority_state_manager, const HostMap& all_hosts,
         absl::flat_hash_set<std::string>& all_new_hosts);
+    // Returns whether the existing host already matches the endpoint, in which case it can be used
+    // for the update without building a new host.
+    bool hostIsUnchanged(
+        const Host& host, const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
+        const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint) const;
 
     EdsClusterImpl& parent_;
     const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment_;
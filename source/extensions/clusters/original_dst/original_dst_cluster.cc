@@ -54,6 +54,12 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
         it->second->used_ = true;
         return host;
       }
+      if (auto created = created_hosts_.find(dst_addr.asString());
+          created != created_hosts_.end()) {
+        ENVOY_LOG(trace, "Using pending host {} {}.", *created->second,
+                  created->second->address()->asString());
+        return created->second;
+      }
       // Add a new host
       const Network::Address::Ip* dst_ip = dst_addr.ip();
       if (dst_ip) {
@@ -67,6 +73,7 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
             envoy::config::endpoint::v3::Endpoint::HealthCheckConfig().default_instance(), 0,
             envoy::config::core::v3::UNKNOWN, parent_->time_source_));
         ENVOY_LOG(debug, "Created host {} {}.", *host, host->address()->asString());
+        created_hosts_.emplace(dst_addr.asString(), host);
 
         // Tell the cluster about the new host
         // lambda cannot capture a member by value.
@@ -15,6 +15,8 @@
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -96,6 +98,10 @@ public:
     const absl::optional<Http::LowerCaseString>& http_header_name_;
     const absl::optional<uint32_t> port_override_;
     HostMultiMapConstSharedPtr host_map_;
+    // Hosts created by this load balancer that are not in host_map_ yet. A new load balancer is
+    // created with the updated host map once the main thread adds them, so until then further
+    // requests to the same address reuse the host instead of creating and posting another one.
+    absl::flat_hash_map<std::string, HostSharedPtr> created_hosts_;
   };
 
   const absl::optional<Http::LowerCaseString>& httpHeaderName() { return http_header_name_; }
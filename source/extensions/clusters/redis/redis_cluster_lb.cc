@@ -17,6 +17,22 @@ bool ClusterSlot::operator==(const Envoy::Extensions::Clusters::Redis::ClusterSl
 }
 
 // RedisClusterLoadBalancerFactory
+bool RedisClusterLoadBalancerFactory::RedisShard::hasHosts(
+    const Upstream::HostConstSharedPtr& primary, const Upstream::HostVector& replicas) const {
+  const Upstream::HostVector& current_replicas = replicas_.hosts();
+  return primary_ == primary && current_replicas.size() == replicas.size() &&
+         std::equal(current_replicas.begin(), current_replicas.end(), replicas.begin());
+}
+
+bool RedisClusterLoadBalancerFactory::sameSlotRanges(const std::vector<ClusterSlot>& lhs,
+                                                     const std::vector<ClusterSlot>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](const ClusterSlot& a, const ClusterSlot& b) {
+                      return a.start() == b.start() && a.end() == b.end() &&
+                             *a.primary() == *b.primary();
+                    });
+}
+
 bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&& slots,
                                                           Envoy::Upstream::HostMap& all_hosts) {
   // The slots is sorted, allowing for a quick comparison to make sure we need to update the slot
@@ -30,9 +46,19 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
     return false;
   }
 
-  auto updated_slots = std::make_shared<SlotArray>();
+  // A refresh usually changes few shards, so the shards whose hosts are unchanged are reused rather
+  // than rebuilding their host sets.
+  absl::flat_hash_map<std::string, RedisShardSharedPtr> current_shards;
+  if (shard_vector_) {
+    for (const RedisShardSharedPtr& shard : *shard_vector_) {
+      current_shards.emplace(shard->primary()->address()->asString(), shard);
+    }
+  }
+
   auto shard_vector = std::make_shared<std::vector<RedisShardSharedPtr>>();
   absl::flat_hash_map<std::string, uint64_t> shards;
+  std::vector<uint64_t> slot_shards;
+  slot_shards.reserve(slots->size());
 
   for (const ClusterSlot& slot : *slots) {
     // look in the updated map
@@ -56,13 +82,32 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
         primary_and_replicas->push_back(replica_host->second);
       }
 
-      shard_vector->emplace_back(
-          std::make_shared<RedisShard>(primary_host->second, replicas, primary_and_replicas));
+      auto current_shard = current_shards.find(primary_address);
+      if (current_shard != current_shards.end() &&
+          current_shard->second->hasHosts(primary_host->second, *replicas)) {
+        shard_vector->push_back(current_shard->second);
+      } else {
+        shard_vector->emplace_back(
+            std::make_shared<RedisShard>(primary_host->second, replicas, primary_and_replicas));
+      }
     }
+    slot_shards.push_back(result.first->second);
+  }
 
-    for (auto i = slot.start(); i <= slot.end(); ++i) {
-      updated_slots->at(i) = result.first->second;
+  // The shard indexes only depend on the ranges of slots and their primaries. The current slot
+  // array, which the workers may still be reading, is kept if those are unchanged.
+  SlotArraySharedPtr updated_slots;
+  if (current_cluster_slot_ && sameSlotRanges(*current_cluster_slot_, *slots)) {
+    absl::ReaderMutexLock lock(&mutex_);
+    updated_slots = slot_array_;
+  } else {
+    auto slot_array = std::make_shared<SlotArray>();
+    for (uint64_t i = 0; i < slots->size(); ++i) {
+      const ClusterSlot& slot = (*slots)[i];
+      std::fill(slot_array->begin() + slot.start(), slot_array->begin() + slot.end() + 1,
+                slot_shards[i]);
     }
+    updated_slots = std::move(slot_array);
   }
 
   {
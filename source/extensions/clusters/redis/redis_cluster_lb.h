@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -169,6 +170,12 @@ private:
     const Upstream::HostSetImpl& replicas() const { return replicas_; }
     const Upstream::HostSetImpl& allHosts() const { return all_hosts_; }
 
+    /**
+     * @return whether the shard was built from the same primary and replica hosts.
+     */
+    bool hasHosts(const Upstream::HostConstSharedPtr& primary,
+                  const Upstream::HostVector& replicas) const;
+
   private:
     const Upstream::HostConstSharedPtr primary_;
     Upstream::HostSetImpl replicas_{0, absl::nullopt};
@@ -222,6 +229,10 @@ private:
     Random::RandomGenerator& random_;
   };
 
+  // Whether the sorted slots have the same ranges of slots assigned to the same primaries.
+  static bool sameSlotRanges(const std::vector<ClusterSlot>& lhs,
+                             const std::vector<ClusterSlot>& rhs);
+
   absl::Mutex mutex_;
   SlotArraySharedPtr slot_array_ ABSL_GUARDED_BY(mutex_);
   ClusterSlotsSharedPtr current_cluster_slot_;
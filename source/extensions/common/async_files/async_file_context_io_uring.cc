@@ -0,0 +1,223 @@
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/common/async_files/async_file_action.h"
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+#include "source/extensions/common/async_files/status_after_file_error.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+
+// The result of a request is an int32_t, so longer reads and writes go to the thread pool.
+constexpr size_t MaxRequestLength = std::numeric_limits<int32_t>::max();
+
+template <typename T>
+class AsyncFileActionIoUring : public AsyncFileActionWithResult<T>, public IoUringFileAction {
+public:
+  AsyncFileActionIoUring(AsyncFileHandle handle, std::function<void(T)> on_complete)
+      : AsyncFileActionWithResult<T>(on_complete), handle_(std::move(handle)),
+        file_descriptor_(context()->fileDescriptor()), file_index_(context()->fileIndex()) {}
+
+  // IoUringFileAction
+  void onCompletion(int32_t result) override {
+    result_ = result;
+    this->execute();
+  }
+  void abandon() override { this->cancel(); }
+
+protected:
+  AsyncFileContextIoUring* context() const {
+    return static_cast<AsyncFileContextIoUring*>(handle_.get());
+  }
+
+  // The manager looks up completions by the IoUringFileAction, which isn't the first base.
+  void* userData() { return static_cast<IoUringFileAction*>(this); }
+
+  // The kernel reports errors as negated errno values.
+  absl::Status errorStatus() const { return statusAfterFileError(-result_); }
+
+  AsyncFileHandle handle_;
+  // Copied, as close() resets the descriptor of the context while requests may be in flight.
+  const int file_descriptor_;
+  const absl::optional<unsigned> file_index_;
+  int32_t result_{0};
+};
+
+class ActionReadFile : public AsyncFileActionIoUring<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionReadFile(AsyncFileHandle handle, off_t offset, size_t length,
+                 std::shared_ptr<RegisteredBufferPool> buffers,
+                 std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : AsyncFileActionIoUring<absl::StatusOr<Buffer::InstancePtr>>(handle, on_complete),
+        offset_(offset), length_(length) {
+    if (buffers != nullptr && length <= buffers->bufferSize()) {
+      buffer_index_ = buffers->acquire();
+      if (buffer_index_.has_value()) {
+        buffers_ = std::move(buffers);
+      }
+    }
+    if (!buffer_index_.has_value()) {
+      heap_buffer_.reset(new char[length_]);
+    }
+  }
+
+  ~ActionReadFile() override {
+    if (buffer_index_.has_value()) {
+      buffers_->release(*buffer_index_);
+    }
+  }
+
+  // IoUringFileAction
+  Io::IoUringResult prepare(Io::IoUring& ring) override {
+    if (buffer_index_.has_value()) {
+      return ring.prepareReadFixed(file_index_.has_value() ? *file_index_ : file_descriptor_,
+                                   file_index_.has_value(), buffers_->data(*buffer_index_),
+                                   length_, offset_, *buffer_index_, userData());
+    }
+    iovec_ = {heap_buffer_.get(), length_};
+    return ring.prepareReadv(file_descriptor_, &iovec_, 1, offset_, userData());
+  }
+
+  absl::StatusOr<Buffer::InstancePtr> executeImpl() override {
+    if (result_ < 0) {
+      return errorStatus();
+    }
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    if (result_ == 0) {
+      return result;
+    }
+    // The memory the kernel read into is lent to the buffer rather than copied.
+    Buffer::BufferFragmentImpl* fragment;
+    if (buffer_index_.has_value()) {
+      fragment = new Buffer::BufferFragmentImpl(
+          buffers_->data(*buffer_index_), result_,
+          [buffers = buffers_, index = *buffer_index_](const void*, size_t,
+                                                       const Buffer::BufferFragmentImpl* self) {
+            buffers->release(index);
+            delete self;
+          });
+      buffer_index_.reset();
+    } else {
+      fragment = new Buffer::BufferFragmentImpl(
+          heap_buffer_.release(), result_,
+          [](const void* data, size_t, const Buffer::BufferFragmentImpl* self) {
+            delete[] static_cast<const char*>(data);
+            delete self;
+          });
+    }
+    result->addBufferFragment(*fragment);
+    return result;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+  std::shared_ptr<RegisteredBufferPool> buffers_;
+  absl::optional<int> buffer_index_;
+  std::unique_ptr<char[]> heap_buffer_;
+  struct iovec iovec_;
+};
+
+class ActionWriteFile : public AsyncFileActionIoUring<absl::StatusOr<size_t>> {
+public:
+  ActionWriteFile(AsyncFileHandle handle, Buffer::Instance& contents, off_t offset,
+                  std::function<void(absl::StatusOr<size_t>)> on_complete)
+      : AsyncFileActionIoUring<absl::StatusOr<size_t>>(handle, on_complete), offset_(offset) {
+    contents_.move(contents);
+    for (const Buffer::RawSlice& slice : contents_.getRawSlices()) {
+      iovecs_.push_back({slice.mem_, slice.len_});
+    }
+  }
+
+  // Puts the contents back, if the write is performed by the thread pool instead.
+  void restoreContents(Buffer::Instance& contents) { contents.move(contents_); }
+
+  // IoUringFileAction
+  Io::IoUringResult prepare(Io::IoUring& ring) override {
+    if (file_index_.has_value()) {
+      return ring.prepareWritevFixedFile(*file_index_, iovecs_.data(), iovecs_.size(), offset_,
+                                         userData());
+    }
+    return ring.prepareWritev(file_descriptor_, iovecs_.data(), iovecs_.size(), offset_,
+                              userData());
+  }
+
+  // A write to a regular file is only short when the disk is full, in which case the short count
+  // is reported rather than retried.
+  absl::StatusOr<size_t> executeImpl() override {
+    if (result_ < 0) {
+      return errorStatus();
+    }
+    return static_cast<size_t>(result_);
+  }
+
+private:
+  Buffer::OwnedImpl contents_;
+  std::vector<struct iovec> iovecs_;
+  const off_t offset_;
+};
+
+} // namespace
+
+AsyncFileContextIoUring::AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd)
+    : AsyncFileContextThreadPool(manager, fd), file_index_(manager.registerFile(fd)) {}
+
+AsyncFileContextIoUring::~AsyncFileContextIoUring() {
+  if (file_index_.has_value()) {
+    ioUringManager().unregisterFile(*file_index_);
+  }
+}
+
+absl::StatusOr<CancelFunction> AsyncFileContextIoUring::read(
+    off_t offset, size_t length,
+    std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  if (length <= MaxRequestLength) {
+    auto action = std::make_shared<ActionReadFile>(
+        handle(), offset, length, ioUringManager().registeredBuffers(), on_complete);
+    if (ioUringManager().submit(action)) {
+      return [action]() { action->cancel(); };
+    }
+  }
+  return AsyncFileContextThreadPool::read(offset, length, std::move(on_complete));
+}
+
+absl::StatusOr<CancelFunction>
+AsyncFileContextIoUring::write(Buffer::Instance& contents, off_t offset,
+                               std::function<void(absl::StatusOr<size_t>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  if (contents.length() <= MaxRequestLength &&
+      contents.getRawSlices().size() <= static_cast<size_t>(IOV_MAX)) {
+    auto action = std::make_shared<ActionWriteFile>(handle(), contents, offset, on_complete);
+    if (ioUringManager().submit(action)) {
+      return [action]() { action->cancel(); };
+    }
+    action->restoreContents(contents);
+  }
+  return AsyncFileContextThreadPool::write(contents, offset, std::move(on_complete));
+}
+
+AsyncFileManagerIoUring& AsyncFileContextIoUring::ioUringManager() {
+  return static_cast<AsyncFileManagerIoUring&>(manager());
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+
+#include "source/extensions/common/async_files/async_file_context_thread_pool.h"
+
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+class AsyncFileManagerIoUring;
+
+// The io_uring implementation of an AsyncFileContext - reads and writes are submitted to the
+// ring of the manager, and the other operations are performed by its thread pool.
+class AsyncFileContextIoUring : public AsyncFileContextThreadPool {
+public:
+  AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd);
+  ~AsyncFileContextIoUring() override;
+
+  absl::StatusOr<CancelFunction>
+  read(off_t offset, size_t length,
+       std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
+  absl::StatusOr<CancelFunction>
+  write(Buffer::Instance& contents, off_t offset,
+        std::function<void(absl::StatusOr<size_t>)> on_complete) override;
+
+  // The index of the file in the file table of the ring, or nullopt if it isn't registered.
+  absl::optional<unsigned> fileIndex() const { return file_index_; }
+
+private:
+  AsyncFileManagerIoUring& ioUringManager();
+
+  // Requests hold a handle to the context, so the file is unregistered only once none of them is
+  // in flight. The table holds a reference to the file until then, even after close().
+  const absl::optional<unsigned> file_index_;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -17,7 +17,7 @@ class AsyncFileManager;
 
 // The thread pool implementation of an AsyncFileContext - uses the manager thread pool and
 // old-school synchronous posix file operations.
-class AsyncFileContextThreadPool final : public AsyncFileContextBase {
+class AsyncFileContextThreadPool : public AsyncFileContextBase {
 public:
   explicit AsyncFileContextThreadPool(AsyncFileManager& manager, int fd);
 
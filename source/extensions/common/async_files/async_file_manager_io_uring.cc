@@ -0,0 +1,204 @@
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+
+#include <sys/eventfd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+constexpr uint32_t DefaultRingSize = 256;
+constexpr uint32_t DefaultRegisteredBufferSize = 64 * 1024;
+} // namespace
+
+RegisteredBufferPool::RegisteredBufferPool(uint32_t count, uint32_t size)
+    : size_(size), storage_(new char[static_cast<size_t>(count) * size]) {
+  iovecs_.reserve(count);
+  free_.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    iovecs_.push_back({data(i), size_});
+    free_.push_back(count - 1 - i);
+  }
+}
+
+absl::optional<int> RegisteredBufferPool::acquire() {
+  absl::MutexLock lock(&mutex_);
+  if (free_.empty()) {
+    return absl::nullopt;
+  }
+  const int index = free_.back();
+  free_.pop_back();
+  return index;
+}
+
+void RegisteredBufferPool::release(int index) {
+  absl::MutexLock lock(&mutex_);
+  free_.push_back(index);
+}
+
+AsyncFileManagerIoUring::AsyncFileManagerIoUring(
+    const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+    Api::OsSysCalls& posix)
+    : AsyncFileManagerThreadPool(config.id(), config.io_uring().thread_pool().thread_count(),
+                                 posix),
+      ring_size_(config.io_uring().ring_size() == 0 ? DefaultRingSize
+                                                    : config.io_uring().ring_size()) {
+  if (!Io::isIoUringSupported()) {
+    throw EnvoyException("AsyncFileManagerIoUring not supported");
+  }
+  const auto& io_uring_config = config.io_uring();
+  ring_ = std::make_unique<Io::IoUringImpl>(ring_size_, false);
+  event_fd_ = ring_->registerEventfd();
+
+  if (io_uring_config.registered_buffer_count() > 0) {
+    auto pool = std::make_shared<RegisteredBufferPool>(
+        io_uring_config.registered_buffer_count(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(io_uring_config, registered_buffer_size,
+                                        DefaultRegisteredBufferSize));
+    // Registration fails when the buffers exceed the locked memory limit, in which case reads
+    // just don't use registered buffers.
+    if (ring_->registerBuffers(pool->iovecs().data(), pool->iovecs().size()) ==
+        Io::IoUringResult::Ok) {
+      registered_buffers_ = std::move(pool);
+    } else {
+      ENVOY_LOG(warn, "AsyncFileManagerIoUring '{}' could not register its buffers", config.id());
+    }
+  }
+  if (io_uring_config.registered_file_count() > 0) {
+    // Older kernels can't register a table without files.
+    if (ring_->registerFileTable(io_uring_config.registered_file_count()) ==
+        Io::IoUringResult::Ok) {
+      absl::MutexLock lock(&submit_mutex_);
+      for (unsigned i = io_uring_config.registered_file_count(); i > 0; --i) {
+        free_file_indices_.push_back(i - 1);
+      }
+    } else {
+      ENVOY_LOG(warn, "AsyncFileManagerIoUring '{}' could not register its file table",
+                config.id());
+    }
+  }
+  ENVOY_LOG(info, "AsyncFileManagerIoUring created with id '{}', with a ring of {} entries",
+            config.id(), ring_size_);
+  completion_thread_ = std::thread([this]() { reapCompletions(); });
+}
+
+AsyncFileManagerIoUring::~AsyncFileManagerIoUring() {
+  // The thread pool may still submit requests until it stops.
+  stopThreadPool();
+  std::vector<std::shared_ptr<IoUringFileAction>> in_flight;
+  {
+    absl::MutexLock lock(&submit_mutex_);
+    terminate_ = true;
+    for (const auto& entry : in_flight_) {
+      in_flight.push_back(entry.second);
+    }
+  }
+  for (const auto& action : in_flight) {
+    action->abandon();
+  }
+  in_flight.clear();
+  // Wake the completion thread, which exits once the kernel has completed the requests in flight.
+  eventfd_write(event_fd_, 1);
+  completion_thread_.join();
+  ring_->unregisterEventfd();
+}
+
+std::string AsyncFileManagerIoUring::describe() const {
+  return absl::StrCat(AsyncFileManagerThreadPool::describe(), ", ring_size = ", ring_size_);
+}
+
+AsyncFileHandle AsyncFileManagerIoUring::newFileContext(int fd) {
+  return std::make_shared<AsyncFileContextIoUring>(*this, fd);
+}
+
+bool AsyncFileManagerIoUring::submit(std::shared_ptr<IoUringFileAction> action) {
+  absl::MutexLock lock(&submit_mutex_);
+  // The completion queue is only twice as large as the submission queue, so bound the requests
+  // in flight rather than risk losing completions.
+  if (terminate_ || in_flight_.size() >= ring_size_) {
+    return false;
+  }
+  Io::IoUringResult result = action->prepare(*ring_);
+  if (result == Io::IoUringResult::Failed) {
+    // The submission queue is full of deferred entries. Try to hand them to the kernel.
+    submitPrepared();
+    result = action->prepare(*ring_);
+  }
+  if (result == Io::IoUringResult::Failed) {
+    return false;
+  }
+  IoUringFileAction* key = action.get();
+  in_flight_.emplace(key, std::move(action));
+  submitPrepared();
+  return true;
+}
+
+void AsyncFileManagerIoUring::submitPrepared() {
+  // When the kernel is busy the entries stay in the submission queue until the next completions
+  // are reaped.
+  submit_deferred_ = ring_->submit() == Io::IoUringResult::Busy;
+}
+
+absl::optional<unsigned> AsyncFileManagerIoUring::registerFile(int fd) {
+  absl::MutexLock lock(&submit_mutex_);
+  if (free_file_indices_.empty()) {
+    return absl::nullopt;
+  }
+  const unsigned index = free_file_indices_.back();
+  if (ring_->setRegisteredFile(index, fd) != Io::IoUringResult::Ok) {
+    return absl::nullopt;
+  }
+  free_file_indices_.pop_back();
+  return index;
+}
+
+void AsyncFileManagerIoUring::unregisterFile(unsigned index) {
+  absl::MutexLock lock(&submit_mutex_);
+  // Contexts only unregister their file once no request on it is in flight, so the entry can't
+  // be reused by a request still in the submission queue.
+  ring_->setRegisteredFile(index, INVALID_SOCKET);
+  free_file_indices_.push_back(index);
+}
+
+void AsyncFileManagerIoUring::reapCompletions() {
+  while (true) {
+    // Blocks until the kernel signals completions, or until the destructor wakes the thread.
+    ring_->forEveryCompletion([this](void* user_data, int32_t result) {
+      std::shared_ptr<IoUringFileAction> action;
+      {
+        absl::MutexLock lock(&submit_mutex_);
+        auto it = in_flight_.find(static_cast<IoUringFileAction*>(user_data));
+        ASSERT(it != in_flight_.end());
+        action = std::move(it->second);
+        in_flight_.erase(it);
+      }
+      // Called without the lock, so that the callback can submit the next request.
+      action->onCompletion(result);
+    });
+    absl::MutexLock lock(&submit_mutex_);
+    if (submit_deferred_) {
+      submitPrepared();
+    }
+    if (terminate_ && in_flight_.empty()) {
+      return;
+    }
+  }
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
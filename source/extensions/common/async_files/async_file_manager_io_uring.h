@@ -0,0 +1,119 @@
+#pragma once
+
+#include <sys/uio.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/io/io_uring.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+// A read or write submitted to the ring of an AsyncFileManagerIoUring.
+class IoUringFileAction {
+public:
+  virtual ~IoUringFileAction() = default;
+
+  // Prepares the request on the ring, with this as the user data.
+  virtual Io::IoUringResult prepare(Io::IoUring& ring) PURE;
+
+  // Called on the completion thread with the result of the request.
+  virtual void onCompletion(int32_t result) PURE;
+
+  // Prevents the callback, as the manager is being destroyed.
+  virtual void abandon() PURE;
+};
+
+// Buffers registered with a ring, which reads of up to a buffer size can use. A buffer is lent to
+// the Buffer::Instance returned by the read, and returns here when the instance releases it, so
+// the pool is shared with those instances.
+class RegisteredBufferPool {
+public:
+  RegisteredBufferPool(uint32_t count, uint32_t size);
+
+  // Returns the index of a free buffer, or nullopt if they are all in use.
+  absl::optional<int> acquire() ABSL_LOCKS_EXCLUDED(mutex_);
+  void release(int index) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  char* data(int index) { return storage_.get() + static_cast<size_t>(index) * size_; }
+  uint32_t bufferSize() const { return size_; }
+  const std::vector<struct iovec>& iovecs() const { return iovecs_; }
+
+private:
+  const uint32_t size_;
+  const std::unique_ptr<char[]> storage_;
+  std::vector<struct iovec> iovecs_;
+  absl::Mutex mutex_;
+  std::vector<int> free_ ABSL_GUARDED_BY(mutex_);
+};
+
+// An AsyncFileManager which submits reads and writes to an io_uring from the thread requesting
+// them, so that they don't wait for a thread of the pool, and runs their callbacks on a single
+// completion thread. The other operations, which io_uring can't do on every supported kernel, and
+// the reads and writes the ring has no room for, are performed by the thread pool.
+//
+// Reads of up to registered_buffer_size bytes use buffers registered with the ring when one is
+// free, and open files are added to the file table of the ring when it has room, so that the
+// kernel doesn't map the buffer or look up the file for each request.
+class AsyncFileManagerIoUring : public AsyncFileManagerThreadPool {
+public:
+  AsyncFileManagerIoUring(
+      const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+      Api::OsSysCalls& posix);
+  ~AsyncFileManagerIoUring() override;
+
+  std::string describe() const override;
+  AsyncFileHandle newFileContext(int fd) override;
+
+  // Submits a read or write. Returns false if the ring has no room for it, in which case the
+  // action is dropped and the operation should be performed by the thread pool instead.
+  bool submit(std::shared_ptr<IoUringFileAction> action) ABSL_LOCKS_EXCLUDED(submit_mutex_);
+
+  // Returns nullptr if no buffers are registered.
+  const std::shared_ptr<RegisteredBufferPool>& registeredBuffers() const {
+    return registered_buffers_;
+  }
+
+  // Adds a file to the file table of the ring. Returns its index, or nullopt if the table is full.
+  absl::optional<unsigned> registerFile(int fd) ABSL_LOCKS_EXCLUDED(submit_mutex_);
+  void unregisterFile(unsigned index) ABSL_LOCKS_EXCLUDED(submit_mutex_);
+
+private:
+  void reapCompletions() ABSL_LOCKS_EXCLUDED(submit_mutex_);
+  void submitPrepared() ABSL_EXCLUSIVE_LOCKS_REQUIRED(submit_mutex_);
+
+  const uint32_t ring_size_;
+  std::unique_ptr<Io::IoUring> ring_;
+  os_fd_t event_fd_;
+  std::shared_ptr<RegisteredBufferPool> registered_buffers_;
+  std::thread completion_thread_;
+
+  absl::Mutex submit_mutex_;
+  // Actions are kept alive until the kernel reports their completion, as it may still write
+  // into their buffers.
+  absl::flat_hash_map<IoUringFileAction*, std::shared_ptr<IoUringFileAction>>
+      in_flight_ ABSL_GUARDED_BY(submit_mutex_);
+  // Entries prepared while the kernel was too busy to take them.
+  bool submit_deferred_ ABSL_GUARDED_BY(submit_mutex_) = false;
+  bool terminate_ ABSL_GUARDED_BY(submit_mutex_) = false;
+  std::vector<unsigned> free_file_indices_ ABSL_GUARDED_BY(submit_mutex_);
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
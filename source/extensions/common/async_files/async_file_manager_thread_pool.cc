@@ -29,16 +29,20 @@ thread_local bool ThreadIsWorker = false;
 AsyncFileManagerThreadPool::AsyncFileManagerThreadPool(
     const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
     Api::OsSysCalls& posix)
+    : AsyncFileManagerThreadPool(config.id(), config.thread_pool().thread_count(), posix) {}
+
+AsyncFileManagerThreadPool::AsyncFileManagerThreadPool(absl::string_view id,
+                                                       unsigned int thread_pool_size,
+                                                       Api::OsSysCalls& posix)
     : posix_(posix) {
   if (!posix.supportsAllPosixFileOperations()) {
     throw EnvoyException("AsyncFileManagerThreadPool not supported");
   }
-  unsigned int thread_pool_size = config.thread_pool().thread_count();
   if (thread_pool_size == 0) {
     thread_pool_size = std::thread::hardware_concurrency();
   }
   ENVOY_LOG(info, fmt::format("AsyncFileManagerThreadPool created with id '{}', with {} threads",
-                              config.id(), thread_pool_size));
+                              id, thread_pool_size));
   thread_pool_.reserve(thread_pool_size);
   while (thread_pool_.size() < thread_pool_size) {
     thread_pool_.emplace_back([this]() { worker(); });
@@ -46,6 +50,10 @@ AsyncFileManagerThreadPool::AsyncFileManagerThreadPool(
 }
 
 AsyncFileManagerThreadPool::~AsyncFileManagerThreadPool() ABSL_LOCKS_EXCLUDED(queue_mutex_) {
+  stopThreadPool();
+}
+
+void AsyncFileManagerThreadPool::stopThreadPool() {
   {
     absl::MutexLock lock(&queue_mutex_);
     terminate_ = true;
@@ -56,6 +64,10 @@ AsyncFileManagerThreadPool::~AsyncFileManagerThreadPool() ABSL_LOCKS_EXCLUDED(qu
   }
 }
 
+AsyncFileHandle AsyncFileManagerThreadPool::newFileContext(int fd) {
+  return std::make_shared<AsyncFileContextThreadPool>(*this, fd);
+}
+
 std::string AsyncFileManagerThreadPool::describe() const {
   return absl::StrCat("thread_pool_size = ", thread_pool_.size());
 }
@@ -139,14 +151,14 @@ public:
       if (was_successful_first_call) {
         // This was the thread doing the very first open(O_TMPFILE), and it worked, so no need to do
         // anything else.
-        return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+        return manager_.newFileContext(open_result.return_value_);
       }
       // This was any other thread, but O_TMPFILE proved it worked, so we can do it again.
       open_result = posix().open(path_.c_str(), O_TMPFILE | O_RDWR, S_IRUSR | S_IWUSR);
       if (open_result.return_value_ == -1) {
         return statusAfterFileError(open_result);
       }
-      return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+      return manager_.newFileContext(open_result.return_value_);
     }
 #endif // O_TMPFILE
     // If O_TMPFILE didn't work, fall back to creating a named file and unlinking it.
@@ -176,7 +188,7 @@ public:
           "AsyncFileManagerThreadPool::createAnonymousFile: not supported for "
           "target filesystem (failed to unlink an open file)");
     }
-    return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+    return manager_.newFileContext(open_result.return_value_);
   }
 
 private:
@@ -195,7 +207,7 @@ public:
     if (open_result.return_value_ == -1) {
       return statusAfterFileError(open_result);
     }
-    return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+    return manager_.newFileContext(open_result.return_value_);
   }
 
 private:
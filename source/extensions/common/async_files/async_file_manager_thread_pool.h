@@ -43,6 +43,9 @@ public:
   std::string describe() const override;
   Api::OsSysCalls& posix() const { return posix_; }
 
+  // Creates the context of a file opened by the thread pool.
+  virtual AsyncFileHandle newFileContext(int fd);
+
 #ifdef O_TMPFILE
   // The first time we try to open an anonymous file, these values are used to capture whether
   // opening with O_TMPFILE works. If it does not, the first open is retried using 'mkstemp',
@@ -55,6 +58,15 @@ public:
   bool supports_o_tmpfile_;
 #endif // O_TMPFILE
 
+protected:
+  // thread_pool_size defaults to the number of concurrent threads the hardware supports if 0.
+  AsyncFileManagerThreadPool(absl::string_view id, unsigned int thread_pool_size,
+                             Api::OsSysCalls& posix);
+
+  // Stops the threads, dropping the queued actions. Subclasses call this first on destruction,
+  // so that no action runs while they are partially destroyed.
+  void stopThreadPool() ABSL_LOCKS_EXCLUDED(queue_mutex_);
+
 private:
   std::function<void()> enqueue(std::shared_ptr<AsyncFileAction> action)
       ABSL_LOCKS_EXCLUDED(queue_mutex_) override;
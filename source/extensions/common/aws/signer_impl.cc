@@ -5,6 +5,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/lock_guard.h"
 #include "source/common/crypto/utility.h"
 #include "source/common/http/headers.h"
 #include "source/extensions/common/aws/utility.h"
@@ -110,17 +111,36 @@ std::string SignerImpl::createSignature(absl::string_view secret_access_key,
                                         absl::string_view short_date,
                                         absl::string_view string_to_sign,
                                         absl::string_view override_region) const {
+  auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
+  const auto signing_key = signingKey(secret_access_key, short_date,
+                                      override_region.empty() ? region_ : override_region);
+  return Hex::encode(crypto_util.getSha256Hmac(signing_key, string_to_sign));
+}
+
+std::vector<uint8_t> SignerImpl::signingKey(absl::string_view secret_access_key,
+                                            absl::string_view short_date,
+                                            absl::string_view region) const {
+  {
+    Thread::LockGuard lock(signing_key_lock_);
+    if (signing_key_cache_.short_date_ == short_date && signing_key_cache_.region_ == region &&
+        signing_key_cache_.secret_access_key_ == secret_access_key) {
+      return signing_key_cache_.signing_key_;
+    }
+  }
+
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
   const auto secret_key =
       absl::StrCat(SignatureConstants::get().SignatureVersion, secret_access_key);
   const auto date_key = crypto_util.getSha256Hmac(
       std::vector<uint8_t>(secret_key.begin(), secret_key.end()), short_date);
-  const auto region_key =
-      crypto_util.getSha256Hmac(date_key, override_region.empty() ? region_ : override_region);
+  const auto region_key = crypto_util.getSha256Hmac(date_key, region);
   const auto service_key = crypto_util.getSha256Hmac(region_key, service_name_);
-  const auto signing_key =
-      crypto_util.getSha256Hmac(service_key, SignatureConstants::get().Aws4Request);
-  return Hex::encode(crypto_util.getSha256Hmac(signing_key, string_to_sign));
+  auto signing_key = crypto_util.getSha256Hmac(service_key, SignatureConstants::get().Aws4Request);
+
+  Thread::LockGuard lock(signing_key_lock_);
+  signing_key_cache_ = {std::string(secret_access_key), std::string(short_date),
+                        std::string(region), signing_key};
+  return signing_key;
 }
 
 std::string
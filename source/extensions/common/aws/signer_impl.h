@@ -4,6 +4,7 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
+#include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/singleton/const_singleton.h"
@@ -85,6 +86,9 @@ private:
                               absl::string_view string_to_sign,
                               const absl::string_view override_region) const;
 
+  std::vector<uint8_t> signingKey(absl::string_view secret_access_key,
+                                  absl::string_view short_date, absl::string_view region) const;
+
   std::string createAuthorizationHeader(absl::string_view access_key_id,
                                         absl::string_view credential_scope,
                                         const std::map<std::string, std::string>& canonical_headers,
@@ -112,6 +116,18 @@ private:
   TimeSource& time_source_;
   DateFormatter long_date_formatter_;
   DateFormatter short_date_formatter_;
+
+  // The last derived signing key. It only depends on the secret access key, the day and the
+  // region, so all requests signed on the same day with the same credentials can reuse it instead
+  // of deriving it with four HMACs each.
+  struct SigningKeyCacheEntry {
+    std::string secret_access_key_;
+    std::string short_date_;
+    std::string region_;
+    std::vector<uint8_t> signing_key_;
+  };
+  mutable Thread::MutexBasicLockable signing_key_lock_;
+  mutable SigningKeyCacheEntry signing_key_cache_ ABSL_GUARDED_BY(signing_key_lock_);
 };
 
 } // namespace Aws
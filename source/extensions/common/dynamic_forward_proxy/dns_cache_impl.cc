@@ -89,6 +89,12 @@ DnsCacheImpl::loadDnsCacheEntry(absl::string_view host, uint16_t default_port, b
             is_proxy_lookup ? "proxy mode " : "");
   ThreadLocalHostInfo& tls_host_info = *tls_slot_;
 
+  const auto resolved_host = tls_host_info.resolved_hosts_.find(host);
+  if (resolved_host != tls_host_info.resolved_hosts_.end()) {
+    ENVOY_LOG(debug, "thread local cache hit for host '{}'", host);
+    return {LoadDnsCacheEntryStatus::InCache, nullptr, resolved_host->second};
+  }
+
   auto [is_overflow, host_info] = [&]() {
     absl::ReaderMutexLock read_lock{&primary_hosts_lock_};
     auto tls_host = primary_hosts_.find(host);
@@ -258,7 +264,7 @@ void DnsCacheImpl::onReResolve(const std::string& host) {
       host_to_erase = std::move(host_it->second);
       primary_hosts_.erase(host_it);
     }
-    notifyThreads(host, primary_host.host_info_);
+    notifyThreads(host, primary_host.host_info_, true);
   } else {
     startResolve(host, primary_host);
   }
@@ -442,8 +448,8 @@ void DnsCacheImpl::runRemoveCallbacks(const std::string& host) {
 }
 
 void DnsCacheImpl::notifyThreads(const std::string& host,
-                                 const DnsHostInfoImplSharedPtr& resolved_info) {
-  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info);
+                                 const DnsHostInfoImplSharedPtr& resolved_info, bool removed) {
+  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info, removed);
   tls_slot_.runOnAllThreads([shared_info](OptRef<ThreadLocalHostInfo> local_host_info) {
     local_host_info->onHostMapUpdate(shared_info);
   });
@@ -460,6 +466,17 @@ DnsCacheImpl::ThreadLocalHostInfo::~ThreadLocalHostInfo() {
 
 void DnsCacheImpl::ThreadLocalHostInfo::onHostMapUpdate(
     const HostMapUpdateInfoSharedPtr& resolved_host) {
+  if (resolved_host->removed_) {
+    auto resolved_it = resolved_hosts_.find(resolved_host->host_);
+    // Updates are posted in order, but only erase the entry of the removed host in case the host
+    // was added back under the same name.
+    if (resolved_it != resolved_hosts_.end() && resolved_it->second == resolved_host->info_) {
+      resolved_hosts_.erase(resolved_it);
+    }
+  } else if (resolved_host->info_->firstResolveComplete()) {
+    resolved_hosts_.insert_or_assign(resolved_host->host_, resolved_host->info_);
+  }
+
   auto host_it = pending_resolutions_.find(resolved_host->host_);
   if (host_it != pending_resolutions_.end()) {
     for (auto* resolution : host_it->second) {
@@ -82,10 +82,12 @@ private:
   using DnsHostInfoImplSharedPtr = std::shared_ptr<DnsHostInfoImpl>;
 
   struct HostMapUpdateInfo {
-    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info)
-        : host_(host), info_(std::move(info)) {}
+    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info, bool removed)
+        : host_(host), info_(std::move(info)), removed_(removed) {}
     std::string host_;
     DnsHostInfoImplSharedPtr info_;
+    // Was the host removed from the cache?
+    const bool removed_;
   };
   using HostMapUpdateInfoSharedPtr = std::shared_ptr<HostMapUpdateInfo>;
 
@@ -95,6 +97,9 @@ private:
     ~ThreadLocalHostInfo() override;
     void onHostMapUpdate(const HostMapUpdateInfoSharedPtr& resolved_info);
     absl::flat_hash_map<std::string, std::list<LoadDnsCacheEntryHandleImpl*>> pending_resolutions_;
+    // Copy of the hosts of primary_hosts_ whose first resolution is complete, so that cache hits
+    // do not contend on primary_hosts_lock_. It is updated through notifyThreads().
+    absl::flat_hash_map<std::string, DnsHostInfoSharedPtr> resolved_hosts_;
     DnsCacheImpl& parent_;
   };
 
@@ -209,7 +214,8 @@ private:
                                       const DnsHostInfoSharedPtr& host_info,
                                       Network::DnsResolver::ResolutionStatus status);
   void runRemoveCallbacks(const std::string& host);
-  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
+  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info,
+                     bool removed = false);
   void onReResolve(const std::string& host);
   void onResolveTimeout(const std::string& host);
   PrimaryHostInfo& getPrimaryHost(const std::string& host);
@@ -714,8 +714,8 @@ WasmResult Context::addHeaderMapValue(WasmHeaderMapType type, std::string_view k
   if (!map) {
     return WasmResult::BadArgument;
   }
-  const Http::LowerCaseString lower_key{std::string(key)};
-  map->addCopy(lower_key, std::string(value));
+  const Http::LowerCaseString lower_key{toAbslStringView(key)};
+  map->addCopy(lower_key, toAbslStringView(value));
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
   }
@@ -738,7 +738,7 @@ WasmResult Context::getHeaderMapValue(WasmHeaderMapType type, std::string_view k
     // Requested map type is not currently available.
     return WasmResult::BadArgument;
   }
-  const Http::LowerCaseString lower_key{std::string(key)};
+  const Http::LowerCaseString lower_key{toAbslStringView(key)};
   const auto entry = map->get(lower_key);
   if (entry.empty()) {
     if (wasm()->abiVersion() == proxy_wasm::AbiVersion::ProxyWasm_0_1_0) {
@@ -778,18 +778,10 @@ WasmResult Context::setHeaderMapPairs(WasmHeaderMapType type, const Pairs& pairs
   if (!map) {
     return WasmResult::BadArgument;
   }
-  std::vector<std::string> keys;
-  map->iterate([&keys](const Http::HeaderEntry& header) -> Http::HeaderMap::Iterate {
-    keys.push_back(std::string(header.key().getStringView()));
-    return Http::HeaderMap::Iterate::Continue;
-  });
-  for (auto& k : keys) {
-    const Http::LowerCaseString lower_key{k};
-    map->remove(lower_key);
-  }
+  map->clear();
   for (auto& p : pairs) {
-    const Http::LowerCaseString lower_key{std::string(p.first)};
-    map->addCopy(lower_key, std::string(p.second));
+    const Http::LowerCaseString lower_key{toAbslStringView(p.first)};
+    map->addCopy(lower_key, toAbslStringView(p.second));
   }
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
@@ -802,7 +794,7 @@ WasmResult Context::removeHeaderMapValue(WasmHeaderMapType type, std::string_vie
   if (!map) {
     return WasmResult::BadArgument;
   }
-  const Http::LowerCaseString lower_key{std::string(key)};
+  const Http::LowerCaseString lower_key{toAbslStringView(key)};
   map->remove(lower_key);
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
@@ -816,7 +808,7 @@ WasmResult Context::replaceHeaderMapValue(WasmHeaderMapType type, std::string_vi
   if (!map) {
     return WasmResult::BadArgument;
   }
-  const Http::LowerCaseString lower_key{std::string(key)};
+  const Http::LowerCaseString lower_key{toAbslStringView(key)};
   map->setCopy(lower_key, toAbslStringView(value));
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
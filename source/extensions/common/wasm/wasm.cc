@@ -319,8 +319,8 @@ bool createWasm(const PluginSharedPtr& plugin, const Stats::ScopeSharedPtr& scop
                 CreateWasmCallback&& cb, CreateContextFn create_root_context_for_testing) {
   auto& stats_handler = getCreateStatsHandler();
   std::string source, code;
-  auto config = plugin->wasmConfig();
-  auto vm_config = config.config().vm_config();
+  // The code of the module may be inlined in the config, so avoid copying it.
+  const auto& vm_config = plugin->wasmConfig().config().vm_config();
   bool fetch = false;
   if (vm_config.code().has_remote()) {
     // TODO(https://github.com/envoyproxy/envoy/issues/25052) Stabilize this feature.
@@ -385,13 +385,13 @@ bool createWasm(const PluginSharedPtr& plugin, const Stats::ScopeSharedPtr& scop
                                       MessageUtil::anyToBytes(vm_config.configuration()), code);
   auto complete_cb = [cb, vm_key, plugin, scope, &api, &cluster_manager, &dispatcher,
                       &lifecycle_notifier, create_root_context_for_testing,
-                      &stats_handler](std::string code) -> bool {
+                      &stats_handler](const std::string& code) -> bool {
     if (code.empty()) {
       cb(nullptr);
       return false;
     }
 
-    auto config = plugin->wasmConfig();
+    auto& config = plugin->wasmConfig();
     auto wasm = proxy_wasm::createWasm(
         vm_key, code, plugin,
         getWasmHandleFactory(config, scope, api, cluster_manager, dispatcher, lifecycle_notifier),
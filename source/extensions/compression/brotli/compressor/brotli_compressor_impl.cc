@@ -8,12 +8,25 @@ namespace Compression {
 namespace Brotli {
 namespace Compressor {
 
+PreparedDictionary::PreparedDictionary(std::string data)
+    : data_(std::move(data)),
+      prepared_(BrotliEncoderPrepareDictionary(
+          BROTLI_SHARED_DICTIONARY_RAW, data_.size(),
+          reinterpret_cast<const uint8_t*>(data_.data()), BROTLI_MAX_QUALITY, nullptr, nullptr,
+          nullptr)) {
+  RELEASE_ASSERT(prepared_ != nullptr, "unable to prepare brotli dictionary");
+}
+
+PreparedDictionary::~PreparedDictionary() { BrotliEncoderDestroyPreparedDictionary(prepared_); }
+
 BrotliCompressorImpl::BrotliCompressorImpl(const uint32_t quality, const uint32_t window_bits,
                                            const uint32_t input_block_bits,
                                            const bool disable_literal_context_modeling,
-                                           const EncoderMode mode, const uint32_t chunk_size)
-    : chunk_size_{chunk_size}, state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr),
-                                      &BrotliEncoderDestroyInstance) {
+                                           const EncoderMode mode, const uint32_t chunk_size,
+                                           PreparedDictionarySharedPtr dictionary)
+    : chunk_size_{chunk_size}, dictionary_(std::move(dictionary)),
+      state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr),
+             &BrotliEncoderDestroyInstance) {
   RELEASE_ASSERT(quality <= BROTLI_MAX_QUALITY, "");
   BROTLI_BOOL result = BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_QUALITY, quality);
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
@@ -35,6 +48,11 @@ BrotliCompressorImpl::BrotliCompressorImpl(const uint32_t quality, const uint32_
 
   result = BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_MODE, static_cast<uint32_t>(mode));
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
+
+  if (dictionary_ != nullptr) {
+    result = BrotliEncoderAttachPreparedDictionary(state_.get(), dictionary_->get());
+    RELEASE_ASSERT(result == BROTLI_TRUE, "unable to attach brotli dictionary");
+  }
 }
 
 void BrotliCompressorImpl::compress(Buffer::Instance& buffer,
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "envoy/compression/compressor/compressor.h"
 
 #include "source/extensions/compression/brotli/common/base.h"
@@ -12,6 +15,24 @@ namespace Compression {
 namespace Brotli {
 namespace Compressor {
 
+/**
+ * A raw dictionary prepared once for all the compressors of a factory, which share it read-only.
+ */
+class PreparedDictionary : NonCopyable {
+public:
+  explicit PreparedDictionary(std::string data);
+  ~PreparedDictionary();
+
+  const BrotliEncoderPreparedDictionary* get() const { return prepared_; }
+
+private:
+  // The prepared dictionary refers to the data rather than copying it.
+  const std::string data_;
+  BrotliEncoderPreparedDictionary* const prepared_;
+};
+
+using PreparedDictionarySharedPtr = std::shared_ptr<const PreparedDictionary>;
+
 /**
  * Implementation of compressor's interface.
  */
@@ -44,10 +65,13 @@ public:
    * feature. This flag is a "decoding-speed vs compression ratio" trade-off.
    * @param mode tunes encoder for specific input. @see EncoderMode enum.
    * @param chunk_size amount of memory reserved for the compressor output.
+   * @param dictionary optional dictionary the output refers to, which the decompressor must use
+   * as well.
    */
   BrotliCompressorImpl(const uint32_t quality, const uint32_t window_bits,
                        const uint32_t input_block_bits, const bool disable_literal_context_modeling,
-                       const EncoderMode mode, const uint32_t chunk_size);
+                       const EncoderMode mode, const uint32_t chunk_size,
+                       PreparedDictionarySharedPtr dictionary = nullptr);
 
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
@@ -57,6 +81,8 @@ private:
                const BrotliEncoderOperation op);
 
   const uint32_t chunk_size_;
+  // Kept alive for as long as the encoder refers to it.
+  const PreparedDictionarySharedPtr dictionary_;
   std::unique_ptr<BrotliEncoderState, decltype(&BrotliEncoderDestroyInstance)> state_;
 };
 
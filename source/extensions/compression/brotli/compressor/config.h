@@ -38,16 +38,18 @@ const std::string& brotliExtensionName() {
 class BrotliCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
   BrotliCompressorFactory(
-      const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli);
+      const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli, Api::Api& api);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createCompressorWithEffort(float effort) override;
   const std::string& statsPrefix() const override { return brotliStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Brotli;
   }
 
 private:
+  Envoy::Compression::Compressor::CompressorPtr makeCompressor(uint32_t quality);
   static BrotliCompressorImpl::EncoderMode encoderModeEnum(
       envoy::extensions::compression::brotli::compressor::v3::Brotli::EncoderMode encoder_mode);
   const uint32_t chunk_size_;
@@ -56,6 +58,7 @@ private:
   const uint32_t input_block_bits_;
   const uint32_t quality_;
   const uint32_t window_bits_;
+  PreparedDictionarySharedPtr dictionary_;
 };
 
 class BrotliCompressorLibraryFactory
@@ -1,5 +1,7 @@
 #include "source/extensions/compression/brotli/decompressor/config.h"
 
+#include "source/common/config/datasource.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -14,22 +16,28 @@ const uint32_t DefaultChunkSize = 4096;
 
 BrotliDecompressorFactory::BrotliDecompressorFactory(
     const envoy::extensions::compression::brotli::decompressor::v3::Brotli& brotli,
-    Stats::Scope& scope)
+    Stats::Scope& scope, Api::Api& api)
     : scope_(scope),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, chunk_size, DefaultChunkSize)),
-      disable_ring_buffer_reallocation_{brotli.disable_ring_buffer_reallocation()} {}
+      disable_ring_buffer_reallocation_{brotli.disable_ring_buffer_reallocation()} {
+  if (brotli.has_dictionary()) {
+    dictionary_ = std::make_shared<const std::string>(
+        Config::DataSource::read(brotli.dictionary(), false, api));
+  }
+}
 
 Envoy::Compression::Decompressor::DecompressorPtr
 BrotliDecompressorFactory::createDecompressor(const std::string& stats_prefix) {
   return std::make_unique<BrotliDecompressorImpl>(scope_, stats_prefix, chunk_size_,
-                                                  disable_ring_buffer_reallocation_);
+                                                  disable_ring_buffer_reallocation_, dictionary_);
 }
 
 Envoy::Compression::Decompressor::DecompressorFactoryPtr
 BrotliDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::brotli::decompressor::v3::Brotli& proto_config,
     Server::Configuration::FactoryContext& context) {
-  return std::make_unique<BrotliDecompressorFactory>(proto_config, context.scope());
+  return std::make_unique<BrotliDecompressorFactory>(proto_config, context.scope(),
+                                                     context.api());
 }
 
 /**
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "envoy/compression/compressor/config.h"
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/server/filter_config.h"
@@ -10,6 +13,18 @@ namespace Compression {
 namespace Common {
 namespace Compressor {
 
+/**
+ * @return the level between the cheapest and the configured compression levels of a library that
+ * corresponds to the effort. @see CompressorFactory::createCompressorWithEffort().
+ */
+inline int64_t levelForEffort(int64_t cheapest_level, int64_t configured_level, float effort) {
+  if (configured_level <= cheapest_level) {
+    return configured_level;
+  }
+  const float range = static_cast<float>(configured_level - cheapest_level);
+  return cheapest_level + std::lround(range * std::clamp(effort, 0.0f, 1.0f));
+}
+
 template <class ConfigProto>
 class CompressorLibraryFactoryBase
     : public Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory {
@@ -60,8 +60,24 @@ ZlibCompressorImpl::CompressionStrategy GzipCompressorFactory::compressionStrate
 }
 
 Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
+  return makeCompressor(compression_level_);
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+GzipCompressorFactory::createCompressorWithEffort(float effort) {
+  // The standard level of zlib is 6.
+  const int64_t configured_level =
+      compression_level_ == ZlibCompressorImpl::CompressionLevel::Standard
+          ? 6
+          : static_cast<int64_t>(compression_level_);
+  return makeCompressor(static_cast<ZlibCompressorImpl::CompressionLevel>(
+      Compression::Common::Compressor::levelForEffort(Z_BEST_SPEED, configured_level, effort)));
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+GzipCompressorFactory::makeCompressor(ZlibCompressorImpl::CompressionLevel level) {
   auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
-  compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
+  compressor->init(level, compression_strategy_, window_bits_, memory_level_);
   return compressor;
 }
 
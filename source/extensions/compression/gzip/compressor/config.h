@@ -42,12 +42,15 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createCompressorWithEffort(float effort) override;
   const std::string& statsPrefix() const override { return gzipStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Gzip;
   }
 
 private:
+  Envoy::Compression::Compressor::CompressorPtr
+  makeCompressor(ZlibCompressorImpl::CompressionLevel level);
   static ZlibCompressorImpl::CompressionLevel
   compressionLevelEnum(envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
                            compression_level);
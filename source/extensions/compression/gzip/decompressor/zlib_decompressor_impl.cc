@@ -46,10 +46,18 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
     zstream_ptr_->avail_in = input_slice.len_;
     zstream_ptr_->next_in = static_cast<Bytef*>(input_slice.mem_);
-    while (inflateNext()) {
-      if (zstream_ptr_->avail_out == 0) {
-        updateOutput(output_buffer);
-      }
+    bool more_output = true;
+    while (more_output) {
+      // Inflate straight into the output buffer rather than into the chunk and copying it from
+      // there. Each reservation is committed before the next one is made, so that inflate never
+      // writes past the output accounted for in the buffer.
+      Buffer::ReservationSingleSlice reservation = output_buffer.reserveSingleSlice(chunk_size_);
+      zstream_ptr_->next_out = static_cast<Bytef*>(reservation.slice().mem_);
+      zstream_ptr_->avail_out = reservation.slice().len_;
+      do {
+        more_output = inflateNext();
+      } while (more_output && zstream_ptr_->avail_out > 0);
+      reservation.commit(reservation.slice().len_ - zstream_ptr_->avail_out);
 
       if (Runtime::runtimeFeatureEnabled(
               "envoy.reloadable_features.enable_compression_bomb_protection") &&
@@ -63,10 +71,6 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
       }
     }
   }
-
-  // Flush z_stream and reset its buffer. Otherwise the stale content of the buffer
-  // will pollute output upon the next call to decompress().
-  updateOutput(output_buffer);
 }
 
 bool ZlibDecompressorImpl::inflateNext() {
@@ -29,6 +29,17 @@ Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompr
                                               cdict_manager_, chunk_size_);
 }
 
+Envoy::Compression::Compressor::CompressorPtr
+ZstdCompressorFactory::createCompressorWithEffort(float effort) {
+  // The level of a dictionary is fixed when it is digested.
+  if (cdict_manager_) {
+    return createCompressor();
+  }
+  return std::make_unique<ZstdCompressorImpl>(
+      Compression::Common::Compressor::levelForEffort(1, compression_level_, effort),
+      enable_checksum_, strategy_, cdict_manager_, chunk_size_);
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 ZstdCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::zstd::compressor::v3::Zstd& proto_config,
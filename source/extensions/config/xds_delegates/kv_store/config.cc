@@ -0,0 +1,43 @@
+#include "source/extensions/config/xds_delegates/kv_store/config.h"
+
+#include "envoy/common/key_value_store.h"
+#include "envoy/extensions/config/xds_delegates/kv_store/v3/kv_store.pb.h"
+#include "envoy/extensions/config/xds_delegates/kv_store/v3/kv_store.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/config/xds_delegates/kv_store/kv_store_xds_delegate.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+
+Envoy::Config::XdsResourcesDelegatePtr KeyValueStoreXdsDelegateFactory::createXdsResourcesDelegate(
+    const ProtobufWkt::Any& config, ProtobufMessage::ValidationVisitor& validation_visitor,
+    Api::Api& api, Event::Dispatcher& dispatcher) {
+  const auto& delegate_config = MessageUtil::anyConvertAndValidate<
+      envoy::extensions::config::xds_delegates::kv_store::v3::KeyValueStoreXdsDelegateConfig>(
+      config, validation_visitor);
+  const auto& store_config = delegate_config.key_value_store_config();
+  auto& store_factory =
+      Envoy::Config::Utility::getAndCheckFactory<KeyValueStoreFactory>(store_config.config());
+  return std::make_unique<KeyValueStoreXdsDelegate>(store_factory.createStore(
+      store_config, validation_visitor, dispatcher, api.fileSystem()));
+}
+
+Envoy::ProtobufTypes::MessagePtr KeyValueStoreXdsDelegateFactory::createEmptyConfigProto() {
+  return std::make_unique<
+      envoy::extensions::config::xds_delegates::kv_store::v3::KeyValueStoreXdsDelegateConfig>();
+}
+
+/**
+ * Static registration for this xDS delegate factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(KeyValueStoreXdsDelegateFactory, Envoy::Config::XdsResourcesDelegateFactory);
+
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
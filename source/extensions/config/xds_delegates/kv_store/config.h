@@ -0,0 +1,27 @@
+#pragma once
+
+#include "envoy/config/xds_resources_delegate.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+
+class KeyValueStoreXdsDelegateFactory : public Envoy::Config::XdsResourcesDelegateFactory {
+public:
+  KeyValueStoreXdsDelegateFactory() = default;
+
+  Envoy::Config::XdsResourcesDelegatePtr
+  createXdsResourcesDelegate(const ProtobufWkt::Any& config,
+                             ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api,
+                             Event::Dispatcher& dispatcher) override;
+
+  Envoy::ProtobufTypes::MessagePtr createEmptyConfigProto() override;
+
+  std::string name() const override { return "envoy.xds_delegates.kv_store"; }
+};
+
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
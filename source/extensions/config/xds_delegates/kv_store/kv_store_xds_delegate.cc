@@ -0,0 +1,104 @@
+#include "source/extensions/config/xds_delegates/kv_store/kv_store_xds_delegate.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+
+KeyValueStoreXdsDelegate::KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store)
+    : xds_config_store_(std::move(xds_config_store)) {}
+
+std::vector<envoy::service::discovery::v3::Resource> KeyValueStoreXdsDelegate::getResources(
+    const Envoy::Config::XdsSourceId& source_id,
+    const absl::flat_hash_set<std::string>& resource_names) const {
+  std::vector<std::string> names;
+  if (resource_names.empty() || (resource_names.size() == 1 &&
+                                 resource_names.contains(Envoy::Config::Wildcard))) {
+    names = storedResourceNames(source_id);
+  } else {
+    names.assign(resource_names.begin(), resource_names.end());
+  }
+
+  const std::string prefix = keyPrefix(source_id);
+  std::vector<envoy::service::discovery::v3::Resource> resources;
+  resources.reserve(names.size());
+  for (const std::string& name : names) {
+    const absl::optional<absl::string_view> value =
+        xds_config_store_->get(absl::StrCat(prefix, name));
+    if (!value.has_value()) {
+      continue;
+    }
+    envoy::service::discovery::v3::Resource resource;
+    if (!resource.ParseFromArray(value->data(), value->size())) {
+      ENVOY_LOG(warn, "Unable to parse the stored xDS resource {} of {}", name, source_id.toKey());
+      continue;
+    }
+    resources.push_back(std::move(resource));
+  }
+  return resources;
+}
+
+void KeyValueStoreXdsDelegate::onConfigUpdated(
+    const Envoy::Config::XdsSourceId& source_id,
+    const std::vector<Envoy::Config::DecodedResourceRef>& resources) {
+  const std::string prefix = keyPrefix(source_id);
+  absl::flat_hash_set<std::string> updated_names;
+  for (const auto& resource_ref : resources) {
+    const auto& decoded_resource = resource_ref.get();
+    if (!decoded_resource.hasResource()) {
+      continue;
+    }
+    envoy::service::discovery::v3::Resource resource;
+    resource.set_name(decoded_resource.name());
+    resource.set_version(decoded_resource.version());
+    resource.mutable_resource()->PackFrom(decoded_resource.resource());
+    xds_config_store_->addOrUpdate(absl::StrCat(prefix, decoded_resource.name()),
+                                   resource.SerializeAsString(), absl::nullopt);
+    updated_names.insert(decoded_resource.name());
+  }
+
+  // A state of the world update carries all the resources of the source, so the stored resources
+  // which are not in it were removed.
+  for (const std::string& name : storedResourceNames(source_id)) {
+    if (!updated_names.contains(name)) {
+      xds_config_store_->remove(absl::StrCat(prefix, name));
+    }
+  }
+}
+
+void KeyValueStoreXdsDelegate::onResourceLoadFailed(
+    const Envoy::Config::XdsSourceId& source_id, const std::string& resource_name,
+    const absl::optional<EnvoyException>& exception) {
+  ENVOY_LOG(warn, "Failed to load the stored xDS resource {} of {}: {}", resource_name,
+            source_id.toKey(), exception.has_value() ? exception->what() : "");
+  // The stored resource is invalid, so there is no use in loading it again.
+  xds_config_store_->remove(absl::StrCat(keyPrefix(source_id), resource_name));
+}
+
+std::string KeyValueStoreXdsDelegate::keyPrefix(const Envoy::Config::XdsSourceId& source_id) {
+  return absl::StrCat(source_id.toKey(), "+");
+}
+
+std::vector<std::string>
+KeyValueStoreXdsDelegate::storedResourceNames(const Envoy::Config::XdsSourceId& source_id) const {
+  const std::string prefix = keyPrefix(source_id);
+  std::vector<std::string> names;
+  xds_config_store_->iterate([&prefix, &names](const std::string& key, const std::string&) {
+    if (absl::StartsWith(key, prefix)) {
+      names.push_back(key.substr(prefix.size()));
+    }
+    return KeyValueStore::Iterate::Continue;
+  });
+  return names;
+}
+
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
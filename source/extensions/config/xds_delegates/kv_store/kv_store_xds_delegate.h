@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "envoy/common/key_value_store.h"
+#include "envoy/config/xds_resources_delegate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+
+/**
+ * An XdsResourcesDelegate which saves the last accepted resources of each xDS source in a key value
+ * store. Each resource is kept under the key of its source and its name, as a serialized
+ * envoy::service::discovery::v3::Resource carrying its version.
+ */
+class KeyValueStoreXdsDelegate : public Envoy::Config::XdsResourcesDelegate,
+                                 public Logger::Loggable<Logger::Id::config> {
+public:
+  explicit KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store);
+
+  // Config::XdsResourcesDelegate
+  std::vector<envoy::service::discovery::v3::Resource>
+  getResources(const Envoy::Config::XdsSourceId& source_id,
+               const absl::flat_hash_set<std::string>& resource_names) const override;
+  void onConfigUpdated(const Envoy::Config::XdsSourceId& source_id,
+                       const std::vector<Envoy::Config::DecodedResourceRef>& resources) override;
+  void onResourceLoadFailed(const Envoy::Config::XdsSourceId& source_id,
+                            const std::string& resource_name,
+                            const absl::optional<EnvoyException>& exception) override;
+
+private:
+  static std::string keyPrefix(const Envoy::Config::XdsSourceId& source_id);
+
+  // @return the names of the resources of the source which are in the store.
+  std::vector<std::string> storedResourceNames(const Envoy::Config::XdsSourceId& source_id) const;
+
+  KeyValueStorePtr xds_config_store_;
+};
+
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
@@ -5,6 +5,7 @@ EXTENSIONS = {
     #
 
     "envoy.access_loggers.file":                        "//source/extensions/access_loggers/file:config",
+    "envoy.access_loggers.extension_filters.adaptive_sampling": "//source/extensions/access_loggers/filters/adaptive_sampling:config",
     "envoy.access_loggers.extension_filters.cel":       "//source/extensions/access_loggers/filters/cel:config",
     "envoy.access_loggers.http_grpc":                   "//source/extensions/access_loggers/grpc:http_config",
     "envoy.access_loggers.tcp_grpc":                    "//source/extensions/access_loggers/grpc:tcp_config",
@@ -43,6 +44,12 @@ EXTENSIONS = {
 
     "envoy.config.validators.minimum_clusters_validator":     "//source/extensions/config/validators/minimum_clusters:config",
 
+    #
+    # xDS delegates
+    #
+
+    "envoy.xds_delegates.kv_store":                     "//source/extensions/config/xds_delegates/kv_store:config",
+
     #
     # gRPC Credentials Plugins
     #
@@ -182,6 +189,7 @@ EXTENSIONS = {
     "envoy.resource_monitors.fixed_heap":               "//source/extensions/resource_monitors/fixed_heap:config",
     "envoy.resource_monitors.injected_resource":        "//source/extensions/resource_monitors/injected_resource:config",
     "envoy.resource_monitors.downstream_connections":   "//source/extensions/resource_monitors/downstream_connections:config",
+    "envoy.resource_monitors.cpu_utilization":          "//source/extensions/resource_monitors/cpu_utilization:config",
 
     #
     # Stat sinks
@@ -246,7 +254,9 @@ EXTENSIONS = {
     # CacheFilter plugins
     #
     "envoy.extensions.http.cache.file_system_http_cache": "//source/extensions/http/cache/file_system_http_cache:config",
+    "envoy.extensions.http.cache.in_memory":            "//source/extensions/http/cache/in_memory_http_cache:config",
     "envoy.extensions.http.cache.simple":               "//source/extensions/http/cache/simple_http_cache:config",
+    "envoy.extensions.http.cache.tiered":               "//source/extensions/http/cache/tiered_http_cache:config",
 
     #
     # Internal redirect predicates
@@ -267,6 +277,7 @@ EXTENSIONS = {
     # Watchdog actions
     #
 
+    "envoy.watchdog.backtrace_action":                  "//source/extensions/watchdog/backtrace_action:config",
     "envoy.watchdog.profile_action":                    "//source/extensions/watchdog/profile_action:config",
 
     #
@@ -298,6 +309,12 @@ EXTENSIONS = {
 
     "envoy.tls.cert_validator.spiffe":                  "//source/extensions/transport_sockets/tls/cert_validator/spiffe:config",
 
+    #
+    # TLS private key providers
+    #
+
+    "envoy.tls.key_providers.thread_pool":              "//source/extensions/private_key_providers/thread_pool:config",
+
     #
     # HTTP header formatters
     #
@@ -397,6 +414,8 @@ EXTENSIONS = {
     #
     "envoy.load_balancing_policies.least_request":     "//source/extensions/load_balancing_policies/least_request:config",
     "envoy.load_balancing_policies.random":            "//source/extensions/load_balancing_policies/random:config",
+    "envoy.load_balancing_policies.peak_ewma":         "//source/extensions/load_balancing_policies/peak_ewma:config",
+    "envoy.load_balancing_policies.client_side_weighted_round_robin": "//source/extensions/load_balancing_policies/client_side_weighted_round_robin:config",
     "envoy.load_balancing_policies.round_robin":       "//source/extensions/load_balancing_policies/round_robin:config",
     "envoy.load_balancing_policies.maglev":            "//source/extensions/load_balancing_policies/maglev:config",
     "envoy.load_balancing_policies.ring_hash":       "//source/extensions/load_balancing_policies/ring_hash:config",
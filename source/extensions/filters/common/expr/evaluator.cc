@@ -21,6 +21,11 @@ namespace {
 enum class ActivationToken { ACTIVATION_TOKENS(_DECLARE) };
 #undef _DECLARE
 
+#define _COUNT(_t) +1
+static_assert(0 ACTIVATION_TOKENS(_COUNT) == StreamActivation::Attributes,
+              "StreamActivation::Attributes is the number of activation tokens");
+#undef _COUNT
+
 using ActivationLookupTable = absl::flat_hash_map<absl::string_view, ActivationToken>;
 
 #define _PAIR(_t) {_t, ActivationToken::_t},
@@ -36,13 +41,26 @@ absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
   if (activation_info_ == nullptr) {
     return {};
   }
-  const StreamInfo::StreamInfo& info = *activation_info_;
   const auto& tokens = getActivationTokens();
   const auto token = tokens.find(name);
   if (token == tokens.end()) {
     return {};
   }
-  switch (token->second) {
+  if (arena != resolved_arena_) {
+    resolved_attributes_.fill(absl::nullopt);
+    resolved_arena_ = arena;
+  }
+  const size_t attribute = static_cast<size_t>(token->second);
+  if (!resolved_attributes_[attribute].has_value()) {
+    resolved_attributes_[attribute] = resolveValue(attribute, arena);
+  }
+  return resolved_attributes_[attribute];
+}
+
+absl::optional<CelValue> StreamActivation::resolveValue(size_t attribute,
+                                                        Protobuf::Arena* arena) const {
+  const StreamInfo::StreamInfo& info = *activation_info_;
+  switch (static_cast<ActivationToken>(attribute)) {
   case ActivationToken::Request:
     return CelValue::CreateMap(
         Protobuf::Arena::Create<RequestWrapper>(arena, *arena, activation_request_headers_, info));
@@ -73,6 +91,8 @@ void StreamActivation::resetActivation() const {
   activation_request_headers_ = nullptr;
   activation_response_headers_ = nullptr;
   activation_response_trailers_ = nullptr;
+  resolved_arena_ = nullptr;
+  resolved_attributes_.fill(absl::nullopt);
 }
 
 ActivationPtr createActivation(const StreamInfo::StreamInfo& info,
@@ -145,6 +165,24 @@ bool matches(const Expression& expr, const StreamInfo::StreamInfo& info,
   return result.IsBool() ? result.BoolOrDie() : false;
 }
 
+absl::optional<CelValue> EvaluationContext::evaluate(const Expression& expr) {
+  auto eval_status = expr.Evaluate(activation_, &arena_);
+  if (!eval_status.ok()) {
+    return {};
+  }
+
+  return eval_status.value();
+}
+
+bool EvaluationContext::matches(const Expression& expr) {
+  auto eval_status = evaluate(expr);
+  if (!eval_status.has_value()) {
+    return false;
+  }
+  auto result = eval_status.value();
+  return result.IsBool() ? result.BoolOrDie() : false;
+}
+
 std::string print(CelValue value) {
   switch (value.type()) {
   case CelValue::Type::kBool:
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "envoy/stream_info/stream_info.h"
 
 #include "source/common/http/headers.h"
@@ -42,12 +44,24 @@ public:
     return {};
   }
 
+  // The number of top level attributes.
+  static constexpr size_t Attributes = 9;
+
 protected:
   void resetActivation() const;
   mutable const StreamInfo::StreamInfo* activation_info_{nullptr};
   mutable const Http::RequestHeaderMap* activation_request_headers_{nullptr};
   mutable const Http::ResponseHeaderMap* activation_response_headers_{nullptr};
   mutable const Http::ResponseTrailerMap* activation_response_trailers_{nullptr};
+
+private:
+  absl::optional<CelValue> resolveValue(size_t attribute, Protobuf::Arena* arena) const;
+
+  // The top level attributes already resolved, which are allocated in the arena they were
+  // resolved with. An attribute referenced more than once, by an expression or by expressions
+  // evaluated with the same activation and arena, is only resolved once.
+  mutable const Protobuf::Arena* resolved_arena_{nullptr};
+  mutable std::array<absl::optional<CelValue>, Attributes> resolved_attributes_;
 };
 
 // Creates an activation providing the common context attributes.
@@ -79,6 +93,28 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
 bool matches(const Expression& expr, const StreamInfo::StreamInfo& info,
              const Http::RequestHeaderMap& headers);
 
+// The context of the evaluations of expressions for a request. The expressions evaluated with the
+// same context share the attributes resolved by each other, and the arena holding them.
+class EvaluationContext {
+public:
+  EvaluationContext(const StreamInfo::StreamInfo& info,
+                    const Http::RequestHeaderMap* request_headers,
+                    const Http::ResponseHeaderMap* response_headers,
+                    const Http::ResponseTrailerMap* response_trailers)
+      : activation_(info, request_headers, response_headers, response_trailers) {}
+
+  // Evaluates an expression. The value is held by the arena of the context.
+  absl::optional<CelValue> evaluate(const Expression& expr);
+
+  // Evaluates an expression and returns true if the expression evaluates to "true".
+  // Returns false if the expression fails to evaluate.
+  bool matches(const Expression& expr);
+
+private:
+  Protobuf::Arena arena_;
+  const StreamActivation activation_;
+};
+
 // Returns a string for a CelValue.
 std::string print(CelValue value);
 
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
 
 #include <chrono>
+#include <thread>
 
 #include "envoy/runtime/runtime.h"
 
@@ -17,11 +18,12 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     const std::chrono::milliseconds fill_interval, const uint32_t max_tokens,
     const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
     const Protobuf::RepeatedPtrField<
-        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors)
+        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
+    const uint32_t token_batch_size)
     : fill_timer_(fill_interval > std::chrono::milliseconds(0)
                       ? dispatcher.createTimer([this] { onFillTimer(); })
                       : nullptr),
-      time_source_(dispatcher.timeSource()) {
+      time_source_(dispatcher.timeSource()), token_batch_size_(token_batch_size) {
   if (fill_timer_ && fill_interval < std::chrono::milliseconds(50)) {
     throw EnvoyException("local rate limit token bucket fill timer must be >= 50ms");
   }
@@ -29,8 +31,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
   token_bucket_.max_tokens_ = max_tokens;
   token_bucket_.tokens_per_fill_ = tokens_per_fill;
   token_bucket_.fill_interval_ = absl::FromChrono(fill_interval);
-  tokens_.tokens_ = max_tokens;
-  tokens_.fill_time_ = time_source_.monotonicTime();
+  initializeTokenState(tokens_, max_tokens);
 
   if (fill_timer_) {
     fill_timer_->enableTimer(fill_interval);
@@ -58,8 +59,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     new_descriptor.token_bucket_ = per_descriptor_token_bucket;
 
     auto token_state = std::make_shared<TokenState>();
-    token_state->tokens_ = per_descriptor_token_bucket.max_tokens_;
-    token_state->fill_time_ = time_source_.monotonicTime();
+    initializeTokenState(*token_state, per_descriptor_token_bucket.max_tokens_);
     new_descriptor.token_state_ = token_state;
 
     auto result = descriptors_.emplace(new_descriptor);
@@ -89,6 +89,14 @@ LocalRateLimiterImpl::~LocalRateLimiterImpl() {
   }
 }
 
+void LocalRateLimiterImpl::initializeTokenState(TokenState& tokens, uint32_t max_tokens) {
+  tokens.tokens_ = max_tokens;
+  tokens.fill_time_ = time_source_.monotonicTime();
+  if (token_batch_size_ > 1) {
+    tokens.reservoirs_ = std::make_unique<TokenReservoir[]>(TokenReservoirs);
+  }
+}
+
 void LocalRateLimiterImpl::onFillTimer() {
   // Since descriptors tokens are refilled whenever the remainder of dividing refill_counter_
   // by descriptor.multiplier_ is zero and refill_counter_ is initialized to zero, it must be
@@ -105,11 +113,22 @@ void LocalRateLimiterImpl::onFillTimerHelper(TokenState& tokens,
                                              const RateLimit::TokenBucket& bucket) {
   // Relaxed consistency is used for all operations because we don't care about ordering, just the
   // final atomic correctness.
+
+  // The tokens left in the reservoirs are returned to the bucket, so that the tokens taken in
+  // batches are unavailable to the other threads for at most a fill interval.
+  uint32_t reserved_tokens = 0;
+  if (tokens.reservoirs_ != nullptr) {
+    for (size_t i = 0; i < TokenReservoirs; ++i) {
+      reserved_tokens += tokens.reservoirs_[i].tokens_.exchange(0, std::memory_order_relaxed);
+    }
+  }
   uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
   uint32_t new_tokens_value;
   do {
     // expected_tokens is either initialized above or reloaded during the CAS failure below.
-    new_tokens_value = std::min(bucket.max_tokens_, expected_tokens + bucket.tokens_per_fill_);
+    new_tokens_value = static_cast<uint32_t>(
+        std::min<uint64_t>(bucket.max_tokens_, static_cast<uint64_t>(expected_tokens) +
+                                                   reserved_tokens + bucket.tokens_per_fill_));
 
     // Testing hook.
     synchronizer_.syncPoint("on_fill_timer_pre_cas");
@@ -135,6 +154,10 @@ void LocalRateLimiterImpl::onFillTimerDescriptorHelper() {
 }
 
 bool LocalRateLimiterImpl::requestAllowedHelper(const TokenState& tokens) const {
+  if (tokens.reservoirs_ != nullptr) {
+    return requestAllowedBatchHelper(tokens);
+  }
+
   // Relaxed consistency is used for all operations because we don't care about ordering, just the
   // final atomic correctness.
   uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
@@ -155,6 +178,45 @@ bool LocalRateLimiterImpl::requestAllowedHelper(const TokenState& tokens) const
   return true;
 }
 
+bool LocalRateLimiterImpl::requestAllowedBatchHelper(const TokenState& tokens) const {
+  // A thread consistently uses the same reservoir, so the tokens it takes from the bucket are
+  // mostly consumed by itself.
+  const TokenReservoir& reservoir =
+      tokens.reservoirs_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                         TokenReservoirs];
+
+  // Relaxed consistency is used for all operations because we don't care about ordering, just the
+  // final atomic correctness.
+  uint32_t reserved_tokens = reservoir.tokens_.load(std::memory_order_relaxed);
+  while (reserved_tokens > 0) {
+    if (reservoir.tokens_.compare_exchange_weak(reserved_tokens, reserved_tokens - 1,
+                                                std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+
+  // The reservoir is empty, so take a batch of tokens from the bucket: one for this request and
+  // the others for the next requests using the reservoir.
+  uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
+  uint32_t batch;
+  do {
+    if (expected_tokens == 0) {
+      return false;
+    }
+    batch = std::min(expected_tokens, token_batch_size_);
+
+    // Testing hook.
+    synchronizer_.syncPoint("allowed_pre_cas");
+
+  } while (!tokens.tokens_.compare_exchange_weak(expected_tokens, expected_tokens - batch,
+                                                 std::memory_order_relaxed));
+
+  if (batch > 1) {
+    reservoir.tokens_.fetch_add(batch - 1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
 OptRef<const LocalRateLimiterImpl::LocalDescriptorImpl> LocalRateLimiterImpl::descriptorHelper(
     absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const {
   if (!descriptors_.empty() && !request_descriptors.empty()) {
@@ -211,9 +273,18 @@ uint32_t LocalRateLimiterImpl::remainingTokens(
     absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const {
   auto descriptor = descriptorHelper(request_descriptors);
 
-  return descriptor.has_value()
-             ? descriptor.value().get().token_state_->tokens_.load(std::memory_order_relaxed)
-             : tokens_.tokens_.load(std::memory_order_relaxed);
+  return remainingTokensHelper(descriptor.has_value() ? *descriptor.value().get().token_state_
+                                                      : tokens_);
+}
+
+uint32_t LocalRateLimiterImpl::remainingTokensHelper(const TokenState& tokens) const {
+  uint32_t remaining_tokens = tokens.tokens_.load(std::memory_order_relaxed);
+  if (tokens.reservoirs_ != nullptr) {
+    for (size_t i = 0; i < TokenReservoirs; ++i) {
+      remaining_tokens += tokens.reservoirs_[i].tokens_.load(std::memory_order_relaxed);
+    }
+  }
+  return remaining_tokens;
 }
 
 int64_t LocalRateLimiterImpl::remainingFillInterval(
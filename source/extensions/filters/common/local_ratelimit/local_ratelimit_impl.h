@@ -22,7 +22,8 @@ public:
       const std::chrono::milliseconds fill_interval, const uint32_t max_tokens,
       const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
       const Protobuf::RepeatedPtrField<
-          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors);
+          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
+      const uint32_t token_batch_size = 0);
   ~LocalRateLimiterImpl();
 
   bool requestAllowed(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
@@ -31,10 +32,22 @@ public:
   int64_t
   remainingFillInterval(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
 
+  // The number of reservoirs of the buckets taking tokens in batches. The threads are spread
+  // over the reservoirs, so that the threads of different workers rarely share one.
+  static constexpr size_t TokenReservoirs = 32;
+
 private:
+  // Tokens taken from a bucket by the threads using the reservoir, which they consume without
+  // touching the bucket. Each reservoir has its own cache line, so that the threads of
+  // different reservoirs don't contend.
+  struct alignas(64) TokenReservoir {
+    mutable std::atomic<uint32_t> tokens_{0};
+  };
   struct TokenState {
     mutable std::atomic<uint32_t> tokens_;
     MonotonicTime fill_time_;
+    // Only set when the tokens are taken in batches.
+    std::unique_ptr<TokenReservoir[]> reservoirs_;
   };
   // Refill counter is incremented per each refill timer hit.
   uint64_t refill_counter_{0};
@@ -75,11 +88,16 @@ private:
   OptRef<const LocalDescriptorImpl>
   descriptorHelper(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
   bool requestAllowedHelper(const TokenState& tokens) const;
+  bool requestAllowedBatchHelper(const TokenState& tokens) const;
+  uint32_t remainingTokensHelper(const TokenState& tokens) const;
+  void initializeTokenState(TokenState& tokens, uint32_t max_tokens);
   int tokensFillPerSecond(LocalDescriptorImpl& descriptor);
 
   RateLimit::TokenBucket token_bucket_;
   const Event::TimerPtr fill_timer_;
   TimeSource& time_source_;
+  // Tokens are taken from the buckets in batches of up to this many tokens if greater than 1.
+  const uint32_t token_batch_size_;
   TokenState tokens_;
   absl::flat_hash_set<LocalDescriptorImpl, LocalDescriptorHash, LocalDescriptorEqual> descriptors_;
   std::vector<LocalDescriptorImpl> sorted_descriptors_;
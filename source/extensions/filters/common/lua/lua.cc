@@ -1,5 +1,6 @@
 #include "source/extensions/filters/common/lua/lua.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/common/exception.h"
@@ -14,8 +15,18 @@ namespace Filters {
 namespace Common {
 namespace Lua {
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     CoroutinePool* pool)
+    : coroutine_state_(new_thread_state, false), pool_(pool) {}
+
+Coroutine::~Coroutine() {
+  // A yielded coroutine can't be unwound, and a failed one can't be resumed anymore.
+  if (pool_ != nullptr && state_ != State::Yielded && !failed_) {
+    lua_settop(coroutine_state_.get(), 0);
+    coroutine_state_.pushStack();
+    pool_->release(coroutine_state_.get());
+  }
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -43,6 +54,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
     yield_callback();
   } else {
     state_ = State::Finished;
+    failed_ = true;
     const char* error = lua_tostring(coroutine_state_.get(), -1);
     if (!error) {
       error = "unspecified lua error";
@@ -51,7 +63,44 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
   }
 }
 
-ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
+CoroutinePool::CoroutinePool(lua_State* state, uint32_t max_idle)
+    : state_(state), max_idle_(max_idle) {}
+
+CoroutinePool::~CoroutinePool() {
+  for (int ref : idle_) {
+    luaL_unref(state_, LUA_REGISTRYINDEX, ref);
+  }
+}
+
+CoroutinePtr CoroutinePool::create() {
+  if (idle_.empty()) {
+    return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state_), state_), this);
+  }
+  const int ref = idle_.back();
+  idle_.pop_back();
+  lua_rawgeti(state_, LUA_REGISTRYINDEX, ref);
+  luaL_unref(state_, LUA_REGISTRYINDEX, ref);
+  return std::make_unique<Coroutine>(std::make_pair(lua_tothread(state_, -1), state_), this);
+}
+
+void CoroutinePool::prewarm(uint32_t threads) {
+  while (idle_.size() < std::min(threads, max_idle_)) {
+    lua_newthread(state_);
+    release(lua_tothread(state_, -1));
+  }
+}
+
+void CoroutinePool::release(lua_State* thread) {
+  ASSERT(lua_tothread(state_, -1) == thread);
+  if (idle_.size() < max_idle_) {
+    idle_.push_back(luaL_ref(state_, LUA_REGISTRYINDEX));
+  } else {
+    lua_pop(state_, 1);
+  }
+}
+
+ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls,
+                                   uint32_t max_idle_coroutines)
     : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)) {
 
   // First verify that the supplied code can be parsed.
@@ -64,7 +113,9 @@ ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAll
   }
 
   // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(code); });
+  tls_slot_->set([code, max_idle_coroutines](Event::Dispatcher&) {
+    return std::make_shared<LuaThreadLocal>(code, max_idle_coroutines);
+  });
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -92,18 +143,17 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
   return current_global_slot_++;
 }
 
-CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tlsState().get();
-  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
-}
+CoroutinePtr ThreadLocalState::createCoroutine() { return (*tls_slot_)->coroutines_.create(); }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
-    : state_(luaL_newstate()) {
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code,
+                                                 uint32_t max_idle_coroutines)
+    : state_(luaL_newstate()), coroutines_(state_.get(), max_idle_coroutines) {
 
   RELEASE_ASSERT(state_.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state_.get());
   int rc = luaL_dostring(state_.get(), code.c_str());
   ASSERT(rc == 0);
+  coroutines_.prewarm(PrewarmedCoroutines);
 }
 
 } // namespace Lua
@@ -343,6 +343,8 @@ public:
   }
 };
 
+class CoroutinePool;
+
 /**
  * This is a wrapper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -351,7 +353,14 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param new_thread_state supplies the Lua thread of the coroutine, which must be at the top of
+   *        the stack of its parent state, and the parent state.
+   * @param pool supplies the pool the Lua thread is returned to on destruction, if any.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            CoroutinePool* pool = nullptr);
+  ~Coroutine();
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
@@ -376,9 +385,54 @@ public:
 private:
   LuaRef<lua_State> coroutine_state_;
   State state_{State::NotStarted};
+  CoroutinePool* const pool_;
+  // Whether the coroutine raised an error, in which case its Lua thread can't be reused.
+  bool failed_{};
 };
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
+
+/**
+ * A pool of the Lua threads of coroutines which didn't yield when destroyed. Lua threads which
+ * finished or never started can run another function, so reusing them saves creating and then
+ * garbage collecting a Lua thread per coroutine.
+ */
+class CoroutinePool {
+public:
+  /**
+   * @param state supplies the state the Lua threads are created in.
+   * @param max_idle supplies the maximum number of idle Lua threads kept in the pool.
+   */
+  CoroutinePool(lua_State* state, uint32_t max_idle);
+  ~CoroutinePool();
+
+  /**
+   * @return CoroutinePtr a coroutine running on an idle Lua thread of the pool, or on a new Lua
+   *         thread if there is none.
+   */
+  CoroutinePtr create();
+
+  /**
+   * Creates idle Lua threads, up to the maximum number of idle threads.
+   */
+  void prewarm(uint32_t threads);
+
+  /**
+   * @return the number of idle Lua threads.
+   */
+  size_t idle() const { return idle_.size(); }
+
+private:
+  friend class Coroutine;
+
+  // Keeps the Lua thread of a coroutine, which must be at the top of the stack of the state.
+  void release(lua_State* thread);
+
+  lua_State* const state_;
+  const uint32_t max_idle_;
+  // The registry references of the idle Lua threads.
+  std::vector<int> idle_;
+};
 using Initializer = std::function<void(lua_State*)>;
 using InitializerList = std::vector<Initializer>;
 
@@ -389,7 +443,19 @@ using InitializerList = std::vector<Initializer>;
  */
 class ThreadLocalState : Logger::Loggable<Logger::Id::lua> {
 public:
-  ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
+  // The number of idle coroutines kept by each worker.
+  static constexpr uint32_t DefaultMaxIdleCoroutines = 64;
+  // The number of idle coroutines each worker starts with.
+  static constexpr uint32_t PrewarmedCoroutines = 8;
+
+  /**
+   * @param code supplies the script run by each worker.
+   * @param tls supplies the slot allocator of the worker states.
+   * @param max_idle_coroutines supplies the maximum number of idle coroutines kept by each worker
+   *        for reuse. 0 disables the reuse of coroutines.
+   */
+  ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls,
+                   uint32_t max_idle_coroutines = DefaultMaxIdleCoroutines);
 
   /**
    * @return CoroutinePtr a new coroutine.
@@ -436,10 +502,12 @@ public:
 
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& code, uint32_t max_idle_coroutines);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Destroyed before the state.
+    CoroutinePool coroutines_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
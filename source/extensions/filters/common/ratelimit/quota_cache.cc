@@ -0,0 +1,93 @@
+#include "source/extensions/filters/common/ratelimit/quota_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RateLimit {
+namespace {
+
+// Appends a value prefixed by its length, so that different descriptor sets never produce the
+// same key.
+void appendValue(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+QuotaCache::QuotaCache(uint32_t max_entries, ThreadLocal::SlotAllocator& tls,
+                       TimeSource& time_source)
+    : time_source_(time_source), tls_(tls) {
+  tls_.set([max_entries](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalQuotas>(max_entries);
+  });
+}
+
+std::string QuotaCache::key(const std::string& domain,
+                            const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  std::string key;
+  appendValue(key, domain);
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    absl::StrAppend(&key, descriptor.entries_.size(), ";");
+    for (const Envoy::RateLimit::DescriptorEntry& entry : descriptor.entries_) {
+      appendValue(key, entry.key_);
+      appendValue(key, entry.value_);
+    }
+    // The quota of a descriptor set applies to the limits sent with it.
+    if (descriptor.limit_.has_value()) {
+      absl::StrAppend(&key, descriptor.limit_->requests_per_unit_, "/",
+                      static_cast<int>(descriptor.limit_->unit_));
+    }
+    key.push_back(';');
+  }
+  return key;
+}
+
+absl::optional<LimitStatus> QuotaCache::consume(const std::string& key) {
+  LruCache& quotas = tls_->quotas_;
+  LruCache::ScopedLookup lookup(&quotas, key);
+  if (!lookup.found()) {
+    return absl::nullopt;
+  }
+  CachedQuota& quota = *lookup.value();
+  if (quota.valid_until_ <= time_source_.monotonicTime()) {
+    quotas.remove(key);
+    return absl::nullopt;
+  }
+  if (quota.requests_ == 0) {
+    return LimitStatus::OverLimit;
+  }
+  quota.requests_--;
+  return LimitStatus::OK;
+}
+
+void QuotaCache::insert(const std::string& key,
+                        const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) {
+  LruCache& quotas = tls_->quotas_;
+  quotas.remove(key);
+  if (!quota.has_valid_until()) {
+    return;
+  }
+  // The expiration is a point in wall clock time, which is converted to monotonic time so that
+  // clock adjustments don't extend the quota.
+  const SystemTime valid_until{std::chrono::milliseconds(
+      Protobuf::util::TimeUtil::TimestampToMilliseconds(quota.valid_until()))};
+  const SystemTime now = time_source_.systemTime();
+  if (valid_until <= now || quota.requests() == 0) {
+    return;
+  }
+  const MonotonicTime monotonic_valid_until =
+      time_source_.monotonicTime() +
+      std::chrono::duration_cast<MonotonicTime::duration>(valid_until - now);
+  quotas.insert(key, new CachedQuota{quota.requests() - 1, monotonic_valid_until}, 1);
+}
+
+} // namespace RateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/service/ratelimit/v3/rls.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/common/ratelimit/ratelimit.h"
+
+#include "absl/types/optional.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RateLimit {
+
+/**
+ * Caches the quotas the rate limit service grants to descriptor sets, in a cache per worker
+ * thread. Requests whose descriptor set has a cached quota are admitted by consuming a unit of
+ * the quota, without querying the rate limit service, until the quota runs out or expires.
+ * @see envoy::service::ratelimit::v3::RateLimitResponse::quota.
+ */
+class QuotaCache {
+public:
+  QuotaCache(uint32_t max_entries, ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the key of the quotas of a descriptor set.
+   */
+  static std::string key(const std::string& domain,
+                         const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
+
+  /**
+   * Consumes a unit of the quota cached for the key. Must be called on a worker thread.
+   * @return OK if a unit was consumed, OverLimit if the quota ran out but didn't expire yet, or
+   *         nullopt if there is no quota for the key, in which case the rate limit service must
+   *         be queried.
+   */
+  absl::optional<LimitStatus> consume(const std::string& key);
+
+  /**
+   * Caches the quota granted for the key, overriding the previous one. A unit of the quota is
+   * consumed by the request the quota was granted for. Quotas without an expiration are not
+   * cached. Must be called on a worker thread.
+   */
+  void insert(const std::string& key,
+              const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota);
+
+private:
+  struct CachedQuota {
+    uint32_t requests_;
+    MonotonicTime valid_until_;
+  };
+  using LruCache = ::google::simple_lru_cache::SimpleLRUCache<std::string, CachedQuota>;
+
+  struct ThreadLocalQuotas : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalQuotas(uint32_t max_entries) : quotas_(max_entries) {}
+    LruCache quotas_;
+  };
+
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlot<ThreadLocalQuotas> tls_;
+};
+
+using QuotaCacheSharedPtr = std::shared_ptr<QuotaCache>;
+
+} // namespace RateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
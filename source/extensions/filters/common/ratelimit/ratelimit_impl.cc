@@ -20,10 +20,12 @@ namespace Common {
 namespace RateLimit {
 
 GrpcClientImpl::GrpcClientImpl(const Grpc::RawAsyncClientSharedPtr& async_client,
-                               const absl::optional<std::chrono::milliseconds>& timeout)
+                               const absl::optional<std::chrono::milliseconds>& timeout,
+                               QuotaCacheSharedPtr quota_cache)
     : async_client_(async_client), timeout_(timeout),
       service_method_(*Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
-          "envoy.service.ratelimit.v3.RateLimitService.ShouldRateLimit")) {}
+          "envoy.service.ratelimit.v3.RateLimitService.ShouldRateLimit")),
+      quota_cache_(std::move(quota_cache)) {}
 
 GrpcClientImpl::~GrpcClientImpl() { ASSERT(!callbacks_); }
 
@@ -59,6 +61,14 @@ void GrpcClientImpl::limit(RequestCallbacks& callbacks, const std::string& domai
                            const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
                            Tracing::Span& parent_span, const StreamInfo::StreamInfo& stream_info) {
   ASSERT(callbacks_ == nullptr);
+  if (quota_cache_ != nullptr) {
+    quota_key_ = QuotaCache::key(domain, descriptors);
+    const absl::optional<LimitStatus> status = quota_cache_->consume(quota_key_);
+    if (status.has_value()) {
+      callbacks.complete(status.value(), nullptr, nullptr, nullptr, EMPTY_STRING, nullptr);
+      return;
+    }
+  }
   callbacks_ = &callbacks;
 
   envoy::service::ratelimit::v3::RateLimitRequest request;
@@ -73,6 +83,10 @@ void GrpcClientImpl::limit(RequestCallbacks& callbacks, const std::string& domai
 void GrpcClientImpl::onSuccess(
     std::unique_ptr<envoy::service::ratelimit::v3::RateLimitResponse>&& response,
     Tracing::Span& span) {
+  if (quota_cache_ != nullptr && response->has_quota()) {
+    quota_cache_->insert(quota_key_, response->quota());
+  }
+
   LimitStatus status = LimitStatus::OK;
   ASSERT(response->overall_code() != envoy::service::ratelimit::v3::RateLimitResponse::UNKNOWN);
   if (response->overall_code() == envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT) {
@@ -121,13 +135,14 @@ void GrpcClientImpl::onFailure(Grpc::Status::GrpcStatus status, const std::strin
 
 ClientPtr rateLimitClient(Server::Configuration::FactoryContext& context,
                           const envoy::config::core::v3::GrpcService& grpc_service,
-                          const std::chrono::milliseconds timeout) {
+                          const std::chrono::milliseconds timeout,
+                          QuotaCacheSharedPtr quota_cache) {
   // TODO(ramaraochavali): register client to singleton when GrpcClientImpl supports concurrent
   // requests.
   return std::make_unique<Filters::Common::RateLimit::GrpcClientImpl>(
       context.clusterManager().grpcAsyncClientManager().getOrCreateRawAsyncClient(
           grpc_service, context.scope(), true),
-      timeout);
+      timeout, std::move(quota_cache));
 }
 
 } // namespace RateLimit
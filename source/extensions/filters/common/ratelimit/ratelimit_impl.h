@@ -18,6 +18,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/grpc/typed_async_client.h"
 #include "source/common/singleton/const_singleton.h"
+#include "source/extensions/filters/common/ratelimit/quota_cache.h"
 #include "source/extensions/filters/common/ratelimit/ratelimit.h"
 
 namespace Envoy {
@@ -45,7 +46,8 @@ class GrpcClientImpl : public Client,
                        public Logger::Loggable<Logger::Id::config> {
 public:
   GrpcClientImpl(const Grpc::RawAsyncClientSharedPtr& async_client,
-                 const absl::optional<std::chrono::milliseconds>& timeout);
+                 const absl::optional<std::chrono::milliseconds>& timeout,
+                 QuotaCacheSharedPtr quota_cache = nullptr);
   ~GrpcClientImpl() override;
 
   static void createRequest(envoy::service::ratelimit::v3::RateLimitRequest& request,
@@ -73,6 +75,9 @@ private:
   absl::optional<std::chrono::milliseconds> timeout_;
   RequestCallbacks* callbacks_{};
   const Protobuf::MethodDescriptor& service_method_;
+  // If set, the quotas granted by the service are cached and consumed before querying it.
+  const QuotaCacheSharedPtr quota_cache_;
+  std::string quota_key_;
 };
 
 /**
@@ -80,7 +85,8 @@ private:
  */
 ClientPtr rateLimitClient(Server::Configuration::FactoryContext& context,
                           const envoy::config::core::v3::GrpcService& grpc_service,
-                          const std::chrono::milliseconds timeout);
+                          const std::chrono::milliseconds timeout,
+                          QuotaCacheSharedPtr quota_cache = nullptr);
 
 } // namespace RateLimit
 } // namespace Common
@@ -1,5 +1,8 @@
 #include "source/extensions/filters/common/rbac/engine_impl.h"
 
+#include <algorithm>
+#include <map>
+
 #include "envoy/config/rbac/v3/rbac.pb.h"
 #include "envoy/config/rbac/v3/rbac.pb.validate.h"
 
@@ -10,6 +13,12 @@ namespace Extensions {
 namespace Filters {
 namespace Common {
 namespace RBAC {
+namespace {
+
+// The number of policies from which they are indexed.
+constexpr size_t MinPoliciesToIndex = 8;
+
+} // namespace
 
 Envoy::Matcher::ActionFactoryCb
 ActionFactory::createActionFactoryCb(const Protobuf::Message& config, ActionContext& context,
@@ -52,9 +61,26 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     }
   }
 
-  for (const auto& policy : rules.policies()) {
-    policies_.emplace(policy.first, std::make_unique<PolicyMatcher>(policy.second, builder_.get(),
-                                                                    validation_visitor));
+  // Policies are evaluated in name order, so that the first matching policy doesn't depend on
+  // the order of the map.
+  const std::map<std::string, const envoy::config::rbac::v3::Policy*> sorted_policies = [&rules] {
+    std::map<std::string, const envoy::config::rbac::v3::Policy*> sorted_policies;
+    for (const auto& policy : rules.policies()) {
+      sorted_policies.emplace(policy.first, &policy.second);
+    }
+    return sorted_policies;
+  }();
+  std::vector<const envoy::config::rbac::v3::Policy*> policy_configs;
+  policies_.reserve(sorted_policies.size());
+  policy_configs.reserve(sorted_policies.size());
+  for (const auto& [name, policy] : sorted_policies) {
+    policies_.emplace_back(
+        name, std::make_unique<PolicyMatcher>(*policy, builder_.get(), validation_visitor));
+    policy_configs.push_back(policy);
+  }
+
+  if (policies_.size() >= MinPoliciesToIndex) {
+    index_ = std::make_unique<PolicyIndex>(policy_configs);
   }
 }
 
@@ -89,19 +115,27 @@ bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& c
 bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Network::Connection& connection, const StreamInfo::StreamInfo& info,
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
-  bool matched = false;
-
-  for (const auto& policy : policies_) {
-    if (policy.second->matches(connection, headers, info)) {
-      matched = true;
-      if (effective_policy_id != nullptr) {
-        *effective_policy_id = policy.first;
-      }
-      break;
+  // The conditions of the policies share the attributes resolved for the request.
+  absl::optional<Expr::EvaluationContext> evaluation;
+  const auto matches = [&](const std::pair<std::string, std::unique_ptr<PolicyMatcher>>& policy) {
+    if (!policy.second->matches(connection, headers, info, evaluation)) {
+      return false;
     }
-  }
+    if (effective_policy_id != nullptr) {
+      *effective_policy_id = policy.first;
+    }
+    return true;
+  };
 
-  return matched;
+  if (index_ == nullptr) {
+    return std::any_of(policies_.begin(), policies_.end(), matches);
+  }
+  // The candidates are in the order of the policies, so the first match is the same as without
+  // the index.
+  std::vector<uint32_t> candidates;
+  index_->candidates(connection, headers, info, candidates);
+  return std::any_of(candidates.begin(), candidates.end(),
+                     [&](uint32_t position) { return matches(policies_[position]); });
 }
 
 RoleBasedAccessControlMatcherEngineImpl::RoleBasedAccessControlMatcherEngineImpl(
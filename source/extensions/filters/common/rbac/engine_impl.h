@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -83,7 +84,11 @@ private:
   const envoy::config::rbac::v3::RBAC::Action action_;
   const EnforcementMode mode_;
 
-  std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
+  // The policies in name order, which is the order they are evaluated in.
+  std::vector<std::pair<std::string, std::unique_ptr<PolicyMatcher>>> policies_;
+  // Narrows down the policies to evaluate. Only set when there are enough policies for the
+  // lookups to cost less than evaluating all of them.
+  std::unique_ptr<PolicyIndex> index_;
 
   Protobuf::Arena constant_arena_;
   Expr::BuilderPtr builder_;
@@ -248,6 +248,23 @@ bool PolicyMatcher::matches(const Network::Connection& connection,
          (expr_ == nullptr ? true : Expr::matches(*expr_, info, headers));
 }
 
+bool PolicyMatcher::matches(const Network::Connection& connection,
+                            const Envoy::Http::RequestHeaderMap& headers,
+                            const StreamInfo::StreamInfo& info,
+                            absl::optional<Expr::EvaluationContext>& evaluation) const {
+  if (!permissions_.matches(connection, headers, info) ||
+      !principals_.matches(connection, headers, info)) {
+    return false;
+  }
+  if (expr_ == nullptr) {
+    return true;
+  }
+  if (!evaluation.has_value()) {
+    evaluation.emplace(info, &headers, nullptr, nullptr);
+  }
+  return evaluation->matches(*expr_);
+}
+
 bool RequestedServerNameMatcher::matches(const Network::Connection& connection,
                                          const Envoy::Http::RequestHeaderMap&,
                                          const StreamInfo::StreamInfo&) const {
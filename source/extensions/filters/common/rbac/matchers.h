@@ -221,6 +221,14 @@ public:
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo&) const override;
 
+  /**
+   * Same as matches(), evaluating the condition in an evaluation context shared with the other
+   * policies matched against the request. The context is created on the first evaluation.
+   */
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo& info,
+               absl::optional<Expr::EvaluationContext>& evaluation) const;
+
 private:
   const OrMatcher permissions_;
   const OrMatcher principals_;
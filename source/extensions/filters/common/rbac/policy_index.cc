@@ -0,0 +1,330 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "source/common/http/header_utility.h"
+#include "source/common/http/path_utility.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+// An LcTrie with the default fill factor holds up to a quarter as many prefixes as it has nodes.
+constexpr size_t MaxRangesPerTrie = Network::LcTrie::MaxLcTrieNodes / 4;
+
+// Returns the address an IPMatcher of the type matches against.
+Network::Address::InstanceConstSharedPtr address(IPMatcher::Type type,
+                                                 const Network::Connection& connection,
+                                                 const StreamInfo::StreamInfo& info) {
+  switch (type) {
+  case IPMatcher::ConnectionRemote:
+    return connection.connectionInfoProvider().remoteAddress();
+  case IPMatcher::DownstreamLocal:
+    return info.downstreamAddressProvider().localAddress();
+  case IPMatcher::DownstreamDirectRemote:
+    return info.downstreamAddressProvider().directRemoteAddress();
+  case IPMatcher::DownstreamRemote:
+    return info.downstreamAddressProvider().remoteAddress();
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+// Returns whether a string matcher only matches a single, case sensitive, value.
+bool isExact(const envoy::type::matcher::v3::StringMatcher& matcher) {
+  return matcher.match_pattern_case() == envoy::type::matcher::v3::StringMatcher::kExact &&
+         !matcher.ignore_case();
+}
+
+void addPosition(std::vector<uint32_t>& positions, uint32_t position) {
+  // Policies are added in increasing order, and may have the same key more than once.
+  if (positions.empty() || positions.back() != position) {
+    positions.push_back(position);
+  }
+}
+
+} // namespace
+
+size_t PolicyIndex::Keys::size() const {
+  size_t size = ports_.size() + headers_.size() + paths_.size() + principals_.size();
+  for (const auto& ranges : ranges_) {
+    size += ranges.size();
+  }
+  return size;
+}
+
+void PolicyIndex::Keys::append(Keys&& other) {
+  for (size_t type = 0; type < IpTypes; ++type) {
+    std::move(other.ranges_[type].begin(), other.ranges_[type].end(),
+              std::back_inserter(ranges_[type]));
+  }
+  std::move(other.ports_.begin(), other.ports_.end(), std::back_inserter(ports_));
+  std::move(other.headers_.begin(), other.headers_.end(), std::back_inserter(headers_));
+  std::move(other.paths_.begin(), other.paths_.end(), std::back_inserter(paths_));
+  std::move(other.principals_.begin(), other.principals_.end(), std::back_inserter(principals_));
+}
+
+template <class Rule>
+bool PolicyIndex::collectAnyKeys(const Protobuf::RepeatedPtrField<Rule>& rules, Keys& keys) {
+  // A request matching any of the rules has one of the keys of that rule. No rules match no
+  // requests, so they need no keys.
+  for (const auto& rule : rules) {
+    if (!collectKeys(rule, keys)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Rule>
+bool PolicyIndex::collectAllKeys(const Protobuf::RepeatedPtrField<Rule>& rules, Keys& keys) {
+  // A request matching all the rules has one of the keys of each rule, so the keys of any rule
+  // will do. The rule with the fewest keys is the most selective.
+  absl::optional<Keys> fewest_keys;
+  for (const auto& rule : rules) {
+    Keys rule_keys;
+    if (collectKeys(rule, rule_keys) &&
+        (!fewest_keys.has_value() || rule_keys.size() < fewest_keys->size())) {
+      fewest_keys = std::move(rule_keys);
+    }
+  }
+  if (!fewest_keys.has_value()) {
+    return false;
+  }
+  keys.append(std::move(*fewest_keys));
+  return true;
+}
+
+PolicyIndex::PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies) {
+  std::vector<absl::optional<Keys>> policy_keys(policies.size());
+  std::array<size_t, IpTypes> range_counts{};
+  for (uint32_t position = 0; position < policies.size(); ++position) {
+    const envoy::config::rbac::v3::Policy& policy = *policies[position];
+    Keys permission_keys;
+    Keys principal_keys;
+    const bool has_permission_keys = collectAnyKeys(policy.permissions(), permission_keys);
+    const bool has_principal_keys = collectAnyKeys(policy.principals(), principal_keys);
+    if (has_permission_keys &&
+        (!has_principal_keys || permission_keys.size() <= principal_keys.size())) {
+      policy_keys[position] = std::move(permission_keys);
+    } else if (has_principal_keys) {
+      policy_keys[position] = std::move(principal_keys);
+    } else {
+      continue;
+    }
+    for (size_t type = 0; type < IpTypes; ++type) {
+      range_counts[type] += policy_keys[position]->ranges_[type].size();
+    }
+  }
+
+  std::array<std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>>, IpTypes>
+      trie_data;
+  absl::flat_hash_map<std::string, size_t> header_names;
+  for (uint32_t position = 0; position < policies.size(); ++position) {
+    absl::optional<Keys>& keys = policy_keys[position];
+    for (size_t type = 0; keys.has_value() && type < IpTypes; ++type) {
+      if (!keys->ranges_[type].empty() && range_counts[type] > MaxRangesPerTrie) {
+        keys.reset();
+      }
+    }
+    if (!keys.has_value()) {
+      unindexed_.push_back(position);
+      continue;
+    }
+
+    for (size_t type = 0; type < IpTypes; ++type) {
+      if (!keys->ranges_[type].empty()) {
+        trie_data[type].emplace_back(position, std::move(keys->ranges_[type]));
+      }
+    }
+    for (const uint32_t port : keys->ports_) {
+      addPosition(ports_[port], position);
+    }
+    for (auto& [name, value] : keys->headers_) {
+      auto [it, inserted] = header_names.try_emplace(name.get(), headers_.size());
+      if (inserted) {
+        headers_.emplace_back(name, absl::flat_hash_map<std::string, Positions>());
+      }
+      addPosition(headers_[it->second].second[value], position);
+    }
+    for (const std::string& path : keys->paths_) {
+      addPosition(paths_[path], position);
+    }
+    for (const std::string& principal : keys->principals_) {
+      addPosition(principals_[principal], position);
+    }
+  }
+
+  for (size_t type = 0; type < IpTypes; ++type) {
+    if (!trie_data[type].empty()) {
+      ip_tries_[type] = std::make_unique<PositionTrie>(trie_data[type]);
+    }
+  }
+}
+
+void PolicyIndex::candidates(const Network::Connection& connection,
+                             const Envoy::Http::RequestHeaderMap& headers,
+                             const StreamInfo::StreamInfo& info,
+                             std::vector<uint32_t>& candidates) const {
+  candidates.assign(unindexed_.begin(), unindexed_.end());
+
+  for (size_t type = 0; type < IpTypes; ++type) {
+    if (ip_tries_[type] == nullptr) {
+      continue;
+    }
+    const Network::Address::InstanceConstSharedPtr ip =
+        address(static_cast<IPMatcher::Type>(type), connection, info);
+    if (ip != nullptr && ip->ip() != nullptr) {
+      const std::vector<uint32_t> hits = ip_tries_[type]->getData(ip);
+      candidates.insert(candidates.end(), hits.begin(), hits.end());
+    }
+  }
+
+  if (!ports_.empty()) {
+    const Network::Address::Ip* ip = info.downstreamAddressProvider().localAddress()->ip();
+    if (ip != nullptr) {
+      const auto it = ports_.find(ip->port());
+      if (it != ports_.end()) {
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+      }
+    }
+  }
+
+  for (const auto& [name, values] : headers_) {
+    // Header values are compared the way HeaderMatcher compares them.
+    const auto value = Envoy::Http::HeaderUtility::getAllOfHeaderAsString(headers, name);
+    if (value.result().has_value()) {
+      addHits(values, value.result().value(), candidates);
+    }
+  }
+
+  if (!paths_.empty() && headers.Path() != nullptr) {
+    addHits(paths_,
+            Envoy::Http::PathUtil::removeQueryAndFragment(headers.getPathValue()), candidates);
+  }
+
+  const auto& ssl = connection.ssl();
+  if (!principals_.empty() && ssl != nullptr) {
+    for (const std::string& uri : ssl->uriSanPeerCertificate()) {
+      addHits(principals_, uri, candidates);
+    }
+    for (const std::string& dns : ssl->dnsSansPeerCertificate()) {
+      addHits(principals_, dns, candidates);
+    }
+    addHits(principals_, ssl->subjectPeerCertificate(), candidates);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+void PolicyIndex::addHits(const absl::flat_hash_map<std::string, Positions>& index,
+                          absl::string_view value, std::vector<uint32_t>& candidates) {
+  const auto it = index.find(value);
+  if (it != index.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+}
+
+bool PolicyIndex::collectKeys(const envoy::config::rbac::v3::Permission& permission,
+                              Keys& keys) {
+  switch (permission.rule_case()) {
+  case envoy::config::rbac::v3::Permission::RuleCase::kAndRules:
+    return collectAllKeys(permission.and_rules().rules(), keys);
+  case envoy::config::rbac::v3::Permission::RuleCase::kOrRules:
+    return collectAnyKeys(permission.or_rules().rules(), keys);
+  case envoy::config::rbac::v3::Permission::RuleCase::kHeader:
+    return collectHeaderKeys(permission.header(), keys);
+  case envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp:
+    return collectIpKeys(permission.destination_ip(), IPMatcher::DownstreamLocal, keys);
+  case envoy::config::rbac::v3::Permission::RuleCase::kDestinationPort:
+    keys.ports_.push_back(permission.destination_port());
+    return true;
+  case envoy::config::rbac::v3::Permission::RuleCase::kUrlPath:
+    return collectPathKeys(permission.url_path(), keys);
+  default:
+    return false;
+  }
+}
+
+bool PolicyIndex::collectKeys(const envoy::config::rbac::v3::Principal& principal, Keys& keys) {
+  switch (principal.identifier_case()) {
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kAndIds:
+    return collectAllKeys(principal.and_ids().ids(), keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kOrIds:
+    return collectAnyKeys(principal.or_ids().ids(), keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kAuthenticated:
+    if (!principal.authenticated().has_principal_name() ||
+        !isExact(principal.authenticated().principal_name())) {
+      return false;
+    }
+    keys.principals_.push_back(principal.authenticated().principal_name().exact());
+    return true;
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+    return collectIpKeys(principal.source_ip(), IPMatcher::ConnectionRemote, keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+    return collectIpKeys(principal.direct_remote_ip(), IPMatcher::DownstreamDirectRemote, keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+    return collectIpKeys(principal.remote_ip(), IPMatcher::DownstreamRemote, keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kHeader:
+    return collectHeaderKeys(principal.header(), keys);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kUrlPath:
+    return collectPathKeys(principal.url_path(), keys);
+  default:
+    return false;
+  }
+}
+
+bool PolicyIndex::collectHeaderKeys(const envoy::config::route::v3::HeaderMatcher& header,
+                                    Keys& keys) {
+  if (header.invert_match() || header.treat_missing_header_as_empty()) {
+    return false;
+  }
+  switch (header.header_match_specifier_case()) {
+  case envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kExactMatch:
+    // An empty value matches any value.
+    if (header.exact_match().empty()) {
+      return false;
+    }
+    keys.headers_.emplace_back(Envoy::Http::LowerCaseString(header.name()), header.exact_match());
+    return true;
+  case envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kStringMatch:
+    if (!isExact(header.string_match())) {
+      return false;
+    }
+    keys.headers_.emplace_back(Envoy::Http::LowerCaseString(header.name()),
+                               header.string_match().exact());
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool PolicyIndex::collectPathKeys(const envoy::type::matcher::v3::PathMatcher& path, Keys& keys) {
+  if (!path.has_path() || !isExact(path.path())) {
+    return false;
+  }
+  keys.paths_.push_back(path.path().exact());
+  return true;
+}
+
+bool PolicyIndex::collectIpKeys(const envoy::config::core::v3::CidrRange& range,
+                                IPMatcher::Type type, Keys& keys) {
+  Network::Address::CidrRange cidr = Network::Address::CidrRange::create(range);
+  // An invalid range matches no addresses, so it needs no key.
+  if (cidr.isValid()) {
+    keys.ranges_[type].push_back(std::move(cidr));
+  }
+  return true;
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
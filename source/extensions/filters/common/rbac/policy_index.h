@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
+#include "source/extensions/filters/common/rbac/matchers.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * An index of the policies of an RBAC config, which narrows down the policies a request may
+ * match without evaluating all of them.
+ *
+ * At construction, each policy is reduced to a set of keys, at least one of which is present in
+ * every request the policy matches: the destination and source IP ranges, destination ports,
+ * exact header values, exact paths and exact principal names. The keys are taken from the
+ * permissions of the policy, or from its principals when the permissions have none, e.g. a policy
+ * with an `any` permission. The keys of an `or_rules` are the keys of all its rules, and the keys
+ * of an `and_rules` are those of the rule having the fewest keys. Policies without such a set of
+ * keys are candidates for every request.
+ *
+ * The index only discards policies which can't match, so the policies it returns must still be
+ * evaluated in full.
+ */
+class PolicyIndex {
+public:
+  /**
+   * @param policies supplies the policies, in evaluation order. The index refers to a policy by
+   *                 its position in this vector.
+   */
+  explicit PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies);
+
+  /**
+   * Sets the positions of the policies which may match a request, in increasing order.
+   */
+  void candidates(const Network::Connection& connection,
+                  const Envoy::Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& info,
+                  std::vector<uint32_t>& candidates) const;
+
+  /**
+   * @return the number of policies which are candidates for every request.
+   */
+  size_t unindexedPolicies() const { return unindexed_.size(); }
+
+private:
+  using Positions = std::vector<uint32_t>;
+  using PositionTrie = Network::LcTrie::LcTrie<uint32_t>;
+
+  static constexpr size_t IpTypes = IPMatcher::Type::DownstreamRemote + 1;
+
+  // The keys of a policy. At least one of them is present in each request the policy matches.
+  struct Keys {
+    size_t size() const;
+    void append(Keys&& other);
+
+    std::array<std::vector<Network::Address::CidrRange>, IpTypes> ranges_;
+    std::vector<uint32_t> ports_;
+    std::vector<std::pair<Envoy::Http::LowerCaseString, std::string>> headers_;
+    std::vector<std::string> paths_;
+    std::vector<std::string> principals_;
+  };
+
+  // Each returns false if there is no set of keys for the rule.
+  static bool collectKeys(const envoy::config::rbac::v3::Permission& permission, Keys& keys);
+  static bool collectKeys(const envoy::config::rbac::v3::Principal& principal, Keys& keys);
+  static bool collectHeaderKeys(const envoy::config::route::v3::HeaderMatcher& header,
+                                Keys& keys);
+  static bool collectPathKeys(const envoy::type::matcher::v3::PathMatcher& path, Keys& keys);
+  static bool collectIpKeys(const envoy::config::core::v3::CidrRange& range, IPMatcher::Type type,
+                            Keys& keys);
+  template <class Rule>
+  static bool collectAnyKeys(const Protobuf::RepeatedPtrField<Rule>& rules, Keys& keys);
+  template <class Rule>
+  static bool collectAllKeys(const Protobuf::RepeatedPtrField<Rule>& rules, Keys& keys);
+
+  static void addHits(const absl::flat_hash_map<std::string, Positions>& index,
+                      absl::string_view value, std::vector<uint32_t>& candidates);
+
+  Positions unindexed_;
+  std::array<std::unique_ptr<PositionTrie>, IpTypes> ip_tries_;
+  absl::flat_hash_map<uint32_t, Positions> ports_;
+  // The values are indexed by header name.
+  std::vector<std::pair<Envoy::Http::LowerCaseString, absl::flat_hash_map<std::string, Positions>>>
+      headers_;
+  absl::flat_hash_map<std::string, Positions> paths_;
+  absl::flat_hash_map<std::string, Positions> principals_;
+};
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
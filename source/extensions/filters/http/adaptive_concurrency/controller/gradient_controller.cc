@@ -182,16 +182,14 @@ uint32_t GradientController::calculateNewLimit() {
 }
 
 RequestForwardingAction GradientController::forwardingDecision() {
-  // Note that a race condition exists here which would allow more outstanding requests than the
-  // concurrency limit bounded by the number of worker threads. After loading num_rq_outstanding_
-  // and before loading concurrency_limit_, another thread could potentially swoop in and modify
-  // num_rq_outstanding_, causing us to move forward with stale values and increment
-  // num_rq_outstanding_.
-  //
-  // TODO (tonya11en): Reconsider using a CAS loop here.
-  if (num_rq_outstanding_.load() < concurrencyLimit()) {
-    ++num_rq_outstanding_;
-    return RequestForwardingAction::Forward;
+  // The outstanding request count is only incremented if it was not modified by another worker
+  // since it was compared to the limit, so workers racing for the last slots cannot push the
+  // number of outstanding requests past the concurrency limit.
+  uint32_t rq_outstanding = num_rq_outstanding_.load();
+  while (rq_outstanding < concurrencyLimit()) {
+    if (num_rq_outstanding_.compare_exchange_weak(rq_outstanding, rq_outstanding + 1)) {
+      return RequestForwardingAction::Forward;
+    }
   }
   stats_.rq_blocked_.inc();
   return RequestForwardingAction::Block;
@@ -62,7 +62,7 @@ public:
   void recordFailure() override { recordRequest(false); }
 
   RequestData requestCounts() override {
-    maybeUpdateHistoricalData();
+    maybeUpdateHistoricalData(time_source_.monotonicTime());
     return global_data_;
   }
 
@@ -71,23 +71,23 @@ public:
 private:
   void recordRequest(bool success);
 
-  // Potentially remove any stale samples and record sample aggregates to the historical data.
-  void maybeUpdateHistoricalData();
+  // Potentially remove any stale samples and record sample aggregates to the historical data. The
+  // current time is passed in by the caller so that the clock is read once per request, rather than
+  // once per sample that is aged.
+  void maybeUpdateHistoricalData(MonotonicTime now);
 
   // Returns the age of the oldest sample in the historical data.
-  std::chrono::microseconds ageOfOldestSample() const {
+  std::chrono::microseconds ageOfOldestSample(MonotonicTime now) const {
     ASSERT(!historical_data_.empty());
     using namespace std::chrono;
-    return duration_cast<microseconds>(time_source_.monotonicTime() -
-                                       historical_data_.front().first);
+    return duration_cast<microseconds>(now - historical_data_.front().first);
   }
 
   // Returns the age of the newest sample in the historical data.
-  std::chrono::microseconds ageOfNewestSample() const {
+  std::chrono::microseconds ageOfNewestSample(MonotonicTime now) const {
     ASSERT(!historical_data_.empty());
     using namespace std::chrono;
-    return duration_cast<microseconds>(time_source_.monotonicTime() -
-                                       historical_data_.back().first);
+    return duration_cast<microseconds>(now - historical_data_.back().first);
   }
 
   // Removes the oldest sample in the historical data and reconciles the global data.
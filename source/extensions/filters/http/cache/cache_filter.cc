@@ -33,12 +33,18 @@ using CacheResponseCodeDetails = ConstSingleton<CacheResponseCodeDetailValues>;
 
 CacheFilter::CacheFilter(const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
                          const std::string&, Stats::Scope&, TimeSource& time_source,
-                         HttpCache& http_cache)
-    : time_source_(time_source), cache_(http_cache),
+                         HttpCache& http_cache, RequestCoalescerSharedPtr coalescer)
+    : time_source_(time_source), cache_(http_cache), coalescer_(std::move(coalescer)),
+      coalescing_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, request_coalescing_timeout, 0)),
       vary_allow_list_(config.allowed_vary_headers()) {}
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  // Let the requests waiting for this one look the response up, or go upstream themselves.
+  fill_.reset();
+  if (fill_timer_) {
+    fill_timer_->disableTimer();
+  }
   if (lookup_) {
     lookup_->onDestroy();
   }
@@ -79,6 +85,9 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   LookupRequest lookup_request(headers, time_source_.systemTime(), vary_allow_list_);
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (coalescer_) {
+    key_ = lookup_request.key();
+  }
   lookup_ = cache_.makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
 
   ASSERT(lookup_);
@@ -116,6 +125,7 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
 
   if (filter_state_ == FilterState::ValidatingCachedResponse && isResponseNotModified(headers)) {
     processSuccessfulValidation(headers);
+    fill_.reset();
     // Stop the encoding stream until the cached response is fetched & added to the encoding stream.
     if (is_head_request_) {
       // Return since HEAD requests are not cached
@@ -141,11 +151,13 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
         headers, metadata, [](bool) {}, end_stream);
     if (end_stream) {
       insert_status_ = InsertStatus::InsertSucceeded;
+      fill_.reset();
     }
     // insert_status_ remains absl::nullopt if end_stream == false, as we have not completed the
     // insertion yet.
   } else {
     insert_status_ = InsertStatus::NoInsertResponseNotCacheable;
+    fill_.reset();
   }
   filter_state_ = FilterState::NotServingFromCache;
   return Http::FilterHeadersStatus::Continue;
@@ -168,6 +180,7 @@ Http::FilterDataStatus CacheFilter::encodeData(Buffer::Instance& data, bool end_
         data, [](bool) {}, end_stream);
     if (end_stream) {
       insert_status_ = InsertStatus::InsertSucceeded;
+      fill_.reset();
     }
     // insert_status_ remains absl::nullopt if end_stream == false, as we have not completed the
     // insertion yet.
@@ -191,6 +204,7 @@ Http::FilterTrailersStatus CacheFilter::encodeTrailers(Http::ResponseTrailerMap&
     insert_->insertTrailers(trailers, [](bool) {});
   }
   insert_status_ = InsertStatus::InsertSucceeded;
+  fill_.reset();
 
   return Http::FilterTrailersStatus::Continue;
 }
@@ -383,6 +397,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
   case CacheEntryStatus::FoundNotModified:
     PANIC("unsupported code");
   case CacheEntryStatus::RequiresValidation:
+    if (waitForFill(request_headers)) {
+      return;
+    }
     // If a cache entry requires validation, inject validation headers in the
     // request and let it pass through as if no cache entry was found. If the
     // cache entry was valid, the response status should be 304 (unmodified)
@@ -397,6 +414,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit();
     return;
   case CacheEntryStatus::Unusable:
+    if (waitForFill(request_headers)) {
+      return;
+    }
     decoder_callbacks_->continueDecoding();
     return;
   case CacheEntryStatus::LookupError:
@@ -467,6 +487,59 @@ void CacheFilter::onTrailers(Http::ResponseTrailerMapPtr&& trailers) {
   finalizeEncodingCachedResponse();
 }
 
+bool CacheFilter::waitForFill(Http::RequestHeaderMap& request_headers) {
+  // HEAD requests and requests forbidding inserts would not fill the cache for the others.
+  if (!coalescer_ || waited_for_fill_ || is_head_request_ || !request_allows_inserts_) {
+    return false;
+  }
+  ASSERT(key_.has_value());
+  CacheFilterWeakPtr self = weak_from_this();
+  fill_ = coalescer_->join(key_.value(), decoder_callbacks_->dispatcher(),
+                           [self, &request_headers]() {
+                             if (CacheFilterSharedPtr cache_filter = self.lock()) {
+                               cache_filter->onFillDone(request_headers);
+                             }
+                           });
+  if (fill_) {
+    return false;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter waiting for a concurrent request to fill the cache",
+                   *decoder_callbacks_);
+  waited_for_fill_ = true;
+  fill_timer_ = decoder_callbacks_->dispatcher().createTimer(
+      [this, &request_headers]() { onFillTimeout(request_headers); });
+  fill_timer_->enableTimer(coalescing_timeout_);
+  return true;
+}
+
+void CacheFilter::onFillDone(Http::RequestHeaderMap& request_headers) {
+  // The timeout may have fired, or a response may have been injected into the filter chain, while
+  // the fill was posting this callback.
+  if (fill_timer_ == nullptr || !fill_timer_->enabled() ||
+      filter_state_ != FilterState::Initial) {
+    return;
+  }
+  fill_timer_->disableTimer();
+  ENVOY_STREAM_LOG(debug, "CacheFilter looking up the response filled by a concurrent request",
+                   *decoder_callbacks_);
+  lookup_->onDestroy();
+  lookup_result_.reset();
+  lookup_ = cache_.makeLookupContext(
+      LookupRequest(request_headers, time_source_.systemTime(), vary_allow_list_),
+      *decoder_callbacks_);
+  getHeaders(request_headers);
+}
+
+void CacheFilter::onFillTimeout(Http::RequestHeaderMap& request_headers) {
+  if (filter_state_ != FilterState::Initial) {
+    return;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter timed out waiting for a concurrent request to fill",
+                   *decoder_callbacks_);
+  LookupResult result = std::move(*lookup_result_);
+  onHeaders(std::move(result), request_headers);
+}
+
 void CacheFilter::handleCacheHit() {
   filter_state_ = FilterState::DecodeServingFromCache;
   insert_status_ = InsertStatus::NoInsertCacheHit;
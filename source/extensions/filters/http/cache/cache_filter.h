@@ -5,12 +5,14 @@
 #include <string>
 #include <vector>
 
+#include "envoy/event/timer.h"
 #include "envoy/extensions/filters/http/cache/v3/cache.pb.h"
 
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/http/cache/cache_filter_logging_info.h"
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/request_coalescer.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -52,9 +54,13 @@ class CacheFilter : public Http::PassThroughFilter,
                     public Logger::Loggable<Logger::Id::cache_filter>,
                     public std::enable_shared_from_this<CacheFilter> {
 public:
+  /**
+   * @param coalescer supplies the coalescer of the cache misses, shared by the filters of the
+   *        config, or nullptr if requests are not coalesced.
+   */
   CacheFilter(const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
               const std::string& stats_prefix, Stats::Scope& scope, TimeSource& time_source,
-              HttpCache& http_cache);
+              HttpCache& http_cache, RequestCoalescerSharedPtr coalescer = nullptr);
   // Http::StreamFilterBase
   void onDestroy() override;
   void onStreamComplete() override;
@@ -81,6 +87,17 @@ private:
   void onBody(Buffer::InstancePtr&& body);
   void onTrailers(Http::ResponseTrailerMapPtr&& trailers);
 
+  // Precondition: lookup_result_ points to a cache miss or to a response requiring validation.
+  // Joins the fill of the key if requests are coalesced. Returns true if another request is
+  // filling the cache, in which case this one waits for it.
+  bool waitForFill(Http::RequestHeaderMap& request_headers);
+
+  // Looks the response up again once the fill this request waited for is done.
+  void onFillDone(Http::RequestHeaderMap& request_headers);
+
+  // Stops waiting for a fill taking too long, and handles the original lookup result.
+  void onFillTimeout(Http::RequestHeaderMap& request_headers);
+
   // Set required state in the CacheFilter for handling a cache hit.
   void handleCacheHit();
 
@@ -128,6 +145,8 @@ private:
 
   TimeSource& time_source_;
   HttpCache& cache_;
+  const RequestCoalescerSharedPtr coalescer_;
+  const std::chrono::milliseconds coalescing_timeout_;
   LookupContextPtr lookup_;
   InsertContextPtr insert_;
   LookupResultPtr lookup_result_;
@@ -154,6 +173,16 @@ private:
   FilterState filter_state_ = FilterState::Initial;
 
   bool is_head_request_ = false;
+
+  // The cache key of the request, if requests are coalesced.
+  absl::optional<Key> key_;
+  // Set if this request is filling the cache for other requests.
+  RequestCoalescer::FillPtr fill_;
+  // Set while this request waits for another one to fill the cache.
+  Event::TimerPtr fill_timer_;
+  // True once this request waited for a fill, so that it doesn't wait again.
+  bool waited_for_fill_ = false;
+
   // The status of the insert operation or header update, or decision not to insert or update.
   // If it's too early to determine the final status, this is empty.
   absl::optional<InsertStatus> insert_status_;
@@ -14,6 +14,8 @@
 #include "absl/container/btree_set.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
 namespace Envoy {
@@ -302,6 +304,32 @@ constexpr absl::string_view headerSeparator = "\n";
 constexpr absl::string_view inValueSeparator = "\r";
 }; // namespace
 
+std::string VaryHeaderUtils::normalizeAcceptEncoding(absl::string_view accept_encoding) {
+  absl::btree_set<std::string> accepted;
+  absl::btree_set<std::string> refused;
+  for (absl::string_view element : absl::StrSplit(accept_encoding, ',', absl::SkipWhitespace())) {
+    std::vector<absl::string_view> params = absl::StrSplit(element, ';');
+    const std::string coding = absl::AsciiStrToLower(absl::StripAsciiWhitespace(params[0]));
+    if (coding.empty()) {
+      continue;
+    }
+    bool is_refused = false;
+    for (size_t i = 1; i < params.size(); ++i) {
+      const absl::string_view param = absl::StripAsciiWhitespace(params[i]);
+      double q;
+      if (absl::StartsWithIgnoreCase(param, "q=") && absl::SimpleAtod(param.substr(2), &q)) {
+        is_refused = q == 0;
+      }
+    }
+    (is_refused ? refused : accepted).insert(coding);
+  }
+  std::string normalized = absl::StrJoin(accepted, ",");
+  for (const std::string& coding : refused) {
+    absl::StrAppend(&normalized, ",!", coding);
+  }
+  return normalized;
+}
+
 absl::optional<std::string>
 VaryHeaderUtils::createVaryIdentifier(const VaryAllowList& allow_list,
                                       const absl::btree_set<absl::string_view>& vary_header_values,
@@ -332,6 +360,19 @@ VaryHeaderUtils::createVaryIdentifier(const VaryAllowList& allow_list,
     // UserAgent::initializeFromHeaders tries to do that normalization and could
     // be used as an inspiration for some bucketing configuration. The config
     // should enable and control the bucketing wanted.
+    if (absl::EqualsIgnoreCase(value, Http::CustomHeaders::get().AcceptEncoding.get())) {
+      // Requests accepting the same codings share a variant, whatever their order and weights,
+      // so that a response compressed by a downstream compressor filter is stored once per
+      // set of codings rather than once per distinct header value.
+      const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(
+          request_headers, Http::CustomHeaders::get().AcceptEncoding, ",");
+      absl::StrAppend(&vary_identifier, value, inValueSeparator,
+                      all_values.result().has_value()
+                          ? normalizeAcceptEncoding(all_values.result().value())
+                          : "",
+                      headerSeparator);
+      continue;
+    }
     const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(
         request_headers, Http::LowerCaseString(std::string(value)), inValueSeparator);
     absl::StrAppend(&vary_identifier, value, inValueSeparator,
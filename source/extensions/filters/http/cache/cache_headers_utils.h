@@ -145,10 +145,15 @@ bool hasVary(const Http::ResponseHeaderMap& headers);
 // map across all vary header entries.
 absl::btree_set<absl::string_view> getVaryValues(const Envoy::Http::ResponseHeaderMap& headers);
 
+// Returns a canonical form of an Accept-Encoding value: the accepted codings, lowercased and
+// sorted, followed by the refused ones (with a weight of 0) prefixed with "!". Weights are
+// otherwise ignored, as any variant encoded with an accepted coding may be served.
+std::string normalizeAcceptEncoding(absl::string_view accept_encoding);
+
 // Creates a single string combining the values of the varied headers from
-// entry_headers. Returns an absl::nullopt if no valid vary key can be created
-// and the response should not be cached (eg. when disallowed vary headers are
-// present in the response).
+// entry_headers, with Accept-Encoding values normalized by normalizeAcceptEncoding().
+// Returns an absl::nullopt if no valid vary key can be created and the response
+// should not be cached (eg. when disallowed vary headers are present in the response).
 absl::optional<std::string>
 createVaryIdentifier(const VaryAllowList& allow_list,
                      const absl::btree_set<absl::string_view>& vary_header_values,
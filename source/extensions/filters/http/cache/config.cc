@@ -19,11 +19,13 @@ Http::FilterFactoryCb CacheFilterFactory::createFilterFactoryFromProtoTyped(
   }
 
   auto cache = http_cache_factory->getCache(config, context);
+  RequestCoalescerSharedPtr coalescer =
+      config.has_request_coalescing_timeout() ? std::make_shared<RequestCoalescer>() : nullptr;
 
-  return [config, stats_prefix, &context,
-          cache](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(std::make_shared<CacheFilter>(config, stats_prefix, context.scope(),
-                                                            context.timeSource(), *cache));
+  return [config, stats_prefix, &context, cache,
+          coalescer](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+    callbacks.addStreamFilter(std::make_shared<CacheFilter>(
+        config, stats_prefix, context.scope(), context.timeSource(), *cache, coalescer));
   };
 }
 
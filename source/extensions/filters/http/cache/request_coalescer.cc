@@ -0,0 +1,38 @@
+#include "source/extensions/filters/http/cache/request_coalescer.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+RequestCoalescer::FillPtr RequestCoalescer::join(const Key& key, Event::Dispatcher& dispatcher,
+                                                 std::function<void()> on_fill_done) {
+  absl::MutexLock lock(&mutex_);
+  auto [iter, inserted] = fills_.try_emplace(key);
+  if (inserted) {
+    return std::make_unique<Fill>(shared_from_this(), key);
+  }
+  iter->second.push_back(Waiter{dispatcher, std::move(on_fill_done)});
+  return nullptr;
+}
+
+void RequestCoalescer::endFill(const Key& key) {
+  std::vector<Waiter> waiters;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto iter = fills_.find(key);
+    ASSERT(iter != fills_.end());
+    waiters = std::move(iter->second);
+    fills_.erase(iter);
+  }
+  for (Waiter& waiter : waiters) {
+    waiter.dispatcher_.post(std::move(waiter.on_fill_done_));
+  }
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/key.pb.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+/**
+ * Coalesces the concurrent cache misses for a key, from any worker: the first request missing the
+ * cache is the fill and goes upstream, while the others wait until it's done to look the key up
+ * in the cache again, instead of all going upstream at once.
+ */
+class RequestCoalescer : public std::enable_shared_from_this<RequestCoalescer> {
+public:
+  /**
+   * A fill in progress. Destroying it ends the fill, waking up the requests waiting for it.
+   */
+  class Fill {
+  public:
+    Fill(std::shared_ptr<RequestCoalescer> coalescer, const Key& key)
+        : coalescer_(std::move(coalescer)), key_(key) {}
+    ~Fill() { coalescer_->endFill(key_); }
+
+  private:
+    const std::shared_ptr<RequestCoalescer> coalescer_;
+    const Key key_;
+  };
+  using FillPtr = std::unique_ptr<Fill>;
+
+  /**
+   * Join the fill of a key after missing the cache for it.
+   * @param key supplies the cache key of the request.
+   * @param dispatcher supplies the dispatcher of the worker handling the request.
+   * @param on_fill_done supplies the callback posted to the dispatcher once the fill in progress
+   *        is done. It's dropped if there is no fill in progress.
+   * @return the new fill if there was none in progress for the key, nullptr otherwise.
+   */
+  FillPtr join(const Key& key, Event::Dispatcher& dispatcher, std::function<void()> on_fill_done);
+
+private:
+  struct Waiter {
+    Event::Dispatcher& dispatcher_;
+    std::function<void()> on_fill_done_;
+  };
+
+  void endFill(const Key& key);
+
+  absl::Mutex mutex_;
+  // The fills in progress, with the requests waiting for them.
+  absl::flat_hash_map<Key, std::vector<Waiter>, MessageUtil, MessageUtil>
+      fills_ ABSL_GUARDED_BY(mutex_);
+};
+
+using RequestCoalescerSharedPtr = std::shared_ptr<RequestCoalescer>;
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -53,7 +53,10 @@ void StreamRateLimiter::onTokenTimer() {
 
   // Try to obtain that as many tokens as bytes in the buffer, and then
   // figure out how many bytes to write given the number of tokens we actually got.
-  const uint64_t tokens_obtained = token_bucket_->consume(buffer_.length(), true);
+  // An empty buffer (e.g. a bare end_stream) needs no tokens, so skip the bucket which takes a
+  // lock when it is shared by every stream of the filter.
+  const uint64_t tokens_obtained =
+      buffer_.length() > 0 ? token_bucket_->consume(buffer_.length(), true) : 0;
   const uint64_t bytes_to_write = std::min(tokens_obtained, buffer_.length());
   ENVOY_LOG(debug,
             "StreamRateLimiter <onTokenTimer>: tokens_needed={} "
@@ -3,6 +3,9 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/ascii.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -62,6 +65,15 @@ struct CompressorRegistry : public StreamInfo::FilterState::Object {
 // Key to per stream CompressorRegistry objects.
 const std::string& compressorRegistryKey() { CONSTRUCT_ON_FIRST_USE(std::string, "compressors"); }
 
+// The content type of a response, without parameters.
+absl::string_view contentTypeValue(const Http::ResponseHeaderMap& headers) {
+  const Http::HeaderEntry* content_type = headers.ContentType();
+  if (content_type == nullptr) {
+    return {};
+  }
+  return StringUtil::trim(StringUtil::cropRight(content_type->value().getStringView(), ";"));
+}
+
 void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compressor,
                             const CompressorStats& stats, Buffer::Instance& data, bool end_stream) {
   ASSERT(compressor != nullptr);
@@ -86,7 +98,8 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
 CompressorFilterConfig::CompressorFilterConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-    Compression::Compressor::CompressorFactoryPtr compressor_factory)
+    Compression::Compressor::CompressorFactoryPtr compressor_factory,
+    OptRef<Server::OverloadManager> overload_manager)
     : common_stats_prefix_(fmt::format("{}compressor.{}.{}", stats_prefix,
                                        proto_config.compressor_library().name(),
                                        compressor_factory->statsPrefix())),
@@ -94,7 +107,7 @@ CompressorFilterConfig::CompressorFilterConfig(
       response_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       content_encoding_(compressor_factory->contentEncoding()),
       compressor_factory_(std::move(compressor_factory)),
-      choose_first_(proto_config.choose_first()) {}
+      choose_first_(proto_config.choose_first()), overload_manager_(overload_manager) {}
 
 StringUtil::CaseUnorderedSet CompressorFilterConfig::DirectionConfig::contentTypeSet(
     const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -130,7 +143,52 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
           proto_config.has_response_direction_config()
               ? proto_config.response_direction_config().remove_accept_encoding_header()
               : proto_config.remove_accept_encoding_header()),
-      response_stats_{generateResponseStats(stats_prefix, scope)} {}
+      response_stats_{generateResponseStats(stats_prefix, scope)},
+      min_savings_permille_(static_cast<uint32_t>(
+          proto_config.response_direction_config().min_compression_savings().value() * 10)) {
+  if (proto_config.response_direction_config().has_min_compression_savings()) {
+    for (const std::string& content_type : contentTypeValues()) {
+      savings_estimates_.emplace(absl::AsciiStrToLower(content_type),
+                                 std::make_unique<SavingsEstimate>());
+    }
+  }
+}
+
+CompressorFilterConfig::ResponseDirectionConfig::SavingsEstimate*
+CompressorFilterConfig::ResponseDirectionConfig::savingsEstimate(
+    const Http::ResponseHeaderMap& headers) const {
+  if (savings_estimates_.empty()) {
+    return nullptr;
+  }
+  auto it = savings_estimates_.find(absl::AsciiStrToLower(contentTypeValue(headers)));
+  return it == savings_estimates_.end() ? nullptr : it->second.get();
+}
+
+void CompressorFilterConfig::ResponseDirectionConfig::SavingsEstimate::record(
+    uint64_t uncompressed_bytes, uint64_t compressed_bytes) {
+  if (uncompressed_bytes == 0) {
+    return;
+  }
+  const uint32_t savings =
+      compressed_bytes >= uncompressed_bytes
+          ? 0
+          : static_cast<uint32_t>((uncompressed_bytes - compressed_bytes) * 1000 /
+                                  uncompressed_bytes);
+  const uint32_t previous = savings_permille_.load(std::memory_order_relaxed);
+  // An exponentially weighted moving average, weighing the latest response by 1/8.
+  savings_permille_.store(previous == Unknown ? savings : (previous * 7 + savings) / 8,
+                          std::memory_order_relaxed);
+}
+
+bool CompressorFilterConfig::ResponseDirectionConfig::SavingsEstimate::isBelow(
+    uint32_t min_savings_permille) {
+  const uint32_t savings = savings_permille_.load(std::memory_order_relaxed);
+  if (savings == Unknown || savings >= min_savings_permille) {
+    return false;
+  }
+  // Every SampleInterval-th response is still compressed, so that the estimate follows changes.
+  return (skipped_.fetch_add(1, std::memory_order_relaxed) + 1) % SampleInterval != 0;
+}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
 CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
@@ -163,6 +221,24 @@ Envoy::Compression::Compressor::CompressorPtr CompressorFilterConfig::makeCompre
   return compressor_factory_->createCompressor();
 }
 
+Envoy::Compression::Compressor::CompressorPtr
+CompressorFilterConfig::makeCompressor(float effort) {
+  if (effort >= 1) {
+    return compressor_factory_->createCompressor();
+  }
+  return compressor_factory_->createCompressorWithEffort(effort);
+}
+
+float CompressorFilterConfig::compressionEffort() const {
+  if (!overload_manager_.has_value()) {
+    return 1;
+  }
+  const Server::OverloadActionState state =
+      overload_manager_->getThreadLocalOverloadState().getState(
+          Server::OverloadActionNames::get().ReduceCompressionEffort);
+  return state.isSaturated() ? 0 : 1 - state.value().value();
+}
+
 CompressorFilter::CompressorFilter(const CompressorFilterConfigSharedPtr config)
     : config_(std::move(config)) {}
 
@@ -276,13 +352,16 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       config.isContentTypeAllowed(headers) && !hasCacheControlNoTransform(headers) &&
       isEtagAllowed(headers) && !headers.getInline(response_content_encoding_handle.handle());
   if (!end_stream && isAcceptEncodingAllowed(isEnabledAndContentLengthBigEnough, headers) &&
-      isCompressible && isTransferEncodingAllowed(headers)) {
+      isCompressible && isTransferEncodingAllowed(headers) && isCompressionWorthwhile(headers)) {
     sanitizeEtagHeader(headers);
     headers.removeContentLength();
     headers.setInline(response_content_encoding_handle.handle(), config_->contentEncoding());
     config.stats().compressed_.inc();
+    if (response_compression_effort_ < 1) {
+      config.responseStats().compressed_with_reduced_effort_.inc();
+    }
     // Finally instantiate the compressor.
-    response_compressor_ = config_->makeCompressor();
+    response_compressor_ = config_->makeCompressor(response_compression_effort_);
   } else {
     config.stats().not_compressed_.inc();
   }
@@ -299,8 +378,10 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
   if (response_compressor_ != nullptr) {
+    const uint64_t uncompressed_bytes = data.length();
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
+    recordResponseSavings(uncompressed_bytes, data.length(), end_stream);
   }
   return Http::FilterDataStatus::Continue;
 }
@@ -313,11 +394,41 @@ Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTraile
     // that the stream is ended.
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(),
                            empty_buffer, true);
+    recordResponseSavings(0, empty_buffer.length(), true);
     encoder_callbacks_->addEncodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+bool CompressorFilter::isCompressionWorthwhile(const Http::ResponseHeaderMap& headers) {
+  const auto& config = config_->responseDirectionConfig();
+  response_compression_effort_ = config_->compressionEffort();
+  if (response_compression_effort_ <= 0) {
+    config.responseStats().not_compressed_overload_.inc();
+    return false;
+  }
+  savings_estimate_ = config.savingsEstimate(headers);
+  if (savings_estimate_ != nullptr && savings_estimate_->isBelow(config.minSavingsPermille())) {
+    config.responseStats().not_compressed_low_savings_.inc();
+    savings_estimate_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void CompressorFilter::recordResponseSavings(uint64_t uncompressed_bytes,
+                                             uint64_t compressed_bytes, bool end_stream) {
+  if (savings_estimate_ == nullptr) {
+    return;
+  }
+  response_uncompressed_bytes_ += uncompressed_bytes;
+  response_compressed_bytes_ += compressed_bytes;
+  if (end_stream) {
+    savings_estimate_->record(response_uncompressed_bytes_, response_compressed_bytes_);
+    savings_estimate_ = nullptr;
+  }
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -338,13 +449,7 @@ std::unique_ptr<CompressorFilter::EncodingDecision>
 CompressorFilter::chooseEncoding(const Http::ResponseHeaderMap& headers) const {
   using EncPair = std::pair<absl::string_view, float>; // pair of {encoding, q_value}
   std::vector<EncPair> pairs;
-  absl::string_view content_type_value;
-
-  const Http::HeaderEntry* content_type = headers.ContentType();
-  if (content_type != nullptr) {
-    content_type_value =
-        StringUtil::trim(StringUtil::cropRight(content_type->value().getStringView(), ";"));
-  }
+  const absl::string_view content_type_value = contentTypeValue(headers);
 
   // Find all compressors enabled for the filter chain.
   std::map<std::string, CompressorInChain> allowed_compressors;
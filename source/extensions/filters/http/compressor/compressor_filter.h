@@ -1,13 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "envoy/common/optref.h"
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
+#include "envoy/server/overload/overload_manager.h"
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -47,7 +55,10 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(not_compressed_overload)                                                                 \
+  COUNTER(not_compressed_low_savings)                                                              \
+  COUNTER(compressed_with_reduced_effort)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -113,6 +124,25 @@ public:
 
   class ResponseDirectionConfig : public DirectionConfig {
   public:
+    /**
+     * A moving average of how much compression shrinks the responses of a content type, shared
+     * by the workers. Updates racing with each other may be lost, which is fine for an estimate.
+     */
+    class SavingsEstimate {
+    public:
+      void record(uint64_t uncompressed_bytes, uint64_t compressed_bytes);
+      // Returns true if the responses shrink by less than min_savings_permille on average, except
+      // for one in SampleInterval calls, so that the estimate is kept current.
+      bool isBelow(uint32_t min_savings_permille);
+
+    private:
+      static constexpr uint32_t Unknown = std::numeric_limits<uint32_t>::max();
+      static constexpr uint32_t SampleInterval = 16;
+
+      std::atomic<uint32_t> savings_permille_{Unknown};
+      std::atomic<uint32_t> skipped_{0};
+    };
+
     ResponseDirectionConfig(
         const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
         const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime);
@@ -121,6 +151,9 @@ public:
     const ResponseCompressorStats& responseStats() const { return response_stats_; }
     bool disableOnEtagHeader() const { return disable_on_etag_header_; }
     bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
+    // Returns nullptr if savings are not estimated for the content type of the response.
+    SavingsEstimate* savingsEstimate(const Http::ResponseHeaderMap& headers) const;
+    uint32_t minSavingsPermille() const { return min_savings_permille_; }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -136,15 +169,24 @@ public:
     const bool disable_on_etag_header_;
     const bool remove_accept_encoding_header_;
     const ResponseCompressorStats response_stats_;
+    const uint32_t min_savings_permille_;
+    // Keyed by the lower case content types. Built once, so lookups need no lock.
+    absl::flat_hash_map<std::string, std::unique_ptr<SavingsEstimate>> savings_estimates_;
   };
 
   CompressorFilterConfig() = delete;
   CompressorFilterConfig(
       const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
+      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory,
+      OptRef<Server::OverloadManager> overload_manager = {});
 
   Envoy::Compression::Compressor::CompressorPtr makeCompressor();
+  // @see Envoy::Compression::Compressor::CompressorFactory::createCompressorWithEffort().
+  Envoy::Compression::Compressor::CompressorPtr makeCompressor(float effort);
+  // Returns the fraction of the configured compression effort the overload manager allows on the
+  // current worker, which is zero if responses should not be compressed at all.
+  float compressionEffort() const;
 
   const std::string contentEncoding() const { return content_encoding_; };
   bool chooseFirst() const { return choose_first_; };
@@ -159,6 +201,7 @@ private:
   const std::string content_encoding_;
   const Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory_;
   const bool choose_first_;
+  const OptRef<Server::OverloadManager> overload_manager_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -201,6 +244,9 @@ private:
   bool isAcceptEncodingAllowed(bool maybe_compress, const Http::ResponseHeaderMap& headers) const;
   bool isEtagAllowed(Http::ResponseHeaderMap& headers) const;
   bool isTransferEncodingAllowed(Http::RequestOrResponseHeaderMap& headers) const;
+  bool isCompressionWorthwhile(const Http::ResponseHeaderMap& headers);
+  void recordResponseSavings(uint64_t uncompressed_bytes, uint64_t compressed_bytes,
+                             bool end_stream);
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
   void insertVaryHeader(Http::ResponseHeaderMap& headers);
@@ -230,6 +276,11 @@ private:
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  // Set from the overload state when the response headers are encoded.
+  float response_compression_effort_{1};
+  CompressorFilterConfig::ResponseDirectionConfig::SavingsEstimate* savings_estimate_{};
+  uint64_t response_uncompressed_bytes_{};
+  uint64_t response_compressed_bytes_{};
 };
 
 } // namespace Compressor
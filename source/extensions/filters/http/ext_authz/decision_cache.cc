@@ -0,0 +1,183 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include <algorithm>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/crypto/utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+constexpr uint32_t DefaultMaxEntriesPerWorker = 1024;
+constexpr uint32_t DefaultMaxSharedEntries = 16384;
+constexpr uint32_t DefaultMaxDeniedEntries = 128;
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+// Appends a value prefixed by its length, so that different sequences of values never produce
+// the same key material.
+void appendValue(std::string& material, absl::string_view value) {
+  absl::StrAppend(&material, value.size(), ":", value);
+}
+
+} // namespace
+
+DecisionLru::DecisionLru(uint32_t max_entries, uint32_t max_denied_entries)
+    : allowed_(max_entries), denied_(max_denied_entries) {}
+
+absl::optional<CachedDecision> DecisionLru::lookup(LruCache& cache, const std::string& key,
+                                                   MonotonicTime now) {
+  LruCache::ScopedLookup lookup(&cache, key);
+  if (!lookup.found()) {
+    return absl::nullopt;
+  }
+  if (lookup.value()->expiry_ <= now) {
+    cache.remove(key);
+    return absl::nullopt;
+  }
+  return *lookup.value();
+}
+
+absl::optional<CachedDecision> DecisionLru::lookup(const std::string& key, MonotonicTime now) {
+  absl::optional<CachedDecision> decision = lookup(allowed_, key, now);
+  if (!decision.has_value()) {
+    decision = lookup(denied_, key, now);
+  }
+  return decision;
+}
+
+void DecisionLru::insert(const std::string& key, const CachedDecision& decision) {
+  // A key has a single decision, so a new decision replaces the one of the other kind.
+  allowed_.remove(key);
+  denied_.remove(key);
+  LruCache& cache = decision.response_->status == CheckStatus::OK ? allowed_ : denied_;
+  cache.insert(key, new CachedDecision(decision), 1);
+}
+
+DecisionCache::DecisionCache(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : key_headers_(config.key_headers().begin(), config.key_headers().end()),
+      ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      denied_ttl_(config.has_denied_ttl() ? absl::make_optional(std::chrono::milliseconds(
+                                                PROTOBUF_GET_MS_REQUIRED(config, denied_ttl)))
+                                          : absl::nullopt),
+      ttl_header_(config.ttl_header().empty()
+                      ? absl::nullopt
+                      : absl::make_optional(Http::LowerCaseString(config.ttl_header()))),
+      time_source_(time_source), tls_(tls),
+      shared_decisions_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_shared_entries, DefaultMaxSharedEntries),
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_denied_entries, DefaultMaxDeniedEntries)) {
+  const uint32_t max_entries =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries_per_worker, DefaultMaxEntriesPerWorker);
+  const uint32_t max_denied_entries =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_denied_entries, DefaultMaxDeniedEntries);
+  tls_.set([max_entries, max_denied_entries](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalDecisions>(max_entries, max_denied_entries);
+  });
+}
+
+std::string
+DecisionCache::key(const Http::RequestHeaderMap& headers,
+                   const Protobuf::Map<std::string, std::string>& context_extensions) const {
+  std::string material;
+  for (const Http::LowerCaseString& name : key_headers_) {
+    const auto values = headers.get(name);
+    absl::StrAppend(&material, values.size(), ";");
+    for (size_t i = 0; i < values.size(); ++i) {
+      appendValue(material, values[i]->value().getStringView());
+    }
+  }
+  // The map has no stable order, so the extensions are sorted by name.
+  std::vector<std::pair<absl::string_view, absl::string_view>> extensions(
+      context_extensions.begin(), context_extensions.end());
+  std::sort(extensions.begin(), extensions.end());
+  for (const auto& [name, value] : extensions) {
+    appendValue(material, name);
+    appendValue(material, value);
+  }
+  const std::vector<uint8_t> digest = Common::Crypto::UtilitySingleton::get().getSha256Digest(
+      Buffer::OwnedImpl(material.data(), material.size()));
+  return {digest.begin(), digest.end()};
+}
+
+Filters::Common::ExtAuthz::ResponsePtr DecisionCache::lookup(const std::string& key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  DecisionLru& local_decisions = tls_->decisions_;
+  absl::optional<CachedDecision> decision = local_decisions.lookup(key, now);
+  if (!decision.has_value()) {
+    {
+      absl::MutexLock lock(&mutex_);
+      decision = shared_decisions_.lookup(key, now);
+    }
+    if (!decision.has_value()) {
+      return nullptr;
+    }
+    local_decisions.insert(key, *decision);
+  }
+  return std::make_unique<Response>(*decision->response_);
+}
+
+void DecisionCache::insert(const std::string& key, Response& response) {
+  const absl::optional<std::chrono::seconds> server_ttl = takeServerTtl(response);
+  absl::optional<std::chrono::milliseconds> ttl;
+  switch (response.status) {
+  case CheckStatus::OK:
+    ttl = ttl_;
+    break;
+  case CheckStatus::Denied:
+    ttl = denied_ttl_;
+    break;
+  case CheckStatus::Error:
+    break;
+  }
+  if (!ttl.has_value()) {
+    return;
+  }
+  if (server_ttl.has_value()) {
+    ttl = std::min<std::chrono::milliseconds>(*ttl, *server_ttl);
+  }
+  if (ttl->count() == 0) {
+    return;
+  }
+
+  const CachedDecision decision{std::make_shared<const Response>(response),
+                                time_source_.monotonicTime() + *ttl};
+  tls_->decisions_.insert(key, decision);
+  absl::MutexLock lock(&mutex_);
+  shared_decisions_.insert(key, decision);
+}
+
+absl::optional<std::chrono::seconds> DecisionCache::takeServerTtl(Response& response) const {
+  if (!ttl_header_.has_value()) {
+    return absl::nullopt;
+  }
+  absl::optional<std::chrono::seconds> server_ttl;
+  auto& headers = response.headers_to_set;
+  for (auto it = headers.begin(); it != headers.end();) {
+    if (it->first != *ttl_header_) {
+      ++it;
+      continue;
+    }
+    uint32_t seconds;
+    if (!server_ttl.has_value() && absl::SimpleAtoi(it->second, &seconds)) {
+      server_ttl = std::chrono::seconds(seconds);
+    }
+    it = headers.erase(it);
+  }
+  return server_ttl;
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
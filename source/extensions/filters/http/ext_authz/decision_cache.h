@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * A decision of the authorization server, and when it stops being used.
+ */
+struct CachedDecision {
+  std::shared_ptr<const Filters::Common::ExtAuthz::Response> response_;
+  MonotonicTime expiry_;
+};
+
+/**
+ * Decisions in least recently used order. The denials are kept apart, so that they can't evict
+ * the decisions allowing requests.
+ */
+class DecisionLru {
+public:
+  DecisionLru(uint32_t max_entries, uint32_t max_denied_entries);
+
+  absl::optional<CachedDecision> lookup(const std::string& key, MonotonicTime now);
+  void insert(const std::string& key, const CachedDecision& decision);
+
+private:
+  using LruCache = ::google::simple_lru_cache::SimpleLRUCache<std::string, CachedDecision>;
+
+  static absl::optional<CachedDecision> lookup(LruCache& cache, const std::string& key,
+                                               MonotonicTime now);
+
+  LruCache allowed_;
+  LruCache denied_;
+};
+
+/**
+ * Caches the decisions of the authorization server in a cache per worker thread, backed by a
+ * cache shared between the workers. Decisions are keyed by the hash of configured request headers
+ * and of the context extensions of the route.
+ */
+class DecisionCache {
+public:
+  DecisionCache(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the key of the decisions for a request.
+   */
+  std::string key(const Http::RequestHeaderMap& headers,
+                  const Protobuf::Map<std::string, std::string>& context_extensions) const;
+
+  /**
+   * @return a copy of the decision cached for the key, or nullptr if there is none. Must be
+   * called on a worker thread.
+   */
+  Filters::Common::ExtAuthz::ResponsePtr lookup(const std::string& key);
+
+  /**
+   * Caches the decision for the key if its status and TTL allow it. The TTL header, if set, is
+   * removed from the response. Must be called on a worker thread.
+   */
+  void insert(const std::string& key, Filters::Common::ExtAuthz::Response& response);
+
+private:
+  struct ThreadLocalDecisions : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalDecisions(uint32_t max_entries, uint32_t max_denied_entries)
+        : decisions_(max_entries, max_denied_entries) {}
+    DecisionLru decisions_;
+  };
+
+  // Returns the TTL set by the server in the TTL header, and removes the header.
+  absl::optional<std::chrono::seconds>
+  takeServerTtl(Filters::Common::ExtAuthz::Response& response) const;
+
+  const std::vector<Http::LowerCaseString> key_headers_;
+  const std::chrono::milliseconds ttl_;
+  const absl::optional<std::chrono::milliseconds> denied_ttl_;
+  const absl::optional<Http::LowerCaseString> ttl_header_;
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlot<ThreadLocalDecisions> tls_;
+  absl::Mutex mutex_;
+  DecisionLru shared_decisions_ ABSL_GUARDED_BY(mutex_);
+};
+
+using DecisionCacheSharedPtr = std::shared_ptr<DecisionCache>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -41,6 +41,24 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     context_extensions = maybe_merged_per_route_config.value().takeContextExtensions();
   }
 
+  if (decision_cache_ != nullptr) {
+    decision_cache_key_ = decision_cache_->key(headers, context_extensions);
+    Filters::Common::ExtAuthz::ResponsePtr cached_response =
+        decision_cache_->lookup(decision_cache_key_);
+    if (cached_response != nullptr) {
+      ENVOY_STREAM_LOG(trace, "ext_authz filter using a cached decision", *decoder_callbacks_);
+      stats_.decision_cache_hits_.inc();
+      filter_return_ = FilterReturn::StopDecoding;
+      cluster_ = decoder_callbacks_->clusterInfo();
+      // The decision is applied as if the authorization server responded right away.
+      initiating_call_ = true;
+      onComplete(std::move(cached_response));
+      initiating_call_ = false;
+      return;
+    }
+    stats_.decision_cache_misses_.inc();
+  }
+
   envoy::config::core::v3::Metadata metadata_context;
 
   // If metadata_context_namespaces is specified, pass matching filter metadata to the ext_authz
@@ -222,6 +240,9 @@ void Filter::onDestroy() {
 }
 
 void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
+  if (decision_cache_ != nullptr && state_ == State::Calling) {
+    decision_cache_->insert(decision_cache_key_, *response);
+  }
   state_ = State::Complete;
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
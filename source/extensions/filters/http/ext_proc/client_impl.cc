@@ -1,5 +1,7 @@
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -68,6 +70,192 @@ void ExternalProcessorStreamImpl::onRemoteClose(Grpc::Status::GrpcStatus status,
   }
 }
 
+SharedProcessorStream::SharedProcessorStream(
+    Grpc::AsyncClient<ProcessingRequest, ProcessingResponse>&& client,
+    uint32_t max_pending_messages, TimeSource& time_source, Stats::Histogram& queue_time,
+    Stats::Counter& unmatched_responses)
+    : client_(std::move(client)), max_pending_messages_(max_pending_messages),
+      time_source_(time_source), queue_time_(queue_time),
+      unmatched_responses_(unmatched_responses) {
+  auto descriptor = Protobuf::DescriptorPool::generated_pool()->FindMethodByName(kExternalMethod);
+  // The stream outlives the requests using it, so it has no parent context.
+  stream_ = client_.start(*descriptor, *this, Http::AsyncClient::StreamOptions());
+  if (stream_ == nullptr && !close_status_.has_value()) {
+    close_status_ = Grpc::Status::Unavailable;
+  }
+}
+
+SharedProcessorStream::~SharedProcessorStream() {
+  for (auto& [request_id, attached] : attached_) {
+    attached.stream_->onSharedStreamGone();
+  }
+  if (!close_status_.has_value()) {
+    stream_.resetStream();
+  }
+}
+
+void SharedProcessorStream::attach(uint64_t request_id, MultiplexedProcessorStream& stream) {
+  attached_.emplace(request_id, AttachedRequest{&stream, 0});
+}
+
+void SharedProcessorStream::detach(uint64_t request_id) {
+  auto it = attached_.find(request_id);
+  if (it == attached_.end()) {
+    return;
+  }
+  // Responses to the messages still pending will be ignored.
+  pending_messages_ -= it->second.pending_messages_;
+  attached_.erase(it);
+  queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+                              [request_id](const QueuedMessage& message) {
+                                return message.request_id_ == request_id;
+                              }),
+               queue_.end());
+  sendQueuedMessages();
+}
+
+void SharedProcessorStream::send(uint64_t request_id, ProcessingRequest&& request) {
+  request.set_multiplexed_request_id(request_id);
+  QueuedMessage message{request_id, std::move(request), time_source_.monotonicTime()};
+  if (max_pending_messages_ > 0 && pending_messages_ >= max_pending_messages_) {
+    queue_.push_back(std::move(message));
+    return;
+  }
+  sendNow(std::move(message));
+}
+
+void SharedProcessorStream::sendQueuedMessages() {
+  while (!queue_.empty() && pending_messages_ < max_pending_messages_) {
+    QueuedMessage message = std::move(queue_.front());
+    queue_.pop_front();
+    sendNow(std::move(message));
+  }
+}
+
+void SharedProcessorStream::sendNow(QueuedMessage&& message) {
+  auto it = attached_.find(message.request_id_);
+  ASSERT(it != attached_.end());
+  ++it->second.pending_messages_;
+  ++pending_messages_;
+  queue_time_.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                              time_source_.monotonicTime() - message.queued_at_)
+                              .count());
+  stream_.sendMessage(message.request_, false);
+}
+
+void SharedProcessorStream::onReceiveMessage(ProcessingResponsePtr&& response) {
+  auto it = attached_.find(response->multiplexed_request_id());
+  if (it == attached_.end()) {
+    // The request has ended, most likely after its message timed out.
+    ENVOY_LOG(debug, "Ignoring response for unknown multiplexed request {}",
+              response->multiplexed_request_id());
+    unmatched_responses_.inc();
+    return;
+  }
+  if (it->second.pending_messages_ > 0) {
+    --it->second.pending_messages_;
+    --pending_messages_;
+  }
+  ExternalProcessorCallbacks& callbacks = it->second.stream_->callbacks();
+  sendQueuedMessages();
+  callbacks.onReceiveMessage(std::move(response));
+}
+
+void SharedProcessorStream::onRemoteClose(Grpc::Status::GrpcStatus status,
+                                          const std::string& message) {
+  ENVOY_LOG(debug, "Shared gRPC stream closed remotely with status {}: {}", status, message);
+  close_status_ = status;
+  // The callbacks may close the streams of the requests, which detach from this one.
+  absl::flat_hash_map<uint64_t, AttachedRequest> attached;
+  attached.swap(attached_);
+  queue_.clear();
+  pending_messages_ = 0;
+  for (auto& [request_id, request] : attached) {
+    request.stream_->onSharedStreamGone();
+    if (status == Grpc::Status::Ok) {
+      request.stream_->callbacks().onGrpcClose();
+    } else {
+      request.stream_->callbacks().onGrpcError(status);
+    }
+  }
+}
+
+MultiplexedProcessorStream::MultiplexedProcessorStream(SharedProcessorStream& shared_stream,
+                                                       uint64_t request_id,
+                                                       ExternalProcessorCallbacks& callbacks)
+    : shared_stream_(&shared_stream), request_id_(request_id), callbacks_(callbacks) {
+  shared_stream.attach(request_id, *this);
+}
+
+void MultiplexedProcessorStream::send(ProcessingRequest&& request, bool) {
+  if (shared_stream_ != nullptr) {
+    shared_stream_->send(request_id_, std::move(request));
+  }
+}
+
+bool MultiplexedProcessorStream::close() {
+  if (shared_stream_ == nullptr) {
+    return false;
+  }
+  shared_stream_->detach(request_id_);
+  shared_stream_ = nullptr;
+  return true;
+}
+
+MultiplexedStreamPool::MultiplexedStreamPool(
+    Grpc::AsyncClientManager& client_manager, Stats::Scope& scope, Event::Dispatcher& dispatcher,
+    const envoy::extensions::filters::http::ext_proc::v3::StreamMultiplexing& config,
+    Stats::Histogram& queue_time, Stats::Counter& unmatched_responses)
+    : client_manager_(client_manager), scope_(scope), dispatcher_(dispatcher),
+      streams_per_worker_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, streams_per_worker, 1)),
+      max_pending_messages_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_pending_messages_per_stream, 0)),
+      queue_time_(queue_time), unmatched_responses_(unmatched_responses) {}
+
+ExternalProcessorStreamPtr
+MultiplexedStreamPool::start(ExternalProcessorCallbacks& callbacks,
+                             const envoy::config::core::v3::GrpcService& grpc_service) {
+  SharedProcessorStream& shared_stream = pickStream(grpc_service);
+  if (shared_stream.closeStatus().has_value()) {
+    // The stream couldn't be started. Report it as the stream of the request would have.
+    callbacks.onGrpcError(shared_stream.closeStatus().value());
+    return nullptr;
+  }
+  return std::make_unique<MultiplexedProcessorStream>(shared_stream, next_request_id_++,
+                                                      callbacks);
+}
+
+SharedProcessorStream&
+MultiplexedStreamPool::pickStream(const envoy::config::core::v3::GrpcService& grpc_service) {
+  std::vector<std::unique_ptr<SharedProcessorStream>>& streams = streams_[grpc_service];
+  SharedProcessorStream* picked = nullptr;
+  for (auto& stream : streams) {
+    if (stream->closeStatus().has_value()) {
+      // Streams are replaced once closed. The closed one may still be running its callbacks.
+      dispatcher_.deferredDelete(std::move(stream));
+      stream = newStream(grpc_service);
+    }
+    if (picked == nullptr || stream->attachedRequests() < picked->attachedRequests()) {
+      picked = stream.get();
+    }
+  }
+  // Streams are opened as they are needed, up to the configured number.
+  if (streams.size() < streams_per_worker_ &&
+      (picked == nullptr || picked->attachedRequests() > 0)) {
+    streams.push_back(newStream(grpc_service));
+    picked = streams.back().get();
+  }
+  return *picked;
+}
+
+std::unique_ptr<SharedProcessorStream>
+MultiplexedStreamPool::newStream(const envoy::config::core::v3::GrpcService& grpc_service) {
+  return std::make_unique<SharedProcessorStream>(
+      Grpc::AsyncClient<ProcessingRequest, ProcessingResponse>(
+          client_manager_.getOrCreateRawAsyncClient(grpc_service, scope_, true)),
+      max_pending_messages_, dispatcher_.timeSource(), queue_time_, unmatched_responses_);
+}
+
 } // namespace ExternalProcessing
 } // namespace HttpFilters
 } // namespace Extensions
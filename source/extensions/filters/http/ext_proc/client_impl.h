@@ -1,16 +1,27 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "envoy/common/time.h"
 #include "envoy/config/core/v3/grpc_service.pb.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/filters/http/ext_proc/v3/ext_proc.pb.h"
 #include "envoy/grpc/async_client_manager.h"
 #include "envoy/service/ext_proc/v3/external_processor.pb.h"
 #include "envoy/stats/scope.h"
+#include "envoy/stats/stats.h"
+#include "envoy/thread_local/thread_local_object.h"
 
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/ext_proc/client.h"
 
+#include "absl/container/flat_hash_map.h"
+
 using envoy::service::ext_proc::v3::ProcessingRequest;
 using envoy::service::ext_proc::v3::ProcessingResponse;
 
@@ -63,6 +74,138 @@ private:
   bool stream_closed_ = false;
 };
 
+class MultiplexedProcessorStream;
+
+/**
+ * A gRPC stream to an external processor which carries the messages of many HTTP requests,
+ * each identified by the multiplexed_request_id of the messages.
+ */
+class SharedProcessorStream : public Grpc::AsyncStreamCallbacks<ProcessingResponse>,
+                              public Event::DeferredDeletable,
+                              public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  SharedProcessorStream(Grpc::AsyncClient<ProcessingRequest, ProcessingResponse>&& client,
+                        uint32_t max_pending_messages, TimeSource& time_source,
+                        Stats::Histogram& queue_time, Stats::Counter& unmatched_responses);
+  ~SharedProcessorStream() override;
+
+  void attach(uint64_t request_id, MultiplexedProcessorStream& stream);
+  void detach(uint64_t request_id);
+  void send(uint64_t request_id, ProcessingRequest&& request);
+
+  // Returns the status the stream was closed with, or nullopt if it is still open.
+  const absl::optional<Grpc::Status::GrpcStatus>& closeStatus() const { return close_status_; }
+  size_t attachedRequests() const { return attached_.size(); }
+
+  // AsyncStreamCallbacks
+  void onReceiveMessage(ProcessingResponsePtr&& message) override;
+
+  // RawAsyncStreamCallbacks
+  void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+  void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
+  void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
+  void onRemoteClose(Grpc::Status::GrpcStatus status, const std::string& message) override;
+
+private:
+  struct AttachedRequest {
+    MultiplexedProcessorStream* stream_;
+    // The messages of the request sent and awaiting a response.
+    uint32_t pending_messages_;
+  };
+  struct QueuedMessage {
+    uint64_t request_id_;
+    ProcessingRequest request_;
+    MonotonicTime queued_at_;
+  };
+
+  void sendQueuedMessages();
+  void sendNow(QueuedMessage&& message);
+
+  Grpc::AsyncClient<ProcessingRequest, ProcessingResponse> client_;
+  Grpc::AsyncStream<ProcessingRequest> stream_;
+  const uint32_t max_pending_messages_;
+  TimeSource& time_source_;
+  Stats::Histogram& queue_time_;
+  Stats::Counter& unmatched_responses_;
+  absl::flat_hash_map<uint64_t, AttachedRequest> attached_;
+  std::deque<QueuedMessage> queue_;
+  uint32_t pending_messages_{};
+  absl::optional<Grpc::Status::GrpcStatus> close_status_;
+};
+
+/**
+ * The stream of a single HTTP request over a SharedProcessorStream.
+ */
+class MultiplexedProcessorStream : public ExternalProcessorStream {
+public:
+  MultiplexedProcessorStream(SharedProcessorStream& shared_stream, uint64_t request_id,
+                             ExternalProcessorCallbacks& callbacks);
+  ~MultiplexedProcessorStream() override { close(); }
+
+  // ExternalProcessorStream
+  // The shared stream stays open when the request ends, so end_stream is ignored.
+  void send(ProcessingRequest&& request, bool end_stream) override;
+  bool close() override;
+
+  ExternalProcessorCallbacks& callbacks() { return callbacks_; }
+  // Called when the shared stream is closed remotely, or destroyed.
+  void onSharedStreamGone() { shared_stream_ = nullptr; }
+
+private:
+  SharedProcessorStream* shared_stream_;
+  const uint64_t request_id_;
+  ExternalProcessorCallbacks& callbacks_;
+};
+
+/**
+ * The shared gRPC streams of a worker thread, for each external processing service.
+ */
+class MultiplexedStreamPool : public ThreadLocal::ThreadLocalObject {
+public:
+  MultiplexedStreamPool(
+      Grpc::AsyncClientManager& client_manager, Stats::Scope& scope, Event::Dispatcher& dispatcher,
+      const envoy::extensions::filters::http::ext_proc::v3::StreamMultiplexing& config,
+      Stats::Histogram& queue_time, Stats::Counter& unmatched_responses);
+
+  ExternalProcessorStreamPtr start(ExternalProcessorCallbacks& callbacks,
+                                   const envoy::config::core::v3::GrpcService& grpc_service);
+
+private:
+  SharedProcessorStream& pickStream(const envoy::config::core::v3::GrpcService& grpc_service);
+  std::unique_ptr<SharedProcessorStream>
+  newStream(const envoy::config::core::v3::GrpcService& grpc_service);
+
+  Grpc::AsyncClientManager& client_manager_;
+  Stats::Scope& scope_;
+  Event::Dispatcher& dispatcher_;
+  const uint32_t streams_per_worker_;
+  const uint32_t max_pending_messages_;
+  Stats::Histogram& queue_time_;
+  Stats::Counter& unmatched_responses_;
+  absl::flat_hash_map<envoy::config::core::v3::GrpcService,
+                      std::vector<std::unique_ptr<SharedProcessorStream>>, MessageUtil,
+                      MessageUtil>
+      streams_;
+  uint64_t next_request_id_{1};
+};
+
+/**
+ * A client which multiplexes the streams of the requests over the shared streams of a pool.
+ */
+class MultiplexedExternalProcessorClient : public ExternalProcessorClient {
+public:
+  explicit MultiplexedExternalProcessorClient(MultiplexedStreamPool& pool) : pool_(pool) {}
+
+  ExternalProcessorStreamPtr start(ExternalProcessorCallbacks& callbacks,
+                                   const envoy::config::core::v3::GrpcService& grpc_service,
+                                   const StreamInfo::StreamInfo&) override {
+    return pool_.start(callbacks, grpc_service);
+  }
+
+private:
+  MultiplexedStreamPool& pool_;
+};
+
 } // namespace ExternalProcessing
 } // namespace HttpFilters
 } // namespace Extensions
@@ -1,5 +1,7 @@
 #include "source/extensions/filters/http/ext_proc/config.h"
 
+#include "envoy/thread_local/thread_local.h"
+
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 #include "source/extensions/filters/http/ext_proc/ext_proc.h"
 
@@ -16,6 +18,25 @@ Http::FilterFactoryCb ExternalProcessingFilterConfig::createFilterFactoryFromPro
   const auto filter_config = std::make_shared<FilterConfig>(
       proto_config, std::chrono::milliseconds(message_timeout_ms), context.scope(), stats_prefix);
 
+  if (proto_config.has_stream_multiplexing()) {
+    // Each worker has its own shared streams, which outlive the requests using them.
+    auto pools = ThreadLocal::TypedSlot<MultiplexedStreamPool>::makeUnique(context.threadLocal());
+    pools->set([filter_config, multiplexing = proto_config.stream_multiplexing(),
+                &context](Event::Dispatcher& dispatcher) {
+      return std::make_shared<MultiplexedStreamPool>(
+          context.clusterManager().grpcAsyncClientManager(), context.scope(), dispatcher,
+          multiplexing, filter_config->stats().multiplexed_queue_time_us_,
+          filter_config->stats().spurious_msgs_received_);
+    });
+    return [filter_config, grpc_service = proto_config.grpc_service(),
+            pools = std::shared_ptr<ThreadLocal::TypedSlot<MultiplexedStreamPool>>(
+                std::move(pools))](Http::FilterChainFactoryCallbacks& callbacks) {
+      auto client = std::make_unique<MultiplexedExternalProcessorClient>(**pools);
+      callbacks.addStreamFilter(Http::StreamFilterSharedPtr{
+          std::make_shared<Filter>(filter_config, std::move(client), grpc_service)});
+    };
+  }
+
   return [filter_config, grpc_service = proto_config.grpc_service(),
           &context](Http::FilterChainFactoryCallbacks& callbacks) {
     auto client = std::make_unique<ExternalProcessorClientImpl>(
@@ -307,10 +307,17 @@ FilterDataStatus Filter::onData(ProcessorState& state, Buffer::Instance& data, b
       // Fall through
       break;
     }
-    // Send the chunk on the gRPC stream
-    sendBodyChunk(state, data, ProcessorState::CallbackState::StreamedBodyCallback, end_stream);
-    // Move the data to the queue and optionally raise the watermark.
-    state.enqueueStreamingChunk(data, end_stream, true);
+    if (state.streamedBodyWindowed()) {
+      // Queue the chunk, and send it along with any earlier chunks that were held back if
+      // there is room in the window of data awaiting a response.
+      state.enqueueStreamingChunk(data, end_stream, false);
+      state.sendStreamedChunks();
+    } else {
+      // Send the chunk on the gRPC stream
+      sendBodyChunk(state, data, ProcessorState::CallbackState::StreamedBodyCallback, end_stream);
+      // Move the data to the queue and optionally raise the watermark.
+      state.enqueueStreamingChunk(data, end_stream, true);
+    }
 
     // At this point we will continue, but with no data, because that will come later
     if (end_stream) {
@@ -446,7 +453,9 @@ FilterTrailersStatus Filter::onTrailers(ProcessorState& state, Http::HeaderMap&
   state.setTrailers(&trailers);
 
   if (state.callbackState() == ProcessorState::CallbackState::HeadersCallback ||
-      state.callbackState() == ProcessorState::CallbackState::BufferedBodyCallback) {
+      state.callbackState() == ProcessorState::CallbackState::BufferedBodyCallback ||
+      (state.callbackState() == ProcessorState::CallbackState::StreamedBodyCallback &&
+       state.streamedBodyWindowed())) {
     ENVOY_LOG(trace, "Previous callback still executing -- holding header iteration");
     state.setPaused(true);
     return FilterTrailersStatus::StopIteration;
@@ -519,7 +528,8 @@ FilterTrailersStatus Filter::encodeTrailers(ResponseTrailerMap& trailers) {
 }
 
 void Filter::sendBodyChunk(ProcessorState& state, const Buffer::Instance& data,
-                           ProcessorState::CallbackState new_state, bool end_stream) {
+                           ProcessorState::CallbackState new_state, bool end_stream,
+                           uint64_t chunk_index) {
   ENVOY_LOG(debug, "Sending a body chunk of {} bytes", data.length());
   state.onStartProcessorCall(std::bind(&Filter::onMessageTimeout, this), config_->messageTimeout(),
                              new_state);
@@ -527,6 +537,7 @@ void Filter::sendBodyChunk(ProcessorState& state, const Buffer::Instance& data,
   auto* body_req = state.mutableBody(req);
   body_req->set_end_of_stream(end_stream);
   body_req->set_body(data.toString());
+  body_req->set_chunk_index(chunk_index);
   stream_->send(std::move(req), false);
   stats_.stream_msgs_sent_.inc();
 }
@@ -556,8 +567,8 @@ void Filter::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& r) {
   // being invoked in line.
   if (response->has_mode_override()) {
     ENVOY_LOG(debug, "Processing mode overridden by server for this request");
-    decoding_state_.setProcessingMode(response->mode_override());
-    encoding_state_.setProcessingMode(response->mode_override());
+    decoding_state_.setProcessingMode(config_->applicableMode(response->mode_override()));
+    encoding_state_.setProcessingMode(config_->applicableMode(response->mode_override()));
   }
 
   ENVOY_LOG(debug, "Received {} response", responseCaseToString(response->response_case()));
@@ -759,8 +770,8 @@ void Filter::mergePerRouteConfig() {
   }
   if (merged_config->processingMode()) {
     ENVOY_LOG(trace, "Setting new processing mode from per-route configuration");
-    decoding_state_.setProcessingMode(*(merged_config->processingMode()));
-    encoding_state_.setProcessingMode(*(merged_config->processingMode()));
+    decoding_state_.setProcessingMode(config_->applicableMode(*(merged_config->processingMode())));
+    encoding_state_.setProcessingMode(config_->applicableMode(*(merged_config->processingMode())));
   }
   if (merged_config->grpcService()) {
     ENVOY_LOG(trace, "Setting new GrpcService from per-route configuration");
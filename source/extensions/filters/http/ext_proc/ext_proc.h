@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "envoy/common/exception.h"
 #include "envoy/config/core/v3/grpc_service.pb.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/filters/http/ext_proc/v3/ext_proc.pb.h"
@@ -24,7 +25,7 @@ namespace Extensions {
 namespace HttpFilters {
 namespace ExternalProcessing {
 
-#define ALL_EXT_PROC_FILTER_STATS(COUNTER)                                                         \
+#define ALL_EXT_PROC_FILTER_STATS(COUNTER, HISTOGRAM)                                              \
   COUNTER(streams_started)                                                                         \
   COUNTER(stream_msgs_sent)                                                                        \
   COUNTER(stream_msgs_received)                                                                    \
@@ -33,10 +34,11 @@ namespace ExternalProcessing {
   COUNTER(streams_failed)                                                                          \
   COUNTER(failure_mode_allowed)                                                                    \
   COUNTER(message_timeouts)                                                                        \
-  COUNTER(rejected_header_mutations)
+  COUNTER(rejected_header_mutations)                                                               \
+  HISTOGRAM(multiplexed_queue_time_us, Microseconds)
 
 struct ExtProcFilterStats {
-  ALL_EXT_PROC_FILTER_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_EXT_PROC_FILTER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 inline constexpr absl::string_view ExtProcLoggingInfoName = "ext-proc-logging-info";
@@ -72,7 +74,21 @@ public:
                const std::string& stats_prefix)
       : failure_mode_allow_(config.failure_mode_allow()), message_timeout_(message_timeout),
         stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
-        processing_mode_(config.processing_mode()), mutation_checker_(config.mutation_rules()) {}
+        processing_mode_(config.processing_mode()), mutation_checker_(config.mutation_rules()),
+        multiplexed_(config.has_stream_multiplexing()),
+        max_streamed_bytes_in_flight_(
+            config.has_streamed_body_window()
+                ? absl::make_optional(config.streamed_body_window().max_in_flight_bytes())
+                : absl::nullopt) {
+    using envoy::extensions::filters::http::ext_proc::v3::ProcessingMode;
+    if (multiplexed_ && (processing_mode_.request_body_mode() != ProcessingMode::NONE ||
+                         processing_mode_.response_body_mode() != ProcessingMode::NONE ||
+                         processing_mode_.request_trailer_mode() == ProcessingMode::SEND ||
+                         processing_mode_.response_trailer_mode() == ProcessingMode::SEND)) {
+      throw EnvoyException(
+          "ext_proc: stream_multiplexing requires a processing mode without bodies or trailers");
+    }
+  }
 
   bool failureModeAllow() const { return failure_mode_allow_; }
 
@@ -88,11 +104,41 @@ public:
     return mutation_checker_;
   }
 
+  // Whether the requests share gRPC streams, which can only carry headers.
+  bool multiplexed() const { return multiplexed_; }
+
+  // Returns the mode to apply when a route or the processor asks for the given one.
+  envoy::extensions::filters::http::ext_proc::v3::ProcessingMode
+  applicableMode(const envoy::extensions::filters::http::ext_proc::v3::ProcessingMode& mode) const {
+    return multiplexed_ ? headerOnlyMode(mode) : mode;
+  }
+
+  // If set, chunks in STREAMED body mode are pipelined within this many bytes awaiting a
+  // response, and the responses may arrive in any order.
+  const absl::optional<uint32_t>& maxStreamedBytesInFlight() const {
+    return max_streamed_bytes_in_flight_;
+  }
+
 private:
   ExtProcFilterStats generateStats(const std::string& prefix,
                                    const std::string& filter_stats_prefix, Stats::Scope& scope) {
     const std::string final_prefix = absl::StrCat(prefix, "ext_proc.", filter_stats_prefix);
-    return {ALL_EXT_PROC_FILTER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix))};
+    return {ALL_EXT_PROC_FILTER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix),
+                                      POOL_HISTOGRAM_PREFIX(scope, final_prefix))};
+  }
+
+  static envoy::extensions::filters::http::ext_proc::v3::ProcessingMode
+  headerOnlyMode(envoy::extensions::filters::http::ext_proc::v3::ProcessingMode mode) {
+    using envoy::extensions::filters::http::ext_proc::v3::ProcessingMode;
+    mode.set_request_body_mode(ProcessingMode::NONE);
+    mode.set_response_body_mode(ProcessingMode::NONE);
+    if (mode.request_trailer_mode() == ProcessingMode::SEND) {
+      mode.set_request_trailer_mode(ProcessingMode::SKIP);
+    }
+    if (mode.response_trailer_mode() == ProcessingMode::SEND) {
+      mode.set_response_trailer_mode(ProcessingMode::SKIP);
+    }
+    return mode;
   }
 
   const bool failure_mode_allow_;
@@ -101,6 +147,8 @@ private:
   ExtProcFilterStats stats_;
   const envoy::extensions::filters::http::ext_proc::v3::ProcessingMode processing_mode_;
   const Filters::Common::MutationRules::Checker mutation_checker_;
+  const bool multiplexed_;
+  const absl::optional<uint32_t> max_streamed_bytes_in_flight_;
 };
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
@@ -184,7 +232,8 @@ public:
     sendBodyChunk(state, *state.bufferedData(), new_state, end_stream);
   }
   void sendBodyChunk(ProcessorState& state, const Buffer::Instance& data,
-                     ProcessorState::CallbackState new_state, bool end_stream);
+                     ProcessorState::CallbackState new_state, bool end_stream,
+                     uint64_t chunk_index = 0);
 
   void sendTrailers(ProcessorState& state, const Http::HeaderMap& trailers);
 
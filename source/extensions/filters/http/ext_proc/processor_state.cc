@@ -119,9 +119,14 @@ absl::Status ProcessorState::handleHeadersResponse(const HeadersResponse& respon
           modifyBufferedData(
               [&buffered_chunk](Buffer::Instance& data) { buffered_chunk.move(data); });
           ENVOY_LOG(debug, "Sending first chunk using buffered data ({})", buffered_chunk.length());
-          filter_.sendBodyChunk(*this, buffered_chunk,
-                                ProcessorState::CallbackState::StreamedBodyCallback, false);
-          enqueueStreamingChunk(buffered_chunk, false, true);
+          if (streamedBodyWindowed()) {
+            enqueueStreamingChunk(buffered_chunk, false, false);
+            sendStreamedChunks();
+          } else {
+            filter_.sendBodyChunk(*this, buffered_chunk,
+                                  ProcessorState::CallbackState::StreamedBodyCallback, false);
+            enqueueStreamingChunk(buffered_chunk, false, true);
+          }
         }
         if (queueBelowLowLimit()) {
           clearWatermark();
@@ -173,6 +178,7 @@ absl::Status ProcessorState::handleHeadersResponse(const HeadersResponse& respon
 
 absl::Status ProcessorState::handleBodyResponse(const BodyResponse& response) {
   bool should_continue = false;
+  bool chunks_awaiting_response = false;
   const auto& common_response = response.response();
   if (callback_state_ == CallbackState::BufferedBodyCallback ||
       callback_state_ == CallbackState::StreamedBodyCallback ||
@@ -204,6 +210,14 @@ absl::Status ProcessorState::handleBodyResponse(const BodyResponse& response) {
       clearWatermark();
       onFinishProcessorCall(Grpc::Status::Ok);
       should_continue = true;
+    } else if ((callback_state_ == CallbackState::StreamedBodyCallback ||
+                callback_state_ == CallbackState::StreamedBodyCallbackFinishing) &&
+               filter_.config().maxStreamedBytesInFlight().has_value()) {
+      const auto status = handleWindowedBodyResponse(response, should_continue);
+      if (!status.ok()) {
+        return status;
+      }
+      chunks_awaiting_response = !chunk_queue_.empty();
     } else if (callback_state_ == CallbackState::StreamedBodyCallback ||
                callback_state_ == CallbackState::StreamedBodyCallbackFinishing) {
       bool delivered_one = false;
@@ -273,7 +287,7 @@ absl::Status ProcessorState::handleBodyResponse(const BodyResponse& response) {
     }
     headers_ = nullptr;
 
-    if (send_trailers_ && trailers_available_) {
+    if (send_trailers_ && trailers_available_ && !chunks_awaiting_response) {
       // Trailers came in while we were waiting for this response, and the server
       // asked to see them -- send them now.
       filter_.sendTrailers(*this, *trailers_);
@@ -289,6 +303,57 @@ absl::Status ProcessorState::handleBodyResponse(const BodyResponse& response) {
   return absl::FailedPreconditionError("spurious message");
 }
 
+absl::Status ProcessorState::handleWindowedBodyResponse(const BodyResponse& response,
+                                                        bool& should_continue) {
+  QueuedChunk* chunk = chunk_queue_.findAwaitingResponse(response.chunk_index());
+  if (chunk == nullptr) {
+    ENVOY_LOG(debug, "No body chunk with index {} awaits a response", response.chunk_index());
+    return absl::FailedPreconditionError("spurious message");
+  }
+  chunk->responded = true;
+  bytes_in_flight_ -= chunk->sent_length;
+  const auto& common_response = response.response();
+  if (common_response.has_body_mutation()) {
+    ENVOY_LOG(debug, "Applying body response to chunk {}. Size = {}", chunk->index,
+              chunk->data.length());
+    chunk_queue_.modify(*chunk, [&common_response](Buffer::Instance& data) {
+      MutationUtils::applyBodyMutations(common_response.body_mutation(), data);
+    });
+  }
+
+  // Pass on the chunks at the head of the queue that are done, in order. Once the processing
+  // mode changed, the chunks that were never sent are passed on as they are.
+  const bool finishing = callback_state_ == CallbackState::StreamedBodyCallbackFinishing;
+  while (auto ready_chunk = chunk_queue_.popResponded(finishing)) {
+    auto ready = std::move(*ready_chunk);
+    should_continue = ready->end_stream;
+    if (ready->data.length() > 0) {
+      ENVOY_LOG(trace, "Injecting {} bytes of data to filter stream", ready->data.length());
+      injectDataToFilterChain(ready->data, false);
+    }
+  }
+
+  if (chunk_queue_.empty()) {
+    // Trailers are held back until the whole body was passed on.
+    should_continue = should_continue || trailers_available_;
+    onFinishProcessorCall(Grpc::Status::Ok);
+  } else {
+    onFinishProcessorCall(Grpc::Status::Ok, callback_state_);
+    if (!finishing) {
+      sendStreamedChunks();
+    }
+    if (bytes_in_flight_ > 0 && !call_start_time_.has_value()) {
+      // Nothing new was sent, so time the chunks still awaiting a response from now on.
+      message_timer_->enableTimer(filter_.config().messageTimeout());
+      call_start_time_ = filter_callbacks_->dispatcher().timeSource().monotonicTime();
+    }
+  }
+  if (queueBelowLowLimit()) {
+    clearWatermark();
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ProcessorState::handleTrailersResponse(const TrailersResponse& response) {
   if (callback_state_ == CallbackState::TrailersCallback) {
     ENVOY_LOG(debug, "Applying response to buffered trailers");
@@ -316,6 +381,28 @@ void ProcessorState::enqueueStreamingChunk(Buffer::Instance& data, bool end_stre
   }
 }
 
+bool ProcessorState::streamedBodyWindowed() const {
+  return body_mode_ == ProcessingMode::STREAMED &&
+         filter_.config().maxStreamedBytesInFlight().has_value();
+}
+
+void ProcessorState::sendStreamedChunks() {
+  const uint32_t window = *filter_.config().maxStreamedBytesInFlight();
+  while (QueuedChunk* chunk = chunk_queue_.firstUndelivered()) {
+    if (bytes_in_flight_ > 0 && bytes_in_flight_ + chunk->data.length() > window) {
+      ENVOY_LOG(trace, "Holding {} bytes of body data until the window has room",
+                chunk->data.length());
+      return;
+    }
+    chunk->delivered = true;
+    chunk->index = next_chunk_index_++;
+    chunk->sent_length = chunk->data.length();
+    bytes_in_flight_ += chunk->sent_length;
+    filter_.sendBodyChunk(*this, chunk->data, CallbackState::StreamedBodyCallback,
+                          chunk->end_stream, chunk->index);
+  }
+}
+
 void ProcessorState::clearAsyncState() {
   onFinishProcessorCall(Grpc::Status::Aborted);
   while (auto queued_chunk = dequeueStreamingChunk(false)) {
@@ -433,6 +520,41 @@ const QueuedChunk& ChunkQueue::consolidate(bool delivered) {
   return *(queue_.front());
 }
 
+QueuedChunk* ChunkQueue::firstUndelivered() {
+  for (auto& chunk : queue_) {
+    if (!chunk->delivered) {
+      return chunk.get();
+    }
+  }
+  return nullptr;
+}
+
+QueuedChunk* ChunkQueue::findAwaitingResponse(uint64_t index) {
+  for (auto& chunk : queue_) {
+    if (chunk->delivered && !chunk->responded && chunk->index == index) {
+      return chunk.get();
+    }
+  }
+  return nullptr;
+}
+
+void ChunkQueue::modify(QueuedChunk& chunk, std::function<void(Buffer::Instance&)> cb) {
+  bytes_enqueued_ -= chunk.data.length();
+  cb(chunk.data);
+  bytes_enqueued_ += chunk.data.length();
+}
+
+absl::optional<QueuedChunkPtr> ChunkQueue::popResponded(bool include_undelivered) {
+  if (queue_.empty()) {
+    return absl::nullopt;
+  }
+  const QueuedChunk& front = *queue_.front();
+  if (!front.responded && (front.delivered || !include_undelivered)) {
+    return absl::nullopt;
+  }
+  return pop(false);
+}
+
 } // namespace ExternalProcessing
 } // namespace HttpFilters
 } // namespace Extensions
@@ -29,6 +29,11 @@ public:
   bool end_stream = false;
   // True if the chunk was actually sent to the gRPC stream
   bool delivered = false;
+  // True if the response to the chunk arrived, when responses may arrive out of order
+  bool responded = false;
+  // The index the chunk was sent with, and its size at the time
+  uint64_t index = 0;
+  uint32_t sent_length = 0;
   Buffer::OwnedImpl data;
 };
 using QueuedChunkPtr = std::unique_ptr<QueuedChunk>;
@@ -43,6 +48,15 @@ public:
   void push(Buffer::Instance& data, bool end_stream, bool delivered);
   absl::optional<QueuedChunkPtr> pop(bool undelivered_only);
   const QueuedChunk& consolidate(bool delivered);
+  // Return the first chunk that was not sent to the gRPC stream, if any.
+  QueuedChunk* firstUndelivered();
+  // Return the chunk sent with the given index that is still awaiting a response, if any.
+  QueuedChunk* findAwaitingResponse(uint64_t index);
+  // Modify the data of a queued chunk, keeping count of the bytes enqueued.
+  void modify(QueuedChunk& chunk, std::function<void(Buffer::Instance&)> cb);
+  // If the head of the queue was responded to, or if it was never delivered and
+  // "include_undelivered" is set, return it.
+  absl::optional<QueuedChunkPtr> popResponded(bool include_undelivered);
 
 private:
   // If we are in either streaming mode, store chunks that we received here,
@@ -145,6 +159,12 @@ public:
   bool queueOverHighLimit() const { return chunk_queue_.bytesEnqueued() > bufferLimit(); }
   bool queueBelowLowLimit() const { return chunk_queue_.bytesEnqueued() < bufferLimit() / 2; }
 
+  // Whether chunks in STREAMED mode are pipelined within a window, and may be responded to
+  // out of order.
+  bool streamedBodyWindowed() const;
+  // Send the chunks on the queue that were not sent yet, for as long as the window has room.
+  void sendStreamedChunks();
+
   virtual Http::HeaderMap* addTrailers() PURE;
 
   virtual void continueProcessing() const PURE;
@@ -198,6 +218,14 @@ protected:
   ChunkQueue chunk_queue_;
   absl::optional<MonotonicTime> call_start_time_ = absl::nullopt;
   const envoy::config::core::v3::TrafficDirection traffic_direction_;
+  // When the body is streamed within a window, the index of the next chunk to send, and
+  // the number of bytes awaiting a response.
+  uint64_t next_chunk_index_ = 0;
+  uint64_t bytes_in_flight_ = 0;
+
+private:
+  absl::Status handleWindowedBodyResponse(
+      const envoy::service::ext_proc::v3::BodyResponse& response, bool& should_continue);
 };
 
 class DecodingProcessorState : public ProcessorState {
@@ -293,6 +293,9 @@ Status JsonTranscoderConfig::createMethodInfo(const Protobuf::MethodDescriptor*
                                               MethodInfoSharedPtr& method_info) {
   method_info = std::make_shared<MethodInfo>();
   method_info->descriptor_ = descriptor;
+  method_info->request_type_ = type_helper_->Info()->GetTypeByTypeUrl(
+      Grpc::Common::typeUrl(descriptor->input_type()->full_name()));
+  method_info->response_type_url_ = Grpc::Common::typeUrl(descriptor->output_type()->full_name());
 
   Status status =
       resolveField(descriptor->input_type(), http_rule.body(),
@@ -331,14 +334,10 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
 
   ASSERT(!disabled_);
   const std::string method(headers.getMethodValue());
-  std::string path(headers.getPathValue());
-  std::string args;
-
-  const size_t pos = path.find('?');
-  if (pos != std::string::npos) {
-    args = path.substr(pos + 1);
-    path = path.substr(0, pos);
-  }
+  const absl::string_view path_and_args = headers.getPathValue();
+  const size_t pos = path_and_args.find('?');
+  const std::string path(path_and_args.substr(0, pos));
+  const std::string args(pos != absl::string_view::npos ? path_and_args.substr(pos + 1) : "");
 
   struct RequestInfo request_info;
   request_info.reject_binding_body_field_collisions =
@@ -392,11 +391,9 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
         method_info->descriptor_->client_streaming(), true);
   }
 
-  const auto response_type_url =
-      Grpc::Common::typeUrl(method_info->descriptor_->output_type()->full_name());
   ResponseToJsonTranslatorPtr response_translator{new ResponseToJsonTranslator(
-      type_helper_->Resolver(), response_type_url, method_info->descriptor_->server_streaming(),
-      &response_input, response_translate_options_)};
+      type_helper_->Resolver(), method_info->response_type_url_,
+      method_info->descriptor_->server_streaming(), &response_input, response_translate_options_)};
 
   transcoder = std::make_unique<TranscoderImpl>(std::move(request_translator),
                                                 std::move(json_request_translator),
@@ -407,10 +404,9 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
 ProtobufUtil::Status
 JsonTranscoderConfig::methodToRequestInfo(const MethodInfoSharedPtr& method_info,
                                           google::grpc::transcoding::RequestInfo* info) const {
-  const std::string& request_type_full_name = method_info->descriptor_->input_type()->full_name();
-  auto request_type_url = Grpc::Common::typeUrl(request_type_full_name);
-  info->message_type = type_helper_->Info()->GetTypeByTypeUrl(request_type_url);
+  info->message_type = method_info->request_type_;
   if (info->message_type == nullptr) {
+    const std::string& request_type_full_name = method_info->descriptor_->input_type()->full_name();
     ENVOY_LOG(debug, "Cannot resolve input-type: {}", request_type_full_name);
     return ProtobufUtil::Status(StatusCode::kNotFound,
                                 "Could not resolve type: " + request_type_full_name);
@@ -43,6 +43,10 @@ struct VariableBinding {
 
 struct MethodInfo {
   const Protobuf::MethodDescriptor* descriptor_ = nullptr;
+  // The type of the request message and the type URL of the response message, resolved once when
+  // the method is registered rather than for each request.
+  const ProtobufWkt::Type* request_type_ = nullptr;
+  std::string response_type_url_;
   std::vector<const ProtobufWkt::Field*> request_body_field_path;
   std::vector<const ProtobufWkt::Field*> response_body_field_path;
   bool request_type_is_http_body_ = false;
@@ -86,6 +86,17 @@ Rule::Rule(const ProtoRule& rule) : rule_(rule) {
     regex_rewrite_ = Regex::Utility::parseRegex(rewrite_spec.pattern());
     regex_rewrite_substitution_ = rewrite_spec.substitution();
   }
+
+  on_header_present_value_ = constantValue(rule.on_header_present());
+  on_header_missing_value_ = constantValue(rule.on_header_missing());
+}
+
+absl::optional<ProtobufWkt::Value> Rule::constantValue(const KeyValuePair& keyval) {
+  // Invalid constants are left to the filter, which skips them for each request.
+  if (keyval.value().empty()) {
+    return absl::nullopt;
+  }
+  return HeaderToMetadataFilter::toValue(keyval.value(), keyval.type(), keyval.encode());
 }
 
 Config::Config(const envoy::extensions::filters::http::header_to_metadata::v3::Config config,
@@ -150,9 +161,8 @@ void HeaderToMetadataFilter::setEncoderFilterCallbacks(
   encoder_callbacks_ = &callbacks;
 }
 
-bool HeaderToMetadataFilter::addMetadata(StructMap& map, const std::string& meta_namespace,
-                                         const std::string& key, std::string value, ValueType type,
-                                         ValueEncode encode) const {
+absl::optional<ProtobufWkt::Value>
+HeaderToMetadataFilter::toValue(std::string value, ValueType type, ValueEncode encode) {
   ProtobufWkt::Value val;
 
   ASSERT(!value.empty());
@@ -160,14 +170,14 @@ bool HeaderToMetadataFilter::addMetadata(StructMap& map, const std::string& meta
   if (value.size() >= MAX_HEADER_VALUE_LEN) {
     // Too long, go away.
     ENVOY_LOG(debug, "metadata value is too long");
-    return false;
+    return absl::nullopt;
   }
 
   if (encode == envoy::extensions::filters::http::header_to_metadata::v3::Config::BASE64) {
     value = Base64::decodeWithoutPadding(value);
     if (value.empty()) {
       ENVOY_LOG(debug, "Base64 decode failed");
-      return false;
+      return absl::nullopt;
     }
   }
 
@@ -183,29 +193,29 @@ bool HeaderToMetadataFilter::addMetadata(StructMap& map, const std::string& meta
       val.set_number_value(dval);
     } else {
       ENVOY_LOG(debug, "value to number conversion failed");
-      return false;
+      return absl::nullopt;
     }
     break;
   }
   case envoy::extensions::filters::http::header_to_metadata::v3::Config::PROTOBUF_VALUE: {
     if (!val.ParseFromString(value)) {
       ENVOY_LOG(debug, "parse from decoded string failed");
-      return false;
+      return absl::nullopt;
     }
     break;
   }
   }
+  return val;
+}
 
-  // Have we seen this namespace before?
-  auto namespace_iter = map.find(meta_namespace);
-  if (namespace_iter == map.end()) {
-    map[meta_namespace] = ProtobufWkt::Struct();
-    namespace_iter = map.find(meta_namespace);
+bool HeaderToMetadataFilter::addMetadata(StructMap& map, const std::string& meta_namespace,
+                                         const std::string& key, std::string value, ValueType type,
+                                         ValueEncode encode) const {
+  absl::optional<ProtobufWkt::Value> val = toValue(std::move(value), type, encode);
+  if (!val) {
+    return false;
   }
-
-  auto& keyval = namespace_iter->second;
-  (*keyval.mutable_fields())[key] = val;
-
+  (*map[meta_namespace].mutable_fields())[key] = std::move(*val);
   return true;
 }
 
@@ -216,7 +226,14 @@ const std::string& HeaderToMetadataFilter::decideNamespace(const std::string& ns
 
 // add metadata['key']= value depending on header present or missing case
 void HeaderToMetadataFilter::applyKeyValue(std::string&& value, const Rule& rule,
-                                           const KeyValuePair& keyval, StructMap& np) {
+                                           const KeyValuePair& keyval,
+                                           const absl::optional<ProtobufWkt::Value>& constant,
+                                           StructMap& np) {
+  if (constant) {
+    const auto& nspace = decideNamespace(keyval.metadata_namespace());
+    (*np[nspace].mutable_fields())[keyval.key()] = *constant;
+    return;
+  }
   if (!keyval.value().empty()) {
     value = keyval.value();
   } else {
@@ -227,7 +244,7 @@ void HeaderToMetadataFilter::applyKeyValue(std::string&& value, const Rule& rule
   }
   if (!value.empty()) {
     const auto& nspace = decideNamespace(keyval.metadata_namespace());
-    addMetadata(np, nspace, keyval.key(), value, keyval.type(), keyval.encode());
+    addMetadata(np, nspace, keyval.key(), std::move(value), keyval.type(), keyval.encode());
   } else {
     ENVOY_LOG(debug, "value is empty, not adding metadata");
   }
@@ -244,10 +261,10 @@ void HeaderToMetadataFilter::writeHeaderToMetadata(Http::HeaderMap& headers,
 
     if (value && proto_rule.has_on_header_present()) {
       applyKeyValue(std::move(value).value_or(""), rule, proto_rule.on_header_present(),
-                    structs_by_namespace);
+                    rule.onHeaderPresentValue(), structs_by_namespace);
     } else if (!value && proto_rule.has_on_header_missing()) {
       applyKeyValue(std::move(value).value_or(""), rule, proto_rule.on_header_missing(),
-                    structs_by_namespace);
+                    rule.onHeaderMissingValue(), structs_by_namespace);
     }
   }
   // Any matching rules?
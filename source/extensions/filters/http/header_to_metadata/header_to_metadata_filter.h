@@ -11,6 +11,7 @@
 #include "source/common/common/matchers.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -74,12 +75,24 @@ public:
   const ProtoRule& rule() const { return rule_; }
   const Regex::CompiledMatcherPtr& regexRewrite() const { return regex_rewrite_; }
   const std::string& regexSubstitution() const { return regex_rewrite_substitution_; }
+  // The metadata values of on_header_present and on_header_missing when they are constants of the
+  // config, converted once when the config is loaded.
+  const absl::optional<ProtobufWkt::Value>& onHeaderPresentValue() const {
+    return on_header_present_value_;
+  }
+  const absl::optional<ProtobufWkt::Value>& onHeaderMissingValue() const {
+    return on_header_missing_value_;
+  }
   std::shared_ptr<const ValueSelector> selector_;
 
 private:
+  static absl::optional<ProtobufWkt::Value> constantValue(const KeyValuePair& keyval);
+
   const ProtoRule rule_;
   Regex::CompiledMatcherPtr regex_rewrite_{};
   std::string regex_rewrite_substitution_{};
+  absl::optional<ProtobufWkt::Value> on_header_present_value_;
+  absl::optional<ProtobufWkt::Value> on_header_missing_value_;
 };
 
 using HeaderToMetadataRules = std::vector<Rule>;
@@ -166,6 +179,13 @@ public:
   }
   void setEncoderFilterCallbacks(Http::StreamEncoderFilterCallbacks& callbacks) override;
 
+  /**
+   * Converts a header value to a metadata value.
+   * @return the value, or absl::nullopt if the header value can't be converted.
+   */
+  static absl::optional<ProtobufWkt::Value> toValue(std::string value, ValueType type,
+                                                   ValueEncode encode);
+
 private:
   friend class HeaderToMetadataTest;
 
@@ -190,7 +210,8 @@ private:
                              Http::StreamFilterCallbacks& callbacks);
   bool addMetadata(StructMap&, const std::string&, const std::string&, std::string, ValueType,
                    ValueEncode) const;
-  void applyKeyValue(std::string&&, const Rule&, const KeyValuePair&, StructMap&);
+  void applyKeyValue(std::string&&, const Rule&, const KeyValuePair&,
+                     const absl::optional<ProtobufWkt::Value>&, StructMap&);
   const std::string& decideNamespace(const std::string& nspace) const;
   const Config* getConfig() const;
 };
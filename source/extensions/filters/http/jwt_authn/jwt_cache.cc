@@ -1,7 +1,10 @@
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
+#include <algorithm>
+
 #include "source/common/common/assert.h"
 
+#include "absl/hash/hash.h"
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using ::google::simple_lru_cache::SimpleLRUCache;
@@ -19,8 +22,9 @@ constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
 
 class JwtCacheImpl : public JwtCache {
 public:
-  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
-      : time_source_(time_source) {
+  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source,
+               SharedJwtCacheSharedPtr shared_cache)
+      : time_source_(time_source), shared_cache_(std::move(shared_cache)) {
     if (enable_cache) {
       // if cache_size is 0, it is not specified in the config, use default
       auto cache_size =
@@ -40,16 +44,29 @@ public:
     if (!jwt_lru_cache_) {
       return nullptr;
     }
-    SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>::ScopedLookup lookup(
-        jwt_lru_cache_.get(), token);
-    if (lookup.found()) {
-      ::google::jwt_verify::Jwt* const found_jwt = lookup.value();
-      ASSERT(found_jwt != nullptr);
-      if (found_jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) !=
-          ::google::jwt_verify::Status::JwtExpired) {
-        return found_jwt;
-      } else {
-        jwt_lru_cache_->remove(token);
+    {
+      SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>::ScopedLookup lookup(
+          jwt_lru_cache_.get(), token);
+      if (lookup.found()) {
+        ::google::jwt_verify::Jwt* const found_jwt = lookup.value();
+        ASSERT(found_jwt != nullptr);
+        if (found_jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) !=
+            ::google::jwt_verify::Status::JwtExpired) {
+          return found_jwt;
+        } else {
+          jwt_lru_cache_->remove(token);
+        }
+      }
+    }
+    if (shared_cache_) {
+      const std::shared_ptr<const ::google::jwt_verify::Jwt> shared_jwt =
+          shared_cache_->lookup(token);
+      if (shared_jwt) {
+        // The token was verified by another worker. Copying the JWT parses it again, which is
+        // much cheaper than verifying its signature.
+        auto* const jwt = new ::google::jwt_verify::Jwt(*shared_jwt);
+        jwt_lru_cache_->insert(token, jwt, 1);
+        return jwt;
       }
     }
     return nullptr;
@@ -57,6 +74,9 @@ public:
 
   void insert(const std::string& token, std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) override {
     if (jwt_lru_cache_ && token.size() <= kMaxJwtSizeForCache) {
+      if (shared_cache_) {
+        shared_cache_->insert(token, std::make_shared<const ::google::jwt_verify::Jwt>(*jwt));
+      }
       // pass the ownership of jwt to cache
       jwt_lru_cache_->insert(token, jwt.release(), 1);
     }
@@ -65,12 +85,63 @@ public:
 private:
   std::unique_ptr<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>> jwt_lru_cache_;
   TimeSource& time_source_;
+  const SharedJwtCacheSharedPtr shared_cache_;
 };
 } // namespace
 
+SharedJwtCache::SharedJwtCache(uint32_t max_entries, TimeSource& time_source)
+    : time_source_(time_source) {
+  const uint32_t max_shard_entries = std::max<uint32_t>(1, max_entries / NumShards);
+  for (Shard& shard : shards_) {
+    absl::MutexLock lock(&shard.mutex_);
+    shard.cache_ = std::make_unique<LruCache>(max_shard_entries);
+  }
+}
+
+std::shared_ptr<const ::google::jwt_verify::Jwt>
+SharedJwtCache::lookup(const std::string& token) {
+  Shard& token_shard = shard(token);
+  absl::MutexLock lock(&token_shard.mutex_);
+  LruCache::ScopedLookup lookup(token_shard.cache_.get(), token);
+  if (!lookup.found()) {
+    return nullptr;
+  }
+  std::shared_ptr<const ::google::jwt_verify::Jwt> jwt = *lookup.value();
+  if (jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) ==
+      ::google::jwt_verify::Status::JwtExpired) {
+    token_shard.cache_->remove(token);
+    return nullptr;
+  }
+  return jwt;
+}
+
+void SharedJwtCache::insert(const std::string& token,
+                            std::shared_ptr<const ::google::jwt_verify::Jwt> jwt) {
+  if (token.size() > kMaxJwtSizeForCache) {
+    return;
+  }
+  Shard& token_shard = shard(token);
+  absl::MutexLock lock(&token_shard.mutex_);
+  token_shard.cache_->insert(
+      token, new std::shared_ptr<const ::google::jwt_verify::Jwt>(std::move(jwt)), 1);
+}
+
+SharedJwtCache::Shard& SharedJwtCache::shard(const std::string& token) {
+  return shards_[absl::Hash<std::string>()(token) % NumShards];
+}
+
+SharedJwtCacheSharedPtr SharedJwtCache::create(bool enable_cache, const JwtCacheConfig& config,
+                                               TimeSource& time_source) {
+  if (!enable_cache || config.shared_jwt_cache_size() == 0) {
+    return nullptr;
+  }
+  return std::make_shared<SharedJwtCache>(config.shared_jwt_cache_size(), time_source);
+}
+
 JwtCachePtr JwtCache::create(bool enable_cache, const JwtCacheConfig& config,
-                             TimeSource& time_source) {
-  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source);
+                             TimeSource& time_source, SharedJwtCacheSharedPtr shared_cache) {
+  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source,
+                                        std::move(shared_cache));
 }
 
 } // namespace JwtAuthn
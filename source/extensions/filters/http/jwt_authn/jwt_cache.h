@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -7,8 +8,11 @@
 
 #include "source/common/common/utility.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "jwt_verify_lib/jwt.h"
 #include "jwt_verify_lib/verify.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig;
 
@@ -19,6 +23,42 @@ namespace JwtAuthn {
 
 // Cache key is the JWT string, value is parsed JWT struct.
 
+class SharedJwtCache;
+using SharedJwtCacheSharedPtr = std::shared_ptr<SharedJwtCache>;
+
+// A cache of verified JWTs shared by the worker threads. It is split into shards, each with its
+// own lock, so that the workers rarely wait for each other.
+class SharedJwtCache {
+public:
+  SharedJwtCache(uint32_t max_entries, TimeSource& time_source);
+
+  // Lookup a JWT token in the cache. Return nullptr if not found or expired.
+  std::shared_ptr<const ::google::jwt_verify::Jwt> lookup(const std::string& token);
+
+  // Insert a JWT token and its parsed JWT struct to the cache.
+  void insert(const std::string& token, std::shared_ptr<const ::google::jwt_verify::Jwt> jwt);
+
+  // SharedJwtCache factory function. Return nullptr if the shared cache is not enabled.
+  static SharedJwtCacheSharedPtr create(bool enable_cache, const JwtCacheConfig& config,
+                                        TimeSource& time_source);
+
+private:
+  using LruCache = ::google::simple_lru_cache::SimpleLRUCache<
+      std::string, std::shared_ptr<const ::google::jwt_verify::Jwt>>;
+
+  static constexpr size_t NumShards = 16;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    std::unique_ptr<LruCache> cache_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shard(const std::string& token);
+
+  TimeSource& time_source_;
+  std::array<Shard, NumShards> shards_;
+};
+
 class JwtCache;
 using JwtCachePtr = std::unique_ptr<JwtCache>;
 
@@ -35,9 +75,11 @@ public:
   virtual void insert(const std::string& token,
                       std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) PURE;
 
-  // JwtCache factory function.
+  // JwtCache factory function. A JWT not found in the cache is looked up in the shared cache,
+  // if set, and JWTs inserted in the cache are also inserted in the shared cache.
   static JwtCachePtr create(bool enable_cache, const JwtCacheConfig& config,
-                            TimeSource& time_source);
+                            TimeSource& time_source,
+                            SharedJwtCacheSharedPtr shared_cache = nullptr);
 };
 
 } // namespace JwtAuthn
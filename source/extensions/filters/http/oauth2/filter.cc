@@ -197,6 +197,10 @@ void OAuth2CookieValidator::setParams(const Http::RequestHeaderMap& headers,
 }
 
 bool OAuth2CookieValidator::hmacIsValid() const {
+  if (hmac_.empty()) {
+    // No session cookie, e.g. the first request of a user, cannot match any HMAC.
+    return false;
+  }
   auto& crypto_util = Envoy::Common::Crypto::UtilitySingleton::get();
   const auto hmac_payload = absl::StrCat(host_, expires_, token_, id_token_, refresh_token_);
   const auto pre_encoded_hmac = Hex::encode(crypto_util.getSha256Hmac(secret_, hmac_payload));
@@ -216,7 +220,9 @@ bool OAuth2CookieValidator::timestampIsValid() const {
   return std::chrono::seconds(expires) > current_epoch;
 }
 
-bool OAuth2CookieValidator::isValid() const { return hmacIsValid() && timestampIsValid(); }
+// The timestamp is checked first since it is much cheaper than the HMAC, and expired sessions need
+// not be authenticated.
+bool OAuth2CookieValidator::isValid() const { return timestampIsValid() && hmacIsValid(); }
 
 OAuth2Filter::OAuth2Filter(FilterConfigSharedPtr config,
                            std::unique_ptr<OAuth2Client>&& oauth_client, TimeSource& time_source)
@@ -27,12 +27,20 @@ Http::FilterFactoryCb RateLimitFilterConfig::createFilterFactoryFromProtoTyped(
   const std::chrono::milliseconds timeout =
       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(proto_config, timeout, 20));
 
+  // The quotas are shared by the filters created from this configuration.
+  Filters::Common::RateLimit::QuotaCacheSharedPtr quota_cache;
+  if (proto_config.max_cached_quotas() > 0) {
+    quota_cache = std::make_shared<Filters::Common::RateLimit::QuotaCache>(
+        proto_config.max_cached_quotas(), context.threadLocal(), context.timeSource());
+  }
+
   Config::Utility::checkTransportVersion(proto_config.rate_limit_service());
-  return [proto_config, &context, timeout,
-          filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+  return [proto_config, &context, timeout, filter_config,
+          quota_cache](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<Filter>(
-        filter_config, Filters::Common::RateLimit::rateLimitClient(
-                           context, proto_config.rate_limit_service().grpc_service(), timeout)));
+        filter_config,
+        Filters::Common::RateLimit::rateLimitClient(
+            context, proto_config.rate_limit_service().grpc_service(), timeout, quota_cache)));
   };
 }
 
@@ -27,10 +27,18 @@ fillHeaderList(Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValue>*
 } // namespace
 
 HttpTapConfigImpl::HttpTapConfigImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                                     Common::Tap::Sink* admin_streamer)
-    : TapCommon::TapConfigBaseImpl(std::move(proto_config), admin_streamer) {}
+                                     Common::Tap::Sink* admin_streamer,
+                                     Runtime::Loader& runtime)
+    : TapCommon::TapConfigBaseImpl(std::move(proto_config), admin_streamer),
+      tap_enabled_(proto_config.has_tap_enabled()
+                       ? absl::make_optional<Runtime::FractionalPercent>(
+                             proto_config.tap_enabled(), runtime)
+                       : absl::nullopt) {}
 
 HttpPerRequestTapperPtr HttpTapConfigImpl::createPerRequestTapper(uint64_t stream_id) {
+  if (tap_enabled_.has_value() && !tap_enabled_->enabled()) {
+    return nullptr;
+  }
   return std::make_unique<HttpPerRequestTapperImpl>(shared_from_this(), stream_id);
 }
 
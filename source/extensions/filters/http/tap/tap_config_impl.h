@@ -4,8 +4,10 @@
 #include "envoy/data/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/http.pb.h"
 #include "envoy/http/header_map.h"
+#include "envoy/runtime/runtime.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/common/tap/tap_config_base.h"
 #include "source/extensions/filters/http/tap/tap_config.h"
 
@@ -19,10 +21,15 @@ class HttpTapConfigImpl : public Extensions::Common::Tap::TapConfigBaseImpl,
                           public std::enable_shared_from_this<HttpTapConfigImpl> {
 public:
   HttpTapConfigImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                    Extensions::Common::Tap::Sink* admin_streamer);
+                    Extensions::Common::Tap::Sink* admin_streamer, Runtime::Loader& runtime);
 
   // TapFilter::HttpTapConfig
   HttpPerRequestTapperPtr createPerRequestTapper(uint64_t stream_id) override;
+
+private:
+  // Sampled before any matching or copying is done, so that requests which are not tapped cost
+  // nothing but the sampling decision.
+  const absl::optional<Runtime::FractionalPercent> tap_enabled_;
 };
 
 class HttpPerRequestTapperImpl : public HttpPerRequestTapper, Logger::Loggable<Logger::Id::tap> {
@@ -303,9 +303,7 @@ bool Filter::parseV2Header(const char* buf) {
 }
 
 bool Filter::parseV1Header(const char* buf, size_t len) {
-  std::string proxy_line;
-  proxy_line.assign(buf, len);
-  const auto trimmed_proxy_line = StringUtil::rtrim(proxy_line);
+  const auto trimmed_proxy_line = StringUtil::rtrim(absl::string_view(buf, len));
 
   // Parse proxy protocol line with format: PROXY TCP4/TCP6/UNKNOWN SOURCE_ADDRESS
   // DESTINATION_ADDRESS SOURCE_PORT DESTINATION_PORT.
@@ -375,6 +373,8 @@ bool Filter::parseV1Header(const char* buf, size_t len) {
  *        See https://www.haproxy.org/download/2.1/doc/proxy-protocol.txt for details
  */
 bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
+  // The TLVs of each metadata namespace, which are set once all the TLVs are parsed.
+  absl::flat_hash_map<std::string, ProtobufWkt::Struct> tlv_metadata;
   size_t idx{0};
   while (idx < len) {
     const uint8_t tlv_type = buf[idx];
@@ -411,14 +411,11 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
       ProtobufWkt::Value metadata_value;
       metadata_value.set_string_value(tlv_value.data(), tlv_value.size());
 
-      std::string metadata_key = key_value_pair->metadata_namespace().empty()
-                                     ? "envoy.filters.listener.proxy_protocol"
-                                     : key_value_pair->metadata_namespace();
-
-      ProtobufWkt::Struct metadata(
-          (*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key]);
-      metadata.mutable_fields()->insert({key_value_pair->key(), metadata_value});
-      cb_->setDynamicMetadata(metadata_key, metadata);
+      const absl::string_view metadata_key =
+          key_value_pair->metadata_namespace().empty()
+              ? "envoy.filters.listener.proxy_protocol"
+              : absl::string_view(key_value_pair->metadata_namespace());
+      tlv_metadata[metadata_key].mutable_fields()->insert({key_value_pair->key(), metadata_value});
     } else {
       ENVOY_LOG(trace,
                 "proxy_protocol: Skip TLV of type {} since it's not needed for dynamic metadata",
@@ -434,6 +431,10 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
     idx += tlv_value_length;
     ASSERT(idx <= len);
   }
+
+  for (const auto& [metadata_key, metadata] : tlv_metadata) {
+    cb_->setDynamicMetadata(metadata_key, metadata);
+  }
   return true;
 }
 
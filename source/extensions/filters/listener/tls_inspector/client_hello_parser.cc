@@ -0,0 +1,244 @@
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include <algorithm>
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+namespace {
+
+constexpr uint8_t HandshakeContentType = 22;
+constexpr uint8_t RecordMajorVersion = 3;
+constexpr size_t MaxRecordSize = 16384;
+constexpr uint8_t ClientHelloMessageType = 1;
+constexpr size_t HandshakeHeaderSize = 4;
+constexpr size_t RandomSize = 32;
+constexpr size_t MaxSessionIdSize = 32;
+constexpr size_t MaxHostNameSize = 255;
+
+// Read the next TLS record carrying handshake data.
+ClientHelloParser::Result readRecord(CBS* records, CBS* record) {
+  uint8_t content_type;
+  uint16_t version;
+  uint16_t length;
+  if (!CBS_get_u8(records, &content_type)) {
+    return ClientHelloParser::Result::NeedMoreData;
+  }
+  if (content_type != HandshakeContentType) {
+    return ClientHelloParser::Result::NotClientHello;
+  }
+  if (!CBS_get_u16(records, &version)) {
+    return ClientHelloParser::Result::NeedMoreData;
+  }
+  if ((version >> 8) != RecordMajorVersion) {
+    return ClientHelloParser::Result::NotClientHello;
+  }
+  if (!CBS_get_u16(records, &length)) {
+    return ClientHelloParser::Result::NeedMoreData;
+  }
+  if (length == 0 || length > MaxRecordSize) {
+    return ClientHelloParser::Result::NotClientHello;
+  }
+  if (!CBS_get_bytes(records, record, length)) {
+    return ClientHelloParser::Result::NeedMoreData;
+  }
+  return ClientHelloParser::Result::Done;
+}
+
+// Check the header of the handshake message, setting the size of the whole message.
+ClientHelloParser::Result readHandshakeHeader(absl::Span<const uint8_t> data, size_t* size) {
+  if (data.size() < HandshakeHeaderSize) {
+    return ClientHelloParser::Result::NeedMoreData;
+  }
+  if (data[0] != ClientHelloMessageType) {
+    return ClientHelloParser::Result::NotClientHello;
+  }
+  const size_t length = (size_t(data[1]) << 16) | (size_t(data[2]) << 8) | data[3];
+  if (length > ClientHelloParser::MAX_CLIENT_HELLO_MESSAGE_SIZE) {
+    return ClientHelloParser::Result::NotClientHello;
+  }
+  *size = HandshakeHeaderSize + length;
+  return ClientHelloParser::Result::Done;
+}
+
+absl::Span<const uint8_t> toSpan(const CBS& cbs) { return {CBS_data(&cbs), CBS_len(&cbs)}; }
+
+} // namespace
+
+ClientHelloParser::Result ClientHelloParser::parse(absl::Span<const uint8_t> data) {
+  version_ = 0;
+  cipher_suites_ = {};
+  extensions_ = {};
+  server_name_ = {};
+
+  CBS message;
+  const Result result = readHandshakeMessage(data, &message);
+  if (result != Result::Done) {
+    return result;
+  }
+  if (!parseMessage(message) || !negotiateVersion() || !parseServerName()) {
+    return Result::NotClientHello;
+  }
+  return Result::Done;
+}
+
+ClientHelloParser::Result ClientHelloParser::readHandshakeMessage(absl::Span<const uint8_t> data,
+                                                                  CBS* message) {
+  CBS records;
+  CBS_init(&records, data.data(), data.size());
+  reassembled_.clear();
+  while (true) {
+    CBS record;
+    Result result = readRecord(&records, &record);
+    if (result != Result::Done) {
+      return result;
+    }
+
+    size_t size;
+    if (reassembled_.empty()) {
+      // The ClientHello almost always fits in the first record, so use it in place.
+      result = readHandshakeHeader(toSpan(record), &size);
+      if (result == Result::NotClientHello) {
+        return result;
+      }
+      if (result == Result::Done && CBS_len(&record) >= size) {
+        CBS_init(message, CBS_data(&record), size);
+        return Result::Done;
+      }
+    }
+
+    const absl::Span<const uint8_t> fragment = toSpan(record);
+    reassembled_.insert(reassembled_.end(), fragment.begin(), fragment.end());
+    result = readHandshakeHeader(reassembled_, &size);
+    if (result == Result::NotClientHello) {
+      return result;
+    }
+    if (result == Result::Done && reassembled_.size() >= size) {
+      CBS_init(message, reassembled_.data(), size);
+      return Result::Done;
+    }
+  }
+}
+
+bool ClientHelloParser::parseMessage(CBS message) {
+  CBS session_id;
+  CBS cipher_suites;
+  CBS compression_methods;
+  if (!CBS_skip(&message, HandshakeHeaderSize) || !CBS_get_u16(&message, &version_) ||
+      !CBS_skip(&message, RandomSize) || !CBS_get_u8_length_prefixed(&message, &session_id) ||
+      CBS_len(&session_id) > MaxSessionIdSize ||
+      !CBS_get_u16_length_prefixed(&message, &cipher_suites) || CBS_len(&cipher_suites) < 2 ||
+      CBS_len(&cipher_suites) % 2 != 0 ||
+      !CBS_get_u8_length_prefixed(&message, &compression_methods) ||
+      CBS_len(&compression_methods) < 1) {
+    return false;
+  }
+  cipher_suites_ = toSpan(cipher_suites);
+
+  // Extensions are optional.
+  if (CBS_len(&message) == 0) {
+    return true;
+  }
+  CBS extensions;
+  if (!CBS_get_u16_length_prefixed(&message, &extensions) || CBS_len(&message) != 0) {
+    return false;
+  }
+  extensions_ = toSpan(extensions);
+
+  // Check the framing and reject duplicated extensions. There are a few dozen extensions at most,
+  // so comparing each with the following ones is cheaper than building a set.
+  while (CBS_len(&extensions) > 0) {
+    uint16_t type;
+    CBS body;
+    if (!CBS_get_u16(&extensions, &type) || !CBS_get_u16_length_prefixed(&extensions, &body)) {
+      return false;
+    }
+    CBS following = extensions;
+    while (CBS_len(&following) > 0) {
+      uint16_t following_type;
+      if (!CBS_get_u16(&following, &following_type) ||
+          !CBS_get_u16_length_prefixed(&following, &body)) {
+        return false;
+      }
+      if (following_type == type) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ClientHelloParser::negotiateVersion() const {
+  CBS supported_versions;
+  if (!getExtension(TLSEXT_TYPE_supported_versions, &supported_versions)) {
+    // Without the extension, the client supports the versions up to the legacy version, which
+    // can't negotiate TLS 1.3.
+    return version_ >= TLS1_VERSION &&
+           std::min<uint16_t>(version_, TLS1_2_VERSION) >= min_version_;
+  }
+
+  CBS versions;
+  if (!CBS_get_u8_length_prefixed(&supported_versions, &versions) ||
+      CBS_len(&supported_versions) != 0 || CBS_len(&versions) == 0) {
+    return false;
+  }
+  while (CBS_len(&versions) > 0) {
+    uint16_t version;
+    if (!CBS_get_u16(&versions, &version)) {
+      return false;
+    }
+    if (version >= min_version_ && version <= max_version_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ClientHelloParser::parseServerName() {
+  CBS server_name;
+  if (!getExtension(TLSEXT_TYPE_server_name, &server_name)) {
+    return true;
+  }
+
+  // Like BoringSSL, only accept a single host name.
+  CBS server_name_list;
+  CBS host_name;
+  uint8_t name_type;
+  if (!CBS_get_u16_length_prefixed(&server_name, &server_name_list) ||
+      !CBS_get_u8(&server_name_list, &name_type) ||
+      !CBS_get_u16_length_prefixed(&server_name_list, &host_name) ||
+      CBS_len(&server_name_list) != 0 || CBS_len(&server_name) != 0 ||
+      name_type != TLSEXT_NAMETYPE_host_name || CBS_len(&host_name) == 0 ||
+      CBS_len(&host_name) > MaxHostNameSize || CBS_contains_zero_byte(&host_name)) {
+    return false;
+  }
+  server_name_ = {reinterpret_cast<const char*>(CBS_data(&host_name)), CBS_len(&host_name)};
+  return true;
+}
+
+bool ClientHelloParser::getExtension(uint16_t type, CBS* out) const {
+  CBS extensions;
+  CBS_init(&extensions, extensions_.data(), extensions_.size());
+  while (CBS_len(&extensions) > 0) {
+    uint16_t extension_type;
+    CBS body;
+    if (!CBS_get_u16(&extensions, &extension_type) ||
+        !CBS_get_u16_length_prefixed(&extensions, &body)) {
+      return false;
+    }
+    if (extension_type == type) {
+      *out = body;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/bytestring.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+/**
+ * Parses the TLS ClientHello at the start of a connection without setting up a TLS handshake.
+ * Only the structure of the message is checked, along with the protocol version and the server
+ * name, like BoringSSL does before it looks at the extensions. The parsed fields point into the
+ * parsed data, so the data must outlive them. Nothing is allocated unless the ClientHello spans
+ * several TLS records.
+ */
+class ClientHelloParser {
+public:
+  enum class Result {
+    // A ClientHello was parsed.
+    Done,
+    // The data is the beginning of a ClientHello.
+    NeedMoreData,
+    // The data is not a ClientHello of a supported TLS version.
+    NotClientHello
+  };
+
+  /**
+   * @param min_version supplies the minimum TLS version to accept.
+   * @param max_version supplies the maximum TLS version to accept.
+   */
+  ClientHelloParser(uint16_t min_version, uint16_t max_version)
+      : min_version_(min_version), max_version_(max_version) {}
+
+  /**
+   * Parse the ClientHello from the start of the data received on the connection.
+   * @param data supplies all the data received so far.
+   * @return the result of the parsing. The accessors below are only valid after Result::Done.
+   */
+  Result parse(absl::Span<const uint8_t> data);
+
+  // The legacy version field of the ClientHello.
+  uint16_t version() const { return version_; }
+  // The cipher suites, as a list of 16-bit values.
+  absl::Span<const uint8_t> cipherSuites() const { return cipher_suites_; }
+  // The extensions, as a list of 16-bit types with 16-bit length-prefixed bodies.
+  absl::Span<const uint8_t> extensions() const { return extensions_; }
+  // The requested server name, empty if none.
+  absl::string_view serverName() const { return server_name_; }
+
+  /**
+   * Find an extension of the ClientHello.
+   * @param type supplies the type of the extension.
+   * @param out receives the body of the extension if found.
+   * @return true if the extension was found.
+   */
+  bool getExtension(uint16_t type, CBS* out) const;
+
+  // BoringSSL limits handshake messages it receives before the peer certificate to this size.
+  static constexpr size_t MAX_CLIENT_HELLO_MESSAGE_SIZE = 16384;
+
+private:
+  // Gathers the handshake message containing the ClientHello from the TLS records.
+  Result readHandshakeMessage(absl::Span<const uint8_t> data, CBS* message);
+  bool parseMessage(CBS message);
+  bool negotiateVersion() const;
+  bool parseServerName();
+
+  const uint16_t min_version_;
+  const uint16_t max_version_;
+  uint16_t version_{};
+  absl::Span<const uint8_t> cipher_suites_;
+  absl::Span<const uint8_t> extensions_;
+  absl::string_view server_name_;
+  // Only used for ClientHello messages spanning several records.
+  std::vector<uint8_t> reassembled_;
+};
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
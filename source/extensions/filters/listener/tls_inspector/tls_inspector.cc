@@ -17,7 +17,7 @@
 #include "source/common/common/hex.h"
 #include "source/common/protobuf/utility.h"
 
-#include "absl/strings/str_format.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "openssl/md5.h"
 #include "openssl/ssl.h"
@@ -27,7 +27,7 @@ namespace Extensions {
 namespace ListenerFilters {
 namespace TlsInspector {
 
-// Min/max TLS version recognized by the underlying TLS/SSL library.
+// Min/max TLS version recognized by the ClientHello parser.
 const unsigned Config::TLS_MIN_SUPPORTED_VERSION = TLS1_VERSION;
 const unsigned Config::TLS_MAX_SUPPORTED_VERSION = TLS1_3_VERSION;
 
@@ -36,7 +36,6 @@ Config::Config(
     const envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector& proto_config,
     uint32_t max_client_hello_size)
     : stats_{ALL_TLS_INSPECTOR_STATS(POOL_COUNTER_PREFIX(scope, "tls_inspector."))},
-      ssl_ctx_(SSL_CTX_new(TLS_with_buffers_method())),
       enable_ja3_fingerprinting_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, enable_ja3_fingerprinting, false)),
       max_client_hello_size_(max_client_hello_size) {
@@ -45,42 +44,9 @@ Config::Config(
     throw EnvoyException(fmt::format("max_client_hello_size of {} is greater than maximum of {}.",
                                      max_client_hello_size_, size_t(TLS_MAX_CLIENT_HELLO)));
   }
-
-  SSL_CTX_set_min_proto_version(ssl_ctx_.get(), TLS_MIN_SUPPORTED_VERSION);
-  SSL_CTX_set_max_proto_version(ssl_ctx_.get(), TLS_MAX_SUPPORTED_VERSION);
-  SSL_CTX_set_options(ssl_ctx_.get(), SSL_OP_NO_TICKET);
-  SSL_CTX_set_session_cache_mode(ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
-  SSL_CTX_set_select_certificate_cb(
-      ssl_ctx_.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
-        Filter* filter = static_cast<Filter*>(SSL_get_app_data(client_hello->ssl));
-        filter->createJA3Hash(client_hello);
-
-        const uint8_t* data;
-        size_t len;
-        if (SSL_early_callback_ctx_extension_get(
-                client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
-          filter->onALPN(data, len);
-        }
-        return ssl_select_cert_success;
-      });
-  SSL_CTX_set_tlsext_servername_callback(
-      ssl_ctx_.get(), [](SSL* ssl, int* out_alert, void*) -> int {
-        Filter* filter = static_cast<Filter*>(SSL_get_app_data(ssl));
-        filter->onServername(
-            absl::NullSafeStringView(SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name)));
-
-        // Return an error to stop the handshake; we have what we wanted already.
-        *out_alert = SSL_AD_USER_CANCELLED;
-        return SSL_TLSEXT_ERR_ALERT_FATAL;
-      });
 }
 
-bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
-
-Filter::Filter(const ConfigSharedPtr& config) : config_(config), ssl_(config_->newSsl()) {
-  SSL_set_app_data(ssl_.get(), this);
-  SSL_set_accept_state(ssl_.get());
-}
+Filter::Filter(const ConfigSharedPtr& config) : config_(config) {}
 
 Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   ENVOY_LOG(debug, "tls inspector: new connection accepted");
@@ -118,20 +84,18 @@ void Filter::onServername(absl::string_view name) {
   } else {
     config_->stats().sni_not_found_.inc();
   }
-  clienthello_success_ = true;
 }
 
 Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   auto raw_slice = buffer.rawSlice();
   ENVOY_LOG(trace, "tls inspector: recv: {}", raw_slice.len_);
 
-  // Because we're doing a MSG_PEEK, data we've seen before gets returned every time, so
-  // skip over what we've already processed.
+  // Because we're doing a MSG_PEEK, data we've seen before gets returned every time. The parser
+  // starts over from the beginning of the ClientHello, so only parse once there is new data.
   if (static_cast<uint64_t>(raw_slice.len_) > read_) {
-    const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
-    const size_t len = raw_slice.len_ - read_;
     read_ = raw_slice.len_;
-    ParseState parse_state = parseClientHello(data, len);
+    ParseState parse_state = parseClientHello(
+        {static_cast<const uint8_t*>(raw_slice.mem_), static_cast<size_t>(raw_slice.len_)});
     switch (parse_state) {
     case ParseState::Error:
       cb_->socket().ioHandle().close();
@@ -148,23 +112,11 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   return Network::FilterStatus::StopIteration;
 }
 
-ParseState Filter::parseClientHello(const void* data, size_t len) {
-  // Ownership is passed to ssl_ in SSL_set_bio()
-  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(data, len));
-
-  // Make the mem-BIO return that there is more data
-  // available beyond it's end
-  BIO_set_mem_eof_return(bio.get(), -1);
-
-  SSL_set_bio(ssl_.get(), bio.get(), bio.get());
-  bio.release();
-
-  int ret = SSL_do_handshake(ssl_.get());
-
-  // This should never succeed because an error is always returned from the SNI callback.
-  ASSERT(ret <= 0);
-  switch (SSL_get_error(ssl_.get(), ret)) {
-  case SSL_ERROR_WANT_READ:
+ParseState Filter::parseClientHello(absl::Span<const uint8_t> data) {
+  ClientHelloParser client_hello(Config::TLS_MIN_SUPPORTED_VERSION,
+                                 Config::TLS_MAX_SUPPORTED_VERSION);
+  switch (client_hello.parse(data)) {
+  case ClientHelloParser::Result::NeedMoreData:
     if (read_ == config_->maxClientHelloSize()) {
       // We've hit the specified size limit. This is an unreasonably large ClientHello;
       // indicate failure.
@@ -172,22 +124,28 @@ ParseState Filter::parseClientHello(const void* data, size_t len) {
       return ParseState::Error;
     }
     return ParseState::Continue;
-  case SSL_ERROR_SSL:
-    if (clienthello_success_) {
-      config_->stats().tls_found_.inc();
-      if (alpn_found_) {
-        config_->stats().alpn_found_.inc();
-      } else {
-        config_->stats().alpn_not_found_.inc();
-      }
-      cb_->socket().setDetectedTransportProtocol("tls");
-    } else {
-      config_->stats().tls_not_found_.inc();
-    }
+  case ClientHelloParser::Result::NotClientHello:
+    config_->stats().tls_not_found_.inc();
     return ParseState::Done;
-  default:
-    return ParseState::Error;
+  case ClientHelloParser::Result::Done:
+    break;
+  }
+
+  createJA3Hash(client_hello);
+  CBS alpn;
+  if (client_hello.getExtension(TLSEXT_TYPE_application_layer_protocol_negotiation, &alpn)) {
+    onALPN(CBS_data(&alpn), CBS_len(&alpn));
+  }
+  onServername(client_hello.serverName());
+
+  config_->stats().tls_found_.inc();
+  if (alpn_found_) {
+    config_->stats().alpn_found_.inc();
+  } else {
+    config_->stats().alpn_not_found_.inc();
   }
+  cb_->socket().setDetectedTransportProtocol("tls");
+  return ParseState::Done;
 }
 
 // Google GREASE values (https://datatracker.ietf.org/doc/html/rfc8701)
@@ -200,9 +158,9 @@ bool isNotGrease(uint16_t id) {
   return std::find(GREASE.begin(), GREASE.end(), id) == GREASE.end();
 }
 
-void writeCipherSuites(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fingerprint) {
+void writeCipherSuites(const ClientHelloParser& client_hello, std::string& fingerprint) {
   CBS cipher_suites;
-  CBS_init(&cipher_suites, ssl_client_hello->cipher_suites, ssl_client_hello->cipher_suites_len);
+  CBS_init(&cipher_suites, client_hello.cipherSuites().data(), client_hello.cipherSuites().size());
 
   bool write_cipher = true;
   bool first = true;
@@ -213,15 +171,15 @@ void writeCipherSuites(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fi
       if (!first) {
         absl::StrAppend(&fingerprint, "-");
       }
-      absl::StrAppendFormat(&fingerprint, "%d", id);
+      absl::StrAppend(&fingerprint, id);
       first = false;
     }
   }
 }
 
-void writeExtensions(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fingerprint) {
+void writeExtensions(const ClientHelloParser& client_hello, std::string& fingerprint) {
   CBS extensions;
-  CBS_init(&extensions, ssl_client_hello->extensions, ssl_client_hello->extensions_len);
+  CBS_init(&extensions, client_hello.extensions().data(), client_hello.extensions().size());
 
   bool write_extension = true;
   bool first = true;
@@ -235,20 +193,15 @@ void writeExtensions(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fing
       if (!first) {
         absl::StrAppend(&fingerprint, "-");
       }
-      absl::StrAppendFormat(&fingerprint, "%d", id);
+      absl::StrAppend(&fingerprint, id);
       first = false;
     }
   }
 }
 
-void writeEllipticCurves(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fingerprint) {
-  const uint8_t* ec_data;
-  size_t ec_len;
-  if (SSL_early_callback_ctx_extension_get(ssl_client_hello, TLSEXT_TYPE_supported_groups, &ec_data,
-                                           &ec_len)) {
-    CBS ec;
-    CBS_init(&ec, ec_data, ec_len);
-
+void writeEllipticCurves(const ClientHelloParser& client_hello, std::string& fingerprint) {
+  CBS ec;
+  if (client_hello.getExtension(TLSEXT_TYPE_supported_groups, &ec)) {
     // skip list length
     uint16_t id;
     bool write_elliptic_curve = CBS_get_u16(&ec, &id);
@@ -260,22 +213,17 @@ void writeEllipticCurves(const SSL_CLIENT_HELLO* ssl_client_hello, std::string&
         if (!first) {
           absl::StrAppend(&fingerprint, "-");
         }
-        absl::StrAppendFormat(&fingerprint, "%d", id);
+        absl::StrAppend(&fingerprint, id);
         first = false;
       }
     }
   }
 }
 
-void writeEllipticCurvePointFormats(const SSL_CLIENT_HELLO* ssl_client_hello,
+void writeEllipticCurvePointFormats(const ClientHelloParser& client_hello,
                                     std::string& fingerprint) {
-  const uint8_t* ecpf_data;
-  size_t ecpf_len;
-  if (SSL_early_callback_ctx_extension_get(ssl_client_hello, TLSEXT_TYPE_ec_point_formats,
-                                           &ecpf_data, &ecpf_len)) {
-    CBS ecpf;
-    CBS_init(&ecpf, ecpf_data, ecpf_len);
-
+  CBS ecpf;
+  if (client_hello.getExtension(TLSEXT_TYPE_ec_point_formats, &ecpf)) {
     // skip list length
     uint8_t id;
     bool write_point_format = CBS_get_u8(&ecpf, &id);
@@ -287,25 +235,24 @@ void writeEllipticCurvePointFormats(const SSL_CLIENT_HELLO* ssl_client_hello,
         if (!first) {
           absl::StrAppend(&fingerprint, "-");
         }
-        absl::StrAppendFormat(&fingerprint, "%d", id);
+        absl::StrAppend(&fingerprint, id);
         first = false;
       }
     }
   }
 }
 
-void Filter::createJA3Hash(const SSL_CLIENT_HELLO* ssl_client_hello) {
+void Filter::createJA3Hash(const ClientHelloParser& client_hello) {
   if (config_->enableJA3Fingerprinting()) {
     std::string fingerprint;
-    const uint16_t client_version = ssl_client_hello->version;
-    absl::StrAppendFormat(&fingerprint, "%d,", client_version);
-    writeCipherSuites(ssl_client_hello, fingerprint);
+    absl::StrAppend(&fingerprint, client_hello.version(), ",");
+    writeCipherSuites(client_hello, fingerprint);
     absl::StrAppend(&fingerprint, ",");
-    writeExtensions(ssl_client_hello, fingerprint);
+    writeExtensions(client_hello, fingerprint);
     absl::StrAppend(&fingerprint, ",");
-    writeEllipticCurves(ssl_client_hello, fingerprint);
+    writeEllipticCurves(client_hello, fingerprint);
     absl::StrAppend(&fingerprint, ",");
-    writeEllipticCurvePointFormats(ssl_client_hello, fingerprint);
+    writeEllipticCurvePointFormats(client_hello, fingerprint);
 
     ENVOY_LOG(trace, "tls:createJA3Hash(), fingerprint: {}", fingerprint);
 
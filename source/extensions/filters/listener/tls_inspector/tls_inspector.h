@@ -8,8 +8,7 @@
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/logger.h"
-
-#include "openssl/ssl.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -53,7 +52,6 @@ public:
          uint32_t max_client_hello_size = TLS_MAX_CLIENT_HELLO);
 
   const TlsInspectorStats& stats() const { return stats_; }
-  bssl::UniquePtr<SSL> newSsl();
   bool enableJA3Fingerprinting() const { return enable_ja3_fingerprinting_; }
   uint32_t maxClientHelloSize() const { return max_client_hello_size_; }
 
@@ -63,7 +61,6 @@ public:
 
 private:
   TlsInspectorStats stats_;
-  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
   const bool enable_ja3_fingerprinting_;
   const uint32_t max_client_hello_size_;
 };
@@ -83,22 +80,16 @@ public:
   size_t maxReadBytes() const override { return config_->maxClientHelloSize(); }
 
 private:
-  ParseState parseClientHello(const void* data, size_t len);
-  ParseState onRead();
+  ParseState parseClientHello(absl::Span<const uint8_t> data);
   void onALPN(const unsigned char* data, unsigned int len);
   void onServername(absl::string_view name);
-  void createJA3Hash(const SSL_CLIENT_HELLO* ssl_client_hello);
+  void createJA3Hash(const ClientHelloParser& client_hello);
 
   ConfigSharedPtr config_;
   Network::ListenerFilterCallbacks* cb_{};
 
-  bssl::UniquePtr<SSL> ssl_;
   uint64_t read_{0};
   bool alpn_found_{false};
-  bool clienthello_success_{false};
-
-  // Allows callbacks on the SSL_CTX to set fields in this class.
-  friend class Config;
 };
 
 } // namespace TlsInspector
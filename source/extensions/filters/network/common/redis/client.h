@@ -85,6 +85,11 @@ public:
    */
   virtual bool active() PURE;
 
+  /**
+   * @return uint64_t the number of requests waiting for their response.
+   */
+  virtual uint64_t pendingRequests() PURE;
+
   /**
    * Closes the underlying network connection.
    */
@@ -172,6 +177,11 @@ public:
    */
   virtual uint32_t maxUpstreamUnknownConnections() const PURE;
 
+  /**
+   * @return the maximum number of connections opened to each upstream host.
+   */
+  virtual uint32_t maxConnectionsPerHost() const PURE;
+
   /**
    * @return when enabled, upstream cluster per-command statistics will be recorded.
    */
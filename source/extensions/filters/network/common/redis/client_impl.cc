@@ -28,6 +28,8 @@ ConfigImpl::ConfigImpl(
                // as the buffer is flushed on each request immediately.
       max_upstream_unknown_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_upstream_unknown_connections, 100)),
+      max_connections_per_host_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connections_per_host, 1)),
       enable_command_stats_(config.enable_command_stats()) {
   switch (config.read_policy()) {
     PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
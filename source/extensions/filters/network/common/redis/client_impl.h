@@ -52,6 +52,7 @@ public:
   uint32_t maxUpstreamUnknownConnections() const override {
     return max_upstream_unknown_connections_;
   }
+  uint32_t maxConnectionsPerHost() const override { return max_connections_per_host_; }
   bool enableCommandStats() const override { return enable_command_stats_; }
   ReadPolicy readPolicy() const override { return read_policy_; }
 
@@ -62,6 +63,7 @@ private:
   const uint32_t max_buffer_size_before_flush_;
   const std::chrono::milliseconds buffer_flush_timeout_;
   const uint32_t max_upstream_unknown_connections_;
+  const uint32_t max_connections_per_host_;
   const bool enable_command_stats_;
   ReadPolicy read_policy_;
 };
@@ -87,6 +89,7 @@ public:
   void close() override;
   PoolRequest* makeRequest(const RespValue& request, ClientCallbacks& callbacks) override;
   bool active() override { return !pending_requests_.empty(); }
+  uint64_t pendingRequests() override { return pending_requests_.size(); }
   void flushBufferAndResetTimer();
   void initialize(const std::string& auth_username, const std::string& auth_password) override;
 
@@ -330,14 +330,16 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
+  uint64_t following_length = data.length();
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    parseSlice(slice);
+    following_length -= slice.len_;
+    parseSlice(slice, following_length);
   }
 
   data.drain(data.length());
 }
 
-void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
+void DecoderImpl::parseSlice(const Buffer::RawSlice& slice, uint64_t following_length) {
   const char* buffer = reinterpret_cast<const char*>(slice.mem_);
   uint64_t remaining = slice.len_;
 
@@ -458,7 +460,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // TODO(mattklein123): define max length since we don't stream currently.
+          // Reserve the bytes of the string which were already received, so that large strings
+          // aren't reallocated as they are appended, without trusting the length sent by the peer.
+          current_value.value_->asString().reserve(
+              std::min(pending_integer_.integer_, remaining + following_length));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
@@ -55,7 +55,8 @@ private:
     uint64_t current_array_element_;
   };
 
-  void parseSlice(const Buffer::RawSlice& slice);
+  // following_length is the number of bytes of the slices following this one in the input.
+  void parseSlice(const Buffer::RawSlice& slice, uint64_t following_length);
 
   DecoderCallbacks& callbacks_;
   State state_{State::ValueRootStart};
@@ -9,11 +9,16 @@ namespace DubboProxy {
 
 RpcInvocationImpl::Attachment::Attachment(MapPtr&& value, size_t offset)
     : attachment_(std::move(value)), attachment_offset_(offset) {
-  headers_ = Http::RequestHeaderMapImpl::create();
-
   ASSERT(attachment_ != nullptr);
   ASSERT(attachment_->toMutableUntypedMap().has_value());
+}
+
+const Http::HeaderMap& RpcInvocationImpl::Attachment::headers() const {
+  if (headers_ != nullptr) {
+    return *headers_;
+  }
 
+  headers_ = Http::RequestHeaderMapImpl::create();
   for (const auto& pair : *attachment_) {
     const auto key = pair.first->toString();
     const auto value = pair.second->toString();
@@ -22,6 +27,7 @@ RpcInvocationImpl::Attachment::Attachment(MapPtr&& value, size_t offset)
     }
     headers_->addCopy(Http::LowerCaseString(key.value().get()), value.value().get());
   }
+  return *headers_;
 }
 
 void RpcInvocationImpl::Attachment::insert(const std::string& key, const std::string& value) {
@@ -29,9 +35,11 @@ void RpcInvocationImpl::Attachment::insert(const std::string& key, const std::st
 
   attachment_->emplace(std::make_unique<String>(key), std::make_unique<String>(value));
 
-  auto lowcase_key = Http::LowerCaseString(key);
-  headers_->remove(lowcase_key);
-  headers_->addCopy(lowcase_key, value);
+  if (headers_ != nullptr) {
+    auto lowcase_key = Http::LowerCaseString(key);
+    headers_->remove(lowcase_key);
+    headers_->addCopy(lowcase_key, value);
+  }
 }
 
 void RpcInvocationImpl::Attachment::remove(const std::string& key) {
@@ -39,7 +47,9 @@ void RpcInvocationImpl::Attachment::remove(const std::string& key) {
 
   attachment_updated_ = true;
   attachment_->toMutableUntypedMap().value().get().erase(key);
-  headers_->remove(Http::LowerCaseString(key));
+  if (headers_ != nullptr) {
+    headers_->remove(Http::LowerCaseString(key));
+  }
 }
 
 const std::string* RpcInvocationImpl::Attachment::lookup(const std::string& key) const {
@@ -152,6 +152,17 @@ public:
   virtual void numberReturned(int32_t number_returned) PURE;
   virtual const std::list<Bson::DocumentSharedPtr>& documents() const PURE;
   virtual std::list<Bson::DocumentSharedPtr>& documents() PURE;
+
+  /**
+   * @return the number of documents. Unlike documents(), it does not decode the documents.
+   */
+  virtual uint64_t documentCount() const PURE;
+
+  /**
+   * @return the total byte size of the documents. Unlike documents(), it does not decode the
+   * documents.
+   */
+  virtual uint64_t documentsByteSize() const PURE;
 };
 
 using ReplyMessagePtr = std::unique_ptr<ReplyMessage>;
@@ -1,5 +1,6 @@
 #include "source/extensions/filters/network/mongo_proxy/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -182,17 +183,61 @@ std::string QueryMessageImpl::toString(bool full) const {
       return_fields_selector_ ? return_fields_selector_->toString() : "{}");
 }
 
-void ReplyMessageImpl::fromBuffer(uint32_t, Buffer::Instance& data) {
+void ReplyMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instance& data) {
   ENVOY_LOG(trace, "decoding reply message");
+  // flags, cursor id, starting from and number returned.
+  constexpr uint32_t FixedFieldsSize = 20;
+  if (message_length < FixedFieldsSize) {
+    throw EnvoyException("invalid reply message length");
+  }
+
   flags_ = Bson::BufferHelper::removeInt32(data);
   cursor_id_ = Bson::BufferHelper::removeInt64(data);
   starting_from_ = Bson::BufferHelper::removeInt32(data);
   number_returned_ = Bson::BufferHelper::removeInt32(data);
+  encoded_documents_.move(data, message_length - FixedFieldsSize);
+
+  ENVOY_LOG(trace, "{}", toString(true));
+}
+
+void ReplyMessageImpl::decodeDocuments() const {
+  if (encoded_documents_.length() == 0) {
+    return;
+  }
+
   for (int32_t i = 0; i < number_returned_; i++) {
-    documents_.emplace_back(Bson::DocumentImpl::create(data));
+    documents_.emplace_back(Bson::DocumentImpl::create(encoded_documents_));
   }
+  encoded_documents_.drain(encoded_documents_.length());
+}
 
-  ENVOY_LOG(trace, "{}", toString(true));
+const std::list<Bson::DocumentSharedPtr>& ReplyMessageImpl::documents() const {
+  decodeDocuments();
+  return documents_;
+}
+
+std::list<Bson::DocumentSharedPtr>& ReplyMessageImpl::documents() {
+  decodeDocuments();
+  return documents_;
+}
+
+uint64_t ReplyMessageImpl::documentCount() const {
+  if (encoded_documents_.length() != 0) {
+    return std::max(number_returned_, 0);
+  }
+  return documents_.size();
+}
+
+uint64_t ReplyMessageImpl::documentsByteSize() const {
+  if (encoded_documents_.length() != 0) {
+    return encoded_documents_.length();
+  }
+
+  uint64_t byte_size = 0;
+  for (const Bson::DocumentSharedPtr& document : documents_) {
+    byte_size += document->byteSize();
+  }
+  return byte_size;
 }
 
 bool ReplyMessageImpl::operator==(const ReplyMessage& rhs) const {
@@ -218,7 +263,7 @@ std::string ReplyMessageImpl::toString(bool full) const {
       R"EOF({{"opcode": "OP_REPLY", "id": {}, "response_to": {}, "flags": "{:#x}", "cursor": "{}", )EOF"
       R"EOF("from": {}, "returned": {}, "documents": {}}})EOF",
       request_id_, response_to_, flags_, cursor_id_, starting_from_, number_returned_,
-      full ? documentListToString(documents_) : std::to_string(documents_.size()));
+      full ? documentListToString(documents()) : std::to_string(documentCount()));
 }
 
 /*
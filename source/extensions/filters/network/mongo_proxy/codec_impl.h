@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/network/mongo_proxy/codec.h"
 
@@ -175,15 +176,22 @@ public:
   void startingFrom(int32_t starting_from) override { starting_from_ = starting_from; }
   int32_t numberReturned() const override { return number_returned_; }
   void numberReturned(int32_t number_returned) override { number_returned_ = number_returned; }
-  const std::list<Bson::DocumentSharedPtr>& documents() const override { return documents_; }
-  std::list<Bson::DocumentSharedPtr>& documents() override { return documents_; }
+  const std::list<Bson::DocumentSharedPtr>& documents() const override;
+  std::list<Bson::DocumentSharedPtr>& documents() override;
+  uint64_t documentCount() const override;
+  uint64_t documentsByteSize() const override;
 
 private:
+  void decodeDocuments() const;
+
   int32_t flags_{};
   int64_t cursor_id_{};
   int32_t starting_from_{};
   int32_t number_returned_{};
-  std::list<Bson::DocumentSharedPtr> documents_;
+  // The documents of a decoded reply are kept as they are on the wire until they are accessed, as
+  // replies are usually the largest messages and the proxy only needs their count and size.
+  mutable Buffer::OwnedImpl encoded_documents_;
+  mutable std::list<Bson::DocumentSharedPtr> documents_;
 };
 
 // OP_COMMAND message.
@@ -291,20 +291,16 @@ void ProxyFilter::onDrainClose() {
 
 void ProxyFilter::chargeReplyStats(ActiveQuery& active_query, Stats::ElementVec& names,
                                    const ReplyMessage& message) {
-  uint64_t reply_documents_byte_size = 0;
-  for (const Bson::DocumentSharedPtr& document : message.documents()) {
-    reply_documents_byte_size += document->byteSize();
-  }
-
   // Write 3 different histograms; appending 3 different suffixes to the name
   // that was passed in. Here we overwrite the passed-in names, but we restore
   // names to its original state upon return.
   const size_t orig_size = names.size();
   names.push_back(mongo_stats_->reply_num_docs_);
   mongo_stats_->recordHistogram(names, Stats::Histogram::Unit::Unspecified,
-                                message.documents().size());
+                                message.documentCount());
   names[orig_size] = mongo_stats_->reply_size_;
-  mongo_stats_->recordHistogram(names, Stats::Histogram::Unit::Bytes, reply_documents_byte_size);
+  mongo_stats_->recordHistogram(names, Stats::Histogram::Unit::Bytes,
+                                message.documentsByteSize());
   names[orig_size] = mongo_stats_->reply_time_ms_;
   mongo_stats_->recordHistogram(names, Stats::Histogram::Unit::Milliseconds,
                                 std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -3,6 +3,8 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 
+#include "absl/strings/match.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -14,6 +16,20 @@ namespace {
 // "asking".
 ConnPool::DoNothingPoolCallbacks null_pool_callbacks;
 
+/**
+ * Removes the key of a write command from the key cache of the route, if the route has one.
+ * @param route supplies the route matched with the request.
+ * @param command supplies the command of the request.
+ * @param key supplies the key of the request.
+ */
+void invalidateKey(const Route& route, const std::string& command, const std::string& key) {
+  KeyCache* key_cache = route.keyCache();
+  if (key_cache != nullptr &&
+      !Common::Redis::SupportedCommands::isReadCommand(absl::AsciiStrToLower(command))) {
+    key_cache->invalidate(key);
+  }
+}
+
 /**
  * Make request and maybe mirror the request based on the mirror policies of the route.
  * @param route supplies the route matched with the request.
@@ -29,6 +45,7 @@ Common::Redis::Client::PoolRequest* makeSingleServerRequest(
     const RouteSharedPtr& route, const std::string& command, const std::string& key,
     Common::Redis::RespValueConstSharedPtr incoming_request, ConnPool::PoolCallbacks& callbacks,
     Common::Redis::Client::Transaction& transaction) {
+  invalidateKey(*route, command, key);
   auto handler = route->upstream()->makeRequest(key, ConnPool::RespVariant(incoming_request),
                                                 callbacks, transaction);
   if (handler) {
@@ -58,6 +75,7 @@ makeFragmentedRequest(const RouteSharedPtr& route, const std::string& command,
                       const std::string& key, const Common::Redis::RespValue& incoming_request,
                       ConnPool::PoolCallbacks& callbacks,
                       Common::Redis::Client::Transaction& transaction) {
+  invalidateKey(*route, command, key);
   auto handler = route->upstream()->makeRequest(key, ConnPool::RespVariant(incoming_request),
                                                 callbacks, transaction);
   if (handler) {
@@ -158,6 +176,20 @@ SplitRequestPtr SimpleRequest::create(Router& router,
       new SimpleRequest(callbacks, command_stats, time_source, delay_command_latency)};
   const auto route = router.upstreamPool(incoming_request->asArray()[1].asString());
   if (route) {
+    KeyCache* key_cache = route->keyCache();
+    if (key_cache != nullptr &&
+        absl::EqualsIgnoreCase(incoming_request->asArray()[0].asString(), "get")) {
+      const std::string& key = incoming_request->asArray()[1].asString();
+      Common::Redis::RespValuePtr cached_response = key_cache->lookup(key);
+      if (cached_response != nullptr) {
+        request_ptr->updateStats(true);
+        callbacks.onResponse(std::move(cached_response));
+        return nullptr;
+      }
+      request_ptr->key_cache_ = key_cache;
+      request_ptr->key_cache_generation_ = key_cache->generation();
+      request_ptr->key_ = key;
+    }
     Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
     request_ptr->handle_ = makeSingleServerRequest(
         route, base_request->asArray()[0].asString(), base_request->asArray()[1].asString(),
@@ -175,6 +207,13 @@ SplitRequestPtr SimpleRequest::create(Router& router,
   return request_ptr;
 }
 
+void SimpleRequest::onResponse(Common::Redis::RespValuePtr&& response) {
+  if (key_cache_ != nullptr) {
+    key_cache_->insert(key_, *response, key_cache_generation_);
+  }
+  SingleServerRequest::onResponse(std::move(response));
+}
+
 SplitRequestPtr EvalRequest::create(Router& router, Common::Redis::RespValuePtr&& incoming_request,
                                     SplitCallbacks& callbacks, CommandStats& command_stats,
                                     TimeSource& time_source, bool delay_command_latency) {
@@ -518,6 +557,17 @@ SplitRequestPtr TransactionRequest::create(Router& router,
     route = router.upstreamPool(transaction.key_);
   }
 
+  // The commands of the transaction are sent to the route of the transaction key, but their own
+  // keys may be cached by another route.
+  if (command_name != "exec" && command_name != "discard" &&
+      !Common::Redis::SupportedCommands::isReadCommand(command_name)) {
+    std::string key = incoming_request->asArray()[1].asString();
+    const auto key_route = router.upstreamPool(key);
+    if (key_route) {
+      invalidateKey(*key_route, command_name, key);
+    }
+  }
+
   std::unique_ptr<TransactionRequest> request_ptr{
       new TransactionRequest(callbacks, command_stats, time_source, delay_command_latency)};
   if (route) {
@@ -169,7 +169,8 @@ private:
 };
 
 /**
- * SimpleRequest hashes the first argument as the key.
+ * SimpleRequest hashes the first argument as the key. The GET commands of a route with a key cache
+ * are served from the cache when they can be, and their responses cached otherwise.
  */
 class SimpleRequest : public SingleServerRequest {
 public:
@@ -177,10 +178,17 @@ public:
                                 SplitCallbacks& callbacks, CommandStats& command_stats,
                                 TimeSource& time_source, bool delay_command_latency);
 
+  // ConnPool::PoolCallbacks
+  void onResponse(Common::Redis::RespValuePtr&& response) override;
+
 private:
   SimpleRequest(SplitCallbacks& callbacks, CommandStats& command_stats, TimeSource& time_source,
                 bool delay_command_latency)
       : SingleServerRequest(callbacks, command_stats, time_source, delay_command_latency) {}
+
+  KeyCache* key_cache_{};
+  uint64_t key_cache_generation_{};
+  std::string key_;
 };
 
 /**
@@ -77,8 +77,10 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
     upstreams.emplace(cluster, conn_pool_ptr);
   }
 
-  auto router =
-      std::make_unique<PrefixRoutes>(prefix_routes, std::move(upstreams), context.runtime());
+  KeyCacheFactory key_cache_factory(context.threadLocal(), context.timeSource(), context.scope(),
+                                    filter_config->stat_prefix_);
+  auto router = std::make_unique<PrefixRoutes>(prefix_routes, std::move(upstreams),
+                                               context.runtime(), &key_cache_factory);
 
   auto fault_manager = std::make_unique<Common::Redis::FaultManagerImpl>(
       context.api().randomGenerator(), context.runtime(), proto_config.faults());
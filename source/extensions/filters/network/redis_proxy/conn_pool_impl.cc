@@ -1,5 +1,6 @@
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -108,7 +109,7 @@ InstanceImpl::ThreadLocalPool::~ThreadLocalPool() {
     pending_requests_.pop_front();
   }
   while (!client_map_.empty()) {
-    client_map_.begin()->second->redis_client_->close();
+    client_map_.begin()->second.front()->redis_client_->close();
   }
   while (!clients_to_drain_.empty()) {
     (*clients_to_drain_.begin())->redis_client_->close();
@@ -171,7 +172,7 @@ void InstanceImpl::ThreadLocalPool::onClusterRemoval(const std::string& cluster_
   // requests.
   host_set_member_update_cb_handle_ = nullptr;
   while (!client_map_.empty()) {
-    client_map_.begin()->second->redis_client_->close();
+    client_map_.begin()->second.front()->redis_client_->close();
   }
   while (!clients_to_drain_.empty()) {
     (*clients_to_drain_.begin())->redis_client_->close();
@@ -203,16 +204,27 @@ void InstanceImpl::ThreadLocalPool::onHostsRemoved(
   for (const auto& host : hosts_removed) {
     auto it = client_map_.find(host);
     if (it != client_map_.end()) {
-      if (it->second->redis_client_->active()) {
-        // Put the ThreadLocalActiveClient to the side to drain.
-        clients_to_drain_.push_back(std::move(it->second));
-        client_map_.erase(it);
-        if (!drain_timer_->enabled()) {
-          drain_timer_->enableTimer(std::chrono::seconds(1));
+      std::vector<Common::Redis::Client::Client*> idle_clients;
+      for (ThreadLocalActiveClientPtr& client : it->second) {
+        if (client->redis_client_->active()) {
+          // Put the ThreadLocalActiveClient to the side to drain.
+          clients_to_drain_.push_back(std::move(client));
+          if (!drain_timer_->enabled()) {
+            drain_timer_->enableTimer(std::chrono::seconds(1));
+          }
+        } else {
+          idle_clients.push_back(client->redis_client_.get());
         }
-      } else {
-        // There are no pending requests so close the connection.
-        it->second->redis_client_->close();
+      }
+      it->second.erase(std::remove(it->second.begin(), it->second.end(), nullptr),
+                       it->second.end());
+      if (it->second.empty()) {
+        client_map_.erase(it);
+      }
+      // There are no pending requests so close the connections. Closing a client removes it from
+      // the map, and defers its deletion.
+      for (Common::Redis::Client::Client* client : idle_clients) {
+        client->close();
       }
     }
     // There is the possibility that multiple hosts with the same address
@@ -235,17 +247,34 @@ void InstanceImpl::ThreadLocalPool::drainClients() {
 }
 
 InstanceImpl::ThreadLocalActiveClientPtr&
-InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstSharedPtr host) {
-  ThreadLocalActiveClientPtr& client = client_map_[host];
-  if (!client) {
-    client = std::make_unique<ThreadLocalActiveClient>(*this);
+InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstSharedPtr host,
+                                                       bool first_client) {
+  std::vector<ThreadLocalActiveClientPtr>& clients = client_map_[host];
+  ThreadLocalActiveClientPtr* selected = nullptr;
+  uint64_t selected_pending_requests = 0;
+  if (first_client && !clients.empty()) {
+    selected = &clients.front();
+  } else if (!first_client) {
+    for (ThreadLocalActiveClientPtr& client : clients) {
+      const uint64_t pending_requests = client->redis_client_->pendingRequests();
+      if (selected == nullptr || pending_requests < selected_pending_requests) {
+        selected = &client;
+        selected_pending_requests = pending_requests;
+      }
+    }
+  }
+  if (selected == nullptr ||
+      (selected_pending_requests > 0 && clients.size() < config_->maxConnectionsPerHost())) {
+    ThreadLocalActiveClientPtr& client =
+        clients.emplace_back(std::make_unique<ThreadLocalActiveClient>(*this));
     client->host_ = host;
     client->redis_client_ =
         client_factory_.create(host, dispatcher_, *config_, redis_command_stats_, *(stats_scope_),
                                auth_username_, auth_password_, false);
     client->redis_client_->addConnectionCallbacks(*client);
+    return client;
   }
-  return client;
+  return *selected;
 }
 
 Common::Redis::Client::PoolRequest*
@@ -364,7 +393,7 @@ Common::Redis::Client::PoolRequest* InstanceImpl::ThreadLocalPool::makeRequestTo
     it = host_address_map_.find(host_address_map_key);
   }
 
-  ThreadLocalActiveClientPtr& client = threadLocalActiveClient(it->second);
+  ThreadLocalActiveClientPtr& client = threadLocalActiveClient(it->second, true);
 
   return client->redis_client_->makeRequest(request, callbacks);
 }
@@ -379,13 +408,28 @@ void InstanceImpl::ThreadLocalPool::onRequestCompleted() {
   }
 }
 
+bool InstanceImpl::ThreadLocalActiveClient::removeClient(
+    std::vector<ThreadLocalActiveClientPtr>& clients) {
+  auto it = std::find_if(clients.begin(), clients.end(),
+                         [this](const ThreadLocalActiveClientPtr& client) {
+                           return client.get() == this;
+                         });
+  if (it == clients.end()) {
+    return false;
+  }
+  parent_.dispatcher_.deferredDelete(std::move(redis_client_));
+  clients.erase(it);
+  return true;
+}
+
 void InstanceImpl::ThreadLocalActiveClient::onEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
-    auto client_to_delete = parent_.client_map_.find(host_);
-    if (client_to_delete != parent_.client_map_.end()) {
-      parent_.dispatcher_.deferredDelete(std::move(redis_client_));
-      parent_.client_map_.erase(client_to_delete);
+    auto clients = parent_.client_map_.find(host_);
+    if (clients != parent_.client_map_.end() && removeClient(clients->second)) {
+      if (clients->second.empty()) {
+        parent_.client_map_.erase(clients);
+      }
     } else {
       for (auto it = parent_.clients_to_drain_.begin(); it != parent_.clients_to_drain_.end();
            it++) {
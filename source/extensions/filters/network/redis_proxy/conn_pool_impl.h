@@ -98,6 +98,10 @@ private:
     void onAboveWriteBufferHighWatermark() override {}
     void onBelowWriteBufferLowWatermark() override {}
 
+    // Defers the deletion of the client and removes this from the clients. Returns false if this
+    // is not one of the clients.
+    bool removeClient(std::vector<std::unique_ptr<ThreadLocalActiveClient>>& clients);
+
     ThreadLocalPool& parent_;
     Upstream::HostConstSharedPtr host_;
     Common::Redis::Client::ClientPtr redis_client_;
@@ -149,7 +153,12 @@ private:
                     std::string cluster_name,
                     const Extensions::Common::DynamicForwardProxy::DnsCacheSharedPtr& dns_cache);
     ~ThreadLocalPool() override;
-    ThreadLocalActiveClientPtr& threadLocalActiveClient(Upstream::HostConstSharedPtr host);
+    // Returns the client of the host with the fewest pending requests, creating a client while
+    // all of them are busy and there are fewer than the maximum connections per host. With
+    // first_client, returns the first client of the host, so that the requests sent with it, e.g.
+    // an ASKING followed by the redirected request, are sent on the same connection.
+    ThreadLocalActiveClientPtr& threadLocalActiveClient(Upstream::HostConstSharedPtr host,
+                                                        bool first_client = false);
     Common::Redis::Client::PoolRequest*
     makeRequest(const std::string& key, RespVariant&& request, PoolCallbacks& callbacks,
                 Common::Redis::Client::Transaction& transaction);
@@ -176,7 +185,8 @@ private:
     const Extensions::Common::DynamicForwardProxy::DnsCacheSharedPtr dns_cache_{nullptr};
     Upstream::ClusterUpdateCallbacksHandlePtr cluster_update_handle_;
     Upstream::ThreadLocalCluster* cluster_{};
-    absl::node_hash_map<Upstream::HostConstSharedPtr, ThreadLocalActiveClientPtr> client_map_;
+    absl::node_hash_map<Upstream::HostConstSharedPtr, std::vector<ThreadLocalActiveClientPtr>>
+        client_map_;
     Envoy::Common::CallbackHandlePtr host_set_member_update_cb_handle_;
     absl::node_hash_map<std::string, Upstream::HostConstSharedPtr> host_address_map_;
     std::string auth_username_;
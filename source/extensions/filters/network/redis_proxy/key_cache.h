@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * A cache of the responses to the GET commands of a route, kept by each worker thread. All the
+ * methods must be called on a worker thread.
+ */
+class KeyCache {
+public:
+  virtual ~KeyCache() = default;
+
+  /**
+   * @param key supplies the key of a GET command.
+   * @return a copy of the cached response, or nullptr if there is none.
+   */
+  virtual Common::Redis::RespValuePtr lookup(const std::string& key) PURE;
+
+  /**
+   * @return the generation of the cache of the worker, which changes each time a key is
+   * invalidated. It is taken when a GET is sent upstream, so that a response which may predate a
+   * write is not cached.
+   */
+  virtual uint64_t generation() const PURE;
+
+  /**
+   * Caches the response to a GET of the key, unless a key was invalidated since the generation.
+   * Only bulk string and null responses are cached.
+   * @param key supplies the key of the GET command.
+   * @param response supplies the response.
+   * @param generation supplies the generation of the cache when the GET was sent upstream.
+   */
+  virtual void insert(const std::string& key, const Common::Redis::RespValue& response,
+                      uint64_t generation) PURE;
+
+  /**
+   * Removes the key from the cache of the worker, as a command may write it.
+   * @param key supplies the key of the command.
+   */
+  virtual void invalidate(const std::string& key) PURE;
+};
+
+using KeyCacheSharedPtr = std::shared_ptr<KeyCache>;
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,81 @@
+#include "source/extensions/filters/network/redis_proxy/key_cache_impl.h"
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+constexpr uint32_t DefaultMaxEntriesPerWorker = 1024;
+
+} // namespace
+
+KeyCacheImpl::KeyCacheImpl(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::
+                               PrefixRoutes::Route::KeyCache& config,
+                           ThreadLocal::SlotAllocator& tls, TimeSource& time_source,
+                           const KeyCacheStats& stats)
+    : ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)), time_source_(time_source), stats_(stats),
+      tls_(tls) {
+  const uint32_t max_entries =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries_per_worker, DefaultMaxEntriesPerWorker);
+  tls_.set([max_entries](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalResponses>(max_entries);
+  });
+}
+
+Common::Redis::RespValuePtr KeyCacheImpl::lookup(const std::string& key) {
+  LruCache& responses = tls_->responses_;
+  LruCache::ScopedLookup lookup(&responses, key);
+  if (!lookup.found()) {
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  if (lookup.value()->expiry_ <= time_source_.monotonicTime()) {
+    responses.remove(key);
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  stats_.hit_.inc();
+  return std::make_unique<Common::Redis::RespValue>(lookup.value()->response_);
+}
+
+void KeyCacheImpl::insert(const std::string& key, const Common::Redis::RespValue& response,
+                          uint64_t generation) {
+  if (response.type() != Common::Redis::RespType::BulkString &&
+      response.type() != Common::Redis::RespType::Null) {
+    return;
+  }
+  ThreadLocalResponses& local = *tls_;
+  // A key was invalidated while the GET was in flight, so the response may predate a write.
+  if (generation != local.generation_) {
+    return;
+  }
+  local.responses_.remove(key);
+  local.responses_.insert(key, new CachedResponse{response, time_source_.monotonicTime() + ttl_},
+                          1);
+}
+
+void KeyCacheImpl::invalidate(const std::string& key) {
+  ThreadLocalResponses& local = *tls_;
+  local.generation_++;
+  local.responses_.remove(key);
+  stats_.invalidation_.inc();
+}
+
+KeyCacheFactory::KeyCacheFactory(ThreadLocal::SlotAllocator& tls, TimeSource& time_source,
+                                 Stats::Scope& scope, const std::string& stat_prefix)
+    : tls_(tls), time_source_(time_source),
+      stats_{ALL_KEY_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stat_prefix + "key_cache."))} {}
+
+KeyCacheSharedPtr
+KeyCacheFactory::create(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::
+                            PrefixRoutes::Route::KeyCache& config) {
+  return std::make_shared<KeyCacheImpl>(config, tls_, time_source_, stats_);
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
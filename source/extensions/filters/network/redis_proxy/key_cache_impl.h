@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+#include "source/extensions/filters/network/redis_proxy/key_cache.h"
+
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * All key cache stats. @see stats_macros.h
+ */
+#define ALL_KEY_CACHE_STATS(COUNTER)                                                               \
+  COUNTER(hit)                                                                                     \
+  COUNTER(miss)                                                                                    \
+  COUNTER(invalidation)
+
+/**
+ * Struct definition for all key cache stats. @see stats_macros.h
+ */
+struct KeyCacheStats {
+  ALL_KEY_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * A response cached for a key, and when it stops being used.
+ */
+struct CachedResponse {
+  Common::Redis::RespValue response_;
+  MonotonicTime expiry_;
+};
+
+class KeyCacheImpl : public KeyCache {
+public:
+  KeyCacheImpl(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::
+                   PrefixRoutes::Route::KeyCache& config,
+               ThreadLocal::SlotAllocator& tls, TimeSource& time_source,
+               const KeyCacheStats& stats);
+
+  // RedisProxy::KeyCache
+  Common::Redis::RespValuePtr lookup(const std::string& key) override;
+  uint64_t generation() const override { return tls_->generation_; }
+  void insert(const std::string& key, const Common::Redis::RespValue& response,
+              uint64_t generation) override;
+  void invalidate(const std::string& key) override;
+
+private:
+  using LruCache = ::google::simple_lru_cache::SimpleLRUCache<std::string, CachedResponse>;
+
+  struct ThreadLocalResponses : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalResponses(uint32_t max_entries) : responses_(max_entries) {}
+
+    LruCache responses_;
+    uint64_t generation_{};
+  };
+
+  const std::chrono::milliseconds ttl_;
+  TimeSource& time_source_;
+  KeyCacheStats stats_;
+  ThreadLocal::TypedSlot<ThreadLocalResponses> tls_;
+};
+
+/**
+ * Creates the key caches of the routes of a filter, which share the stats of the filter.
+ */
+class KeyCacheFactory {
+public:
+  KeyCacheFactory(ThreadLocal::SlotAllocator& tls, TimeSource& time_source, Stats::Scope& scope,
+                  const std::string& stat_prefix);
+
+  KeyCacheSharedPtr create(const envoy::extensions::filters::network::redis_proxy::v3::
+                               RedisProxy::PrefixRoutes::Route::KeyCache& config);
+
+private:
+  ThreadLocal::SlotAllocator& tls_;
+  TimeSource& time_source_;
+  KeyCacheStats stats_;
+};
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
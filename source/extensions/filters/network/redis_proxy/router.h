@@ -7,6 +7,7 @@
 #include "envoy/common/pure.h"
 
 #include "source/extensions/filters/network/redis_proxy/conn_pool.h"
+#include "source/extensions/filters/network/redis_proxy/key_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -48,6 +49,12 @@ public:
   virtual ConnPool::InstanceSharedPtr upstream() const PURE;
 
   virtual const MirrorPolicies& mirrorPolicies() const PURE;
+
+  /**
+   * @return the cache of the responses to the GET commands of the route, or nullptr if the
+   * responses are not cached.
+   */
+  virtual KeyCache* keyCache() const PURE;
 };
 
 using RouteSharedPtr = std::shared_ptr<Route>;
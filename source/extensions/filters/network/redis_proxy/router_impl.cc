@@ -41,9 +41,12 @@ bool MirrorPolicyImpl::shouldMirror(const std::string& command) const {
 Prefix::Prefix(
     const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes::Route
         route,
-    Upstreams& upstreams, Runtime::Loader& runtime)
+    Upstreams& upstreams, Runtime::Loader& runtime, KeyCacheFactory* key_cache_factory)
     : prefix_(route.prefix()), remove_prefix_(route.remove_prefix()),
-      upstream_(upstreams.at(route.cluster())) {
+      upstream_(upstreams.at(route.cluster())),
+      key_cache_(route.has_key_cache() && key_cache_factory != nullptr
+                     ? key_cache_factory->create(route.key_cache())
+                     : nullptr) {
   for (auto const& mirror_policy : route.request_mirror_policy()) {
     mirror_policies_.emplace_back(std::make_shared<MirrorPolicyImpl>(
         mirror_policy, upstreams.at(mirror_policy.cluster()), runtime));
@@ -52,10 +55,11 @@ Prefix::Prefix(
 
 PrefixRoutes::PrefixRoutes(
     const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes& config,
-    Upstreams&& upstreams, Runtime::Loader& runtime)
+    Upstreams&& upstreams, Runtime::Loader& runtime, KeyCacheFactory* key_cache_factory)
     : case_insensitive_(config.case_insensitive()), upstreams_(std::move(upstreams)),
       catch_all_route_(config.has_catch_all_route()
-                           ? std::make_shared<Prefix>(config.catch_all_route(), upstreams_, runtime)
+                           ? std::make_shared<Prefix>(config.catch_all_route(), upstreams_, runtime,
+                                                      key_cache_factory)
                            : nullptr) {
 
   for (auto const& route : config.routes()) {
@@ -66,7 +70,8 @@ PrefixRoutes::PrefixRoutes(
     }
 
     auto success = prefix_lookup_table_.add(
-        copy.c_str(), std::make_shared<Prefix>(route, upstreams_, runtime), false);
+        copy.c_str(),
+        std::make_shared<Prefix>(route, upstreams_, runtime, key_cache_factory), false);
     if (!success) {
       throw EnvoyException(fmt::format("prefix `{}` already exists.", route.prefix()));
     }
@@ -15,6 +15,7 @@
 
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
+#include "source/extensions/filters/network/redis_proxy/key_cache_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
 namespace Envoy {
@@ -46,10 +47,11 @@ class Prefix : public Route {
 public:
   Prefix(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes::Route
              route,
-         Upstreams& upstreams, Runtime::Loader& runtime);
+         Upstreams& upstreams, Runtime::Loader& runtime, KeyCacheFactory* key_cache_factory);
 
   ConnPool::InstanceSharedPtr upstream() const override { return upstream_; }
   const MirrorPolicies& mirrorPolicies() const override { return mirror_policies_; };
+  KeyCache* keyCache() const override { return key_cache_.get(); }
   const std::string& prefix() const { return prefix_; }
   bool removePrefix() const { return remove_prefix_; }
 
@@ -58,15 +60,21 @@ private:
   const bool remove_prefix_;
   const ConnPool::InstanceSharedPtr upstream_;
   MirrorPolicies mirror_policies_;
+  const KeyCacheSharedPtr key_cache_;
 };
 
 using PrefixSharedPtr = std::shared_ptr<Prefix>;
 
 class PrefixRoutes : public Router {
 public:
+  /**
+   * @param key_cache_factory supplies the factory of the key caches of the routes. The responses
+   *        of the routes are not cached if it is nullptr.
+   */
   PrefixRoutes(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes&
                    prefix_routes,
-               Upstreams&& upstreams, Runtime::Loader& runtime);
+               Upstreams&& upstreams, Runtime::Loader& runtime,
+               KeyCacheFactory* key_cache_factory = nullptr);
 
   RouteSharedPtr upstreamPool(std::string& key) override;
 
@@ -99,9 +99,12 @@ FilterStatus ShadowRouterImpl::passthroughData(Buffer::Instance& data) {
     return ProtocolConverter::passthroughData(data);
   }
 
-  auto copied = std::make_shared<Buffer::OwnedImpl>(data);
-  auto cb = [copied = std::move(copied), this]() mutable -> FilterStatus {
-    return ProtocolConverter::passthroughData(*copied);
+  // The data is consumed by the protocol converter either way, so it is moved rather than copied
+  // until the connection is ready.
+  auto pending = std::make_shared<Buffer::OwnedImpl>();
+  pending->move(data);
+  auto cb = [pending = std::move(pending), this]() mutable -> FilterStatus {
+    return ProtocolConverter::passthroughData(*pending);
   };
   pending_callbacks_.push_back(std::move(cb));
 
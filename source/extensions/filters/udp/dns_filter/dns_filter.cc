@@ -15,6 +15,7 @@ namespace UdpFilters {
 namespace DnsFilter {
 
 static constexpr std::chrono::milliseconds DEFAULT_RESOLVER_TIMEOUT{500};
+static constexpr uint32_t DEFAULT_ANSWER_CACHE_MAX_ENTRIES = 1024;
 static constexpr std::chrono::seconds DEFAULT_RESOLVER_TTL{300};
 
 DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
@@ -166,6 +167,13 @@ DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     resolver_timeout_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
         client_config, resolver_timeout, DEFAULT_RESOLVER_TIMEOUT.count()));
     max_pending_lookups_ = client_config.max_pending_lookups();
+    if (client_config.has_answer_cache()) {
+      const auto& answer_cache = client_config.answer_cache();
+      answer_cache_config_ = DnsAnswerCacheConfig{
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(answer_cache, max_entries,
+                                          DEFAULT_ANSWER_CACHE_MAX_ENTRIES),
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(answer_cache, negative_ttl, 0))};
+    }
   } else {
     // In case client_config doesn't exist, create default DNS resolver factory and save it.
     dns_resolver_factory_ = &Network::createDefaultDnsResolverFactory(typed_dns_resolver_config_);
@@ -253,7 +261,7 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
   resolver_ = std::make_unique<DnsFilterResolver>(
       resolver_callback_, config->resolverTimeout(), listener_.dispatcher(),
       config->maxPendingLookups(), config->typedDnsResolverConfig(), config->dnsResolverFactory(),
-      config->api());
+      config->api(), config->answerCacheConfig(), config->stats().external_answer_cache_hits_);
 }
 
 Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
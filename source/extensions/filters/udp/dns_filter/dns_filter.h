@@ -34,6 +34,7 @@ namespace DnsFilter {
   COUNTER(downstream_rx_invalid_queries)                                                           \
   COUNTER(downstream_rx_queries)                                                                   \
   COUNTER(external_a_record_queries)                                                               \
+  COUNTER(external_answer_cache_hits)                                                              \
   COUNTER(external_a_record_answers)                                                               \
   COUNTER(external_aaaa_record_answers)                                                            \
   COUNTER(external_aaaa_record_queries)                                                            \
@@ -96,6 +97,9 @@ public:
     return typed_dns_resolver_config_;
   }
   const Network::DnsResolverFactory& dnsResolverFactory() const { return *dns_resolver_factory_; }
+  const absl::optional<DnsAnswerCacheConfig>& answerCacheConfig() const {
+    return answer_cache_config_;
+  }
   Api::Api& api() const { return api_; }
   const TrieLookupTable<DnsVirtualDomainConfigSharedPtr>& getDnsTrie() const {
     return dns_lookup_trie_;
@@ -132,6 +136,7 @@ private:
   uint64_t max_pending_lookups_;
   envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config_;
   Network::DnsResolverFactory* dns_resolver_factory_;
+  absl::optional<DnsAnswerCacheConfig> answer_cache_config_;
 };
 
 using DnsFilterEnvoyConfigSharedPtr = std::shared_ptr<const DnsFilterEnvoyConfig>;
@@ -1,5 +1,7 @@
 #include "source/extensions/filters/udp/dns_filter/dns_filter_resolver.h"
 
+#include <algorithm>
+
 #include "source/common/network/utility.h"
 
 namespace Envoy {
@@ -36,6 +38,10 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
     return;
   }
 
+  if (lookupCachedAnswer(ctx)) {
+    return;
+  }
+
   const DnsQueryRecord* id = domain_query;
 
   // If we have too many pending lookups, invoke the callback to retry the query.
@@ -86,8 +92,8 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                        ctx.query_context->resolution_status_ = status;
                        ctx.resolver_status = DnsFilterResolverStatus::Complete;
 
-                       // C-ares doesn't expose the TTL in the data available here.
                        if (status == Network::DnsResolver::ResolutionStatus::Success) {
+                         cacheAnswer(*ctx.query_rec, response);
                          ctx.resolved_hosts.reserve(response.size());
                          for (const auto& resp : response) {
                            const auto& addrinfo = resp.addrInfo();
@@ -103,6 +109,59 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                      });
 }
 
+bool DnsFilterResolver::lookupCachedAnswer(LookupContext& context) {
+  if (answers_ == nullptr) {
+    return false;
+  }
+  const std::string key = answerCacheKey(*context.query_rec);
+  {
+    AnswerCache::ScopedLookup lookup(answers_.get(), key);
+    if (!lookup.found()) {
+      return false;
+    }
+    if (lookup.value()->expiry_ > dispatcher_.timeSource().monotonicTime()) {
+      context.resolved_hosts = lookup.value()->addresses_;
+      context.query_context->resolution_status_ = Network::DnsResolver::ResolutionStatus::Success;
+      context.resolver_status = DnsFilterResolverStatus::Complete;
+    }
+  }
+  if (context.resolver_status != DnsFilterResolverStatus::Complete) {
+    answers_->remove(key);
+    return false;
+  }
+
+  ENVOY_LOG(trace, "Answering query for [{}] from the answer cache", context.query_rec->name_);
+  answer_cache_hits_.inc();
+  invokeCallback(context);
+  return true;
+}
+
+void DnsFilterResolver::cacheAnswer(const DnsQueryRecord& query,
+                                    const std::list<Network::DnsResponse>& response) {
+  if (answers_ == nullptr) {
+    return;
+  }
+  std::chrono::milliseconds ttl = negative_ttl_;
+  if (!response.empty()) {
+    ttl = std::chrono::milliseconds::max();
+    for (const auto& resp : response) {
+      ttl = std::min<std::chrono::milliseconds>(ttl, resp.addrInfo().ttl_);
+    }
+  }
+  if (ttl.count() <= 0) {
+    return;
+  }
+
+  auto* answer = new CachedAnswer{{}, dispatcher_.timeSource().monotonicTime() + ttl};
+  answer->addresses_.reserve(response.size());
+  for (const auto& resp : response) {
+    answer->addresses_.emplace_back(resp.addrInfo().address_);
+  }
+  const std::string key = answerCacheKey(query);
+  answers_->remove(key);
+  answers_->insert(key, answer, 1);
+}
+
 void DnsFilterResolver::onResolveTimeout() {
   const uint64_t now = DateUtil::nowToSeconds(dispatcher_.timeSource());
   ENVOY_LOG(trace, "Pending queries: {}", lookups_.size());
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/dns.h"
+#include "envoy/stats/stats.h"
 
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace UdpFilters {
@@ -13,6 +24,15 @@ namespace DnsFilter {
 
 enum class DnsFilterResolverStatus { Pending, Complete, TimedOut };
 
+/**
+ * The configuration of the cache of the answers of the external resolvers.
+ */
+struct DnsAnswerCacheConfig {
+  uint32_t max_entries_;
+  // How long an answer without addresses is cached. Zero disables the caching of such answers.
+  std::chrono::milliseconds negative_ttl_;
+};
+
 /*
  * This class encapsulates the logic of handling an asynchronous DNS request for the DNS filter.
  * External request timeouts are handled here.
@@ -22,11 +42,19 @@ public:
   DnsFilterResolver(DnsFilterResolverCallback& callback, std::chrono::milliseconds timeout,
                     Event::Dispatcher& dispatcher, uint64_t max_pending_lookups,
                     const envoy::config::core::v3::TypedExtensionConfig& typed_dns_resolver_config,
-                    const Network::DnsResolverFactory& dns_resolver_factory, Api::Api& api)
+                    const Network::DnsResolverFactory& dns_resolver_factory, Api::Api& api,
+                    const absl::optional<DnsAnswerCacheConfig>& answer_cache_config,
+                    Stats::Counter& answer_cache_hits)
       : timeout_(timeout), dispatcher_(dispatcher),
         resolver_(
             dns_resolver_factory.createDnsResolver(dispatcher, api, typed_dns_resolver_config)),
-        callback_(callback), max_pending_lookups_(max_pending_lookups) {}
+        callback_(callback), max_pending_lookups_(max_pending_lookups),
+        answer_cache_hits_(answer_cache_hits) {
+    if (answer_cache_config.has_value()) {
+      negative_ttl_ = answer_cache_config->negative_ttl_;
+      answers_ = std::make_unique<AnswerCache>(answer_cache_config->max_entries_);
+    }
+  }
   /**
    * @brief entry point to resolve the name in a DnsQueryRecord
    *
@@ -35,6 +63,9 @@ public:
    * callback in order to build the answer object returned to the client.
    *
    * @param domain_query the query record object containing the name for which we are resolving
+   *
+   * When the answer cache is configured, a query for a name resolved before is answered from the
+   * cache until the TTL of the answer expires.
    */
   void resolveExternalQuery(DnsQueryContextPtr context, const DnsQueryRecord* domain_query);
 
@@ -58,6 +89,29 @@ private:
     }
   }
 
+  /**
+   * An answer of the external resolvers, and when it stops being used.
+   */
+  struct CachedAnswer {
+    AddressConstPtrVec addresses_;
+    MonotonicTime expiry_;
+  };
+  using AnswerCache = ::google::simple_lru_cache::SimpleLRUCache<std::string, CachedAnswer>;
+
+  static std::string answerCacheKey(const DnsQueryRecord& query) {
+    return absl::StrCat(query.type_, "/", query.name_);
+  }
+
+  /**
+   * @return whether the query was answered from the answer cache.
+   */
+  bool lookupCachedAnswer(LookupContext& context);
+
+  /**
+   * Caches the answer of a successful lookup, according to the lowest TTL of its addresses.
+   */
+  void cacheAnswer(const DnsQueryRecord& query, const std::list<Network::DnsResponse>& response);
+
   /**
    * @brief Invoke the DNS Filter callback to send a response to a client if the query has timed out
    * DNS Filter will respond to the client appropriately.
@@ -70,6 +124,10 @@ private:
   DnsFilterResolverCallback& callback_;
   absl::flat_hash_map<const DnsQueryRecord*, LookupContext> lookups_;
   uint64_t max_pending_lookups_;
+  Stats::Counter& answer_cache_hits_;
+  std::chrono::milliseconds negative_ttl_{};
+  // Only set when the answer cache is configured. The resolver is used by a single worker.
+  std::unique_ptr<AnswerCache> answers_;
 };
 
 using DnsFilterResolverPtr = std::unique_ptr<DnsFilterResolver>;
@@ -86,6 +86,7 @@ private:
     }
 
     uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+    uint32_t maxConnectionsPerHost() const override { return 1; }
     bool enableCommandStats() const override { return false; }
 
     // Extensions::NetworkFilters::Common::Redis::Client::ClientCallbacks
@@ -0,0 +1,78 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+/**
+ * A singleton tracking the caches, so that filters with equivalent configs share a cache, and
+ * filters with different configs get different caches.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<InMemoryHttpCache> get(std::shared_ptr<CacheSingleton> singleton,
+                                         const ConfigProto& config, Stats::Scope& stats_scope) {
+    std::shared_ptr<InMemoryHttpCache> cache;
+    const uint64_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    auto it = caches_.find(key);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache || !Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
+      cache = std::make_shared<InMemoryHttpCache>(singleton, config, stats_scope);
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // The caches each keep shared_ptrs to this singleton, which is destroyed along with the last
+  // cache, so only weak_ptrs to the caches are kept here.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<InMemoryHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(in_memory_http_cache_singleton);
+
+class InMemoryHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{InMemoryHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    ConfigProto config;
+    MessageUtil::anyConvertAndValidate(filter_config.typed_config(), config,
+                                       context.messageValidationVisitor());
+    std::shared_ptr<CacheSingleton> caches = context.singletonManager().getTyped<CacheSingleton>(
+        SINGLETON_MANAGER_REGISTERED_NAME(in_memory_http_cache_singleton),
+        [] { return std::make_shared<CacheSingleton>(); });
+    return caches->get(caches, config, context.scope());
+  }
+};
+
+static Registry::RegisterFactory<InMemoryHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
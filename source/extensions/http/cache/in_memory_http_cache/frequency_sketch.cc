@@ -0,0 +1,71 @@
+#include "source/extensions/http/cache/in_memory_http_cache/frequency_sketch.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+
+namespace {
+
+constexpr uint64_t MinWidth = 64;
+constexpr uint64_t MaxWidth = uint64_t(1) << 24;
+
+// Round up to a power of two, so that indices are masks of the hash.
+uint64_t widthFor(uint64_t expected_keys) {
+  uint64_t width = MinWidth;
+  while (width < std::min(expected_keys, MaxWidth)) {
+    width <<= 1;
+  }
+  return width;
+}
+
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t expected_keys)
+    : width_mask_(widthFor(expected_keys) - 1), sample_size_(10 * widthFor(expected_keys)),
+      counters_(ROWS * widthFor(expected_keys)) {}
+
+uint64_t FrequencySketch::index(uint64_t hash, uint32_t row) const {
+  // Double hashing: the rows use independent enough indices derived from both halves of the
+  // hash, the second of which is odd so that the indices differ in every row.
+  const uint64_t step = (hash >> 32) | 1;
+  return row * (width_mask_ + 1) + ((hash + row * step) & width_mask_);
+}
+
+void FrequencySketch::record(uint64_t hash) {
+  bool incremented = false;
+  for (uint32_t row = 0; row < ROWS; ++row) {
+    uint8_t& counter = counters_[index(hash, row)];
+    if (counter < MAX_FREQUENCY) {
+      ++counter;
+      incremented = true;
+    }
+  }
+  if (incremented && ++samples_ >= sample_size_) {
+    age();
+  }
+}
+
+uint32_t FrequencySketch::frequency(uint64_t hash) const {
+  uint32_t frequency = MAX_FREQUENCY;
+  for (uint32_t row = 0; row < ROWS; ++row) {
+    frequency = std::min<uint32_t>(frequency, counters_[index(hash, row)]);
+  }
+  return frequency;
+}
+
+void FrequencySketch::age() {
+  for (uint8_t& counter : counters_) {
+    counter >>= 1;
+  }
+  samples_ /= 2;
+}
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+
+/**
+ * Estimates how often keys were seen recently, as the TinyLFU admission policy needs. This is a
+ * count-min sketch with 4-bit counters: the estimate of a key is the smallest of its counters in
+ * each row. Once as many keys as ten times the width have been recorded, all the counters are
+ * halved, so that old popularity fades away.
+ *
+ * Not thread-safe.
+ */
+class FrequencySketch {
+public:
+  /**
+   * @param expected_keys supplies the expected number of distinct keys, which sets the width.
+   */
+  explicit FrequencySketch(uint64_t expected_keys);
+
+  /**
+   * Record an occurrence of a key.
+   * @param hash supplies the hash of the key.
+   */
+  void record(uint64_t hash);
+
+  /**
+   * @param hash supplies the hash of the key.
+   * @return the estimated number of recent occurrences of the key, at most MAX_FREQUENCY.
+   */
+  uint32_t frequency(uint64_t hash) const;
+
+  static constexpr uint32_t MAX_FREQUENCY = 15;
+
+private:
+  static constexpr uint32_t ROWS = 4;
+
+  // The index of the counter of the key in the row.
+  uint64_t index(uint64_t hash, uint32_t row) const;
+  void age();
+
+  const uint64_t width_mask_;
+  const uint64_t sample_size_;
+  uint64_t samples_{};
+  // The rows, one after the other. A byte per counter keeps the code simple, and the sketch is
+  // small next to the cached entries anyway.
+  std::vector<uint8_t> counters_;
+};
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,512 @@
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+#include <algorithm>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/extensions/filters/http/cache/cache_entry_utils.h"
+#include "source/extensions/filters/http/cache/cache_headers_utils.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+// An estimate of the memory taken by an entry besides its key, headers, body and trailers: the
+// list node, the index slot and the header map structures.
+constexpr uint64_t EntryOverhead = 256;
+// Sizes the frequency sketches for entries of this size on average.
+constexpr uint64_t ExpectedEntrySize = 4096;
+constexpr uint32_t DefaultShardCount = 16;
+
+// The key is stored in the list node and in the index.
+uint64_t entrySize(const Key& key, const CacheEntry& entry) {
+  return EntryOverhead + 2 * key.ByteSizeLong() + entry.response_headers_->byteSize() +
+         (entry.body_ ? entry.body_->size() : 0) +
+         (entry.trailers_ ? entry.trailers_->byteSize() : 0);
+}
+
+// Returns a Key with the vary header added to custom_fields.
+// It is an error to call this with headers that don't include vary.
+// Returns nullopt if the vary headers in the response are not
+// compatible with the VaryAllowList in the LookupRequest.
+absl::optional<Key> variedRequestKey(const LookupRequest& request,
+                                     const Http::ResponseHeaderMap& response_headers) {
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(response_headers);
+  ASSERT(!vary_header_values.empty());
+  const absl::optional<std::string> vary_identifier = VaryHeaderUtils::createVaryIdentifier(
+      request.varyAllowList(), vary_header_values, request.requestHeaders());
+  if (!vary_identifier.has_value()) {
+    return absl::nullopt;
+  }
+  Key varied_request_key = request.key();
+  varied_request_key.add_custom_fields(vary_identifier.value());
+  return varied_request_key;
+}
+
+CacheEntry copyEntry(const CacheEntry& entry) {
+  return CacheEntry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_),
+      entry.metadata_, entry.body_,
+      entry.trailers_ ? Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_)
+                      : nullptr};
+}
+
+CacheStats generateStats(Stats::Scope& scope) {
+  const std::string prefix = "in_memory_http_cache.";
+  return {ALL_IN_MEMORY_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                    POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+std::vector<std::unique_ptr<CacheShard>> makeShards(const ConfigProto& config,
+                                                    CacheStats& stats) {
+  const uint32_t shard_count =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, shard_count, DefaultShardCount);
+  const uint64_t shard_size = std::max<uint64_t>(config.max_cache_size_bytes() / shard_count, 1);
+  std::vector<std::unique_ptr<CacheShard>> shards;
+  shards.reserve(shard_count);
+  for (uint32_t i = 0; i < shard_count; ++i) {
+    shards.push_back(std::make_unique<CacheShard>(shard_size, stats));
+  }
+  return shards;
+}
+
+// Lets the lookups reference the cached body instead of copying it.
+class SharedBodyFragment : public Buffer::BufferFragment {
+public:
+  SharedBodyFragment(std::shared_ptr<const std::string> body, const AdjustedByteRange& range)
+      : body_(std::move(body)), data_(body_->data() + range.begin()), size_(range.length()) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_; }
+  size_t size() const override { return size_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const char* const data_;
+  const size_t size_;
+};
+
+class InMemoryLookupContext : public LookupContext {
+public:
+  InMemoryLookupContext(InMemoryHttpCache& cache, LookupRequest&& request)
+      : cache_(cache), request_(std::move(request)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    CacheEntry entry = cache_.lookup(request_);
+    body_ = std::move(entry.body_);
+    trailers_ = std::move(entry.trailers_);
+    cb(entry.response_headers_
+           ? request_.makeLookupResult(std::move(entry.response_headers_),
+                                       std::move(entry.metadata_), body_ ? body_->size() : 0,
+                                       trailers_ != nullptr)
+           : LookupResult{});
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    ASSERT(body_ && range.end() <= body_->size(), "Attempt to read past end of body.");
+    cb(InMemoryHttpCache::bodyBuffer(body_, range));
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    ASSERT(trailers_);
+    cb(std::move(trailers_));
+  }
+
+  const LookupRequest& request() const { return request_; }
+  void onDestroy() override {}
+
+private:
+  InMemoryHttpCache& cache_;
+  const LookupRequest request_;
+  std::shared_ptr<const std::string> body_;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+class InMemoryInsertContext : public InsertContext {
+public:
+  InMemoryInsertContext(LookupContextPtr&& lookup_context, InMemoryHttpCache& cache)
+      : lookup_context_(std::move(lookup_context)), cache_(cache) {}
+
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_success,
+                     bool end_stream) override {
+    ASSERT(!committed_);
+    response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+    metadata_ = metadata;
+    if (end_stream) {
+      insert_success(commit());
+    } else {
+      insert_success(true);
+    }
+  }
+
+  void insertBody(const Buffer::Instance& chunk, InsertCallback ready_for_next_chunk,
+                  bool end_stream) override {
+    ASSERT(!committed_);
+    ASSERT(ready_for_next_chunk || end_stream);
+
+    body_.add(chunk);
+    // Stop buffering a response as soon as it's too large to be cached.
+    if (!cache_.checkEntrySize(body_.length())) {
+      committed_ = true;
+      ready_for_next_chunk(false);
+    } else if (end_stream) {
+      ready_for_next_chunk(commit());
+    } else {
+      ready_for_next_chunk(true);
+    }
+  }
+
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override {
+    ASSERT(!committed_);
+    trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(trailers);
+    insert_complete(commit());
+  }
+
+  void onDestroy() override { lookup_context_->onDestroy(); }
+
+private:
+  bool commit() {
+    committed_ = true;
+    return cache_.insert(
+        static_cast<const InMemoryLookupContext&>(*lookup_context_).request(),
+        CacheEntry{std::move(response_headers_), std::move(metadata_),
+                   std::make_shared<const std::string>(body_.toString()), std::move(trailers_)});
+  }
+
+  const LookupContextPtr lookup_context_;
+  InMemoryHttpCache& cache_;
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  Buffer::OwnedImpl body_;
+  Http::ResponseTrailerMapPtr trailers_;
+  bool committed_ = false;
+};
+
+} // namespace
+
+CacheShard::CacheShard(uint64_t max_size_bytes, CacheStats& stats)
+    : window_capacity_(std::max<uint64_t>(max_size_bytes / 100, 1)),
+      main_capacity_(max_size_bytes - std::min(window_capacity_, max_size_bytes)),
+      protected_capacity_(main_capacity_ / 5 * 4), stats_(stats),
+      sketch_(max_size_bytes / ExpectedEntrySize) {}
+
+void CacheShard::erase(const Key& key) {
+  absl::MutexLock lock(&mutex_);
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    remove(iter->second);
+  }
+}
+
+uint32_t CacheShard::frequency(uint64_t hash) {
+  absl::MutexLock lock(&mutex_);
+  return sketch_.frequency(hash);
+}
+
+CacheEntry CacheShard::lookup(const Key& key, uint64_t hash) {
+  absl::MutexLock lock(&mutex_);
+  // Misses count too: a response requested often enough is admitted once it's inserted.
+  sketch_.record(hash);
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return CacheEntry{};
+  }
+  onHit(iter->second);
+  return copyEntry(iter->second->entry_);
+}
+
+void CacheShard::insert(const Key& key, uint64_t hash, CacheEntry&& entry, uint64_t size) {
+  ASSERT(size <= maxEntrySize());
+  absl::MutexLock lock(&mutex_);
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    remove(iter->second);
+  }
+  window_.push_front(Node{key, hash, std::move(entry), size, Region::Window});
+  index_.emplace(key, window_.begin());
+  window_size_ += size;
+  stats_.size_bytes_.add(size);
+  stats_.size_count_.inc();
+  drainWindow();
+}
+
+bool CacheShard::updateHeaders(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                               const ResponseMetadata& metadata) {
+  absl::MutexLock lock(&mutex_);
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return false;
+  }
+  Node& node = *iter->second;
+  const uint64_t headers_size = node.entry_.response_headers_->byteSize();
+  applyHeaderUpdate(response_headers, *node.entry_.response_headers_);
+  node.entry_.metadata_ = metadata;
+  resize(node, node.size_ - headers_size + node.entry_.response_headers_->byteSize());
+  // The entry is still cached if the update made it too large.
+  demoteProtected();
+  drainWindow();
+  trimMain();
+  return true;
+}
+
+void CacheShard::onHit(NodeList::iterator node) {
+  switch (node->region_) {
+  case Region::Window:
+    window_.splice(window_.begin(), window_, node);
+    break;
+  case Region::Probation:
+    node->region_ = Region::Protected;
+    protected_size_ += node->size_;
+    protected_.splice(protected_.begin(), probation_, node);
+    demoteProtected();
+    break;
+  case Region::Protected:
+    protected_.splice(protected_.begin(), protected_, node);
+    break;
+  }
+}
+
+void CacheShard::drainWindow() {
+  while (window_size_ > window_capacity_) {
+    admitFromWindow();
+  }
+}
+
+void CacheShard::admitFromWindow() {
+  const NodeList::iterator candidate = std::prev(window_.end());
+  // Look for the least recently used main entries making room for the candidate, which replaces
+  // them only if it's more popular than each of them.
+  absl::InlinedVector<NodeList::iterator, 4> victims;
+  uint64_t main_size = main_size_;
+  if (main_size + candidate->size_ > main_capacity_) {
+    const uint32_t candidate_frequency = sketch_.frequency(candidate->hash_);
+    for (NodeList* lru : {&probation_, &protected_}) {
+      for (auto iter = lru->end();
+           iter != lru->begin() && main_size + candidate->size_ > main_capacity_;) {
+        --iter;
+        if (sketch_.frequency(iter->hash_) >= candidate_frequency) {
+          stats_.admission_rejections_.inc();
+          remove(candidate);
+          return;
+        }
+        victims.push_back(iter);
+        main_size -= iter->size_;
+      }
+    }
+    if (main_size + candidate->size_ > main_capacity_) {
+      // The candidate grew larger than the main area with header updates.
+      stats_.evictions_.inc();
+      remove(candidate);
+      return;
+    }
+  }
+
+  for (const NodeList::iterator& victim : victims) {
+    stats_.evictions_.inc();
+    remove(victim);
+  }
+  window_size_ -= candidate->size_;
+  main_size_ += candidate->size_;
+  candidate->region_ = Region::Probation;
+  probation_.splice(probation_.begin(), window_, candidate);
+}
+
+void CacheShard::demoteProtected() {
+  while (protected_size_ > protected_capacity_) {
+    const NodeList::iterator node = std::prev(protected_.end());
+    node->region_ = Region::Probation;
+    protected_size_ -= node->size_;
+    probation_.splice(probation_.begin(), protected_, node);
+  }
+}
+
+void CacheShard::trimMain() {
+  while (main_size_ > main_capacity_) {
+    stats_.evictions_.inc();
+    remove(std::prev(probation_.empty() ? protected_.end() : probation_.end()));
+  }
+}
+
+void CacheShard::resize(Node& node, uint64_t size) {
+  switch (node.region_) {
+  case Region::Window:
+    window_size_ = window_size_ - node.size_ + size;
+    break;
+  case Region::Protected:
+    protected_size_ = protected_size_ - node.size_ + size;
+    FALLTHRU;
+  case Region::Probation:
+    main_size_ = main_size_ - node.size_ + size;
+    break;
+  }
+  stats_.size_bytes_.sub(node.size_);
+  stats_.size_bytes_.add(size);
+  node.size_ = size;
+}
+
+void CacheShard::remove(NodeList::iterator node) {
+  resize(*node, 0);
+  stats_.size_count_.dec();
+  // The index references the node, so erase it first.
+  index_.erase(node->key_);
+  list(node->region_).erase(node);
+}
+
+CacheShard::NodeList& CacheShard::list(Region region) {
+  switch (region) {
+  case Region::Window:
+    return window_;
+  case Region::Probation:
+    return probation_;
+  case Region::Protected:
+    return protected_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+InMemoryHttpCache::InMemoryHttpCache(Singleton::InstanceSharedPtr owner,
+                                     const ConfigProto& config, Stats::Scope& scope)
+    : owner_(std::move(owner)), config_(config), stats_(generateStats(scope)),
+      shards_(makeShards(config, stats_)),
+      max_entry_size_(std::min<uint64_t>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entry_size_bytes, UINT64_MAX),
+          shards_.front()->maxEntrySize())) {}
+
+LookupContextPtr InMemoryHttpCache::makeLookupContext(LookupRequest&& request,
+                                                      Http::StreamDecoderFilterCallbacks&) {
+  return std::make_unique<InMemoryLookupContext>(*this, std::move(request));
+}
+
+InsertContextPtr InMemoryHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                      Http::StreamEncoderFilterCallbacks&) {
+  ASSERT(lookup_context != nullptr);
+  return std::make_unique<InMemoryInsertContext>(std::move(lookup_context), *this);
+}
+
+void InMemoryHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                      const Http::ResponseHeaderMap& response_headers,
+                                      const ResponseMetadata& metadata,
+                                      std::function<void(bool)> on_complete) {
+  const LookupRequest& request =
+      static_cast<const InMemoryLookupContext&>(lookup_context).request();
+  const Key& key = request.key();
+  const uint64_t hash = MessageUtil::hash(key);
+  CacheShard& key_shard = shard(hash);
+  // A varied response is updated through the entry flagging that the responses vary.
+  const CacheEntry entry = key_shard.lookup(key, hash);
+  if (!entry.response_headers_) {
+    on_complete(false);
+    return;
+  }
+  if (!VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    on_complete(key_shard.updateHeaders(key, response_headers, metadata));
+    return;
+  }
+  const absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+  on_complete(varied_key.has_value() &&
+              updateHeaders(varied_key.value(), response_headers, metadata));
+}
+
+bool InMemoryHttpCache::updateHeaders(const Key& key,
+                                      const Http::ResponseHeaderMap& response_headers,
+                                      const ResponseMetadata& metadata) {
+  return shard(MessageUtil::hash(key)).updateHeaders(key, response_headers, metadata);
+}
+
+void InMemoryHttpCache::erase(const Key& key) { shard(MessageUtil::hash(key)).erase(key); }
+
+uint32_t InMemoryHttpCache::frequency(const Key& key) {
+  const uint64_t hash = MessageUtil::hash(key);
+  return shard(hash).frequency(hash);
+}
+
+Buffer::InstancePtr InMemoryHttpCache::bodyBuffer(std::shared_ptr<const std::string> body,
+                                                  const AdjustedByteRange& range) {
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
+  if (range.length() > 0) {
+    buffer->addBufferFragment(*new SharedBodyFragment(std::move(body), range));
+  }
+  return buffer;
+}
+
+CacheEntry InMemoryHttpCache::lookup(const LookupRequest& request) {
+  const uint64_t hash = MessageUtil::hash(request.key());
+  CacheEntry entry = shard(hash).lookup(request.key(), hash);
+  if (!entry.response_headers_ || !VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    return entry;
+  }
+  const absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+  if (!varied_key.has_value()) {
+    return CacheEntry{};
+  }
+  const uint64_t varied_hash = MessageUtil::hash(varied_key.value());
+  return shard(varied_hash).lookup(varied_key.value(), varied_hash);
+}
+
+bool InMemoryHttpCache::insert(const LookupRequest& request, CacheEntry&& entry) {
+  if (!VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    return insert(request.key(), std::move(entry));
+  }
+  const absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+  if (!varied_key.has_value()) {
+    // Skip the insert if we are unable to create a vary key.
+    return false;
+  }
+  // Add an entry without a body to flag that this request generates varied responses.
+  Http::ResponseHeaderMapPtr vary_only_map = Http::createHeaderMap<Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Http::CustomHeaders::get().Vary,
+                         absl::StrJoin(VaryHeaderUtils::getVaryValues(*entry.response_headers_),
+                                       ","));
+  if (!insert(varied_key.value(), std::move(entry))) {
+    return false;
+  }
+  return insert(request.key(), CacheEntry{std::move(vary_only_map), {}, nullptr, nullptr});
+}
+
+bool InMemoryHttpCache::checkEntrySize(uint64_t size) {
+  if (size > max_entry_size_) {
+    stats_.entries_too_large_.inc();
+    return false;
+  }
+  return true;
+}
+
+CacheInfo InMemoryHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  return cache_info;
+}
+
+CacheShard& InMemoryHttpCache::shard(uint64_t hash) {
+  // The sketches index their counters with the low bits of the hash, so mix all of its bits to
+  // pick the shard.
+  return *shards_[((hash * 0x9e3779b97f4a7c15) >> 32) % shards_.size()];
+}
+
+bool InMemoryHttpCache::insert(const Key& key, CacheEntry&& entry) {
+  const uint64_t size = entrySize(key, entry);
+  if (!checkEntrySize(size)) {
+    return false;
+  }
+  const uint64_t hash = MessageUtil::hash(key);
+  shard(hash).insert(key, hash, std::move(entry), size);
+  return true;
+}
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/frequency_sketch.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+
+using ConfigProto =
+    envoy::extensions::http::cache::in_memory_http_cache::v3::InMemoryHttpCacheConfig;
+
+/**
+ * All in-memory cache stats. @see stats_macros.h
+ *
+ * size_bytes is the estimated size of the entries, as bounded by max_cache_size_bytes.
+ **/
+#define ALL_IN_MEMORY_CACHE_STATS(COUNTER, GAUGE)                                                  \
+  COUNTER(evictions)                                                                               \
+  COUNTER(admission_rejections)                                                                    \
+  COUNTER(entries_too_large)                                                                       \
+  GAUGE(size_bytes, NeverImport)                                                                   \
+  GAUGE(size_count, NeverImport)
+
+struct CacheStats {
+  ALL_IN_MEMORY_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// A cached response. The headers and trailers are copied for each lookup, as the filter modifies
+// them, but the body is immutable and shared with the lookups.
+struct CacheEntry {
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  std::shared_ptr<const std::string> body_;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+/**
+ * A part of the cache with its own lock and its own part of the size limit. Entries are admitted
+ * and evicted with W-TinyLFU: new entries go to the front of an LRU window taking 1% of the size.
+ * Entries falling off the window go to the probation LRU list of the main area, and entries hit
+ * while on probation are promoted to the protected LRU list, which takes up to 80% of the main
+ * area. When the main area is full, an entry falling off the window is only admitted if it was
+ * requested more often recently, according to a frequency sketch, than the entries it replaces.
+ */
+class CacheShard {
+public:
+  CacheShard(uint64_t max_size_bytes, CacheStats& stats);
+
+  /**
+   * Look up an entry, counting the request for the admission policy.
+   * @param key supplies the key of the entry.
+   * @param hash supplies the hash of the key.
+   * @return a copy of the entry, with null headers if there is none.
+   */
+  CacheEntry lookup(const Key& key, uint64_t hash);
+
+  /**
+   * Insert or replace an entry.
+   * @param key supplies the key of the entry.
+   * @param hash supplies the hash of the key.
+   * @param entry supplies the entry.
+   * @param size supplies the estimated size of the entry, at most maxEntrySize().
+   */
+  void insert(const Key& key, uint64_t hash, CacheEntry&& entry, uint64_t size);
+
+  /**
+   * Update the headers and metadata of an entry after validation.
+   * @return false if there is no entry for the key.
+   */
+  bool updateHeaders(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata);
+
+  /**
+   * Remove an entry, if any.
+   * @param key supplies the key of the entry.
+   */
+  void erase(const Key& key);
+
+  /**
+   * @param hash supplies the hash of a key.
+   * @return the estimated number of recent lookups of the key.
+   */
+  uint32_t frequency(uint64_t hash);
+
+  // Larger entries could never be admitted to the main area.
+  uint64_t maxEntrySize() const { return main_capacity_; }
+
+private:
+  enum class Region { Window, Probation, Protected };
+
+  struct Node {
+    Key key_;
+    uint64_t hash_;
+    CacheEntry entry_;
+    uint64_t size_;
+    Region region_;
+  };
+  using NodeList = std::list<Node>;
+
+  void onHit(NodeList::iterator node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Move or drop the least recently used entries of the window until it fits its capacity.
+  void drainWindow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Admit the entry falling off the window if the main area can fit it, evicting less popular
+  // entries as needed.
+  void admitFromWindow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Demote the least recently used protected entries until the protected list fits its capacity.
+  void demoteProtected() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Evict the least recently used main entries until the main area fits its capacity.
+  void trimMain() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void resize(Node& node, uint64_t size) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void remove(NodeList::iterator node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  NodeList& list(Region region) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t window_capacity_;
+  const uint64_t main_capacity_;
+  const uint64_t protected_capacity_;
+  CacheStats& stats_;
+
+  absl::Mutex mutex_;
+  FrequencySketch sketch_ ABSL_GUARDED_BY(mutex_);
+  // The most recently used entries are at the front of the lists.
+  NodeList window_ ABSL_GUARDED_BY(mutex_);
+  NodeList probation_ ABSL_GUARDED_BY(mutex_);
+  NodeList protected_ ABSL_GUARDED_BY(mutex_);
+  uint64_t window_size_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t main_size_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t protected_size_ ABSL_GUARDED_BY(mutex_){};
+  absl::flat_hash_map<Key, NodeList::iterator, MessageUtil, MessageUtil>
+      index_ ABSL_GUARDED_BY(mutex_);
+};
+
+/**
+ * A bounded in-memory cache, sharded by the hash of the cache keys so that workers rarely contend
+ * for the same lock.
+ *
+ * Caches are owned by filter configurations, and jointly own the singleton tracking the caches of
+ * each configuration.
+ */
+class InMemoryHttpCache : public HttpCache {
+public:
+  InMemoryHttpCache(Singleton::InstanceSharedPtr owner, const ConfigProto& config,
+                    Stats::Scope& scope);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  /**
+   * @return a copy of the entry matching the request, following the vary header if the response
+   *         varies, with null headers if there is none.
+   */
+  CacheEntry lookup(const LookupRequest& request);
+
+  /**
+   * Insert a response for the request.
+   * @return false if the response can't be cached.
+   */
+  bool insert(const LookupRequest& request, CacheEntry&& entry);
+
+  /**
+   * Insert a response that doesn't vary.
+   * @return false if the response can't be cached.
+   */
+  bool insert(const Key& key, CacheEntry&& entry);
+
+  /**
+   * Update the headers and metadata of a response that doesn't vary.
+   * @return false if there is no response for the key.
+   */
+  bool updateHeaders(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata);
+
+  /**
+   * Remove the response for a key that doesn't vary, if any.
+   */
+  void erase(const Key& key);
+
+  /**
+   * @return the estimated number of recent lookups of the key, up to
+   *         FrequencySketch::MAX_FREQUENCY.
+   */
+  uint32_t frequency(const Key& key);
+
+  /**
+   * @return a buffer referencing a range of a cached body, without copying it.
+   */
+  static Buffer::InstancePtr bodyBuffer(std::shared_ptr<const std::string> body,
+                                        const AdjustedByteRange& range);
+
+  /**
+   * Check that an entry isn't too large to be cached, counting it otherwise.
+   * @param size supplies the estimated size of the entry, or the size of its body so far.
+   * @return false if the entry can't be cached.
+   */
+  bool checkEntrySize(uint64_t size);
+
+  // Larger entries are not cached.
+  uint64_t maxEntrySize() const { return max_entry_size_; }
+
+  const ConfigProto& config() const { return config_; }
+  const CacheStats& stats() const { return stats_; }
+
+  static absl::string_view name() { return "envoy.extensions.http.cache.in_memory"; }
+
+private:
+  CacheShard& shard(uint64_t hash);
+
+  const Singleton::InstanceSharedPtr owner_;
+  const ConfigProto config_;
+  CacheStats stats_;
+  std::vector<std::unique_ptr<CacheShard>> shards_;
+  const uint64_t max_entry_size_;
+};
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,102 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+std::shared_ptr<HttpCache>
+makeBackingTier(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+                const ConfigProto& config, Server::Configuration::FactoryContext& context) {
+  const std::string type{TypeUtil::typeUrlToDescriptorFullName(config.backing_tier().type_url())};
+  HttpCacheFactory* const factory =
+      Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(type);
+  if (factory == nullptr) {
+    throw EnvoyException(
+        fmt::format("Didn't find a registered implementation for type: '{}'", type));
+  }
+  // The backing tier sees the filter config it would have been configured with directly.
+  envoy::extensions::filters::http::cache::v3::CacheConfig backing_config = filter_config;
+  *backing_config.mutable_typed_config() = config.backing_tier();
+  return factory->getCache(backing_config, context);
+}
+
+/**
+ * A singleton tracking the caches, so that filters with equivalent configs share a cache, and
+ * filters with different configs get different caches.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<TieredHttpCache>
+  get(std::shared_ptr<CacheSingleton> singleton,
+      const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+      const ConfigProto& config, Server::Configuration::FactoryContext& context) {
+    std::shared_ptr<TieredHttpCache> cache;
+    const uint64_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    auto it = caches_.find(key);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache || !Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
+      cache = std::make_shared<TieredHttpCache>(
+          singleton, config,
+          std::make_shared<InMemoryHttpCache::InMemoryHttpCache>(nullptr, config.memory_tier(),
+                                                                 context.scope()),
+          makeBackingTier(filter_config, config, context), context.timeSource(),
+          context.scope());
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // The caches each keep shared_ptrs to this singleton, which is destroyed along with the last
+  // cache, so only weak_ptrs to the caches are kept here.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<TieredHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(tiered_http_cache_singleton);
+
+class TieredHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{TieredHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    ConfigProto config;
+    MessageUtil::anyConvertAndValidate(filter_config.typed_config(), config,
+                                       context.messageValidationVisitor());
+    std::shared_ptr<CacheSingleton> caches = context.singletonManager().getTyped<CacheSingleton>(
+        SINGLETON_MANAGER_REGISTERED_NAME(tiered_http_cache_singleton),
+        [] { return std::make_shared<CacheSingleton>(); });
+    return caches->get(caches, filter_config, config, context);
+  }
+};
+
+static Registry::RegisterFactory<TieredHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
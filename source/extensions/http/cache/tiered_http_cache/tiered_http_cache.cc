@@ -0,0 +1,218 @@
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/cache_headers_utils.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+constexpr uint32_t DefaultMinRequestsToPromote = 2;
+
+CacheStats generateStats(Stats::Scope& scope) {
+  return {ALL_TIERED_CACHE_STATS(POOL_COUNTER_PREFIX(scope, "tiered_http_cache."))};
+}
+
+// A response being read from the backing tier to be copied to the memory tier.
+struct Promotion {
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  uint64_t content_length_;
+  bool has_trailers_;
+  std::string body_;
+};
+
+/**
+ * Serves fresh responses from the memory tier and everything else from the backing tier. The
+ * backing tier may invoke the callbacks on another thread, but never after onDestroy(), so they
+ * can safely reference this context.
+ */
+class TieredLookupContext : public LookupContext {
+public:
+  TieredLookupContext(TieredHttpCache& cache, Key key, LookupResult&& memory_result,
+                      InMemoryHttpCache::CacheEntry&& memory_entry,
+                      LookupContextPtr&& backing_lookup)
+      : cache_(cache), key_(std::move(key)), memory_result_(std::move(memory_result)),
+        memory_entry_(std::move(memory_entry)), backing_lookup_(std::move(backing_lookup)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    if (memory_result_.cache_entry_status_ == CacheEntryStatus::Ok) {
+      from_memory_tier_ = true;
+      cache_.stats().memory_tier_hits_.inc();
+      cb(std::move(memory_result_));
+      return;
+    }
+    backing_lookup_->getHeaders([this, cb = std::move(cb)](LookupResult&& result) {
+      startPromotion(result);
+      cb(std::move(result));
+    });
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    if (from_memory_tier_) {
+      ASSERT(memory_entry_.body_ && range.end() <= memory_entry_.body_->size(),
+             "Attempt to read past end of body.");
+      cb(InMemoryHttpCache::InMemoryHttpCache::bodyBuffer(memory_entry_.body_, range));
+      return;
+    }
+    // Only promote responses read from start to end, in order.
+    if (promotion_ && range.begin() != promotion_->body_.size()) {
+      promotion_.reset();
+    }
+    backing_lookup_->getBody(range, [this, cb = std::move(cb)](Buffer::InstancePtr&& body) {
+      if (promotion_) {
+        if (body) {
+          promotion_->body_.append(body->toString());
+          maybeFinishPromotion();
+        } else {
+          promotion_.reset();
+        }
+      }
+      cb(std::move(body));
+    });
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    if (from_memory_tier_) {
+      ASSERT(memory_entry_.trailers_);
+      cb(std::move(memory_entry_.trailers_));
+      return;
+    }
+    backing_lookup_->getTrailers(
+        [this, cb = std::move(cb)](Http::ResponseTrailerMapPtr&& trailers) {
+          if (promotion_ && trailers && promotion_->body_.size() == promotion_->content_length_) {
+            finishPromotion(Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*trailers));
+          }
+          promotion_.reset();
+          cb(std::move(trailers));
+        });
+  }
+
+  void onDestroy() override {
+    if (backing_lookup_) {
+      backing_lookup_->onDestroy();
+    }
+  }
+
+  const Key& key() const { return key_; }
+  const LookupContext& backingLookup() const { return *backing_lookup_; }
+  // The backing lookup is handed over to the insert context of the backing tier.
+  LookupContextPtr releaseBackingLookup() { return std::move(backing_lookup_); }
+
+private:
+  void startPromotion(const LookupResult& result) {
+    InMemoryHttpCache::InMemoryHttpCache& memory_tier = cache_.memoryTier();
+    // Responses that vary are stored under other keys, and range lookups don't read the whole
+    // body.
+    if (result.cache_entry_status_ != CacheEntryStatus::Ok || result.range_details_.has_value() ||
+        VaryHeaderUtils::hasVary(*result.headers_) ||
+        result.content_length_ > memory_tier.maxEntrySize() ||
+        memory_tier.frequency(key_) < cache_.minRequestsToPromote()) {
+      return;
+    }
+    // The headers carry the age of the response at this point, so the memory tier can compute
+    // later ages from the current time.
+    promotion_ = std::make_unique<Promotion>(
+        Promotion{Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*result.headers_),
+                  ResponseMetadata{cache_.timeSource().systemTime()}, result.content_length_,
+                  result.has_trailers_, {}});
+    promotion_->body_.reserve(result.content_length_);
+    maybeFinishPromotion();
+  }
+
+  void maybeFinishPromotion() {
+    if (promotion_->body_.size() > promotion_->content_length_) {
+      promotion_.reset();
+    } else if (promotion_->body_.size() == promotion_->content_length_ &&
+               !promotion_->has_trailers_) {
+      finishPromotion(nullptr);
+      promotion_.reset();
+    }
+  }
+
+  void finishPromotion(Http::ResponseTrailerMapPtr&& trailers) {
+    if (cache_.memoryTier().insert(
+            key_, InMemoryHttpCache::CacheEntry{
+                      std::move(promotion_->response_headers_), std::move(promotion_->metadata_),
+                      std::make_shared<const std::string>(std::move(promotion_->body_)),
+                      std::move(trailers)})) {
+      cache_.stats().promotions_.inc();
+    }
+  }
+
+  TieredHttpCache& cache_;
+  const Key key_;
+  LookupResult memory_result_;
+  InMemoryHttpCache::CacheEntry memory_entry_;
+  LookupContextPtr backing_lookup_;
+  bool from_memory_tier_ = false;
+  std::unique_ptr<Promotion> promotion_;
+};
+
+} // namespace
+
+TieredHttpCache::TieredHttpCache(Singleton::InstanceSharedPtr owner, const ConfigProto& config,
+                                 std::shared_ptr<InMemoryHttpCache::InMemoryHttpCache> memory_tier,
+                                 std::shared_ptr<HttpCache> backing_tier, TimeSource& time_source,
+                                 Stats::Scope& scope)
+    : owner_(std::move(owner)), config_(config), memory_tier_(std::move(memory_tier)),
+      backing_tier_(std::move(backing_tier)), time_source_(time_source),
+      stats_(generateStats(scope)),
+      min_requests_to_promote_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, min_requests_to_promote,
+                                                               DefaultMinRequestsToPromote)) {}
+
+LookupContextPtr TieredHttpCache::makeLookupContext(LookupRequest&& request,
+                                                    Http::StreamDecoderFilterCallbacks& callbacks) {
+  // The memory tier is looked up right away, as it never blocks, and so that the lookup is
+  // counted before the backing tier responds.
+  InMemoryHttpCache::CacheEntry memory_entry = memory_tier_->lookup(request);
+  LookupResult memory_result;
+  if (memory_entry.response_headers_) {
+    memory_result = request.makeLookupResult(
+        std::move(memory_entry.response_headers_), std::move(memory_entry.metadata_),
+        memory_entry.body_ ? memory_entry.body_->size() : 0, memory_entry.trailers_ != nullptr);
+  }
+  Key key = request.key();
+  return std::make_unique<TieredLookupContext>(
+      *this, std::move(key), std::move(memory_result), std::move(memory_entry),
+      backing_tier_->makeLookupContext(std::move(request), callbacks));
+}
+
+InsertContextPtr TieredHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                    Http::StreamEncoderFilterCallbacks& callbacks) {
+  ASSERT(lookup_context != nullptr);
+  auto& tiered_lookup = static_cast<TieredLookupContext&>(*lookup_context);
+  // The new response replaces the promoted one, if any, in the backing tier only.
+  memory_tier_->erase(tiered_lookup.key());
+  return backing_tier_->makeInsertContext(tiered_lookup.releaseBackingLookup(), callbacks);
+}
+
+void TieredHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const ResponseMetadata& metadata,
+                                    std::function<void(bool)> on_complete) {
+  const auto& tiered_lookup = static_cast<const TieredLookupContext&>(lookup_context);
+  // Responses that vary are never promoted, so the memory tier has them under the plain key if
+  // at all.
+  memory_tier_->updateHeaders(tiered_lookup.key(), response_headers, metadata);
+  backing_tier_->updateHeaders(tiered_lookup.backingLookup(), response_headers, metadata,
+                               std::move(on_complete));
+}
+
+CacheInfo TieredHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  cache_info.supports_range_requests_ = backing_tier_->cacheInfo().supports_range_requests_;
+  return cache_info;
+}
+
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
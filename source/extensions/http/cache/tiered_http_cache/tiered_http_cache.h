@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+
+using ConfigProto = envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig;
+
+/**
+ * All tiered cache stats. @see stats_macros.h
+ **/
+#define ALL_TIERED_CACHE_STATS(COUNTER)                                                            \
+  COUNTER(memory_tier_hits)                                                                        \
+  COUNTER(promotions)
+
+struct CacheStats {
+  ALL_TIERED_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * A cache keeping the most requested responses of another cache, such as a file system cache, in
+ * memory. Responses are only inserted in the backing tier. Responses served from the backing tier
+ * are copied to the memory tier once the memory tier has counted enough recent lookups of them,
+ * and are then served from memory while they're fresh. As the backing tier keeps all responses,
+ * the responses evicted from the memory tier don't need to be written back, and each tier enforces
+ * its own size limit.
+ *
+ * Caches are owned by filter configurations, and jointly own the singleton tracking the caches of
+ * each configuration.
+ */
+class TieredHttpCache : public HttpCache {
+public:
+  TieredHttpCache(Singleton::InstanceSharedPtr owner, const ConfigProto& config,
+                  std::shared_ptr<InMemoryHttpCache::InMemoryHttpCache> memory_tier,
+                  std::shared_ptr<HttpCache> backing_tier, TimeSource& time_source,
+                  Stats::Scope& scope);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  InMemoryHttpCache::InMemoryHttpCache& memoryTier() { return *memory_tier_; }
+  HttpCache& backingTier() { return *backing_tier_; }
+  // Responses requested less often recently are not promoted to the memory tier.
+  uint32_t minRequestsToPromote() const { return min_requests_to_promote_; }
+  TimeSource& timeSource() { return time_source_; }
+  CacheStats& stats() { return stats_; }
+  const ConfigProto& config() const { return config_; }
+
+  static absl::string_view name() { return "envoy.extensions.http.cache.tiered"; }
+
+private:
+  const Singleton::InstanceSharedPtr owner_;
+  const ConfigProto config_;
+  const std::shared_ptr<InMemoryHttpCache::InMemoryHttpCache> memory_tier_;
+  const std::shared_ptr<HttpCache> backing_tier_;
+  TimeSource& time_source_;
+  CacheStats stats_;
+  const uint32_t min_requests_to_promote_;
+};
+
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -257,9 +257,11 @@ PathNormalizer::normalizePathUri(RequestHeaderMap& header_map) const {
   }
 
   absl::string_view normalized_path{path};
-  // Update the :path header. We need to honor the normalized path and the original query/fragment
-  // components.
-  header_map.setPath(absl::StrCat(normalized_path, query));
+  // Update the :path header, unless the path was already normalized. We need to honor the
+  // normalized path and the original query/fragment components.
+  if (normalized_path != path_view) {
+    header_map.setPath(absl::StrCat(normalized_path, query));
+  }
 
   if (redirect) {
     return {PathNormalizationResult::Action::Redirect,
@@ -1,6 +1,7 @@
 #include "source/extensions/io_socket/user_space/file_event_impl.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/io_socket/user_space/io_handle.h"
 
 namespace Envoy {
@@ -16,7 +17,9 @@ FileEventImpl::FileEventImpl(Event::Dispatcher& dispatcher, Event::FileReadyCb c
                   static_cast<void*>(this), ephemeral_events);
         cb(ephemeral_events);
       })),
-      io_source_(io_source) {
+      io_source_(io_source),
+      activate_in_current_iteration_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.user_space_events_in_current_iteration")) {
   setEnabled(events);
 }
 
@@ -25,7 +28,13 @@ void FileEventImpl::activate(uint32_t events) {
   ASSERT((events & (Event::FileReadyType::Read | Event::FileReadyType::Write |
                     Event::FileReadyType::Closed)) == events);
   event_listener_.onEventActivated(events);
-  schedulable_->scheduleCallbackNextIteration();
+  if (activate_in_current_iteration_) {
+    // The peer is on the same dispatcher, so the data it wrote can be read in the iteration it
+    // was written instead of waiting for the next poll.
+    schedulable_->scheduleCallbackCurrentIteration();
+  } else {
+    schedulable_->scheduleCallbackNextIteration();
+  }
 }
 
 void FileEventImpl::setEnabled(uint32_t events) {
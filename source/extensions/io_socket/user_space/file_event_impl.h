@@ -70,6 +70,10 @@ private:
 
   // Supplies readable and writable status.
   IoHandle& io_source_;
+
+  // Whether the activated events are delivered in the current iteration of the dispatcher rather
+  // than the next one.
+  const bool activate_in_current_iteration_;
 };
 } // namespace UserSpace
 } // namespace IoSocket
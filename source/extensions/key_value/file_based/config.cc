@@ -31,18 +31,18 @@ void FileBasedKeyValueStore::flush() {
     ENVOY_LOG(error, "Failed to flush cache to file {}", filename_);
     return;
   }
+  // Serialize the whole store first so that it is written with a single write rather than one
+  // per token.
+  std::string contents;
   for (const auto& [key, value_with_ttl] : store()) {
-    file->write(absl::StrCat(key.length(), "\n"));
-    file->write(key);
-    file->write(absl::StrCat(value_with_ttl.value_.length(), "\n"));
-    file->write(value_with_ttl.value_);
+    absl::StrAppend(&contents, key.length(), "\n", key, value_with_ttl.value_.length(), "\n",
+                    value_with_ttl.value_);
     if (value_with_ttl.ttl_.has_value()) {
-      std::string ttl = std::to_string(value_with_ttl.ttl_.value().count());
-      file->write(KV_STORE_TTL_KEY);
-      file->write(absl::StrCat(ttl.length(), "\n"));
-      file->write(ttl);
+      const std::string ttl = std::to_string(value_with_ttl.ttl_.value().count());
+      absl::StrAppend(&contents, KV_STORE_TTL_KEY, ttl.length(), "\n", ttl);
     }
   }
+  file->write(contents);
   file->close();
 }
 
@@ -20,7 +20,8 @@ ActiveTcpListener::ActiveTcpListener(Network::TcpConnectionHandler& parent,
     : OwnedActiveStreamListenerBase(
           parent, parent.dispatcher(),
           parent.dispatcher().createListener(std::move(socket), *this, runtime, config.bindToPort(),
-                                             config.ignoreGlobalConnLimit()),
+                                             config.ignoreGlobalConnLimit(),
+                                             config.maxConnectionsToAcceptPerSocketEvent()),
           config),
       tcp_conn_handler_(parent), connection_balancer_(connection_balancer),
       listen_address_(listen_address) {
@@ -216,6 +216,10 @@ void FilterChainManagerImpl::addFilterChains(
       filter_chains;
   uint32_t new_filter_chain_size = 0;
   FilterChainsByName filter_chains_by_name;
+  // Hashing a filter chain message prints it in text format. Reserve the maps keyed by messages
+  // so that growing them does not hash every message again.
+  filter_chains.reserve(filter_chain_span.size());
+  fc_contexts_.reserve(filter_chain_span.size());
 
   for (const auto& filter_chain : filter_chain_span) {
     const auto& filter_chain_match = filter_chain->filter_chain_match();
@@ -617,7 +621,9 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  // The maps support heterogeneous lookup, so the server name and its wildcards are looked up
+  // without copying them.
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -627,8 +633,8 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+  while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -648,7 +654,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -835,8 +841,7 @@ Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilte
   }
   auto iter = origin->fc_contexts_.find(filter_chain_message);
   if (iter != origin->fc_contexts_.end()) {
-    // copy the context to this filter chain manager.
-    fc_contexts_.emplace(filter_chain_message, iter->second);
+    // The caller adds the context to this filter chain manager.
     return iter->second;
   }
   return nullptr;
@@ -324,6 +324,9 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      max_connections_to_accept_per_socket_event_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connections_to_accept_per_socket_event,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)),
       listener_init_target_(fmt::format("Listener-init-target {}", name),
                             [this]() { dynamic_init_manager_->initialize(local_init_watcher_); }),
       dynamic_init_manager_(std::make_unique<Init::ManagerImpl>(
@@ -451,6 +454,9 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      max_connections_to_accept_per_socket_event_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connections_to_accept_per_socket_event,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)),
       // listener_init_target_ is not used during in place update because we expect server started.
       listener_init_target_("", nullptr),
       dynamic_init_manager_(std::make_unique<Init::ManagerImpl>(
@@ -523,6 +529,22 @@ void ListenerImpl::validateConfig() {
           name_));
     }
   }
+  if (config_.enable_reuse_port_cpu_steering()) {
+    if (!reuse_port_) {
+      throw EnvoyException(fmt::format(
+          "listener {}: enable_reuse_port_cpu_steering requires reuse_port to be enabled", name_));
+    }
+    if (config_.udp_listener_config().has_quic_options()) {
+      throw EnvoyException(fmt::format("listener {}: enable_reuse_port_cpu_steering cannot be used "
+                                       "with QUIC listeners, which steer packets by connection ID",
+                                       name_));
+    }
+    if (!ENVOY_ATTACH_REUSEPORT_CBPF.hasValue()) {
+      throw EnvoyException(fmt::format("listener {}: enable_reuse_port_cpu_steering is not "
+                                       "supported by the operating system",
+                                       name_));
+    }
+  }
 }
 
 void ListenerImpl::buildAccessLog() {
@@ -544,7 +566,8 @@ void ListenerImpl::buildInternalListener() {
          config_.connection_balance_config().has_exact_balance()) ||
         config_.enable_mptcp() ||
         config_.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
-        || (config_.has_freebind() && config_.freebind().value()) ||
+        || config_.enable_reuse_port_cpu_steering() ||
+        (config_.has_freebind() && config_.freebind().value()) ||
         config_.has_tcp_backlog_size() || config_.has_tcp_fast_open_queue_length() ||
         (config_.has_transparent() && config_.transparent().value())) {
       throw EnvoyException(fmt::format(
@@ -667,6 +690,12 @@ void ListenerImpl::buildListenSocketOptions(
     if (reuse_port_) {
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
+      if (config_.enable_reuse_port_cpu_steering()) {
+        // Worker N owns the N-th socket of the reuse port group.
+        addListenSocketOptions(listen_socket_options_list_[i],
+                               Network::SocketOptionFactory::buildReusePortCpuSteeringOptions(
+                                   parent_.server_.options().concurrency()));
+      }
     }
     if (!config_.socket_options().empty()) {
       addListenSocketOptions(
@@ -1175,6 +1204,7 @@ bool ListenerMessageUtil::socketOptionsEqual(const envoy::config::listener::v3::
                                              const envoy::config::listener::v3::Listener& rhs) {
   if ((PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, transparent, false) !=
        PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, transparent, false)) ||
+      (lhs.enable_reuse_port_cpu_steering() != rhs.enable_reuse_port_cpu_steering()) ||
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, freebind, false) !=
        PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, freebind, false)) ||
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, tcp_fast_open_queue_length, 0) !=
@@ -0,0 +1,181 @@
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+#include <limits>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+namespace {
+// Marks timestamps of hosts that never reported their load.
+constexpr int64_t Never = std::numeric_limits<int64_t>::min();
+
+int64_t toNanoseconds(MonotonicTime time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+} // namespace
+
+bool OrcaLoadReport::parse(absl::string_view report, OrcaLoadReport& result) {
+  report = absl::StripAsciiWhitespace(report);
+  if (!absl::ConsumePrefix(&report, "TEXT ")) {
+    return false;
+  }
+
+  for (const absl::string_view metric : absl::StrSplit(report, ',', absl::SkipWhitespace())) {
+    const std::pair<absl::string_view, absl::string_view> key_value =
+        absl::StrSplit(metric, absl::MaxSplits('=', 1));
+    const absl::string_view key = absl::StripAsciiWhitespace(key_value.first);
+    double value;
+    if (!absl::SimpleAtod(absl::StripAsciiWhitespace(key_value.second), &value) || value < 0) {
+      return false;
+    }
+
+    if (key == "application_utilization") {
+      result.application_utilization_ = value;
+    } else if (key == "cpu_utilization") {
+      result.cpu_utilization_ = value;
+    } else if (key == "rps_fractional") {
+      result.rps_fractional_ = value;
+    } else if (key == "eps") {
+      result.eps_ = value;
+    }
+  }
+  return true;
+}
+
+OrcaWeightHostData::OrcaWeightHostData(TimeSource& time_source, double error_utilization_penalty,
+                                       std::chrono::nanoseconds blackout_period,
+                                       std::chrono::nanoseconds weight_expiration_period)
+    : time_source_(time_source), error_utilization_penalty_(error_utilization_penalty),
+      blackout_period_ns_(blackout_period.count()),
+      weight_expiration_period_ns_(weight_expiration_period.count()), last_update_ns_(Never),
+      non_empty_since_ns_(Never) {}
+
+void OrcaWeightHostData::onLoadReport(absl::string_view report) {
+  OrcaLoadReport load;
+  if (!OrcaLoadReport::parse(report, load)) {
+    return;
+  }
+  const double utilization =
+      load.application_utilization_ > 0 ? load.application_utilization_ : load.cpu_utilization_;
+  // A report without both a rate and a utilization says nothing about the capacity of the host.
+  if (load.rps_fractional_ <= 0 || utilization <= 0) {
+    return;
+  }
+
+  weight_.store(load.rps_fractional_ /
+                    (utilization + load.eps_ / load.rps_fractional_ * error_utilization_penalty_),
+                std::memory_order_relaxed);
+  const int64_t now = toNanoseconds(time_source_.monotonicTime());
+  const int64_t last_update = last_update_ns_.exchange(now, std::memory_order_relaxed);
+  if (last_update == Never || now - last_update >= weight_expiration_period_ns_) {
+    non_empty_since_ns_.store(now, std::memory_order_relaxed);
+  }
+}
+
+double OrcaWeightHostData::weight(MonotonicTime now) const {
+  const int64_t non_empty_since = non_empty_since_ns_.load(std::memory_order_relaxed);
+  if (non_empty_since == Never) {
+    return 0;
+  }
+  const int64_t now_ns = toNanoseconds(now);
+  if (now_ns - last_update_ns_.load(std::memory_order_relaxed) >= weight_expiration_period_ns_ ||
+      now_ns - non_empty_since < blackout_period_ns_) {
+    return 0;
+  }
+  return weight_.load(std::memory_order_relaxed);
+}
+
+ClientSideWeightedRoundRobinLoadBalancer::ClientSideWeightedRoundRobinLoadBalancer(
+    const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+    Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    uint32_t healthy_panic_threshold,
+    const envoy::extensions::load_balancing_policies::client_side_weighted_round_robin::v3::
+        ClientSideWeightedRoundRobin& config,
+    TimeSource& time_source)
+    : RoundRobinLoadBalancer(
+          priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
+          envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin::
+              default_instance(),
+          time_source),
+      error_utilization_penalty_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, error_utilization_penalty, 1.0)),
+      blackout_period_(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, blackout_period, 10000))),
+      weight_expiration_period_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, weight_expiration_period, 180000))),
+      weight_update_period_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, weight_update_period, 1000))) {}
+
+Upstream::HostConstSharedPtr
+ClientSideWeightedRoundRobinLoadBalancer::chooseHostOnce(Upstream::LoadBalancerContext* context) {
+  maybeUpdateWeights();
+  return RoundRobinLoadBalancer::chooseHostOnce(context);
+}
+
+Upstream::HostConstSharedPtr
+ClientSideWeightedRoundRobinLoadBalancer::peekAnotherHost(Upstream::LoadBalancerContext* context) {
+  maybeUpdateWeights();
+  return RoundRobinLoadBalancer::peekAnotherHost(context);
+}
+
+void ClientSideWeightedRoundRobinLoadBalancer::maybeUpdateWeights() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now < next_weight_update_) {
+    return;
+  }
+  next_weight_update_ = now + weight_update_period_;
+  weight_update_time_ = now;
+
+  double total_weight = 0;
+  uint64_t reporting_hosts = 0;
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    for (const auto& host : host_set->hosts()) {
+      const double weight = reportedWeight(*host);
+      if (weight > 0) {
+        total_weight += weight;
+        ++reporting_hosts;
+      }
+    }
+  }
+  has_reported_weights_ = reporting_hosts > 0;
+  default_weight_ = has_reported_weights_ ? total_weight / reporting_hosts : 1.0;
+
+  for (uint32_t priority = 0; priority < priority_set_.hostSetsPerPriority().size(); ++priority) {
+    refresh(priority);
+  }
+}
+
+double ClientSideWeightedRoundRobinLoadBalancer::reportedWeight(const Upstream::Host& host) {
+  Upstream::HostLbPolicyData* lb_policy_data = host.lbPolicyData();
+  if (lb_policy_data == nullptr) {
+    lb_policy_data = &host.setLbPolicyData(std::make_unique<OrcaWeightHostData>(
+        time_source_, error_utilization_penalty_, blackout_period_, weight_expiration_period_));
+  }
+  // Hosts belong to a single cluster and hence are only ever used by this load balancing policy.
+  return static_cast<OrcaWeightHostData*>(lb_policy_data)->weight(weight_update_time_);
+}
+
+double ClientSideWeightedRoundRobinLoadBalancer::hostWeight(const Upstream::Host& host) {
+  const double weight = reportedWeight(host);
+  return weight > 0 ? weight : default_weight_;
+}
+
+bool ClientSideWeightedRoundRobinLoadBalancer::hostWeightsAreEqual(
+    const Upstream::HostVector& hosts) const {
+  // Weights assigned by service discovery are ignored, hosts weigh the same until they report.
+  return !has_reported_weights_ || hosts.size() <= 1;
+}
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/upstream/load_balancer_impl.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+/**
+ * The metrics of an ORCA load report that determine the weight of a host.
+ */
+struct OrcaLoadReport {
+  double application_utilization_{};
+  double cpu_utilization_{};
+  double rps_fractional_{};
+  double eps_{};
+
+  /**
+   * Parse a load report in the text format, e.g. "TEXT cpu_utilization=0.3, rps_fractional=10".
+   * Metrics that don't determine the weight, like named metrics, are skipped.
+   * @return whether the report could be parsed.
+   */
+  static bool parse(absl::string_view report, OrcaLoadReport& result);
+};
+
+/**
+ * The weight of a host derived from the load reports that the host attaches to its responses.
+ * Updated by the router filter of any worker and read by the load balancers of all workers, so the
+ * state is kept in atomics rather than behind a lock.
+ */
+class OrcaWeightHostData : public Upstream::HostLbPolicyData {
+public:
+  OrcaWeightHostData(TimeSource& time_source, double error_utilization_penalty,
+                     std::chrono::nanoseconds blackout_period,
+                     std::chrono::nanoseconds weight_expiration_period);
+
+  // Upstream::HostLbPolicyData
+  void onResponseTime(std::chrono::microseconds) override {}
+  void onLoadReport(absl::string_view report) override;
+
+  /**
+   * @return the weight of the host at now, or 0 if the host did not report its load continuously
+   *         for the blackout period or its latest report expired.
+   */
+  double weight(MonotonicTime now) const;
+
+private:
+  TimeSource& time_source_;
+  const double error_utilization_penalty_;
+  const int64_t blackout_period_ns_;
+  const int64_t weight_expiration_period_ns_;
+  std::atomic<double> weight_{0};
+  // Monotonic times in nanoseconds of the latest report and of the first report since the host
+  // started reporting continuously. 0 if the host never reported.
+  std::atomic<int64_t> last_update_ns_{0};
+  std::atomic<int64_t> non_empty_since_ns_{0};
+};
+
+/**
+ * Weighted round robin load balancer that weighs hosts by the load they report. Each worker
+ * periodically recomputes the weights of all hosts and refreshes its EDF schedules with them.
+ */
+class ClientSideWeightedRoundRobinLoadBalancer : public Upstream::RoundRobinLoadBalancer {
+public:
+  ClientSideWeightedRoundRobinLoadBalancer(
+      const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+      Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+      uint32_t healthy_panic_threshold,
+      const envoy::extensions::load_balancing_policies::client_side_weighted_round_robin::v3::
+          ClientSideWeightedRoundRobin& config,
+      TimeSource& time_source);
+
+  // Upstream::EdfLoadBalancerBase
+  Upstream::HostConstSharedPtr chooseHostOnce(Upstream::LoadBalancerContext* context) override;
+  Upstream::HostConstSharedPtr peekAnotherHost(Upstream::LoadBalancerContext* context) override;
+
+private:
+  // Upstream::EdfLoadBalancerBase
+  double hostWeight(const Upstream::Host& host) override;
+  bool hostWeightsAreEqual(const Upstream::HostVector& hosts) const override;
+
+  void maybeUpdateWeights();
+  double reportedWeight(const Upstream::Host& host);
+
+  const double error_utilization_penalty_;
+  const std::chrono::nanoseconds blackout_period_;
+  const std::chrono::nanoseconds weight_expiration_period_;
+  const std::chrono::nanoseconds weight_update_period_;
+  MonotonicTime next_weight_update_{};
+  // The time of the latest weight update. Weights are evaluated at this time, so that all picks
+  // between two updates see the same weights.
+  MonotonicTime weight_update_time_{};
+  // The weight of hosts without a usable report, i.e. the mean of the reported weights.
+  double default_weight_{1.0};
+  bool has_reported_weights_{};
+};
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
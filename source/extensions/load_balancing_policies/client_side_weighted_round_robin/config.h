@@ -0,0 +1,33 @@
+#pragma once
+
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.h"
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.validate.h"
+#include "envoy/upstream/load_balancer.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/load_balancing_policies/common/factory_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+struct ClientSideWeightedRoundRobinCreator : public Logger::Loggable<Logger::Id::upstream> {
+  Upstream::LoadBalancerPtr
+  operator()(Upstream::LoadBalancerParams params, const Upstream::ClusterInfo& cluster_info,
+             const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+             Envoy::Random::RandomGenerator& random, TimeSource& time_source);
+};
+
+class Factory : public Common::FactoryBase<envoy::extensions::load_balancing_policies::
+                                               client_side_weighted_round_robin::v3::
+                                                   ClientSideWeightedRoundRobin,
+                                           ClientSideWeightedRoundRobinCreator> {
+public:
+  Factory() : FactoryBase("envoy.load_balancing_policies.client_side_weighted_round_robin") {}
+};
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,43 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/config.h"
+
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+Upstream::LoadBalancerPtr PeakEwmaCreator::operator()(Upstream::LoadBalancerParams params,
+                                                      const Upstream::ClusterInfo& cluster_info,
+                                                      const Upstream::PrioritySet&,
+                                                      Runtime::Loader& runtime,
+                                                      Envoy::Random::RandomGenerator& random,
+                                                      TimeSource& time_source) {
+
+  const auto* typed_config =
+      dynamic_cast<const envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma*>(
+          cluster_info.loadBalancingPolicy().get());
+
+  // The load balancing policy configuration will be loaded and validated in the main thread when we
+  // load the cluster configuration. So we can assume the configuration is valid here.
+  ASSERT(typed_config != nullptr,
+         "Invalid load balancing policy configuration for peak EWMA load balancer");
+
+  return std::make_unique<PeakEwmaLoadBalancer>(
+      params.priority_set, params.local_priority_set, cluster_info.lbStats(), runtime, random,
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info.lbConfig(),
+                                                     healthy_panic_threshold, 100, 50),
+      *typed_config, time_source);
+}
+
+/**
+ * Static registration for the Factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(Factory, Upstream::TypedLoadBalancerFactory);
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
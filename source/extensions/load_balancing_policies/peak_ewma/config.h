@@ -0,0 +1,32 @@
+#pragma once
+
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.validate.h"
+#include "envoy/upstream/load_balancer.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/load_balancing_policies/common/factory_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+struct PeakEwmaCreator : public Logger::Loggable<Logger::Id::upstream> {
+  Upstream::LoadBalancerPtr
+  operator()(Upstream::LoadBalancerParams params, const Upstream::ClusterInfo& cluster_info,
+             const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+             Envoy::Random::RandomGenerator& random, TimeSource& time_source);
+};
+
+class Factory : public Common::FactoryBase<
+                    envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma,
+                    PeakEwmaCreator> {
+public:
+  Factory() : FactoryBase("envoy.load_balancing_policies.peak_ewma") {}
+};
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,127 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+namespace {
+int64_t toNanoseconds(MonotonicTime time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+} // namespace
+
+PeakEwmaHostData::PeakEwmaHostData(TimeSource& time_source, std::chrono::nanoseconds decay_time,
+                                   std::chrono::microseconds default_latency)
+    : time_source_(time_source), decay_time_ns_(decay_time.count()),
+      latency_us_(default_latency.count()),
+      last_update_ns_(toNanoseconds(time_source.monotonicTime())) {}
+
+double PeakEwmaHostData::decay(MonotonicTime now) const {
+  const int64_t elapsed_ns = toNanoseconds(now) - last_update_ns_.load(std::memory_order_relaxed);
+  return elapsed_ns > 0 ? std::exp(-elapsed_ns / decay_time_ns_) : 1.0;
+}
+
+void PeakEwmaHostData::onResponseTime(std::chrono::microseconds response_time) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const double observed = response_time.count();
+  const double current = latency_us_.load(std::memory_order_relaxed);
+  const double weight = decay(now);
+
+  // Concurrent updates may race, in which case one of the response times is lost. That is fine for
+  // a moving average and keeps both updates and picks free of locks.
+  latency_us_.store(observed > current ? observed : current * weight + observed * (1.0 - weight),
+                    std::memory_order_relaxed);
+  last_update_ns_.store(toNanoseconds(now), std::memory_order_relaxed);
+}
+
+double PeakEwmaHostData::latency(MonotonicTime now) const {
+  return latency_us_.load(std::memory_order_relaxed) * decay(now);
+}
+
+PeakEwmaLoadBalancer::PeakEwmaLoadBalancer(
+    const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+    Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    uint32_t healthy_panic_threshold,
+    const envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma& config,
+    TimeSource& time_source)
+    : ZoneAwareLoadBalancerBase(
+          priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
+          Upstream::LoadBalancerConfigHelper::localityLbConfigFromProto(config)),
+      choice_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, choice_count, 2)),
+      decay_time_(std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, decay_time, 10000))),
+      default_latency_(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, default_latency, 30))),
+      time_source_(time_source) {}
+
+Upstream::HostConstSharedPtr
+PeakEwmaLoadBalancer::chooseHostOnce(Upstream::LoadBalancerContext* context) {
+  return peekOrChoose(context, false);
+}
+
+Upstream::HostConstSharedPtr
+PeakEwmaLoadBalancer::peekAnotherHost(Upstream::LoadBalancerContext* context) {
+  // Only allow as many preconnected connections as there are healthy hosts.
+  if (stashed_random_.size() >= total_healthy_hosts_) {
+    return nullptr;
+  }
+  return peekOrChoose(context, true);
+}
+
+Upstream::HostConstSharedPtr
+PeakEwmaLoadBalancer::peekOrChoose(Upstream::LoadBalancerContext* context, bool peek) {
+  const uint64_t random_hash = random(peek);
+  const absl::optional<HostsSource> hosts_source = hostSourceToUse(context, random_hash);
+  if (!hosts_source) {
+    return nullptr;
+  }
+
+  const Upstream::HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
+  if (hosts_to_use.empty()) {
+    return nullptr;
+  }
+
+  // Latencies change with every response, so there is no point in predicting the next pick when
+  // preconnecting.
+  if (peek) {
+    return hosts_to_use[random_hash % hosts_to_use.size()];
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  Upstream::HostSharedPtr candidate_host;
+  double candidate_cost = 0;
+  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
+    const Upstream::HostSharedPtr& sampled_host =
+        hosts_to_use[random_.random() % hosts_to_use.size()];
+    const double sampled_cost = hostCost(*sampled_host, now);
+    if (candidate_host == nullptr || sampled_cost < candidate_cost) {
+      candidate_host = sampled_host;
+      candidate_cost = sampled_cost;
+    }
+  }
+
+  return candidate_host;
+}
+
+double PeakEwmaLoadBalancer::hostCost(const Upstream::Host& host, MonotonicTime now) {
+  Upstream::HostLbPolicyData* lb_policy_data = host.lbPolicyData();
+  if (lb_policy_data == nullptr) {
+    lb_policy_data = &host.setLbPolicyData(
+        std::make_unique<PeakEwmaHostData>(time_source_, decay_time_, default_latency_));
+  }
+  // Hosts belong to a single cluster and hence are only ever used by this load balancing policy.
+  const double latency = static_cast<PeakEwmaHostData*>(lb_policy_data)->latency(now);
+
+  // The extra microsecond keeps active requests relevant once the latency of an idle host has
+  // decayed to almost nothing.
+  return (latency + 1.0) * (host.stats().rq_active_.value() + 1) / host.weight();
+}
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/upstream/load_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+/**
+ * Peak EWMA of the response times of a host. Updated by the router filter of any worker and read by
+ * the load balancers of all workers, so the state is kept in atomics rather than behind a lock.
+ */
+class PeakEwmaHostData : public Upstream::HostLbPolicyData {
+public:
+  PeakEwmaHostData(TimeSource& time_source, std::chrono::nanoseconds decay_time,
+                   std::chrono::microseconds default_latency);
+
+  // Upstream::HostLbPolicyData
+  void onResponseTime(std::chrono::microseconds response_time) override;
+  void onLoadReport(absl::string_view) override {}
+
+  /**
+   * @return the latency estimate of the host in microseconds, decayed up to now.
+   */
+  double latency(MonotonicTime now) const;
+
+private:
+  // @return the weight that the average of the last update still has at now.
+  double decay(MonotonicTime now) const;
+
+  TimeSource& time_source_;
+  const double decay_time_ns_;
+  std::atomic<double> latency_us_;
+  // Monotonic time of the last update, in nanoseconds.
+  std::atomic<int64_t> last_update_ns_;
+};
+
+/**
+ * Power of N choices load balancer that picks the host with the lowest expected latency, which is
+ * the peak EWMA of the host's response times multiplied by its number of active requests.
+ */
+class PeakEwmaLoadBalancer : public Upstream::ZoneAwareLoadBalancerBase {
+public:
+  PeakEwmaLoadBalancer(
+      const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+      Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+      uint32_t healthy_panic_threshold,
+      const envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma& config,
+      TimeSource& time_source);
+
+  // Upstream::ZoneAwareLoadBalancerBase
+  Upstream::HostConstSharedPtr chooseHostOnce(Upstream::LoadBalancerContext* context) override;
+  Upstream::HostConstSharedPtr peekAnotherHost(Upstream::LoadBalancerContext* context) override;
+
+private:
+  Upstream::HostConstSharedPtr peekOrChoose(Upstream::LoadBalancerContext* context, bool peek);
+  double hostCost(const Upstream::Host& host, MonotonicTime now);
+
+  const uint32_t choice_count_;
+  const std::chrono::nanoseconds decay_time_;
+  const std::chrono::microseconds default_latency_;
+  TimeSource& time_source_;
+};
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
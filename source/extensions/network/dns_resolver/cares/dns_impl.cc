@@ -274,39 +274,64 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
                   "dns resolution for {} completed with status {}", dns_name_,
                   static_cast<int>(pending_response_.status_));
 
+  // Queries issued from the callbacks below start a new resolution.
+  if (collapsible_) {
+    parent_.collapsible_resolutions_.erase(std::make_pair(dns_name_, dns_lookup_family_));
+    collapsible_ = false;
+  }
+
   if (!cancelled_) {
-    // Use a raw try here because it is used in both main thread and filter.
-    // Can not convert to use status code as there may be unexpected exceptions in server fuzz
-    // tests, which must be handled. Potential exception may come from getAddressWithPort() or
-    // portFromTcpUrl().
-    // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
-    // exception in fuzz tests.
-    TRY_NEEDS_AUDIT {
-      callback_(pending_response_.status_, std::move(pending_response_.address_list_));
-    }
-    catch (const EnvoyException& e) {
-      ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
-      dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-    }
-    catch (const std::exception& e) {
-      ENVOY_LOG(critical, "std::exception in c-ares callback: {}", e.what());
-      dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-    }
-    catch (...) {
-      ENVOY_LOG(critical, "Unknown exception in c-ares callback");
-      dispatcher_.post([] { throw EnvoyException("unknown"); });
+    if (collapsed_queries_.empty()) {
+      runCallback(callback_, std::move(pending_response_.address_list_));
+    } else {
+      runCallback(callback_, std::list<DnsResponse>(pending_response_.address_list_));
     }
   } else {
     ENVOY_LOG_EVENT(debug, "cares_dns_callback_cancelled",
                     "dns resolution callback for {} not issued. Cancelled with reason={}",
                     dns_name_, static_cast<int>(cancel_reason_));
   }
+  for (const CollapsedQueryPtr& collapsed_query : collapsed_queries_) {
+    if (!collapsed_query->cancelled_) {
+      runCallback(collapsed_query->callback_,
+                  std::list<DnsResponse>(pending_response_.address_list_));
+    }
+  }
   if (owned_) {
     delete this;
     return;
   }
 }
 
+void DnsResolverImpl::PendingResolution::runCallback(const ResolveCb& callback,
+                                                     std::list<DnsResponse>&& address_list) {
+  // Use a raw try here because it is used in both main thread and filter.
+  // Can not convert to use status code as there may be unexpected exceptions in server fuzz
+  // tests, which must be handled. Potential exception may come from getAddressWithPort() or
+  // portFromTcpUrl().
+  // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
+  // exception in fuzz tests.
+  TRY_NEEDS_AUDIT { callback(pending_response_.status_, std::move(address_list)); }
+  catch (const EnvoyException& e) {
+    ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
+    dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+  }
+  catch (const std::exception& e) {
+    ENVOY_LOG(critical, "std::exception in c-ares callback: {}", e.what());
+    dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+  }
+  catch (...) {
+    ENVOY_LOG(critical, "Unknown exception in c-ares callback");
+    dispatcher_.post([] { throw EnvoyException("unknown"); });
+  }
+}
+
+ActiveDnsQuery* DnsResolverImpl::PendingResolution::addCollapsedQuery(ResolveCb callback) {
+  ASSERT(collapsible_);
+  collapsed_queries_.push_back(std::make_unique<CollapsedQuery>(std::move(callback)));
+  return collapsed_queries_.back().get();
+}
+
 void DnsResolverImpl::updateAresTimer() {
   // Update the timeout for events.
   timeval timeout;
@@ -364,6 +389,18 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     initializeChannel(&options.options_, options.optmask_);
   }
 
+  const bool collapse_queries =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.cares_collapse_in_flight_queries");
+  if (collapse_queries) {
+    const auto it = collapsible_resolutions_.find(std::make_pair(dns_name, dns_lookup_family));
+    if (it != collapsible_resolutions_.end()) {
+      ENVOY_LOG_EVENT(debug, "cares_dns_resolution_collapsed",
+                      "dns resolution for {} joined the one in flight", dns_name);
+      stats_.collapsed_queries_.inc();
+      return it->second->addCollapsedQuery(std::move(callback));
+    }
+  }
+
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
   pending_resolution->startResolution();
@@ -379,6 +416,11 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     // if ~DnsResolverImpl() happens via ares_destroy() and subsequent handling of ARES_EDESTRUCTION
     // in DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback()).
     pending_resolution->owned_ = true;
+    if (collapse_queries) {
+      collapsible_resolutions_.emplace(std::make_pair(dns_name, dns_lookup_family),
+                                       pending_resolution.get());
+      pending_resolution->collapsible_ = true;
+    }
     return pending_resolution.release();
   }
 }
@@ -401,8 +443,8 @@ void DnsResolverImpl::chargeGetAddrInfoErrorStats(int status, int timeouts) {
 DnsResolverImpl::AddrInfoPendingResolution::AddrInfoPendingResolution(
     DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
     ares_channel channel, const std::string& dns_name, DnsLookupFamily dns_lookup_family)
-    : PendingResolution(parent, callback, dispatcher, channel, dns_name),
-      dns_lookup_family_(dns_lookup_family), available_interfaces_(availableInterfaces()),
+    : PendingResolution(parent, callback, dispatcher, channel, dns_name, dns_lookup_family),
+      available_interfaces_(availableInterfaces()),
       accept_nodata_(
           Runtime::runtimeFeatureEnabled("envoy.reloadable_features.cares_accept_nodata")) {
   if (dns_lookup_family == DnsLookupFamily::Auto ||
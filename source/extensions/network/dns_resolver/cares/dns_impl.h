@@ -14,6 +14,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -28,7 +29,8 @@ namespace Network {
   GAUGE(pending_resolutions, NeverImport)                                                          \
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
-  COUNTER(timeouts)
+  COUNTER(timeouts)                                                                                \
+  COUNTER(collapsed_queries)
 
 /**
  * Struct definition for all DNS stats. @see stats_macros.h
@@ -64,6 +66,21 @@ public:
 
 private:
   friend class DnsResolverImplPeer;
+
+  // A query that was issued while a resolution of the same name and lookup family was in flight,
+  // and that completes with that resolution instead of sending its own.
+  class CollapsedQuery : public ActiveDnsQuery {
+  public:
+    explicit CollapsedQuery(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+
+    const ResolveCb callback_;
+    bool cancelled_ = false;
+  };
+  using CollapsedQueryPtr = std::unique_ptr<CollapsedQuery>;
+
   class PendingResolution : public ActiveDnsQuery {
   public:
     void cancel(CancelReason reason) override {
@@ -78,15 +95,26 @@ private:
     bool owned_ = false;
     // Has the query completed? Only meaningful if !owned_;
     bool completed_ = false;
+    // Can queries for the same name and lookup family join the resolution? Only set if owned_.
+    bool collapsible_ = false;
+
+    /**
+     * Adds a query that completes along with this resolution.
+     * @param callback supplies the callback to invoke on completion.
+     * @return ActiveDnsQuery* the query, which is owned by this resolution.
+     */
+    ActiveDnsQuery* addCollapsedQuery(ResolveCb callback);
 
   protected:
     // Network::ActiveDnsQuery
     PendingResolution(DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
-                      ares_channel channel, const std::string& dns_name)
+                      ares_channel channel, const std::string& dns_name,
+                      DnsLookupFamily dns_lookup_family)
         : parent_(parent), callback_(callback), dispatcher_(dispatcher), channel_(channel),
-          dns_name_(dns_name) {}
+          dns_name_(dns_name), dns_lookup_family_(dns_lookup_family) {}
 
     void finishResolve();
+    void runCallback(const ResolveCb& callback, std::list<DnsResponse>&& address_list);
 
     DnsResolverImpl& parent_;
     // Caller supplied callback to invoke on query completion or error.
@@ -97,7 +125,10 @@ private:
     bool cancelled_ = false;
     const ares_channel channel_;
     const std::string dns_name_;
+    const DnsLookupFamily dns_lookup_family_;
     CancelReason cancel_reason_;
+    // Queries that joined this resolution while it was in flight.
+    std::list<CollapsedQueryPtr> collapsed_queries_;
 
     // Small wrapping struct to accumulate addresses from firings of the
     // onAresGetAddrInfoCallback callback.
@@ -157,7 +188,6 @@ private:
     // all concurrent queries are unwound before cleaning up the resolution.
     uint32_t pending_resolutions_ = 0;
     int family_ = AF_INET;
-    const DnsLookupFamily dns_lookup_family_;
     // Queried for at construction time.
     const AvailableInterfaces available_interfaces_;
     const bool accept_nodata_;
@@ -194,6 +224,9 @@ private:
   envoy::config::core::v3::DnsResolverOptions dns_resolver_options_;
 
   absl::node_hash_map<int, Event::FileEventPtr> events_;
+  // Resolutions in flight that queries for the same name and lookup family can join.
+  absl::flat_hash_map<std::pair<std::string, DnsLookupFamily>, PendingResolution*>
+      collapsible_resolutions_;
   const bool use_resolvers_as_fallback_;
   const absl::optional<std::string> resolvers_csv_;
   const bool filter_unroutable_families_;
@@ -0,0 +1,310 @@
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+void BoringSslOperationProcessor::process(
+    absl::Span<const PrivateKeyOperationSharedPtr> operations) {
+  for (const PrivateKeyOperationSharedPtr& operation : operations) {
+    processOne(*operation);
+  }
+}
+
+void BoringSslOperationProcessor::processOne(PrivateKeyOperation& operation) {
+  operation.result_ = OperationStatus::Failure;
+  size_t out_len = 0;
+  if (operation.sign_) {
+    const EVP_MD* md = SSL_get_signature_algorithm_digest(operation.signature_algorithm_);
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx;
+    if (md == nullptr ||
+        !EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, operation.pkey_.get())) {
+      return;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(operation.signature_algorithm_) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+      return;
+    }
+    if (!EVP_DigestSign(ctx.get(), nullptr, &out_len, operation.input_.data(),
+                        operation.input_.size())) {
+      return;
+    }
+    operation.output_.resize(out_len);
+    if (!EVP_DigestSign(ctx.get(), operation.output_.data(), &out_len, operation.input_.data(),
+                        operation.input_.size())) {
+      return;
+    }
+  } else {
+    RSA* rsa = EVP_PKEY_get0_RSA(operation.pkey_.get());
+    if (rsa == nullptr) {
+      return;
+    }
+    operation.output_.resize(RSA_size(rsa));
+    if (!RSA_decrypt(rsa, &out_len, operation.output_.data(), operation.output_.size(),
+                     operation.input_.data(), operation.input_.size(), RSA_NO_PADDING)) {
+      return;
+    }
+  }
+  operation.output_.resize(out_len);
+  operation.result_ = OperationStatus::Success;
+}
+
+PrivateKeyOperationPool::PrivateKeyOperationPool(Thread::ThreadFactory& thread_factory,
+                                                 uint32_t thread_count, uint32_t max_batch_size,
+                                                 PrivateKeyOperationProcessorPtr processor,
+                                                 ThreadPoolPrivateKeyStats& stats)
+    : max_batch_size_(max_batch_size), processor_(std::move(processor)), stats_(stats) {
+  ASSERT(thread_count > 0 && max_batch_size > 0);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.push_back(thread_factory.createThread([this]() { threadRoutine(); },
+                                                   Thread::Options{"TlsKeyPool"}));
+  }
+}
+
+PrivateKeyOperationPool::~PrivateKeyOperationPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+  // The operations that were never started are dropped.
+  absl::MutexLock lock(&mutex_);
+  stats_.queued_operations_.sub(queue_.size());
+}
+
+void PrivateKeyOperationPool::enqueue(PrivateKeyOperationSharedPtr operation) {
+  stats_.queued_operations_.inc();
+  absl::MutexLock lock(&mutex_);
+  queue_.push_back(std::move(operation));
+}
+
+void PrivateKeyOperationPool::threadRoutine() {
+  std::vector<PrivateKeyOperationSharedPtr> batch;
+  batch.reserve(max_batch_size_);
+  while (true) {
+    {
+      const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return !queue_.empty() || shutdown_;
+      };
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (shutdown_) {
+        return;
+      }
+      const size_t batch_size = std::min<size_t>(queue_.size(), max_batch_size_);
+      std::move(queue_.begin(), queue_.begin() + batch_size, std::back_inserter(batch));
+      queue_.erase(queue_.begin(), queue_.begin() + batch_size);
+    }
+    stats_.queued_operations_.sub(batch.size());
+    stats_.batches_.inc();
+    ENVOY_LOG(trace, "processing {} private key operations", batch.size());
+    processor_->process(batch);
+
+    for (PrivateKeyOperationSharedPtr& operation : batch) {
+      stats_.operations_.inc();
+      if (operation->result_ != OperationStatus::Success) {
+        stats_.operation_failures_.inc();
+      }
+      Event::Dispatcher& dispatcher = operation->dispatcher_;
+      dispatcher.post([operation = std::move(operation)]() {
+        operation->status_ = operation->result_;
+        if (operation->callbacks_ != nullptr) {
+          operation->callbacks_->onPrivateKeyMethodComplete();
+        }
+      });
+    }
+    batch.clear();
+  }
+}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->callbacks_ = nullptr;
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::sign(uint16_t signature_algorithm,
+                                                              const uint8_t* in, size_t in_len) {
+  if (EVP_PKEY_id(pkey_.get()) != SSL_get_signature_algorithm_key_type(signature_algorithm) ||
+      SSL_get_signature_algorithm_digest(signature_algorithm) == nullptr) {
+    return ssl_private_key_failure;
+  }
+  operation_ = std::make_shared<PrivateKeyOperation>(bssl::UpRef(pkey_), dispatcher_, callbacks_,
+                                                     absl::MakeConstSpan(in, in_len));
+  operation_->setSignatureAlgorithm(signature_algorithm);
+  pool_.enqueue(operation_);
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::decrypt(const uint8_t* in,
+                                                                 size_t in_len) {
+  if (EVP_PKEY_id(pkey_.get()) != EVP_PKEY_RSA) {
+    return ssl_private_key_failure;
+  }
+  operation_ = std::make_shared<PrivateKeyOperation>(bssl::UpRef(pkey_), dispatcher_, callbacks_,
+                                                     absl::MakeConstSpan(in, in_len));
+  pool_.enqueue(operation_);
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  // The handshake may be resumed by another event before the operation is done.
+  if (operation_->status_ == OperationStatus::Pending) {
+    return ssl_private_key_retry;
+  }
+
+  PrivateKeyOperationSharedPtr operation = std::move(operation_);
+  if (operation->status_ != OperationStatus::Success || operation->output_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(operation->output_.begin(), operation->output_.end(), out);
+  *out_len = operation->output_.size();
+  return ssl_private_key_success;
+}
+
+namespace {
+
+template <int (*ConnectionIndex)()>
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return ssl == nullptr ? nullptr
+                        : static_cast<ThreadPoolPrivateKeyConnection*>(
+                              SSL_get_ex_data(ssl, ConnectionIndex()));
+}
+
+template <int (*ConnectionIndex)()>
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection<ConnectionIndex>(ssl);
+  return connection == nullptr ? ssl_private_key_failure
+                               : connection->sign(signature_algorithm, in, in_len);
+}
+
+template <int (*ConnectionIndex)()>
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t, const uint8_t* in,
+                                           size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection<ConnectionIndex>(ssl);
+  return connection == nullptr ? ssl_private_key_failure : connection->decrypt(in, in_len);
+}
+
+template <int (*ConnectionIndex)()>
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection<ConnectionIndex>(ssl);
+  return connection == nullptr ? ssl_private_key_failure
+                               : connection->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : stats_({ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(factory_context.scope(), "thread_pool_private_key_provider."),
+          POOL_GAUGE_PREFIX(factory_context.scope(), "thread_pool_private_key_provider."))}) {
+  const std::string private_key =
+      Config::DataSource::read(config.private_key(), false, factory_context.api());
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+    method_->sign = privateKeySign<rsaConnectionIndex>;
+    method_->decrypt = privateKeyDecrypt<rsaConnectionIndex>;
+    method_->complete = privateKeyComplete<rsaConnectionIndex>;
+    break;
+  case EVP_PKEY_EC:
+    method_->sign = privateKeySign<ecdsaConnectionIndex>;
+    method_->decrypt = privateKeyDecrypt<ecdsaConnectionIndex>;
+    method_->complete = privateKeyComplete<ecdsaConnectionIndex>;
+    break;
+  default:
+    throw EnvoyException("Not supported key type, only EC and RSA are supported.");
+  }
+
+  pool_ = std::make_unique<PrivateKeyOperationPool>(
+      factory_context.api().threadFactory(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, 2),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, 8),
+      std::make_unique<BoringSslOperationProcessor>(), stats_);
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  const int index = connectionIndex();
+  if (SSL_get_ex_data(ssl, index) != nullptr) {
+    throw EnvoyException(
+        "Can't distinguish between two registered providers for the same SSL object.");
+  }
+  SSL_set_ex_data(ssl, index,
+                  new ThreadPoolPrivateKeyConnection(cb, dispatcher, bssl::UpRef(pkey_), *pool_));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  const int index = connectionIndex();
+  ThreadPoolPrivateKeyConnection* connection =
+      static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, index));
+  SSL_set_ex_data(ssl, index, nullptr);
+  delete connection;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa_private_key != nullptr && RSA_check_fips(rsa_private_key);
+  }
+  const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ecdsa_private_key != nullptr && EC_KEY_check_fips(ecdsa_private_key);
+}
+
+Ssl::BoringSslPrivateKeyMethodSharedPtr
+ThreadPoolPrivateKeyMethodProvider::getBoringSslPrivateKeyMethod() {
+  return method_;
+}
+
+int ThreadPoolPrivateKeyMethodProvider::rsaConnectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+int ThreadPoolPrivateKeyMethodProvider::ecdsaConnectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
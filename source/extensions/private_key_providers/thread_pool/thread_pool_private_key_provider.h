@@ -0,0 +1,194 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_callbacks.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, GAUGE)                                          \
+  COUNTER(operations)                                                                              \
+  COUNTER(operation_failures)                                                                      \
+  COUNTER(batches)                                                                                 \
+  GAUGE(queued_operations, Accumulate)
+
+/**
+ * Thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+enum class OperationStatus { Pending, Success, Failure };
+
+/**
+ * A private key operation of a TLS handshake. It is created on the worker thread of the
+ * connection, computed on a pool thread and handed back to the worker thread.
+ */
+class PrivateKeyOperation {
+public:
+  PrivateKeyOperation(bssl::UniquePtr<EVP_PKEY> pkey, Event::Dispatcher& dispatcher,
+                      Ssl::PrivateKeyConnectionCallbacks& callbacks, absl::Span<const uint8_t> in)
+      : pkey_(std::move(pkey)), dispatcher_(dispatcher), input_(in.begin(), in.end()),
+        callbacks_(&callbacks) {}
+
+  // Set up a signing operation, or a decryption operation otherwise.
+  void setSignatureAlgorithm(uint16_t signature_algorithm) {
+    sign_ = true;
+    signature_algorithm_ = signature_algorithm;
+  }
+
+  // The fields below are only accessed by the pool thread until the operation is complete.
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Event::Dispatcher& dispatcher_;
+  bool sign_{};
+  uint16_t signature_algorithm_{};
+  std::vector<uint8_t> input_;
+  std::vector<uint8_t> output_;
+  OperationStatus result_{OperationStatus::Pending};
+
+  // The fields below are only accessed on the worker thread. The status becomes the result once
+  // the worker thread is told about the completion, so that BoringSSL never sees a result that
+  // is still being written.
+  OperationStatus status_{OperationStatus::Pending};
+  // Cleared when the connection goes away before the operation completes.
+  Ssl::PrivateKeyConnectionCallbacks* callbacks_;
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+/**
+ * Computes batches of private key operations on a pool thread. Implementations may compute the
+ * operations of a batch together, e.g. with multi-buffer instructions.
+ */
+class PrivateKeyOperationProcessor {
+public:
+  virtual ~PrivateKeyOperationProcessor() = default;
+
+  /**
+   * Compute the operations, setting the result and output of each of them.
+   * @param operations supplies the batch.
+   */
+  virtual void process(absl::Span<const PrivateKeyOperationSharedPtr> operations) PURE;
+};
+
+using PrivateKeyOperationProcessorPtr = std::unique_ptr<PrivateKeyOperationProcessor>;
+
+/**
+ * Computes the operations one by one with BoringSSL.
+ */
+class BoringSslOperationProcessor : public PrivateKeyOperationProcessor {
+public:
+  // PrivateKeyOperationProcessor
+  void process(absl::Span<const PrivateKeyOperationSharedPtr> operations) override;
+
+  static void processOne(PrivateKeyOperation& operation);
+};
+
+/**
+ * A pool of threads computing queued private key operations. Completed operations are posted back
+ * to the dispatcher they came from.
+ */
+class PrivateKeyOperationPool : public Logger::Loggable<Logger::Id::connection> {
+public:
+  PrivateKeyOperationPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                          uint32_t max_batch_size, PrivateKeyOperationProcessorPtr processor,
+                          ThreadPoolPrivateKeyStats& stats);
+  ~PrivateKeyOperationPool();
+
+  void enqueue(PrivateKeyOperationSharedPtr operation);
+
+private:
+  void threadRoutine();
+
+  const uint32_t max_batch_size_;
+  PrivateKeyOperationProcessorPtr processor_;
+  ThreadPoolPrivateKeyStats& stats_;
+  absl::Mutex mutex_;
+  std::deque<PrivateKeyOperationSharedPtr> queue_ ABSL_GUARDED_BY(mutex_);
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+/**
+ * The private key operation state of a TLS connection.
+ */
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& callbacks,
+                                 Event::Dispatcher& dispatcher, bssl::UniquePtr<EVP_PKEY> pkey,
+                                 PrivateKeyOperationPool& pool)
+      : callbacks_(callbacks), dispatcher_(dispatcher), pkey_(std::move(pkey)), pool_(pool) {}
+  ~ThreadPoolPrivateKeyConnection();
+
+  ssl_private_key_result_t sign(uint16_t signature_algorithm, const uint8_t* in, size_t in_len);
+  ssl_private_key_result_t decrypt(const uint8_t* in, size_t in_len);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+private:
+  Ssl::PrivateKeyConnectionCallbacks& callbacks_;
+  Event::Dispatcher& dispatcher_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  PrivateKeyOperationPool& pool_;
+  PrivateKeyOperationSharedPtr operation_;
+};
+
+/**
+ * Runs the private key operations of TLS handshakes on a dedicated pool of threads instead of
+ * the worker threads.
+ */
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override;
+
+  // An SSL object may use an RSA and an ECDSA certificate at the same time, so their connection
+  // state is kept apart.
+  static int rsaConnectionIndex();
+  static int ecdsaConnectionIndex();
+
+private:
+  int connectionIndex() const {
+    return EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA ? rsaConnectionIndex()
+                                                    : ecdsaConnectionIndex();
+  }
+
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  ThreadPoolPrivateKeyStats stats_;
+  // Destroyed first, so that the pool threads are joined before the stats go away.
+  std::unique_ptr<PrivateKeyOperationPool> pool_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
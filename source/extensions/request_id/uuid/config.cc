@@ -1,5 +1,7 @@
 #include "source/extensions/request_id/uuid/config.h"
 
+#include <cstring>
+
 #include "envoy/http/header_map.h"
 #include "envoy/tracing/http_tracer.h"
 
@@ -42,13 +44,17 @@ UUIDRequestIDExtension::getInteger(const Http::RequestHeaderMap& request_headers
   if (request_headers.RequestId() == nullptr) {
     return absl::nullopt;
   }
-  const std::string uuid(request_headers.getRequestIdValue());
+  const absl::string_view uuid = request_headers.getRequestIdValue();
   if (uuid.length() < 8) {
     return absl::nullopt;
   }
 
+  // atoull() needs a nul-terminated string, so copy the first 8 hex digits to the stack.
+  char prefix[9];
+  memcpy(prefix, uuid.data(), 8);
+  prefix[8] = '\0';
   uint64_t value;
-  if (!StringUtil::atoull(uuid.substr(0, 8).c_str(), value, 16)) {
+  if (!StringUtil::atoull(prefix, value, 16)) {
     return absl::nullopt;
   }
 
@@ -86,24 +92,30 @@ void UUIDRequestIDExtension::setTraceReason(Http::RequestHeaderMap& request_head
   if (uuid_view.length() != Random::RandomGeneratorImpl::UUID_LENGTH) {
     return;
   }
-  std::string uuid(uuid_view);
 
+  char trace_byte;
   switch (reason) {
   case Tracing::Reason::ServiceForced:
-    uuid[TRACE_BYTE_POSITION] = TRACE_FORCED;
+    trace_byte = TRACE_FORCED;
     break;
   case Tracing::Reason::ClientForced:
-    uuid[TRACE_BYTE_POSITION] = TRACE_CLIENT;
+    trace_byte = TRACE_CLIENT;
     break;
   case Tracing::Reason::Sampling:
-    uuid[TRACE_BYTE_POSITION] = TRACE_SAMPLED;
+    trace_byte = TRACE_SAMPLED;
     break;
   case Tracing::Reason::NotTraceable:
-    uuid[TRACE_BYTE_POSITION] = NO_TRACE;
+    trace_byte = NO_TRACE;
     break;
   default:
-    break;
+    return;
   }
+  // Generated UUIDs already carry NO_TRACE, so most requests don't need the header rewritten.
+  if (uuid_view[TRACE_BYTE_POSITION] == trace_byte) {
+    return;
+  }
+  std::string uuid(uuid_view);
+  uuid[TRACE_BYTE_POSITION] = trace_byte;
   request_headers.setRequestId(uuid);
 }
 
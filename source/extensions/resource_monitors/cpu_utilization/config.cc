@@ -0,0 +1,62 @@
+#include "source/extensions/resource_monitors/cpu_utilization/config.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+#include "envoy/extensions/resource_monitors/cpu_utilization/v3/cpu_utilization.pb.h"
+#include "envoy/extensions/resource_monitors/cpu_utilization/v3/cpu_utilization.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_stats_reader.h"
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_utilization_monitor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+namespace {
+
+uint64_t clockTicksPerSecond() {
+#ifndef WIN32
+  const long ticks = sysconf(_SC_CLK_TCK);
+  if (ticks > 0) {
+    return ticks;
+  }
+#endif
+  // The value on every Linux architecture Envoy builds for.
+  return 100;
+}
+
+} // namespace
+
+Server::ResourceMonitorPtr CpuUtilizationMonitorFactory::createResourceMonitorFromProtoTyped(
+    const envoy::extensions::resource_monitors::cpu_utilization::v3::CpuUtilizationConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  const uint32_t host_cpus = std::max(1U, std::thread::hardware_concurrency());
+  CpuStatsReaderPtr reader;
+  switch (config.source()) {
+    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
+  case envoy::extensions::resource_monitors::cpu_utilization::v3::CpuUtilizationConfig::PROCESS:
+    reader = std::make_unique<ProcessCpuStatsReader>(context.api().fileSystem(), host_cpus,
+                                                     clockTicksPerSecond());
+    break;
+  case envoy::extensions::resource_monitors::cpu_utilization::v3::CpuUtilizationConfig::CGROUP:
+    reader = std::make_unique<CgroupCpuStatsReader>(context.api().fileSystem(), host_cpus);
+    break;
+  }
+  return std::make_unique<CpuUtilizationMonitor>(context.api().timeSource(), std::move(reader));
+}
+
+/**
+ * Static registration for the CPU utilization resource monitor factory. @see RegistryFactory.
+ */
+REGISTER_FACTORY(CpuUtilizationMonitorFactory, Server::Configuration::ResourceMonitorFactory);
+
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
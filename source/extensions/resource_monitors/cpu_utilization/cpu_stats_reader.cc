@@ -0,0 +1,90 @@
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_stats_reader.h"
+
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+namespace {
+
+constexpr absl::string_view ProcessStatPath = "/proc/self/stat";
+constexpr absl::string_view CgroupCpuStatPath = "/sys/fs/cgroup/cpu.stat";
+constexpr absl::string_view CgroupCpuMaxPath = "/sys/fs/cgroup/cpu.max";
+
+uint64_t parseUint64(absl::string_view value, absl::string_view path) {
+  uint64_t parsed;
+  if (!absl::SimpleAtoi(value, &parsed)) {
+    throw EnvoyException(absl::StrCat("failed to parse CPU time in ", path));
+  }
+  return parsed;
+}
+
+} // namespace
+
+ProcessCpuStatsReader::ProcessCpuStatsReader(Filesystem::Instance& file_system,
+                                             uint32_t host_cpus, uint64_t clock_ticks_per_second)
+    : file_system_(file_system), host_cpus_(host_cpus),
+      clock_ticks_per_second_(clock_ticks_per_second) {}
+
+CpuTimes ProcessCpuStatsReader::read() {
+  const std::string contents = file_system_.fileReadToEnd(std::string(ProcessStatPath));
+  // The command name in the second field is in parentheses and may contain spaces, so the fields
+  // are counted from the last closing parenthesis. utime and stime are the 14th and 15th fields.
+  const size_t end_of_command = contents.rfind(')');
+  if (end_of_command == std::string::npos) {
+    throw EnvoyException(absl::StrCat("failed to parse ", ProcessStatPath));
+  }
+  const std::vector<absl::string_view> fields = absl::StrSplit(
+      absl::string_view(contents).substr(end_of_command + 1), ' ', absl::SkipEmpty());
+  // The fields after the command start with the 3rd one.
+  if (fields.size() < 13) {
+    throw EnvoyException(absl::StrCat("failed to parse ", ProcessStatPath));
+  }
+  const uint64_t ticks =
+      parseUint64(fields[11], ProcessStatPath) + parseUint64(fields[12], ProcessStatPath);
+  return {ticks * 1000000 / clock_ticks_per_second_, static_cast<double>(host_cpus_)};
+}
+
+CgroupCpuStatsReader::CgroupCpuStatsReader(Filesystem::Instance& file_system, uint32_t host_cpus)
+    : file_system_(file_system), host_cpus_(host_cpus) {}
+
+CpuTimes CgroupCpuStatsReader::read() {
+  absl::optional<uint64_t> used_us;
+  for (absl::string_view line :
+       absl::StrSplit(file_system_.fileReadToEnd(std::string(CgroupCpuStatPath)), '\n')) {
+    if (absl::ConsumePrefix(&line, "usage_usec ")) {
+      used_us = parseUint64(line, CgroupCpuStatPath);
+      break;
+    }
+  }
+  if (!used_us.has_value()) {
+    throw EnvoyException(absl::StrCat("no usage_usec in ", CgroupCpuStatPath));
+  }
+
+  // cpu.max is "<quota> <period>", with a quota of "max" if there is none.
+  double cpus = host_cpus_;
+  const std::vector<absl::string_view> max = absl::StrSplit(
+      absl::StripAsciiWhitespace(file_system_.fileReadToEnd(std::string(CgroupCpuMaxPath))), ' ');
+  if (max.size() == 2 && max[0] != "max") {
+    const uint64_t period = parseUint64(max[1], CgroupCpuMaxPath);
+    if (period > 0) {
+      cpus = static_cast<double>(parseUint64(max[0], CgroupCpuMaxPath)) / period;
+    }
+  }
+  return {used_us.value(), cpus};
+}
+
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
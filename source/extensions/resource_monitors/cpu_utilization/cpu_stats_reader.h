@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/pure.h"
+#include "envoy/filesystem/filesystem.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+
+/**
+ * The CPU time used so far, and the number of CPUs it can be used on.
+ */
+struct CpuTimes {
+  uint64_t used_us_;
+  double cpus_;
+};
+
+/**
+ * Reads the CPU time used so far. Reading throws an EnvoyException on failure.
+ */
+class CpuStatsReader {
+public:
+  virtual ~CpuStatsReader() = default;
+
+  virtual CpuTimes read() PURE;
+};
+
+using CpuStatsReaderPtr = std::unique_ptr<CpuStatsReader>;
+
+/**
+ * Reads the CPU time of the Envoy process from /proc/self/stat.
+ */
+class ProcessCpuStatsReader : public CpuStatsReader {
+public:
+  ProcessCpuStatsReader(Filesystem::Instance& file_system, uint32_t host_cpus,
+                        uint64_t clock_ticks_per_second);
+
+  // CpuStatsReader
+  CpuTimes read() override;
+
+private:
+  Filesystem::Instance& file_system_;
+  const uint32_t host_cpus_;
+  const uint64_t clock_ticks_per_second_;
+};
+
+/**
+ * Reads the CPU time of the cgroup v2 of Envoy from /sys/fs/cgroup/cpu.stat, and its quota from
+ * /sys/fs/cgroup/cpu.max.
+ */
+class CgroupCpuStatsReader : public CpuStatsReader {
+public:
+  CgroupCpuStatsReader(Filesystem::Instance& file_system, uint32_t host_cpus);
+
+  // CpuStatsReader
+  CpuTimes read() override;
+
+private:
+  Filesystem::Instance& file_system_;
+  const uint32_t host_cpus_;
+};
+
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
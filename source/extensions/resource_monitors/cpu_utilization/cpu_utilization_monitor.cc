@@ -0,0 +1,49 @@
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_utilization_monitor.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+
+CpuUtilizationMonitor::CpuUtilizationMonitor(TimeSource& time_source, CpuStatsReaderPtr reader)
+    : time_source_(time_source), reader_(std::move(reader)) {}
+
+void CpuUtilizationMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  CpuTimes times;
+  TRY_ASSERT_MAIN_THREAD { times = reader_->read(); }
+  END_TRY
+  catch (const EnvoyException& error) {
+    callbacks.onFailure(error);
+    return;
+  }
+  const Sample sample{time_source_.monotonicTime(), times.used_us_};
+
+  Server::ResourceUsage usage;
+  usage.resource_pressure_ = 0;
+  if (previous_.has_value() && sample.time_ > previous_->time_ && times.cpus_ > 0) {
+    const double elapsed_us =
+        std::chrono::duration<double, std::micro>(sample.time_ - previous_->time_).count();
+    // The used time only goes down if the cgroup or process was replaced, which counts as idle.
+    const double used_us =
+        sample.used_us_ > previous_->used_us_ ? sample.used_us_ - previous_->used_us_ : 0;
+    usage.resource_pressure_ = std::min(used_us / (elapsed_us * times.cpus_), 1.0);
+  }
+  previous_ = sample;
+
+  ENVOY_LOG_MISC(trace, "CpuUtilizationMonitor: used_us={}, cpus={}, pressure={}", times.used_us_,
+                 times.cpus_, usage.resource_pressure_);
+  callbacks.onSuccess(usage);
+}
+
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/resource_monitors/cpu_utilization/v3/cpu_utilization.pb.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_stats_reader.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+
+/**
+ * CPU utilization monitor, reporting the fraction of the available CPU time used since the
+ * previous update.
+ */
+class CpuUtilizationMonitor : public Server::ResourceMonitor {
+public:
+  CpuUtilizationMonitor(TimeSource& time_source, CpuStatsReaderPtr reader);
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+private:
+  struct Sample {
+    MonotonicTime time_;
+    uint64_t used_us_;
+  };
+
+  TimeSource& time_source_;
+  const CpuStatsReaderPtr reader_;
+  absl::optional<Sample> previous_;
+};
+
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -47,10 +47,11 @@ void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
-                             const Statsd::TagFormat& tag_format)
+                             const Statsd::TagFormat& tag_format, bool delta_snapshots)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      delta_snapshots_(delta_snapshots) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
@@ -59,23 +60,72 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   Writer& writer = tls_->getTyped<Writer>();
   Buffer::OwnedImpl buffer;
+  ++flush_count_;
+  // Reused for every line to avoid an allocation per metric.
+  std::string line;
 
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+      const CachedLine& cached = cachedLine(counter_lines_, counter.counter_.get(), "|c");
+      line.assign(cached.before_value_);
+      absl::StrAppend(&line, counter.delta_, cached.after_value_);
+      writeBuffer(buffer, writer, line);
     }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+      const CachedLine& cached = cachedLine(gauge_lines_, gauge.get(), "|g");
+      line.assign(cached.before_value_);
+      absl::StrAppend(&line, gauge.get().value(), cached.after_value_);
+      writeBuffer(buffer, writer, line);
     }
   }
 
   flushBuffer(buffer, writer);
   // TODO(efimki): Add support of text readouts stats.
+
+  if (flush_count_ % MaxIdleFlushes == 0) {
+    evictIdleLines(counter_lines_);
+    evictIdleLines(gauge_lines_);
+  }
+}
+
+const UdpStatsdSink::CachedLine&
+UdpStatsdSink::cachedLine(CachedLineMap& lines, const Stats::Metric& metric,
+                          absl::string_view type) {
+  auto it = lines.find(metric.statName());
+  if (it == lines.end()) {
+    // Only the reference counts of the symbols are updated, the metric itself is not modified.
+    auto cached = std::make_unique<CachedLine>(metric.statName(),
+                                               const_cast<Stats::Metric&>(metric).symbolTable());
+    const std::string name = absl::StrCat(prefix_, ".", getName(metric));
+    const std::string tags = buildTagStr(metric.tags());
+    switch (tag_format_.tag_position) {
+    case Statsd::TagPosition::TagAfterValue:
+      cached->before_value_ = absl::StrCat(name, ":");
+      cached->after_value_ = absl::StrCat(type, tags);
+      break;
+    case Statsd::TagPosition::TagAfterName:
+      cached->before_value_ = absl::StrCat(name, tags, ":");
+      cached->after_value_ = std::string(type);
+      break;
+    }
+    const Stats::StatName key = cached->stat_name_.statName();
+    it = lines.emplace(key, std::move(cached)).first;
+  }
+  it->second->last_flush_ = flush_count_;
+  return *it->second;
+}
+
+void UdpStatsdSink::evictIdleLines(CachedLineMap& lines) {
+  for (auto it = lines.begin(); it != lines.end();) {
+    if (flush_count_ - it->second->last_flush_ >= MaxIdleFlushes) {
+      lines.erase(it++);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
@@ -179,8 +229,9 @@ const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
                              const std::string& cluster_name, ThreadLocal::SlotAllocator& tls,
                              Upstream::ClusterManager& cluster_manager, Stats::Scope& scope,
-                             const std::string& prefix)
-    : prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix), tls_(tls.allocateSlot()),
+                             const std::string& prefix, bool delta_snapshots)
+    : prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
+      delta_snapshots_(delta_snapshots), tls_(tls.allocateSlot()),
       cluster_manager_(cluster_manager),
       cx_overflow_stat_(scope.counterFromStatName(
           Stats::StatNameManagedStorage("statsd.cx_overflow", scope.symbolTable()).statName())) {
@@ -15,6 +15,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/macros.h"
 #include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
 #include "absl/types/optional.h"
@@ -44,15 +45,18 @@ public:
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat());
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool delta_snapshots = false);
   // For testing.
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool delta_snapshots = false)
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+        delta_snapshots_(delta_snapshots) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -60,6 +64,11 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  bool deltaSnapshots() const override { return delta_snapshots_; }
+
+  // Lines are swept every this many flushes, evicting those of metrics that were not flushed since
+  // the previous sweep. Delta snapshots skip unchanged metrics, so idle lines are kept for a while.
+  static constexpr uint64_t MaxIdleFlushes = 60;
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
@@ -82,8 +91,26 @@ private:
     const Network::IoHandlePtr io_handle_;
   };
 
+  // The text around the value of a flushed metric line. It only depends on the metric, and is
+  // cached per metric since building it requires decoding the metric name and tags.
+  struct CachedLine {
+    CachedLine(Stats::StatName stat_name, Stats::SymbolTable& symbol_table)
+        : stat_name_(stat_name, symbol_table) {}
+
+    // Holds references to the symbols of the name, so the key can't change meaning.
+    Stats::StatNameManagedStorage stat_name_;
+    std::string before_value_;
+    std::string after_value_;
+    uint64_t last_flush_{};
+  };
+  using CachedLinePtr = std::unique_ptr<CachedLine>;
+  using CachedLineMap = Stats::StatNameHashMap<CachedLinePtr>;
+
   void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
   void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
+  const CachedLine& cachedLine(CachedLineMap& lines, const Stats::Metric& metric,
+                               absl::string_view type);
+  void evictIdleLines(CachedLineMap& lines);
 
   template <typename ValueType>
   const std::string buildMessage(const Stats::Metric& metric, ValueType value,
@@ -98,6 +125,11 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  const bool delta_snapshots_;
+  // Only accessed from flush(), which runs on the main thread.
+  CachedLineMap counter_lines_;
+  CachedLineMap gauge_lines_;
+  uint64_t flush_count_{};
 };
 
 /**
@@ -107,11 +139,13 @@ class TcpStatsdSink : public Stats::Sink {
 public:
   TcpStatsdSink(const LocalInfo::LocalInfo& local_info, const std::string& cluster_name,
                 ThreadLocal::SlotAllocator& tls, Upstream::ClusterManager& cluster_manager,
-                Stats::Scope& scope, const std::string& prefix = getDefaultPrefix());
+                Stats::Scope& scope, const std::string& prefix = getDefaultPrefix(),
+                bool delta_snapshots = false);
 
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  bool deltaSnapshots() const override { return delta_snapshots_; }
 
   const std::string& getPrefix() { return prefix_; }
 
@@ -151,6 +185,7 @@ private:
 
   // Prefix for all flushed stats.
   const std::string prefix_;
+  const bool delta_snapshots_;
 
   Upstream::ClusterInfoConstSharedPtr cluster_info_;
   ThreadLocal::SlotPtr tls_;
@@ -118,24 +118,28 @@ template <class RequestProto, class ResponseProto> class MetricsServiceSink : pu
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels)
+      bool report_counters_as_deltas, bool emit_labels, bool delta_snapshots = false)
       : MetricsServiceSink(grpc_metrics_streamer,
-                           MetricsFlusher(report_counters_as_deltas, emit_labels)) {}
+                           MetricsFlusher(report_counters_as_deltas, emit_labels),
+                           delta_snapshots) {}
 
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      MetricsFlusher&& flusher)
-      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)) {}
+      MetricsFlusher&& flusher, bool delta_snapshots = false)
+      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)),
+        delta_snapshots_(delta_snapshots) {}
 
   // MetricsService::Sink
   void flush(Stats::MetricSnapshot& snapshot) override {
     grpc_metrics_streamer_->send(flusher_.flush(snapshot));
   }
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool deltaSnapshots() const override { return delta_snapshots_; }
 
 private:
   const MetricsFlusher flusher_;
   GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto> grpc_metrics_streamer_;
+  const bool delta_snapshots_;
 };
 
 } // namespace MetricsService
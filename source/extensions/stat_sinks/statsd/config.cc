@@ -26,14 +26,20 @@ StatsdSinkFactory::createStatsSink(const Protobuf::Message& config,
     Network::Address::InstanceConstSharedPtr address =
         Network::Address::resolveProtoAddress(statsd_sink.address());
     ENVOY_LOG(debug, "statsd UDP ip address: {}", address->asString());
-    return std::make_unique<Common::Statsd::UdpStatsdSink>(server.threadLocal(), std::move(address),
-                                                           false, statsd_sink.prefix());
+    absl::optional<uint64_t> max_bytes;
+    if (statsd_sink.has_max_bytes_per_datagram()) {
+      max_bytes = statsd_sink.max_bytes_per_datagram().value();
+    }
+    return std::make_unique<Common::Statsd::UdpStatsdSink>(
+        server.threadLocal(), std::move(address), false, statsd_sink.prefix(), max_bytes,
+        Common::Statsd::getDefaultTagFormat(), statsd_sink.emit_changed_metrics_only());
   }
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::kTcpClusterName:
     ENVOY_LOG(debug, "statsd TCP cluster: {}", statsd_sink.tcp_cluster_name());
     return std::make_unique<Common::Statsd::TcpStatsdSink>(
         server.localInfo(), statsd_sink.tcp_cluster_name(), server.threadLocal(),
-        server.clusterManager(), server.scope(), statsd_sink.prefix());
+        server.clusterManager(), server.scope(), statsd_sink.prefix(),
+        statsd_sink.emit_changed_metrics_only());
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::STATSD_SPECIFIER_NOT_SET:
     break; // Fall through to PANIC
   }
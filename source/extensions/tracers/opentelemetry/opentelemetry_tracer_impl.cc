@@ -39,7 +39,8 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
     }
     TracerPtr tracer = std::make_unique<Tracer>(
         std::move(exporter), factory_context.timeSource(), factory_context.api().randomGenerator(),
-        factory_context.runtime(), dispatcher, tracing_stats_, opentelemetry_config.service_name());
+        factory_context.runtime(), dispatcher, tracing_stats_, opentelemetry_config.service_name(),
+        opentelemetry_config.tail_sampling());
 
     return std::make_shared<TlsTracer>(std::move(tracer));
   });
@@ -7,6 +7,8 @@
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/tracing/common_values.h"
 
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
 #include "opentelemetry/proto/trace/v1/trace.pb.h"
@@ -48,7 +50,8 @@ void Span::finishSpan() {
   // Call into the parent tracer so we can access the shared exporter.
   span_.set_end_time_unix_nano(
       std::chrono::nanoseconds(time_source_.systemTime().time_since_epoch()).count());
-  if (sampled()) {
+  if (sampled() || parent_tracer_.tailSample(span_)) {
+    // The span is done with once finished, so its proto is moved to the buffer of the tracer.
     parent_tracer_.sendSpan(span_);
   }
 }
@@ -81,22 +84,24 @@ void Span::setTag(absl::string_view name, absl::string_view value) {
     }
   }
   // If we haven't found an existing match already, we can add a new key/value.
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  value_proto.set_string_value(std::string{value});
-  key_value.set_key(std::string{name});
-  *key_value.mutable_value() = value_proto;
-  *span_.add_attributes() = key_value;
+  opentelemetry::proto::common::v1::KeyValue* key_value = span_.add_attributes();
+  key_value->set_key(std::string{name});
+  key_value->mutable_value()->set_string_value(std::string{value});
 }
 
 Tracer::Tracer(OpenTelemetryGrpcTraceExporterPtr exporter, Envoy::TimeSource& time_source,
                Random::RandomGenerator& random, Runtime::Loader& runtime,
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
-               const std::string& service_name)
+               const std::string& service_name,
+               const envoy::config::trace::v3::OpenTelemetryConfig::TailSampling& tail_sampling)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
-      tracing_stats_(tracing_stats), service_name_(service_name) {
+      tracing_stats_(tracing_stats), service_name_(service_name),
+      tail_sample_errors_(tail_sampling.errors()),
+      tail_sample_min_duration_(
+          tail_sampling.has_min_duration()
+              ? absl::make_optional<std::chrono::nanoseconds>(std::chrono::milliseconds(
+                    DurationUtil::durationToMilliseconds(tail_sampling.min_duration())))
+              : absl::nullopt) {
   if (service_name.empty()) {
     service_name_ = std::string{kDefaultServiceName};
   }
@@ -127,11 +132,12 @@ void Tracer::flushSpans() {
   *key_value.mutable_value() = value_proto;
   (*resource_span->mutable_resource()->add_attributes()) = key_value;
   ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
+  const int num_spans = span_buffer_.size();
+  // Hand the buffered spans over to the request rather than copying them, which also empties the
+  // buffer.
+  scope_span->mutable_spans()->Swap(&span_buffer_);
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
+    tracing_stats_.spans_sent_.add(num_spans);
     if (!exporter_->log(request)) {
       // TODO: should there be any sort of retry or reporting here?
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
@@ -139,11 +145,10 @@ void Tracer::flushSpans() {
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
 }
 
 void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  span_buffer_.push_back(span);
+  *span_buffer_.Add() = std::move(span);
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
   if (span_buffer_.size() >= min_flush_spans) {
@@ -151,39 +156,59 @@ void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
   }
 }
 
+bool Tracer::tailSample(const ::opentelemetry::proto::trace::v1::Span& span) {
+  bool keep = false;
+  if (tail_sample_errors_) {
+    for (const auto& key_value : span.attributes()) {
+      if (key_value.key() == Tracing::Tags::get().Error) {
+        keep = key_value.value().string_value() == Tracing::Tags::get().True;
+        break;
+      }
+    }
+  }
+  if (!keep && tail_sample_min_duration_.has_value()) {
+    keep = span.end_time_unix_nano() - span.start_time_unix_nano() >=
+           static_cast<uint64_t>(tail_sample_min_duration_->count());
+  }
+  if (keep) {
+    tracing_stats_.spans_tail_sampled_.inc();
+  }
+  return keep;
+}
+
 Tracing::SpanPtr Tracer::startSpan(const Tracing::Config& config, const std::string& operation_name,
                                    SystemTime start_time,
                                    const Tracing::Decision tracing_decision) {
   // Create an Tracers::OpenTelemetry::Span class that will contain the OTel span.
-  Span new_span = Span(config, operation_name, start_time, time_source_, *this);
-  new_span.setSampled(tracing_decision.traced);
+  auto new_span = std::make_unique<Span>(config, operation_name, start_time, time_source_, *this);
+  new_span->setSampled(tracing_decision.traced);
   uint64_t trace_id_high = random_.random();
   uint64_t trace_id = random_.random();
-  new_span.setTraceId(absl::StrCat(Hex::uint64ToHex(trace_id_high), Hex::uint64ToHex(trace_id)));
+  new_span->setTraceId(absl::StrCat(Hex::uint64ToHex(trace_id_high), Hex::uint64ToHex(trace_id)));
   uint64_t span_id = random_.random();
-  new_span.setId(Hex::uint64ToHex(span_id));
-  return std::make_unique<Span>(new_span);
+  new_span->setId(Hex::uint64ToHex(span_id));
+  return new_span;
 }
 
 Tracing::SpanPtr Tracer::startSpan(const Tracing::Config& config, const std::string& operation_name,
                                    SystemTime start_time,
                                    const SpanContext& previous_span_context) {
   // Create a new span and populate details from the span context.
-  Span new_span = Span(config, operation_name, start_time, time_source_, *this);
-  new_span.setSampled(previous_span_context.sampled());
-  new_span.setTraceId(previous_span_context.traceId());
+  auto new_span = std::make_unique<Span>(config, operation_name, start_time, time_source_, *this);
+  new_span->setSampled(previous_span_context.sampled());
+  new_span->setTraceId(previous_span_context.traceId());
   if (!previous_span_context.parentId().empty()) {
-    new_span.setParentId(previous_span_context.parentId());
+    new_span->setParentId(previous_span_context.parentId());
   }
   // Generate a new identifier for the span id.
   uint64_t span_id = random_.random();
-  new_span.setId(Hex::uint64ToHex(span_id));
+  new_span->setId(Hex::uint64ToHex(span_id));
   // Respect the previous span's sampled flag.
-  new_span.setSampled(previous_span_context.sampled());
+  new_span->setSampled(previous_span_context.sampled());
   if (!previous_span_context.tracestate().empty()) {
-    new_span.setTracestate(std::string{previous_span_context.tracestate()});
+    new_span->setTracestate(std::string{previous_span_context.tracestate()});
   }
-  return std::make_unique<Span>(new_span);
+  return new_span;
 }
 
 } // namespace OpenTelemetry
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
 #include "envoy/api/api.h"
@@ -9,10 +10,12 @@
 #include "envoy/tracing/trace_driver.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/extensions/tracers/common/factory_base.h"
 #include "source/extensions/tracers/opentelemetry/grpc_trace_exporter.h"
 
 #include "absl/strings/escaping.h"
+#include "absl/types/optional.h"
 #include "span_context.h"
 
 namespace Envoy {
@@ -22,6 +25,7 @@ namespace OpenTelemetry {
 
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
   COUNTER(spans_sent)                                                                              \
+  COUNTER(spans_tail_sampled)                                                                      \
   COUNTER(timer_flushed)
 
 struct OpenTelemetryTracerStats {
@@ -35,10 +39,21 @@ class Tracer : Logger::Loggable<Logger::Id::tracing> {
 public:
   Tracer(OpenTelemetryGrpcTraceExporterPtr exporter, Envoy::TimeSource& time_source,
          Random::RandomGenerator& random, Runtime::Loader& runtime, Event::Dispatcher& dispatcher,
-         OpenTelemetryTracerStats tracing_stats, const std::string& service_name);
+         OpenTelemetryTracerStats tracing_stats, const std::string& service_name,
+         const envoy::config::trace::v3::OpenTelemetryConfig::TailSampling& tail_sampling =
+             envoy::config::trace::v3::OpenTelemetryConfig::TailSampling());
 
+  /**
+   * Buffers a finished span for export, moving it out of the passed span.
+   */
   void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
 
+  /**
+   * @return whether a finished span which was not sampled matches the tail sampling policy, and so
+   * should be exported anyway.
+   */
+  bool tailSample(const ::opentelemetry::proto::trace::v1::Span& span);
+
   Tracing::SpanPtr startSpan(const Tracing::Config& config, const std::string& operation_name,
                              SystemTime start_time, const Tracing::Decision tracing_decision);
 
@@ -58,11 +73,13 @@ private:
   OpenTelemetryGrpcTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  Protobuf::RepeatedPtrField<::opentelemetry::proto::trace::v1::Span> span_buffer_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
   std::string service_name_;
+  const bool tail_sample_errors_;
+  const absl::optional<std::chrono::nanoseconds> tail_sample_min_duration_;
 };
 
 /**
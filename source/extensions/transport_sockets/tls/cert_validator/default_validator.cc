@@ -15,6 +15,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/base64.h"
+#include "source/common/common/empty_string.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/hex.h"
 #include "source/common/common/matchers.h"
@@ -48,6 +49,7 @@ DefaultCertValidator::DefaultCertValidator(
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
                                        CertificateValidationContext::ACCEPT_UNTRUSTED;
+    verification_cache_ttl_ = config_->trustChainVerificationCacheTtl();
   }
 };
 
@@ -198,7 +200,15 @@ int DefaultCertValidator::doSynchronousVerifyCertChain(
     X509_STORE_CTX* store_ctx, Ssl::SslExtendedSocketInfo* ssl_extended_info, X509& leaf_cert,
     const Network::TransportSocketOptions* transport_socket_options) {
   if (verify_trusted_ca_) {
-    int ret = X509_verify_cert(store_ctx);
+    STACK_OF(X509)* cert_chain = X509_STORE_CTX_get0_untrusted(store_ctx);
+    const std::string cache_key = verification_cache_ttl_.has_value()
+                                      ? verificationCacheKey(leaf_cert, cert_chain)
+                                      : EMPTY_STRING;
+    const bool cached = !cache_key.empty() && chainVerificationCached(cache_key);
+    int ret = cached ? 1 : X509_verify_cert(store_ctx);
+    if (ret == 1 && !cached && !cache_key.empty()) {
+      cacheChainVerification(cache_key, leaf_cert, cert_chain);
+    }
     if (ssl_extended_info) {
       ssl_extended_info->setCertificateValidationStatus(
           ret == 1 ? Envoy::Ssl::ClientValidationStatus::Validated
@@ -252,6 +262,70 @@ bool DefaultCertValidator::verifyCertAndUpdateStatus(
   return (allow_untrusted_certificate_ || success);
 }
 
+std::string DefaultCertValidator::verificationCacheKey(X509& leaf_cert,
+                                                       STACK_OF(X509)* cert_chain) {
+  std::string key;
+  auto append_fingerprint = [&key](X509* cert) {
+    uint8_t fingerprint[SHA256_DIGEST_LENGTH];
+    unsigned int fingerprint_len;
+    RELEASE_ASSERT(X509_digest(cert, EVP_sha256(), fingerprint, &fingerprint_len) == 1,
+                   Utility::getLastCryptoError().value_or(""));
+    key.append(reinterpret_cast<const char*>(fingerprint), fingerprint_len);
+  };
+  append_fingerprint(&leaf_cert);
+  if (cert_chain != nullptr) {
+    for (size_t i = 0; i < sk_X509_num(cert_chain); i++) {
+      append_fingerprint(sk_X509_value(cert_chain, i));
+    }
+  }
+  return key;
+}
+
+bool DefaultCertValidator::chainVerificationCached(const std::string& key) {
+  const SystemTime now = time_source_.systemTime();
+  {
+    absl::ReaderMutexLock lock(&verification_cache_mutex_);
+    auto it = verification_cache_.find(key);
+    if (it == verification_cache_.end()) {
+      return false;
+    }
+    if (it->second > now) {
+      return true;
+    }
+  }
+  absl::WriterMutexLock lock(&verification_cache_mutex_);
+  auto it = verification_cache_.find(key);
+  if (it != verification_cache_.end() && it->second <= now) {
+    verification_cache_.erase(it);
+  }
+  return false;
+}
+
+void DefaultCertValidator::cacheChainVerification(const std::string& key, X509& leaf_cert,
+                                                  STACK_OF(X509)* cert_chain) {
+  const SystemTime now = time_source_.systemTime();
+  // A verification cannot be reused once any certificate in the chain expired.
+  SystemTime expiration = now + verification_cache_ttl_.value();
+  expiration = std::min(expiration, Utility::getExpirationTime(leaf_cert));
+  if (cert_chain != nullptr) {
+    for (size_t i = 0; i < sk_X509_num(cert_chain); i++) {
+      expiration = std::min(expiration, Utility::getExpirationTime(*sk_X509_value(cert_chain, i)));
+    }
+  }
+  if (expiration <= now) {
+    return;
+  }
+
+  absl::WriterMutexLock lock(&verification_cache_mutex_);
+  if (verification_cache_.size() >= MaxVerificationCacheEntries) {
+    absl::erase_if(verification_cache_, [now](const auto& entry) { return entry.second <= now; });
+    if (verification_cache_.size() >= MaxVerificationCacheEntries) {
+      verification_cache_.clear();
+    }
+  }
+  verification_cache_[key] = expiration;
+}
+
 Envoy::Ssl::ClientValidationStatus
 DefaultCertValidator::verifyCertificate(X509* cert, const std::vector<std::string>& verify_san_list,
                                         const std::vector<SanMatcherPtr>& subject_alt_name_matchers,
@@ -326,7 +400,12 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
       Envoy::Ssl::ClientValidationStatus::NotValidated;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
   ASSERT(leaf_cert);
-  if (verify_trusted_ca_) {
+  const std::string cache_key = verify_trusted_ca_ && verification_cache_ttl_.has_value()
+                                    ? verificationCacheKey(*leaf_cert, &cert_chain)
+                                    : EMPTY_STRING;
+  if (!cache_key.empty() && chainVerificationCached(cache_key)) {
+    detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+  } else if (verify_trusted_ca_) {
     X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
     ASSERT(verify_store);
     bssl::UniquePtr<X509_STORE_CTX> ctx(X509_STORE_CTX_new());
@@ -362,6 +441,9 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
               SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx.get())), error};
     }
     detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+    if (!cache_key.empty()) {
+      cacheChainVerification(cache_key, *leaf_cert, &cert_chain);
+    }
   }
   std::string error_details;
   uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
@@ -23,6 +23,7 @@
 #include "source/extensions/transport_sockets/tls/cert_validator/san_matcher.h"
 #include "source/extensions/transport_sockets/tls/stats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -112,6 +113,15 @@ private:
                                  Envoy::Ssl::ClientValidationStatus& detailed_status,
                                  std::string* error_details, uint8_t* out_alert);
 
+  // Trust chain verification cache. Keys are the SHA-256 fingerprints of the presented
+  // certificates, in order.
+  static std::string verificationCacheKey(X509& leaf_cert, STACK_OF(X509)* cert_chain);
+  bool chainVerificationCached(const std::string& key);
+  void cacheChainVerification(const std::string& key, X509& leaf_cert, STACK_OF(X509)* cert_chain);
+
+  // Bounds the memory used by the cache, which is flushed when full.
+  static constexpr size_t MaxVerificationCacheEntries = 4096;
+
   const Envoy::Ssl::CertificateValidationContextConfig* config_;
   SslStats& stats_;
   TimeSource& time_source_;
@@ -123,6 +133,11 @@ private:
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
   std::vector<std::vector<uint8_t>> verify_certificate_spki_list_;
   bool verify_trusted_ca_{false};
+  absl::optional<std::chrono::milliseconds> verification_cache_ttl_;
+  absl::Mutex verification_cache_mutex_;
+  // The time at which each cached verification expires.
+  absl::flat_hash_map<std::string, SystemTime>
+      verification_cache_ ABSL_GUARDED_BY(verification_cache_mutex_);
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
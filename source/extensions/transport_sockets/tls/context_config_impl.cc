@@ -8,6 +8,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/config/datasource.h"
+#include "source/common/config/utility.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/secret/sds_api.h"
@@ -166,6 +167,23 @@ bool getStatelessSessionResumptionDisabled(
   }
 }
 
+bool getLazyContextInitialization(
+    const envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext& config) {
+  using envoy::extensions::transport_sockets::tls::v3::CommonTlsContext;
+  using envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext;
+  const CommonTlsContext& common = config.common_tls_context();
+  // Lazily built contexts read the configuration on workers, so it must not change after it has
+  // been loaded. Key logs are opened on the main thread only.
+  return config.lazy_context_initialization() &&
+         common.tls_certificate_sds_secret_configs().empty() &&
+         common.validation_context_type_case() !=
+             CommonTlsContext::kValidationContextSdsSecretConfig &&
+         common.validation_context_type_case() != CommonTlsContext::kCombinedValidationContext &&
+         config.session_ticket_keys_type_case() !=
+             DownstreamTlsContext::kSessionTicketKeysSdsSecretConfig &&
+         common.key_log().path().empty();
+}
+
 } // namespace
 
 ContextConfigImpl::ContextConfigImpl(
@@ -396,7 +414,8 @@ ServerContextConfigImpl::ServerContextConfigImpl(
       full_scan_certs_on_sni_mismatch_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           config, full_scan_certs_on_sni_mismatch,
           !Runtime::runtimeFeatureEnabled(
-              "envoy.reloadable_features.no_full_scan_certs_on_sni_mismatch"))) {
+              "envoy.reloadable_features.no_full_scan_certs_on_sni_mismatch"))),
+      lazy_context_initialization_(getLazyContextInitialization(config)) {
 
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
@@ -424,6 +443,22 @@ ServerContextConfigImpl::ServerContextConfigImpl(
     session_timeout_ =
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
+
+  if (config.has_session_cache()) {
+    auto& factory =
+        Config::Utility::getAndCheckFactory<Ssl::SessionCacheFactory>(config.session_cache());
+    ProtobufTypes::MessagePtr message = Config::Utility::translateAnyToFactoryConfig(
+        config.session_cache().typed_config(), factory_context.messageValidationVisitor(), factory);
+    session_cache_ = factory.createSessionCache(*message, factory_context);
+  }
+
+  if (config.has_dynamic_record_sizing()) {
+    const auto& sizing = config.dynamic_record_sizing();
+    dynamic_record_sizing_ = DynamicRecordSizing{
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(sizing, initial_record_size, 1400),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(sizing, initial_bytes, 128 * 1024),
+        std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(sizing, idle_timeout, 1000))};
+  }
 }
 
 void ServerContextConfigImpl::setSecretUpdateCallback(std::function<void()> callback) {
@@ -170,6 +170,11 @@ public:
   }
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
+  Ssl::SessionCacheSharedPtr sessionCache() const override { return session_cache_; }
+  bool lazyContextInitialization() const override { return lazy_context_initialization_; }
+  const absl::optional<DynamicRecordSizing>& dynamicRecordSizing() const override {
+    return dynamic_record_sizing_;
+  }
 
 private:
   static const unsigned DEFAULT_MIN_VERSION;
@@ -194,6 +199,9 @@ private:
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
   bool full_scan_certs_on_sni_mismatch_;
+  Ssl::SessionCacheSharedPtr session_cache_;
+  const bool lazy_context_initialization_;
+  absl::optional<DynamicRecordSizing> dynamic_record_sizing_;
 };
 
 } // namespace Tls
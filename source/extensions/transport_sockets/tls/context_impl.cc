@@ -778,7 +778,9 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
                                      TimeSource& time_source)
     : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()),
       ocsp_staple_policy_(config.ocspStaplePolicy()), has_rsa_(false),
-      full_scan_certs_on_sni_mismatch_(config.fullScanCertsOnSNIMismatch()) {
+      full_scan_certs_on_sni_mismatch_(config.fullScanCertsOnSNIMismatch()),
+      session_cache_(config.capabilities().handles_session_resumption ? nullptr
+                                                                       : config.sessionCache()) {
   if (config.tlsCertificates().empty() && !config.capabilities().provides_certificates) {
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
@@ -850,6 +852,29 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
           });
     }
 
+    if (session_cache_ != nullptr) {
+      // Sessions are only kept in the external cache. Lookups go through the initial context, but
+      // the callbacks are installed on all of them in case BoringSSL ever uses the selected one.
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* session_id, int session_id_len,
+             int* out_copy) -> SSL_SESSION* {
+            // The returned session is owned by BoringSSL.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->getSession(ssl, session_id, session_id_len);
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
+    }
+
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
       auto timeout = config.sessionTimeout().value().count();
       SSL_CTX_set_timeout(ctx.ssl_ctx_.get(), uint32_t(timeout));
@@ -934,6 +959,121 @@ void ServerContextImpl::populateServerNamesMap(TlsContext& ctx, int pkey_id) {
   }
 }
 
+namespace {
+
+// The state of the external session cache lookup of a handshake. It is attached to the SSL object,
+// which owns it.
+class SessionCacheLookupState : public Ssl::SessionCacheLookupCallbacks {
+public:
+  explicit SessionCacheLookupState(Network::TransportSocketCallbacks& callbacks)
+      : callbacks_(callbacks) {}
+  ~SessionCacheLookupState() override {
+    if (lookup_ != nullptr && !complete_) {
+      lookup_->cancel();
+    }
+  }
+
+  void start(Ssl::SessionCache& cache, absl::string_view session_id) {
+    lookup_ = cache.lookup(session_id, callbacks_.connection().dispatcher(), *this);
+    started_ = true;
+  }
+  bool complete() const { return complete_; }
+  absl::optional<std::string>& session() { return session_; }
+
+  // Ssl::SessionCacheLookupCallbacks
+  void onSessionCacheLookupComplete(absl::optional<std::string>&& session) override {
+    session_ = std::move(session);
+    complete_ = true;
+    if (started_) {
+      // The handshake is waiting for the lookup, ask the connection to drive it again.
+      callbacks_.setTransportSocketIsReadable();
+    }
+  }
+
+private:
+  Network::TransportSocketCallbacks& callbacks_;
+  Ssl::SessionCacheLookupPtr lookup_;
+  absl::optional<std::string> session_;
+  // Whether lookup() has returned, the callbacks may complete the lookup before.
+  bool started_{};
+  bool complete_{};
+};
+
+} // namespace
+
+int ServerContextImpl::sessionCacheLookupIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int index = SSL_get_ex_new_index(
+        0, nullptr, nullptr, nullptr,
+        [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+          delete static_cast<SessionCacheLookupState*>(ptr);
+        });
+    RELEASE_ASSERT(index >= 0, "");
+    return index;
+  }());
+}
+
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned session_id_len;
+  const uint8_t* session_id = SSL_SESSION_get_id(session, &session_id_len);
+  uint8_t* data;
+  size_t data_len;
+  if (session_id_len == 0 || !SSL_SESSION_to_bytes(session, &data, &data_len)) {
+    return 0;
+  }
+  session_cache_->insert(
+      absl::string_view(reinterpret_cast<const char*>(session_id), session_id_len),
+      absl::string_view(reinterpret_cast<const char*>(data), data_len),
+      std::chrono::seconds(SSL_SESSION_get_timeout(session)));
+  OPENSSL_free(data);
+  // BoringSSL keeps the ownership of the session.
+  return 0;
+}
+
+SSL_SESSION* ServerContextImpl::getSession(SSL* ssl, const uint8_t* session_id,
+                                           int session_id_len) {
+  auto* state =
+      static_cast<SessionCacheLookupState*>(SSL_get_ex_data(ssl, sessionCacheLookupIndex()));
+  if (state == nullptr) {
+    auto* callbacks =
+        static_cast<Network::TransportSocketCallbacks*>(SSL_get_ex_data(ssl, sslSocketIndex()));
+    if (callbacks == nullptr) {
+      return nullptr;
+    }
+    state = new SessionCacheLookupState(*callbacks);
+    SSL_set_ex_data(ssl, sessionCacheLookupIndex(), state);
+    state->start(*session_cache_,
+                 absl::string_view(reinterpret_cast<const char*>(session_id), session_id_len));
+  }
+  if (!state->complete()) {
+    // Suspends the handshake with SSL_ERROR_PENDING_SESSION until the lookup completes.
+    return SSL_magic_pending_session_ptr();
+  }
+
+  absl::optional<std::string>& session = state->session();
+  if (!session.has_value()) {
+    return nullptr;
+  }
+  // A session that fails to parse, e.g. one stored by an incompatible version, is a cache miss.
+  SSL_SESSION* parsed =
+      SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(session->data()), session->size(),
+                             SSL_get_SSL_CTX(ssl));
+  session.reset();
+  if (parsed == nullptr) {
+    ERR_clear_error();
+  }
+  return parsed;
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned session_id_len;
+  const uint8_t* session_id = SSL_SESSION_get_id(session, &session_id_len);
+  if (session_id_len > 0) {
+    session_cache_->remove(
+        absl::string_view(reinterpret_cast<const char*>(session_id), session_id_len));
+  }
+}
+
 ServerContextImpl::SessionContextID
 ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string>& server_names) {
   uint8_t hash_buffer[EVP_MAX_MD_SIZE];
@@ -213,6 +213,10 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  int newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(SSL* ssl, const uint8_t* session_id, int session_id_len);
+  void removeSession(SSL_SESSION* session);
+  static int sessionCacheLookupIndex();
   bool isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   bool isClientOcspCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   OcspStapleAction ocspStapleAction(const TlsContext& ctx, bool client_ocsp_capable);
@@ -224,6 +228,7 @@ private:
   ServerNamesMap server_names_map_;
   bool has_rsa_;
   bool full_scan_certs_on_sni_mismatch_;
+  const Ssl::SessionCacheSharedPtr session_cache_;
 };
 
 } // namespace Tls
@@ -26,6 +26,7 @@ ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
 
   Envoy::Ssl::ClientContextSharedPtr context =
       std::make_shared<ClientContextImpl>(scope, config, time_source_);
+  absl::MutexLock lock(&mutex_);
   contexts_.insert(context);
   return context;
 }
@@ -40,12 +41,14 @@ ContextManagerImpl::createSslServerContext(Stats::Scope& scope,
 
   Envoy::Ssl::ServerContextSharedPtr context =
       std::make_shared<ServerContextImpl>(scope, config, server_names, time_source_);
+  absl::MutexLock lock(&mutex_);
   contexts_.insert(context);
   return context;
 }
 
 absl::optional<uint32_t> ContextManagerImpl::daysUntilFirstCertExpires() const {
   absl::optional<uint32_t> ret = absl::make_optional(std::numeric_limits<uint32_t>::max());
+  absl::MutexLock lock(&mutex_);
   for (const auto& context : contexts_) {
     if (context) {
       const absl::optional<uint32_t> tmp = context->daysUntilFirstCertExpires();
@@ -60,6 +63,7 @@ absl::optional<uint32_t> ContextManagerImpl::daysUntilFirstCertExpires() const {
 
 absl::optional<uint64_t> ContextManagerImpl::secondsUntilFirstOcspResponseExpires() const {
   absl::optional<uint64_t> ret;
+  absl::MutexLock lock(&mutex_);
   for (const auto& context : contexts_) {
     if (context) {
       auto next_expiration = context->secondsUntilFirstOcspResponseExpires();
@@ -73,6 +77,7 @@ absl::optional<uint64_t> ContextManagerImpl::secondsUntilFirstOcspResponseExpire
 }
 
 void ContextManagerImpl::iterateContexts(std::function<void(const Envoy::Ssl::Context&)> callback) {
+  absl::MutexLock lock(&mutex_);
   for (const auto& context : contexts_) {
     if (context) {
       callback(*context);
@@ -82,6 +87,7 @@ void ContextManagerImpl::iterateContexts(std::function<void(const Envoy::Ssl::Co
 
 void ContextManagerImpl::removeContext(const Envoy::Ssl::ContextSharedPtr& old_context) {
   if (old_context != nullptr) {
+    absl::MutexLock lock(&mutex_);
     auto erased = contexts_.erase(old_context);
     // The contexts is expected to be added before is removed.
     // And the prod ssl factory implementation guarantees any context is removed exactly once.
@@ -11,6 +11,8 @@
 
 #include "source/extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
@@ -18,10 +20,10 @@ namespace Tls {
 
 /**
  * The SSL context manager has the following threading model:
- * Contexts can be allocated via any thread (through in practice they are only allocated on the main
- * thread). They can be released from any thread (and in practice are since cluster information can
- * be released from any thread). Context allocation/free is a very uncommon thing so we just do a
- * global lock to protect it all.
+ * Contexts can be allocated via any thread (mostly on the main thread, but lazily initialized
+ * downstream contexts are allocated on workers). They can be released from any thread (and in
+ * practice are since cluster information can be released from any thread). Context
+ * allocation/free is a very uncommon thing so we just do a global lock to protect it all.
  */
 class ContextManagerImpl final : public Envoy::Ssl::ContextManager {
 public:
@@ -45,7 +47,8 @@ public:
 
 private:
   TimeSource& time_source_;
-  absl::flat_hash_set<Envoy::Ssl::ContextSharedPtr> contexts_;
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_set<Envoy::Ssl::ContextSharedPtr> contexts_ ABSL_GUARDED_BY(mutex_);
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
 };
 
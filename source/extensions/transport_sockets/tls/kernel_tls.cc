@@ -0,0 +1,169 @@
+#include "source/extensions/transport_sockets/tls/kernel_tls.h"
+
+#include <cstring>
+#include <vector>
+
+#include "source/common/common/logger.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#define ENVOY_KERNEL_TLS 1
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+#if defined(ENVOY_KERNEL_TLS)
+
+namespace {
+
+// The record sequence number is carried in network byte order.
+void writeSequence(uint64_t sequence, unsigned char* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+template <class CryptoInfo>
+bool installTxKey(os_fd_t fd, CryptoInfo& crypto_info, const uint8_t* key, const uint8_t* iv,
+                  uint64_t sequence) {
+  memcpy(crypto_info.key, key, sizeof(crypto_info.key));
+  // The static part of the nonce. AES-GCM keeps it in the salt and sends the rest of the nonce
+  // explicitly in each record, ChaCha20-Poly1305 derives the whole nonce from it.
+  if constexpr (sizeof(crypto_info.salt) > 0) {
+    memcpy(crypto_info.salt, iv, sizeof(crypto_info.salt));
+    // The explicit nonce only has to be unique per record, so start it at the sequence number
+    // like BoringSSL does.
+    writeSequence(sequence, crypto_info.iv);
+  } else {
+    memcpy(crypto_info.iv, iv, sizeof(crypto_info.iv));
+  }
+  writeSequence(sequence, crypto_info.rec_seq);
+  return ::setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info)) == 0;
+}
+
+} // namespace
+
+bool enableKernelTlsTx(SSL* ssl, os_fd_t fd) {
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    return false;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) {
+    return false;
+  }
+
+  size_t key_len;
+  size_t iv_len;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+    break;
+#if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  case NID_chacha20_poly1305:
+    key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+#endif
+  default:
+    return false;
+  }
+
+  // For AEAD ciphers the key block is client key, server key, client IV, server IV.
+  std::vector<uint8_t> key_block(SSL_get_key_block_len(ssl));
+  if (key_block.size() != 2 * (key_len + iv_len) ||
+      !SSL_generate_key_block(ssl, key_block.data(), key_block.size())) {
+    return false;
+  }
+  const bool server = SSL_is_server(ssl);
+  const uint8_t* key = key_block.data() + (server ? key_len : 0);
+  const uint8_t* iv = key_block.data() + 2 * key_len + (server ? iv_len : 0);
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+
+  // This fails if the tls module is not loaded or the socket is not TCP.
+  if (::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    ENVOY_LOG_MISC(debug, "unable to attach kernel TLS: {}", errorDetails(errno));
+    return false;
+  }
+
+  bool installed = false;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm: {
+    tls12_crypto_info_aes_gcm_128 crypto_info{};
+    crypto_info.info.version = TLS_1_2_VERSION;
+    crypto_info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    installed = installTxKey(fd, crypto_info, key, iv, sequence);
+    break;
+  }
+  case NID_aes_256_gcm: {
+    tls12_crypto_info_aes_gcm_256 crypto_info{};
+    crypto_info.info.version = TLS_1_2_VERSION;
+    crypto_info.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+    installed = installTxKey(fd, crypto_info, key, iv, sequence);
+    break;
+  }
+#if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  case NID_chacha20_poly1305: {
+    tls12_crypto_info_chacha20_poly1305 crypto_info{};
+    crypto_info.info.version = TLS_1_2_VERSION;
+    crypto_info.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    installed = installTxKey(fd, crypto_info, key, iv, sequence);
+    break;
+  }
+#endif
+  }
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+
+  // Without a transmit key the attached ULP passes writes through unchanged, so userspace TLS
+  // keeps working.
+  if (!installed) {
+    ENVOY_LOG_MISC(debug, "unable to install kernel TLS transmit key: {}", errorDetails(errno));
+  }
+  return installed;
+}
+
+bool sendKernelTlsAlert(os_fd_t fd, uint8_t level, uint8_t description) {
+  constexpr uint8_t AlertRecordType = 21;
+  uint8_t alert[2] = {level, description};
+  iovec iov{alert, sizeof(alert)};
+
+  char control[CMSG_SPACE(sizeof(AlertRecordType))]{};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  // The record type of the data is passed to the kernel out of band.
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(AlertRecordType));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+
+  return ::sendmsg(fd, &message, MSG_NOSIGNAL) == sizeof(alert);
+}
+
+#else
+
+bool enableKernelTlsTx(SSL*, os_fd_t) { return false; }
+
+bool sendKernelTlsAlert(os_fd_t, uint8_t, uint8_t) { return false; }
+
+#endif
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
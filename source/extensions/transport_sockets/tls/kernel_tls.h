@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/common/platform.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Hand the transmit direction of an established TLS connection to the kernel (kTLS). Once this
+ * succeeds, plaintext written to the socket is framed and encrypted by the kernel, so bytes must
+ * no longer be written through SSL_write(). Only TLS 1.2 with AES-GCM or ChaCha20-Poly1305 is
+ * supported, as TLS 1.3 may require BoringSSL to write KeyUpdate messages after the handshake.
+ * @param ssl supplies the connection whose handshake has completed and that has no record
+ *        partially written.
+ * @param fd supplies the socket of the connection.
+ * @return whether the kernel took over the transmit direction. On failure the socket is left
+ *         usable for userspace TLS.
+ */
+bool enableKernelTlsTx(SSL* ssl, os_fd_t fd);
+
+/**
+ * Send a TLS alert on a socket whose transmit direction is handled by the kernel.
+ * @param fd supplies the socket.
+ * @param level supplies the alert level, e.g. SSL3_AL_WARNING.
+ * @param description supplies the alert description, e.g. SSL_AD_CLOSE_NOTIFY.
+ * @return whether the alert was queued.
+ */
+bool sendKernelTlsAlert(os_fd_t fd, uint8_t level, uint8_t description);
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -1,16 +1,24 @@
 #include "source/extensions/transport_sockets/tls/ssl_socket.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/macros.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/transport_sockets/tls/io_handle_bio.h"
+#include "source/extensions/transport_sockets/tls/kernel_tls.h"
 #include "source/extensions/transport_sockets/tls/ssl_handshaker.h"
 #include "source/extensions/transport_sockets/tls/utility.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_replace.h"
 #include "openssl/err.h"
 #include "openssl/x509v3.h"
@@ -26,6 +34,9 @@ namespace {
 
 constexpr absl::string_view NotReadyReason{"TLS error: Secret is not supplied by SDS"};
 
+// Largest amount of plaintext in a TLS record.
+constexpr uint64_t MaxRecordSize = 16384;
+
 // This SslSocket will be used when SSL secret is not fetched from SDS server.
 class NotReadySslSocket : public Network::TransportSocket {
 public:
@@ -49,9 +60,12 @@ public:
 
 SslSocket::SslSocket(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
                      const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
-                     Ssl::HandshakerFactoryCb handshaker_factory_cb)
+                     Ssl::HandshakerFactoryCb handshaker_factory_cb,
+                     const absl::optional<Envoy::Ssl::ServerContextConfig::DynamicRecordSizing>&
+                         dynamic_record_sizing)
     : transport_socket_options_(transport_socket_options),
       ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)),
+      dynamic_record_sizing_(dynamic_record_sizing),
       info_(std::dynamic_pointer_cast<SslHandshakerImpl>(handshaker_factory_cb(
           ctx_->newSsl(transport_socket_options_), ctx_->sslExtendedSocketInfoIndex(), this))) {
   if (state == InitialState::Client) {
@@ -248,12 +262,35 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (!kernel_tls_tx_attempted_ && info_->state() == Ssl::SocketState::HandshakeComplete) {
+    kernel_tls_tx_attempted_ = true;
+    ASSERT(bytes_to_retry_ == 0);
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_kernel_tx_offload")) {
+      kernel_tls_tx_ = enableKernelTlsTx(rawSsl(), callbacks_->ioHandle().fdDoNotUse());
+      ENVOY_CONN_LOG(debug, "kernel TLS transmit offload {}", callbacks_->connection(),
+                     kernel_tls_tx_ ? "enabled" : "unavailable");
+    }
+  }
+  if (kernel_tls_tx_) {
+    return kernelTlsWrite(write_buffer, end_stream);
+  }
+
+  if (dynamic_record_sizing_.has_value() && write_buffer.length() > 0) {
+    // After an idle period, warm the connection up again with small records.
+    const MonotonicTime now = callbacks_->connection().dispatcher().timeSource().monotonicTime();
+    if (last_write_time_.has_value() &&
+        now - last_write_time_.value() >= dynamic_record_sizing_->idle_timeout_) {
+      warm_up_bytes_written_ = 0;
+    }
+    last_write_time_ = now;
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
     bytes_to_retry_ = 0;
   } else {
-    bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+    bytes_to_write = std::min(write_buffer.length(), recordSize());
   }
 
   uint64_t total_bytes_written = 0;
@@ -271,7 +308,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
       ASSERT(rc == static_cast<int>(bytes_to_write));
       total_bytes_written += rc;
       write_buffer.drain(rc);
-      bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+      if (dynamic_record_sizing_.has_value()) {
+        onRecordWritten(rc);
+      }
+      bytes_to_write = std::min(write_buffer.length(), recordSize());
     } else {
       int err = SSL_get_error(rawSsl(), rc);
       ENVOY_CONN_LOG(trace, "ssl error occurred while write: {}", callbacks_->connection(),
@@ -298,6 +338,48 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+uint64_t SslSocket::recordSize() const {
+  if (dynamic_record_sizing_.has_value() &&
+      warm_up_bytes_written_ < dynamic_record_sizing_->initial_bytes_) {
+    return dynamic_record_sizing_->initial_record_size_;
+  }
+  return MaxRecordSize;
+}
+
+void SslSocket::onRecordWritten(uint64_t bytes) {
+  if (warm_up_bytes_written_ < dynamic_record_sizing_->initial_bytes_) {
+    warm_up_bytes_written_ += bytes;
+    ctx_->stats().dynamic_record_sizing_small_records_.inc();
+  } else {
+    ctx_->stats().dynamic_record_sizing_full_records_.inc();
+  }
+}
+
+Network::IoResult SslSocket::kernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel frames and encrypts the plaintext, so write it like a raw buffer socket does.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        return {PostIoAction::KeepOpen, total_bytes_written, false};
+      }
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -306,6 +388,15 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_tx_) {
+      // BoringSSL no longer owns the write direction, so the kernel has to send close_notify.
+      const bool sent = sendKernelTlsAlert(callbacks_->ioHandle().fdDoNotUse(), SSL3_AL_WARNING,
+                                           SSL_AD_CLOSE_NOTIFY);
+      ENVOY_CONN_LOG(debug, "SSL shutdown: kernel close_notify sent={}", callbacks_->connection(),
+                     sent);
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -415,17 +506,89 @@ void ClientSslSocketFactory::onAddOrUpdateSecret() {
   stats_.ssl_context_update_by_sds_.inc();
 }
 
+/**
+ * Tracks the lazily initialized server socket factories of the process, to bound the number of
+ * contexts they keep.
+ */
+class LazyServerContextRegistry {
+public:
+  static LazyServerContextRegistry& get() {
+    MUTABLE_CONSTRUCT_ON_FIRST_USE(LazyServerContextRegistry);
+  }
+
+  void add(ServerSslSocketFactory& factory) {
+    absl::MutexLock l(&mu_);
+    factories_.insert(&factory);
+  }
+
+  void remove(ServerSslSocketFactory& factory) {
+    absl::MutexLock l(&mu_);
+    factories_.erase(&factory);
+  }
+
+  uint64_t nextUse() { return uses_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+  // Releases the least recently used contexts beyond the envoy.tls.max_lazy_server_contexts
+  // runtime value.
+  void releaseLeastRecentlyUsed() {
+    Runtime::Loader* runtime = Runtime::LoaderSingleton::getExisting();
+    if (runtime == nullptr) {
+      return;
+    }
+    const uint64_t max_contexts = runtime->snapshot().getInteger(
+        "envoy.tls.max_lazy_server_contexts", std::numeric_limits<uint64_t>::max());
+
+    absl::MutexLock l(&mu_);
+    if (factories_.size() <= max_contexts) {
+      return;
+    }
+    std::vector<std::pair<uint64_t, ServerSslSocketFactory*>> factories;
+    factories.reserve(factories_.size());
+    for (ServerSslSocketFactory* factory : factories_) {
+      factories.emplace_back(factory->last_used_.load(std::memory_order_relaxed), factory);
+    }
+    std::sort(factories.begin(), factories.end());
+    // Keep the contexts of the most recently used factories that have one.
+    uint64_t built = 0;
+    for (auto it = factories.rbegin(); it != factories.rend(); ++it) {
+      if (built < max_contexts) {
+        absl::ReaderMutexLock ctx_lock(&it->second->ssl_ctx_mu_);
+        if (it->second->ssl_ctx_ != nullptr) {
+          ++built;
+        }
+      } else {
+        it->second->releaseLazySslCtx();
+      }
+    }
+  }
+
+private:
+  absl::Mutex mu_;
+  absl::flat_hash_set<ServerSslSocketFactory*> factories_ ABSL_GUARDED_BY(mu_);
+  std::atomic<uint64_t> uses_{};
+};
+
 ServerSslSocketFactory::ServerSslSocketFactory(Envoy::Ssl::ServerContextConfigPtr config,
                                                Envoy::Ssl::ContextManager& manager,
                                                Stats::Scope& stats_scope,
                                                const std::vector<std::string>& server_names)
     : manager_(manager), stats_scope_(stats_scope), stats_(generateStats("server", stats_scope)),
       config_(std::move(config)), server_names_(server_names),
-      ssl_ctx_(manager_.createSslServerContext(stats_scope_, *config_, server_names_)) {
+      lazy_(config_->lazyContextInitialization()) {
+  if (lazy_) {
+    LazyServerContextRegistry::get().add(*this);
+  } else {
+    ssl_ctx_ = manager_.createSslServerContext(stats_scope_, *config_, server_names_);
+  }
   config_->setSecretUpdateCallback([this]() { onAddOrUpdateSecret(); });
 }
 
-ServerSslSocketFactory::~ServerSslSocketFactory() { manager_.removeContext(ssl_ctx_); }
+ServerSslSocketFactory::~ServerSslSocketFactory() {
+  if (lazy_) {
+    LazyServerContextRegistry::get().remove(*this);
+  }
+  manager_.removeContext(ssl_ctx_);
+}
 
 Envoy::Ssl::ClientContextSharedPtr ClientSslSocketFactory::sslCtx() {
   absl::ReaderMutexLock l(&ssl_ctx_mu_);
@@ -437,24 +600,99 @@ Network::TransportSocketPtr ServerSslSocketFactory::createDownstreamTransportSoc
   // creating SslSocket using ssl_ctx. Capture ssl_ctx_ into a local variable so that we check and
   // use the same ssl_ctx to create SslSocket.
   Envoy::Ssl::ServerContextSharedPtr ssl_ctx;
-  {
+  if (lazy_) {
+    ssl_ctx = lazySslCtx();
+  } else {
     absl::ReaderMutexLock l(&ssl_ctx_mu_);
     ssl_ctx = ssl_ctx_;
   }
   if (ssl_ctx) {
     return std::make_unique<SslSocket>(std::move(ssl_ctx), InitialState::Server, nullptr,
-                                       config_->createHandshaker());
+                                       config_->createHandshaker(),
+                                       config_->dynamicRecordSizing());
   } else {
     ENVOY_LOG(debug, "Create NotReadySslSocket");
-    stats_.downstream_context_secrets_not_ready_.inc();
+    // Lazy builds account for their failures themselves.
+    if (!lazy_) {
+      stats_.downstream_context_secrets_not_ready_.inc();
+    }
     return std::make_unique<NotReadySslSocket>();
   }
 }
 
+Envoy::Ssl::ServerContextSharedPtr ServerSslSocketFactory::lazySslCtx() const {
+  LazyServerContextRegistry& registry = LazyServerContextRegistry::get();
+  last_used_.store(registry.nextUse(), std::memory_order_relaxed);
+  {
+    absl::ReaderMutexLock l(&ssl_ctx_mu_);
+    if (ssl_ctx_ != nullptr) {
+      return ssl_ctx_;
+    }
+  }
+
+  Envoy::Ssl::ServerContextSharedPtr ssl_ctx;
+  {
+    absl::MutexLock build_lock(&lazy_init_mu_);
+    {
+      // Another worker may have built the context in the meantime.
+      absl::ReaderMutexLock l(&ssl_ctx_mu_);
+      if (ssl_ctx_ != nullptr) {
+        return ssl_ctx_;
+      }
+    }
+    if (lazy_init_failed_) {
+      stats_.downstream_context_lazy_init_failed_.inc();
+      return nullptr;
+    }
+    TRY_NEEDS_AUDIT {
+      ssl_ctx = manager_.createSslServerContext(stats_scope_, *config_, server_names_);
+    }
+    catch (const EnvoyException& e) {
+      ENVOY_LOG(warn, "Failed to build the TLS context of {}: {}",
+                absl::StrJoin(server_names_, ","), e.what());
+      lazy_init_failed_ = true;
+      stats_.downstream_context_lazy_init_failed_.inc();
+      return nullptr;
+    }
+    if (ssl_ctx == nullptr) {
+      stats_.downstream_context_secrets_not_ready_.inc();
+      return nullptr;
+    }
+    absl::WriterMutexLock l(&ssl_ctx_mu_);
+    ssl_ctx_ = ssl_ctx;
+  }
+  registry.releaseLeastRecentlyUsed();
+  return ssl_ctx;
+}
+
+bool ServerSslSocketFactory::releaseLazySslCtx() {
+  Envoy::Ssl::ServerContextSharedPtr ssl_ctx;
+  {
+    absl::WriterMutexLock l(&ssl_ctx_mu_);
+    std::swap(ssl_ctx, ssl_ctx_);
+  }
+  if (ssl_ctx == nullptr) {
+    return false;
+  }
+  // Connections using the context keep it alive until they are closed.
+  manager_.removeContext(ssl_ctx);
+  return true;
+}
+
 bool ServerSslSocketFactory::implementsSecureTransport() const { return true; }
 
 void ServerSslSocketFactory::onAddOrUpdateSecret() {
   ENVOY_LOG(debug, "Secret is updated.");
+  if (lazy_) {
+    // The context is built again with the new secret when needed.
+    {
+      absl::MutexLock l(&lazy_init_mu_);
+      lazy_init_failed_ = false;
+    }
+    releaseLazySslCtx();
+    stats_.ssl_context_update_by_sds_.inc();
+    return;
+  }
   auto ctx = manager_.createSslServerContext(stats_scope_, *config_, server_names_);
   {
     absl::WriterMutexLock l(&ssl_ctx_mu_);
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
+#include "envoy/common/time.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/secret/secret_callbacks.h"
@@ -32,7 +34,8 @@ namespace Tls {
 #define ALL_SSL_SOCKET_FACTORY_STATS(COUNTER)                                                      \
   COUNTER(ssl_context_update_by_sds)                                                               \
   COUNTER(upstream_context_secrets_not_ready)                                                      \
-  COUNTER(downstream_context_secrets_not_ready)
+  COUNTER(downstream_context_secrets_not_ready)                                                    \
+  COUNTER(downstream_context_lazy_init_failed)
 
 /**
  * Wrapper struct for SSL socket factory stats. @see stats_macros.h
@@ -50,7 +53,9 @@ class SslSocket : public Network::TransportSocket,
 public:
   SslSocket(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
             const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
-            Ssl::HandshakerFactoryCb handshaker_factory_cb);
+            Ssl::HandshakerFactoryCb handshaker_factory_cb,
+            const absl::optional<Envoy::Ssl::ServerContextConfig::DynamicRecordSizing>&
+                dynamic_record_sizing = absl::nullopt);
 
   // Network::TransportSocket
   void setTransportSocketCallbacks(Network::TransportSocketCallbacks& callbacks) override;
@@ -84,6 +89,9 @@ private:
     absl::optional<int> error_;
   };
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
+  Network::IoResult kernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
+  uint64_t recordSize() const;
+  void onRecordWritten(uint64_t bytes);
 
   Network::PostIoAction doHandshake();
   void drainErrorQueue();
@@ -96,6 +104,15 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether the kernel has been asked to encrypt writes. It is only attempted on the first write
+  // after the handshake.
+  bool kernel_tls_tx_attempted_{};
+  bool kernel_tls_tx_{};
+  // Unset if records are always written at full size.
+  const absl::optional<Envoy::Ssl::ServerContextConfig::DynamicRecordSizing> dynamic_record_sizing_;
+  // Bytes written since the connection started or was last idle, while small records are written.
+  uint64_t warm_up_bytes_written_{};
+  absl::optional<MonotonicTime> last_write_time_;
 
   SslHandshakerImplSharedPtr info_;
 };
@@ -134,6 +151,8 @@ private:
   Envoy::Ssl::ClientContextSharedPtr ssl_ctx_ ABSL_GUARDED_BY(ssl_ctx_mu_);
 };
 
+class LazyServerContextRegistry;
+
 class ServerSslSocketFactory : public Network::DownstreamTransportSocketFactory,
                                public Secret::SecretCallbacks,
                                Logger::Loggable<Logger::Id::config> {
@@ -151,11 +170,25 @@ public:
   void onAddOrUpdateSecret() override;
 
 private:
+  friend class LazyServerContextRegistry;
+
+  // Returns the context of a lazily initialized factory, building it if needed.
+  Envoy::Ssl::ServerContextSharedPtr lazySslCtx() const;
+  // Releases the context of a lazily initialized factory. Returns false if there was none.
+  bool releaseLazySslCtx();
+
   Ssl::ContextManager& manager_;
   Stats::Scope& stats_scope_;
   SslSocketFactoryStats stats_;
   Envoy::Ssl::ServerContextConfigPtr config_;
   const std::vector<std::string> server_names_;
+  const bool lazy_;
+  // Serializes lazy builds, so that each context is only built once.
+  mutable absl::Mutex lazy_init_mu_ ABSL_ACQUIRED_BEFORE(ssl_ctx_mu_);
+  // Set when the lazy build failed, so that it is not attempted for each connection.
+  mutable bool lazy_init_failed_ ABSL_GUARDED_BY(lazy_init_mu_){};
+  // The order of the last use of a lazily built context, to release the least recently used ones.
+  mutable std::atomic<uint64_t> last_used_{};
   mutable absl::Mutex ssl_ctx_mu_;
   Envoy::Ssl::ServerContextSharedPtr ssl_ctx_ ABSL_GUARDED_BY(ssl_ctx_mu_);
 };
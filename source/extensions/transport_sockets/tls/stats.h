@@ -20,7 +20,9 @@ namespace Tls {
   COUNTER(ocsp_staple_failed)                                                                      \
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
-  COUNTER(ocsp_staple_requests)
+  COUNTER(ocsp_staple_requests)                                                                    \
+  COUNTER(dynamic_record_sizing_small_records)                                                     \
+  COUNTER(dynamic_record_sizing_full_records)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
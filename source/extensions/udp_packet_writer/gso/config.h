@@ -1,9 +1,13 @@
 #pragma once
 
 #include "envoy/extensions/udp_packet_writer/v3/udp_gso_batch_writer_factory.pb.h"
+#include "envoy/extensions/udp_packet_writer/v3/udp_gso_batch_writer_factory.pb.validate.h"
 #include "envoy/network/udp_packet_writer_handler.h"
 #include "envoy/registry/registry.h"
 
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/quic/udp_gso_batch_writer.h"
 #endif
@@ -16,11 +20,15 @@ namespace Quic {
 class UdpGsoBatchWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
 public:
   std::string name() const override { return "envoy.udp_packet_writer.gso"; }
-  Network::UdpPacketWriterFactoryPtr
-  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+  Network::UdpPacketWriterFactoryPtr createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override {
 #ifdef ENVOY_ENABLE_QUIC
-    return std::make_unique<UdpGsoBatchWriterFactory>();
+    const auto writer_config = MessageUtil::anyConvertAndValidate<
+        envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory>(
+        config.typed_config(), ProtobufMessage::getStrictValidationVisitor());
+    return std::make_unique<UdpGsoBatchWriterFactory>(writer_config.enable_pacing_offload());
 #else
+    UNREFERENCED_PARAMETER(config);
     return {};
 #endif
   }
@@ -0,0 +1,151 @@
+#include "source/extensions/watchdog/backtrace_action/backtrace_action.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/stats/symbol_table.h"
+#include "source/server/backtrace.h"
+
+#include "absl/synchronization/mutex.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace BacktraceAction {
+namespace {
+using WatchdogAction = envoy::config::bootstrap::v3::Watchdog::WatchdogAction;
+
+constexpr uint64_t DefaultMaxBacktraces = 10;
+constexpr uint64_t DefaultWaitDurationMs = 100;
+
+#ifdef __linux__
+// The state of the capture shared with the signal handler. It holds the tid of the thread whose
+// stack is requested, or one of the values below.
+constexpr int64_t Idle = -1;
+constexpr int64_t Capturing = -2;
+constexpr int64_t Captured = -3;
+std::atomic<int64_t> capture_state{Idle};
+BackwardsTrace captured_trace;
+
+// Serializes the captures of the actions of all the guard dogs, as there is a single trace.
+ABSL_CONST_INIT absl::Mutex capture_mutex(absl::kConstInit);
+
+void backtraceSignalHandler(int, siginfo_t*, void* context) {
+  // Only the thread whose stack was requested captures it, so that a stray SIGUSR2 is ignored.
+  int64_t expected = syscall(SYS_gettid);
+  if (!capture_state.compare_exchange_strong(expected, Capturing)) {
+    return;
+  }
+  captured_trace.captureFrom(context);
+  capture_state.store(Captured);
+}
+
+void installSignalHandler() {
+  struct sigaction saction;
+  std::memset(&saction, 0, sizeof(saction));
+  sigemptyset(&saction.sa_mask);
+  saction.sa_flags = SA_SIGINFO | SA_RESTART;
+  saction.sa_sigaction = backtraceSignalHandler;
+  RELEASE_ASSERT(sigaction(SIGUSR2, &saction, nullptr) == 0, "");
+}
+
+// Captures the stack of the thread, or returns false if it did not capture it in time.
+bool captureTrace(int64_t tid, absl::Duration wait_duration, std::ostream& os) {
+  absl::MutexLock lock(&capture_mutex);
+  capture_state.store(tid);
+  if (syscall(SYS_tgkill, getpid(), tid, SIGUSR2) != 0) {
+    capture_state.store(Idle);
+    return false;
+  }
+
+  const absl::Time deadline = absl::Now() + wait_duration;
+  while (capture_state.load() != Captured && absl::Now() < deadline) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  int64_t expected = tid;
+  if (capture_state.compare_exchange_strong(expected, Idle)) {
+    // The thread did not handle the signal in time, and will ignore it.
+    return false;
+  }
+  // The handler started capturing, which does not block.
+  while (capture_state.load() != Captured) {
+  }
+  captured_trace.printTrace(os);
+  capture_state.store(Idle);
+  return true;
+}
+#endif
+
+Stats::Counter& counter(Server::Configuration::GuardDogActionFactoryContext& context,
+                        absl::string_view name) {
+  return context.stats_.counterFromStatName(
+      Stats::StatNameManagedStorage(
+          absl::StrCat(context.guarddog_name_, ".backtrace_action.", name),
+          context.stats_.symbolTable())
+          .statName());
+}
+} // namespace
+
+BacktraceAction::BacktraceAction(
+    envoy::extensions::watchdog::backtrace_action::v3::BacktraceActionConfig& config,
+    Server::Configuration::GuardDogActionFactoryContext& context)
+    : wait_duration_(absl::Milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, wait_duration, DefaultWaitDurationMs))),
+      max_backtraces_(config.max_backtraces() == 0 ? DefaultMaxBacktraces
+                                                   : config.max_backtraces()),
+      backtraces_captured_(counter(context, "captured")),
+      backtraces_timed_out_(counter(context, "timed_out")) {
+#ifdef __linux__
+  installSignalHandler();
+#endif
+}
+
+void BacktraceAction::run(
+    envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent event,
+    const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
+    MonotonicTime now) {
+#ifdef __linux__
+  for (const auto& [thread_id, last_checkin] : thread_last_checkin_pairs) {
+    if (backtraces_logged_ >= max_backtraces_) {
+      return;
+    }
+    std::ostringstream trace;
+    if (!captureTrace(thread_id.getId(), wait_duration_, trace)) {
+      backtraces_timed_out_.inc();
+      ENVOY_LOG_MISC(warn, "Watchdog BacktraceAction failed to capture the stack of tid {}.",
+                     thread_id.debugString());
+      continue;
+    }
+    backtraces_captured_.inc();
+    backtraces_logged_++;
+    const auto stuck_for =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - last_checkin);
+    ENVOY_LOG_MISC(warn,
+                   "Watchdog BacktraceAction on {}, tid {} stuck for {}ms "
+                   "(use tools/stack_decode.py to get line numbers):\n{}",
+                   WatchdogAction::WatchdogEvent_Name(event), thread_id.debugString(),
+                   stuck_for.count(), trace.str());
+  }
+#else
+  UNREFERENCED_PARAMETER(event);
+  UNREFERENCED_PARAMETER(thread_last_checkin_pairs);
+  UNREFERENCED_PARAMETER(now);
+  ENVOY_LOG_MISC(error, "Watchdog BacktraceAction is only supported on Linux.");
+#endif
+}
+
+} // namespace BacktraceAction
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
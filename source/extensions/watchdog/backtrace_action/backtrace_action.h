@@ -0,0 +1,42 @@
+#pragma once
+
+#include "envoy/extensions/watchdog/backtrace_action/v3/backtrace_action.pb.h"
+#include "envoy/server/guarddog_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
+
+#include "absl/time/time.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace BacktraceAction {
+
+/**
+ * A GuardDogAction that logs the stack of the stuck threads. Each thread is sent SIGUSR2, so that
+ * its handler captures the stack of the thread where it is stuck, and the stack is symbolized and
+ * logged on the guard dog thread.
+ */
+class BacktraceAction : public Server::Configuration::GuardDogAction {
+public:
+  BacktraceAction(envoy::extensions::watchdog::backtrace_action::v3::BacktraceActionConfig& config,
+                  Server::Configuration::GuardDogActionFactoryContext& context);
+
+  void run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent event,
+           const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
+           MonotonicTime now) override;
+
+private:
+  const absl::Duration wait_duration_;
+  const uint64_t max_backtraces_;
+  uint64_t backtraces_logged_ = 0;
+  Stats::Counter& backtraces_captured_;
+  Stats::Counter& backtraces_timed_out_;
+};
+
+using BacktraceActionPtr = std::unique_ptr<BacktraceAction>;
+
+} // namespace BacktraceAction
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
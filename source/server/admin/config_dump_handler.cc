@@ -3,6 +3,7 @@
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/config/endpoint/v3/endpoint.pb.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/statusor.h"
@@ -11,6 +12,9 @@
 #include "source/common/network/utility.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/str_replace.h"
+#include "absl/strings/strip.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -152,6 +156,22 @@ buildNameMatcher(const Http::Utility::QueryParams& params) {
   }
 }
 
+// Redacts the config, and appends its pretty-printed JSON as the next element of the configs of
+// the dump. Serializing each config on its own means that the whole dump is never held at once as
+// a ConfigDump proto, and then again as one string. The JSON is indented to the depth of the
+// configs array, which keeps the output identical to that of printing the whole ConfigDump.
+void addConfigToDump(Protobuf::Message& message, Buffer::Instance& configs) {
+  MessageUtil::redact(message);
+  ProtobufWkt::Any config;
+  config.PackFrom(message);
+  const std::string json = MessageUtil::getJsonStringFromMessageOrError(config, true);
+  if (configs.length() > 0) {
+    configs.add(",\n");
+  }
+  configs.add("  ");
+  configs.add(absl::StrReplaceAll(absl::StripSuffix(json, "\n"), {{"\n", "\n  "}}));
+}
+
 } // namespace
 
 ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
@@ -171,13 +191,12 @@ Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& respons
     return Http::Code::BadRequest;
   }
 
-  envoy::admin::v3::ConfigDump dump;
-
+  Buffer::OwnedImpl configs;
   absl::optional<std::pair<Http::Code, std::string>> err;
   if (resource.has_value()) {
-    err = addResourceToDump(dump, mask, resource.value(), **name_matcher, include_eds);
+    err = addResourceToDump(configs, mask, resource.value(), **name_matcher, include_eds);
   } else {
-    err = addAllConfigToDump(dump, mask, **name_matcher, include_eds);
+    err = addAllConfigToDump(configs, mask, **name_matcher, include_eds);
   }
   if (err.has_value()) {
     response_headers.addReference(Http::Headers::get().XContentTypeOptions,
@@ -186,15 +205,21 @@ Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& respons
     response.add(err.value().second);
     return err.value().first;
   }
-  MessageUtil::redact(dump);
 
   response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
-  response.add(MessageUtil::getJsonStringFromMessageOrError(dump, true)); // pretty-print
+  // Frame the configs the way the pretty-printed JSON of an envoy::admin::v3::ConfigDump is.
+  if (configs.length() == 0) {
+    response.add("{}\n");
+    return Http::Code::OK;
+  }
+  response.add("{\n \"configs\": [\n");
+  response.move(configs);
+  response.add("\n ]\n}\n");
   return Http::Code::OK;
 }
 
 absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourceToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+    Buffer::Instance& configs, const absl::optional<std::string>& mask,
     const std::string& resource, const Matchers::StringMatcher& name_matcher,
     bool include_eds) const {
   Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
@@ -235,8 +260,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
                                                    " could not be successfully used."))};
         }
       }
-      auto* config = dump.add_configs();
-      config->PackFrom(msg);
+      addConfigToDump(msg, configs);
     }
 
     // We found the desired resource so there is no need to continue iterating over
@@ -249,7 +273,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
 }
 
 absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConfigToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+    Buffer::Instance& configs, const absl::optional<std::string>& mask,
     const Matchers::StringMatcher& name_matcher, bool include_eds) const {
   Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
   if (include_eds) {
@@ -279,10 +303,9 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConf
       }
     }
 
-    auto* config = dump.add_configs();
-    config->PackFrom(*message);
+    addConfigToDump(*message, configs);
   }
-  if (dump.configs().empty() && mask.has_value()) {
+  if (configs.length() == 0 && mask.has_value()) {
     return absl::optional<std::pair<Http::Code, std::string>>{std::make_pair(
         Http::Code::BadRequest,
         absl::StrCat("FieldMask ", *mask, " could not be successfully applied to any configs."))};
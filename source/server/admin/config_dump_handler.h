@@ -26,16 +26,22 @@ public:
                                Buffer::Instance& response, AdminStream&) const;
 
 private:
+  /**
+   * Add the JSON of all the configs to the passed configs of a config dump.
+   * @return absl::nullopt on success, else the Http::Code and an error message that should be added
+   * to the admin response.
+   */
   absl::optional<std::pair<Http::Code, std::string>>
-  addAllConfigToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+  addAllConfigToDump(Buffer::Instance& configs, const absl::optional<std::string>& mask,
                      const Matchers::StringMatcher& name_matcher, bool include_eds) const;
   /**
-   * Add the config matching the passed resource to the passed config dump.
+   * Add the JSON of the configs matching the passed resource to the passed configs of a config
+   * dump.
    * @return absl::nullopt on success, else the Http::Code and an error message that should be added
    * to the admin response.
    */
   absl::optional<std::pair<Http::Code, std::string>>
-  addResourceToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+  addResourceToDump(Buffer::Instance& configs, const absl::optional<std::string>& mask,
                     const std::string& resource, const Matchers::StringMatcher& name_matcher,
                     bool include_eds) const;
 
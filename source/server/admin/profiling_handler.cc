@@ -91,5 +91,36 @@ Http::Code TcmallocProfilingHandler::handlerHeapDump(Http::ResponseHeaderMap&,
   return Http::Code::NotImplemented;
 }
 
+Http::Code TcmallocProfilingHandler::handlerAllocationProfiler(Http::ResponseHeaderMap&,
+                                                               Buffer::Instance& response,
+                                                               AdminStream& admin_stream) {
+  Http::Utility::QueryParams query_params = admin_stream.queryParams();
+  if (query_params.size() != 1 || query_params.begin()->first != "enable" ||
+      (query_params.begin()->second != "y" && query_params.begin()->second != "n")) {
+    response.add("?enable=<y|n>\n");
+    return Http::Code::BadRequest;
+  }
+
+  absl::Status status;
+  if (query_params.begin()->second == "y") {
+    status = Profiler::TcmallocProfiler::startAllocationProfiler();
+    if (status.ok()) {
+      response.add("Starting allocation profiler");
+      return Http::Code::OK;
+    }
+  } else {
+    auto profile = Profiler::TcmallocProfiler::stopAllocationProfiler();
+    if (profile.ok()) {
+      response.add(profile.value());
+      return Http::Code::OK;
+    }
+    status = profile.status();
+  }
+
+  response.add(status.message());
+  return status.code() == absl::StatusCode::kUnimplemented ? Http::Code::NotImplemented
+                                                           : Http::Code::BadRequest;
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -3,10 +3,14 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/histogram_impl.h"
 
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
+#include "io/prometheus/client/metrics.pb.h"
 
 namespace Envoy {
 namespace Server {
@@ -24,7 +28,18 @@ std::string sanitizeName(const absl::string_view name) {
   // The name must match the regex [a-zA-Z_][a-zA-Z0-9_]* as required by
   // prometheus. Refer to https://prometheus.io/docs/concepts/data_model/.
   // The initial [a-zA-Z_] constraint is always satisfied by the namespace prefix.
-  return promRegex().replaceAll(name, "_");
+  // Names are almost always ASCII, which is sanitized byte by byte without running the regex.
+  std::string sanitized(name);
+  for (char& c : sanitized) {
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      // The regex replaces a multi-byte UTF-8 character with a single '_'.
+      return promRegex().replaceAll(name, "_");
+    }
+    if (!absl::ascii_isalnum(c) && c != '_') {
+      c = '_';
+    }
+  }
+  return sanitized;
 }
 
 /**
@@ -223,15 +238,31 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+/*
+ * Adds a metric with the sanitized tags of the given stat to a MetricFamily.
+ */
+io::prometheus::client::Metric* addProtobufMetric(io::prometheus::client::MetricFamily& family,
+                                                  const std::vector<Stats::Tag>& tags) {
+  io::prometheus::client::Metric* metric = family.add_metric();
+  for (const Stats::Tag& tag : tags) {
+    io::prometheus::client::LabelPair* label = metric->add_label();
+    label->set_name(sanitizeName(tag.name_));
+    label->set_value(tag.value_);
+  }
+  return metric;
+}
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
-  std::vector<std::string> buf;
-  buf.reserve(tags.size());
+  std::string formatted;
   for (const Stats::Tag& tag : tags) {
-    buf.push_back(fmt::format("{}=\"{}\"", sanitizeName(tag.name_), sanitizeValue(tag.value_)));
+    if (!formatted.empty()) {
+      formatted.push_back(',');
+    }
+    absl::StrAppend(&formatted, sanitizeName(tag.name_), "=\"", sanitizeValue(tag.value_), "\"");
   }
-  return absl::StrJoin(buf, ",");
+  return formatted;
 }
 
 absl::optional<std::string>
@@ -285,5 +316,217 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Stats::CustomStatNamespaces& custom_namespaces,
+                                               Format format)
+    : stats_(stats), params_(params), custom_namespaces_(custom_namespaces), format_(format),
+      groups_(stats.constSymbolTable()) {}
+
+PrometheusStatsRequest::Format
+PrometheusStatsRequest::formatFromAcceptHeader(absl::string_view accept) {
+  // Prometheus servers that can parse the protobuf format list it, together with the text format
+  // as a fallback, see
+  // https://github.com/prometheus/docs/blob/main/content/docs/instrumenting/exposition_formats.md.
+  if (absl::StrContains(accept, "application/vnd.google.protobuf") &&
+      absl::StrContains(accept, "proto=io.prometheus.client.MetricFamily")) {
+    return Format::Protobuf;
+  }
+  return Format::Text;
+}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap& response_headers) {
+  if (format_ == Format::Protobuf) {
+    response_headers.setReferenceContentType(ProtobufContentType);
+  }
+  phase_ = Phase::Counters;
+  populateGroups(stats_.counters());
+  return Http::Code::OK;
+}
+
+void PrometheusStatsRequest::nextPhase() {
+  ASSERT(groups_.empty());
+  switch (phase_) {
+  case Phase::Counters:
+    phase_ = Phase::Gauges;
+    populateGroups(stats_.gauges());
+    break;
+  case Phase::Gauges:
+    phase_ = Phase::TextReadouts;
+    if (params_.prometheus_text_readouts_) {
+      populateGroups(stats_.textReadouts());
+    }
+    break;
+  case Phase::TextReadouts:
+    phase_ = Phase::Histograms;
+    populateGroups(stats_.histograms());
+    break;
+  case Phase::Histograms:
+  case Phase::Done:
+    phase_ = Phase::Done;
+    break;
+  }
+}
+
+template <class StatType>
+void PrometheusStatsRequest::populateGroups(
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics) {
+  for (const auto& metric : metrics) {
+    if (shouldShowMetric(*metric, params_)) {
+      groups_[metric->tagExtractedStatName()].emplace_back(metric.get());
+    }
+  }
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t chunk_end = response.length() + chunk_size_;
+  while (response.length() < chunk_end) {
+    while (groups_.empty()) {
+      nextPhase();
+      if (phase_ == Phase::Done) {
+        return false;
+      }
+    }
+
+    auto iter = groups_.begin();
+    if (!group_name_.has_value()) {
+      group_name_ = PrometheusStatsFormatter::metricName(
+          stats_.constSymbolTable().toString(iter->first), custom_namespaces_);
+      if (!group_name_.has_value()) {
+        groups_.erase(iter);
+        continue;
+      }
+      // Sort before producing the output to satisfy the "preferred" ordering from the
+      // prometheus spec: metrics will be sorted by their tags' textual representation, which
+      // will be consistent across calls.
+      std::sort(iter->second.begin(), iter->second.end(),
+                [](const Stats::RefcountPtr<Stats::Metric>& a,
+                   const Stats::RefcountPtr<Stats::Metric>& b) {
+                  return MetricLessThan()(a.get(), b.get());
+                });
+      group_index_ = 0;
+    }
+
+    bool group_done = true;
+    switch (format_) {
+    case Format::Text:
+      group_done = renderTextGroup(iter->second, response, chunk_end);
+      break;
+    case Format::Protobuf:
+      // A metric family must be sent as a single message.
+      renderProtobufGroup(iter->second, response);
+      break;
+    }
+    if (group_done) {
+      groups_.erase(iter);
+      group_name_.reset();
+    }
+  }
+  return true;
+}
+
+bool PrometheusStatsRequest::renderTextGroup(MetricVec& metrics, Buffer::Instance& response,
+                                             uint64_t chunk_end) {
+  const std::string& name = group_name_.value();
+  if (group_index_ == 0) {
+    // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+    absl::string_view type = "gauge";
+    if (phase_ == Phase::Counters) {
+      type = "counter";
+    } else if (phase_ == Phase::Histograms) {
+      type = "histogram";
+    }
+    response.add(fmt::format("# TYPE {0} {1}\n", name, type));
+  }
+
+  for (; group_index_ < metrics.size(); ++group_index_) {
+    if (response.length() >= chunk_end) {
+      return false;
+    }
+    const Stats::Metric& metric = *metrics[group_index_];
+    switch (phase_) {
+    case Phase::Counters:
+      response.add(generateNumericOutput(static_cast<const Stats::Counter&>(metric), name));
+      break;
+    case Phase::Gauges:
+      response.add(generateNumericOutput(static_cast<const Stats::Gauge&>(metric), name));
+      break;
+    case Phase::TextReadouts:
+      response.add(generateTextReadoutOutput(static_cast<const Stats::TextReadout&>(metric), name));
+      break;
+    case Phase::Histograms:
+      response.add(
+          generateHistogramOutput(static_cast<const Stats::ParentHistogram&>(metric), name));
+      break;
+    case Phase::Done:
+      PANIC("not reached");
+    }
+    // Release the metric as soon as it is rendered.
+    metrics[group_index_].reset();
+  }
+  return true;
+}
+
+void PrometheusStatsRequest::renderProtobufGroup(const MetricVec& metrics,
+                                                 Buffer::Instance& response) {
+  io::prometheus::client::MetricFamily family;
+  family.set_name(group_name_.value());
+  for (const auto& metric_ptr : metrics) {
+    const Stats::Metric& metric = *metric_ptr;
+    switch (phase_) {
+    case Phase::Counters:
+      family.set_type(io::prometheus::client::MetricType::COUNTER);
+      addProtobufMetric(family, metric.tags())
+          ->mutable_counter()
+          ->set_value(static_cast<const Stats::Counter&>(metric).value());
+      break;
+    case Phase::Gauges:
+      family.set_type(io::prometheus::client::MetricType::GAUGE);
+      addProtobufMetric(family, metric.tags())
+          ->mutable_gauge()
+          ->set_value(static_cast<const Stats::Gauge&>(metric).value());
+      break;
+    case Phase::TextReadouts: {
+      // Same workaround as in the text format: a gauge with value 0 and the text as a tag.
+      family.set_type(io::prometheus::client::MetricType::GAUGE);
+      std::vector<Stats::Tag> tags = metric.tags();
+      tags.push_back(
+          Stats::Tag{"text_value", static_cast<const Stats::TextReadout&>(metric).value()});
+      addProtobufMetric(family, tags)->mutable_gauge()->set_value(0);
+      break;
+    }
+    case Phase::Histograms: {
+      family.set_type(io::prometheus::client::MetricType::HISTOGRAM);
+      const Stats::HistogramStatistics& stats =
+          static_cast<const Stats::ParentHistogram&>(metric).cumulativeStatistics();
+      io::prometheus::client::Histogram* histogram =
+          addProtobufMetric(family, metric.tags())->mutable_histogram();
+      histogram->set_sample_count(stats.sampleCount());
+      histogram->set_sample_sum(stats.sampleSum());
+      Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
+      const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
+      for (size_t i = 0; i < supported_buckets.size(); ++i) {
+        io::prometheus::client::Bucket* bucket = histogram->add_bucket();
+        bucket->set_upper_bound(supported_buckets[i]);
+        bucket->set_cumulative_count(computed_buckets[i]);
+      }
+      break;
+    }
+    case Phase::Done:
+      PANIC("not reached");
+    }
+  }
+
+  std::string output;
+  {
+    Protobuf::io::StringOutputStream stream(&output);
+    Protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.WriteVarint64(family.ByteSizeLong());
+    family.SerializeWithCachedSizes(&coded_stream);
+  }
+  response.add(output);
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <map>
 #include <regex>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
@@ -47,5 +52,70 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Streams the stats of a store in the Prometheus exposition format, one chunk at a time, in the
+ * same order as PrometheusStatsFormatter::statsAsPrometheus(). Only the stats of the type being
+ * emitted are held, grouped by tag-extracted name, and each group is released as soon as it has
+ * been written, so the rendered output is never materialized.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  enum class Format {
+    // The text exposition format.
+    Text,
+    // Length-delimited io.prometheus.client.MetricFamily messages.
+    Protobuf,
+  };
+
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+  static constexpr absl::string_view ProtobufContentType =
+      "application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; "
+      "encoding=delimited";
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         Format format = Format::Text);
+
+  /**
+   * @param accept supplies the value of the accept request header.
+   * @return the format asked for by a Prometheus server sending the header.
+   */
+  static Format formatFromAcceptHeader(absl::string_view accept);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  // Ordered to match statsAsPrometheus().
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, Done };
+
+  using MetricVec = std::vector<Stats::RefcountPtr<Stats::Metric>>;
+
+  // Moves to the next phase and groups the stats it covers.
+  void nextPhase();
+  template <class StatType>
+  void populateGroups(const std::vector<Stats::RefcountPtr<StatType>>& metrics);
+  // Renders the metrics of the first group from group_index_ on, until the chunk is full.
+  // @return whether the whole group was rendered.
+  bool renderTextGroup(MetricVec& metrics, Buffer::Instance& response, uint64_t chunk_end);
+  void renderProtobufGroup(const MetricVec& metrics, Buffer::Instance& response);
+
+  Stats::Store& stats_;
+  const StatsParams params_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  const Format format_;
+  Phase phase_{Phase::Counters};
+  std::map<Stats::StatName, MetricVec, Stats::StatNameLessThan> groups_;
+  // Prefixed name of the first group, once its rendering has started.
+  absl::optional<std::string> group_name_;
+  // Index of the next metric of the first group to render.
+  size_t group_index_{0};
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -80,16 +80,7 @@ Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   }
 
   if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    Buffer::OwnedImpl response;
-    prometheusFlushAndRender(params, response);
-    return Admin::makeStaticTextRequest(response, code);
+    return makePrometheusRequest(params, admin_stream);
   }
 
   if (server_.statsConfig().flushOnAdmin()) {
@@ -105,33 +96,29 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params, url_handler_fn);
 }
 
-Http::Code StatsHandler::handlerPrometheusStats(Http::ResponseHeaderMap&,
-                                                Buffer::Instance& response,
-                                                AdminStream& admin_stream) {
-  return prometheusStats(admin_stream.getRequestHeaders().getPathValue(), response);
-}
-
-Http::Code StatsHandler::prometheusStats(absl::string_view path_and_query,
-                                         Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(AdminStream& admin_stream) {
   StatsParams params;
-  Http::Code code = params.parse(path_and_query, response);
+  Buffer::OwnedImpl response;
+  Http::Code code = params.parse(admin_stream.getRequestHeaders().getPathValue(), response);
   if (code != Http::Code::OK) {
-    return code;
+    return Admin::makeStaticTextRequest(response, code);
   }
+  return makePrometheusRequest(params, admin_stream);
+}
 
+Admin::RequestPtr StatsHandler::makePrometheusRequest(const StatsParams& params,
+                                                      AdminStream& admin_stream) {
   if (server_.statsConfig().flushOnAdmin()) {
     server_.flushStats();
   }
 
-  prometheusFlushAndRender(params, response);
-  return Http::Code::OK;
-}
-
-void StatsHandler::prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response) {
-  if (server_.statsConfig().flushOnAdmin()) {
-    server_.flushStats();
+  PrometheusStatsRequest::Format format = PrometheusStatsRequest::Format::Text;
+  const auto accept = admin_stream.getRequestHeaders().get(Http::CustomHeaders::get().Accept);
+  if (!accept.empty()) {
+    format = PrometheusStatsRequest::formatFromAcceptHeader(accept[0]->value().getStringView());
   }
-  prometheusRender(server_.stats(), server_.api().customStatNamespaces(), params, response);
+  return std::make_unique<PrometheusStatsRequest>(server_.stats(), params,
+                                                  server_.api().customStatNamespaces(), format);
 }
 
 void StatsHandler::prometheusRender(Stats::Store& stats,
@@ -163,6 +150,23 @@ Http::Code StatsHandler::handlerContention(Http::ResponseHeaderMap& response_hea
   return Http::Code::OK;
 }
 
+Admin::UrlHandler StatsHandler::prometheusStatsHandler() {
+  return {"/stats/prometheus",
+          "print server stats in prometheus format",
+          [this](AdminStream& admin_stream) -> Admin::RequestPtr {
+            return makePrometheusRequest(admin_stream);
+          },
+          false,
+          false,
+          {{Admin::ParamDescriptor::Type::Boolean, "usedonly",
+            "Only include stats that have been written by system since restart"},
+           {Admin::ParamDescriptor::Type::Boolean, "text_readouts",
+            "Render text_readouts as new gaugues with value 0 (increases Prometheus "
+            "data size)"},
+           {Admin::ParamDescriptor::Type::String, "filter",
+            "Regular expression (Google re2) for filtering stats"}}};
+}
+
 Admin::UrlHandler StatsHandler::statsHandler() {
   return {
       "/stats",
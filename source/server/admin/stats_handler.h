@@ -33,26 +33,15 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
 
   /**
-   * Parses and executes a prometheus stats request.
+   * Creates a streaming prometheus stats request.
    *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
-   */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
+   * @param admin_stream the admin stream of the request; the accept header selects between the
+   *        text and protobuf exposition formats.
+   * @return the request.
    */
-  void prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
 
   /**
    * Renders the stats as prometheus. This is broken out as a separately
@@ -83,6 +72,11 @@ public:
    */
   Admin::UrlHandler statsHandler();
 
+  /**
+   * @return a URL handler streaming the stats in prometheus format.
+   */
+  Admin::UrlHandler prometheusStatsHandler();
+
   static Admin::RequestPtr makeRequest(Stats::Store& stats, const StatsParams& params,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
@@ -90,9 +84,7 @@ public:
   //                                     StatsRequest::UrlHandlerFn url_handler_fn);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params, AdminStream& admin_stream);
 };
 
 } // namespace Server
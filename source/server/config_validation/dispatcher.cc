@@ -19,7 +19,8 @@ Network::ClientConnectionPtr ValidationDispatcher::createClientConnection(
 
 Network::ListenerPtr ValidationDispatcher::createListener(Network::SocketSharedPtr&&,
                                                           Network::TcpListenerCallbacks&,
-                                                          Runtime::Loader&, bool, bool) {
+                                                          Runtime::Loader&, bool, bool,
+                                                          uint32_t) {
   return nullptr;
 }
 
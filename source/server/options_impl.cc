@@ -144,6 +144,8 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "", "enable-mutex-tracing", "Enable mutex contention tracing functionality", cmd, false);
   TCLAP::SwitchArg cpuset_threads(
       "", "cpuset-threads", "Get the default # of worker threads from cpuset size", cmd, false);
+  TCLAP::SwitchArg pin_worker_threads(
+      "", "pin-worker-threads", "Pin each worker thread to the CPU matching its index", cmd, false);
 
   TCLAP::ValueArg<std::string> disable_extensions("", "disable-extensions",
                                                   "Comma-separated list of extensions to disable",
@@ -190,6 +192,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   core_dump_enabled_ = enable_core_dump.getValue();
 
   cpuset_threads_ = cpuset_threads.getValue();
+  pin_worker_threads_ = pin_worker_threads.getValue();
 
   if (log_level.isSet()) {
     log_level_ = parseAndValidateLogLevel(log_level.getValue());
@@ -431,6 +434,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
+  command_line_options->set_pin_worker_threads(pinWorkerThreadsEnabled());
   command_line_options->set_restart_epoch(restartEpoch());
   for (const auto& e : disabledExtensions()) {
     command_line_options->add_disabled_extensions(e);
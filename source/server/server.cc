@@ -26,6 +26,7 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/common/utility.h"
@@ -38,6 +39,7 @@
 #include "source/common/http/codes.h"
 #include "source/common/http/headers.h"
 #include "source/common/local_info/local_info_impl.h"
+#include "source/common/memory/huge_page_region.h"
 #include "source/common/memory/stats.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
@@ -100,7 +102,8 @@ InstanceImpl::InstanceImpl(
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
                           store),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
-      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
+      handler_(getHandler(*dispatcher_)),
+      worker_factory_(thread_local_, *api_, hooks, options.pinWorkerThreadsEnabled()),
       terminated_(false),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
@@ -242,15 +245,59 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_sou
   snapshot_time_ = time_source.systemTime();
 }
 
+DeltaMetricSnapshotImpl::DeltaMetricSnapshotImpl(MetricSnapshotImpl& snapshot,
+                                                 FlushedGaugeValues& flushed_gauge_values)
+    : snapshot_time_(snapshot.snapshotTime()) {
+  for (const auto& counter : snapshot.counters()) {
+    if (counter.delta_ > 0) {
+      counters_.push_back(counter);
+    }
+  }
+
+  // Rebuild the flushed values from scratch so that gauges which are no longer sinked are released.
+  FlushedGaugeValues gauge_values;
+  gauge_values.reserve(snapshot.snappedGauges().size());
+  for (const Stats::GaugeSharedPtr& gauge : snapshot.snappedGauges()) {
+    const uint64_t value = gauge->value();
+    if (gauge->used()) {
+      auto it = flushed_gauge_values.find(gauge.get());
+      if (it == flushed_gauge_values.end() || it->second.second != value) {
+        gauges_.push_back(*gauge);
+      }
+    }
+    gauge_values.emplace(gauge.get(), std::make_pair(gauge, value));
+  }
+  flushed_gauge_values = std::move(gauge_values);
+
+  for (const auto& histogram : snapshot.histograms()) {
+    if (histogram.get().intervalStatistics().sampleCount() > 0) {
+      histograms_.push_back(histogram);
+    }
+  }
+
+  // Text readouts don't track changes and are rare, so they are always included.
+  text_readouts_ = snapshot.textReadouts();
+}
+
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source,
+                                       FlushedGaugeValues& flushed_gauge_values) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
   MetricSnapshotImpl snapshot(store, time_source);
+  // Built lazily since it only pays off for sinks that opted in, and shared between them.
+  std::unique_ptr<DeltaMetricSnapshotImpl> delta_snapshot;
   for (const auto& sink : sinks) {
-    sink->flush(snapshot);
+    if (sink->deltaSnapshots()) {
+      if (delta_snapshot == nullptr) {
+        delta_snapshot = std::make_unique<DeltaMetricSnapshotImpl>(snapshot, flushed_gauge_values);
+      }
+      sink->flush(*delta_snapshot);
+    } else {
+      sink->flush(snapshot);
+    }
   }
 }
 
@@ -307,7 +354,8 @@ void InstanceImpl::updateServerStats() {
 void InstanceImpl::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
-  InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, timeSource());
+  InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, timeSource(),
+                                    flushed_gauge_values_);
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
@@ -413,6 +461,16 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
                                     messageValidationContext().staticValidationVisitor(), *api_);
   bootstrap_config_update_time_ = time_source_.systemTime();
 
+  if (bootstrap_.has_huge_page_buffer_region()) {
+    const auto& region = bootstrap_.huge_page_buffer_region();
+    if (!Memory::HugePageRegion::initializeForBuffers(region.size_bytes(),
+                                                      Buffer::Slice::default_slice_size_,
+                                                      region.explicit_huge_pages())) {
+      throw EnvoyException(
+          fmt::format("unable to map a huge page buffer region of {} bytes", region.size_bytes()));
+    }
+  }
+
 #ifdef ENVOY_PERFETTO
   perfetto::TracingInitArgs args;
   // Include in-process events only.
@@ -48,6 +48,7 @@
 #include "source/server/overload_manager_impl.h"
 #include "source/server/worker_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -115,6 +116,13 @@ public:
   virtual Runtime::LoaderPtr createRuntime(Instance& server, Configuration::Initial& config) PURE;
 };
 
+/**
+ * Values of the gauges handed to delta snapshot sinks on the previous flush. Each entry holds a
+ * reference to its gauge so that the address can't be reused by another gauge in the meantime.
+ */
+using FlushedGaugeValues =
+    absl::flat_hash_map<const Stats::Gauge*, std::pair<Stats::GaugeSharedPtr, uint64_t>>;
+
 /**
  * Helpers used during server creation.
  */
@@ -131,9 +139,12 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param flushed_gauge_values supplies the gauge values handed to delta snapshot sinks on the
+   *        previous flush. It is updated with the current values if any sink uses delta snapshots.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  TimeSource& time_source);
+                                  TimeSource& time_source,
+                                  FlushedGaugeValues& flushed_gauge_values);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -402,6 +413,8 @@ private:
   bool enable_reuse_port_default_;
   Regex::EnginePtr regex_engine_;
 
+  FlushedGaugeValues flushed_gauge_values_;
+
   bool stats_flush_in_progress_ : 1;
 
   template <class T>
@@ -441,6 +454,8 @@ public:
   }
   SystemTime snapshotTime() const override { return snapshot_time_; }
 
+  const std::vector<Stats::GaugeSharedPtr>& snappedGauges() const { return snapped_gauges_; }
+
 private:
   std::vector<Stats::CounterSharedPtr> snapped_counters_;
   std::vector<CounterSnapshot> counters_;
@@ -453,5 +468,32 @@ private:
   SystemTime snapshot_time_;
 };
 
+// Stats::MetricSnapshot handed to sinks that opted in to delta snapshots. It is a filtered view of
+// a full snapshot, which must outlive it.
+class DeltaMetricSnapshotImpl : public Stats::MetricSnapshot {
+public:
+  DeltaMetricSnapshotImpl(MetricSnapshotImpl& snapshot, FlushedGaugeValues& flushed_gauge_values);
+
+  // Stats::MetricSnapshot
+  const std::vector<CounterSnapshot>& counters() override { return counters_; }
+  const std::vector<std::reference_wrapper<const Stats::Gauge>>& gauges() override {
+    return gauges_;
+  }
+  const std::vector<std::reference_wrapper<const Stats::ParentHistogram>>& histograms() override {
+    return histograms_;
+  }
+  const std::vector<std::reference_wrapper<const Stats::TextReadout>>& textReadouts() override {
+    return text_readouts_;
+  }
+  SystemTime snapshotTime() const override { return snapshot_time_; }
+
+private:
+  std::vector<CounterSnapshot> counters_;
+  std::vector<std::reference_wrapper<const Stats::Gauge>> gauges_;
+  std::vector<std::reference_wrapper<const Stats::ParentHistogram>> histograms_;
+  std::vector<std::reference_wrapper<const Stats::TextReadout>> text_readouts_;
+  const SystemTime snapshot_time_;
+};
+
 } // namespace Server
 } // namespace Envoy
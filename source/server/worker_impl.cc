@@ -9,11 +9,42 @@
 #include "envoy/server/configuration.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/config/utility.h"
 #include "source/server/listener_manager_factory.h"
 
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Server {
+namespace {
+
+// Returns the CPUs in the affinity mask of the process, in ascending order. Returns an empty vector
+// if the mask cannot be read or the platform has no such mask.
+std::vector<uint32_t> allowedCpus() {
+  std::vector<uint32_t> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    return cpus;
+  }
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+#endif
+  return cpus;
+}
+
+} // namespace
 
 std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher, uint32_t index) {
 
@@ -26,22 +57,42 @@ std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher, uin
   return nullptr;
 }
 
+ProdWorkerFactory::ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api,
+                                     ListenerHooks& hooks, bool pin_worker_threads)
+    : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks),
+      pin_worker_threads_(pin_worker_threads),
+      allowed_cpus_(pin_worker_threads ? allowedCpus() : std::vector<uint32_t>{}) {}
+
+absl::optional<uint32_t> ProdWorkerFactory::workerCpu(uint32_t index) const {
+  if (!pin_worker_threads_) {
+    return absl::nullopt;
+  }
+  if (allowed_cpus_.empty()) {
+    // Without a known affinity mask fall back to the worker index, pinning fails for CPUs the
+    // process cannot use and the worker runs unpinned.
+    return index;
+  }
+  return allowed_cpus_[index % allowed_cpus_.size()];
+}
+
 WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overload_manager,
                                           const std::string& worker_name) {
   Event::DispatcherPtr dispatcher(
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
   auto conn_handler = getHandler(*dispatcher, index);
-  return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+  return std::make_unique<WorkerImpl>(
+      tls_, hooks_, std::move(dispatcher), std::move(conn_handler), overload_manager, api_,
+      stat_names_, workerCpu(index));
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, absl::optional<uint32_t> cpu)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      cpu_(cpu) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -106,7 +157,7 @@ void WorkerImpl::start(GuardDog& guard_dog, const Event::PostCb& cb) {
   //
   // TODO(jmarantz): consider refactoring how this naming works so this naming
   // architecture is centralized, resulting in clearer names.
-  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name())};
+  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name()), cpu_};
   thread_ = api_.threadFactory().createThread(
       [this, &guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
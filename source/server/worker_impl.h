@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/api/api.h"
 #include "envoy/network/connection_handler.h"
@@ -28,18 +29,30 @@ struct WorkerStatNames {
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
-  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
-      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
+  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks,
+                    bool pin_worker_threads);
 
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
                          const std::string& worker_name) override;
 
+  /**
+   * @return the CPU worker index is pinned to, or absl::nullopt if workers are not pinned. Worker N
+   *         is pinned to the Nth CPU the process is allowed to run on, wrapping around when there
+   *         are more workers than CPUs, so that workers stay within the CPUs (and hence the NUMA
+   *         nodes) the process was started on.
+   */
+  absl::optional<uint32_t> workerCpu(uint32_t index) const;
+
 private:
   ThreadLocal::Instance& tls_;
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  const bool pin_worker_threads_;
+  // The CPUs the process was allowed to run on when the factory was created, in ascending order.
+  // Empty if workers are not pinned or the affinity of the process could not be read.
+  const std::vector<uint32_t> allowed_cpus_;
 };
 
 /**
@@ -49,7 +62,7 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names, absl::optional<uint32_t> cpu);
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -77,6 +90,8 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  // The CPU the worker thread is pinned to, if any.
+  const absl::optional<uint32_t> cpu_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
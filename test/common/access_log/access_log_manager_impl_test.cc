@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -11,6 +13,9 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -486,6 +491,56 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+// Records of each thread are written in order, including when some of them don't fit into the ring
+// buffer of the thread and go through the shared buffer instead.
+TEST_F(AccessLogManagerImplTest, ConcurrentWritersKeepOrder) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  Thread::MutexBasicLockable written_lock;
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        Thread::LockGuard lock(written_lock);
+        absl::StrAppend(&written, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr uint32_t NumThreads = 4;
+  constexpr uint32_t NumRecords = 2000;
+  // Larger than the ring buffers.
+  const std::string padding(1024 * 70, 'x');
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t t = 0; t < NumThreads; ++t) {
+    threads.push_back(thread_factory_.createThread([&, t]() {
+      for (uint32_t i = 0; i < NumRecords; ++i) {
+        log_file->write(absl::StrCat(t, " ", i, i % 500 == 0 ? padding : "", "\n"));
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+  EXPECT_LT(0, store_.counter("filesystem.write_ring_buffer_full").value());
+
+  Thread::LockGuard lock(written_lock);
+  std::vector<uint32_t> next_record(NumThreads, 0);
+  for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+    std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+    ASSERT_EQ(2, fields.size());
+    uint32_t t;
+    ASSERT_TRUE(absl::SimpleAtoi(fields[0], &t));
+    ASSERT_LT(t, NumThreads);
+    EXPECT_EQ(absl::StrCat(next_record[t], next_record[t] % 500 == 0 ? padding : ""), fields[1]);
+    ++next_record[t];
+  }
+  EXPECT_EQ(std::vector<uint32_t>(NumThreads, NumRecords), next_record);
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
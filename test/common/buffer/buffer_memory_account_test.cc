@@ -5,7 +5,9 @@
 
 #include "source/common/buffer/buffer_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/integration/tracked_watermark_buffer.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/http/stream_reset_handler.h"
 
 #include "gmock/gmock.h"
@@ -16,6 +18,7 @@ namespace Buffer {
 namespace {
 
 using testing::_;
+using testing::NiceMock;
 
 using MemoryClassesToAccountsSet = std::array<absl::flat_hash_set<BufferMemoryAccountSharedPtr>,
                                               BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_>;
@@ -493,6 +496,96 @@ TEST(WatermarkBufferFactoryTest, DefaultsToEffectivelyNotTracking) {
   EXPECT_EQ(factory.bitshift(), 63); // Too large for any reasonable account size.
 }
 
+// Hands out the schedulable callbacks of a dispatcher.
+class DispatcherCallbackScheduler : public Event::CallbackScheduler {
+public:
+  explicit DispatcherCallbackScheduler(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  Event::SchedulableCallbackPtr
+  createSchedulableCallback(const std::function<void()>& cb) override {
+    return dispatcher_.createSchedulableCallback(cb);
+  }
+
+private:
+  Event::Dispatcher& dispatcher_;
+};
+
+TEST(WatermarkBufferFactoryTest, ResetsLargestStreamsOverMaxWorkerAccountBytes) {
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  config.mutable_max_worker_account_bytes()->set_value(8 * kMinimumBalanceToTrack);
+  WatermarkBufferFactory factory(config);
+  NiceMock<Event::MockDispatcher> dispatcher;
+  auto* reset_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher);
+  DispatcherCallbackScheduler scheduler(dispatcher);
+  factory.initializeScheduler(scheduler);
+
+  Http::MockStreamResetHandler large_stream;
+  Http::MockStreamResetHandler small_stream;
+  auto large_account = factory.createAccount(large_stream);
+  auto small_account = factory.createAccount(small_stream);
+
+  // The accounts may hold up to the maximum.
+  EXPECT_CALL(*reset_cb, scheduleCallbackCurrentIteration()).Times(0);
+  large_account->charge(8 * kMinimumBalanceToTrack);
+  testing::Mock::VerifyAndClearExpectations(reset_cb);
+
+  // Going over it schedules a single reset, however much more is charged.
+  EXPECT_CALL(*reset_cb, scheduleCallbackCurrentIteration());
+  small_account->charge(kMinimumBalanceToTrack);
+  small_account->charge(kMinimumBalanceToTrack);
+  testing::Mock::VerifyAndClearExpectations(reset_cb);
+
+  // The streams of the largest bucket are reset.
+  EXPECT_CALL(small_stream, resetStream(_)).Times(0);
+  EXPECT_CALL(large_stream, resetStream(_)).WillOnce(Invoke([&]() {
+    large_account->credit(getBalance(large_account));
+    large_account->clearDownstream();
+  }));
+  reset_cb->invokeCallback();
+
+  // Once back under the maximum, going over it again schedules another reset.
+  EXPECT_CALL(*reset_cb, scheduleCallbackCurrentIteration());
+  small_account->charge(8 * kMinimumBalanceToTrack);
+
+  small_account->credit(getBalance(small_account));
+  small_account->clearDownstream();
+}
+
+TEST(WatermarkBufferFactoryTest, ReportsBalancesOfAccountsInGauge) {
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  Stats::TestUtil::TestStore store;
+  // The gauge is shared by the factories of all the workers.
+  WatermarkBufferFactory factory(config, *store.rootScope());
+  WatermarkBufferFactory other_factory(config, *store.rootScope());
+  Stats::Gauge& gauge = store.gauge("server.memory_buffer_accounts",
+                                    Stats::Gauge::ImportMode::NeverImport);
+
+  Http::MockStreamResetHandler stream;
+  Http::MockStreamResetHandler other_stream;
+  auto account = factory.createAccount(stream);
+  auto other_account = other_factory.createAccount(other_stream);
+  account->charge(100);
+  other_account->charge(20);
+  EXPECT_EQ(gauge.value(), 120);
+
+  account->credit(100);
+  EXPECT_EQ(gauge.value(), 20);
+
+  account->clearDownstream();
+  other_account->credit(20);
+  other_account->clearDownstream();
+  EXPECT_EQ(gauge.value(), 0);
+}
+
+TEST(WatermarkBufferFactoryTest, NoGaugeWithoutAccountTracking) {
+  Stats::TestUtil::TestStore store;
+  WatermarkBufferFactory factory(envoy::config::overload::v3::BufferFactoryConfig(),
+                                 *store.rootScope());
+  EXPECT_FALSE(store.findGaugeByString("server.memory_buffer_accounts").has_value());
+}
+
 TEST(WatermarkBufferFactoryTest, ShouldOnlyResetAllStreamsGreatThanOrEqualToProvidedIndex) {
   TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
   Http::MockStreamResetHandler largest_stream_to_reset;
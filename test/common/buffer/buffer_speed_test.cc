@@ -320,6 +320,38 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test sustained churn of a streaming proxy: each iteration reads a full reservation into the
+// buffer and drains everything, so slice storage is allocated and released continuously.
+static void bufferReadDrainChurn(benchmark::State& state) {
+  Buffer::OwnedImpl buffer;
+  const uint64_t size = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::Reservation reservation = buffer.reserveForReadWithLengthForTest(size);
+    reservation.commit(reservation.length());
+    buffer.drain(buffer.length());
+  }
+  benchmark::DoNotOptimize(buffer.length());
+}
+BENCHMARK(bufferReadDrainChurn)->Arg(16 * 1024)->Arg(64 * 1024)->Arg(128 * 1024);
+
+// Test sustained churn of data added to and drained from a buffer in default slice sized chunks,
+// as done when filters copy data between buffers.
+static void bufferAddDrainChurn(benchmark::State& state) {
+  Buffer::OwnedImpl buffer;
+  const std::string data(Buffer::Slice::default_slice_size_, 'a');
+  const uint64_t slices = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (uint64_t i = 0; i < slices; i++) {
+      buffer.add(data);
+    }
+    buffer.drain(buffer.length());
+  }
+  benchmark::DoNotOptimize(buffer.length());
+}
+BENCHMARK(bufferAddDrainChurn)->Arg(1)->Arg(8)->Arg(32);
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
@@ -7,6 +7,7 @@
 
 #include "test/common/buffer/utility.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -291,6 +292,59 @@ TEST_F(OwnedSliceTest, Drain) {
   EXPECT_EQ(original_size, slice.reservableSize());
 }
 
+TEST(SliceStorageCacheTest, ReuseDefaultSizedStorage) {
+  const uint32_t cached = Slice::cachedStorages();
+  const uint8_t* storage;
+  {
+    Slice slice(Slice::default_slice_size_, nullptr);
+    storage = slice.data();
+  }
+  EXPECT_EQ(std::min(cached + 1, Slice::max_cached_storages_), Slice::cachedStorages());
+
+  // The most recently released storage is handed out first.
+  if (cached < Slice::max_cached_storages_) {
+    Slice slice(Slice::default_slice_size_, nullptr);
+    EXPECT_EQ(storage, slice.data());
+  }
+}
+
+TEST(SliceStorageCacheTest, OtherSizesAreNotCached) {
+  const uint32_t cached = Slice::cachedStorages();
+  { Slice slice(Slice::default_slice_size_ * 2, nullptr); }
+  { Slice slice(4096, nullptr); }
+  EXPECT_EQ(cached, Slice::cachedStorages());
+}
+
+TEST(SliceStorageCacheTest, CacheIsBounded) {
+  std::vector<Slice> slices;
+  for (uint32_t i = 0; i < Slice::max_cached_storages_ * 2; i++) {
+    slices.emplace_back(Slice::default_slice_size_, nullptr);
+  }
+  EXPECT_EQ(0, Slice::cachedStorages());
+  slices.clear();
+  EXPECT_EQ(Slice::max_cached_storages_, Slice::cachedStorages());
+}
+
+TEST(SliceStorageCacheTest, StorageReturnsToDestroyingThread) {
+  std::unique_ptr<Slice> slice;
+  uint32_t creating_thread_cached = 0;
+  auto thread = Thread::threadFactoryForTest().createThread([&]() {
+    slice = std::make_unique<Slice>(Slice::default_slice_size_, nullptr);
+    creating_thread_cached = Slice::cachedStorages();
+  });
+  thread->join();
+  EXPECT_EQ(0, creating_thread_cached);
+
+  // The slice migrated to this thread, so its storage refills the cache of this thread.
+  const uint32_t cached = Slice::cachedStorages();
+  const uint8_t* storage = slice->data();
+  slice.reset();
+  EXPECT_EQ(std::min(cached + 1, Slice::max_cached_storages_), Slice::cachedStorages());
+  if (cached < Slice::max_cached_storages_) {
+    EXPECT_EQ(storage, Slice(Slice::default_slice_size_, nullptr).data());
+  }
+}
+
 TEST(UnownedSliceTest, CreateDelete) {
   constexpr char input[] = "hello world";
   bool release_callback_called = false;
@@ -68,6 +68,16 @@ TEST_F(WatermarkBufferTest, AddBuffer) {
   EXPECT_EQ(11, buffer_.length());
 }
 
+TEST_F(WatermarkBufferTest, AddBufferFragment) {
+  BufferFragmentImpl first(TEN_BYTES, 10, nullptr);
+  buffer_.addBufferFragment(first);
+  EXPECT_EQ(0, times_high_watermark_called_);
+  BufferFragmentImpl second("a", 1, nullptr);
+  buffer_.addBufferFragment(second);
+  EXPECT_EQ(1, times_high_watermark_called_);
+  EXPECT_EQ(11, buffer_.length());
+}
+
 TEST_F(WatermarkBufferTest, Prepend) {
   std::string suffix = "World!", prefix = "Hello, ";
 
@@ -269,6 +269,29 @@ TEST(LoggerTest, LogWithLogDetails) {
   ENVOY_LOG_MISC(info, "hello");
 }
 
+// Each thread formats with its own copy of the formatter, which must follow format changes.
+TEST(LoggerTest, LogFormatChangeAppliesToAllThreads) {
+  Envoy::Logger::Registry::setLogLevel(spdlog::level::info);
+
+  MockLogSink sink(Envoy::Logger::Registry::getSink());
+  const auto expect_log = [&sink](const std::string& expected) {
+    EXPECT_CALL(sink, log(_, _)).WillOnce(Invoke([expected](auto msg, auto&) {
+      EXPECT_EQ(absl::StrCat(expected, TestEnvironment::newLine), msg);
+    }));
+    ENVOY_LOG_MISC(info, "hello");
+  };
+
+  Envoy::Logger::Registry::getSink()->set_pattern("first %v");
+  expect_log("first hello");
+  std::thread([&]() { expect_log("first hello"); }).join();
+
+  Envoy::Logger::Registry::getSink()->set_pattern("second %v");
+  expect_log("second hello");
+  std::thread([&]() { expect_log("second hello"); }).join();
+
+  Envoy::Logger::Registry::setLogFormat(Envoy::Logger::Logger::DEFAULT_LOG_FORMAT);
+}
+
 } // namespace
 } // namespace Logger
 } // namespace Envoy
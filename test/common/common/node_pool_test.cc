@@ -0,0 +1,83 @@
+#include <list>
+#include <string>
+#include <vector>
+
+#include "source/common/common/node_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+using PooledList = std::list<std::string, NodePoolAllocator<std::string>>;
+
+TEST(NodePoolTest, SlabsGrowGeometrically) {
+  NodePool pool(2, 8);
+  PooledList list{NodePoolAllocator<std::string>(pool)};
+  EXPECT_EQ(0, pool.numSlabs());
+
+  // Slabs of 2, 4 and 8 nodes.
+  for (int i = 0; i < 14; ++i) {
+    list.emplace_back(std::to_string(i));
+  }
+  EXPECT_EQ(3, pool.numSlabs());
+
+  // Further slabs are capped at 8 nodes.
+  list.emplace_back("14");
+  EXPECT_EQ(4, pool.numSlabs());
+  for (int i = 15; i < 22; ++i) {
+    list.emplace_back(std::to_string(i));
+  }
+  EXPECT_EQ(4, pool.numSlabs());
+}
+
+TEST(NodePoolTest, ReusesReleasedNodes) {
+  NodePool pool(4, 4);
+  PooledList list{NodePoolAllocator<std::string>(pool)};
+  for (int i = 0; i < 4; ++i) {
+    list.emplace_back(std::to_string(i));
+  }
+  EXPECT_EQ(1, pool.numSlabs());
+
+  list.pop_front();
+  list.pop_back();
+  list.emplace_front("a");
+  list.emplace_back("b");
+  EXPECT_EQ(1, pool.numSlabs());
+  EXPECT_EQ((std::vector<std::string>{"a", "1", "2", "b"}),
+            std::vector<std::string>(list.begin(), list.end()));
+
+  list.clear();
+  for (int i = 0; i < 4; ++i) {
+    list.emplace_back(std::string(100, 'x'));
+  }
+  EXPECT_EQ(1, pool.numSlabs());
+}
+
+TEST(NodePoolTest, OtherSizesUseGlobalAllocator) {
+  NodePool pool;
+  NodePoolAllocator<uint64_t> allocator(pool);
+  uint64_t* node = allocator.allocate(1);
+  EXPECT_EQ(1, pool.numSlabs());
+
+  // Arrays and rebound types of a different size do not come from the slabs.
+  uint64_t* array = allocator.allocate(3);
+  NodePoolAllocator<std::string> rebound(allocator);
+  std::string* str = rebound.allocate(1);
+  EXPECT_EQ(1, pool.numSlabs());
+  EXPECT_TRUE(rebound == allocator);
+
+  rebound.deallocate(str, 1);
+  allocator.deallocate(array, 3);
+  allocator.deallocate(node, 1);
+}
+
+TEST(NodePoolTest, AllocatorEquality) {
+  NodePool pool1;
+  NodePool pool2;
+  EXPECT_TRUE(NodePoolAllocator<int>(pool1) == NodePoolAllocator<int>(pool1));
+  EXPECT_TRUE(NodePoolAllocator<int>(pool1) != NodePoolAllocator<int>(pool2));
+}
+
+} // namespace
+} // namespace Envoy
@@ -1,13 +1,18 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from
 // a quiescent system with disabled cstate power management.
 
+#include <memory>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 // NOLINT(namespace-envoy)
 
@@ -126,3 +131,60 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+// Generates `count` OpenAPI style path patterns; the input returned by routePatternInput() is only
+// matched by the last one.
+static std::vector<std::string> routePatterns(int64_t count) {
+  std::vector<std::string> patterns;
+  patterns.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    patterns.push_back(absl::StrCat("/shelves/[^/]+/route_", i));
+  }
+  return patterns;
+}
+
+static std::string routePatternInput(int64_t count) {
+  return absl::StrCat("/shelves/shelf_1/route_", count - 1);
+}
+
+// Matches an input against each of `state.range(0)` patterns in turn, the way route selection
+// evaluates regex routes one at a time.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_IndividualPatterns(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& pattern : routePatterns(state.range(0))) {
+    regexes.push_back(std::make_unique<re2::RE2>(pattern));
+  }
+  const std::string input = routePatternInput(state.range(0));
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const auto& regex : regexes) {
+      if (re2::RE2::FullMatch(input, *regex)) {
+        ++passes;
+        break;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_IndividualPatterns)->Arg(100)->Arg(1000);
+
+// Matches an input against `state.range(0)` patterns compiled into a single RE2::Set.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_PatternSet(benchmark::State& state) {
+  re2::RE2::Set set(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH);
+  for (const std::string& pattern : routePatterns(state.range(0))) {
+    RELEASE_ASSERT(set.Add(pattern, nullptr) >= 0, "");
+  }
+  RELEASE_ASSERT(set.Compile(), "");
+  const std::string input = routePatternInput(state.range(0));
+  uint32_t passes = 0;
+  std::vector<int> matches;
+  for (auto _ : state) { // NOLINT
+    if (set.Match(input, &matches)) {
+      ++passes;
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_PatternSet)->Arg(100)->Arg(1000);
@@ -154,6 +154,27 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+// Matchers compiled from the same pattern share its program, which has to outlive each of them.
+TEST(CompiledGoogleReMatcher, SamePattern) {
+  auto first = std::make_unique<CompiledGoogleReMatcher>("/shared/[0-9]+", false);
+  auto second = std::make_unique<CompiledGoogleReMatcher>("/shared/[0-9]+", false);
+  EXPECT_TRUE(first->match("/shared/1"));
+  EXPECT_TRUE(second->match("/shared/2"));
+
+  first.reset();
+  EXPECT_TRUE(second->match("/shared/3"));
+  EXPECT_FALSE(second->match("/shared/a"));
+  EXPECT_EQ("/shared/n", second->replaceAll("/shared/4", "/shared/n"));
+
+  second.reset();
+  CompiledGoogleReMatcher third("/shared/[0-9]+", false);
+  EXPECT_TRUE(third.match("/shared/5"));
+
+  // Invalid patterns fail every time rather than being cached.
+  EXPECT_THROW(CompiledGoogleReMatcher("(+invalid)", false), EnvoyException);
+  EXPECT_THROW(CompiledGoogleReMatcher("(+invalid)", false), EnvoyException);
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
@@ -0,0 +1,85 @@
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/spsc_ring_buffer.h"
+#include "source/common/common/thread.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/strings/str_cat.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(SpscRingBufferTest, WriteAndDrain) {
+  SpscRingBuffer ring(16);
+  EXPECT_EQ(16, ring.capacity());
+  EXPECT_EQ(0, ring.readableBytes());
+
+  Buffer::OwnedImpl output;
+  EXPECT_EQ(0, ring.drainTo(output));
+  EXPECT_EQ(0, output.length());
+
+  EXPECT_TRUE(ring.write("hello "));
+  EXPECT_TRUE(ring.write("world"));
+  EXPECT_EQ(11, ring.readableBytes());
+  EXPECT_EQ(11, ring.drainTo(output));
+  EXPECT_EQ("hello world", output.toString());
+  EXPECT_EQ(0, ring.readableBytes());
+}
+
+TEST(SpscRingBufferTest, RejectsDataThatDoesNotFit) {
+  SpscRingBuffer ring(8);
+  EXPECT_FALSE(ring.write("123456789"));
+  EXPECT_TRUE(ring.write("12345"));
+  EXPECT_FALSE(ring.write("6789"));
+  EXPECT_TRUE(ring.write("678"));
+  EXPECT_FALSE(ring.write("9"));
+
+  Buffer::OwnedImpl output;
+  EXPECT_EQ(8, ring.drainTo(output));
+  EXPECT_EQ("12345678", output.toString());
+  EXPECT_TRUE(ring.write("9"));
+}
+
+TEST(SpscRingBufferTest, WrapsAround) {
+  SpscRingBuffer ring(8);
+  Buffer::OwnedImpl output;
+  EXPECT_TRUE(ring.write("abcdef"));
+  EXPECT_EQ(6, ring.drainTo(output));
+  output.drain(output.length());
+
+  // Written across the end of the storage.
+  EXPECT_TRUE(ring.write("ghijklmn"));
+  EXPECT_EQ(8, ring.drainTo(output));
+  EXPECT_EQ("ghijklmn", output.toString());
+}
+
+TEST(SpscRingBufferTest, ConcurrentProducerAndConsumer) {
+  SpscRingBuffer ring(64);
+  constexpr uint32_t NumRecords = 100000;
+
+  Thread::ThreadPtr producer = Thread::threadFactoryForTest().createThread([&ring]() {
+    for (uint32_t i = 0; i < NumRecords; ++i) {
+      const std::string record = absl::StrCat(i, "\n");
+      while (!ring.write(record)) {
+      }
+    }
+  });
+
+  std::string expected;
+  for (uint32_t i = 0; i < NumRecords; ++i) {
+    absl::StrAppend(&expected, i, "\n");
+  }
+  Buffer::OwnedImpl output;
+  while (output.length() < expected.size()) {
+    ring.drainTo(output);
+  }
+  producer->join();
+  EXPECT_EQ(expected, output.toString());
+}
+
+} // namespace
+} // namespace Envoy
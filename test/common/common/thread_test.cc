@@ -231,6 +231,41 @@ TEST_F(ThreadAsyncPtrTest, TruncateNoWait) {
   thread->join();
 }
 
+#ifdef __linux__
+TEST_F(ThreadAsyncPtrTest, PinnedToCpu) {
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  uint32_t cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+
+  absl::Notification notify;
+  cpu_set_t thread_cpus;
+  CPU_ZERO(&thread_cpus);
+  auto thread = thread_factory_.createThread(
+      [&notify, &thread_cpus]() {
+        notify.WaitForNotification();
+        pthread_getaffinity_np(pthread_self(), sizeof(thread_cpus), &thread_cpus);
+      },
+      Options{"pinned", cpu});
+  notify.Notify();
+  thread->join();
+
+  EXPECT_EQ(1, CPU_COUNT(&thread_cpus));
+  EXPECT_TRUE(CPU_ISSET(cpu, &thread_cpus));
+}
+
+TEST_F(ThreadAsyncPtrTest, PinnedToUnavailableCpu) {
+  // The thread still runs when the CPU cannot be used.
+  absl::Notification ran;
+  auto thread = thread_factory_.createThread([&ran]() { ran.Notify(); },
+                                             Options{"pinned", CPU_SETSIZE - 1});
+  ran.WaitForNotification();
+  thread->join();
+}
+#endif
+
 TEST_F(ThreadAsyncPtrTest, NameNotSpecifiedWait) {
   absl::Notification notify;
   auto thread = thread_factory_.createThread([&notify]() { notify.WaitForNotification(); });
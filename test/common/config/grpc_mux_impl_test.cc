@@ -25,6 +25,7 @@
 #include "test/test_common/logging.h"
 #include "test/test_common/resources.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
@@ -590,6 +591,69 @@ TEST_F(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// Resources unchanged since the previous response are delivered again when they are reused.
+TEST_F(GrpcMuxImplTest, ReuseUnchangedResources) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.xds_reuse_unchanged_resources", "true"}});
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_x;
+  load_assignment_x.set_cluster_name("x");
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_y;
+  load_assignment_y.set_cluster_name("y");
+  const auto expect_update =
+      [this](const std::string& version,
+             const std::vector<envoy::config::endpoint::v3::ClusterLoadAssignment>& expected) {
+        EXPECT_CALL(callbacks_, onConfigUpdate(_, version))
+            .WillOnce(Invoke([expected](const std::vector<DecodedResourceRef>& resources,
+                                        const std::string&) {
+              ASSERT_EQ(expected.size(), resources.size());
+              for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_EQ(expected[i].cluster_name(), resources[i].get().name());
+                EXPECT_TRUE(TestUtility::protoEqual(expected[i], resources[i].get().resource()));
+              }
+            }));
+      };
+
+  for (const std::string& version : std::vector<std::string>{"1", "2"}) {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info(version);
+    response->add_resources()->PackFrom(load_assignment_x);
+    if (version == "2") {
+      response->add_resources()->PackFrom(load_assignment_y);
+      expect_update(version, {load_assignment_x, load_assignment_y});
+    } else {
+      expect_update(version, {load_assignment_x});
+    }
+    expectSendMessage(type_url, {}, version);
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+
+  // An invalid resource is rejected even if the other resources are unchanged.
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("3");
+    response->set_nonce("bad");
+    response->add_resources()->PackFrom(load_assignment_x);
+    response->add_resources()->PackFrom(envoy::config::endpoint::v3::ClusterLoadAssignment());
+    EXPECT_CALL(callbacks_, onConfigUpdateFailed(ConfigUpdateFailureReason::UpdateRejected, _));
+    EXPECT_CALL(async_stream_, sendMessageRaw_(_, false));
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_F(GrpcMuxImplTest, WatchDemux) {
   setup();
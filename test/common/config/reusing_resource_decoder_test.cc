@@ -0,0 +1,136 @@
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/config/reusing_resource_decoder.h"
+#include "source/common/protobuf/message_validator_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+using ClusterLoadAssignment = envoy::config::endpoint::v3::ClusterLoadAssignment;
+
+// Counts the resources decoded by the wrapped decoder.
+class CountingResourceDecoder : public OpaqueResourceDecoderImpl<ClusterLoadAssignment> {
+public:
+  CountingResourceDecoder(ProtobufMessage::ValidationVisitor& validation_visitor)
+      : OpaqueResourceDecoderImpl<ClusterLoadAssignment>(validation_visitor, "cluster_name") {}
+
+  ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) override {
+    decoded_++;
+    return OpaqueResourceDecoderImpl<ClusterLoadAssignment>::decodeResource(resource);
+  }
+
+  uint32_t decoded_{};
+};
+
+class ReusingResourceDecoderTest : public testing::Test {
+public:
+  static ProtobufWkt::Any resource(const std::string& cluster_name) {
+    ClusterLoadAssignment assignment;
+    assignment.set_cluster_name(cluster_name);
+    ProtobufWkt::Any any;
+    any.PackFrom(assignment);
+    return any;
+  }
+
+  void decode(const ProtobufWkt::Any& any) {
+    const ProtobufTypes::MessagePtr message = decoder_.decodeResource(any);
+    ClusterLoadAssignment expected;
+    any.UnpackTo(&expected);
+    EXPECT_THAT(*message, ProtoEq(expected));
+    EXPECT_EQ(expected.cluster_name(), decoder_.resourceName(*message));
+  }
+
+  ProtobufMessage::StrictValidationVisitorImpl validation_visitor_;
+  std::shared_ptr<CountingResourceDecoder> counting_decoder_{
+      std::make_shared<CountingResourceDecoder>(validation_visitor_)};
+  ReusingResourceDecoder decoder_;
+};
+
+// Resources unchanged since the previous accepted response are not decoded again.
+TEST_F(ReusingResourceDecoderTest, ReusesUnchangedResources) {
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("a"));
+  decode(resource("b"));
+  decoder_.finishResponse(true);
+  EXPECT_EQ(2, counting_decoder_->decoded_);
+  EXPECT_EQ(2, decoder_.size());
+
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("a"));
+  decode(resource("c"));
+  decoder_.finishResponse(true);
+  EXPECT_EQ(3, counting_decoder_->decoded_);
+  // The resource missing from the last response is dropped.
+  EXPECT_EQ(2, decoder_.size());
+
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("b"));
+  decoder_.finishResponse(true);
+  EXPECT_EQ(4, counting_decoder_->decoded_);
+}
+
+// The resources of a rejected response are kept along with those of the previous response.
+TEST_F(ReusingResourceDecoderTest, KeepsResourcesOfRejectedResponse) {
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("a"));
+  decoder_.finishResponse(true);
+
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("b"));
+  EXPECT_THROW(decoder_.decodeResource(resource("")), ProtoValidationException);
+  decoder_.finishResponse(false);
+  EXPECT_EQ(2, decoder_.size());
+
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("a"));
+  decode(resource("b"));
+  decoder_.finishResponse(true);
+  EXPECT_EQ(3, counting_decoder_->decoded_);
+}
+
+// An invalid resource is decoded each time, so it is rejected each time.
+TEST_F(ReusingResourceDecoderTest, InvalidResourceNotReused) {
+  for (int i = 0; i < 2; ++i) {
+    decoder_.startResponse(counting_decoder_);
+    EXPECT_THROW(decoder_.decodeResource(resource("")), ProtoValidationException);
+    decoder_.finishResponse(false);
+  }
+  EXPECT_EQ(2, counting_decoder_->decoded_);
+  EXPECT_EQ(0, decoder_.size());
+}
+
+// The resources are not reused across decoders, nor for another type.
+TEST_F(ReusingResourceDecoderTest, NotReusedAcrossDecodersOrTypes) {
+  decoder_.startResponse(counting_decoder_);
+  decode(resource("a"));
+  decoder_.finishResponse(true);
+
+  auto other_decoder = std::make_shared<CountingResourceDecoder>(validation_visitor_);
+  decoder_.startResponse(other_decoder);
+  ProtobufWkt::Any any = resource("a");
+  decode(any);
+  any.set_type_url("type.googleapis.com/envoy.config.cluster.v3.Cluster");
+  EXPECT_THROW_WITH_REGEX(decoder_.decodeResource(any), EnvoyException, "Unable to unpack");
+  decoder_.finishResponse(false);
+  EXPECT_EQ(2, other_decoder->decoded_);
+}
+
+// Empty resources are passed to the wrapped decoder without being kept.
+TEST_F(ReusingResourceDecoderTest, EmptyResourceNotKept) {
+  decoder_.startResponse(counting_decoder_);
+  decode(ProtobufWkt::Any());
+  decoder_.finishResponse(true);
+  EXPECT_EQ(1, counting_decoder_->decoded_);
+  EXPECT_EQ(0, decoder_.size());
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -472,6 +472,29 @@ TEST_F(ConnPoolImplDispatcherBaseTest, NoAvailableStreams) {
   pool_.destructAllConnections();
 }
 
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnect) {
+  ON_CALL(*cluster_, adaptivePreconnect).WillByDefault(Return(true));
+
+  // Without any history, only the connection for the first stream is created.
+  newConnectingClient();
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(ActiveClient::State::Busy, clients_.back()->state());
+
+  // Connections take 100ms and streams arrive every 110ms, so almost one more stream is expected
+  // to arrive while the connection for this one is being established.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(2);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  EXPECT_EQ(3, clients_.size());
+
+  // Clean up.
+  ON_CALL(*cluster_, adaptivePreconnect).WillByDefault(Return(false));
+  EXPECT_CALL(pool_, onPoolFailure);
+  pool_.destructAllConnections();
+}
+
 // Remote close simulates the peer closing the connection.
 TEST_F(ConnPoolImplBaseTest, PoolIdleCallbackTriggeredRemoteClose) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).Times(AnyNumber());
@@ -21,6 +21,7 @@
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -1046,6 +1047,60 @@ TEST_F(TimerImplTest, ChangeLargeTimerForwardToNonZeroBeforeRun) {
   });
 }
 
+TEST_F(TimerImplTest, CommonTimeoutsOfWholeSeconds) {
+  CommonTimeouts common_timeouts(libevent_base_);
+  EXPECT_EQ(nullptr, common_timeouts.find(std::chrono::milliseconds(0)));
+  EXPECT_EQ(nullptr, common_timeouts.find(std::chrono::milliseconds(1500)));
+  const timeval* one_second = common_timeouts.find(std::chrono::seconds(1));
+  ASSERT_NE(nullptr, one_second);
+  EXPECT_EQ(one_second, common_timeouts.find(std::chrono::milliseconds(1000)));
+  EXPECT_NE(one_second, common_timeouts.find(std::chrono::seconds(2)));
+
+  // Only a limited number of durations get a common timeout.
+  for (int seconds = 3; seconds < 100; ++seconds) {
+    common_timeouts.find(std::chrono::seconds(seconds));
+  }
+  EXPECT_EQ(nullptr, common_timeouts.find(std::chrono::seconds(100)));
+  EXPECT_EQ(one_second, common_timeouts.find(std::chrono::seconds(1)));
+}
+
+// Timers enabled with the common timeouts of their durations behave like the other timers.
+TEST_F(TimerImplTest, TimersOnCommonTimeouts) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.libevent_common_timeouts", "true"}});
+
+  ReadyWatcher watcher1;
+  Event::TimerPtr timer1 = dispatcher_->createTimer([&] { watcher1.ready(); });
+  ReadyWatcher watcher2;
+  Event::TimerPtr timer2 = dispatcher_->createTimer([&] { watcher2.ready(); });
+  ReadyWatcher watcher3;
+  Event::TimerPtr timer3 = dispatcher_->createTimer([&] { watcher3.ready(); });
+  ReadyWatcher watcher4;
+  Event::TimerPtr timer4 = dispatcher_->createTimer([&] { watcher4.ready(); });
+
+  InSequence s;
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher4, ready());
+  EXPECT_CALL(watcher2, ready());
+  EXPECT_CALL(watcher1, ready());
+  runInEventLoop([&]() {
+    timer1->enableTimer(std::chrono::seconds(2));
+    timer2->enableTimer(std::chrono::seconds(1));
+    timer3->enableTimer(std::chrono::seconds(1));
+    // Moving a timer from a common timeout to the timer heap.
+    timer4->enableTimer(std::chrono::seconds(1));
+    timer4->enableTimer(std::chrono::milliseconds(500));
+    timer3->disableTimer();
+    EXPECT_TRUE(timer1->enabled());
+    EXPECT_TRUE(timer2->enabled());
+    EXPECT_FALSE(timer3->enabled());
+
+    // Advance time by 2s so timers above all trigger in the same loop iteration.
+    advanceLibeventTime(absl::Seconds(2));
+  });
+  EXPECT_FALSE(timer1->enabled());
+}
+
 // Timers scheduled at different times execute in order.
 TEST_F(TimerImplTest, TimerOrdering) {
   ReadyWatcher watcher1;
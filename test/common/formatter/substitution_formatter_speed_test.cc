@@ -28,6 +28,27 @@ std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeJsonFormatter(bool type
   return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(JsonLogFormat, typed, false);
 }
 
+// Nested formats are not compiled into flat fields and are rendered through a Struct.
+std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeNestedJsonFormatter(bool typed) {
+  ProtobufWkt::Struct JsonLogFormat;
+  const std::string format_yaml = R"EOF(
+    remote_address: '%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT%'
+    start_time: '%START_TIME(%Y/%m/%dT%H:%M:%S%z %s)%'
+    request:
+      method: '%REQ(:METHOD)%'
+      url: '%REQ(X-FORWARDED-PROTO)%://%REQ(:AUTHORITY)%%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)%'
+      protocol: '%PROTOCOL%'
+      referer: '%REQ(REFERER)%'
+      user-agent: '%REQ(USER-AGENT)%'
+    response:
+      response_code: '%RESPONSE_CODE%'
+      bytes_sent: '%BYTES_SENT%'
+      duration: '%DURATION%'
+  )EOF";
+  TestUtility::loadFromYaml(format_yaml, JsonLogFormat);
+  return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(JsonLogFormat, typed, false);
+}
+
 std::unique_ptr<Envoy::Formatter::StructFormatter> makeStructFormatter(bool typed) {
   ProtobufWkt::Struct StructLogFormat;
   const std::string format_yaml = R"EOF(
@@ -185,6 +206,59 @@ static void BM_TypedJsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_TypedJsonAccessLogFormatter);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_NestedJsonAccessLogFormatter(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> json_formatter =
+      makeNestedJsonFormatter(state.range(0) != 0);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers;
+  Http::TestResponseHeaderMapImpl response_headers;
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes +=
+        json_formatter
+            ->format(request_headers, response_headers, response_trailers, *stream_info, body)
+            .length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_NestedJsonAccessLogFormatter)->Arg(0)->Arg(1);
+
+// Formats with long literals, where most of the output is copied from the compiled format.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LiteralHeavyAccessLogFormatter(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  static const char* LogFormat =
+      "remote_address=%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT% method=%REQ(:METHOD)% "
+      "authority=%REQ(:AUTHORITY)% path=%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)% protocol=%PROTOCOL% "
+      "response_code=%RESPONSE_CODE% response_flags=%RESPONSE_FLAGS% "
+      "bytes_received=%BYTES_RECEIVED% bytes_sent=%BYTES_SENT% duration=%DURATION% "
+      "upstream_service_time=%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)% "
+      "forwarded_for=\"%REQ(X-FORWARDED-FOR)%\" user_agent=\"%REQ(USER-AGENT)%\" "
+      "request_id=\"%REQ(X-REQUEST-ID)%\" upstream_host=\"%UPSTREAM_HOST%\"\n";
+
+  std::unique_ptr<Envoy::Formatter::FormatterImpl> formatter =
+      std::make_unique<Envoy::Formatter::FormatterImpl>(LogFormat, false);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers;
+  Http::TestResponseHeaderMapImpl response_headers;
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes +=
+        formatter->format(request_headers, response_headers, response_trailers, *stream_info, body)
+            .length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_LiteralHeavyAccessLogFormatter);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -3516,6 +3516,92 @@ TEST(SubstitutionFormatterTest, JsonFormatterTest) {
   EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected));
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterFlatFormatTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"user-agent", "agent \"with\" quotes\\"},
+                                                {":path", "/path?a=b\tc"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    user-agent: '%REQ(USER-AGENT)%'
+    url: 'http://%REQ(:AUTHORITY)%%REQ(:PATH)%'
+    protocol: '%PROTOCOL%'
+    missing: '%RESP(X-MISSING)%'
+    "quoted\"key": plain
+    number: 12
+  )EOF",
+                            key_mapping);
+
+  {
+    JsonFormatterImpl formatter(key_mapping, false, false);
+    EXPECT_EQ("{\"missing\":\"-\",\"number\":\"12\",\"protocol\":\"HTTP/1.1\","
+              "\"quoted\\\"key\":\"plain\",\"url\":\"http://-/path?a=b\\tc\","
+              "\"user-agent\":\"agent \\\"with\\\" quotes\\\\\"}\n",
+              formatter.format(request_header, response_header, response_trailer, stream_info,
+                               body));
+  }
+
+  {
+    JsonFormatterImpl formatter(key_mapping, true, true);
+    EXPECT_EQ("{\"number\":12,\"protocol\":\"HTTP/1.1\","
+              "\"quoted\\\"key\":\"plain\",\"url\":\"http:///path?a=b\\tc\","
+              "\"user-agent\":\"agent \\\"with\\\" quotes\\\\\"}\n",
+              formatter.format(request_header, response_header, response_trailer, stream_info,
+                               body));
+  }
+}
+
+// The flat JSON output must be equivalent to rendering the StructFormatter output.
+TEST(SubstitutionFormatterTest, JsonFormatterFlatFormatMatchesStructFormatterTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"x-text", "tab\tand\x01"
+                                                          "control"},
+                                                {":method", "GET"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  absl::optional<uint32_t> response_code{404};
+  EXPECT_CALL(stream_info, responseCode()).WillRepeatedly(Return(response_code));
+  EXPECT_CALL(stream_info, bytesReceived()).WillRepeatedly(Return(1234567));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    text: '%REQ(X-TEXT)%'
+    method_and_code: '%REQ(:METHOD)% %RESPONSE_CODE%'
+    response_code: '%RESPONSE_CODE%'
+    bytes_received: '%BYTES_RECEIVED%'
+    missing: '%REQ(X-MISSING)%'
+    missing_concatenated: '%REQ(X-MISSING)%/%REQ(X-MISSING)%'
+    integer: 42
+    fraction: 0.5
+  )EOF",
+                            key_mapping);
+
+  for (const bool preserve_types : {false, true}) {
+    for (const bool omit_empty_values : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("preserve_types: ", preserve_types,
+                                " omit_empty_values: ", omit_empty_values));
+      JsonFormatterImpl json_formatter(key_mapping, preserve_types, omit_empty_values);
+      StructFormatter struct_formatter(key_mapping, preserve_types, omit_empty_values);
+      const std::string expected = MessageUtil::getJsonStringFromMessageOrDie(
+          struct_formatter.format(request_header, response_header, response_trailer, stream_info,
+                                  body),
+          false, true);
+      const std::string out_json = json_formatter.format(request_header, response_header,
+                                                         response_trailer, stream_info, body);
+      EXPECT_EQ('\n', out_json.back());
+      EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected)) << out_json;
+    }
+  }
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
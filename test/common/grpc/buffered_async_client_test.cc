@@ -50,10 +50,13 @@ public:
         raw_client_);
   }
 
-  void prepareBufferedClient(uint32_t buffer_size, std::chrono::milliseconds ttl) {
+  void prepareBufferedClient(
+      uint32_t buffer_size, std::chrono::milliseconds ttl,
+      BufferOverflowPolicy overflow_policy = BufferOverflowPolicy::RejectNewest) {
     buffered_client_ =
         std::make_unique<BufferedAsyncClient<helloworld::HelloRequest, helloworld::HelloReply>>(
-            buffer_size, *method_descriptor_, callback_, *client_, *dispatcher_, ttl);
+            buffer_size, *method_descriptor_, callback_, *client_, *dispatcher_, ttl,
+            overflow_policy);
   }
 
   void bufferNewMessage(absl::optional<uint32_t> expected_message_id) {
@@ -157,6 +160,30 @@ TEST_F(BufferedAsyncClientTest, BufferLimitExceeded) {
   EXPECT_TRUE(buffered_client_->hasActiveStream());
 }
 
+TEST_F(BufferedAsyncClientTest, BufferLimitExceededDropOldest) {
+  EXPECT_CALL(http_stream_, sendData(_, _)).Times(2);
+  EXPECT_CALL(http_stream_, isAboveWriteBufferHighWatermark()).WillRepeatedly(Return(false));
+
+  helloworld::HelloRequest request;
+  request.set_name("Alice");
+  prepareBufferedClient(2 * request.ByteSizeLong(), std::chrono::milliseconds(1000),
+                        BufferOverflowPolicy::DropOldest);
+  bufferNewMessage(0);
+  bufferNewMessage(1);
+
+  // The oldest message is dropped to make room for the new one.
+  bufferNewMessage(2);
+  validateBuffer(2, 0);
+  EXPECT_EQ(0, buffered_client_->messageBuffer().count(0));
+  EXPECT_EQ(1, buffered_client_->droppedMessageCount());
+
+  // Messages being sent are not dropped.
+  EXPECT_EQ(2, buffered_client_->sendBufferedMessages().size());
+  bufferNewMessage(absl::nullopt);
+  validateBuffer(0, 2);
+  EXPECT_EQ(1, buffered_client_->droppedMessageCount());
+}
+
 TEST_F(BufferedAsyncClientTest, BufferHighWatermarkTest) {
   EXPECT_CALL(http_stream_, isAboveWriteBufferHighWatermark()).WillOnce(Return(true));
 
@@ -405,5 +405,23 @@ TEST(GrpcContextTest, PrependGrpcFrameHeader) {
   EXPECT_EQ(buffer->toString(), header_string + "test");
 }
 
+// Ensure that the header of a serialized message is prepended in the slice of the message.
+TEST(GrpcContextTest, PrependGrpcFrameHeaderToSerializedMessage) {
+  helloworld::HelloRequest request;
+  request.set_name("test");
+  Buffer::InstancePtr buffer = Common::serializeMessage(request);
+  EXPECT_EQ(request.SerializeAsString(), buffer->toString());
+
+  Common::prependGrpcFrameHeader(*buffer);
+  EXPECT_EQ(1, buffer->getRawSlices().size());
+  EXPECT_EQ(Common::serializeToGrpcFrame(request)->toString(), buffer->toString());
+
+  helloworld::HelloRequest empty_request;
+  buffer = Common::serializeMessage(empty_request);
+  EXPECT_EQ(0, buffer->length());
+  Common::prependGrpcFrameHeader(*buffer);
+  EXPECT_EQ(Common::serializeToGrpcFrame(empty_request)->toString(), buffer->toString());
+}
+
 } // namespace Grpc
 } // namespace Envoy
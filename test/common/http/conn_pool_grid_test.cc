@@ -314,6 +314,26 @@ TEST_F(ConnectivityGridTest, SrttMatters) {
   cancel->cancel(Envoy::ConnectionPool::CancelPolicy::CloseExcess);
 }
 
+// Test timer is affected by rtt learned after the grid was created.
+TEST_F(ConnectivityGridTest, SrttLearnedAfterGridCreationMatters) {
+  initialize();
+  addHttp3AlternateProtocol(std::chrono::microseconds(2000));
+  EXPECT_EQ(grid_->first(), nullptr);
+
+  Event::MockTimer* failover_timer = new StrictMock<MockTimer>(&dispatcher_);
+  EXPECT_CALL(*failover_timer, enableTimer(std::chrono::milliseconds(4), nullptr));
+  EXPECT_CALL(*failover_timer, enabled()).WillRepeatedly(Return(false));
+
+  auto cancel = grid_->newStream(decoder_, callbacks_,
+                                 {/*can_send_early_data_=*/false,
+                                  /*can_use_http3_=*/true});
+  EXPECT_NE(grid_->first(), nullptr);
+  EXPECT_TRUE(failover_timer->enabled_);
+
+  // Clean up.
+  cancel->cancel(Envoy::ConnectionPool::CancelPolicy::CloseExcess);
+}
+
 // Test both connections happening in parallel and the first connecting.
 TEST_F(ConnectivityGridTest, TimeoutThenSuccessParallelFirstConnects) {
   initialize();
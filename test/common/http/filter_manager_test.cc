@@ -11,10 +11,12 @@
 #include "source/common/stream_info/filter_state_impl.h"
 #include "source/common/stream_info/stream_info_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/local_reply/mocks.h"
 #include "test/mocks/network/mocks.h"
+#include "test/test_common/simulated_time_system.h"
 
 #include "gtest/gtest.h"
 
@@ -320,6 +322,43 @@ TEST_F(FilterManagerTest, ResetIdleTimer) {
   filter_manager_->destroyFilters();
 }
 
+TEST_F(FilterManagerTest, FilterTiming) {
+  Event::SimulatedTimeSystem time_system;
+  Stats::TestUtil::TestStore store;
+  Stats::StatNameManagedStorage prefix("http.test", store.symbolTable());
+  initialize();
+  filter_manager_->enableFilterTiming(*store.rootScope(), prefix.statName());
+
+  std::shared_ptr<MockStreamFilter> filter(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> decoder_filter(new NiceMock<MockStreamDecoderFilter>());
+
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainManager& manager) -> bool {
+        auto factory = createStreamFilterFactoryCb(filter);
+        manager.applyFilterFactoryCb({"timed", "envoy.test.timed"}, factory);
+        auto decoder_factory = createDecoderFilterFactoryCb(decoder_filter);
+        manager.applyFilterFactoryCb({"not_called", "envoy.test.not_called"}, decoder_factory);
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  EXPECT_CALL(*filter, decodeHeaders(_, true))
+      .WillOnce(Invoke([&](RequestHeaderMap&, bool) -> FilterHeadersStatus {
+        time_system.advanceTimeWait(std::chrono::milliseconds(5));
+        return FilterHeadersStatus::StopIteration;
+      }));
+  TestRequestHeaderMapImpl headers{{":authority", "host"}, {":path", "/"}, {":method", "GET"}};
+  filter_manager_->decodeHeaders(headers, true);
+  filter_manager_->destroyFilters();
+
+  EXPECT_EQ(std::vector<uint64_t>({5000}),
+            store.histogramValues("http.test.filter_timing.timed.decode_time_us", false));
+  EXPECT_FALSE(
+      store.findHistogramByString("http.test.filter_timing.not_called.decode_time_us").has_value());
+  EXPECT_FALSE(
+      store.findHistogramByString("http.test.filter_timing.timed.encode_time_us").has_value());
+}
+
 TEST_F(FilterManagerTest, SetAndGetUpstreamOverrideHost) {
   initialize();
 
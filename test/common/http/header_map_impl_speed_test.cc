@@ -208,6 +208,26 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of creating a RequestHeaderMapImpl, populating it with the given number of
+ * non-inline headers and destroying it, which is dominated by the allocation of header entries.
+ */
+static void headerMapImplCreatePopulateDestroy(benchmark::State& state) {
+  const std::string value("01234567890123456789");
+  std::vector<LowerCaseString> keys;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    keys.emplace_back("x-header-" + std::to_string(i));
+  }
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    for (const auto& key : keys) {
+      headers->addReference(key, value);
+    }
+    benchmark::DoNotOptimize(headers->size());
+  }
+}
+BENCHMARK(headerMapImplCreatePopulateDestroy)->Arg(1)->Arg(10)->Arg(30);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
@@ -1003,6 +1003,35 @@ TEST_P(Http2CodecImplTest, TrailingHeadersLargeClientBody) {
   driveToCompletion();
 }
 
+// Verifies that large DATA payloads that reference the received slices are decoded intact.
+TEST_P(Http2CodecImplTest, ZeroCopyDataReceive) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_zero_copy_data_receive", "true"}});
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  std::string body;
+  for (uint32_t i = 0; body.size() < 60 * 1024; ++i) {
+    body.append(std::to_string(i)).append(",");
+  }
+  std::string received;
+  EXPECT_CALL(request_decoder_, decodeData(_, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) {
+        received.append(data.toString());
+        data.drain(data.length());
+      }));
+  Buffer::OwnedImpl request_body(body);
+  request_encoder_->encodeData(request_body, true);
+  driveToCompletion();
+  EXPECT_EQ(body, received);
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
 TEST_P(Http2CodecImplTest, SmallMetadataVecTest) {
   allow_metadata_ = true;
   initialize();
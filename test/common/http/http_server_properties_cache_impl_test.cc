@@ -110,6 +110,18 @@ TEST_F(HttpServerPropertiesCacheImplTest, SetConcurrency) {
   EXPECT_EQ(5, protocols_->getConcurrentStreams(origin1_));
 }
 
+TEST_F(HttpServerPropertiesCacheImplTest, SetConcurrencyAfterAlternatives) {
+  initialize();
+  EXPECT_CALL(*store_,
+              addOrUpdate("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|0|0", kNoTtl));
+  protocols_->setAlternatives(origin1_, protocols1_);
+  EXPECT_CALL(*store_,
+              addOrUpdate("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|0|5", kNoTtl));
+  protocols_->setConcurrentStreams(origin1_, 5);
+  EXPECT_EQ(5, protocols_->getConcurrentStreams(origin1_));
+  EXPECT_EQ(1, protocols_->size());
+}
+
 TEST_F(HttpServerPropertiesCacheImplTest, FindAlternatives) {
   initialize();
   EXPECT_CALL(*store_,
@@ -0,0 +1,42 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/http/path_utility.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+
+// Canonicalizes a path which is already canonical, as most request paths are, and one which needs
+// to be rewritten.
+static void bmCanonicalPath(benchmark::State& state) {
+  const std::string path = state.range(0) ? "/api/v1/users/../items/./12345?limit=10"
+                                          : "/api/v1/items/12345?limit=10";
+  TestRequestHeaderMapImpl headers;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    headers.setPath(path);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(PathUtil::canonicalPath(headers));
+  }
+}
+BENCHMARK(bmCanonicalPath)->Arg(0)->Arg(1);
+
+static void bmMergeSlashes(benchmark::State& state) {
+  const std::string path =
+      state.range(0) ? "/api//v1///items/12345?limit=10" : "/api/v1/items/12345?limit=10";
+  TestRequestHeaderMapImpl headers;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    headers.setPath(path);
+    state.ResumeTiming();
+    PathUtil::mergeSlashes(headers);
+  }
+}
+BENCHMARK(bmMergeSlashes)->Arg(0)->Arg(1);
+
+} // namespace Http
+} // namespace Envoy
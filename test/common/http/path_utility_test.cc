@@ -38,6 +38,18 @@ TEST_F(PathUtilityTest, AlreadyNormalPaths) {
   }
 }
 
+// Already normalized paths are not rewritten, so the header keeps its storage.
+TEST_F(PathUtilityTest, AlreadyNormalPathsAreNotRewritten) {
+  const std::vector<std::string> normal_paths{"/xyz", "/x/y/z", "/x/y?a=/../b"};
+  for (const auto& path : normal_paths) {
+    auto& path_header = pathHeaderEntry(path);
+    const char* original_data = path_header.value().getStringView().data();
+    EXPECT_TRUE(PathUtil::canonicalPath(headers_)) << "original path: " << path;
+    EXPECT_EQ(headers_.Path()->value().getStringView().data(), original_data);
+    EXPECT_EQ(headers_.getPathValue(), path);
+  }
+}
+
 // Invalid paths are rejected.
 TEST_F(PathUtilityTest, InvalidPaths) {
   const std::vector<std::string> invalid_paths{"/xyz/.%00../abc", "/xyz/%00.%00./abc",
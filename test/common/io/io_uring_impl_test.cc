@@ -65,6 +65,14 @@ INSTANTIATE_TEST_SUITE_P(InvalidPrepareMethodParamsTest, IoUringImplParamTest,
                              [](IoUring& uring, os_fd_t fd) -> IoUringResult {
                                return uring.prepareWritev(fd, nullptr, 0, 0, nullptr);
                              },
+                             [](IoUring& uring, os_fd_t fd) -> IoUringResult {
+                               return uring.prepareReadFixed(fd, false, nullptr, 0, 0, 0,
+                                                             nullptr);
+                             },
+                             [](IoUring& uring, os_fd_t) -> IoUringResult {
+                               // No file table is registered.
+                               return uring.prepareWritevFixedFile(0, nullptr, 0, 0, nullptr);
+                             },
                              [](IoUring& uring, os_fd_t fd) -> IoUringResult {
                                return uring.prepareClose(fd, nullptr);
                              }));
@@ -163,6 +171,53 @@ TEST_F(IoUringImplTest, PrepareReadvAllDataFitsOneChunk) {
   EXPECT_STREQ(static_cast<char*>(iov.iov_base), "test text");
 }
 
+TEST_F(IoUringImplTest, PrepareReadFixedFromRegisteredFile) {
+  std::string test_file =
+      TestEnvironment::writeStringToFileForTest("prepare_read_fixed", "test text", true);
+  os_fd_t fd = open(test_file.c_str(), O_RDONLY);
+  ASSERT_TRUE(fd >= 0);
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+
+  uint8_t buffer[4096]{};
+  struct iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = 4096;
+
+  auto& uring = factory_->getOrCreate();
+  if (uring.registerBuffers(&iov, 1) != IoUringResult::Ok ||
+      uring.registerFileTable(2) != IoUringResult::Ok) {
+    close(fd);
+    GTEST_SKIP() << "registered buffers or sparse file tables are not supported by the kernel";
+  }
+  EXPECT_EQ(IoUringResult::Ok, uring.setRegisteredFile(1, fd));
+  EXPECT_EQ(IoUringResult::Failed, uring.setRegisteredFile(2, fd));
+  os_fd_t event_fd = uring.registerEventfd();
+
+  int32_t completions_nr = 0;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [&uring, &completions_nr, d = dispatcher.get()](uint32_t) {
+        uring.forEveryCompletion([&completions_nr](void*, int32_t res) {
+          completions_nr++;
+          EXPECT_EQ(res, strlen("test text"));
+        });
+        d->exit();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  // The file can be closed once registered.
+  close(fd);
+  EXPECT_EQ(IoUringResult::Ok, uring.prepareReadFixed(1, true, buffer, 4096, 0, 0, nullptr));
+  uring.submit();
+
+  dispatcher->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(completions_nr, 1);
+  EXPECT_STREQ(reinterpret_cast<char*>(buffer), "test text");
+  EXPECT_EQ(IoUringResult::Ok, uring.setRegisteredFile(1, INVALID_SOCKET));
+}
+
 TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   std::string test_file =
       TestEnvironment::writeStringToFileForTest("prepare_readv_overflow", "abcdefhg", true);
@@ -0,0 +1,172 @@
+#include "source/common/io/io_uring_worker_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/io/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+class IoUringWorkerImplTest : public testing::Test {
+public:
+  IoUringWorkerImplTest() {
+    auto io_uring = std::make_unique<NiceMock<MockIoUring>>();
+    io_uring_ = io_uring.get();
+    submit_cb_ = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+    EXPECT_CALL(*io_uring_, registerEventfd()).WillOnce(Return(event_fd_));
+    EXPECT_CALL(dispatcher_, createFileEvent_(event_fd_, _, _, Event::FileReadyType::Read))
+        .WillOnce(DoAll(SaveArg<1>(&file_event_cb_), Return(new NiceMock<Event::MockFileEvent>())));
+    worker_ = std::make_unique<IoUringWorkerImpl>(std::move(io_uring), dispatcher_);
+  }
+
+  ~IoUringWorkerImplTest() override {
+    EXPECT_CALL(*io_uring_, unregisterEventfd());
+    worker_.reset();
+  }
+
+  // Delivers the given completions as if the kernel had posted them to the completion queue.
+  void complete(const std::vector<std::pair<void*, int32_t>>& completions) {
+    EXPECT_CALL(*io_uring_, forEveryCompletion(_))
+        .WillOnce(Invoke([completions](const CompletionCb& cb) {
+          for (const auto& completion : completions) {
+            cb(completion.first, completion.second);
+          }
+        }));
+    file_event_cb_(Event::FileReadyType::Read);
+  }
+
+  const os_fd_t event_fd_{42};
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Event::MockSchedulableCallback* submit_cb_;
+  Event::FileReadyCb file_event_cb_;
+  MockIoUring* io_uring_;
+  std::unique_ptr<IoUringWorkerImpl> worker_;
+};
+
+// Requests prepared in the same event loop iteration are submitted with a single system call.
+TEST_F(IoUringWorkerImplTest, BatchesSubmissions) {
+  struct iovec iov {};
+  EXPECT_CALL(*io_uring_, prepareReadv(1, &iov, 1, 0, _)).WillOnce(Return(IoUringResult::Ok));
+  EXPECT_CALL(*io_uring_, prepareWritev(2, &iov, 1, 0, _)).WillOnce(Return(IoUringResult::Ok));
+  EXPECT_CALL(*io_uring_, prepareClose(3, _)).WillOnce(Return(IoUringResult::Ok));
+  EXPECT_CALL(*io_uring_, submit()).Times(0);
+  EXPECT_CALL(*submit_cb_, scheduleCallbackCurrentIteration());
+
+  EXPECT_EQ(IoUringResult::Ok, worker_->readv(1, &iov, 1, 0, [](int32_t) {}));
+  EXPECT_EQ(IoUringResult::Ok, worker_->writev(2, &iov, 1, 0, [](int32_t) {}));
+  EXPECT_EQ(IoUringResult::Ok, worker_->close(3, [](int32_t) {}));
+  EXPECT_EQ(3, worker_->pendingRequests());
+
+  testing::Mock::VerifyAndClearExpectations(io_uring_);
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Ok));
+  submit_cb_->invokeCallback();
+}
+
+TEST_F(IoUringWorkerImplTest, CompletionInvokesCallback) {
+  void* accept_data = nullptr;
+  void* connect_data = nullptr;
+  EXPECT_CALL(*io_uring_, prepareAccept(1, nullptr, nullptr, _))
+      .WillOnce(DoAll(SaveArg<3>(&accept_data), Return(IoUringResult::Ok)));
+  EXPECT_CALL(*io_uring_, prepareConnect(2, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&connect_data), Return(IoUringResult::Ok)));
+
+  std::vector<std::pair<std::string, int32_t>> results;
+  worker_->accept(1, nullptr, nullptr,
+                  [&results](int32_t result) { results.emplace_back("accept", result); });
+  worker_->connect(2, nullptr,
+                   [&results](int32_t result) { results.emplace_back("connect", result); });
+  ASSERT_NE(nullptr, accept_data);
+  ASSERT_NE(nullptr, connect_data);
+
+  complete({{connect_data, -ECONNREFUSED}, {accept_data, 7}});
+  EXPECT_EQ(0, worker_->pendingRequests());
+  ASSERT_EQ(2, results.size());
+  EXPECT_EQ("connect", results[0].first);
+  EXPECT_EQ(-ECONNREFUSED, results[0].second);
+  EXPECT_EQ("accept", results[1].first);
+  EXPECT_EQ(7, results[1].second);
+}
+
+// A completion callback may prepare a follow-up request.
+TEST_F(IoUringWorkerImplTest, PrepareFromCompletionCallback) {
+  struct iovec iov {};
+  void* user_data = nullptr;
+  EXPECT_CALL(*io_uring_, prepareReadv(1, &iov, 1, 0, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SaveArg<4>(&user_data), Return(IoUringResult::Ok)));
+
+  bool read_again = false;
+  worker_->readv(1, &iov, 1, 0, [&](int32_t) {
+    read_again = true;
+    EXPECT_EQ(IoUringResult::Ok, worker_->readv(1, &iov, 1, 0, [](int32_t) {}));
+  });
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Ok));
+  submit_cb_->invokeCallback();
+
+  complete({{user_data, 10}});
+  EXPECT_TRUE(read_again);
+  EXPECT_EQ(1, worker_->pendingRequests());
+  EXPECT_TRUE(submit_cb_->enabled_);
+}
+
+// When the submission queue is full, queued entries are flushed before the request is retried.
+TEST_F(IoUringWorkerImplTest, FullSubmissionQueueFlushes) {
+  struct iovec iov {};
+  EXPECT_CALL(*io_uring_, prepareReadv(1, &iov, 1, 0, _))
+      .WillOnce(Return(IoUringResult::Failed))
+      .WillOnce(Return(IoUringResult::Ok));
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Ok));
+
+  EXPECT_EQ(IoUringResult::Ok, worker_->readv(1, &iov, 1, 0, [](int32_t) {}));
+  EXPECT_EQ(1, worker_->pendingRequests());
+  EXPECT_TRUE(submit_cb_->enabled_);
+}
+
+TEST_F(IoUringWorkerImplTest, PrepareFailure) {
+  struct iovec iov {};
+  EXPECT_CALL(*io_uring_, prepareReadv(1, &iov, 1, 0, _))
+      .Times(2)
+      .WillRepeatedly(Return(IoUringResult::Failed));
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Ok));
+
+  bool called = false;
+  EXPECT_EQ(IoUringResult::Failed,
+            worker_->readv(1, &iov, 1, 0, [&called](int32_t) { called = true; }));
+  EXPECT_EQ(0, worker_->pendingRequests());
+  EXPECT_FALSE(called);
+}
+
+// A busy ring is submitted again once completions have been reaped.
+TEST_F(IoUringWorkerImplTest, BusySubmitIsRetriedAfterCompletions) {
+  void* user_data = nullptr;
+  EXPECT_CALL(*io_uring_, prepareClose(1, _))
+      .WillOnce(DoAll(SaveArg<1>(&user_data), Return(IoUringResult::Ok)));
+  worker_->close(1, [](int32_t) {});
+
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Busy));
+  submit_cb_->invokeCallback();
+  EXPECT_FALSE(submit_cb_->enabled_);
+
+  complete({{user_data, 0}});
+  EXPECT_TRUE(submit_cb_->enabled_);
+  EXPECT_CALL(*io_uring_, submit()).WillOnce(Return(IoUringResult::Ok));
+  submit_cb_->invokeCallback();
+
+  // Nothing is left to submit after a successful submit.
+  complete({});
+  EXPECT_FALSE(submit_cb_->enabled_);
+}
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
@@ -112,6 +112,16 @@ TEST_F(JsonSanitizerTest, SevenBitAscii) {
   }
 }
 
+TEST_F(JsonSanitizerTest, SevenBitAsciiMatchesSerializer) {
+  // Strings with only 7-bit ascii are escaped without the Nlohmann serializer,
+  // so make sure the result is identical to it.
+  for (uint32_t i = 0; i < 128; ++i) {
+    const std::string str = absl::StrCat("a", std::string(1, static_cast<char>(i)), "b\"");
+    const std::string serialized = Nlohmann::Factory::serialize(str);
+    EXPECT_EQ(stripDoubleQuotes(serialized), sanitize(str)) << "char=" << i;
+  }
+}
+
 TEST_F(JsonSanitizerTest, Utf8) {
   // reference; https://www.charset.org/utf-8
   auto unicode = [](std::vector<uint8_t> chars) -> std::string {
@@ -0,0 +1,50 @@
+#include "source/common/matcher/exact_map_matcher.h"
+#include "source/common/matcher/prefix_map_matcher.h"
+
+#include "test/common/matcher/test_utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Matcher {
+namespace {
+
+// Creates a matcher of the given number of children, named key_0 to key_<n-1>, whose input always
+// returns the given value.
+template <class MatcherType>
+std::unique_ptr<MatcherType> createMatcher(int64_t num_children, std::string input) {
+  auto matcher = std::make_unique<MatcherType>(
+      std::make_unique<TestInput>(
+          DataInputGetResult{DataInputGetResult::DataAvailability::AllDataAvailable, input}),
+      absl::nullopt);
+  for (int64_t i = 0; i < num_children; ++i) {
+    const std::string key = absl::StrCat("key_", i);
+    matcher->addChild(key, stringOnMatch<TestData>(key));
+  }
+  return matcher;
+}
+
+static void bmExactMapMatcherMatch(benchmark::State& state) {
+  auto matcher = createMatcher<ExactMapMatcher<TestData>>(state.range(0),
+                                                          absl::StrCat("key_", state.range(0) - 1));
+  TestData data;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(matcher->match(data));
+  }
+}
+BENCHMARK(bmExactMapMatcherMatch)->Arg(10)->Arg(1000);
+
+static void bmPrefixMapMatcherMatch(benchmark::State& state) {
+  auto matcher = createMatcher<PrefixMapMatcher<TestData>>(
+      state.range(0), absl::StrCat("key_", state.range(0) - 1, "/suffix"));
+  TestData data;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(matcher->match(data));
+  }
+}
+BENCHMARK(bmPrefixMapMatcherMatch)->Arg(10)->Arg(1000);
+
+} // namespace
+} // namespace Matcher
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#include "source/common/memory/huge_page_region.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+constexpr uint64_t BlockSize = 16384;
+
+#if defined(__linux__)
+
+TEST(HugePageRegionTest, RoundsUpToHugePageSize) {
+  auto region = HugePageRegion::create(1, BlockSize, false);
+  ASSERT_NE(nullptr, region);
+  EXPECT_EQ(HugePageRegion::HugePageSize, region->size());
+  EXPECT_EQ(BlockSize, region->blockSize());
+  EXPECT_EQ(0, region->allocatedBytes());
+  EXPECT_EQ(0, region->committedBytes());
+}
+
+TEST(HugePageRegionTest, AllocateAndDeallocate) {
+  auto region = HugePageRegion::create(HugePageRegion::HugePageSize, BlockSize, false);
+  ASSERT_NE(nullptr, region);
+
+  void* first = region->allocate();
+  void* second = region->allocate();
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(region->owns(first));
+  EXPECT_TRUE(region->owns(second));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(first) % HugePageRegion::HugePageSize);
+  EXPECT_EQ(2 * BlockSize, region->allocatedBytes());
+  EXPECT_EQ(2 * BlockSize, region->committedBytes());
+
+  // The memory is usable.
+  memset(first, 0xab, BlockSize);
+
+  // Released blocks are handed out again before untouched ones.
+  region->deallocate(first);
+  EXPECT_EQ(BlockSize, region->allocatedBytes());
+  EXPECT_EQ(first, region->allocate());
+  EXPECT_EQ(2 * BlockSize, region->committedBytes());
+
+  region->deallocate(first);
+  region->deallocate(second);
+  EXPECT_EQ(0, region->allocatedBytes());
+}
+
+TEST(HugePageRegionTest, Exhaustion) {
+  auto region = HugePageRegion::create(HugePageRegion::HugePageSize, BlockSize, false);
+  ASSERT_NE(nullptr, region);
+
+  std::vector<void*> blocks;
+  for (uint64_t i = 0; i < HugePageRegion::HugePageSize / BlockSize; ++i) {
+    blocks.push_back(region->allocate());
+    ASSERT_NE(nullptr, blocks.back());
+  }
+  EXPECT_EQ(nullptr, region->allocate());
+  EXPECT_EQ(region->size(), region->allocatedBytes());
+
+  region->deallocate(blocks.back());
+  EXPECT_EQ(blocks.back(), region->allocate());
+  for (void* block : blocks) {
+    region->deallocate(block);
+  }
+}
+
+TEST(HugePageRegionTest, Owns) {
+  auto region = HugePageRegion::create(HugePageRegion::HugePageSize, BlockSize, false);
+  ASSERT_NE(nullptr, region);
+
+  void* block = region->allocate();
+  ASSERT_NE(nullptr, block);
+  EXPECT_TRUE(region->owns(static_cast<uint8_t*>(block) + region->size() - 1));
+  EXPECT_FALSE(region->owns(static_cast<uint8_t*>(block) + region->size()));
+
+  auto heap = std::make_unique<uint8_t[]>(BlockSize);
+  EXPECT_FALSE(region->owns(heap.get()));
+  region->deallocate(block);
+}
+
+#else
+
+TEST(HugePageRegionTest, NotSupported) {
+  EXPECT_EQ(nullptr, HugePageRegion::create(HugePageRegion::HugePageSize, BlockSize, false));
+}
+
+#endif
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
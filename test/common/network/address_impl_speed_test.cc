@@ -35,6 +35,25 @@ static void ipv6InstanceCreate(benchmark::State& state) {
 }
 BENCHMARK(ipv6InstanceCreate);
 
+// Creates an address from its string form, as EDS and the admin API do.
+static void ipv4InstanceCreateFromString(benchmark::State& state) {
+  const std::string addr = "192.0.2.255"; // From the RFC 5737 example range.
+  for (auto _ : state) {
+    Ipv4Instance address(addr, 443);
+    benchmark::DoNotOptimize(address.ip());
+  }
+}
+BENCHMARK(ipv4InstanceCreateFromString);
+
+static void ipv6InstanceCreateFromString(benchmark::State& state) {
+  const std::string addr = "2001:db8::1234"; // From the RFC 3849 example range.
+  for (auto _ : state) {
+    Ipv6Instance address(addr, 443);
+    benchmark::DoNotOptimize(address.ip());
+  }
+}
+BENCHMARK(ipv6InstanceCreateFromString);
+
 } // namespace Address
 } // namespace Network
 } // namespace Envoy
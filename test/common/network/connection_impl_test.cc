@@ -159,7 +159,9 @@ protected:
     }
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(
+        socket_, listener_callbacks_, runtime_, true, false,
+        Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     client_connection_ = std::make_unique<Network::TestClientConnectionImpl>(
         *dispatcher_, socket_->connectionInfoProvider().localAddress(), source_address_,
         createTransportSocket(), socket_options_, transport_socket_options_);
@@ -1413,7 +1415,9 @@ TEST_P(ConnectionImplTest, BindFailureTest) {
   dispatcher_ = api_->allocateDispatcher("test_thread");
   socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(GetParam()));
-  listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+  listener_ = dispatcher_->createListener(
+      socket_, listener_callbacks_, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   client_connection_ = dispatcher_->createClientConnection(
       socket_->connectionInfoProvider().localAddress(), source_address_,
@@ -2685,6 +2689,22 @@ TEST_F(MockTransportConnectionImplTest, WriteReadyOnConnected) {
       .WillOnce(Return(IoResult{PostIoAction::KeepOpen, 0, true}));
 }
 
+// Writes only queue data and activate the write event, so that all the writes made to a
+// connection in an event loop iteration are flushed to the transport socket at once.
+TEST_F(MockTransportConnectionImplTest, WritesFlushedOnceOnWriteReady) {
+  EXPECT_CALL(*file_event_, activate(Event::FileReadyType::Write)).Times(3);
+  EXPECT_CALL(*transport_socket_, doWrite(_, _)).Times(0);
+  for (absl::string_view data : {"headers", "data", "trailers"}) {
+    Buffer::OwnedImpl buffer(data);
+    connection_->write(buffer, false);
+  }
+  testing::Mock::VerifyAndClearExpectations(transport_socket_);
+
+  EXPECT_CALL(*transport_socket_, doWrite(BufferStringEqual("headersdatatrailers"), false))
+      .WillOnce(Invoke(SimulateSuccessfulWrite));
+  file_ready_cb_(Event::FileReadyType::Write);
+}
+
 // Test the interface used by external consumers.
 TEST_F(MockTransportConnectionImplTest, FlushWriteBufferAndRtt) {
   InSequence s;
@@ -2900,7 +2920,9 @@ public:
     dispatcher_ = api_->allocateDispatcher("test_thread");
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(
+        socket_, listener_callbacks_, runtime_, true, false,
+        Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
     client_connection_ = dispatcher_->createClientConnection(
         socket_->connectionInfoProvider().localAddress(),
@@ -37,8 +37,9 @@ static void errorCallbackTest(Address::IpVersion version) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher->createListener(socket, listener_callbacks, runtime, true, false);
+  Network::ListenerPtr listener = dispatcher->createListener(
+      socket, listener_callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ClientConnectionPtr client_connection = dispatcher->createClientConnection(
       socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
@@ -70,9 +71,11 @@ class TestTcpListenerImpl : public TcpListenerImpl {
 public:
   TestTcpListenerImpl(Event::DispatcherImpl& dispatcher, Random::RandomGenerator& random_generator,
                       Runtime::Loader& runtime, SocketSharedPtr socket, TcpListenerCallbacks& cb,
-                      bool bind_to_port, bool ignore_global_conn_limit)
+                      bool bind_to_port, bool ignore_global_conn_limit,
+                      uint32_t max_connections_to_accept_per_socket_event =
+                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)
       : TcpListenerImpl(dispatcher, random_generator, runtime, std::move(socket), cb, bind_to_port,
-                        ignore_global_conn_limit) {}
+                        ignore_global_conn_limit, max_connections_to_accept_per_socket_event) {}
 
   MOCK_METHOD(Address::InstanceConstSharedPtr, getLocalAddress, (os_fd_t fd));
 };
@@ -128,8 +131,9 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitEnforcement) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, scoped_runtime.loader(), true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
@@ -193,8 +197,9 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitListenerOptOut) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, true);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, scoped_runtime.loader(), true, true,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
@@ -360,6 +365,54 @@ TEST_P(TcpListenerImplTest, DisableAndEnableListener) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+TEST_P(TcpListenerImplTest, MaxConnectionsToAcceptPerSocketEvent) {
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version_));
+  MockTcpListenerCallbacks listener_callbacks;
+  MockConnectionCallbacks connection_callbacks;
+  Random::MockRandomGenerator random_generator;
+  NiceMock<Runtime::MockLoader> runtime;
+  TestTcpListenerImpl listener(dispatcherImpl(), random_generator, runtime, socket,
+                               listener_callbacks, true, false, 1);
+
+  // Queue two connections in the backlog while the listener is disabled.
+  listener.disable();
+  int connected = 0;
+  EXPECT_CALL(connection_callbacks, onEvent(ConnectionEvent::Connected))
+      .Times(2)
+      .WillRepeatedly([&] {
+        if (++connected == 2) {
+          dispatcher_->exit();
+        }
+      });
+  EXPECT_CALL(connection_callbacks, onEvent(testing::Ne(ConnectionEvent::Connected)))
+      .Times(testing::AnyNumber());
+  std::vector<ClientConnectionPtr> client_connections;
+  for (int i = 0; i < 2; ++i) {
+    client_connections.push_back(dispatcher_->createClientConnection(
+        socket->connectionInfoProvider().localAddress(), Address::InstanceConstSharedPtr(),
+        Network::Test::createRawBufferSocket(), nullptr, nullptr));
+    client_connections.back()->addConnectionCallbacks(connection_callbacks);
+    client_connections.back()->connect();
+  }
+  EXPECT_CALL(listener_callbacks, onAccept_(_)).Times(0);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  testing::Mock::VerifyAndClearExpectations(&listener_callbacks);
+
+  // Each socket event accepts a single connection and leaves the other one in the backlog.
+  listener.enable();
+  EXPECT_CALL(listener_callbacks, onAccept_(_));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&listener_callbacks);
+
+  EXPECT_CALL(listener_callbacks, onAccept_(_));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+
+  for (auto& client_connection : client_connections) {
+    client_connection->close(ConnectionCloseType::NoFlush);
+  }
+}
+
 TEST_P(TcpListenerImplTest, SetListenerRejectFractionZero) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
@@ -1,6 +1,7 @@
 #include "envoy/config/core/v3/base.pb.h"
 
 #include "source/common/network/address_impl.h"
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
 
@@ -178,6 +179,45 @@ TEST_F(SocketOptionFactoryTest, TestBuildLiteralOptions) {
   EXPECT_EQ(value_bstr, option_details->value_);
 }
 
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+TEST_F(SocketOptionFactoryTest, TestBuildReusePortCpuSteeringOptions) {
+  std::shared_ptr<Socket::Options> options =
+      SocketOptionFactory::buildReusePortCpuSteeringOptions(4);
+
+  const auto expected_option = ENVOY_ATTACH_REUSEPORT_CBPF;
+  const int type = expected_option.level();
+  const int option = expected_option.option();
+  EXPECT_CALL(socket_mock_, setSocketOption(_, _, _, sizeof(sock_fprog)))
+      .WillOnce(Invoke([type, option](int input_type, int input_option, const void* optval,
+                                      socklen_t) -> Api::SysCallIntResult {
+        EXPECT_EQ(type, input_type);
+        EXPECT_EQ(option, input_option);
+        const auto* prog = static_cast<const sock_fprog*>(optval);
+        EXPECT_EQ(3, prog->len);
+        // ld cpu; mod #4; ret a
+        EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), prog->filter[0].k);
+        EXPECT_EQ(4, prog->filter[1].k);
+        return {0, 0};
+      }));
+
+  // The program is attached to the reuse port group once the socket is bound.
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_PREBIND));
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_BOUND));
+
+  // The hash key must not depend on where the program lives.
+  std::vector<uint8_t> hash_key;
+  options->at(0)->hashKey(hash_key);
+  std::vector<uint8_t> same_hash_key;
+  SocketOptionFactory::buildReusePortCpuSteeringOptions(4)->at(0)->hashKey(same_hash_key);
+  EXPECT_EQ(hash_key, same_hash_key);
+  std::vector<uint8_t> other_hash_key;
+  SocketOptionFactory::buildReusePortCpuSteeringOptions(8)->at(0)->hashKey(other_hash_key);
+  EXPECT_NE(hash_key, other_hash_key);
+}
+#endif
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,157 @@
+#include <sys/socket.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/splice_pipe.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::MockFunction;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+#if defined(__linux__)
+
+class SplicePipeTest : public testing::Test {
+protected:
+  void SetUp() override {
+    createSocketPair(source_peer_, source_);
+    createSocketPair(destination_, destination_peer_);
+  }
+
+  void createSocketPair(IoHandlePtr& first, IoHandlePtr& second) {
+    os_fd_t fds[2];
+    ASSERT_EQ(0, Api::OsSysCallsSingleton::get()
+                     .socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds)
+                     .return_value_);
+    first = std::make_unique<IoSocketHandleImpl>(fds[0]);
+    second = std::make_unique<IoSocketHandleImpl>(fds[1]);
+  }
+
+  void writeToSource(absl::string_view data) {
+    ASSERT_EQ(static_cast<ssize_t>(data.size()),
+              Api::OsSysCallsSingleton::get()
+                  .write(source_peer_->fdDoNotUse(), data.data(), data.size())
+                  .return_value_);
+  }
+
+  std::string readFromDestination() {
+    char buffer[1024];
+    const Api::SysCallSizeResult result = Api::OsSysCallsSingleton::get().recv(
+        destination_peer_->fdDoNotUse(), buffer, sizeof(buffer), 0);
+    return result.return_value_ > 0 ? std::string(buffer, result.return_value_) : "";
+  }
+
+  IoHandlePtr source_peer_;
+  IoHandlePtr source_;
+  IoHandlePtr destination_;
+  IoHandlePtr destination_peer_;
+  MockFunction<void()> above_high_watermark_;
+  MockFunction<void()> below_low_watermark_;
+};
+
+TEST_F(SplicePipeTest, MovesBytesBetweenSockets) {
+  SplicePipePtr pipe = SplicePipe::create(0, above_high_watermark_.AsStdFunction(),
+                                          below_low_watermark_.AsStdFunction());
+  ASSERT_NE(nullptr, pipe);
+
+  writeToSource("hello world");
+  Api::IoCallUint64Result result = pipe->spliceFrom(*source_, 1024);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(11, result.return_value_);
+  EXPECT_EQ(11, pipe->bufferedBytes());
+
+  result = pipe->spliceTo(*destination_, 5);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(5, result.return_value_);
+  EXPECT_EQ(6, pipe->bufferedBytes());
+  EXPECT_EQ("hello", readFromDestination());
+
+  result = pipe->spliceTo(*destination_, 1024);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(6, result.return_value_);
+  EXPECT_EQ(0, pipe->bufferedBytes());
+  EXPECT_EQ(" world", readFromDestination());
+
+  // Nothing left to read.
+  result = pipe->spliceFrom(*source_, 1024);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+
+  // End of stream is reported as 0 bytes with no error.
+  source_peer_->close();
+  result = pipe->spliceFrom(*source_, 1024);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+}
+
+TEST_F(SplicePipeTest, Watermarks) {
+  SplicePipePtr pipe = SplicePipe::create(8, above_high_watermark_.AsStdFunction(),
+                                          below_low_watermark_.AsStdFunction());
+  ASSERT_NE(nullptr, pipe);
+
+  writeToSource("0123456789");
+  EXPECT_CALL(above_high_watermark_, Call());
+  ASSERT_TRUE(pipe->spliceFrom(*source_, 1024).ok());
+  EXPECT_TRUE(pipe->aboveHighWatermark());
+
+  // 10 -> 5 bytes buffered is still above the low watermark of 4.
+  EXPECT_CALL(below_low_watermark_, Call()).Times(0);
+  ASSERT_TRUE(pipe->spliceTo(*destination_, 5).ok());
+  EXPECT_TRUE(pipe->aboveHighWatermark());
+  testing::Mock::VerifyAndClearExpectations(&below_low_watermark_);
+
+  EXPECT_CALL(below_low_watermark_, Call());
+  ASSERT_TRUE(pipe->spliceTo(*destination_, 1).ok());
+  EXPECT_FALSE(pipe->aboveHighWatermark());
+  EXPECT_EQ(4, pipe->bufferedBytes());
+}
+
+TEST(SplicePipeSysCallTest, PipeCreationFailure) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> injector(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, pipe2(_, _)).WillOnce(Return(Api::SysCallIntResult{-1, EMFILE}));
+  EXPECT_EQ(nullptr, SplicePipe::create(0, nullptr, nullptr));
+}
+
+TEST(SplicePipeSysCallTest, SpliceErrors) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> injector(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, pipe2(_, _))
+      .WillOnce([](int pipefd[2], int) -> Api::SysCallIntResult {
+        pipefd[0] = -1;
+        pipefd[1] = -1;
+        return {0, 0};
+      });
+  SplicePipePtr pipe = SplicePipe::create(0, nullptr, nullptr);
+  ASSERT_NE(nullptr, pipe);
+
+  IoSocketHandleImpl handle(-1);
+  EXPECT_CALL(linux_os_sys_calls, splice(_, _, _, _, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EPIPE}));
+  Api::IoCallUint64Result result = pipe->spliceFrom(handle, 1024);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(EPIPE, result.err_->getSystemErrorCode());
+  EXPECT_EQ(0, pipe->bufferedBytes());
+}
+
+#else
+
+TEST(SplicePipeTest, NotSupported) {
+  EXPECT_FALSE(SplicePipe::isSupported());
+  EXPECT_EQ(nullptr, SplicePipe::create(0, nullptr, nullptr));
+}
+
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
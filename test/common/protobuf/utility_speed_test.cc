@@ -0,0 +1,81 @@
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.h"
+
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "test/benchmark/main.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using Envoy::benchmark::skipExpensiveBenchmarks;
+
+namespace Envoy {
+namespace {
+
+// Generates a bootstrap with the given number of static clusters of four endpoints, about 400
+// bytes of YAML each.
+envoy::config::bootstrap::v3::Bootstrap generateBootstrap(int64_t num_clusters) {
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  bootstrap.mutable_node()->set_id("node");
+  for (int64_t i = 0; i < num_clusters; ++i) {
+    envoy::config::cluster::v3::Cluster* cluster =
+        bootstrap.mutable_static_resources()->add_clusters();
+    cluster->set_name(absl::StrCat("cluster_", i));
+    cluster->mutable_connect_timeout()->set_seconds(5);
+    cluster->set_type(envoy::config::cluster::v3::Cluster::STATIC);
+    auto* load_assignment = cluster->mutable_load_assignment();
+    load_assignment->set_cluster_name(cluster->name());
+    auto* locality_endpoints = load_assignment->add_endpoints();
+    for (int endpoint = 0; endpoint < 4; ++endpoint) {
+      auto* socket_address = locality_endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(absl::StrCat("10.0.", i % 256, ".", endpoint));
+      socket_address->set_port_value(8080);
+    }
+  }
+  return bootstrap;
+}
+
+// Loads a bootstrap from YAML, like at startup, for 1MB to 100MB of YAML.
+void bmLoadBootstrapFromYaml(::benchmark::State& state) {
+  const int64_t num_clusters = skipExpensiveBenchmarks() ? 1 : state.range(0);
+  const std::string yaml = MessageUtil::getYamlStringFromMessage(generateBootstrap(num_clusters));
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    envoy::config::bootstrap::v3::Bootstrap bootstrap;
+    MessageUtil::loadFromYaml(yaml, bootstrap, ProtobufMessage::getStrictValidationVisitor());
+    ::benchmark::DoNotOptimize(bootstrap.static_resources().clusters_size());
+  }
+  state.SetBytesProcessed(state.iterations() * yaml.size());
+}
+BENCHMARK(bmLoadBootstrapFromYaml)
+    ->Arg(1 << 12)
+    ->Arg(1 << 15)
+    ->Arg(1 << 18)
+    ->Unit(::benchmark::kMillisecond);
+
+// Loads a bootstrap from JSON, for about the same sizes as the YAML benchmark.
+void bmLoadBootstrapFromJson(::benchmark::State& state) {
+  const int64_t num_clusters = skipExpensiveBenchmarks() ? 1 : state.range(0);
+  const std::string json =
+      MessageUtil::getJsonStringFromMessageOrDie(generateBootstrap(num_clusters), false);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    envoy::config::bootstrap::v3::Bootstrap bootstrap;
+    MessageUtil::loadFromJson(json, bootstrap, ProtobufMessage::getStrictValidationVisitor());
+    ::benchmark::DoNotOptimize(bootstrap.static_resources().clusters_size());
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(bmLoadBootstrapFromJson)
+    ->Arg(1 << 12)
+    ->Arg(1 << 15)
+    ->Arg(1 << 18)
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Envoy
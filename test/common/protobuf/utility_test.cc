@@ -1279,6 +1279,32 @@ TEST_F(ProtobufUtilityTest, MessageUtilLoadYamlDouble) {
   EXPECT_DOUBLE_EQ(1.0, v.value());
 }
 
+// Verifies that loading YAML as a message is equivalent to loading it as a ProtobufWkt::Value.
+TEST_F(ProtobufUtilityTest, MessageUtilLoadYamlMatchesValueUtil) {
+  for (const std::string yaml : {
+           "foo: bar",
+           "foo: [1, -2, true, null, 1.5, 9223372036854775807, 0x10, !ignore baz]",
+           "foo: {bar: {baz: \"\\\"quoted\\\\\\n\\t\\u0001\"}, qux: !ignore quux}",
+           "!ignore foo: bar\nbaz: qux",
+           "foo: bar\nfoo: baz",
+           "foo: ! 1",
+       }) {
+    ProtobufWkt::Struct message;
+    MessageUtil::loadFromYaml(yaml, message, ProtobufMessage::getNullValidationVisitor());
+    EXPECT_TRUE(TestUtility::protoEqual(ValueUtil::loadFromYaml(yaml).struct_value(), message))
+        << yaml;
+  }
+
+  ProtobufWkt::Int64Value int64_value;
+  MessageUtil::loadFromYaml("value: 9223372036854775807", int64_value,
+                            ProtobufMessage::getNullValidationVisitor());
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), int64_value.value());
+  ProtobufWkt::StringValue string_value;
+  MessageUtil::loadFromYaml("value: \"a\\\"b\\\\c\\nd\\u0001\"", string_value,
+                            ProtobufMessage::getNullValidationVisitor());
+  EXPECT_EQ("a\"b\\c\nd\x01", string_value.value());
+}
+
 TEST_F(ProtobufUtilityTest, ValueUtilLoadFromYamlScalar) {
   EXPECT_TRUE(checkProtoEquality(ValueUtil::loadFromYaml("null"), "null_value: NULL_VALUE"));
   EXPECT_TRUE(checkProtoEquality(ValueUtil::loadFromYaml("true"), "bool_value: true"));
@@ -333,6 +333,27 @@ TEST_F(EnvoyQuicServerStreamTest, DecodeHeadersBodyAndTrailers) {
   EXPECT_CALL(stream_callbacks_, onResetStream(_, _));
 }
 
+TEST_F(EnvoyQuicServerStreamTest, DecodeBodyOfSeveralDataFrames) {
+  size_t offset = receiveRequestHeaders(false);
+
+  std::string body;
+  std::string data;
+  for (const char c : {'a', 'b', 'c'}) {
+    const std::string part(1000, c);
+    body += part;
+    data += bodyToHttp3StreamPayload(part);
+  }
+  // The payloads of all the DATA frames are read into a single slice.
+  EXPECT_CALL(stream_decoder_, decodeData(_, /*end_stream=*/true))
+      .WillOnce(Invoke([&body](Buffer::Instance& buffer, bool) {
+        EXPECT_EQ(body, buffer.toString());
+        EXPECT_EQ(1u, buffer.getRawSlices().size());
+      }));
+  quic::QuicStreamFrame frame(stream_id_, true, offset, data);
+  quic_stream_->OnStreamFrame(frame);
+  quic_stream_->encodeHeaders(response_headers_, /*end_stream=*/true);
+}
+
 TEST_F(EnvoyQuicServerStreamTest, ResetStreamByHCM) {
   receiveRequest(request_body_, false, request_body_.size() * 2);
   EXPECT_CALL(quic_session_, MaybeSendStopSendingFrame(_, _));
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -85,8 +86,12 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
  * We then time how long it takes for the request to be matched against the
  * last route.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool compiled_path_index = false) {
   // Setup router for benchmarking.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.compiled_route_path_index",
+                               compiled_path_index ? "true" : "false"}});
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
@@ -136,9 +141,66 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
-BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
-BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+/**
+ * Same as bmRouteTableSizeWithPathPrefixMatch, with the compiled route path index enabled.
+ */
+static void bmCompiledIndexRouteTableSizeWithPathPrefixMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix, true);
+}
+
+/**
+ * Same as bmRouteTableSizeWithExactPathMatch, with the compiled route path index enabled.
+ */
+static void bmCompiledIndexRouteTableSizeWithExactPathMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath, true);
+}
+
+/**
+ * Measure the per filter config lookups that each filter of a request does on the matched route,
+ * which fall back through the virtual host and route configuration when none are configured.
+ */
+static void bmMostSpecificPerFilterConfig(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  ConfigImpl config(genRouteConfig(state, RouteMatch::PathSpecifierCase::kPrefix),
+                    OptionalHttpFilters(), factory_context,
+                    ProtobufMessage::getNullValidationVisitor(), true);
+  RouteConstSharedPtr route = config.route(genRequestHeaders(0), stream_info, 0);
+  RELEASE_ASSERT(route != nullptr, "");
+
+  std::vector<std::string> filter_names;
+  for (int i = 0; i < 15; ++i) {
+    filter_names.push_back(absl::StrCat("envoy.filters.http.filter_", i));
+  }
+
+  for (auto _ : state) { // NOLINT
+    for (const std::string& name : filter_names) {
+      benchmark::DoNotOptimize(route->mostSpecificPerFilterConfig(name));
+    }
+  }
+}
+
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithExactPathMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmCompiledIndexRouteTableSizeWithPathPrefixMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmCompiledIndexRouteTableSizeWithExactPathMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmMostSpecificPerFilterConfig)->Arg(1);
 
 } // namespace
 } // namespace Router
@@ -14,6 +14,7 @@
 #include "envoy/server/filter_config.h"
 #include "envoy/type/v3/percent.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/config/metadata.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/http/header_map_impl.h"
@@ -3137,6 +3138,25 @@ TEST_F(RouterMatcherHashPolicyTest, HashQueryParameters) {
   }
 }
 
+TEST_F(RouterMatcherHashPolicyTest, HashQueryParameterValues) {
+  firstRouteHashPolicy()->mutable_query_parameter()->set_name("param");
+  const auto generate_hash = [this](const std::string& path) {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", path, "GET");
+    Router::RouteConstSharedPtr route = config().route(headers, 0);
+    return route->routeEntry()->hashPolicy()->generateHash(nullptr, headers, add_cookie_nop_,
+                                                           nullptr);
+  };
+  // The value of the first occurrence of the parameter is hashed.
+  EXPECT_EQ(HashUtil::xxHash64("xyz"), generate_hash("/foo?a=b&param=xyz&param=abc"));
+  EXPECT_EQ(HashUtil::xxHash64("x=y"), generate_hash("/foo?param=x=y"));
+  // A parameter without a value hashes as the empty string.
+  EXPECT_EQ(HashUtil::xxHash64(""), generate_hash("/foo?param&a=b"));
+  EXPECT_EQ(HashUtil::xxHash64(""), generate_hash("/foo?param="));
+  // Parameter names must match exactly.
+  EXPECT_FALSE(generate_hash("/foo?params=xyz&aparam=xyz&&"));
+  EXPECT_FALSE(generate_hash("/foo?"));
+}
+
 class RouterMatcherFilterStateHashPolicyTest : public RouterMatcherHashPolicyTest {
 public:
   RouterMatcherFilterStateHashPolicyTest()
@@ -8638,6 +8658,196 @@ virtual_hosts:
   }
 }
 
+// Verifies that the compiled path index keeps the first-match semantics of the linear route scan
+// for a mix of indexed and unindexed routes.
+TEST_F(RouteMatcherTest, CompiledPathIndexPreservesRouteOrder) {
+  mergeValues({{"envoy.reloadable_features.compiled_route_path_index", "true"}});
+
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: indexed
+    domains: ["*"]
+    routes:
+      - match:
+          path: "/exact"
+        route: { cluster: exact-cluster }
+      - match:
+          safe_regex:
+            regex: "/api/v1/.*"
+        route: { cluster: regex-cluster }
+      - match:
+          prefix: "/api/"
+          headers:
+          - name: x-special
+            present_match: true
+        route: { cluster: header-cluster }
+      - match:
+          path_separated_prefix: "/api"
+        route: { cluster: separated-cluster }
+      - match:
+          prefix: "/API/"
+          case_sensitive: false
+        route: { cluster: insensitive-cluster }
+      - match:
+          prefix: "/api"
+        route: { cluster: prefix-cluster }
+      - match:
+          prefix: "/"
+        route: { cluster: default-cluster }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"exact-cluster", "regex-cluster", "header-cluster", "separated-cluster",
+       "insensitive-cluster", "prefix-cluster", "default-cluster"},
+      {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  auto cluster_for = [&config](const Http::TestRequestHeaderMapImpl& headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("exact-cluster", cluster_for(genHeaders("www.lyft.com", "/exact?foo=bar", "GET")));
+  EXPECT_EQ("default-cluster", cluster_for(genHeaders("www.lyft.com", "/exact/more", "GET")));
+  EXPECT_EQ("regex-cluster", cluster_for(genHeaders("www.lyft.com", "/api/v1/users", "GET")));
+
+  Http::TestRequestHeaderMapImpl special = genHeaders("www.lyft.com", "/api/v2", "GET");
+  special.addCopy("x-special", "yes");
+  EXPECT_EQ("header-cluster", cluster_for(special));
+
+  EXPECT_EQ("separated-cluster", cluster_for(genHeaders("www.lyft.com", "/api", "GET")));
+  EXPECT_EQ("separated-cluster", cluster_for(genHeaders("www.lyft.com", "/api/v2", "GET")));
+  EXPECT_EQ("insensitive-cluster", cluster_for(genHeaders("www.lyft.com", "/Api/v2", "GET")));
+  EXPECT_EQ("prefix-cluster", cluster_for(genHeaders("www.lyft.com", "/apiv2", "GET")));
+  EXPECT_EQ("default-cluster", cluster_for(genHeaders("www.lyft.com", "/other", "GET")));
+}
+
+// Verifies that the route callback sees the same evaluation status with the compiled path index
+// as with the linear route scan.
+TEST_F(RouteMatcherTest, CompiledPathIndexRouteCallback) {
+  mergeValues({{"envoy.reloadable_features.compiled_route_path_index", "true"}});
+
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: indexed
+    domains: ["*"]
+    routes:
+      - match:
+          prefix: "/foo"
+        route: { cluster: foo-cluster }
+      - match:
+          prefix: "/bar"
+        route: { cluster: bar-cluster }
+      - match:
+          prefix: "/"
+        route: { cluster: default-cluster }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"foo-cluster", "bar-cluster", "default-cluster"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  std::vector<std::pair<std::string, RouteEvalStatus>> seen;
+  Router::RouteConstSharedPtr route = config.route(
+      [&seen](RouteConstSharedPtr route, RouteEvalStatus status) -> RouteMatchStatus {
+        seen.emplace_back(route->routeEntry()->clusterName(), status);
+        return RouteMatchStatus::Continue;
+      },
+      genHeaders("www.lyft.com", "/foo", "GET"));
+  EXPECT_EQ(nullptr, route);
+  ASSERT_EQ(2, seen.size());
+  EXPECT_EQ("foo-cluster", seen[0].first);
+  EXPECT_EQ(RouteEvalStatus::HasMoreRoutes, seen[0].second);
+  EXPECT_EQ("default-cluster", seen[1].first);
+  EXPECT_EQ(RouteEvalStatus::NoMoreRoutes, seen[1].second);
+}
+
+// Verifies that a new version of a route configuration reuses the virtual hosts whose config is
+// unchanged, and only while the rest of the route configuration is unchanged.
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHosts) {
+  mergeValues({{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "true"}});
+
+  const std::string yaml = R"EOF(
+name: foo
+virtual_hosts:
+  - name: unchanged
+    domains: ["unchanged.lyft.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: unchanged-cluster }
+  - name: changed
+    domains: ["changed.lyft.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: changed-cluster }
+  )EOF";
+  const NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const auto virtual_host = [&stream_info](const ConfigImpl& config, const std::string& host) {
+    return &config.route(genHeaders(host, "/", "GET"), stream_info, 0)
+                ->routeEntry()
+                ->virtualHost();
+  };
+  const auto create_config = [this, &yaml](const std::string& cluster, const std::string& header,
+                                           const ConfigImpl* previous_config) {
+    envoy::config::route::v3::RouteConfiguration route_config =
+        parseRouteConfigurationFromYaml(yaml);
+    route_config.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster(cluster);
+    route_config.add_internal_only_headers(header);
+    return std::make_unique<ConfigImpl>(route_config, OptionalHttpFilters(), factory_context_,
+                                        ProtobufMessage::getNullValidationVisitor(), false,
+                                        previous_config);
+  };
+
+  const auto config_v1 = create_config("cluster-v1", "x-internal", nullptr);
+  const auto config_v2 = create_config("cluster-v2", "x-internal", config_v1.get());
+  EXPECT_EQ(virtual_host(*config_v1, "unchanged.lyft.com"),
+            virtual_host(*config_v2, "unchanged.lyft.com"));
+  EXPECT_NE(virtual_host(*config_v1, "changed.lyft.com"),
+            virtual_host(*config_v2, "changed.lyft.com"));
+  EXPECT_EQ("cluster-v2",
+            config_v2->route(genHeaders("changed.lyft.com", "/", "GET"), stream_info, 0)
+                ->routeEntry()
+                ->clusterName());
+  EXPECT_EQ("foo", virtual_host(*config_v2, "unchanged.lyft.com")->routeConfig().name());
+
+  // The virtual hosts depend on the rest of the route configuration, so they are all rebuilt.
+  const auto config_v3 = create_config("cluster-v2", "x-other-internal", config_v2.get());
+  EXPECT_NE(virtual_host(*config_v2, "unchanged.lyft.com"),
+            virtual_host(*config_v3, "unchanged.lyft.com"));
+  EXPECT_EQ("x-other-internal", virtual_host(*config_v3, "unchanged.lyft.com")
+                                    ->routeConfig()
+                                    .internalOnlyHeaders()
+                                    .front()
+                                    .get());
+}
+
+// Verifies that the virtual hosts are not reused when the route configuration validates clusters,
+// as the clusters of a reused virtual host would not be validated again.
+TEST_F(RouteMatcherTest, NoReuseOfVirtualHostsWhenValidatingClusters) {
+  mergeValues({{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "true"}});
+
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: www
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: www-cluster }
+  )EOF";
+  factory_context_.cluster_manager_.initializeClusters({"www-cluster"}, {});
+  const NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const ConfigImpl config_v1(parseRouteConfigurationFromYaml(yaml), OptionalHttpFilters(),
+                             factory_context_, ProtobufMessage::getNullValidationVisitor(), true);
+  const ConfigImpl config_v2(parseRouteConfigurationFromYaml(yaml), OptionalHttpFilters(),
+                             factory_context_, ProtobufMessage::getNullValidationVisitor(), true,
+                             &config_v1);
+  EXPECT_NE(&config_v1.route(genHeaders("www.lyft.com", "/", "GET"), stream_info, 0)
+                 ->routeEntry()
+                 ->virtualHost(),
+            &config_v2.route(genHeaders("www.lyft.com", "/", "GET"), stream_info, 0)
+                 ->routeEntry()
+                 ->virtualHost());
+}
+
 TEST_F(RouteMatcherTest, PathSeparatedPrefixMatchCaseSensitivity) {
 
   const std::string yaml = R"EOF(
@@ -1317,6 +1317,23 @@ TEST(HeaderParser, TestPerFilterStateTranslator) {
   }
 }
 
+TEST(HeaderParserTest, Empty) {
+  EXPECT_TRUE(HeaderParser::defaultParser().empty());
+
+  Protobuf::RepeatedPtrField<HeaderValueOption> headers_to_add;
+  Protobuf::RepeatedPtrField<std::string> headers_to_remove;
+  EXPECT_TRUE(HeaderParser::configure(headers_to_add, headers_to_remove)->empty());
+
+  *headers_to_remove.Add() = "x-removed";
+  EXPECT_FALSE(HeaderParser::configure(headers_to_add, headers_to_remove)->empty());
+
+  headers_to_remove.Clear();
+  HeaderValueOption* header = headers_to_add.Add();
+  header->mutable_header()->set_key("x-added");
+  header->mutable_header()->set_value("value");
+  EXPECT_FALSE(HeaderParser::configure(headers_to_add, headers_to_remove)->empty());
+}
+
 TEST(HeaderParserTest, EvaluateHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -0,0 +1,102 @@
+#include "source/common/router/path_route_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::vector<uint32_t> findCandidates(const PathRouteIndex& index, absl::string_view path) {
+  PathRouteIndex::Candidates candidates;
+  index.findCandidates(path, candidates);
+  return {candidates.begin(), candidates.end()};
+}
+
+TEST(PathRouteIndexTest, Empty) {
+  PathRouteIndex index;
+  EXPECT_THAT(findCandidates(index, "/foo"), IsEmpty());
+  EXPECT_THAT(findCandidates(index, ""), IsEmpty());
+}
+
+TEST(PathRouteIndexTest, Exact) {
+  PathRouteIndex index;
+  index.add(PathRouteIndex::KeyType::Exact, "/foo", 0);
+  index.add(PathRouteIndex::KeyType::Exact, "/foo/bar", 1);
+  index.add(PathRouteIndex::KeyType::Exact, "/foo", 2);
+
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(0, 2));
+  EXPECT_THAT(findCandidates(index, "/foo/bar"), ElementsAre(1));
+  EXPECT_THAT(findCandidates(index, "/fo"), IsEmpty());
+  EXPECT_THAT(findCandidates(index, "/foo/"), IsEmpty());
+}
+
+TEST(PathRouteIndexTest, Prefix) {
+  PathRouteIndex index;
+  index.add(PathRouteIndex::KeyType::Prefix, "/foo/bar", 0);
+  index.add(PathRouteIndex::KeyType::Prefix, "/foo", 1);
+  index.add(PathRouteIndex::KeyType::Prefix, "", 2);
+
+  EXPECT_THAT(findCandidates(index, "/foo/bar/baz"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(findCandidates(index, "/foobar"), ElementsAre(1, 2));
+  EXPECT_THAT(findCandidates(index, "/other"), ElementsAre(2));
+  EXPECT_THAT(findCandidates(index, ""), ElementsAre(2));
+}
+
+TEST(PathRouteIndexTest, PathSeparatedPrefix) {
+  PathRouteIndex index;
+  index.add(PathRouteIndex::KeyType::PathSeparatedPrefix, "/api", 0);
+
+  EXPECT_THAT(findCandidates(index, "/api"), ElementsAre(0));
+  EXPECT_THAT(findCandidates(index, "/api/"), ElementsAre(0));
+  EXPECT_THAT(findCandidates(index, "/api/v1"), ElementsAre(0));
+  EXPECT_THAT(findCandidates(index, "/apiv1"), IsEmpty());
+  EXPECT_THAT(findCandidates(index, "/ap"), IsEmpty());
+}
+
+TEST(PathRouteIndexTest, UnindexedRoutesKeepRouteOrder) {
+  PathRouteIndex index;
+  index.addUnindexed(0);
+  index.add(PathRouteIndex::KeyType::Prefix, "/foo", 1);
+  index.addUnindexed(2);
+  index.add(PathRouteIndex::KeyType::Exact, "/foo", 3);
+  index.add(PathRouteIndex::KeyType::Prefix, "/", 4);
+
+  EXPECT_EQ(2, index.unindexedSize());
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_THAT(findCandidates(index, "/bar"), ElementsAre(0, 2, 4));
+  EXPECT_THAT(findCandidates(index, "bar"), ElementsAre(0, 2));
+}
+
+TEST(PathRouteIndexTest, RegexSet) {
+  PathRouteIndex index;
+  index.addRegex("/shelves/[^/]+/books", 0);
+  index.add(PathRouteIndex::KeyType::Prefix, "/shelves/", 1);
+  index.addRegex("/shelves/.*", 2);
+  index.addRegex("/shelves", 3);
+  index.finalize();
+
+  EXPECT_EQ(3, index.regexSetSize());
+  EXPECT_EQ(0, index.unindexedSize());
+  EXPECT_THAT(findCandidates(index, "/shelves/1/books"), ElementsAre(0, 1, 2));
+  // Regexes must match the full path.
+  EXPECT_THAT(findCandidates(index, "/shelves/1/books/2"), ElementsAre(1, 2));
+  EXPECT_THAT(findCandidates(index, "/shelves"), ElementsAre(3));
+  EXPECT_THAT(findCandidates(index, "/other/shelves"), IsEmpty());
+}
+
+TEST(PathRouteIndexTest, EmptyRegexSet) {
+  PathRouteIndex index;
+  index.add(PathRouteIndex::KeyType::Prefix, "/", 0);
+  index.finalize();
+
+  EXPECT_EQ(0, index.regexSetSize());
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(0));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -795,6 +795,53 @@ TEST_F(RouterTest, EnvoyUpstreamServiceTime) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
 }
 
+// Validate that load balancing policies that keep state for the host are told about the response
+// time and the load report of a response.
+TEST_F(RouterTest, HostLbPolicyDataSeesResponse) {
+  NiceMock<Upstream::MockHostLbPolicyData> lb_policy_data;
+  ON_CALL(*cm_.thread_local_cluster_.conn_pool_.host_, lbPolicyData())
+      .WillByDefault(Return(&lb_policy_data));
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  Http::ResponseHeaderMapPtr response_headers(new Http::TestResponseHeaderMapImpl{
+      {":status", "200"}, {"endpoint-load-metrics", "TEXT cpu_utilization=0.5"}});
+  EXPECT_CALL(lb_policy_data, onLoadReport(absl::string_view("TEXT cpu_utilization=0.5")));
+  EXPECT_CALL(lb_policy_data, onResponseTime(_));
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
+}
+
+// Validate that load reports are also read from response trailers.
+TEST_F(RouterTest, HostLbPolicyDataSeesLoadReportInTrailers) {
+  NiceMock<Upstream::MockHostLbPolicyData> lb_policy_data;
+  ON_CALL(*cm_.thread_local_cluster_.conn_pool_.host_, lbPolicyData())
+      .WillByDefault(Return(&lb_policy_data));
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  EXPECT_CALL(lb_policy_data, onLoadReport(absl::string_view("TEXT rps_fractional=10")));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), false);
+  Http::ResponseTrailerMapPtr response_trailers(
+      new Http::TestResponseTrailerMapImpl{{"endpoint-load-metrics", "TEXT rps_fractional=10"}});
+  response_decoder->decodeTrailers(std::move(response_trailers));
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
+}
+
 // Validate that x-envoy-attempt-count is added to request headers when the option is true.
 TEST_F(RouterTest, EnvoyAttemptCountInRequest) {
   verifyAttemptCountInRequestBasic(
@@ -4635,6 +4682,65 @@ TEST_P(RouterShadowingTest, StreamingShadow) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
 }
 
+TEST_P(RouterShadowingTest, StreamingShadowAbandonedAboveHighWatermark) {
+  if (!streaming_shadow_) {
+    GTEST_SKIP();
+  }
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.abandon_shadows_above_high_watermark", "true"}});
+  // Recreate router filter so it latches the value of the runtime flag.
+  router_ = std::make_unique<RouterTestFilter>(config_, config_.default_stats_);
+  router_->setDecoderFilterCallbacks(callbacks_);
+  router_->downstream_connection_.stream_info_.downstream_connection_info_provider_
+      ->setLocalAddress(host_address_);
+  router_->downstream_connection_.stream_info_.downstream_connection_info_provider_
+      ->setRemoteAddress(Network::Utility::parseInternetAddressAndPort("1.2.3.4:80"));
+
+  ShadowPolicyPtr policy = makeShadowPolicy("foo", "", "bar");
+  callbacks_.route_->route_entry_.shadow_policies_.push_back(policy);
+  ON_CALL(callbacks_, streamId()).WillByDefault(Return(43));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+
+  expectResponseTimerCreate();
+
+  EXPECT_CALL(
+      runtime_.snapshot_,
+      featureEnabled("bar", testing::Matcher<const envoy::type::v3::FractionalPercent&>(Percent(0)),
+                     43))
+      .WillOnce(Return(true));
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  NiceMock<Http::MockAsyncClient> foo_client;
+  NiceMock<Http::MockAsyncClientOngoingRequest> foo_request(&foo_client);
+  EXPECT_CALL(*shadow_writer_, streamingShadow_("foo", _, _)).WillOnce(Return(&foo_request));
+  // The shadow does not apply back-pressure to the request.
+  EXPECT_CALL(foo_request, setWatermarkCallbacks(_)).Times(0);
+  router_->decodeHeaders(headers, false);
+
+  Buffer::OwnedImpl body_data("hello");
+  EXPECT_CALL(foo_request, sendData(BufferStringEqual("hello"), false));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, router_->decodeData(body_data, false));
+
+  // Once the shadow is above its high watermark, it is abandoned and the request proceeds.
+  EXPECT_CALL(foo_request, isAboveWriteBufferHighWatermark()).WillOnce(Return(true));
+  EXPECT_CALL(foo_request, sendData(_, _)).Times(0);
+  EXPECT_CALL(foo_request, cancel());
+  EXPECT_CALL(encoder, encodeData(BufferStringEqual("hello"), true));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, router_->decodeData(body_data, true));
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("retry_or_shadow_abandoned")
+                    .value());
+
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
+}
+
 TEST_P(RouterShadowingTest, BufferingShadow) {
   if (streaming_shadow_) {
     GTEST_SKIP();
@@ -0,0 +1,75 @@
+#include "envoy/type/v3/percent.pb.h"
+
+#include "source/common/common/random_generator.h"
+#include "source/common/runtime/runtime_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Runtime {
+namespace {
+
+// A snapshot with an admin layer of the given number of keys, named key_0 to key_<n-1>.
+class SnapshotBenchmark {
+public:
+  explicit SnapshotBenchmark(int64_t num_keys)
+      : stats_{ALL_RUNTIME_STATS(POOL_COUNTER(*store_.rootScope()),
+                                 POOL_GAUGE(*store_.rootScope()))} {
+    auto layer = std::make_unique<AdminLayer>("admin", stats_);
+    absl::node_hash_map<std::string, std::string> values;
+    for (int64_t i = 0; i < num_keys; ++i) {
+      values.emplace(absl::StrCat("key_", i), absl::StrCat(i % 100));
+    }
+    layer->mergeValues(values);
+    std::vector<Snapshot::OverrideLayerConstPtr> layers;
+    layers.push_back(std::move(layer));
+    snapshot_ = std::make_unique<SnapshotImpl>(random_, stats_, std::move(layers));
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  RuntimeStats stats_;
+  Random::RandomGeneratorImpl random_;
+  std::unique_ptr<SnapshotImpl> snapshot_;
+};
+
+// Looks up an integer by its key, as the callers of the snapshot do.
+static void bmGetInteger(benchmark::State& state) {
+  SnapshotBenchmark snapshot(state.range(0));
+  const std::string key = "key_1";
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(snapshot.snapshot_->getInteger(key, 0));
+  }
+}
+BENCHMARK(bmGetInteger)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Reads the integer of an entry looked up once, which is the most that resolving keys up front
+// could save over bmGetInteger.
+static void bmGetIntegerOfResolvedEntry(benchmark::State& state) {
+  SnapshotBenchmark snapshot(state.range(0));
+  const Snapshot::Entry& entry = snapshot.snapshot_->values().find("key_1")->second;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(entry.uint_value_.value_or(0));
+  }
+}
+BENCHMARK(bmGetIntegerOfResolvedEntry)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Evaluates a fractional percent, with the key set or falling back to the default.
+static void bmFeatureEnabledFractionalPercent(benchmark::State& state) {
+  SnapshotBenchmark snapshot(1000);
+  const std::string key = state.range(0) ? "key_1" : "missing";
+  envoy::type::v3::FractionalPercent default_value;
+  default_value.set_numerator(50);
+  default_value.set_denominator(envoy::type::v3::FractionalPercent::TEN_THOUSAND);
+  uint64_t random_value = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(
+        snapshot.snapshot_->featureEnabled(key, default_value, random_value++));
+  }
+}
+BENCHMARK(bmFeatureEnabledFractionalPercent)->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace Runtime
+} // namespace Envoy
@@ -391,6 +391,24 @@ TEST_F(StatMergerThreadLocalTest, RetainNeverImportModeAfterMerge) {
   EXPECT_EQ(42, gauge.value());
 }
 
+// The gauges merged from the parent are remembered across merges, so verify that a gauge which the
+// child initializes as never import after the first merge stops taking the values of the parent.
+TEST_F(StatMergerThreadLocalTest, NeverImportAfterFirstMerge) {
+  StatMerger stat_merger(store_);
+  Protobuf::Map<std::string, uint64_t> counter_deltas;
+  Protobuf::Map<std::string, uint64_t> gauges;
+  gauges["mygauge"] = 789;
+  stat_merger.mergeStats(counter_deltas, gauges);
+
+  Gauge& gauge = store_.gaugeFromString("mygauge", Gauge::ImportMode::NeverImport);
+  EXPECT_EQ(Gauge::ImportMode::NeverImport, gauge.importMode());
+  EXPECT_EQ(0, gauge.value());
+
+  gauges["mygauge"] = 790;
+  stat_merger.mergeStats(counter_deltas, gauges);
+  EXPECT_EQ(0, gauge.value());
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -5,6 +5,7 @@
 
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -330,5 +331,23 @@ TEST_F(StatsMatcherTest, CheckMultipleAssortedExclusionMatchersWithPrefix) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+// Many token prefixes of different lengths, enough that some of their symbols take more than one
+// byte to encode.
+TEST_F(StatsMatcherTest, CheckManyExclusionPrefixes) {
+  for (int i = 0; i < 300; ++i) {
+    exclusionList()->set_prefix(absl::StrCat("prefix", i, ".a."));
+    exclusionList()->set_prefix(absl::StrCat("prefix", i, ".b.c."));
+  }
+  initMatcher();
+  expectAccepted({"prefix7", "prefix7.b", "prefix7.c", "prefix7.b.d", "prefix7.ab", "prefix300.a",
+                  "foo.prefix7.a", "prefix299.c.b"});
+  expectDenied({"prefix7.a", "prefix7.a.foo", "prefix7.b.c", "prefix7.b.c.foo", "prefix299.a",
+                "prefix299.b.c.foo"});
+  EXPECT_EQ(StatsMatcher::FastResult::Rejects,
+            stats_matcher_impl_->fastRejects(pool_.add("prefix250.b.c.foo")));
+  EXPECT_FALSE(stats_matcher_impl_->acceptsAll());
+  EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -13,6 +13,7 @@
 #include "test/common/stats/make_elements_helper.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
@@ -62,6 +63,51 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Measures concurrent encoding of names whose tokens have all been symbolized
+// already, as happens when workers create per-cluster stats during CDS churn.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeExistingContention(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  constexpr int num_clusters = 100;
+  constexpr int encodes_per_thread = 10000;
+  Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+  Envoy::Stats::SymbolTableImpl table;
+
+  std::vector<std::string> names;
+  names.reserve(num_clusters);
+  Envoy::Stats::StatNamePool pool(table);
+  for (int i = 0; i < num_clusters; ++i) {
+    names.push_back(absl::StrCat("cluster.cluster_", i, ".upstream_rq_total"));
+    pool.add(names.back());
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer start;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&start, &table, &names, i]() {
+        start.wait();
+        for (int count = 0; count < encodes_per_thread; ++count) {
+          Envoy::Stats::StatNameStorage storage(names[(i + count) % names.size()], table);
+          storage.free(table);
+        }
+      }));
+    }
+    start.setReady();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+}
+BENCHMARK(bmEncodeExistingContention)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(::benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
@@ -287,6 +287,9 @@ TEST(TagExtractorTest, DefaultTagExtractors) {
   regex_tester.testRegex("http.egress_dynamodb_iad.dynamodb.table.bar_table.upstream_rq_time",
                          "http.dynamodb.table.upstream_rq_time",
                          {dynamo_http_prefix, dynamo_table});
+  regex_tester.testRegex("http.egress_dynamodb_iad.dynamodb.error.bar_table.ValidationException",
+                         "http.dynamodb.error.ValidationException",
+                         {dynamo_http_prefix, dynamo_table});
   regex_tester.testRegex(
       "http.egress_dynamodb_iad.dynamodb.table.bar_table.capacity.Query.__partition_id=ABC1234",
       "http.dynamodb.table.capacity",
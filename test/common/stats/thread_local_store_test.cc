@@ -1521,6 +1521,56 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Histograms without new values are only merged once more to clear their interval statistics.
+TEST_F(HistogramTest, IdleHistogramIntervalIsCleared) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+  NameHistogramMap name_histogram_map = makeHistogramMap(store_->histograms());
+  const ParentHistogramSharedPtr& p1 = name_histogram_map["h1"];
+  const ParentHistogramSharedPtr& p2 = name_histogram_map["h2"];
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 1));
+  h1.recordValue(1);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(1, p1->intervalStatistics().sampleCount());
+  EXPECT_EQ(1, p1->cumulativeStatistics().sampleCount());
+  EXPECT_FALSE(p2->used());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h2), 2));
+  h2.recordValue(2);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(0, p1->intervalStatistics().sampleCount());
+  EXPECT_EQ(1, p1->cumulativeStatistics().sampleCount());
+  EXPECT_EQ(1, p2->intervalStatistics().sampleCount());
+
+  store_->mergeHistograms([]() -> void {});
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(0, p1->intervalStatistics().sampleCount());
+  EXPECT_EQ(1, p1->cumulativeStatistics().sampleCount());
+  EXPECT_EQ(0, p2->intervalStatistics().sampleCount());
+  EXPECT_EQ(1, p2->cumulativeStatistics().sampleCount());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 3));
+  h1.recordValue(3);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(1, p1->intervalStatistics().sampleCount());
+  EXPECT_EQ(2, p1->cumulativeStatistics().sampleCount());
+}
+
+// Values recorded into a histogram that is released before the merge are dropped.
+TEST_F(HistogramTest, ReleasedHistogramIsNotMerged) {
+  ScopeSharedPtr scope1 = store_->createScope("scope1.");
+  Histogram& h1 = scope1->histogramFromString("h1", Histogram::Unit::Unspecified);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 1));
+  h1.recordValue(1);
+  scope1.reset();
+
+  bool merge_called = false;
+  store_->mergeHistograms([&merge_called]() -> void { merge_called = true; });
+  EXPECT_TRUE(merge_called);
+  EXPECT_TRUE(store_->histograms().empty());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -36,9 +36,9 @@ std::chrono::nanoseconds checkDuration(std::chrono::nanoseconds last,
 
 class StreamInfoImplTest : public testing::Test {
 protected:
-  void assertStreamInfoSize(StreamInfoImpl stream_info) {
-    ASSERT_TRUE(sizeof(stream_info) == 800 || sizeof(stream_info) == 816 ||
-                sizeof(stream_info) == 840)
+  void assertStreamInfoSize(const StreamInfoImpl& stream_info) {
+    ASSERT_TRUE(sizeof(stream_info) == 544 || sizeof(stream_info) == 560 ||
+                sizeof(stream_info) == 584)
         << "If adding fields to StreamInfoImpl, please check to see if you "
            "need to add them to setFromForRecreateStream or setFrom! Current size "
         << sizeof(stream_info);
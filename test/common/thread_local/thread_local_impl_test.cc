@@ -290,6 +290,53 @@ TEST_F(ThreadLocalInstanceImplTest, RunOnAllThreads) {
   tls_.shutdownThread();
 }
 
+// Validate that the updates of an update batch reach each worker in a single post.
+TEST_F(ThreadLocalInstanceImplTest, UpdateBatch) {
+  TypedSlot<StringSlotObject> slot1(tls_);
+  TypedSlot<StringSlotObject> slot2(tls_);
+  EXPECT_CALL(thread_dispatcher_, post(_)).Times(2);
+  slot1.set([](Event::Dispatcher&) { return std::make_shared<StringSlotObject>(); });
+  slot2.set([](Event::Dispatcher&) { return std::make_shared<StringSlotObject>(); });
+
+  std::list<Event::PostCb> posted;
+  EXPECT_CALL(thread_dispatcher_, post(_)).WillOnce(Invoke([&posted](Event::PostCb cb) {
+    posted.push_back(cb);
+  }));
+  uint32_t update_called = 0;
+  bool all_threads_complete = false;
+  {
+    InstanceImpl::UpdateBatch outer_batch;
+    {
+      InstanceImpl::UpdateBatch inner_batch;
+      slot1.runOnAllThreads([&update_called](OptRef<StringSlotObject> s) {
+        ++update_called;
+        s->str_ += "a";
+      });
+    }
+    slot2.runOnAllThreads(
+        [&update_called](OptRef<StringSlotObject> s) {
+          ++update_called;
+          s->str_ += "b";
+        },
+        [&all_threads_complete]() { all_threads_complete = true; });
+    // The main thread is updated right away.
+    EXPECT_EQ(2, update_called);
+    EXPECT_EQ("a", slot1->str_);
+    EXPECT_EQ("b", slot2->str_);
+    EXPECT_TRUE(posted.empty());
+  }
+  ASSERT_EQ(1, posted.size());
+
+  EXPECT_CALL(main_dispatcher_, post(_));
+  posted.front()();
+  posted.clear();
+  EXPECT_EQ(4, update_called);
+  EXPECT_TRUE(all_threads_complete);
+
+  tls_.shutdownGlobalThreading();
+  tls_.shutdownThread();
+}
+
 // Validate ThreadLocal::InstanceImpl's dispatcher() behavior.
 TEST(ThreadLocalInstanceImplDispatcherTest, Dispatcher) {
   InstanceImpl tls;
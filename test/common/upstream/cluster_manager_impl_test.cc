@@ -1977,6 +1977,10 @@ TEST_F(ClusterManagerImplTest, AddOrUpdateClusterStaticExists) {
   cluster1->initialize_callback_();
 
   EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), ""));
+  // A different config doesn't update the static cluster either.
+  envoy::config::cluster::v3::Cluster modified_cluster = defaultStaticCluster("fake_cluster");
+  modified_cluster.mutable_connect_timeout()->set_seconds(5);
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(modified_cluster, ""));
 
   // Attempt to remove a static cluster.
   EXPECT_FALSE(cluster_manager_->removeCluster("fake_cluster"));
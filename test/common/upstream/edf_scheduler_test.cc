@@ -134,6 +134,50 @@ TEST(EdfSchedulerTest, ManyPeekahead) {
   }
 }
 
+// Validate that update() keeps the deadlines of retained entries, drops removed entries and
+// schedules new entries from the current time.
+TEST(EdfSchedulerTest, Update) {
+  EdfScheduler<const uint32_t> sched;
+  std::vector<std::shared_ptr<uint32_t>> entries;
+  for (uint32_t i = 0; i < 4; ++i) {
+    entries.push_back(std::make_shared<uint32_t>(i));
+    sched.add(1, entries.back());
+  }
+  EXPECT_EQ(0, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+  EXPECT_EQ(1, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+
+  // Entry 0 is still alive but no longer part of the schedule.
+  std::vector<std::shared_ptr<uint32_t>> updated = {entries[1], entries[2], entries[3],
+                                                    std::make_shared<uint32_t>(4)};
+  sched.update(updated, [](const uint32_t&) { return 1; });
+
+  for (uint32_t rounds = 0; rounds < 2; ++rounds) {
+    for (const uint32_t expected : {2, 3, 1, 4}) {
+      EXPECT_EQ(expected, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+    }
+  }
+
+  sched.update(std::vector<std::shared_ptr<uint32_t>>{}, [](const uint32_t&) { return 1; });
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const uint32_t&) { return 1; }));
+}
+
+// Validate that entries removed by update() are not returned from the peek list.
+TEST(EdfSchedulerTest, UpdateRemovesPeekedEntries) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(2, first_entry);
+  sched.add(1, second_entry);
+
+  EXPECT_EQ(37, *sched.peekAgain([](const uint32_t&) { return 1; }));
+  sched.update(std::vector<std::shared_ptr<uint32_t>>{second_entry},
+               [](const uint32_t&) { return 1; });
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(42, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+  }
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -1,11 +1,16 @@
 // Usage: bazel run //test/common/upstream:load_balancer_benchmark
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
 #include <memory>
+#include <random>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
 #include "source/common/common/random_generator.h"
 #include "source/common/memory/stats.h"
+#include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/upstream/maglev_lb.h"
 #include "source/common/upstream/ring_hash_lb.h"
 #include "source/common/upstream/subset_lb.h"
@@ -151,9 +156,54 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures host set updates of a weighted cluster where a single host leaves and rejoins, which is
+// the common case for large clusters with continuous endpoint churn.
+void benchmarkRoundRobinLoadBalancerUpdate(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t weighted_subset_percent = state.range(1);
+  const uint64_t weight = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RoundRobinTester tester(num_hosts, weighted_subset_percent, weight);
+  tester.initialize();
+  const HostVector& hosts = tester.priority_set_.getOrCreateHostSet(0).hosts();
+  HostVectorConstSharedPtr orig_hosts = std::make_shared<HostVector>(hosts);
+  HostVectorConstSharedPtr smaller_hosts =
+      std::make_shared<HostVector>(hosts.begin() + 1, hosts.end());
+  HostsPerLocalitySharedPtr orig_locality_hosts = makeHostsPerLocality({*orig_hosts});
+  HostsPerLocalitySharedPtr smaller_locality_hosts = makeHostsPerLocality({*smaller_hosts});
+  const HostVector host_moved = {orig_hosts->front()};
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.priority_set_.updateHosts(
+        0, HostSetImpl::partitionHosts(smaller_hosts, smaller_locality_hosts), nullptr, {},
+        host_moved, absl::nullopt);
+    tester.priority_set_.updateHosts(
+        0, HostSetImpl::partitionHosts(orig_hosts, orig_locality_hosts), nullptr, host_moved, {},
+        absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerUpdate)
+    ->Args({500, 50, 50})
+    ->Args({2500, 50, 50})
+    ->Args({10000, 50, 50})
+    ->Args({25000, 50, 50})
+    ->Args({50000, 50, 50})
+    ->Unit(::benchmark::kMillisecond);
+
 class RingHashTester : public BaseTester {
 public:
-  RingHashTester(uint64_t num_hosts, uint64_t min_ring_size) : BaseTester(num_hosts) {
+  RingHashTester(uint64_t num_hosts, uint64_t min_ring_size, uint32_t hash_balance_factor = 0)
+      : BaseTester(num_hosts) {
+    if (hash_balance_factor > 0) {
+      common_config_.mutable_consistent_hashing_lb_config()
+          ->mutable_hash_balance_factor()
+          ->set_value(hash_balance_factor);
+    }
     config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
     config_.value().mutable_minimum_ring_size()->set_value(min_ring_size);
     ring_hash_lb_ = std::make_unique<RingHashLoadBalancer>(
@@ -171,8 +221,14 @@ public:
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint32_t hash_balance_factor = 0)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (hash_balance_factor > 0) {
+      common_config_.mutable_consistent_hashing_lb_config()
+          ->mutable_hash_balance_factor()
+          ->set_value(hash_balance_factor);
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(
         priority_set_, stats_, stats_scope_, runtime_, random_,
         config_.has_value()
@@ -384,6 +440,122 @@ BENCHMARK(benchmarkMaglevLoadBalancerChooseHost)
     ->Args({500, 100000})
     ->Unit(::benchmark::kMillisecond);
 
+// Draws key indexes from a Zipfian distribution, so that a few keys are much hotter than the rest.
+class ZipfianKeyGenerator {
+public:
+  ZipfianKeyGenerator(uint64_t num_keys, double exponent) {
+    cdf_.reserve(num_keys);
+    double sum = 0;
+    for (uint64_t i = 1; i <= num_keys; i++) {
+      sum += 1.0 / std::pow(i, exponent);
+      cdf_.push_back(sum);
+    }
+    for (double& p : cdf_) {
+      p /= sum;
+    }
+  }
+
+  uint64_t next() {
+    const double p = std::uniform_real_distribution<double>(0, 1)(random_);
+    return std::lower_bound(cdf_.begin(), cdf_.end(), p) - cdf_.begin();
+  }
+
+private:
+  std::vector<double> cdf_;
+  std::mt19937_64 random_{42};
+};
+
+// Picks hosts for Zipfian distributed keys while tracking active requests the way the router does.
+// Every pick stays active until in_flight later picks were made. The max_load_ratio counter is the
+// highest number of requests that were active on a single host relative to the mean.
+void simulateBoundedLoads(::benchmark::State& state, ThreadAwareLoadBalancer& thread_aware_lb,
+                          ClusterInfo& info, uint64_t num_hosts, uint64_t keys_to_simulate) {
+  const uint64_t in_flight = 10 * num_hosts;
+  thread_aware_lb.initialize();
+  LoadBalancerPtr lb = thread_aware_lb.factory()->create();
+  ZipfianKeyGenerator keys(100 * num_hosts, 1.1);
+  std::vector<uint64_t> hashes;
+  hashes.reserve(keys_to_simulate);
+  for (uint64_t i = 0; i < keys_to_simulate; i++) {
+    hashes.push_back(hashInt(keys.next()));
+  }
+  std::deque<HostConstSharedPtr> active;
+  uint64_t max_host_active = 0;
+  TestLoadBalancerContext context;
+  state.ResumeTiming();
+
+  for (const uint64_t hash : hashes) {
+    context.hash_key_ = hash;
+    HostConstSharedPtr host = lb->chooseHost(&context);
+    host->stats().rq_active_.inc();
+    info.trafficStats()->upstream_rq_active_.inc();
+    max_host_active = std::max(max_host_active, host->stats().rq_active_.value());
+    active.push_back(std::move(host));
+    if (active.size() > in_flight) {
+      active.front()->stats().rq_active_.dec();
+      info.trafficStats()->upstream_rq_active_.dec();
+      active.pop_front();
+    }
+  }
+
+  state.PauseTiming();
+  state.counters["max_load_ratio"] = static_cast<double>(max_host_active) * num_hosts / in_flight;
+  for (const auto& host : active) {
+    host->stats().rq_active_.dec();
+    info.trafficStats()->upstream_rq_active_.dec();
+  }
+  state.ResumeTiming();
+}
+
+void benchmarkRingHashLoadBalancerBoundedLoads(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint32_t hash_balance_factor = state.range(1);
+  const uint64_t keys_to_simulate = benchmark::skipExpensiveBenchmarks() ? 1000 : 100000;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Do not time the creation of the ring.
+    state.PauseTiming();
+    RingHashTester tester(num_hosts, 65536, hash_balance_factor);
+    simulateBoundedLoads(state, *tester.ring_hash_lb_, *tester.info_, num_hosts,
+                         keys_to_simulate);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerBoundedLoads)
+    ->Args({100, 0})
+    ->Args({100, 110})
+    ->Args({100, 125})
+    ->Args({100, 150})
+    ->Args({100, 200})
+    ->Args({500, 0})
+    ->Args({500, 110})
+    ->Args({500, 125})
+    ->Args({500, 150})
+    ->Args({500, 200})
+    ->Unit(::benchmark::kMillisecond);
+
+void benchmarkMaglevLoadBalancerBoundedLoads(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint32_t hash_balance_factor = state.range(1);
+  const uint64_t keys_to_simulate = benchmark::skipExpensiveBenchmarks() ? 1000 : 100000;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Do not time the creation of the table.
+    state.PauseTiming();
+    MaglevTester tester(num_hosts, 0, 0, hash_balance_factor);
+    simulateBoundedLoads(state, *tester.maglev_lb_, *tester.info_, num_hosts, keys_to_simulate);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerBoundedLoads)
+    ->Args({100, 0})
+    ->Args({100, 110})
+    ->Args({100, 125})
+    ->Args({100, 150})
+    ->Args({100, 200})
+    ->Args({500, 0})
+    ->Args({500, 110})
+    ->Args({500, 125})
+    ->Args({500, 150})
+    ->Args({500, 200})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkRingHashLoadBalancerHostLoss(::benchmark::State& state) {
   const uint64_t num_hosts = state.range(0);
   const uint64_t min_ring_size = state.range(1);
@@ -544,7 +716,8 @@ BENCHMARK(benchmarkMaglevLoadBalancerWeighted)
 
 class SubsetLbTester : public BaseTester {
 public:
-  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset)
+  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset,
+                 LoadBalancerType lb_type = LoadBalancerType::Random)
       : BaseTester(num_hosts, 0, 0, true /* attach metadata */) {
     envoy::config::cluster::v3::Cluster::LbSubsetConfig subset_config;
     subset_config.set_fallback_policy(
@@ -555,9 +728,9 @@ public:
 
     subset_info_ = std::make_unique<LoadBalancerSubsetInfoImpl>(subset_config);
     lb_ = std::make_unique<SubsetLoadBalancer>(
-        LoadBalancerType::Random, priority_set_, &local_priority_set_, stats_, stats_scope_,
-        runtime_, random_, *subset_info_, absl::nullopt, absl::nullopt, absl::nullopt,
-        absl::nullopt, common_config_, simTime());
+        lb_type, priority_set_, &local_priority_set_, stats_, stats_scope_, runtime_, random_,
+        *subset_info_, absl::nullopt, absl::nullopt, absl::nullopt, absl::nullopt, common_config_,
+        simTime());
 
     const HostVector& hosts = priority_set_.getOrCreateHostSet(0).hosts();
     ASSERT(hosts.size() == num_hosts);
@@ -586,6 +759,23 @@ public:
   HostVector host_moved_;
 };
 
+// Selects the subset of the host whose metadata value is the given number.
+class SubsetLbContext : public LoadBalancerContextBase {
+public:
+  explicit SubsetLbContext(uint64_t value) {
+    ProtobufWkt::Struct metadata_matches;
+    (*metadata_matches.mutable_fields())[std::string(BaseTester::metadata_key)].set_number_value(
+        value);
+    matches_ = std::make_unique<Router::MetadataMatchCriteriaImpl>(metadata_matches);
+  }
+
+  // Upstream::LoadBalancerContext
+  const Router::MetadataMatchCriteria* metadataMatchCriteria() override { return matches_.get(); }
+
+private:
+  std::unique_ptr<Router::MetadataMatchCriteriaImpl> matches_;
+};
+
 void benchmarkSubsetLoadBalancerCreate(::benchmark::State& state) {
   const bool single_host_per_subset = state.range(0);
   const uint64_t num_hosts = state.range(1);
@@ -622,6 +812,38 @@ BENCHMARK(benchmarkSubsetLoadBalancerUpdate)
     ->Ranges({{false, true}, {50, 2500}})
     ->Unit(::benchmark::kMillisecond);
 
+// Every host is in its own subset. Only the subsets that are used need a ring, so the cost of an
+// update should be dominated by the subset bookkeeping rather than by building num_hosts rings.
+void benchmarkSubsetLoadBalancerRingHashUpdate(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t used_subsets = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  SubsetLbTester tester(num_hosts, false, LoadBalancerType::RingHash);
+  std::vector<std::unique_ptr<SubsetLbContext>> contexts;
+  for (uint64_t i = 0; i < used_subsets; i++) {
+    contexts.push_back(std::make_unique<SubsetLbContext>(i));
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.update();
+    for (auto& context : contexts) {
+      benchmark::DoNotOptimize(tester.lb_->chooseHost(context.get()));
+    }
+  }
+}
+
+BENCHMARK(benchmarkSubsetLoadBalancerRingHashUpdate)
+    ->Args({50, 1})
+    ->Args({500, 1})
+    ->Args({500, 50})
+    ->Args({2500, 1})
+    ->Args({2500, 50})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -25,6 +25,7 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -1045,6 +1046,50 @@ TEST_P(RoundRobinLoadBalancerTest, Weighted) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
 }
 
+// Validate that large weighted host sets are updated in place and keep the weighted distribution.
+TEST_P(RoundRobinLoadBalancerTest, WeightedLargeHostSetUpdate) {
+  constexpr uint32_t num_hosts = 1200;
+  for (uint32_t i = 0; i < num_hosts; ++i) {
+    hostSet().healthy_hosts_.push_back(makeTestHost(
+        info_, absl::StrCat("tcp://127.0.0.1:", 1000 + i), simTime(), i % 2 == 0 ? 1 : 3));
+  }
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  for (uint32_t i = 0; i < num_hosts; ++i) {
+    lb_->chooseHost(nullptr);
+  }
+
+  // Remove a few hosts and add a few new ones.
+  HostVector removed_hosts(hostSet().healthy_hosts_.begin(),
+                           hostSet().healthy_hosts_.begin() + 100);
+  HostVector added_hosts;
+  for (uint32_t i = 0; i < 50; ++i) {
+    added_hosts.push_back(
+        makeTestHost(info_, absl::StrCat("tcp://127.0.0.1:", 3000 + i), simTime(), 2));
+  }
+  hostSet().healthy_hosts_.erase(hostSet().healthy_hosts_.begin(),
+                                 hostSet().healthy_hosts_.begin() + 100);
+  hostSet().healthy_hosts_.insert(hostSet().healthy_hosts_.end(), added_hosts.begin(),
+                                  added_hosts.end());
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks(added_hosts, removed_hosts);
+
+  uint32_t total_weight = 0;
+  for (const auto& host : hostSet().healthy_hosts_) {
+    total_weight += host->weight();
+  }
+  absl::flat_hash_map<const Host*, uint32_t> pick_count;
+  for (uint32_t i = 0; i < 2 * total_weight; ++i) {
+    ++pick_count[lb_->chooseHost(nullptr).get()];
+  }
+  for (const auto& host : removed_hosts) {
+    EXPECT_FALSE(pick_count.contains(host.get()));
+  }
+  for (const auto& host : hostSet().healthy_hosts_) {
+    EXPECT_NEAR(2 * host->weight(), pick_count[host.get()], 2);
+  }
+}
+
 // Validate that the RNG seed influences pick order when weighted RR.
 TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
@@ -0,0 +1,62 @@
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/common/upstream/resource_manager_impl.h"
+
+#include "test/test_common/test_runtime.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// A resource manager shared by all the benchmark threads, as the resource manager of a cluster is
+// shared by all the workers.
+class SharedResourceManager {
+public:
+  SharedResourceManager()
+      : stats_{ALL_CLUSTER_CIRCUIT_BREAKERS_STATS(c, POOL_GAUGE(*store_.rootScope()), h, tr,
+                                                  GENERATE_STATNAME_STRUCT)},
+        manager_(runtime_.loader(), "circuit_breakers.speed_test.default.", 1 << 20, 1 << 20,
+                 1 << 20, 1 << 20, 1 << 20, 1 << 20, stats_, 20.0, 3) {}
+
+  static ResourceManagerImpl& get() {
+    static SharedResourceManager* shared = new SharedResourceManager();
+    return shared->manager_;
+  }
+
+private:
+  TestScopedRuntime runtime_;
+  Stats::IsolatedStoreImpl store_;
+  ClusterCircuitBreakersStats stats_;
+  ResourceManagerImpl manager_;
+};
+
+// Admits a request and completes it, as the router does for each request to the cluster.
+static void bmRequestAdmission(benchmark::State& state) {
+  ResourceLimit& requests = SharedResourceManager::get().requests();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (requests.canCreate()) {
+      requests.inc();
+      requests.dec();
+    }
+  }
+}
+BENCHMARK(bmRequestAdmission)->ThreadRange(1, 64)->UseRealTime();
+
+// Admits a retry through the retry budget, which depends on the number of active requests.
+static void bmRetryBudgetAdmission(benchmark::State& state) {
+  ResourceLimit& retries = SharedResourceManager::get().retries();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (retries.canCreate()) {
+      retries.inc();
+      retries.dec();
+    }
+  }
+}
+BENCHMARK(bmRetryBudgetAdmission)->ThreadRange(1, 64)->UseRealTime();
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
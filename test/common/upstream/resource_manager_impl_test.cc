@@ -82,6 +82,27 @@ TEST(ResourceManagerImplTest, RuntimeResourceManager) {
   EXPECT_TRUE(resource_manager.retries().canCreate());
 }
 
+TEST(ResourceManagerImplTest, OpenResourceGauges) {
+  NiceMock<Runtime::MockLoader> runtime;
+  Stats::IsolatedStoreImpl store;
+
+  auto stats = clusterCircuitBreakersStats(store);
+  ResourceManagerImpl resource_manager(runtime,
+                                       "circuit_breakers.runtime_resource_manager_test.default.", 2,
+                                       2, 2, 0, 2, 100, stats, absl::nullopt, absl::nullopt);
+
+  EXPECT_FALSE(stats.cx_open_.used());
+  resource_manager.connections().inc();
+  EXPECT_TRUE(stats.cx_open_.used());
+  EXPECT_EQ(0U, stats.cx_open_.value());
+  resource_manager.connections().inc();
+  EXPECT_EQ(1U, stats.cx_open_.value());
+  resource_manager.connections().dec();
+  EXPECT_EQ(0U, stats.cx_open_.value());
+  resource_manager.connections().dec();
+  EXPECT_EQ(0U, stats.cx_open_.value());
+}
+
 TEST(ResourceManagerImplTest, RemainingResourceGauges) {
   NiceMock<Runtime::MockLoader> runtime;
   Stats::IsolatedStoreImpl store;
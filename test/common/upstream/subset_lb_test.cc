@@ -1560,6 +1560,34 @@ TEST_P(SubsetLoadBalancerTest, LoadBalancerTypesMaglev) {
   tester.validateLbTypeConfigs(LoadBalancerType::Maglev);
 }
 
+// Verifies that thread aware child LBs are only built for subsets that are selected.
+TEST_F(SubsetLoadBalancerTest, RingHashBuiltOnFirstUse) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  lb_type_ = LoadBalancerType::RingHash;
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+  });
+  EXPECT_EQ(nullptr, TestUtility::findGauge(stats_store_, "testprefix.ring_hash_lb.size"));
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_LT(0U, TestUtility::findGauge(stats_store_, "testprefix.ring_hash_lb.size")->value());
+
+  // The ring is built again for the updated hosts once the subset is selected.
+  HostSharedPtr added_host = makeHost("tcp://127.0.0.1:8000", {{"version", "1.0"}});
+  modifyHosts({added_host}, {host_set_.hosts_[0]});
+  EXPECT_EQ(added_host, lb_->chooseHost(&context_10));
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+}
+
 TEST_F(SubsetLoadBalancerTest, ZoneAwareFallback) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
       .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::ANY_ENDPOINT));
@@ -0,0 +1,192 @@
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.h"
+
+#include "source/extensions/access_loggers/filters/adaptive_sampling/adaptive_sampling.h"
+#include "source/extensions/access_loggers/filters/adaptive_sampling/config.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+namespace {
+
+class AdaptiveSamplingFilterTest : public testing::Test {
+public:
+  AdaptiveSamplingFilterTest() { stream_info_.response_code_ = 200; }
+
+  void initialize(const std::string& yaml) {
+    envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling config;
+    TestUtility::loadFromYamlAndValidate(yaml, config);
+    filter_ = std::make_unique<AdaptiveSamplingFilter>(config, runtime_, random_);
+  }
+
+  // Requests are timed by the end of the request.
+  void setTime(std::chrono::milliseconds time) {
+    stream_info_.start_time_monotonic_ = MonotonicTime(time);
+    stream_info_.end_time_ = std::chrono::nanoseconds(0);
+  }
+
+  bool evaluate() {
+    return filter_->evaluate(stream_info_, request_headers_, response_headers_,
+                             response_trailers_);
+  }
+
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  Http::TestResponseHeaderMapImpl response_headers_;
+  Http::TestResponseTrailerMapImpl response_trailers_;
+  std::unique_ptr<AdaptiveSamplingFilter> filter_;
+};
+
+const std::string BasicConfig = R"EOF(
+target_logs_per_second:
+  default_value: 10
+  runtime_key: access_log.target
+)EOF";
+
+TEST_F(AdaptiveSamplingFilterTest, LogsEverythingBelowTarget) {
+  initialize(BasicConfig);
+  setTime(std::chrono::milliseconds(1000));
+  EXPECT_CALL(random_, random()).Times(0);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(evaluate());
+  }
+}
+
+TEST_F(AdaptiveSamplingFilterTest, SamplesAboveTarget) {
+  initialize(BasicConfig);
+  setTime(std::chrono::milliseconds(1000));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(evaluate());
+  }
+
+  // The 11th request is kept with a probability of 10/11.
+  const uint64_t keep = 10.0 / 11 * AdaptiveSamplingFilter::RatioDenominator;
+  EXPECT_CALL(random_, random()).WillOnce(Return(keep - 1));
+  EXPECT_TRUE(evaluate());
+  EXPECT_CALL(random_, random()).WillOnce(Return(AdaptiveSamplingFilter::RatioDenominator - 1));
+  EXPECT_FALSE(evaluate());
+}
+
+TEST_F(AdaptiveSamplingFilterTest, PreviousWindowDrivesRatio) {
+  initialize(BasicConfig);
+  setTime(std::chrono::milliseconds(1000));
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(evaluate());
+  }
+
+  // 20 requests were seen in the previous window, so half of the requests are kept.
+  setTime(std::chrono::milliseconds(2000));
+  EXPECT_CALL(random_, random()).WillOnce(Return(499999));
+  EXPECT_TRUE(evaluate());
+  EXPECT_CALL(random_, random()).WillOnce(Return(500000));
+  EXPECT_FALSE(evaluate());
+
+  // The rate of a window that is not adjacent to the current one is not used.
+  setTime(std::chrono::milliseconds(4000));
+  EXPECT_CALL(random_, random()).Times(0);
+  EXPECT_TRUE(evaluate());
+}
+
+TEST_F(AdaptiveSamplingFilterTest, CustomWindow) {
+  initialize(R"EOF(
+target_logs_per_second:
+  default_value: 10
+  runtime_key: access_log.target
+window: 0.1s
+)EOF");
+  setTime(std::chrono::milliseconds(1000));
+  EXPECT_TRUE(evaluate());
+  EXPECT_CALL(random_, random()).WillOnce(Return(AdaptiveSamplingFilter::RatioDenominator - 1));
+  EXPECT_FALSE(evaluate());
+
+  // The next window starts after 100ms.
+  setTime(std::chrono::milliseconds(1100));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_TRUE(evaluate());
+}
+
+TEST_F(AdaptiveSamplingFilterTest, RuntimeTarget) {
+  initialize(BasicConfig);
+  setTime(std::chrono::milliseconds(1000));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("access_log.target", 10)).WillRepeatedly(Return(0));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_FALSE(evaluate());
+}
+
+TEST_F(AdaptiveSamplingFilterTest, AlwaysLogged) {
+  initialize(R"EOF(
+target_logs_per_second:
+  default_value: 0
+  runtime_key: access_log.target
+always_log_errors: true
+always_log_duration: 0.5s
+always_log_response_codes: [429]
+)EOF");
+  setTime(std::chrono::milliseconds(1000));
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0));
+  EXPECT_FALSE(evaluate());
+
+  stream_info_.response_code_ = 503;
+  EXPECT_TRUE(evaluate());
+  stream_info_.response_code_ = absl::nullopt;
+  EXPECT_TRUE(evaluate());
+  stream_info_.response_code_ = 429;
+  EXPECT_TRUE(evaluate());
+
+  stream_info_.response_code_ = 200;
+  stream_info_.response_flags_ = StreamInfo::ResponseFlag::DownstreamConnectionTermination;
+  EXPECT_TRUE(evaluate());
+  stream_info_.response_flags_ = 0;
+  EXPECT_FALSE(evaluate());
+
+  stream_info_.end_time_ = std::chrono::milliseconds(500);
+  EXPECT_TRUE(evaluate());
+}
+
+TEST(AdaptiveSamplingFilterFactoryTest, CreateFilter) {
+  auto* factory = Registry::FactoryRegistry<Envoy::AccessLog::ExtensionFilterFactory>::getFactory(
+      "envoy.access_loggers.extension_filters.adaptive_sampling");
+  ASSERT_NE(nullptr, factory);
+
+  NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Random::MockRandomGenerator> random;
+  envoy::config::accesslog::v3::ExtensionFilter config;
+  TestUtility::loadFromYaml(R"EOF(
+name: envoy.access_loggers.extension_filters.adaptive_sampling
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.access_loggers.filters.adaptive_sampling.v3.AdaptiveSampling
+  target_logs_per_second:
+    default_value: 100
+    runtime_key: access_log.target
+)EOF",
+                            config);
+  EXPECT_NE(nullptr, factory->createFilter(config, runtime, random));
+
+  // The target is required.
+  config.mutable_typed_config()->PackFrom(
+      envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSampling());
+  EXPECT_THROW(factory->createFilter(config, runtime, random), EnvoyException);
+}
+
+} // namespace
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -67,12 +67,12 @@ private:
 
 class GrpcAccessLoggerImplTest : public testing::Test {
 public:
-  GrpcAccessLoggerImplTest()
+  explicit GrpcAccessLoggerImplTest(uint64_t buffer_size_bytes = BUFFER_SIZE_BYTES)
       : async_client_(new Grpc::MockAsyncClient), timer_(new Event::MockTimer(&dispatcher_)),
         grpc_access_logger_impl_test_helper_(local_info_, async_client_) {
     EXPECT_CALL(*timer_, enableTimer(_, _));
     *config_.mutable_log_name() = "test_log_name";
-    config_.mutable_buffer_size_bytes()->set_value(BUFFER_SIZE_BYTES);
+    config_.mutable_buffer_size_bytes()->set_value(buffer_size_bytes);
     config_.mutable_buffer_flush_interval()->set_nanos(
         std::chrono::duration_cast<std::chrono::nanoseconds>(FlushInterval).count());
     logger_ =
@@ -128,6 +128,67 @@ tcp_logs:
   logger_->log(envoy::data::accesslog::v3::TCPAccessLogEntry(tcp_entry));
 }
 
+class GrpcAccessLoggerImplBatchTest : public GrpcAccessLoggerImplTest {
+public:
+  GrpcAccessLoggerImplBatchTest() : GrpcAccessLoggerImplTest(1024) {}
+};
+
+// Entries that are buffered until the flush timer fires are sent in order in a single message.
+TEST_F(GrpcAccessLoggerImplBatchTest, LogHttpBatch) {
+  envoy::data::accesslog::v3::HTTPAccessLogEntry entry;
+  entry.mutable_request()->set_path("/test/path1");
+  logger_->log(envoy::data::accesslog::v3::HTTPAccessLogEntry(entry));
+  entry.mutable_request()->set_path("/test/path2");
+  entry.mutable_response()->mutable_response_code()->set_value(200);
+  logger_->log(envoy::data::accesslog::v3::HTTPAccessLogEntry(entry));
+
+  grpc_access_logger_impl_test_helper_.expectStreamMessage(R"EOF(
+identifier:
+  node:
+    id: node_name
+    cluster: cluster_name
+    locality:
+      zone: zone_name
+  log_name: test_log_name
+http_logs:
+  log_entry:
+  - request:
+      path: /test/path1
+  - request:
+      path: /test/path2
+    response:
+      response_code: 200
+)EOF");
+  EXPECT_CALL(*timer_, enableTimer(_, _));
+  timer_->invokeCallback();
+}
+
+TEST_F(GrpcAccessLoggerImplBatchTest, LogTcpBatch) {
+  envoy::data::accesslog::v3::TCPAccessLogEntry tcp_entry;
+  tcp_entry.mutable_common_properties()->set_sample_rate(1);
+  logger_->log(envoy::data::accesslog::v3::TCPAccessLogEntry(tcp_entry));
+  tcp_entry.mutable_common_properties()->set_sample_rate(0.5);
+  logger_->log(envoy::data::accesslog::v3::TCPAccessLogEntry(tcp_entry));
+
+  grpc_access_logger_impl_test_helper_.expectStreamMessage(R"EOF(
+identifier:
+  node:
+    id: node_name
+    cluster: cluster_name
+    locality:
+      zone: zone_name
+  log_name: test_log_name
+tcp_logs:
+  log_entry:
+  - common_properties:
+      sample_rate: 1.0
+  - common_properties:
+      sample_rate: 0.5
+)EOF");
+  EXPECT_CALL(*timer_, enableTimer(_, _));
+  timer_->invokeCallback();
+}
+
 class GrpcAccessLoggerCacheImplTest : public testing::Test {
 public:
   GrpcAccessLoggerCacheImplTest()
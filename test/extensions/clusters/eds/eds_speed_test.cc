@@ -107,9 +107,10 @@ public:
   }
 
   // Set up an EDS config with multiple priorities, localities, weights and make sure
-  // they are loaded as expected.
+  // they are loaded as expected. Only the delivery of the update is timed unless timed is false,
+  // in which case nothing is.
   void priorityAndLocalityWeightedHelper(bool ignore_unknown_dynamic_fields, size_t num_hosts,
-                                         bool healthy) {
+                                         bool healthy, bool timed = true) {
     state_.PauseTiming();
 
     envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
@@ -146,7 +147,9 @@ public:
     response->set_version_info(fmt::format("version-{}", version_++));
     auto* resource = response->mutable_resources()->Add();
     resource->PackFrom(cluster_load_assignment);
-    state_.ResumeTiming();
+    if (timed) {
+      state_.ResumeTiming();
+    }
     if (use_unified_mux_) {
       dynamic_cast<Config::XdsMux::GrpcMuxSotw&>(*grpc_mux_)
           .grpcStreamForTest()
@@ -158,6 +161,9 @@ public:
     }
     ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
            num_hosts);
+    if (!timed) {
+      state_.ResumeTiming();
+    }
   }
 
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
@@ -238,3 +244,22 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Times only an update that repeats the endpoints of the previous one. Unchanged endpoints reuse
+// their existing hosts instead of building new ones.
+static void unchangedUpdate(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    Envoy::Upstream::EdsSpeedTest speed_test(state, state.range(1));
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+    state.ResumeTiming();
+
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true, false);
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+  }
+}
+
+BENCHMARK(unchangedUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
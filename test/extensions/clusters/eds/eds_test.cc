@@ -386,6 +386,53 @@ TEST_F(EdsTest, EndpointWeightChangeCausesRebuild) {
   EXPECT_EQ(new_hosts[0]->weight(), 31);
 }
 
+// Verify that unchanged endpoints reuse their existing hosts without building new ones, and that
+// changed endpoints are still updated in place.
+TEST_F(EdsTest, UnchangedEndpointsReuseHosts) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  auto* endpoint = endpoints->add_lb_endpoints();
+  endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_address("1.2.3.4");
+  endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_port_value(80);
+  auto* other_endpoint = endpoints->add_lb_endpoints();
+  other_endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_address(
+      "2.3.4.5");
+  other_endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_port_value(
+      80);
+  Config::Metadata::mutableMetadataValue(*other_endpoint->mutable_metadata(),
+                                         Config::MetadataFilters::get().ENVOY_LB, "version")
+      .set_string_value("v1");
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+  // Each new host resolves its transport socket.
+  EXPECT_EQ(
+      2UL,
+      stats_.findCounterByString("cluster.name.default.total_match_count").value().get().value());
+  const HostVector hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(hosts.size(), 2);
+
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL,
+            stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
+  EXPECT_EQ(
+      2UL,
+      stats_.findCounterByString("cluster.name.default.total_match_count").value().get().value());
+  EXPECT_EQ(hosts, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts());
+
+  other_endpoint->mutable_load_balancing_weight()->set_value(30);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL,
+            stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
+  EXPECT_EQ(
+      3UL,
+      stats_.findCounterByString("cluster.name.default.total_match_count").value().get().value());
+  EXPECT_EQ(hosts, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts());
+  EXPECT_EQ(30, hosts[1]->weight());
+}
+
 // Validate that onConfigUpdate() updates the endpoint metadata.
 TEST_F(EdsTest, EndpointMetadata) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
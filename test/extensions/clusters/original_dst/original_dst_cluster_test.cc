@@ -286,6 +286,39 @@ TEST_F(OriginalDstClusterTest, AddressCollision) {
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
 }
 
+TEST_F(OriginalDstClusterTest, PendingHostReused) {
+  std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 1.250s
+    type: ORIGINAL_DST
+    lb_policy: CLUSTER_PROVIDED
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  EXPECT_CALL(*cleanup_timer_, enableTimer(_, _));
+  setupFromYaml(yaml);
+
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.10.11.11"));
+
+  // The same worker sees a second request before the main thread added the first host, so it
+  // reuses the host it created and only posts once.
+  auto lb = OriginalDstCluster::LoadBalancer(cluster_);
+  Event::PostCb post_cb;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
+  HostConstSharedPtr host1 = lb.chooseHost(&lb_context);
+  ASSERT_NE(host1, nullptr);
+  HostConstSharedPtr host2 = lb.chooseHost(&lb_context);
+  EXPECT_EQ(host1, host2);
+
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_EQ(host1, OriginalDstCluster::LoadBalancer(cluster_).chooseHost(&lb_context));
+}
+
 TEST_F(OriginalDstClusterTest, HostInUse) {
   std::string yaml = R"EOF(
     name: name
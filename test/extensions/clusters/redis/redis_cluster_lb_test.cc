@@ -346,6 +346,46 @@ TEST_F(RedisClusterLoadBalancerTest, ClusterSlotUpdate) {
   validateAssignment(hosts, updated_assignments);
 }
 
+// Only the shards and slots which changed are updated.
+TEST_F(RedisClusterLoadBalancerTest, ClusterSlotPartialUpdate) {
+  Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.2:90", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.2:91", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.1:92", simTime())};
+  Upstream::HostMap all_hosts = generateHostMap(hosts);
+
+  std::vector<ClusterSlot> slots{ClusterSlot(0, 1000, hosts[0]->address()),
+                                 ClusterSlot(1001, 16383, hosts[1]->address())};
+  slots[0].addReplica(hosts[2]->address());
+  slots[1].addReplica(hosts[3]->address());
+  init();
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(slots), all_hosts));
+  validateAssignment(hosts, {{100, 2}, {1100, 3}}, true,
+                     NetworkFilters::Common::Redis::Client::ReadPolicy::Replica);
+
+  // Only the replica of the second shard changes, so the slots keep their assignment.
+  slots[1] = ClusterSlot(1001, 16383, hosts[1]->address());
+  slots[1].addReplica(hosts[4]->address());
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(slots), all_hosts));
+  validateAssignment(hosts, {{100, 0}, {1100, 1}, {2100, 1}});
+  validateAssignment(hosts, {{100, 2}, {1100, 4}, {2100, 4}}, true,
+                     NetworkFilters::Common::Redis::Client::ReadPolicy::Replica);
+
+  // Some of the slots of the second shard move to the first one.
+  slots.emplace_back(ClusterSlot(2001, 16383, hosts[0]->address()));
+  slots.back().addReplica(hosts[2]->address());
+  slots[1] = ClusterSlot(1001, 2000, hosts[1]->address());
+  slots[1].addReplica(hosts[4]->address());
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(slots), all_hosts));
+  validateAssignment(hosts, {{100, 0}, {1100, 1}, {2100, 0}});
+  validateAssignment(hosts, {{100, 2}, {1100, 4}, {2100, 2}}, true,
+                     NetworkFilters::Common::Redis::Client::ReadPolicy::Replica);
+}
+
 TEST_F(RedisClusterLoadBalancerTest, ClusterSlotNoUpdate) {
   Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
                              Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
@@ -0,0 +1,169 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager.h"
+#include "source/extensions/common/async_files/async_file_manager_factory.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/status_utility.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+using StatusHelpers::IsOkAndHolds;
+using StatusHelpers::StatusIs;
+using ::testing::HasSubstr;
+
+class AsyncFileManagerIoUringTest : public testing::Test {
+public:
+  void SetUp() override {
+    if (!Io::isIoUringSupported()) {
+      GTEST_SKIP() << "io_uring is not supported by this kernel";
+    }
+    singleton_manager_ = std::make_unique<Singleton::ManagerImpl>(Thread::threadFactoryForTest());
+    factory_ = AsyncFileManagerFactory::singleton(singleton_manager_.get());
+  }
+
+  void createManager(uint32_t registered_buffer_count, uint32_t registered_file_count) {
+    envoy::extensions::common::async_files::v3::AsyncFileManagerConfig config;
+    auto* io_uring = config.mutable_io_uring();
+    io_uring->mutable_thread_pool()->set_thread_count(1);
+    io_uring->set_ring_size(16);
+    io_uring->set_registered_buffer_count(registered_buffer_count);
+    io_uring->mutable_registered_buffer_size()->set_value(4096);
+    io_uring->set_registered_file_count(registered_file_count);
+    manager_ = factory_->getAsyncFileManager(config);
+  }
+
+  AsyncFileHandle createAnonymousFile() {
+    std::promise<AsyncFileHandle> create_result;
+    manager_->createAnonymousFile(tmpdir_, [&](absl::StatusOr<AsyncFileHandle> result) {
+      create_result.set_value(result.value());
+    });
+    return create_result.get_future().get();
+  }
+
+  absl::StatusOr<size_t> write(AsyncFileHandle& handle, absl::string_view contents, off_t offset) {
+    std::promise<absl::StatusOr<size_t>> write_result;
+    Buffer::OwnedImpl buffer(contents);
+    EXPECT_OK(handle->write(buffer, offset, [&](absl::StatusOr<size_t> result) {
+      write_result.set_value(std::move(result));
+    }));
+    EXPECT_EQ(0, buffer.length());
+    return write_result.get_future().get();
+  }
+
+  absl::StatusOr<Buffer::InstancePtr> read(AsyncFileHandle& handle, off_t offset,
+                                           size_t length) {
+    std::promise<absl::StatusOr<Buffer::InstancePtr>> read_result;
+    EXPECT_OK(handle->read(offset, length, [&](absl::StatusOr<Buffer::InstancePtr> result) {
+      read_result.set_value(std::move(result));
+    }));
+    return read_result.get_future().get();
+  }
+
+  void close(AsyncFileHandle& handle) {
+    std::promise<absl::Status> close_result;
+    EXPECT_OK(handle->close([&](absl::Status status) { close_result.set_value(status); }));
+    EXPECT_OK(close_result.get_future().get());
+  }
+
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  std::string tmpdir_ = test_tmpdir ? test_tmpdir : "/tmp";
+
+  std::unique_ptr<Singleton::ManagerImpl> singleton_manager_;
+  std::shared_ptr<AsyncFileManagerFactory> factory_;
+  std::shared_ptr<AsyncFileManager> manager_;
+};
+
+TEST_F(AsyncFileManagerIoUringTest, DescribeIncludesRingSize) {
+  createManager(0, 0);
+  EXPECT_THAT(manager_->describe(), HasSubstr("ring_size = 16"));
+}
+
+TEST_F(AsyncFileManagerIoUringTest, WriteReadClose) {
+  createManager(0, 0);
+  auto handle = createAnonymousFile();
+  EXPECT_THAT(write(handle, "hello", 0), IsOkAndHolds(5U));
+  EXPECT_THAT(write(handle, "p!", 3), IsOkAndHolds(2U));
+  auto read_result = read(handle, 0, 5);
+  ASSERT_OK(read_result);
+  EXPECT_EQ("help!", read_result.value()->toString());
+  // Reads past the end are short.
+  read_result = read(handle, 2, 10);
+  ASSERT_OK(read_result);
+  EXPECT_EQ("lp!", read_result.value()->toString());
+  close(handle);
+}
+
+TEST_F(AsyncFileManagerIoUringTest, ReadsUseRegisteredBuffersAndFiles) {
+  createManager(1, 1);
+  auto handle = createAnonymousFile();
+  EXPECT_THAT(write(handle, "hello world", 0), IsOkAndHolds(11U));
+  // The first read holds the only registered buffer, so the second one uses its own buffer.
+  auto first_read = read(handle, 0, 5);
+  ASSERT_OK(first_read);
+  auto second_read = read(handle, 6, 5);
+  ASSERT_OK(second_read);
+  EXPECT_EQ("hello", first_read.value()->toString());
+  EXPECT_EQ("world", second_read.value()->toString());
+  // Once released, the registered buffer is used again.
+  first_read.value().reset();
+  auto third_read = read(handle, 0, 11);
+  ASSERT_OK(third_read);
+  EXPECT_EQ("hello world", third_read.value()->toString());
+  // A read larger than a registered buffer doesn't use one.
+  EXPECT_THAT(write(handle, std::string(8192, 'a'), 0), IsOkAndHolds(8192U));
+  auto large_read = read(handle, 0, 8192);
+  ASSERT_OK(large_read);
+  EXPECT_EQ(std::string(8192, 'a'), large_read.value()->toString());
+  close(handle);
+}
+
+TEST_F(AsyncFileManagerIoUringTest, ErrorsAreReportedAsStatus) {
+  createManager(0, 0);
+  std::promise<AsyncFileHandle> open_result;
+  std::string filename = absl::StrCat(tmpdir_, "/async_file_manager_io_uring_test_read_only");
+  {
+    std::ofstream file(filename);
+    file << "contents";
+  }
+  manager_->openExistingFile(filename, AsyncFileManager::Mode::ReadOnly,
+                             [&](absl::StatusOr<AsyncFileHandle> result) {
+                               open_result.set_value(result.value());
+                             });
+  auto handle = open_result.get_future().get();
+  EXPECT_THAT(write(handle, "hello", 0), StatusIs(absl::StatusCode::kFailedPrecondition));
+  close(handle);
+  unlink(filename.c_str());
+}
+
+TEST_F(AsyncFileManagerIoUringTest, ReadAfterCloseFails) {
+  createManager(0, 0);
+  auto handle = createAnonymousFile();
+  close(handle);
+  EXPECT_THAT(handle->read(0, 5, [](absl::StatusOr<Buffer::InstancePtr>) {}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -247,6 +247,42 @@ TEST_F(SignerImplTest, SignHeadersByService) {
                     SignatureConstants::get().UnsignedPayload, true, "region1");
 }
 
+// The signing key reused across requests must give the same signatures as a freshly derived one,
+// and must be derived again when the day, the region or the credentials change.
+TEST_F(SignerImplTest, SigningKeyReuse) {
+  const Credentials other_credentials("akid", "other_secret");
+  const auto sign = [](SignerImpl& signer, absl::string_view override_region) {
+    Http::TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}};
+    signer.signEmptyPayload(headers, override_region);
+    return std::string(
+        headers.get(Http::CustomHeaders::get().Authorization)[0]->value().getStringView());
+  };
+  const auto fresh_sign = [this, &sign](const Credentials& credentials,
+                                        absl::string_view override_region) {
+    auto* credentials_provider = new NiceMock<MockCredentialsProvider>();
+    ON_CALL(*credentials_provider, getCredentials()).WillByDefault(Return(credentials));
+    SignerImpl signer("service", "region", CredentialsProviderSharedPtr{credentials_provider},
+                      time_system_, Extensions::Common::Aws::AwsSigV4HeaderExclusionVector{});
+    return sign(signer, override_region);
+  };
+
+  EXPECT_CALL(*credentials_provider_, getCredentials())
+      .WillOnce(Return(credentials_))
+      .WillOnce(Return(credentials_))
+      .WillOnce(Return(credentials_))
+      .WillOnce(Return(other_credentials))
+      .WillOnce(Return(other_credentials));
+  const std::string first = sign(signer_, "");
+  EXPECT_EQ(first, sign(signer_, ""));
+  EXPECT_EQ(fresh_sign(credentials_, "region1"), sign(signer_, "region1"));
+  EXPECT_EQ(fresh_sign(other_credentials, ""), sign(signer_, ""));
+
+  time_system_.advanceTimeWait(std::chrono::hours(24));
+  const std::string next_day = sign(signer_, "");
+  EXPECT_NE(first, next_day);
+  EXPECT_EQ(fresh_sign(other_credentials, ""), next_day);
+}
+
 } // namespace
 } // namespace Aws
 } // namespace Common
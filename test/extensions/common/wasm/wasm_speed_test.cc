@@ -63,6 +63,68 @@ void bmWasmSpeedTest(benchmark::State& state) {
 
 BENCHMARK(bmWasmSpeedTest);
 
+class HeaderContext : public Envoy::Extensions::Common::Wasm::Context {
+public:
+  void setRequestHeaders(Envoy::Http::RequestHeaderMap* headers) { request_headers_ = headers; }
+};
+
+// The headers of a typical browser request.
+Envoy::Http::TestRequestHeaderMapImpl requestHeaders() {
+  return {{":method", "GET"},
+          {":path", "/index.html"},
+          {":scheme", "https"},
+          {":authority", "www.example.com"},
+          {"user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:109.0) Gecko/20100101 Firefox/110.0"},
+          {"accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+          {"accept-language", "en-US,en;q=0.5"},
+          {"accept-encoding", "gzip, deflate, br"},
+          {"cookie", "session=0123456789abcdef0123456789abcdef"},
+          {"x-request-id", "4c1a2b3d-5e6f-7a8b-9c0d-1e2f3a4b5c6d"}};
+}
+
+void bmWasmGetHeaderMapPairs(benchmark::State& state) {
+  HeaderContext context;
+  auto headers = requestHeaders();
+  context.setRequestHeaders(&headers);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    proxy_wasm::Pairs pairs;
+    context.getHeaderMapPairs(proxy_wasm::WasmHeaderMapType::RequestHeaders, &pairs);
+    benchmark::DoNotOptimize(pairs);
+  }
+}
+
+BENCHMARK(bmWasmGetHeaderMapPairs);
+
+void bmWasmSetHeaderMapPairs(benchmark::State& state) {
+  HeaderContext context;
+  const auto source = requestHeaders();
+  std::vector<std::pair<std::string, std::string>> values;
+  source.iterate([&values](const Envoy::Http::HeaderEntry& header) {
+    values.emplace_back(header.key().getStringView(), header.value().getStringView());
+    return Envoy::Http::HeaderMap::Iterate::Continue;
+  });
+  proxy_wasm::Pairs pairs(values.begin(), values.end());
+  auto headers = requestHeaders();
+  context.setRequestHeaders(&headers);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    context.setHeaderMapPairs(proxy_wasm::WasmHeaderMapType::RequestHeaders, pairs);
+  }
+}
+
+BENCHMARK(bmWasmSetHeaderMapPairs);
+
+void bmWasmReplaceHeaderMapValue(benchmark::State& state) {
+  HeaderContext context;
+  auto headers = requestHeaders();
+  context.setRequestHeaders(&headers);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    context.replaceHeaderMapValue(proxy_wasm::WasmHeaderMapType::RequestHeaders, "x-request-id",
+                                  "5d2b3c4e-6f7a-8b9c-0d1e-2f3a4b5c6d7e");
+  }
+}
+
+BENCHMARK(bmWasmReplaceHeaderMapValue);
+
 } // namespace Envoy
 
 int main(int argc, char** argv) {
@@ -206,6 +206,50 @@ TEST_F(BrotliDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   EXPECT_EQ(0, stats_store.counterFromString("test.brotli_error").value());
 }
 
+// Exercises compression and decompression of a small message with a shared raw dictionary.
+TEST_F(BrotliDecompressorImplTest, CompressAndDecompressWithDictionary) {
+  const std::string dictionary{
+      R"({"id": 0, "name": "", "email": "", "created_at": "", "updated_at": "", "tags": []})"};
+  const std::string original_text{
+      R"({"id": 42, "name": "envoy", "email": "envoy@example.com", "created_at": "2023-01-01", )"
+      R"("updated_at": "2023-01-02", "tags": ["proxy"]})"};
+  auto prepared_dictionary =
+      std::make_shared<const Brotli::Compressor::PreparedDictionary>(dictionary);
+
+  auto compress = [&](Brotli::Compressor::PreparedDictionarySharedPtr dictionary) {
+    Brotli::Compressor::BrotliCompressorImpl compressor{
+        default_quality,
+        default_window_bits,
+        default_input_block_bits,
+        false,
+        Brotli::Compressor::BrotliCompressorImpl::EncoderMode::Default,
+        4096,
+        std::move(dictionary)};
+    Buffer::OwnedImpl buffer{original_text};
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    return buffer.toString();
+  };
+  const std::string compressed = compress(prepared_dictionary);
+  EXPECT_LT(compressed.size(), compress(nullptr).size());
+
+  Stats::IsolatedStoreImpl stats_store{};
+  BrotliDecompressorImpl decompressor{*stats_store.rootScope(), "test.", 4096, false,
+                                      std::make_shared<const std::string>(dictionary)};
+  Buffer::OwnedImpl input{compressed};
+  Buffer::OwnedImpl output;
+  decompressor.decompress(input, output);
+  EXPECT_EQ(original_text, output.toString());
+  EXPECT_EQ(0, stats_store.counterFromString("test.brotli_error").value());
+
+  // The output refers to the dictionary, so it can't be decompressed without it.
+  BrotliDecompressorImpl decompressor_without_dictionary{*stats_store.rootScope(), "other.", 4096,
+                                                         false};
+  Buffer::OwnedImpl other_input{compressed};
+  Buffer::OwnedImpl other_output;
+  decompressor_without_dictionary.decompress(other_input, other_output);
+  EXPECT_EQ(1, stats_store.counterFromString("other.brotli_error").value());
+}
+
 class UncommonParamsTest : public BrotliDecompressorImplTest,
                            public testing::WithParamInterface<std::tuple<bool, bool>> {
 protected:
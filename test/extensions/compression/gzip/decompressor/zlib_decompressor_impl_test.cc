@@ -258,6 +258,30 @@ TEST_F(ZlibDecompressorImplTest, DecompressWithSmallOutputBuffer) {
   ASSERT_EQ(0, decompressor.decompression_error_);
 }
 
+// Decompressed data is appended after the data already in the output buffer, including when it
+// is inflated into the free space at the end of its last slice.
+TEST_F(ZlibDecompressorImplTest, DecompressAppendsToOutputBuffer) {
+  Buffer::OwnedImpl buffer;
+  Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+
+  TestUtility::feedBufferWithRandomCharacters(buffer, 3 * default_input_size);
+  const std::string original_text = buffer.toString();
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+
+  Buffer::OwnedImpl output_buffer("prefix");
+  ZlibDecompressorImpl decompressor{stats_scope_, "test.", 64, 100};
+  decompressor.init(gzip_window_bits);
+  decompressor.decompress(buffer, output_buffer);
+
+  EXPECT_EQ("prefix" + original_text, output_buffer.toString());
+  EXPECT_EQ(compressor.checksum(), decompressor.checksum());
+  EXPECT_EQ(0, decompressor.decompression_error_);
+}
+
 // Exercises decompression with other supported zlib initialization params.
 TEST_F(ZlibDecompressorImplTest, CompressDecompressWithUncommonParams) {
   // Test with different memory levels.
@@ -0,0 +1,57 @@
+#include "envoy/extensions/config/xds_delegates/kv_store/v3/kv_store.pb.h"
+#include "envoy/extensions/key_value/file_based/v3/config.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/extensions/config/xds_delegates/kv_store/config.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+namespace {
+
+using envoy::extensions::config::xds_delegates::kv_store::v3::KeyValueStoreXdsDelegateConfig;
+
+TEST(KeyValueStoreXdsDelegateFactoryTest, CreateDelegate) {
+  auto factory = Registry::FactoryRegistry<Envoy::Config::XdsResourcesDelegateFactory>::getFactory(
+      "envoy.xds_delegates.kv_store");
+  ASSERT_NE(factory, nullptr);
+
+  envoy::extensions::key_value::file_based::v3::FileBasedKeyValueStoreConfig store_config;
+  store_config.set_filename(TestEnvironment::temporaryPath("xds_kv_store"));
+  KeyValueStoreXdsDelegateConfig config;
+  config.mutable_key_value_store_config()->mutable_config()->set_name(
+      "envoy.key_value.file_based");
+  config.mutable_key_value_store_config()->mutable_config()->mutable_typed_config()->PackFrom(
+      store_config);
+  ProtobufWkt::Any typed_config;
+  typed_config.PackFrom(config);
+
+  Api::ApiPtr api = Api::createApiForTest();
+  testing::NiceMock<Event::MockDispatcher> dispatcher;
+  auto delegate = factory->createXdsResourcesDelegate(
+      typed_config, ProtobufMessage::getStrictValidationVisitor(), *api, dispatcher);
+  EXPECT_NE(delegate, nullptr);
+}
+
+TEST(KeyValueStoreXdsDelegateFactoryTest, CreateEmptyConfigProto) {
+  auto factory = Registry::FactoryRegistry<Envoy::Config::XdsResourcesDelegateFactory>::getFactory(
+      "envoy.xds_delegates.kv_store");
+  ASSERT_NE(factory, nullptr);
+
+  auto empty_proto = factory->createEmptyConfigProto();
+  EXPECT_NE(nullptr, dynamic_cast<KeyValueStoreXdsDelegateConfig*>(empty_proto.get()));
+}
+
+} // namespace
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/xds_source_id.h"
+#include "source/extensions/config/xds_delegates/kv_store/kv_store_xds_delegate.h"
+#include "source/extensions/key_value/file_based/config.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/file_system_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Config {
+namespace XdsDelegates {
+namespace {
+
+using Envoy::Config::DecodedResourceImpl;
+using Envoy::Config::DecodedResourceRef;
+using Envoy::Config::XdsConfigSourceId;
+
+constexpr absl::string_view ClusterTypeUrl = "type.googleapis.com/envoy.config.cluster.v3.Cluster";
+
+class KeyValueStoreXdsDelegateTest : public testing::Test {
+protected:
+  KeyValueStoreXdsDelegateTest() : filename_(TestEnvironment::temporaryPath("xds_kv_store")) {
+    TestEnvironment::removePath(filename_);
+    auto store = std::make_unique<KeyValue::FileBasedKeyValueStore>(
+        dispatcher_, std::chrono::seconds(0), Filesystem::fileSystemForTest(), filename_, 0);
+    store_ = store.get();
+    delegate_ = std::make_unique<KeyValueStoreXdsDelegate>(std::move(store));
+  }
+
+  // Sends a state of the world update of clusters of the given names to the delegate.
+  void update(const XdsConfigSourceId& source_id, const std::vector<std::string>& names,
+              const std::string& version) {
+    std::vector<std::unique_ptr<DecodedResourceImpl>> owned_resources;
+    std::vector<DecodedResourceRef> resources;
+    for (const std::string& name : names) {
+      auto cluster = std::make_unique<envoy::config::cluster::v3::Cluster>();
+      cluster->set_name(name);
+      owned_resources.push_back(
+          std::make_unique<DecodedResourceImpl>(std::move(cluster), name,
+                                                std::vector<std::string>{}, version));
+      resources.emplace_back(*owned_resources.back());
+    }
+    delegate_->onConfigUpdated(source_id, resources);
+  }
+
+  static std::vector<std::string>
+  names(const std::vector<envoy::service::discovery::v3::Resource>& resources) {
+    std::vector<std::string> names;
+    for (const auto& resource : resources) {
+      names.push_back(resource.name());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  const std::string filename_;
+  KeyValueStore* store_;
+  std::unique_ptr<KeyValueStoreXdsDelegate> delegate_;
+  const XdsConfigSourceId source_id_{"xds.example.com", ClusterTypeUrl};
+};
+
+TEST_F(KeyValueStoreXdsDelegateTest, SavesAndGetsResources) {
+  update(source_id_, {"cluster_0", "cluster_1"}, "1");
+
+  const auto resources = delegate_->getResources(source_id_, {"cluster_1", "cluster_2"});
+  ASSERT_EQ(1, resources.size());
+  EXPECT_EQ("cluster_1", resources[0].name());
+  EXPECT_EQ("1", resources[0].version());
+  envoy::config::cluster::v3::Cluster cluster;
+  ASSERT_TRUE(resources[0].resource().UnpackTo(&cluster));
+  EXPECT_EQ("cluster_1", cluster.name());
+}
+
+TEST_F(KeyValueStoreXdsDelegateTest, WildcardGetsAllResourcesOfSource) {
+  const XdsConfigSourceId other_source_id{"other.example.com", ClusterTypeUrl};
+  update(source_id_, {"cluster_0", "cluster_1"}, "1");
+  update(other_source_id, {"cluster_2"}, "1");
+
+  EXPECT_EQ((std::vector<std::string>{"cluster_0", "cluster_1"}),
+            names(delegate_->getResources(source_id_, {})));
+  EXPECT_EQ((std::vector<std::string>{"cluster_0", "cluster_1"}),
+            names(delegate_->getResources(source_id_, {"*"})));
+  EXPECT_EQ((std::vector<std::string>{"cluster_2"}),
+            names(delegate_->getResources(other_source_id, {})));
+}
+
+TEST_F(KeyValueStoreXdsDelegateTest, RemovesResourcesMissingFromUpdate) {
+  update(source_id_, {"cluster_0", "cluster_1"}, "1");
+  update(source_id_, {"cluster_1"}, "2");
+
+  const auto resources = delegate_->getResources(source_id_, {});
+  ASSERT_EQ(1, resources.size());
+  EXPECT_EQ("cluster_1", resources[0].name());
+  EXPECT_EQ("2", resources[0].version());
+}
+
+TEST_F(KeyValueStoreXdsDelegateTest, LoadFailureRemovesResource) {
+  update(source_id_, {"cluster_0", "cluster_1"}, "1");
+
+  delegate_->onResourceLoadFailed(source_id_, "cluster_0", EnvoyException("invalid cluster"));
+  EXPECT_EQ((std::vector<std::string>{"cluster_1"}),
+            names(delegate_->getResources(source_id_, {})));
+}
+
+TEST_F(KeyValueStoreXdsDelegateTest, UnparsableResourceSkipped) {
+  update(source_id_, {"cluster_0"}, "1");
+  store_->addOrUpdate(absl::StrCat(source_id_.toKey(), "+cluster_1"), "not a resource",
+                      absl::nullopt);
+
+  EXPECT_EQ((std::vector<std::string>{"cluster_0"}),
+            names(delegate_->getResources(source_id_, {"cluster_0", "cluster_1"})));
+}
+
+} // namespace
+} // namespace XdsDelegates
+} // namespace Config
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,96 @@
+#include "source/extensions/filters/common/expr/evaluator.h"
+
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace Expr {
+namespace {
+
+// request.headers['x-tenant'] == tenant && request.url_path == '/api'
+google::api::expr::v1alpha1::Expr tenantCondition(uint32_t tenant) {
+  const std::string yaml = fmt::format(R"EOF(
+    call_expr:
+      function: _&&_
+      args:
+      - call_expr:
+          function: _==_
+          args:
+          - call_expr:
+              function: _[_]
+              args:
+              - select_expr:
+                  operand:
+                    ident_expr:
+                      name: request
+                  field: headers
+              - const_expr:
+                  string_value: x-tenant
+          - const_expr:
+              string_value: tenant-{}
+      - call_expr:
+          function: _==_
+          args:
+          - select_expr:
+              operand:
+                ident_expr:
+                  name: request
+              field: url_path
+          - const_expr:
+              string_value: /api
+  )EOF",
+                                       tenant);
+  return TestUtility::parseYaml<google::api::expr::v1alpha1::Expr>(yaml);
+}
+
+class EvaluatorBenchmark {
+public:
+  explicit EvaluatorBenchmark(uint32_t expressions)
+      : builder_(createBuilder(&constant_arena_)),
+        headers_{{":path", "/api?a=b"}, {"x-tenant", absl::StrCat("tenant-", expressions - 1)}} {
+    for (uint32_t i = 0; i < expressions; ++i) {
+      expressions_.push_back(createExpression(*builder_, tenantCondition(i)));
+    }
+  }
+
+  Protobuf::Arena constant_arena_;
+  BuilderPtr builder_;
+  std::vector<ExpressionPtr> expressions_;
+  testing::NiceMock<StreamInfo::MockStreamInfo> info_;
+  Http::TestRequestHeaderMapImpl headers_;
+};
+
+// Each expression is evaluated with its own activation and arena.
+static void BM_SeparateEvaluations(benchmark::State& state) {
+  EvaluatorBenchmark evaluator(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (const ExpressionPtr& expression : evaluator.expressions_) {
+      benchmark::DoNotOptimize(matches(*expression, evaluator.info_, evaluator.headers_));
+    }
+  }
+}
+BENCHMARK(BM_SeparateEvaluations)->Arg(1)->Arg(10)->Arg(100);
+
+// The expressions share an evaluation context, so the attributes are resolved once per request.
+static void BM_SharedEvaluationContext(benchmark::State& state) {
+  EvaluatorBenchmark evaluator(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    EvaluationContext context(evaluator.info_, &evaluator.headers_, nullptr, nullptr);
+    for (const ExpressionPtr& expression : evaluator.expressions_) {
+      benchmark::DoNotOptimize(context.matches(*expression));
+    }
+  }
+}
+BENCHMARK(BM_SharedEvaluationContext)->Arg(1)->Arg(10)->Arg(100);
+
+} // namespace
+} // namespace Expr
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
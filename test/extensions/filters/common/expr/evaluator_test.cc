@@ -1,5 +1,6 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/time/time.h"
@@ -40,6 +41,67 @@ TEST(Evaluator, Print) {
   EXPECT_EQ(print(CelValue::CreateError(&status)), "CelError value");
 }
 
+// request.headers[name] == value
+google::api::expr::v1alpha1::Expr headerEquals(const std::string& name, const std::string& value) {
+  const std::string yaml = fmt::format(R"EOF(
+    call_expr:
+      function: _==_
+      args:
+      - call_expr:
+          function: _[_]
+          args:
+          - select_expr:
+              operand:
+                ident_expr:
+                  name: request
+              field: headers
+          - const_expr:
+              string_value: {}
+      - const_expr:
+          string_value: {}
+  )EOF",
+                                       name, value);
+  return TestUtility::parseYaml<google::api::expr::v1alpha1::Expr>(yaml);
+}
+
+TEST(Evaluator, ActivationResolvesAttributesOncePerArena) {
+  testing::NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers{{"foo", "bar"}};
+  StreamActivation activation(info, &headers, nullptr, nullptr);
+
+  Protobuf::Arena arena;
+  const absl::optional<CelValue> request = activation.FindValue("request", &arena);
+  ASSERT_TRUE(request.has_value() && request->IsMap());
+  EXPECT_EQ(request->MapOrDie(), activation.FindValue("request", &arena)->MapOrDie());
+  EXPECT_NE(request->MapOrDie(), activation.FindValue("response", &arena)->MapOrDie());
+  EXPECT_FALSE(activation.FindValue("unknown", &arena).has_value());
+
+  // Attributes resolved with another arena are resolved again.
+  Protobuf::Arena other_arena;
+  EXPECT_NE(request->MapOrDie(), activation.FindValue("request", &other_arena)->MapOrDie());
+}
+
+TEST(Evaluator, EvaluationContext) {
+  Protobuf::Arena constant_arena;
+  BuilderPtr builder = createBuilder(&constant_arena);
+  ExpressionPtr foo_is_bar = createExpression(*builder, headerEquals("foo", "bar"));
+  ExpressionPtr foo_is_baz = createExpression(*builder, headerEquals("foo", "baz"));
+
+  testing::NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers{{"foo", "bar"}};
+  EvaluationContext context(info, &headers, nullptr, nullptr);
+  EXPECT_TRUE(context.matches(*foo_is_bar));
+  EXPECT_FALSE(context.matches(*foo_is_baz));
+  const absl::optional<CelValue> value = context.evaluate(*foo_is_bar);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ("true", print(*value));
+
+  // The attributes are views of the request, rather than copies of its values.
+  headers.setCopy(Http::LowerCaseString("foo"), "baz");
+  EXPECT_FALSE(context.matches(*foo_is_bar));
+  EXPECT_TRUE(context.matches(*foo_is_baz));
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
@@ -0,0 +1,57 @@
+#include <limits>
+
+#include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
+
+#include "test/mocks/event/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace LocalRateLimit {
+namespace {
+
+// Shared by the threads of a benchmark, which are synchronized at the start and the end of the
+// measured loop.
+std::unique_ptr<NiceMock<Event::MockDispatcher>> dispatcher;
+std::unique_ptr<LocalRateLimiterImpl> rate_limiter;
+
+// Threads allowing requests with a shared token bucket, taking the tokens in batches of the size
+// given by the argument. The bucket isn't refilled, so it has enough tokens to never run out.
+static void BM_RequestAllowed(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    const Protobuf::RepeatedPtrField<
+        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+        descriptors;
+    dispatcher = std::make_unique<NiceMock<Event::MockDispatcher>>();
+    rate_limiter = std::make_unique<LocalRateLimiterImpl>(
+        std::chrono::milliseconds(0), std::numeric_limits<uint32_t>::max(), 0, *dispatcher,
+        descriptors, state.range(0));
+  }
+  const std::vector<RateLimit::LocalDescriptor> route_descriptors;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(rate_limiter->requestAllowed(route_descriptors));
+  }
+  if (state.thread_index() == 0) {
+    rate_limiter.reset();
+    dispatcher.reset();
+  }
+}
+BENCHMARK(BM_RequestAllowed)
+    ->Arg(0)
+    ->Arg(16)
+    ->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+
+} // namespace
+} // namespace LocalRateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -24,12 +24,12 @@ public:
   }
 
   void initialize(const std::chrono::milliseconds fill_interval, const uint32_t max_tokens,
-                  const uint32_t tokens_per_fill) {
+                  const uint32_t tokens_per_fill, const uint32_t token_batch_size = 0) {
 
     initializeTimer();
 
     rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
-        fill_interval, max_tokens, tokens_per_fill, dispatcher_, descriptors_);
+        fill_interval, max_tokens, tokens_per_fill, dispatcher_, descriptors_, token_batch_size);
   }
 
   Thread::ThreadSynchronizer& synchronizer() { return rate_limiter_->synchronizer_; }
@@ -208,6 +208,72 @@ TEST_F(LocalRateLimiterImplTest, TokenBucketStatus) {
   EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 3);
 }
 
+// Verify the tokens taken in batches are consumed by the thread which took them.
+TEST_F(LocalRateLimiterImplTest, TokenBatches) {
+  initialize(std::chrono::milliseconds(200), 10, 5, 4);
+
+  // 10 -> 6 tokens in the bucket and 3 in the reservoir of this thread.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 9);
+
+  // The reservoir is used before the bucket, and the last batch only has the 2 tokens left.
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  }
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 0);
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // 0 -> 5 tokens
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 5);
+
+  // 5 -> 1 tokens in the bucket and 2 in the reservoir, which are returned to the bucket on fill:
+  // 1 + 2 -> 8 tokens.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 3);
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 8);
+
+  // The returned tokens don't exceed the max tokens: 7 -> 10 tokens.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 7);
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 10);
+}
+
+// Verify threads taking tokens in batches never allow more requests than the bucket has tokens.
+TEST_F(LocalRateLimiterImplTest, TokenBatchesConcurrentThreads) {
+  initialize(std::chrono::milliseconds(200), 1000, 1000, 16);
+
+  std::atomic<uint32_t> allowed{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 200; ++j) {
+        if (rate_limiter_->requestAllowed(route_descriptors_)) {
+          allowed++;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // The tokens left in the reservoirs of the other threads are still remaining.
+  EXPECT_LE(allowed.load(), 1000);
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 1000 - allowed.load());
+
+  // All the remaining tokens are returned to the bucket on fill.
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 1000);
+}
+
 class LocalRateLimiterDescriptorImplTest : public LocalRateLimiterImplTest {
 public:
   void initializeWithDescriptor(const std::chrono::milliseconds fill_interval,
@@ -178,6 +178,76 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// The Lua threads of coroutines which didn't yield or fail are reused.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object:testCall()
+    end
+
+    function yieldMe()
+      coroutine.yield()
+    end
+
+    function failMe()
+      error("failed")
+    end
+  )EOF"};
+
+  InSequence s;
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  const int yield_me = state_->getGlobalRef(state_->registerGlobal("yieldMe", initializers_));
+  const int fail_me = state_->getGlobalRef(state_->registerGlobal("failMe", initializers_));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  lua_State* finished_thread = cr->luaState();
+  {
+    LuaRef<TestObject> ref(TestObject::create(cr->luaState()), true);
+    EXPECT_CALL(*ref.get(), doTestCall(_));
+    cr->start(call_me, 1, yield_callback_);
+    EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+    EXPECT_CALL(*ref.get(), onDestroy());
+  }
+  lua_gc(cr->luaState(), LUA_GCCOLLECT, 0);
+  cr.reset();
+
+  // The finished coroutine's thread runs the next coroutine, from an empty stack.
+  cr = state_->createCoroutine();
+  EXPECT_EQ(finished_thread, cr->luaState());
+  EXPECT_EQ(0, lua_gettop(cr->luaState()));
+  EXPECT_CALL(on_yield_, ready());
+  cr->start(yield_me, 0, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Yielded);
+  cr.reset();
+
+  // The yielded coroutine's thread was discarded.
+  cr = state_->createCoroutine();
+  EXPECT_NE(finished_thread, cr->luaState());
+  lua_State* failed_thread = cr->luaState();
+  EXPECT_THROW_WITH_REGEX(cr->start(fail_me, 0, yield_callback_), LuaException, "failed");
+  cr.reset();
+
+  // So was the failed coroutine's thread.
+  cr = state_->createCoroutine();
+  EXPECT_NE(failed_thread, cr->luaState());
+}
+
+// Coroutines are not reused when the pool is disabled.
+TEST_F(LuaTest, CoroutineReuseDisabled) {
+  state_ = std::make_unique<ThreadLocalState>("function callMe() end", tls_, 0);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  cr->start(call_me, 0, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  lua_State* finished_thread = cr->luaState();
+  cr.reset();
+
+  cr = state_->createCoroutine();
+  EXPECT_NE(finished_thread, cr->luaState());
+}
+
 class ThreadSafeTest : public testing::Test {
 public:
   ThreadSafeTest()
@@ -13,8 +13,10 @@
 
 #include "test/mocks/grpc/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -23,6 +25,7 @@
 using testing::_;
 using testing::Eq;
 using testing::Invoke;
+using testing::NiceMock;
 using testing::Ref;
 using testing::Return;
 
@@ -168,6 +171,91 @@ TEST_F(RateLimitGrpcClientTest, Cancel) {
   client_.cancel();
 }
 
+class RateLimitGrpcClientQuotaTest : public testing::Test {
+public:
+  RateLimitGrpcClientQuotaTest()
+      : quota_cache_(std::make_shared<QuotaCache>(10, tls_, time_system_)),
+        async_client_(new Grpc::MockAsyncClient()),
+        client_(Grpc::RawAsyncClientPtr{async_client_}, absl::optional<std::chrono::milliseconds>(),
+                quota_cache_) {}
+
+  // Queries the service, which grants a quota to the descriptor set.
+  void expectCall(const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                  absl::optional<uint32_t> quota_requests) {
+    EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _)).WillOnce(Return(&async_request_));
+    client_.limit(request_callbacks_, "foo", descriptors, Tracing::NullSpan::instance(),
+                  stream_info_);
+
+    auto response = std::make_unique<envoy::service::ratelimit::v3::RateLimitResponse>();
+    response->set_overall_code(envoy::service::ratelimit::v3::RateLimitResponse::OK);
+    if (quota_requests.has_value()) {
+      response->mutable_quota()->set_requests(quota_requests.value());
+      *response->mutable_quota()->mutable_valid_until() =
+          Protobuf::util::TimeUtil::MillisecondsToTimestamp(
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  (time_system_.systemTime() + std::chrono::seconds(10)).time_since_epoch())
+                  .count());
+    }
+    EXPECT_CALL(request_callbacks_, complete_(LimitStatus::OK, _, _, _, _, _));
+    client_.onSuccess(std::move(response), span_);
+  }
+
+  // Consumes the cached quota of the descriptor set, without querying the service.
+  void expectCached(const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                    LimitStatus status) {
+    EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(request_callbacks_, complete_(status, _, _, _, _, _));
+    client_.limit(request_callbacks_, "foo", descriptors, Tracing::NullSpan::instance(),
+                  stream_info_);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  QuotaCacheSharedPtr quota_cache_;
+  Grpc::MockAsyncClient* async_client_;
+  Grpc::MockAsyncRequest async_request_;
+  GrpcClientImpl client_;
+  MockRequestCallbacks request_callbacks_;
+  NiceMock<Tracing::MockSpan> span_;
+  StreamInfo::MockStreamInfo stream_info_;
+};
+
+TEST_F(RateLimitGrpcClientQuotaTest, ConsumeQuota) {
+  const std::vector<Envoy::RateLimit::Descriptor> descriptors{{{{"foo", "bar"}}}};
+
+  // The request the quota is granted for consumes a unit of it.
+  expectCall(descriptors, 3);
+  expectCached(descriptors, LimitStatus::OK);
+  expectCached(descriptors, LimitStatus::OK);
+  expectCached(descriptors, LimitStatus::OverLimit);
+
+  // Other descriptor sets have quotas of their own.
+  expectCall({{{{"foo", "bar"}}}, {{{"bar", "baz"}}}}, absl::nullopt);
+  expectCall({{{{"foo", "bar"}}, {{42, envoy::type::v3::RateLimitUnit::MINUTE}}}}, absl::nullopt);
+
+  // The service is queried again once the quota expired.
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  expectCall(descriptors, 2);
+  expectCached(descriptors, LimitStatus::OK);
+  expectCached(descriptors, LimitStatus::OverLimit);
+}
+
+TEST_F(RateLimitGrpcClientQuotaTest, QuotaWithoutExpiration) {
+  const std::vector<Envoy::RateLimit::Descriptor> descriptors{{{{"foo", "bar"}}}};
+
+  // Quotas without expiration aren't cached, so the service is queried for each request.
+  EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _)).WillOnce(Return(&async_request_));
+  client_.limit(request_callbacks_, "foo", descriptors, Tracing::NullSpan::instance(),
+                stream_info_);
+  auto response = std::make_unique<envoy::service::ratelimit::v3::RateLimitResponse>();
+  response->set_overall_code(envoy::service::ratelimit::v3::RateLimitResponse::OK);
+  response->mutable_quota()->set_requests(10);
+  EXPECT_CALL(request_callbacks_, complete_(LimitStatus::OK, _, _, _, _, _));
+  client_.onSuccess(std::move(response), span_);
+
+  expectCall(descriptors, absl::nullopt);
+}
+
 } // namespace
 } // namespace RateLimit
 } // namespace Common
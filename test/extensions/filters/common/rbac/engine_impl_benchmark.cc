@@ -0,0 +1,78 @@
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+// A policy per tenant, allowing requests with the tenant header on the port of the tenant.
+envoy::config::rbac::v3::RBAC tenantPolicies(uint32_t tenants, bool exact_tenant) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (uint32_t i = 0; i < tenants; ++i) {
+    envoy::config::rbac::v3::Policy& policy =
+        (*rbac.mutable_policies())[absl::StrCat("tenant-", i)];
+    auto* rules = policy.add_permissions()->mutable_and_rules();
+    auto* header = rules->add_rules()->mutable_header();
+    header->set_name("x-tenant");
+    if (exact_tenant) {
+      header->mutable_string_match()->set_exact(absl::StrCat("tenant-", i));
+    } else {
+      // Prefix matches can't be indexed, so each policy is evaluated.
+      header->mutable_string_match()->set_prefix(absl::StrCat("tenant-", i, "/"));
+    }
+    rules->add_rules()->set_destination_port(10000 + i % 1000);
+    policy.add_principals()->set_any(true);
+  }
+  return rbac;
+}
+
+void benchmarkPolicies(benchmark::State& state, bool exact_tenant) {
+  const uint32_t tenants = state.range(0);
+  const RoleBasedAccessControlEngineImpl engine(tenantPolicies(tenants, exact_tenant),
+                                                ProtobufMessage::getNullValidationVisitor());
+
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  // The policy of the last tenant is evaluated last, as the numbers of tenants are powers of ten.
+  const uint32_t tenant = tenants - 1;
+  info.downstream_connection_info_provider_->setLocalAddress(
+      Network::Utility::parseInternetAddress("1.2.3.4", 10000 + tenant % 1000, false));
+  Http::TestRequestHeaderMapImpl headers{
+      {"x-tenant", exact_tenant ? absl::StrCat("tenant-", tenant)
+                                : absl::StrCat("tenant-", tenant, "/a")}};
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    std::string policy_id;
+    benchmark::DoNotOptimize(engine.handleAction(connection, headers, info, &policy_id));
+  }
+}
+
+// Policies the engine narrows down with its index.
+static void BM_IndexedPolicies(benchmark::State& state) { benchmarkPolicies(state, true); }
+BENCHMARK(BM_IndexedPolicies)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Policies which are all evaluated for each request.
+static void BM_UnindexedPolicies(benchmark::State& state) { benchmarkPolicies(state, false); }
+BENCHMARK(BM_UnindexedPolicies)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
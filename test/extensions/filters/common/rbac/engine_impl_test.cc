@@ -247,6 +247,37 @@ TEST(RoleBasedAccessControlEngineImpl, DeniedDenylist) {
   checkEngine(engine, true, LogResult::Undecided, info, conn, headers);
 }
 
+TEST(RoleBasedAccessControlEngineImpl, IndexedPoliciesMatchInNameOrder) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (uint32_t i = 0; i < 10; ++i) {
+    envoy::config::rbac::v3::Policy& policy = (*rbac.mutable_policies())[absl::StrCat("p", i)];
+    policy.add_permissions()->set_destination_port(1000 + i);
+    policy.add_principals()->set_any(true);
+  }
+  // Matches any request, and is evaluated between p3 and p4.
+  envoy::config::rbac::v3::Policy& any_policy = (*rbac.mutable_policies())["p3-any"];
+  any_policy.add_permissions()->set_any(true);
+  any_policy.add_principals()->set_any(true);
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac,
+                                                ProtobufMessage::getStrictValidationVisitor());
+
+  Envoy::Network::MockConnection conn;
+  Envoy::Http::TestRequestHeaderMapImpl headers;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  const auto effective_policy_id = [&](uint32_t port) {
+    info.downstream_connection_info_provider_->setLocalAddress(
+        Envoy::Network::Utility::parseInternetAddress("1.2.3.4", port, false));
+    std::string policy_id;
+    EXPECT_TRUE(engine.handleAction(conn, headers, info, &policy_id));
+    return policy_id;
+  };
+  EXPECT_EQ("p0", effective_policy_id(1000));
+  EXPECT_EQ("p3", effective_policy_id(1003));
+  EXPECT_EQ("p3-any", effective_policy_id(1004));
+  EXPECT_EQ("p3-any", effective_policy_id(2000));
+}
+
 TEST(RoleBasedAccessControlEngineImpl, BasicCondition) {
   envoy::config::rbac::v3::Policy policy;
   policy.add_permissions()->set_any(true);
@@ -0,0 +1,221 @@
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Const;
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+class PolicyIndexTest : public testing::Test {
+protected:
+  PolicyIndexTest() {
+    setLocalAddress("1.2.3.4", 443);
+    setRemoteAddress("192.168.0.1");
+  }
+
+  void initialize(const std::vector<std::string>& yamls) {
+    for (const std::string& yaml : yamls) {
+      TestUtility::loadFromYaml(yaml, policies_.emplace_back());
+    }
+    std::vector<const envoy::config::rbac::v3::Policy*> policies;
+    for (const auto& policy : policies_) {
+      policies.push_back(&policy);
+    }
+    index_ = std::make_unique<PolicyIndex>(policies);
+  }
+
+  std::vector<uint32_t> candidates() {
+    std::vector<uint32_t> candidates;
+    index_->candidates(connection_, headers_, info_, candidates);
+    return candidates;
+  }
+
+  void setLocalAddress(const std::string& address, uint32_t port) {
+    info_.downstream_connection_info_provider_->setLocalAddress(
+        Network::Utility::parseInternetAddress(address, port, false));
+  }
+
+  void setRemoteAddress(const std::string& address) {
+    info_.downstream_connection_info_provider_->setRemoteAddress(
+        Network::Utility::parseInternetAddress(address, 1234, false));
+  }
+
+  void setPeerCertificate(const std::vector<std::string>& uri_sans, const std::string& subject) {
+    auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+    uri_sans_ = uri_sans;
+    subject_ = subject;
+    ON_CALL(*ssl, uriSanPeerCertificate()).WillByDefault(Return(uri_sans_));
+    ON_CALL(*ssl, dnsSansPeerCertificate()).WillByDefault(Return(std::vector<std::string>()));
+    ON_CALL(*ssl, subjectPeerCertificate()).WillByDefault(ReturnRef(subject_));
+    ON_CALL(Const(connection_), ssl()).WillByDefault(Return(ssl));
+  }
+
+  std::vector<envoy::config::rbac::v3::Policy> policies_;
+  std::unique_ptr<PolicyIndex> index_;
+  NiceMock<Network::MockConnection> connection_;
+  Http::TestRequestHeaderMapImpl headers_;
+  NiceMock<StreamInfo::MockStreamInfo> info_;
+  std::vector<std::string> uri_sans_;
+  std::string subject_;
+};
+
+TEST_F(PolicyIndexTest, ExactKeys) {
+  initialize({
+      R"EOF(
+permissions: [{destination_port: 80}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{header: {name: X-Tenant, string_match: {exact: a}}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{url_path: {path: {exact: /admin}}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{any: true}]
+principals: [{authenticated: {principal_name: {exact: "spiffe://a"}}}]
+)EOF",
+      R"EOF(
+permissions: [{destination_ip: {address_prefix: 10.0.0.0, prefix_len: 8}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{any: true}]
+principals: [{remote_ip: {address_prefix: 192.168.0.0, prefix_len: 16}}]
+)EOF",
+  });
+  EXPECT_EQ(0, index_->unindexedPolicies());
+
+  EXPECT_THAT(candidates(), ElementsAre(5));
+  setRemoteAddress("172.16.0.1");
+  EXPECT_THAT(candidates(), ElementsAre());
+
+  setLocalAddress("1.2.3.4", 80);
+  EXPECT_THAT(candidates(), ElementsAre(0));
+  setLocalAddress("10.1.2.3", 80);
+  EXPECT_THAT(candidates(), ElementsAre(0, 4));
+
+  headers_.addCopy("x-tenant", "a");
+  headers_.setPath("/admin?user=a");
+  EXPECT_THAT(candidates(), ElementsAre(0, 1, 2, 4));
+  headers_.setCopy(Http::LowerCaseString("x-tenant"), "b");
+  headers_.setPath("/admin/a");
+  EXPECT_THAT(candidates(), ElementsAre(0, 4));
+
+  setPeerCertificate({"spiffe://b"}, "spiffe://a");
+  EXPECT_THAT(candidates(), ElementsAre(0, 3, 4));
+}
+
+TEST_F(PolicyIndexTest, RulesWithoutKeys) {
+  initialize({
+      R"EOF(
+permissions: [{header: {name: x-tenant, string_match: {exact: a, ignore_case: true}}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{header: {name: x-tenant, string_match: {exact: a}, invert_match: true}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{url_path: {path: {prefix: /admin}}}]
+principals: [{authenticated: {}}]
+)EOF",
+      R"EOF(
+permissions: [{destination_port: 80}, {not_rule: {destination_port: 443}}]
+principals: [{any: true}]
+)EOF",
+      R"EOF(
+permissions: [{and_rules: {rules: [{any: true}, {requested_server_name: {exact: a}}]}}]
+principals: [{any: true}]
+)EOF",
+  });
+  EXPECT_EQ(5, index_->unindexedPolicies());
+  EXPECT_THAT(candidates(), ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST_F(PolicyIndexTest, CompositeRules) {
+  initialize({
+      // Any rule of an and_rules has a key of each matching request.
+      R"EOF(
+permissions:
+- and_rules:
+    rules:
+    - url_path: {path: {prefix: /api}}
+    - destination_port: 80
+principals: [{any: true}]
+)EOF",
+      // All the rules of an or_rules need keys.
+      R"EOF(
+permissions:
+- or_rules:
+    rules:
+    - destination_port: 80
+    - header: {name: x-tenant, exact_match: a}
+principals: [{any: true}]
+)EOF",
+      // The most selective of the permissions and principals is used.
+      R"EOF(
+permissions: [{destination_port: 80}, {destination_port: 8080}]
+principals: [{header: {name: x-tenant, exact_match: b}}]
+)EOF",
+  });
+  EXPECT_EQ(0, index_->unindexedPolicies());
+
+  EXPECT_THAT(candidates(), ElementsAre());
+  setLocalAddress("1.2.3.4", 80);
+  EXPECT_THAT(candidates(), ElementsAre(0, 1));
+  setLocalAddress("1.2.3.4", 443);
+  headers_.addCopy("x-tenant", "a");
+  EXPECT_THAT(candidates(), ElementsAre(1));
+  headers_.setCopy(Http::LowerCaseString("x-tenant"), "b");
+  EXPECT_THAT(candidates(), ElementsAre(2));
+}
+
+TEST_F(PolicyIndexTest, OverlappingRanges) {
+  initialize({
+      R"EOF(
+permissions: [{any: true}]
+principals:
+- remote_ip: {address_prefix: 192.168.0.0, prefix_len: 16}
+- remote_ip: {address_prefix: 192.168.0.0, prefix_len: 24}
+)EOF",
+      R"EOF(
+permissions: [{any: true}]
+principals: [{remote_ip: {address_prefix: 0.0.0.0, prefix_len: 0}}]
+)EOF",
+      R"EOF(
+permissions: [{any: true}]
+principals: [{remote_ip: {address_prefix: "::", prefix_len: 0}}]
+)EOF",
+  });
+  EXPECT_THAT(candidates(), ElementsAre(0, 1));
+  setRemoteAddress("2001:db8::1");
+  EXPECT_THAT(candidates(), ElementsAre(2));
+}
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -844,6 +845,46 @@ min_rtt_calc_params:
   EXPECT_FALSE(controller->inMinRTTSamplingWindow());
 }
 
+// Workers racing for forwarding decisions never forward more requests than the concurrency
+// limit.
+TEST_F(GradientControllerTest, MultiThreadForwardingDecisions) {
+  const std::string yaml = R"EOF(
+sample_aggregate_percentile:
+  value: 50
+concurrency_limit_params:
+  max_concurrency_limit:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  jitter:
+    value: 0.0
+  interval: 3600s
+  request_count: 5
+  buffer:
+    value: 0
+  min_concurrency: 100
+)EOF";
+
+  auto controller = makeController(yaml);
+  EXPECT_EQ(100, controller->concurrencyLimit());
+
+  std::atomic<uint32_t> forwarded{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&controller, &forwarded]() {
+      for (int j = 0; j < 1000; ++j) {
+        if (controller->forwardingDecision() == RequestForwardingAction::Forward) {
+          ++forwarded;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(100, forwarded.load());
+}
+
 } // namespace
 } // namespace Controller
 } // namespace AdaptiveConcurrency
@@ -27,9 +27,10 @@ class CacheFilterTest : public ::testing::Test {
 protected:
   // The filter has to be created as a shared_ptr to enable shared_from_this() which is used in the
   // cache callbacks.
-  CacheFilterSharedPtr makeFilter(HttpCache& cache) {
+  CacheFilterSharedPtr makeFilter(HttpCache& cache,
+                                  RequestCoalescerSharedPtr coalescer = nullptr) {
     auto filter = std::make_shared<CacheFilter>(config_, /*stats_prefix=*/"", context_.scope(),
-                                                context_.timeSource(), cache);
+                                                context_.timeSource(), cache, coalescer);
     filter_state_ = std::make_shared<StreamInfo::FilterStateImpl>(
         StreamInfo::FilterState::LifeSpan::FilterChain);
     filter->setDecoderFilterCallbacks(decoder_callbacks_);
@@ -279,6 +280,87 @@ TEST_F(CacheFilterTest, CacheMissWithTrailers) {
   }
 }
 
+TEST_F(CacheFilterTest, CoalescedCacheMiss) {
+  request_headers_.setHost("CoalescedCacheMiss");
+  config_.mutable_request_coalescing_timeout()->set_seconds(5);
+  auto coalescer = std::make_shared<RequestCoalescer>();
+  CacheFilterSharedPtr fill = makeFilter(simple_cache_, coalescer);
+  testDecodeRequestMiss(fill);
+
+  // A concurrent miss for the same key waits for the first request to fill the cache.
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_, coalescer);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_).Times(0);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // Once the response is inserted, the waiting request is served from the cache.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(IsSupersetOfHeaders(response_headers_), true));
+  EXPECT_EQ(fill->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  waiter->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheHit));
+  fill->onDestroy();
+  waiter->onDestroy();
+}
+
+TEST_F(CacheFilterTest, CoalescedCacheMissTimeout) {
+  request_headers_.setHost("CoalescedCacheMissTimeout");
+  config_.mutable_request_coalescing_timeout()->set_seconds(5);
+  auto coalescer = std::make_shared<RequestCoalescer>();
+  CacheFilterSharedPtr fill = makeFilter(simple_cache_, coalescer);
+  testDecodeRequestMiss(fill);
+
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_, coalescer);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // The waiting request goes upstream once the timeout fires, and then ignores the fill.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  time_source_.advanceTimeAndRun(std::chrono::seconds(5), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_).Times(0);
+  EXPECT_EQ(fill->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  waiter->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheMiss));
+  fill->onDestroy();
+  waiter->onDestroy();
+}
+
+// The waiting requests go upstream themselves if the fill is abandoned.
+TEST_F(CacheFilterTest, CoalescedCacheMissFillDestroyed) {
+  request_headers_.setHost("CoalescedCacheMissFillDestroyed");
+  config_.mutable_request_coalescing_timeout()->set_seconds(5);
+  auto coalescer = std::make_shared<RequestCoalescer>();
+  CacheFilterSharedPtr fill = makeFilter(simple_cache_, coalescer);
+  testDecodeRequestMiss(fill);
+
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_, coalescer);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  fill->onDestroy();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+  waiter->onDestroy();
+}
+
 TEST_F(CacheFilterTest, CacheHitNoBody) {
   request_headers_.setHost("CacheHitNoBody");
 
@@ -802,6 +802,35 @@ TEST(CreateVaryIdentifier, DisallowedHeaderWithAllowedHeader) {
       absl::nullopt);
 }
 
+TEST(NormalizeAcceptEncoding, Normalizes) {
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding(""), "");
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding("gzip"), "gzip");
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding("gzip, deflate, br"), "br,deflate,gzip");
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding("BR;q=0.5 , Gzip;q=1,gzip"), "br,gzip");
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding("gzip, identity;q=0, *;Q=0.0"),
+            "gzip,!*,!identity");
+  EXPECT_EQ(VaryHeaderUtils::normalizeAcceptEncoding(" , ;q=1, zstd;q=junk"), "zstd");
+}
+
+TEST(CreateVaryIdentifier, AcceptEncodingIsNormalized) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+  Http::TestRequestHeaderMapImpl request_headers1{{"accept-encoding", "gzip, br;q=0.8"}};
+  Http::TestRequestHeaderMapImpl request_headers2{{"accept-encoding", "br"},
+                                                  {"accept-encoding", "GZIP"}};
+  Http::TestRequestHeaderMapImpl request_headers3{{"accept-encoding", "gzip"}};
+
+  const absl::optional<std::string> vary_identifier1 = VaryHeaderUtils::createVaryIdentifier(
+      vary_allow_list, {"accept-encoding"}, request_headers1);
+  EXPECT_EQ(vary_identifier1, "vary-id\naccept-encoding\r"
+                              "br,gzip\n");
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers2),
+            vary_identifier1);
+  EXPECT_NE(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers3),
+            vary_identifier1);
+}
+
 envoy::extensions::filters::http::cache::v3::CacheConfig getConfig() {
   // Allows {accept, accept-language, width} to be varied in the tests.
   envoy::extensions::filters::http::cache::v3::CacheConfig config;
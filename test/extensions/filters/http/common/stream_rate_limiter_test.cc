@@ -25,6 +25,15 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Common {
 
+class MockTokenBucket : public TokenBucket {
+public:
+  MOCK_METHOD(uint64_t, consume, (uint64_t tokens, bool allow_partial));
+  MOCK_METHOD(uint64_t, consume,
+              (uint64_t tokens, bool allow_partial, std::chrono::milliseconds& time_to_next_token));
+  MOCK_METHOD(std::chrono::milliseconds, nextTokenAvailable, ());
+  MOCK_METHOD(void, maybeReset, (uint64_t num_tokens));
+};
+
 class StreamRateLimiterTest : public testing::Test {
 public:
   void setUpTest(uint16_t limit_kbps, uint16_t fill_interval,
@@ -146,6 +155,22 @@ TEST_F(StreamRateLimiterTest, RateLimitOnSingleStream) {
   EXPECT_EQ(limiter_->destroyed(), true);
 }
 
+TEST_F(StreamRateLimiterTest, EmptyEndStreamDoesNotConsumeTokens) {
+  ON_CALL(decoder_callbacks_, decoderBufferLimit()).WillByDefault(Return(1100));
+  Event::MockTimer* token_timer = new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  auto token_bucket = std::make_shared<NiceMock<MockTokenBucket>>();
+  setUpTest(1, 50, token_bucket);
+
+  EXPECT_CALL(*token_bucket, consume(_, _)).Times(0);
+  EXPECT_CALL(*token_timer, enableTimer(std::chrono::milliseconds(0), _));
+  Buffer::OwnedImpl empty;
+  limiter_->writeData(empty, true);
+  EXPECT_CALL(decoder_callbacks_, injectDecodedDataToFilterChain(BufferStringEqual(""), true));
+  token_timer->invokeCallback();
+
+  limiter_->destroy();
+}
+
 } // namespace Common
 } // namespace HttpFilters
 } // namespace Extensions
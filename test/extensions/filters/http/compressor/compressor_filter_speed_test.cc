@@ -10,12 +10,14 @@
 
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/overload_manager.h"
 #include "test/mocks/stats/mocks.h"
 
 #include "benchmark/benchmark.h"
 #include "gmock/gmock.h"
 
 using testing::Return;
+using testing::ReturnRef;
 
 namespace Envoy {
 namespace Extensions {
@@ -37,6 +39,20 @@ public:
     return compressor;
   }
 
+  Envoy::Compression::Compressor::CompressorPtr createCompressorWithEffort(float effort) override {
+    using Compression::Gzip::Compressor::ZlibCompressorImpl;
+    const int64_t level = level_ == ZlibCompressorImpl::CompressionLevel::Standard
+                              ? 6
+                              : static_cast<int64_t>(level_);
+    auto compressor = std::make_unique<ZlibCompressorImpl>(
+        Compression::Gzip::Compressor::DefaultChunkSize);
+    const int64_t reduced_level =
+        Compression::Common::Compressor::levelForEffort(Z_BEST_SPEED, level, effort);
+    compressor->init(static_cast<ZlibCompressorImpl::CompressionLevel>(reduced_level), strategy_,
+                     window_bits_, memory_level_);
+    return compressor;
+  }
+
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "gzip."); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Gzip;
@@ -106,7 +122,8 @@ struct CompressionParams {
 
 CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
                                                testing::NiceMock<Runtime::MockLoader>& runtime,
-                                               const CompressionParams& params) {
+                                               const CompressionParams& params,
+                                               OptRef<Server::OverloadManager> overload_manager) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
 
@@ -120,8 +137,9 @@ CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
   const auto memory_level = params.memory_level;
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockGzipCompressorFactory>(level, strategy, window_bits, memory_level);
-  CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+  CompressorFilterConfigSharedPtr config =
+      std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats.rootScope(), runtime,
+                                               std::move(compressor_factory), overload_manager);
 
   return config;
 }
@@ -204,7 +222,8 @@ enum class CompressorLibs { Brotli, Gzip, Zstd };
 static Result compressWith(enum CompressorLibs lib, std::vector<Buffer::OwnedImpl>&& chunks,
                            CompressionParams params,
                            NiceMock<Http::MockStreamDecoderFilterCallbacks>& decoder_callbacks,
-                           benchmark::State& state) {
+                           benchmark::State& state,
+                           OptRef<Server::OverloadManager> overload_manager = {}) {
   auto start = std::chrono::high_resolution_clock::now();
   Stats::IsolatedStoreImpl stats;
   testing::NiceMock<Runtime::MockLoader> runtime;
@@ -216,7 +235,7 @@ static Result compressWith(enum CompressorLibs lib, std::vector<Buffer::OwnedImp
     encoding = "br";
     compressor = "brotli";
   } else if (lib == CompressorLibs::Gzip) {
-    config = makeGzipConfig(stats, runtime, params);
+    config = makeGzipConfig(stats, runtime, params, overload_manager);
     encoding = compressor = "gzip";
   } else if (lib == CompressorLibs::Zstd) {
     config = makeZstdConfig(stats, runtime, params);
@@ -688,6 +707,31 @@ BENCHMARK(compressChunks1024WithBrotli)
     ->UseManualTime()
     ->Unit(benchmark::kMillisecond);
 
+// The reduce compression effort overload action lowers the level of gzip from the configured one,
+// the default level 6 here, down to 1 as it goes from 0% to 100%, where compression stops.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressFullWithGzipUnderOverload(benchmark::State& state) {
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  const Server::OverloadActionState overload_state(UnitFloat(state.range(0) / 100.0));
+  ON_CALL(overload_manager.overload_state_,
+          getState(Server::OverloadActionNames::get().ReduceCompressionEffort))
+      .WillByDefault(ReturnRef(overload_state));
+  const auto& params = gzip_compression_params[5];
+
+  for (auto _ : state) { // NOLINT
+    std::vector<Buffer::OwnedImpl> chunks = generateChunks(1, 122880);
+    compressWith(CompressorLibs::Gzip, std::move(chunks), params, decoder_callbacks, state,
+                 overload_manager);
+  }
+}
+BENCHMARK(compressFullWithGzipUnderOverload)
+    ->Arg(0)
+    ->Arg(50)
+    ->Arg(90)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
 } // namespace Compressor
 } // namespace HttpFilters
 } // namespace Extensions
@@ -3,6 +3,7 @@
 #include "test/mocks/compression/compressor/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/overload_manager.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
@@ -18,6 +19,7 @@ namespace {
 using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnRef;
 
 class TestCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
@@ -29,12 +31,18 @@ public:
     EXPECT_CALL(*compressor, compress(_, _)).Times(expected_compress_calls_);
     return compressor;
   }
+  Envoy::Compression::Compressor::CompressorPtr createCompressorWithEffort(float effort) override {
+    last_effort_ = effort;
+    return createCompressor();
+  }
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "test."); }
   const std::string& contentEncoding() const override { return content_encoding_; }
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
+  absl::optional<float> lastEffort() const { return last_effort_; }
 
 private:
+  absl::optional<float> last_effort_;
   uint32_t expected_compress_calls_{1};
   const std::string content_encoding_;
 };
@@ -60,13 +68,14 @@ public:
   }
 
   // CompressorFilterTest Helpers
-  void setUpFilter(std::string&& json) {
+  void setUpFilter(std::string&& json, OptRef<Server::OverloadManager> overload_manager = {}) {
     envoy::extensions::filters::http::compressor::v3::Compressor compressor;
     TestUtility::loadFromJson(json, compressor);
     auto compressor_factory = std::make_unique<TestCompressorFactory>("test");
     compressor_factory_ = compressor_factory.get();
     config_ = std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats_.rootScope(),
-                                                       runtime_, std::move(compressor_factory));
+                                                       runtime_, std::move(compressor_factory),
+                                                       overload_manager);
     filter_ = std::make_unique<CompressorFilter>(config_);
     filter_->setDecoderFilterCallbacks(decoder_callbacks_);
     filter_->setEncoderFilterCallbacks(encoder_callbacks_);
@@ -429,6 +438,92 @@ TEST_F(CompressorFilterTest, EmptyResponse) {
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
 }
 
+// Responses are compressed with the effort left by the reduce compression effort overload action,
+// and not compressed at all once it is saturated.
+TEST_F(CompressorFilterTest, ReduceCompressionEffortOnOverload) {
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  setUpFilter(R"EOF(
+{
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF",
+              overload_manager);
+  const Server::OverloadActionState reduced_state(UnitFloat(0.25));
+  const Server::OverloadActionState saturated_state = Server::OverloadActionState::saturated();
+  EXPECT_CALL(overload_manager.overload_state_,
+              getState(Server::OverloadActionNames::get().ReduceCompressionEffort))
+      .WillOnce(ReturnRef(reduced_state))
+      .WillOnce(ReturnRef(saturated_state));
+
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  ASSERT_TRUE(compressor_factory_->lastEffort().has_value());
+  EXPECT_FLOAT_EQ(0.75, compressor_factory_->lastEffort().value());
+  EXPECT_EQ(1U, stats_.counter("test.compressor.test.test.compressed_with_reduced_effort").value());
+
+  filter_ = std::make_unique<CompressorFilter>(config_);
+  filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+  filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  Http::TestResponseHeaderMapImpl overloaded_headers{{":method", "get"},
+                                                     {"content-length", "256"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(overloaded_headers, false));
+  EXPECT_EQ("", overloaded_headers.get_("content-encoding"));
+  EXPECT_EQ("256", overloaded_headers.get_("content-length"));
+  EXPECT_EQ(1U, stats_.counter("test.compressor.test.test.not_compressed_overload").value());
+}
+
+// Responses of a content type which has compressed poorly are only compressed once in a while, to
+// keep the estimate of its savings up to date.
+TEST_F(CompressorFilterTest, SkipCompressionOfContentTypesWithLowSavings) {
+  setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "min_compression_savings": {
+      "value": 10
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  const auto respond = [this](absl::string_view content_type) {
+    filter_ = std::make_unique<CompressorFilter>(config_);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+    Http::TestResponseHeaderMapImpl headers{
+        {":method", "get"}, {"content-length", "256"}, {"content-type", std::string(content_type)}};
+    populateBuffer(256);
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
+    return headers.get_("content-encoding") == "test";
+  };
+
+  // The mock compressor leaves the data as is, so nothing is saved by compressing it.
+  EXPECT_TRUE(respond("application/json"));
+  for (uint32_t i = 1; i < 16; ++i) {
+    EXPECT_FALSE(respond("Application/JSON; charset=utf-8"));
+  }
+  EXPECT_TRUE(respond("application/json"));
+  EXPECT_EQ(15U, stats_.counter("test.compressor.test.test.not_compressed_low_savings").value());
+
+  // Other content types have their own estimate.
+  EXPECT_TRUE(respond("text/html"));
+}
+
 // Verify removeAcceptEncoding header.
 TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   {
@@ -0,0 +1,213 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+class DecisionCacheTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ext_authz::v3::DecisionCache config;
+    TestUtility::loadFromYaml(yaml, config);
+    cache_ = std::make_unique<DecisionCache>(config, tls_, time_system_);
+  }
+
+  static Response response(CheckStatus status) {
+    Response response{};
+    response.status = status;
+    return response;
+  }
+
+  std::string key(absl::string_view authorization) {
+    Http::TestRequestHeaderMapImpl headers{{"authorization", std::string(authorization)}};
+    return cache_->key(headers, {});
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<ThreadLocal::MockInstance> tls_;
+  std::unique_ptr<DecisionCache> cache_;
+};
+
+TEST_F(DecisionCacheTest, KeyDependsOnHeadersAndContextExtensions) {
+  initialize(R"EOF(
+  key_headers: ["authorization", ":path"]
+  ttl: 10s
+  )EOF");
+
+  Http::TestRequestHeaderMapImpl headers{{"authorization", "Bearer a"}, {":path", "/a"}};
+  const std::string base = cache_->key(headers, {});
+  // Only a hash of the headers is kept.
+  EXPECT_EQ(32, base.size());
+  EXPECT_EQ(base, cache_->key(headers, {}));
+
+  Http::TestRequestHeaderMapImpl other_path{{"authorization", "Bearer a"}, {":path", "/b"}};
+  EXPECT_NE(base, cache_->key(other_path, {}));
+  Http::TestRequestHeaderMapImpl no_path{{"authorization", "Bearer a"}};
+  EXPECT_NE(base, cache_->key(no_path, {}));
+  Http::TestRequestHeaderMapImpl empty_path{{"authorization", "Bearer a"}, {":path", ""}};
+  EXPECT_NE(cache_->key(no_path, {}), cache_->key(empty_path, {}));
+  Http::TestRequestHeaderMapImpl other_header{
+      {"authorization", "Bearer a"}, {":path", "/a"}, {"x-other", "b"}};
+  EXPECT_EQ(base, cache_->key(other_header, {}));
+
+  Protobuf::Map<std::string, std::string> extensions;
+  extensions["route"] = "a";
+  EXPECT_NE(base, cache_->key(headers, extensions));
+  Protobuf::Map<std::string, std::string> same_extensions;
+  same_extensions["route"] = "a";
+  EXPECT_EQ(cache_->key(headers, extensions), cache_->key(headers, same_extensions));
+}
+
+TEST_F(DecisionCacheTest, CachesAllowedDecisionsUntilTtl) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  )EOF");
+
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+  Response allowed = response(CheckStatus::OK);
+  allowed.headers_to_set.emplace_back(Http::LowerCaseString("x-user"), "a");
+  cache_->insert(key("a"), allowed);
+
+  Filters::Common::ExtAuthz::ResponsePtr cached = cache_->lookup(key("a"));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::OK, cached->status);
+  ASSERT_EQ(1, cached->headers_to_set.size());
+  EXPECT_EQ("a", cached->headers_to_set[0].second);
+  EXPECT_EQ(nullptr, cache_->lookup(key("b")));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_NE(nullptr, cache_->lookup(key("a")));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+}
+
+TEST_F(DecisionCacheTest, CachesDeniedDecisionsOnlyWithDeniedTtl) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  )EOF");
+
+  Response denied = response(CheckStatus::Denied);
+  cache_->insert(key("a"), denied);
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+  Response error = response(CheckStatus::Error);
+  cache_->insert(key("a"), error);
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  denied_ttl: 2s
+  )EOF");
+
+  cache_->insert(key("a"), denied);
+  Filters::Common::ExtAuthz::ResponsePtr cached = cache_->lookup(key("a"));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::Denied, cached->status);
+  cache_->insert(key("b"), error);
+  EXPECT_EQ(nullptr, cache_->lookup(key("b")));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+}
+
+TEST_F(DecisionCacheTest, TtlFromServer) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  ttl_header: x-auth-cache-ttl
+  )EOF");
+
+  Response allowed = response(CheckStatus::OK);
+  allowed.headers_to_set.emplace_back(Http::LowerCaseString("x-auth-cache-ttl"), "3");
+  allowed.headers_to_set.emplace_back(Http::LowerCaseString("x-user"), "a");
+  cache_->insert(key("a"), allowed);
+  // The header is consumed by the cache.
+  ASSERT_EQ(1, allowed.headers_to_set.size());
+  EXPECT_EQ("x-user", allowed.headers_to_set[0].first.get());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  Filters::Common::ExtAuthz::ResponsePtr cached = cache_->lookup(key("a"));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(1, cached->headers_to_set.size());
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(nullptr, cache_->lookup(key("a")));
+
+  // The configured TTL is an upper bound.
+  Response long_lived = response(CheckStatus::OK);
+  long_lived.headers_to_set.emplace_back(Http::LowerCaseString("x-auth-cache-ttl"), "3600");
+  cache_->insert(key("b"), long_lived);
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(nullptr, cache_->lookup(key("b")));
+
+  Response uncacheable = response(CheckStatus::OK);
+  uncacheable.headers_to_set.emplace_back(Http::LowerCaseString("x-auth-cache-ttl"), "0");
+  cache_->insert(key("c"), uncacheable);
+  EXPECT_TRUE(uncacheable.headers_to_set.empty());
+  EXPECT_EQ(nullptr, cache_->lookup(key("c")));
+}
+
+TEST_F(DecisionCacheTest, SharedCacheBacksWorkerCache) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  max_entries_per_worker: 1
+  )EOF");
+
+  Response allowed = response(CheckStatus::OK);
+  cache_->insert(key("a"), allowed);
+  cache_->insert(key("b"), allowed);
+  // The decision for "a" was evicted from the cache of the worker, but not from the shared one.
+  EXPECT_NE(nullptr, cache_->lookup(key("a")));
+  EXPECT_NE(nullptr, cache_->lookup(key("b")));
+}
+
+TEST_F(DecisionCacheTest, DenialsDontEvictAllowedDecisions) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  denied_ttl: 10s
+  max_entries_per_worker: 2
+  max_shared_entries: 2
+  max_denied_entries: 1
+  )EOF");
+
+  Response allowed = response(CheckStatus::OK);
+  Response denied = response(CheckStatus::Denied);
+  cache_->insert(key("a"), allowed);
+  cache_->insert(key("b"), denied);
+  cache_->insert(key("c"), denied);
+  EXPECT_NE(nullptr, cache_->lookup(key("a")));
+  EXPECT_EQ(nullptr, cache_->lookup(key("b")));
+  EXPECT_NE(nullptr, cache_->lookup(key("c")));
+
+  // A new decision for a key replaces the previous one.
+  cache_->insert(key("c"), allowed);
+  Filters::Common::ExtAuthz::ResponsePtr cached = cache_->lookup(key("c"));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::OK, cached->status);
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
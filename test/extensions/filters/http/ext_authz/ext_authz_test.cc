@@ -24,6 +24,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/router/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/proto/helloworld.pb.h"
@@ -1584,6 +1585,67 @@ TEST_F(HttpFilterTest, FilterAllowAtDisable) {
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
 }
 
+// Verifies that a cached decision is applied without calling the authorization server.
+TEST_F(HttpFilterTest, DecisionCache) {
+  initialize(R"EOF(
+  transport_api_version: V3
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  )EOF");
+
+  envoy::extensions::filters::http::ext_authz::v3::DecisionCache cache_config;
+  TestUtility::loadFromYaml(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  )EOF",
+                            cache_config);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  auto decision_cache = std::make_shared<DecisionCache>(
+      cache_config, tls, decoder_filter_callbacks_.dispatcher().timeSource());
+  const auto make_filter = [&]() {
+    client_ = new Filters::Common::ExtAuthz::MockClient();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_},
+                                       decision_cache);
+    filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_filter_callbacks_);
+  };
+  prepareCheck();
+
+  make_filter();
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  response.headers_to_set = Http::HeaderVector{{Http::LowerCaseString{"x-user"}, "a"}};
+  auto response_ptr = std::make_unique<Filters::Common::ExtAuthz::Response>(response);
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                           const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                           const StreamInfo::StreamInfo&) -> void {
+        callbacks.onComplete(std::move(response_ptr));
+      }));
+  Http::TestRequestHeaderMapImpl first_headers{{"authorization", "Bearer a"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(first_headers, false));
+  EXPECT_EQ("a", first_headers.get_("x-user"));
+
+  make_filter();
+  EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+  Http::TestRequestHeaderMapImpl second_headers{{"authorization", "Bearer a"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(second_headers, false));
+  EXPECT_EQ("a", second_headers.get_("x-user"));
+
+  make_filter();
+  EXPECT_CALL(*client_, check(_, _, _, _));
+  Http::TestRequestHeaderMapImpl other_headers{{"authorization", "Bearer b"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(other_headers, false));
+  EXPECT_CALL(*client_, cancel());
+  filter_->onDestroy();
+
+  EXPECT_EQ(2U, config_->stats().ok_.value());
+  EXPECT_EQ(1U, config_->stats().decision_cache_hits_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_misses_.value());
+}
+
 // -------------------
 // Parameterized Tests
 // -------------------
@@ -4,6 +4,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/grpc/mocks.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
@@ -15,6 +16,7 @@ using envoy::service::ext_proc::v3::ProcessingRequest;
 using envoy::service::ext_proc::v3::ProcessingResponse;
 
 using testing::Invoke;
+using testing::NiceMock;
 using testing::Unused;
 
 namespace Envoy {
@@ -156,6 +158,189 @@ TEST_F(ExtProcStreamTest, StreamError) {
   stream->close();
 }
 
+class TestProcessorCallbacks : public ExternalProcessorCallbacks {
+public:
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override {
+    responses_.push_back(std::move(response));
+  }
+  void onGrpcError(Grpc::Status::GrpcStatus status) override { grpc_status_ = status; }
+  void onGrpcClose() override { grpc_closed_ = true; }
+
+  std::vector<std::unique_ptr<ProcessingResponse>> responses_;
+  absl::optional<Grpc::Status::GrpcStatus> grpc_status_;
+  bool grpc_closed_ = false;
+};
+
+class MultiplexedStreamTest : public testing::Test {
+protected:
+  void SetUp() override { grpc_service_.mutable_envoy_grpc()->set_cluster_name("test"); }
+
+  void initialize(uint32_t streams_per_worker, uint32_t max_pending_messages) {
+    envoy::extensions::filters::http::ext_proc::v3::StreamMultiplexing config;
+    config.mutable_streams_per_worker()->set_value(streams_per_worker);
+    if (max_pending_messages > 0) {
+      config.mutable_max_pending_messages_per_stream()->set_value(max_pending_messages);
+    }
+    ON_CALL(client_manager_, getOrCreateRawAsyncClient(_, _, _))
+        .WillByDefault(Invoke([this](Unused, Unused, Unused) {
+          auto async_client = std::make_shared<NiceMock<Grpc::MockAsyncClient>>();
+          ON_CALL(*async_client, startRaw(_, _, _, _))
+              .WillByDefault(Invoke([this](Unused, Unused, Grpc::RawAsyncStreamCallbacks& callbacks,
+                                           const Http::AsyncClient::StreamOptions&) {
+                stream_callbacks_.push_back(&callbacks);
+                return &stream_;
+              }));
+          return async_client;
+        }));
+    ON_CALL(stream_, sendMessageRaw_(_, _))
+        .WillByDefault(Invoke([this](Buffer::InstancePtr& request, bool end_stream) {
+          EXPECT_FALSE(end_stream);
+          ProcessingRequest message;
+          EXPECT_TRUE(message.ParseFromString(request->toString()));
+          sent_.push_back(message);
+        }));
+    pool_ = std::make_unique<MultiplexedStreamPool>(client_manager_, *stats_store_.rootScope(),
+                                                    dispatcher_, config, queue_time_,
+                                                    unmatched_responses_);
+    client_ = std::make_unique<MultiplexedExternalProcessorClient>(*pool_);
+  }
+
+  void respond(size_t stream_index, uint64_t request_id) {
+    ProcessingResponse response;
+    response.mutable_request_headers();
+    response.set_multiplexed_request_id(request_id);
+    EXPECT_TRUE(stream_callbacks_[stream_index]->onReceiveMessageRaw(
+        Grpc::Common::serializeMessage(response)));
+  }
+
+  envoy::config::core::v3::GrpcService grpc_service_;
+  NiceMock<Grpc::MockAsyncClientManager> client_manager_;
+  NiceMock<Grpc::MockAsyncStream> stream_;
+  std::vector<Grpc::RawAsyncStreamCallbacks*> stream_callbacks_;
+  std::vector<ProcessingRequest> sent_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  NiceMock<Stats::MockStore> stats_store_;
+  NiceMock<Stats::MockHistogram> queue_time_;
+  NiceMock<Stats::MockCounter> unmatched_responses_;
+  std::unique_ptr<MultiplexedStreamPool> pool_;
+  ExternalProcessorClientPtr client_;
+};
+
+// Requests share a stream, and responses are routed to them by request ID.
+TEST_F(MultiplexedStreamTest, RequestsShareStream) {
+  initialize(1, 0);
+  TestProcessorCallbacks callbacks1;
+  TestProcessorCallbacks callbacks2;
+  auto stream1 = client_->start(callbacks1, grpc_service_, stream_info_);
+  auto stream2 = client_->start(callbacks2, grpc_service_, stream_info_);
+  EXPECT_EQ(1, stream_callbacks_.size());
+
+  EXPECT_CALL(queue_time_, recordValue(_)).Times(2);
+  stream1->send(ProcessingRequest(), false);
+  stream2->send(ProcessingRequest(), false);
+  ASSERT_EQ(2, sent_.size());
+  EXPECT_NE(sent_[0].multiplexed_request_id(), sent_[1].multiplexed_request_id());
+
+  respond(0, sent_[1].multiplexed_request_id());
+  EXPECT_TRUE(callbacks1.responses_.empty());
+  ASSERT_EQ(1, callbacks2.responses_.size());
+  respond(0, sent_[0].multiplexed_request_id());
+  EXPECT_EQ(1, callbacks1.responses_.size());
+
+  // Closing the stream of a request leaves the shared stream open, and late responses for it
+  // are ignored.
+  EXPECT_CALL(stream_, closeStream()).Times(0);
+  EXPECT_TRUE(stream1->close());
+  EXPECT_FALSE(stream1->close());
+  EXPECT_CALL(unmatched_responses_, inc());
+  respond(0, sent_[0].multiplexed_request_id());
+  EXPECT_EQ(1, callbacks1.responses_.size());
+
+  auto stream3 = client_->start(callbacks1, grpc_service_, stream_info_);
+  EXPECT_EQ(1, stream_callbacks_.size());
+  EXPECT_CALL(stream_, resetStream());
+  pool_.reset();
+  EXPECT_FALSE(stream2->close());
+  EXPECT_FALSE(stream3->close());
+}
+
+// More streams are opened up to the configured number, and requests pick the least busy one.
+TEST_F(MultiplexedStreamTest, SpreadOverStreams) {
+  initialize(2, 0);
+  TestProcessorCallbacks callbacks;
+  auto stream1 = client_->start(callbacks, grpc_service_, stream_info_);
+  auto stream2 = client_->start(callbacks, grpc_service_, stream_info_);
+  auto stream3 = client_->start(callbacks, grpc_service_, stream_info_);
+  EXPECT_EQ(2, stream_callbacks_.size());
+  stream1->close();
+  stream2->close();
+  stream3->close();
+}
+
+// Messages beyond the pending limit wait for responses to earlier ones.
+TEST_F(MultiplexedStreamTest, QueueBeyondMaxPendingMessages) {
+  initialize(1, 1);
+  TestProcessorCallbacks callbacks1;
+  TestProcessorCallbacks callbacks2;
+  TestProcessorCallbacks callbacks3;
+  auto stream1 = client_->start(callbacks1, grpc_service_, stream_info_);
+  auto stream2 = client_->start(callbacks2, grpc_service_, stream_info_);
+  auto stream3 = client_->start(callbacks3, grpc_service_, stream_info_);
+
+  stream1->send(ProcessingRequest(), false);
+  stream2->send(ProcessingRequest(), false);
+  stream3->send(ProcessingRequest(), false);
+  ASSERT_EQ(1, sent_.size());
+
+  // The queued message of a closed request is dropped.
+  stream2->close();
+  EXPECT_CALL(queue_time_, recordValue(_));
+  respond(0, sent_[0].multiplexed_request_id());
+  ASSERT_EQ(2, sent_.size());
+  respond(0, sent_[1].multiplexed_request_id());
+  EXPECT_EQ(1, callbacks1.responses_.size());
+  EXPECT_TRUE(callbacks2.responses_.empty());
+  EXPECT_EQ(1, callbacks3.responses_.size());
+  stream1->close();
+  stream3->close();
+}
+
+// When the shared stream is closed remotely, every request using it is told, and the next
+// request opens a new stream.
+TEST_F(MultiplexedStreamTest, RemoteClose) {
+  initialize(1, 0);
+  TestProcessorCallbacks callbacks1;
+  TestProcessorCallbacks callbacks2;
+  auto stream1 = client_->start(callbacks1, grpc_service_, stream_info_);
+  auto stream2 = client_->start(callbacks2, grpc_service_, stream_info_);
+  stream_callbacks_[0]->onRemoteClose(Grpc::Status::Unavailable, "");
+  EXPECT_EQ(Grpc::Status::Unavailable, callbacks1.grpc_status_);
+  EXPECT_EQ(Grpc::Status::Unavailable, callbacks2.grpc_status_);
+  EXPECT_FALSE(stream1->close());
+
+  EXPECT_CALL(dispatcher_, deferredDelete_(_));
+  TestProcessorCallbacks callbacks3;
+  auto stream3 = client_->start(callbacks3, grpc_service_, stream_info_);
+  EXPECT_EQ(2, stream_callbacks_.size());
+  stream_callbacks_[1]->onRemoteClose(Grpc::Status::Ok, "");
+  EXPECT_TRUE(callbacks3.grpc_closed_);
+}
+
+// A stream which can't be started fails the request right away.
+TEST_F(MultiplexedStreamTest, StartFailure) {
+  initialize(1, 0);
+  ON_CALL(client_manager_, getOrCreateRawAsyncClient(_, _, _))
+      .WillByDefault(Invoke([](Unused, Unused, Unused) {
+        auto async_client = std::make_shared<NiceMock<Grpc::MockAsyncClient>>();
+        ON_CALL(*async_client, startRaw(_, _, _, _)).WillByDefault(testing::Return(nullptr));
+        return async_client;
+      }));
+  TestProcessorCallbacks callbacks;
+  EXPECT_EQ(nullptr, client_->start(callbacks, grpc_service_, stream_info_));
+  EXPECT_EQ(Grpc::Status::Unavailable, callbacks.grpc_status_);
+}
+
 } // namespace
 } // namespace ExternalProcessing
 } // namespace HttpFilters
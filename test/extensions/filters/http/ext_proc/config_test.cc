@@ -44,6 +44,52 @@ TEST(HttpExtProcConfigTest, CorrectConfig) {
   cb(filter_callback);
 }
 
+TEST(HttpExtProcConfigTest, MultiplexedConfig) {
+  std::string yaml = R"EOF(
+  grpc_service:
+    google_grpc:
+      target_uri: ext_proc_server
+      stat_prefix: google
+  processing_mode:
+    request_header_mode: send
+    response_header_mode: send
+  stream_multiplexing:
+    streams_per_worker: 2
+    max_pending_messages_per_stream: 100
+  )EOF";
+
+  ExternalProcessingFilterConfig factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyConfigProto();
+  TestUtility::loadFromYaml(yaml, *proto_config);
+
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context;
+  Http::FilterFactoryCb cb = factory.createFilterFactoryFromProto(*proto_config, "stats", context);
+  Http::MockFilterChainFactoryCallbacks filter_callback;
+  EXPECT_CALL(filter_callback, addStreamFilter(_));
+  cb(filter_callback);
+}
+
+TEST(HttpExtProcConfigTest, MultiplexedConfigWithBody) {
+  std::string yaml = R"EOF(
+  grpc_service:
+    google_grpc:
+      target_uri: ext_proc_server
+      stat_prefix: google
+  processing_mode:
+    request_body_mode: buffered
+  stream_multiplexing: {}
+  )EOF";
+
+  ExternalProcessingFilterConfig factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyConfigProto();
+  TestUtility::loadFromYaml(yaml, *proto_config);
+
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context;
+  EXPECT_THROW_WITH_MESSAGE(
+      factory.createFilterFactoryFromProto(*proto_config, "stats", context), EnvoyException,
+      "ext_proc: stream_multiplexing requires a processing mode without bodies or trailers");
+}
+
 } // namespace
 } // namespace ExternalProcessing
 } // namespace HttpFilters
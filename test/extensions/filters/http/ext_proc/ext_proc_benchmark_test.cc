@@ -65,7 +65,12 @@ protected:
 
   static void TearDownTestSuite() { PERF_DUMP(); }
 
-  void TearDown() override { test_processor_.shutdown(); }
+  void TearDown() override {
+    // Shared streams to the processor stay open until Envoy shuts down.
+    cleanupUpstreamAndDownstream();
+    test_server_.reset();
+    test_processor_.shutdown();
+  }
 
   void initialize() override {
     // This enables a built-in automatic upstream server.
@@ -247,6 +252,55 @@ TEST_F(BenchmarkTest, ProcessBufferedResponseBody) {
   measureHttpGets("buffered-response-body", 2000);
 }
 
+// Add a request header over a gRPC stream shared by all the requests.
+TEST_F(BenchmarkTest, MultiplexedAddRequestHeader) {
+  proto_config_.mutable_stream_multiplexing();
+  test_processor_.start(
+      ipVersion(), [](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        ProcessingRequest header_req;
+        while (stream->Read(&header_req)) {
+          ASSERT_TRUE(header_req.has_request_headers());
+          ProcessingResponse header_resp;
+          header_resp.set_multiplexed_request_id(header_req.multiplexed_request_id());
+          auto* new_hdr = header_resp.mutable_request_headers()
+                              ->mutable_response()
+                              ->mutable_header_mutation()
+                              ->add_set_headers();
+          new_hdr->mutable_header()->set_key("x-envoy-benchmark");
+          new_hdr->mutable_header()->set_value("true");
+          // The response headers aren't sent to the processor.
+          header_resp.mutable_mode_override()->set_response_header_mode(ProcessingMode::SKIP);
+          stream->Write(header_resp);
+        }
+      });
+  initialize();
+  measureHttpGets("multiplexed-add-request-header");
+}
+
+// Add a request header and a response header over a gRPC stream shared by all the requests.
+TEST_F(BenchmarkTest, MultiplexedAddRequestAndResponseHeaders) {
+  proto_config_.mutable_stream_multiplexing()->mutable_max_pending_messages_per_stream()->set_value(
+      16);
+  test_processor_.start(
+      ipVersion(), [](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        ProcessingRequest request;
+        while (stream->Read(&request)) {
+          ProcessingResponse response;
+          response.set_multiplexed_request_id(request.multiplexed_request_id());
+          auto* headers_response = request.has_request_headers()
+                                       ? response.mutable_request_headers()
+                                       : response.mutable_response_headers();
+          auto* new_hdr =
+              headers_response->mutable_response()->mutable_header_mutation()->add_set_headers();
+          new_hdr->mutable_header()->set_key("x-envoy-benchmark");
+          new_hdr->mutable_header()->set_value("true");
+          stream->Write(response);
+        }
+      });
+  initialize();
+  measureHttpGets("multiplexed-add-request-and-response-headers");
+}
+
 } // namespace
 } // namespace ExternalProcessing
 } // namespace HttpFilters
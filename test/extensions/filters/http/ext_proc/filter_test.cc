@@ -1323,6 +1323,132 @@ TEST_F(HttpFilterTest, PostStreamingBodiesDifferentOrder) {
   EXPECT_EQ(1, config_->stats().streams_closed_.value());
 }
 
+// Using a configuration with a window for streamed bodies, ensure that chunks
+// are held back while the window is full, and that responses arriving out of
+// order are passed on in the original order.
+TEST_F(HttpFilterTest, StreamedBodyWindowOutOfOrderResponses) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  processing_mode:
+    request_header_mode: "SEND"
+    response_header_mode: "SKIP"
+    request_body_mode: "STREAMED"
+  streamed_body_window:
+    max_in_flight_bytes: 250
+  )EOF");
+
+  EXPECT_CALL(decoder_callbacks_, decodingBuffer()).WillRepeatedly(Return(nullptr));
+  EXPECT_EQ(FilterHeadersStatus::StopIteration, filter_->decodeHeaders(request_headers_, false));
+  processRequestHeaders(false, absl::nullopt);
+
+  bool decoding_watermarked = false;
+  setUpDecodingWatermarking(decoding_watermarked);
+
+  Buffer::OwnedImpl got_request_body;
+  EXPECT_CALL(decoder_callbacks_, injectDecodedDataToFilterChain(_, false))
+      .WillRepeatedly(Invoke(
+          [&got_request_body](Buffer::Instance& data, Unused) { got_request_body.move(data); }));
+
+  const auto respond = [this](uint64_t chunk_index, absl::optional<std::string> new_body) {
+    auto response = std::make_unique<ProcessingResponse>();
+    auto* body_response = response->mutable_request_body();
+    body_response->set_chunk_index(chunk_index);
+    if (new_body) {
+      body_response->mutable_response()->mutable_body_mutation()->set_body(*new_body);
+    }
+    stream_callbacks_->onReceiveMessage(std::move(response));
+  };
+
+  std::vector<std::string> chunks;
+  for (int i = 0; i < 3; i++) {
+    Buffer::OwnedImpl req_chunk;
+    TestUtility::feedBufferWithRandomCharacters(req_chunk, 100);
+    chunks.push_back(req_chunk.toString());
+    EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(req_chunk, false));
+    EXPECT_EQ(0, req_chunk.length());
+  }
+  // The third chunk doesn't fit in the window.
+  EXPECT_EQ(3, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(1, last_request_.request_body().chunk_index());
+
+  // A response to the second chunk makes room for the third one, but nothing
+  // can be passed on before the first chunk is done.
+  respond(1, "one");
+  EXPECT_EQ(0, got_request_body.length());
+  EXPECT_EQ(4, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(2, last_request_.request_body().chunk_index());
+  EXPECT_EQ(chunks[2], last_request_.request_body().body());
+
+  Buffer::OwnedImpl last_chunk;
+  EXPECT_EQ(FilterDataStatus::StopIterationNoBuffer, filter_->decodeData(last_chunk, true));
+  EXPECT_EQ(5, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(3, last_request_.request_body().chunk_index());
+  EXPECT_TRUE(last_request_.request_body().end_of_stream());
+
+  respond(0, absl::nullopt);
+  EXPECT_EQ(chunks[0] + "one", got_request_body.toString());
+  respond(3, absl::nullopt);
+  EXPECT_EQ(chunks[0] + "one", got_request_body.toString());
+
+  EXPECT_CALL(decoder_callbacks_, continueDecoding());
+  respond(2, absl::nullopt);
+  EXPECT_EQ(chunks[0] + "one" + chunks[2], got_request_body.toString());
+  EXPECT_FALSE(decoding_watermarked);
+
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().streams_started_.value());
+  EXPECT_EQ(5, config_->stats().stream_msgs_received_.value());
+  EXPECT_EQ(0, config_->stats().spurious_msgs_received_.value());
+  EXPECT_EQ(1, config_->stats().streams_closed_.value());
+  expectGrpcCalls(envoy::config::core::v3::TrafficDirection::INBOUND, Grpc::Status::Ok, 5);
+}
+
+// Using a configuration with a window for streamed bodies, ensure that a
+// response for a chunk that is not awaiting one is treated as spurious.
+TEST_F(HttpFilterTest, StreamedBodyWindowUnknownChunkIndex) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  processing_mode:
+    request_header_mode: "SEND"
+    response_header_mode: "SKIP"
+    request_body_mode: "STREAMED"
+  streamed_body_window:
+    max_in_flight_bytes: 1000
+  )EOF");
+
+  EXPECT_CALL(decoder_callbacks_, decodingBuffer()).WillRepeatedly(Return(nullptr));
+  EXPECT_EQ(FilterHeadersStatus::StopIteration, filter_->decodeHeaders(request_headers_, false));
+  processRequestHeaders(false, absl::nullopt);
+
+  Buffer::OwnedImpl got_request_body;
+  EXPECT_CALL(decoder_callbacks_, injectDecodedDataToFilterChain(_, false))
+      .WillRepeatedly(Invoke(
+          [&got_request_body](Buffer::Instance& data, Unused) { got_request_body.move(data); }));
+
+  Buffer::OwnedImpl req_chunk("foo");
+  EXPECT_EQ(FilterDataStatus::StopIterationNoBuffer, filter_->decodeData(req_chunk, true));
+
+  // The chunk is passed on unmodified once the stream is abandoned.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding());
+  auto response = std::make_unique<ProcessingResponse>();
+  auto* body_response = response->mutable_request_body();
+  body_response->set_chunk_index(7);
+  body_response->mutable_response()->mutable_body_mutation()->set_body("bar");
+  stream_callbacks_->onReceiveMessage(std::move(response));
+  EXPECT_EQ("foo", got_request_body.toString());
+
+  filter_->onDestroy();
+
+  EXPECT_EQ(2, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(1, config_->stats().spurious_msgs_received_.value());
+  EXPECT_EQ(1, config_->stats().streams_closed_.value());
+}
+
 // Using a configuration with streaming set for the response body,
 // change the processing mode after receiving some chunks and verify the
 // correct behavior.
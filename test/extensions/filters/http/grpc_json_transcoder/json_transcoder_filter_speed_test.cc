@@ -0,0 +1,124 @@
+#include "envoy/extensions/filters/http/grpc_json_transcoder/v3/transcoder.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/grpc/common.h"
+#include "source/extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/proto/bookstore.pb.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+namespace {
+
+// Adds the file of the bookstore protos and its dependencies, so that the benchmark doesn't need
+// the descriptor set of the runfiles.
+void addFile(const Protobuf::FileDescriptor& file, absl::flat_hash_set<std::string>& added,
+             Protobuf::FileDescriptorSet& descriptor_set) {
+  if (!added.insert(file.name()).second) {
+    return;
+  }
+  for (int i = 0; i < file.dependency_count(); ++i) {
+    addFile(*file.dependency(i), added, descriptor_set);
+  }
+  file.CopyTo(descriptor_set.add_file());
+}
+
+envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder bookstoreConfig() {
+  Protobuf::FileDescriptorSet descriptor_set;
+  absl::flat_hash_set<std::string> added;
+  addFile(*bookstore::Shelf::descriptor()->file(), added, descriptor_set);
+
+  envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder proto_config;
+  proto_config.set_proto_descriptor_bin(descriptor_set.SerializeAsString());
+  proto_config.add_services("bookstore.Bookstore");
+  return proto_config;
+}
+
+class TranscoderBenchmark {
+public:
+  TranscoderBenchmark() : api_(Api::createApiForTest()), config_(bookstoreConfig(), *api_) {
+    ON_CALL(decoder_callbacks_, decoderBufferLimit()).WillByDefault(Return(64 << 20));
+    ON_CALL(encoder_callbacks_, encoderBufferLimit()).WillByDefault(Return(64 << 20));
+  }
+
+  // Transcodes a GET request and the gRPC response of the given frames.
+  void transcode(absl::string_view path, const Buffer::Instance& response_frames) {
+    JsonTranscoderFilter filter(config_);
+    filter.setDecoderFilterCallbacks(decoder_callbacks_);
+    filter.setEncoderFilterCallbacks(encoder_callbacks_);
+
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                   {":path", std::string(path)}};
+    filter.decodeHeaders(request_headers, true);
+
+    Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/grpc"},
+                                                     {":status", "200"}};
+    filter.encodeHeaders(response_headers, false);
+    Buffer::OwnedImpl response_data;
+    response_data.add(response_frames);
+    filter.encodeData(response_data, false);
+    Http::TestResponseTrailerMapImpl response_trailers{{"grpc-status", "0"}};
+    filter.encodeTrailers(response_trailers);
+    benchmark::DoNotOptimize(response_data.length());
+  }
+
+  Api::ApiPtr api_;
+  JsonTranscoderConfig config_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+};
+
+// A unary call returning a message with the given number of repeated messages.
+static void BM_UnaryRepeatedField(benchmark::State& state) {
+  TranscoderBenchmark transcoder;
+  bookstore::ListShelvesResponse response;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    bookstore::Shelf* shelf = response.add_shelves();
+    shelf->set_id(i);
+    shelf->set_theme(absl::StrCat("theme of the shelf ", i));
+  }
+  const Buffer::InstancePtr frames = Grpc::Common::serializeToGrpcFrame(response);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    transcoder.transcode("/shelves", *frames);
+  }
+}
+BENCHMARK(BM_UnaryRepeatedField)->Arg(10)->Arg(1000)->Arg(10000);
+
+// A server streaming call returning the given number of messages with repeated fields.
+static void BM_ServerStreaming(benchmark::State& state) {
+  TranscoderBenchmark transcoder;
+  Buffer::OwnedImpl frames;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    bookstore::Book book;
+    book.set_id(i);
+    book.set_author("author");
+    book.set_title(absl::StrCat("title of the book ", i));
+    for (int quote = 0; quote < 10; ++quote) {
+      book.add_quotes(absl::StrCat("quote ", quote, " of the book ", i));
+    }
+    frames.move(*Grpc::Common::serializeToGrpcFrame(book));
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    transcoder.transcode("/shelves/1/books", frames);
+  }
+}
+BENCHMARK(BM_ServerStreaming)->Arg(10)->Arg(1000)->Arg(10000);
+
+} // namespace
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
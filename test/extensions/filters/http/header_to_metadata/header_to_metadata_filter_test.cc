@@ -438,6 +438,41 @@ response_rules:
   EXPECT_EQ(empty_headers, incoming_headers);
 }
 
+/**
+ * Constant values are converted when the config is loaded.
+ */
+TEST_F(HeaderToMetadataTest, ConstantValuesConvertedWithConfig) {
+  const std::string response_config_yaml = R"EOF(
+response_rules:
+  - header: x-something
+    on_header_present:
+      key: something
+      value: ' 42 '
+      type: NUMBER
+    on_header_missing:
+      key: something
+      value: not a number
+      type: NUMBER
+)EOF";
+  initializeFilter(response_config_yaml);
+  const Rule& rule = getConfig()->responseRules()[0];
+  ASSERT_TRUE(rule.onHeaderPresentValue().has_value());
+  EXPECT_EQ(42, rule.onHeaderPresentValue()->number_value());
+  // The invalid constant is skipped for each request instead.
+  EXPECT_FALSE(rule.onHeaderMissingValue().has_value());
+
+  Http::TestResponseHeaderMapImpl incoming_headers{{"x-something", "thing"}};
+  std::map<std::string, int> expected = {{"something", 42}};
+  EXPECT_CALL(encoder_callbacks_, streamInfo()).WillRepeatedly(ReturnRef(req_info_));
+  EXPECT_CALL(req_info_,
+              setDynamicMetadata("envoy.filters.http.header_to_metadata", MapEqNum(expected)));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(incoming_headers, false));
+
+  Http::TestResponseHeaderMapImpl empty_headers;
+  EXPECT_CALL(req_info_, setDynamicMetadata(_, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(empty_headers, false));
+}
+
 /**
  * Rules with no on_header{present,missing} fields should be rejected.
  */
@@ -80,6 +80,50 @@ TEST_F(JwtCacheTest, TestExpiredToken) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+TEST_F(JwtCacheTest, TestSharedCache) {
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  config.set_shared_jwt_cache_size(100);
+  SharedJwtCacheSharedPtr shared_cache = SharedJwtCache::create(true, config, time_system_);
+  ASSERT_NE(shared_cache, nullptr);
+  // Caches of two workers.
+  JwtCachePtr cache1 = JwtCache::create(true, config, time_system_, shared_cache);
+  JwtCachePtr cache2 = JwtCache::create(true, config, time_system_, shared_cache);
+
+  loadJwt(GoodToken);
+  auto* origin_jwt = jwt_.get();
+  cache1->insert(GoodToken, std::move(jwt_));
+  EXPECT_EQ(cache1->lookup(GoodToken), origin_jwt);
+
+  // The JWT verified by the first worker is found by the second one, which keeps its own copy.
+  auto* jwt = cache2->lookup(GoodToken);
+  ASSERT_NE(jwt, nullptr);
+  EXPECT_NE(jwt, origin_jwt);
+  EXPECT_EQ(jwt->iss_, origin_jwt->iss_);
+  EXPECT_EQ(cache2->lookup(GoodToken), jwt);
+
+  EXPECT_EQ(cache2->lookup(NonExpiringToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, TestSharedCacheExpiredToken) {
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  config.set_shared_jwt_cache_size(100);
+  SharedJwtCacheSharedPtr shared_cache = SharedJwtCache::create(true, config, time_system_);
+  JwtCachePtr cache1 = JwtCache::create(true, config, time_system_, shared_cache);
+  JwtCachePtr cache2 = JwtCache::create(true, config, time_system_, shared_cache);
+
+  loadJwt(ExpiredToken);
+  cache1->insert(ExpiredToken, std::move(jwt_));
+  EXPECT_EQ(shared_cache->lookup(ExpiredToken), nullptr);
+  EXPECT_EQ(cache2->lookup(ExpiredToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, TestSharedCacheDisabled) {
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  EXPECT_EQ(SharedJwtCache::create(true, config, time_system_), nullptr);
+  config.set_shared_jwt_cache_size(100);
+  EXPECT_EQ(SharedJwtCache::create(false, config, time_system_), nullptr);
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
@@ -717,6 +717,23 @@ TEST_F(OAuth2Test, CookieValidatorInvalidExpiresAt) {
   EXPECT_FALSE(cookie_validator->isValid());
 }
 
+// Validates the behavior of the cookie validator when there is no HMAC cookie.
+TEST_F(OAuth2Test, CookieValidatorMissingHmac) {
+  Http::TestRequestHeaderMapImpl request_headers{
+      {Http::Headers::get().Host.get(), "traffic.example.com"},
+      {Http::Headers::get().Path.get(), "/anypath"},
+      {Http::Headers::get().Method.get(), Http::Headers::get().MethodValues.Get},
+      {Http::Headers::get().Cookie.get(), "BearerToken=xyztoken;version=test"},
+  };
+
+  auto cookie_validator = std::make_shared<OAuth2CookieValidator>(
+      test_time_, CookieNames{"BearerToken", "OauthHMAC", "OauthExpires"});
+  cookie_validator->setParams(request_headers, "mock-secret");
+
+  EXPECT_FALSE(cookie_validator->hmacIsValid());
+  EXPECT_FALSE(cookie_validator->isValid());
+}
+
 // Verify that we 401 the request if the state query param doesn't contain a valid URL.
 TEST_F(OAuth2Test, OAuthTestInvalidUrlInStateQueryParam) {
   Http::TestRequestHeaderMapImpl request_headers{
@@ -3,12 +3,14 @@
 #include "test/extensions/common/tap/common.h"
 #include "test/extensions/filters/http/tap/common.h"
 #include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
 #include "test/test_common/utility.h"
 
 using testing::_;
 using testing::Assign;
 using testing::ByMove;
 using testing::InSequence;
+using testing::NiceMock;
 using testing::Return;
 using testing::ReturnRef;
 
@@ -258,6 +260,36 @@ http_streamed_trace_segment:
   EXPECT_TRUE(tapper_->onDestroyLog());
 }
 
+// Requests which are not sampled by tap_enabled do not get a tapper.
+TEST(HttpTapConfigImplTest, TapEnabled) {
+  envoy::config::tap::v3::TapConfig proto_config;
+  TestUtility::loadFromYaml(R"EOF(
+match:
+  any_match: true
+output_config:
+  sinks:
+    - format: PROTO_BINARY
+      file_per_tap:
+        path_prefix: tap
+tap_enabled:
+  default_value:
+    numerator: 1
+    denominator: TEN_THOUSAND
+  runtime_key: tap.enabled
+)EOF",
+                            proto_config);
+  NiceMock<Runtime::MockLoader> runtime;
+  auto config = std::make_shared<HttpTapConfigImpl>(proto_config, nullptr, runtime);
+
+  EXPECT_CALL(runtime.snapshot_,
+              featureEnabled("tap.enabled",
+                             testing::Matcher<const envoy::type::v3::FractionalPercent&>(_)))
+      .WillOnce(Return(false))
+      .WillOnce(Return(true));
+  EXPECT_EQ(nullptr, config->createPerRequestTapper(1));
+  EXPECT_NE(nullptr, config->createPerRequestTapper(2));
+}
+
 } // namespace
 } // namespace TapFilter
 } // namespace HttpFilters
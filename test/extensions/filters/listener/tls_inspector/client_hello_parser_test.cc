@@ -0,0 +1,158 @@
+#include <string>
+#include <vector>
+
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+using Result = ClientHelloParser::Result;
+
+void appendU16(std::vector<uint8_t>& out, uint16_t value) {
+  out.push_back(value >> 8);
+  out.push_back(value & 0xff);
+}
+
+// Builds a TLS 1.2 ClientHello record with the given extensions.
+std::vector<uint8_t> clientHelloWithExtensions(const std::vector<uint8_t>& extensions) {
+  std::vector<uint8_t> body;
+  appendU16(body, TLS1_2_VERSION);
+  body.insert(body.end(), 32, 0);              // random
+  body.push_back(0);                           // session_id
+  body.insert(body.end(), {0, 2, 0xc0, 0x2f}); // cipher_suites
+  body.insert(body.end(), {1, 0});             // compression_methods
+  appendU16(body, extensions.size());
+  body.insert(body.end(), extensions.begin(), extensions.end());
+
+  std::vector<uint8_t> record = {22, 3, 1};
+  appendU16(record, body.size() + 4);
+  record.insert(record.end(), {1, 0});
+  appendU16(record, body.size());
+  record.insert(record.end(), body.begin(), body.end());
+  return record;
+}
+
+std::vector<uint8_t> serverNameExtension(const std::vector<std::string>& names) {
+  std::vector<uint8_t> list;
+  for (const std::string& name : names) {
+    list.push_back(TLSEXT_NAMETYPE_host_name);
+    appendU16(list, name.size());
+    list.insert(list.end(), name.begin(), name.end());
+  }
+  std::vector<uint8_t> extension;
+  appendU16(extension, TLSEXT_TYPE_server_name);
+  appendU16(extension, list.size() + 2);
+  appendU16(extension, list.size());
+  extension.insert(extension.end(), list.begin(), list.end());
+  return extension;
+}
+
+TEST(ClientHelloParserTest, Parse) {
+  const std::vector<uint8_t> data = Tls::Test::generateClientHello(
+      TLS1_VERSION, TLS1_3_VERSION, "example.com", "\x02h2\x08http/1.1");
+  ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+  ASSERT_EQ(Result::Done, parser.parse(data));
+  EXPECT_EQ("example.com", parser.serverName());
+  EXPECT_EQ(TLS1_2_VERSION, parser.version());
+  EXPECT_FALSE(parser.cipherSuites().empty());
+
+  CBS alpn;
+  ASSERT_TRUE(parser.getExtension(TLSEXT_TYPE_application_layer_protocol_negotiation, &alpn));
+  EXPECT_EQ(std::string("\x00\x0c\x02h2\x08http/1.1", 14),
+            std::string(reinterpret_cast<const char*>(CBS_data(&alpn)), CBS_len(&alpn)));
+  CBS unknown;
+  EXPECT_FALSE(parser.getExtension(0xfeed, &unknown));
+}
+
+TEST(ClientHelloParserTest, Truncated) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_3_VERSION, "example.com", "");
+  ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+  for (size_t len = 0; len < data.size(); ++len) {
+    EXPECT_EQ(Result::NeedMoreData, parser.parse({data.data(), len})) << len;
+  }
+  EXPECT_EQ(Result::Done, parser.parse(data));
+}
+
+// The ClientHello may be fragmented across records.
+TEST(ClientHelloParserTest, MultipleRecords) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_3_VERSION, "example.com", "");
+  const size_t payload_size = data.size() - 5;
+  // Split within the handshake header and within the message.
+  for (const size_t split : {size_t(2), payload_size / 2}) {
+    std::vector<uint8_t> fragmented = {22, 3, 1};
+    appendU16(fragmented, split);
+    fragmented.insert(fragmented.end(), data.begin() + 5, data.begin() + 5 + split);
+    fragmented.insert(fragmented.end(), {22, 3, 1});
+    appendU16(fragmented, payload_size - split);
+    fragmented.insert(fragmented.end(), data.begin() + 5 + split, data.end());
+
+    ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+    EXPECT_EQ(Result::NeedMoreData, parser.parse({fragmented.data(), fragmented.size() - 1}));
+    ASSERT_EQ(Result::Done, parser.parse(fragmented));
+    EXPECT_EQ("example.com", parser.serverName());
+  }
+}
+
+TEST(ClientHelloParserTest, NotClientHello) {
+  ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+  // Not a handshake record.
+  EXPECT_EQ(Result::NotClientHello, parser.parse(std::vector<uint8_t>(100, 0)));
+  EXPECT_EQ(Result::NotClientHello, parser.parse(std::vector<uint8_t>{23}));
+  // Not a TLS record version.
+  EXPECT_EQ(Result::NotClientHello, parser.parse(std::vector<uint8_t>{22, 2, 0}));
+  // Not a ClientHello message.
+  EXPECT_EQ(Result::NotClientHello, parser.parse(std::vector<uint8_t>{22, 3, 1, 0, 4, 2, 0, 0, 0}));
+  // A message larger than BoringSSL accepts.
+  EXPECT_EQ(Result::NotClientHello,
+            parser.parse(std::vector<uint8_t>{22, 3, 1, 0, 4, 1, 0, 0x40, 0x01}));
+}
+
+TEST(ClientHelloParserTest, UnsupportedVersion) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_2_VERSION, "example.com", "");
+  EXPECT_EQ(Result::Done, ClientHelloParser(TLS1_2_VERSION, TLS1_3_VERSION).parse(data));
+  EXPECT_EQ(Result::NotClientHello, ClientHelloParser(TLS1_3_VERSION, TLS1_3_VERSION).parse(data));
+}
+
+TEST(ClientHelloParserTest, ServerName) {
+  ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+  EXPECT_EQ(Result::Done, parser.parse(clientHelloWithExtensions({})));
+  EXPECT_EQ("", parser.serverName());
+  EXPECT_EQ(Result::Done, parser.parse(clientHelloWithExtensions(serverNameExtension({"a.com"}))));
+  EXPECT_EQ("a.com", parser.serverName());
+
+  // Only a single non-empty name is accepted.
+  EXPECT_EQ(Result::NotClientHello,
+            parser.parse(clientHelloWithExtensions(serverNameExtension({"a.com", "b.com"}))));
+  EXPECT_EQ(Result::NotClientHello,
+            parser.parse(clientHelloWithExtensions(serverNameExtension({""}))));
+  EXPECT_EQ(Result::NotClientHello,
+            parser.parse(clientHelloWithExtensions(serverNameExtension({std::string("a\0b", 3)}))));
+}
+
+TEST(ClientHelloParserTest, MalformedExtensions) {
+  ClientHelloParser parser(TLS1_VERSION, TLS1_3_VERSION);
+  std::vector<uint8_t> duplicated = serverNameExtension({"a.com"});
+  const std::vector<uint8_t> copy = duplicated;
+  duplicated.insert(duplicated.end(), copy.begin(), copy.end());
+  EXPECT_EQ(Result::NotClientHello, parser.parse(clientHelloWithExtensions(duplicated)));
+
+  // The extension claims more data than there is.
+  EXPECT_EQ(Result::NotClientHello, parser.parse(clientHelloWithExtensions({0, 0, 0, 8, 0})));
+}
+
+} // namespace
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -5,6 +5,7 @@
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/listener_filter_buffer_impl.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 #include "source/extensions/filters/listener/tls_inspector/tls_inspector.h"
 
 #include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
@@ -72,6 +73,8 @@ static void BM_TlsInspector(benchmark::State& state) {
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls};
   NiceMock<Stats::MockStore> store;
   envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector proto_config;
+  // The first argument enables JA3 fingerprinting.
+  proto_config.mutable_enable_ja3_fingerprinting()->set_value(state.range(0) != 0);
   ConfigSharedPtr cfg(std::make_shared<Config>(*store.rootScope(), proto_config));
   Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>();
   Network::ConnectionSocketImpl socket(std::move(io_handle), nullptr, nullptr);
@@ -100,7 +103,23 @@ static void BM_TlsInspector(benchmark::State& state) {
   }
 }
 
-BENCHMARK(BM_TlsInspector)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TlsInspector)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Parsing alone, without the filter and the socket.
+static void BM_ClientHelloParser(benchmark::State& state) {
+  const std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      Config::TLS_MIN_SUPPORTED_VERSION, Config::TLS_MAX_SUPPORTED_VERSION, "example.com",
+      "\x02h2\x08http/1.1");
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ClientHelloParser parser(Config::TLS_MIN_SUPPORTED_VERSION, Config::TLS_MAX_SUPPORTED_VERSION);
+    RELEASE_ASSERT(parser.parse(client_hello) == ClientHelloParser::Result::Done, "");
+    benchmark::DoNotOptimize(parser.serverName());
+  }
+}
+
+BENCHMARK(BM_ClientHelloParser)->Unit(benchmark::kNanosecond);
 
 } // namespace TlsInspector
 } // namespace ListenerFilters
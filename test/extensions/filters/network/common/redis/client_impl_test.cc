@@ -188,6 +188,7 @@ class ConfigBufferSizeGTSingleRequest : public Config {
     return std::chrono::milliseconds(1);
   }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+  uint32_t maxConnectionsPerHost() const override { return 1; }
   bool enableCommandStats() const override { return false; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
 };
@@ -348,6 +349,7 @@ class ConfigEnableCommandStats : public Config {
   }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+  uint32_t maxConnectionsPerHost() const override { return 1; }
   bool enableCommandStats() const override { return true; }
 };
 
@@ -734,6 +736,7 @@ class ConfigOutlierDisabled : public Config {
   }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+  uint32_t maxConnectionsPerHost() const override { return 1; }
   bool enableCommandStats() const override { return false; }
 };
 
@@ -275,6 +275,28 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, FragmentedBulkString) {
+  // The string spans several slices, and its last bytes are only received by a later decode().
+  buffer_.appendSliceForTest("$20\r\n0123");
+  buffer_.appendSliceForTest("456789");
+  decoder_.decode(buffer_);
+  EXPECT_TRUE(decoded_values_.empty());
+  EXPECT_EQ(0UL, buffer_.length());
+
+  buffer_.appendSliceForTest("0123456789\r\n");
+  decoder_.decode(buffer_);
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_EQ(RespType::BulkString, decoded_values_[0]->type());
+  EXPECT_EQ("01234567890123456789", decoded_values_[0]->asString());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, BulkStringLengthNotTrusted) {
+  // The string isn't reserved past the bytes which were received.
+  buffer_.add("$1000000000\r\nabc");
+  decoder_.decode(buffer_);
+  EXPECT_TRUE(decoded_values_.empty());
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
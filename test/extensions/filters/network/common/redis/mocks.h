@@ -84,6 +84,7 @@ public:
 
   MOCK_METHOD(void, addConnectionCallbacks, (Network::ConnectionCallbacks & callbacks));
   MOCK_METHOD(bool, active, ());
+  MOCK_METHOD(uint64_t, pendingRequests, ());
   MOCK_METHOD(void, close, ());
   MOCK_METHOD(PoolRequest*, makeRequest_,
               (const Common::Redis::RespValue& request, ClientCallbacks& callbacks));
@@ -77,6 +77,26 @@ TEST(RpcInvocationImplAttachmentTest, RpcInvocationImplAttachmentTest) {
   EXPECT_EQ(23333, attachment.attachmentOffset());
 }
 
+// The header map is built from the attachment, including the updates made before it was built.
+TEST(RpcInvocationImplAttachmentTest, HeadersBuiltOnDemand) {
+  auto map = std::make_unique<RpcInvocationImpl::Attachment::Map>();
+  map->emplace(std::make_unique<Hessian2::StringObject>("group"),
+               std::make_unique<Hessian2::StringObject>("fake_group"));
+  map->emplace(std::make_unique<Hessian2::StringObject>("fake_key"),
+               std::make_unique<Hessian2::StringObject>("fake_value"));
+
+  RpcInvocationImpl::Attachment attachment(std::move(map), 0);
+  attachment.remove("fake_key");
+  attachment.insert("test", "test_value");
+
+  const auto& headers = attachment.headers();
+  EXPECT_EQ(2, headers.size());
+  EXPECT_EQ("fake_group", headers.get(Http::LowerCaseString("group"))[0]->value().getStringView());
+  EXPECT_EQ("test_value", headers.get(Http::LowerCaseString("test"))[0]->value().getStringView());
+  EXPECT_TRUE(headers.get(Http::LowerCaseString("fake_key")).empty());
+  EXPECT_EQ(&headers, &attachment.headers());
+}
+
 TEST(RpcInvocationImplTest, RpcInvocationImplTest) {
   RpcInvocationImpl invo;
 
@@ -10,7 +10,9 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::Eq;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Pointee;
 
@@ -165,6 +167,58 @@ TEST_F(MongoCodecImplTest, Reply) {
   decoder_.onData(output_);
 }
 
+TEST_F(MongoCodecImplTest, ReplyDocumentsDecodedOnDemand) {
+  ReplyMessageImpl reply(2, 2);
+  reply.numberReturned(2);
+  reply.documents().push_back(Bson::DocumentImpl::create()->addString("hello", "world"));
+  reply.documents().push_back(Bson::DocumentImpl::create()->addInt32("int32", 1));
+  EXPECT_EQ(2, reply.documentCount());
+  const uint64_t byte_size =
+      reply.documents().front()->byteSize() + reply.documents().back()->byteSize();
+  EXPECT_EQ(byte_size, reply.documentsByteSize());
+
+  encoder_.encodeReply(reply);
+  EXPECT_CALL(callbacks_, decodeReply_(_)).WillOnce(Invoke([&](ReplyMessagePtr& message) {
+    EXPECT_EQ(2, message->documentCount());
+    EXPECT_EQ(byte_size, message->documentsByteSize());
+    EXPECT_TRUE(reply == *message);
+    EXPECT_EQ(2, message->documentCount());
+    EXPECT_EQ(byte_size, message->documentsByteSize());
+  }));
+  decoder_.onData(output_);
+}
+
+TEST_F(MongoCodecImplTest, ReplyWithInvalidDocuments) {
+  Buffer::OwnedImpl reply;
+  Bson::BufferHelper::writeInt32(reply, 16 + 20 + 4);
+  Bson::BufferHelper::writeInt32(reply, 1);
+  Bson::BufferHelper::writeInt32(reply, 1);
+  Bson::BufferHelper::writeInt32(reply, static_cast<int32_t>(Message::OpCode::Reply));
+  Bson::BufferHelper::writeInt32(reply, 0);
+  Bson::BufferHelper::writeInt64(reply, 0);
+  Bson::BufferHelper::writeInt32(reply, 0);
+  Bson::BufferHelper::writeInt32(reply, 1);
+  // A document that claims to be longer than the reply.
+  Bson::BufferHelper::writeInt32(reply, 100);
+
+  // The documents are only validated when they are accessed.
+  EXPECT_CALL(callbacks_, decodeReply_(_)).WillOnce(Invoke([](ReplyMessagePtr& message) {
+    EXPECT_EQ(1, message->documentCount());
+    EXPECT_EQ(4, message->documentsByteSize());
+    EXPECT_THROW(message->documents(), EnvoyException);
+  }));
+  decoder_.onData(reply);
+  EXPECT_EQ(0, reply.length());
+
+  // The fixed fields of a reply are missing.
+  Bson::BufferHelper::writeInt32(reply, 16 + 4);
+  Bson::BufferHelper::writeInt32(reply, 1);
+  Bson::BufferHelper::writeInt32(reply, 1);
+  Bson::BufferHelper::writeInt32(reply, static_cast<int32_t>(Message::OpCode::Reply));
+  Bson::BufferHelper::writeInt32(reply, 0);
+  EXPECT_THROW(decoder_.onData(reply), EnvoyException);
+}
+
 TEST_F(MongoCodecImplTest, GetMoreEqual) {
   {
     GetMoreMessageImpl g1(0, 0);
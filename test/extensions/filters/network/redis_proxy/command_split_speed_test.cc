@@ -1,13 +1,16 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from a
 // quiescent system with disabled cstate power management.
 
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
@@ -82,6 +85,28 @@ public:
       single_mset.asArray()[2].asString() = request->asArray()[i + 1].asString();
     }
   }
+
+  class NoopDecoderCallbacks : public Common::Redis::DecoderCallbacks {
+  public:
+    void onRespValue(Common::Redis::RespValuePtr&& value) override { value_ = std::move(value); }
+
+    Common::Redis::RespValuePtr value_;
+  };
+
+  // Decodes the request, received in slices of the given size, as the proxy does.
+  void decode(const Buffer::Instance& encoded, uint64_t slice_size) {
+    Buffer::OwnedImpl data;
+    for (const Buffer::RawSlice& slice : encoded.getRawSlices()) {
+      for (uint64_t offset = 0; offset < slice.len_; offset += slice_size) {
+        data.appendSliceForTest(static_cast<const char*>(slice.mem_) + offset,
+                                std::min(slice_size, slice.len_ - offset));
+      }
+    }
+    NoopDecoderCallbacks callbacks;
+    Common::Redis::DecoderImpl decoder(callbacks);
+    decoder.decode(data);
+    benchmark::DoNotOptimize(callbacks.value_);
+  }
 };
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -129,3 +154,17 @@ static void BM_Split_CreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(BM_Split_CreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+static void BM_Decode_Mset(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedBulkStringArray(state.range(0), 36, state.range(1));
+  Envoy::Buffer::OwnedImpl encoded;
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  encoder.encode(*request, encoded);
+  for (auto _ : state) {
+    // Socket reads are typically returned in 16KiB slices.
+    context.decode(encoded, 16384);
+  }
+}
+BENCHMARK(BM_Decode_Mset)->Ranges({{1, 100}, {64, 8 << 14}});
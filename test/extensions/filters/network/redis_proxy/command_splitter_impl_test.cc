@@ -17,8 +17,10 @@
 #include "test/test_common/simulated_time_system.h"
 
 using testing::_;
+using testing::ByMove;
 using testing::DoAll;
 using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Property;
 using testing::Return;
@@ -482,6 +484,75 @@ TEST_F(RedisSingleServerRequestTest, EvalNoUpstream) {
   EXPECT_EQ(1UL, store_.counter("redis.foo.command.eval.error").value());
 };
 
+TEST_F(RedisSingleServerRequestTest, GetServedFromKeyCache) {
+  InSequence s;
+
+  NiceMock<MockKeyCache> key_cache;
+  ON_CALL(*route_, keyCache()).WillByDefault(Return(&key_cache));
+
+  Common::Redis::RespValue cached;
+  cached.type(Common::Redis::RespType::BulkString);
+  cached.asString() = "world";
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(key_cache, lookup("hello")).WillOnce(Invoke([&](const std::string&) {
+    return std::make_unique<Common::Redis::RespValue>(cached);
+  }));
+  EXPECT_CALL(*conn_pool_, makeRequest_(_, _, _)).Times(0);
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&cached)));
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"GET", "hello"});
+  handle_ = splitter_.makeRequest(std::move(request), callbacks_, dispatcher_);
+  EXPECT_EQ(nullptr, handle_);
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.get.total").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.get.success").value());
+};
+
+TEST_F(RedisSingleServerRequestTest, GetCachedOnKeyCacheMiss) {
+  InSequence s;
+
+  NiceMock<MockKeyCache> key_cache;
+  ON_CALL(*route_, keyCache()).WillByDefault(Return(&key_cache));
+
+  EXPECT_CALL(key_cache, lookup("hello")).WillOnce(Return(ByMove(nullptr)));
+  EXPECT_CALL(key_cache, generation()).WillOnce(Return(3));
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"get", "hello"});
+  makeRequest("hello", std::move(request));
+  EXPECT_NE(nullptr, handle_);
+
+  // The generation taken when the GET was sent lets the cache know whether the key was written
+  // since.
+  EXPECT_CALL(key_cache, insert("hello", _, 3));
+  respond();
+};
+
+TEST_F(RedisSingleServerRequestTest, WriteInvalidatesKeyCache) {
+  InSequence s;
+
+  NiceMock<MockKeyCache> key_cache;
+  ON_CALL(*route_, keyCache()).WillByDefault(Return(&key_cache));
+
+  // Commands other than GET are neither served from the cache nor cached, and writes remove their
+  // key from the cache before they are sent upstream.
+  EXPECT_CALL(key_cache, lookup(_)).Times(0);
+  EXPECT_CALL(key_cache, invalidate("hello"));
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"set", "hello", "world"});
+  makeRequest("hello", std::move(request));
+  EXPECT_NE(nullptr, handle_);
+
+  EXPECT_CALL(key_cache, insert(_, _, _)).Times(0);
+  respond();
+
+  EXPECT_CALL(key_cache, invalidate(_)).Times(0);
+  request = std::make_unique<Common::Redis::RespValue>();
+  makeBulkStringArray(*request, {"strlen", "hello"});
+  makeRequest("hello", std::move(request));
+  EXPECT_NE(nullptr, handle_);
+  respond();
+};
+
 MATCHER_P(CompositeArrayEq, rhs, "CompositeArray should be equal") {
   const ConnPool::RespVariant& obj = arg;
   const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
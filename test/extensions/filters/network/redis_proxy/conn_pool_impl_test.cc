@@ -82,11 +82,12 @@ public:
         std::make_shared<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>();
     auto redis_command_stats =
         Common::Redis::RedisCommandStats::createRedisCommandStats(store_.symbolTable());
+    auto settings = Common::Redis::Client::createConnPoolSettings(
+        20, hashtagging, true, max_unknown_conns, read_policy_);
+    settings.mutable_max_connections_per_host()->set_value(max_connections_per_host_);
     std::shared_ptr<InstanceImpl> conn_pool_impl = std::make_shared<InstanceImpl>(
-        cluster_name_, cm_, *this, tls_,
-        Common::Redis::Client::createConnPoolSettings(20, hashtagging, true, max_unknown_conns,
-                                                      read_policy_),
-        api_, store_.rootScope(), redis_command_stats, cluster_refresh_manager_, dns_cache);
+        cluster_name_, cm_, *this, tls_, settings, api_, store_.rootScope(), redis_command_stats,
+        cluster_refresh_manager_, dns_cache);
     conn_pool_impl->init();
     // Set the authentication password for this connection pool.
     conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().auth_username_ = auth_username_;
@@ -164,7 +165,8 @@ public:
     return conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().auth_password_;
   }
 
-  absl::node_hash_map<Upstream::HostConstSharedPtr, InstanceImpl::ThreadLocalActiveClientPtr>&
+  absl::node_hash_map<Upstream::HostConstSharedPtr,
+                      std::vector<InstanceImpl::ThreadLocalActiveClientPtr>>&
   clientMap() {
     InstanceImpl* conn_pool_impl = dynamic_cast<InstanceImpl*>(conn_pool_.get());
     return conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().client_map_;
@@ -172,7 +174,9 @@ public:
 
   InstanceImpl::ThreadLocalActiveClient* clientMap(Upstream::HostConstSharedPtr host) {
     InstanceImpl* conn_pool_impl = dynamic_cast<InstanceImpl*>(conn_pool_.get());
-    return conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().client_map_[host].get();
+    auto& clients =
+        conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().client_map_[host];
+    return clients.empty() ? nullptr : clients.front().get();
   }
 
   absl::node_hash_map<std::string, Upstream::HostConstSharedPtr>& hostAddressMap() {
@@ -310,6 +314,7 @@ public:
   envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ConnPoolSettings::ReadPolicy
       read_policy_ = envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::
           ConnPoolSettings::MASTER;
+  uint32_t max_connections_per_host_{1};
   NiceMock<Stats::MockCounter> upstream_cx_drained_;
   NiceMock<Stats::MockCounter> max_upstream_unknown_connections_reached_;
   std::shared_ptr<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>
@@ -692,6 +697,43 @@ TEST_F(RedisConnPoolImplTest, RemoteClose) {
   tls_.shutdownThread();
 }
 
+// Requests are sent on the client with the fewest pending requests, and a client is created while
+// all the clients are busy and there are fewer than max_connections_per_host.
+TEST_F(RedisConnPoolImplTest, MaxConnectionsPerHost) {
+  max_connections_per_host_ = 2;
+  setup();
+
+  Common::Redis::RespValueSharedPtr value = std::make_shared<Common::Redis::RespValue>();
+  MockPoolCallbacks callbacks;
+  Common::Redis::Client::MockPoolRequest active_request1, active_request2, active_request3;
+  Common::Redis::Client::MockClient* client1 = new NiceMock<Common::Redis::Client::MockClient>();
+  Common::Redis::Client::MockClient* client2 = new NiceMock<Common::Redis::Client::MockClient>();
+
+  makeRequest(client1, value, callbacks, active_request1);
+
+  EXPECT_CALL(*client1, pendingRequests()).WillRepeatedly(Return(1));
+  makeRequest(client2, value, callbacks, active_request2);
+  EXPECT_EQ(2, clientMap()[cm_.thread_local_cluster_.lb_.host_].size());
+
+  // The least busy client is used once there are max_connections_per_host clients.
+  EXPECT_CALL(*client2, pendingRequests()).WillRepeatedly(Return(2));
+  makeRequest(client1, value, callbacks, active_request3, false);
+  EXPECT_EQ(2, clientMap()[cm_.thread_local_cluster_.lb_.host_].size());
+
+  // A closed client is removed, and the other client of the host is kept. Closing the other client
+  // on shutdown deletes it too.
+  EXPECT_CALL(tls_.dispatcher_, deferredDelete_(_)).Times(2);
+  client1->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(clientMap(cm_.thread_local_cluster_.lb_.host_), client2->callbacks_.front());
+
+  EXPECT_CALL(active_request1, cancel());
+  EXPECT_CALL(active_request2, cancel());
+  EXPECT_CALL(active_request3, cancel());
+  EXPECT_CALL(callbacks, onFailure_()).Times(3);
+  EXPECT_CALL(*client2, close());
+  tls_.shutdownThread();
+}
+
 TEST_F(RedisConnPoolImplTest, MakeRequestToHost) {
   Common::Redis::RespValue value;
   Common::Redis::Client::MockPoolRequest active_request1;
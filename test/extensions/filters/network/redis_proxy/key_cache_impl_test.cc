@@ -0,0 +1,134 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/network/redis_proxy/key_cache_impl.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+class KeyCacheImplTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes::Route::KeyCache
+        config;
+    TestUtility::loadFromYaml(yaml, config);
+    cache_ = factory_.create(config);
+  }
+
+  static Common::Redis::RespValue bulkString(const std::string& value) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = value;
+    return response;
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "redis.foo.key_cache." + name)->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<ThreadLocal::MockInstance> tls_;
+  Stats::IsolatedStoreImpl store_;
+  KeyCacheFactory factory_{tls_, time_system_, *store_.rootScope(), "redis.foo."};
+  KeyCacheSharedPtr cache_;
+};
+
+TEST_F(KeyCacheImplTest, CachesUntilTtl) {
+  initialize("ttl: 10s");
+
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  cache_->insert("a", bulkString("value"), cache_->generation());
+  Common::Redis::RespValue null_response;
+  cache_->insert("b", null_response, cache_->generation());
+
+  Common::Redis::RespValuePtr response = cache_->lookup("a");
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ(bulkString("value"), *response);
+  response = cache_->lookup("b");
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ(Common::Redis::RespType::Null, response->type());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  EXPECT_EQ(2, counter("hit"));
+  EXPECT_EQ(2, counter("miss"));
+}
+
+TEST_F(KeyCacheImplTest, OnlyValuesAreCached) {
+  initialize("ttl: 10s");
+
+  Common::Redis::RespValue error;
+  error.type(Common::Redis::RespType::Error);
+  error.asString() = "MOVED 1 10.0.0.1:6379";
+  cache_->insert("a", error, cache_->generation());
+  Common::Redis::RespValue integer;
+  integer.type(Common::Redis::RespType::Integer);
+  cache_->insert("b", integer, cache_->generation());
+
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  EXPECT_EQ(nullptr, cache_->lookup("b"));
+}
+
+TEST_F(KeyCacheImplTest, Invalidate) {
+  initialize("ttl: 10s");
+
+  cache_->insert("a", bulkString("old"), cache_->generation());
+  const uint64_t generation = cache_->generation();
+  cache_->invalidate("a");
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  EXPECT_EQ(1, counter("invalidation"));
+
+  // The response to a GET sent before the invalidation may predate the write.
+  cache_->insert("a", bulkString("old"), generation);
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+
+  cache_->insert("a", bulkString("new"), cache_->generation());
+  EXPECT_EQ(bulkString("new"), *cache_->lookup("a"));
+}
+
+TEST_F(KeyCacheImplTest, EvictsLeastRecentlyUsedKeys) {
+  initialize(R"EOF(
+  ttl: 10s
+  max_entries_per_worker: 2
+  )EOF");
+
+  cache_->insert("a", bulkString("a"), cache_->generation());
+  cache_->insert("b", bulkString("b"), cache_->generation());
+  EXPECT_NE(nullptr, cache_->lookup("a"));
+  cache_->insert("c", bulkString("c"), cache_->generation());
+
+  EXPECT_NE(nullptr, cache_->lookup("a"));
+  EXPECT_EQ(nullptr, cache_->lookup("b"));
+  EXPECT_NE(nullptr, cache_->lookup("c"));
+}
+
+TEST_F(KeyCacheImplTest, StatsSharedByCaches) {
+  initialize("ttl: 10s");
+  KeyCacheSharedPtr first = cache_;
+  initialize("ttl: 10s");
+
+  first->insert("a", bulkString("a"), first->generation());
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  EXPECT_NE(nullptr, first->lookup("a"));
+  EXPECT_EQ(1, counter("hit"));
+  EXPECT_EQ(1, counter("miss"));
+}
+
+} // namespace
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -26,6 +26,9 @@ MockMirrorPolicy::MockMirrorPolicy(ConnPool::InstanceSharedPtr conn_pool)
   ON_CALL(*this, shouldMirror(_)).WillByDefault(Return(true));
 }
 
+MockKeyCache::MockKeyCache() = default;
+MockKeyCache::~MockKeyCache() = default;
+
 MockFaultManager::MockFaultManager() = default;
 MockFaultManager::MockFaultManager(const MockFaultManager&) {}
 MockFaultManager::~MockFaultManager() = default;
@@ -37,6 +37,7 @@ public:
 
   MOCK_METHOD(ConnPool::InstanceSharedPtr, upstream, (), (const));
   MOCK_METHOD(const MirrorPolicies&, mirrorPolicies, (), (const));
+  MOCK_METHOD(KeyCache*, keyCache, (), (const));
   ConnPool::InstanceSharedPtr conn_pool_;
   MirrorPolicies policies_;
 };
@@ -52,6 +53,19 @@ public:
   ConnPool::InstanceSharedPtr conn_pool_;
 };
 
+class MockKeyCache : public KeyCache {
+public:
+  MockKeyCache();
+  ~MockKeyCache() override;
+
+  MOCK_METHOD(Common::Redis::RespValuePtr, lookup, (const std::string& key));
+  MOCK_METHOD(uint64_t, generation, (), (const));
+  MOCK_METHOD(void, insert,
+              (const std::string& key, const Common::Redis::RespValue& response,
+               uint64_t generation));
+  MOCK_METHOD(void, invalidate, (const std::string& key));
+};
+
 class MockFaultManager : public Common::Redis::FaultManager {
 public:
   MockFaultManager();
@@ -3,12 +3,15 @@
 #include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
 #include "envoy/type/v3/percent.pb.h"
 
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
 
 #include "test/extensions/filters/network/common/redis/mocks.h"
 #include "test/extensions/filters/network/redis_proxy/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
 using testing::Eq;
@@ -193,6 +196,28 @@ TEST(PrefixRoutesTest, DuplicatePrefix) {
                             EnvoyException, "prefix `ab` already exists.")
 }
 
+TEST(PrefixRoutesTest, KeyCache) {
+  Upstreams upstreams;
+  upstreams.emplace("fake_clusterA", std::make_shared<ConnPool::MockInstance>());
+  upstreams.emplace("fake_clusterB", std::make_shared<ConnPool::MockInstance>());
+
+  Runtime::MockLoader runtime_;
+  NiceMock<ThreadLocal::MockInstance> tls;
+  Event::SimulatedTimeSystem time_system;
+  Stats::IsolatedStoreImpl store;
+  KeyCacheFactory key_cache_factory(tls, time_system, *store.rootScope(), "redis.foo.");
+
+  auto prefix_routes = createPrefixRoutes();
+  prefix_routes.mutable_routes(0)->mutable_key_cache()->mutable_ttl()->set_seconds(1);
+
+  PrefixRoutes router(prefix_routes, std::move(upstreams), runtime_, &key_cache_factory);
+
+  std::string cached_key("ab:bar");
+  EXPECT_NE(nullptr, router.upstreamPool(cached_key)->keyCache());
+  std::string key("a:bar");
+  EXPECT_EQ(nullptr, router.upstreamPool(key)->keyCache());
+}
+
 TEST(MirrorPolicyImplTest, ShouldMirrorDefault) {
   envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::PrefixRoutes::Route::
       RequestMirrorPolicy config;
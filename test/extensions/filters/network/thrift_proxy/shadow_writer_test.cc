@@ -16,6 +16,7 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/registry.h"
 
+#include "absl/strings/match.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -383,6 +384,52 @@ TEST_F(ShadowWriterTest, ShadowRequestWriteBeforePoolReady) {
       cluster_.cluster_.info_->statsScope().counterFromString("thrift.upstream_rq_call").value());
 }
 
+TEST_F(ShadowWriterTest, ShadowRequestPassthroughBeforePoolReady) {
+  Tcp::ConnectionPool::Callbacks* callbacks;
+
+  EXPECT_CALL(cm_, getThreadLocalCluster(_)).WillOnce(Return(&cluster_));
+  EXPECT_CALL(*cluster_.cluster_.info_, maintenanceMode()).WillOnce(Return(false));
+  EXPECT_CALL(cluster_, tcpConnPool(_, _))
+      .WillOnce(Return(Upstream::TcpPoolData([]() {}, &conn_pool_)));
+  EXPECT_CALL(conn_pool_, newConnection(_))
+      .WillOnce(
+          Invoke([&](Tcp::ConnectionPool::Callbacks& cb) -> Tcp::ConnectionPool::Cancellable* {
+            callbacks = &cb;
+            return &cancellable_;
+          }));
+
+  auto router_handle = shadow_writer_->submit("shadow_cluster", metadata_, TransportType::Framed,
+                                              ProtocolType::Binary);
+  EXPECT_NE(absl::nullopt, router_handle);
+
+  // The passthrough data is moved out of the caller's buffer until the connection is ready.
+  auto& request_owner = router_handle.value().get().requestOwner();
+  Buffer::OwnedImpl passthrough_data("payload");
+  EXPECT_EQ(FilterStatus::Continue, request_owner.transportBegin(nullptr));
+  EXPECT_EQ(FilterStatus::Continue, request_owner.passthroughData(passthrough_data));
+  EXPECT_EQ(0, passthrough_data.length());
+  EXPECT_EQ(FilterStatus::Continue, request_owner.messageEnd());
+  EXPECT_EQ(FilterStatus::Continue, request_owner.transportEnd());
+
+  NiceMock<Network::MockClientConnection> connection;
+  auto data = std::make_unique<NiceMock<Envoy::Tcp::ConnectionPool::MockConnectionData>>();
+  EXPECT_CALL(*data, connection()).WillRepeatedly(ReturnRef(connection));
+  EXPECT_CALL(*data, connectionState())
+      .WillRepeatedly(
+          Invoke([&]() -> Tcp::ConnectionPool::ConnectionState* { return conn_state_.get(); }));
+  EXPECT_CALL(*data, setConnectionState_(_))
+      .WillOnce(Invoke(
+          [&](Tcp::ConnectionPool::ConnectionStatePtr& cs) -> void { conn_state_.swap(cs); }));
+
+  EXPECT_CALL(connection, write(_, false)).WillOnce(Invoke([](Buffer::Instance& buffer, bool) {
+    EXPECT_TRUE(absl::EndsWith(buffer.toString(), "payload"));
+  }));
+  callbacks->onPoolReady(std::move(data), host_);
+
+  EXPECT_CALL(connection, close(_));
+  shadow_writer_ = nullptr;
+}
+
 TEST_F(ShadowWriterTest, ShadowRequestPoolFailure) {
   EXPECT_CALL(cm_, getThreadLocalCluster(_)).WillOnce(Return(&cluster_));
   EXPECT_CALL(*cluster_.cluster_.info_, maintenanceMode()).WillOnce(Return(false));
@@ -219,6 +219,33 @@ server_config:
             - "10.0.0.1"
 )EOF";
 
+  const std::string forward_query_with_answer_cache_config = R"EOF(
+stat_prefix: "my_prefix"
+client_config:
+  resolver_timeout: 1s
+  typed_dns_resolver_config:
+    name: envoy.network.dns_resolver.cares
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.network.dns_resolver.cares.v3.CaresDnsResolverConfig
+      resolvers:
+      - socket_address:
+          address: "1.1.1.1"
+          port_value: 53
+  max_pending_lookups: 1
+  answer_cache:
+    max_entries: 16
+    negative_ttl: 2s
+server_config:
+  inline_dns_table:
+    external_retry_count: 0
+    virtual_domains:
+      - name: "www.foo1.com"
+        endpoint:
+          address_list:
+            address:
+            - "10.0.0.1"
+)EOF";
+
   const std::string external_dns_table_config = R"EOF(
 stat_prefix: "my_prefix"
 client_config:
@@ -935,6 +962,97 @@ TEST_F(DnsFilterTest, ExternalResolutionReturnNoAddresses) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
 }
 
+TEST_F(DnsFilterTest, ExternalResolutionAnswerCached) {
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+
+  const std::string expected_address("130.207.244.251");
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_with_answer_cache_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success,
+             TestUtility::makeDnsResponse({expected_address}, std::chrono::seconds(6)));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The second query is answered from the cache, without a lookup.
+  EXPECT_CALL(*resolver_, resolve(_, _, _)).Times(0);
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(1, response_ctx_->answers_.size());
+  std::list<std::string> expected{expected_address};
+  for (const auto& answer : response_ctx_->answers_) {
+    EXPECT_EQ(answer.first, domain);
+    Utils::verifyAddress(expected, answer.second);
+  }
+  EXPECT_EQ(2, config_->stats().external_a_record_answers_.value());
+  EXPECT_EQ(1, config_->stats().external_answer_cache_hits_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // A query for another record type of the name is not answered from the cache.
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  const std::string aaaa_query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_AAAA, DNS_RECORD_CLASS_IN);
+  EXPECT_CALL(*resolver_, resolve(domain, Network::DnsLookupFamily::V6Only, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", aaaa_query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Failure, {});
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The answer expires with the TTL of its addresses.
+  simTime().advanceTimeWait(std::chrono::seconds(6));
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve(domain, Network::DnsLookupFamily::V4Only, _))
+      .WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_EQ(1, config_->stats().external_answer_cache_hits_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
+TEST_F(DnsFilterTest, ExternalResolutionNoAddressesCachedForNegativeTtl) {
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_with_answer_cache_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success, TestUtility::makeDnsResponse({}));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  EXPECT_CALL(*resolver_, resolve(_, _, _)).Times(0);
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NAME_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(0, response_ctx_->answers_.size());
+  EXPECT_EQ(1, config_->stats().external_answer_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().unanswered_queries_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  simTime().advanceTimeWait(std::chrono::seconds(2));
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve(domain, _, _)).WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
 TEST_F(DnsFilterTest, ExternalResolutionTimeout) {
   InSequence s;
 
@@ -0,0 +1,57 @@
+#include "source/common/common/hash.h"
+#include "source/extensions/http/cache/in_memory_http_cache/frequency_sketch.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+TEST(FrequencySketchTest, CountsOccurrences) {
+  FrequencySketch sketch(100);
+  const uint64_t hot = HashUtil::xxHash64("hot");
+  const uint64_t cold = HashUtil::xxHash64("cold");
+  EXPECT_EQ(0, sketch.frequency(hot));
+  for (uint32_t i = 1; i <= 5; ++i) {
+    sketch.record(hot);
+    EXPECT_EQ(i, sketch.frequency(hot));
+  }
+  sketch.record(cold);
+  EXPECT_EQ(1, sketch.frequency(cold));
+  EXPECT_EQ(5, sketch.frequency(hot));
+}
+
+TEST(FrequencySketchTest, Saturates) {
+  FrequencySketch sketch(100);
+  const uint64_t hash = HashUtil::xxHash64("key");
+  for (uint32_t i = 0; i < 2 * FrequencySketch::MAX_FREQUENCY; ++i) {
+    sketch.record(hash);
+  }
+  EXPECT_EQ(FrequencySketch::MAX_FREQUENCY, sketch.frequency(hash));
+}
+
+// The counters are halved once ten times the width of the sketch have been recorded, which is
+// 640 for the smallest sketch.
+TEST(FrequencySketchTest, Ages) {
+  FrequencySketch sketch(0);
+  const uint64_t hot = HashUtil::xxHash64("hot");
+  for (uint32_t i = 0; i < 10; ++i) {
+    sketch.record(hot);
+  }
+  for (uint32_t i = 0; i < 700; ++i) {
+    sketch.record(HashUtil::xxHash64(absl::StrCat("cold", i)));
+  }
+  EXPECT_LT(sketch.frequency(hot), 10);
+  EXPECT_GE(sketch.frequency(hot), 5);
+}
+
+} // namespace
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
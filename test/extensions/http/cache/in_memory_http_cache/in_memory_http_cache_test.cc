@@ -0,0 +1,193 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+#include "test/extensions/filters/http/cache/common.h"
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+class InMemoryHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  InMemoryHttpCacheTestDelegate() {
+    config_.set_max_cache_size_bytes(16 * 1024 * 1024);
+    cache_ = std::make_shared<InMemoryHttpCache>(nullptr, config_, *store_.rootScope());
+  }
+
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  ConfigProto config_;
+  std::shared_ptr<InMemoryHttpCache> cache_;
+};
+
+INSTANTIATE_TEST_SUITE_P(InMemoryHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<InMemoryHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "InMemoryHttpCache";
+                         });
+
+envoy::extensions::filters::http::cache::v3::CacheConfig cacheConfig(const ConfigProto& config) {
+  envoy::extensions::filters::http::cache::v3::CacheConfig cache_config;
+  cache_config.mutable_typed_config()->PackFrom(config);
+  return cache_config;
+}
+
+TEST(Registration, GetFactory) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.in_memory_http_cache.v3.InMemoryHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  ConfigProto config;
+  config.set_max_cache_size_bytes(1024 * 1024);
+  std::shared_ptr<HttpCache> cache = factory->getCache(cacheConfig(config), factory_context);
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.in_memory");
+
+  // Equal configs share a cache.
+  EXPECT_EQ(cache, factory->getCache(cacheConfig(config), factory_context));
+  config.mutable_shard_count()->set_value(4);
+  EXPECT_NE(cache, factory->getCache(cacheConfig(config), factory_context));
+
+  config.set_max_cache_size_bytes(0);
+  EXPECT_THROW(factory->getCache(cacheConfig(config), factory_context), EnvoyException);
+}
+
+TEST(InMemoryHttpCacheTest, MaxEntrySize) {
+  Stats::IsolatedStoreImpl store;
+  ConfigProto config;
+  config.set_max_cache_size_bytes(16000);
+  // Bounded by the main area of a shard.
+  EXPECT_EQ(990, InMemoryHttpCache(nullptr, config, *store.rootScope()).maxEntrySize());
+
+  config.mutable_max_entry_size_bytes()->set_value(100);
+  InMemoryHttpCache cache(nullptr, config, *store.rootScope());
+  EXPECT_EQ(100, cache.maxEntrySize());
+  EXPECT_TRUE(cache.checkEntrySize(100));
+  EXPECT_FALSE(cache.checkEntrySize(101));
+  EXPECT_EQ(1, cache.stats().entries_too_large_.value());
+}
+
+// A shard of 10000 bytes has a window of 100 bytes, so entries of 1000 bytes go to the main area
+// as soon as they are inserted, until it holds 9 of them.
+class CacheShardTest : public testing::Test {
+public:
+  CacheShardTest()
+      : stats_{ALL_IN_MEMORY_CACHE_STATS(POOL_COUNTER(*store_.rootScope()),
+                                         POOL_GAUGE(*store_.rootScope()))},
+        shard_(10000, stats_) {}
+
+  static Key key(int i) {
+    Key key;
+    key.set_path(absl::StrCat("/", i));
+    return key;
+  }
+
+  void insert(int i) {
+    shard_.insert(key(i), MessageUtil::hash(key(i)),
+                  CacheEntry{Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                                 {{Http::Headers::get().Status, "200"}}),
+                             {},
+                             std::make_shared<const std::string>("body"),
+                             nullptr},
+                  1000);
+  }
+
+  bool lookup(int i) {
+    return shard_.lookup(key(i), MessageUtil::hash(key(i))).response_headers_ != nullptr;
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  CacheStats stats_;
+  CacheShard shard_;
+};
+
+TEST_F(CacheShardTest, LookupSharesBody) {
+  insert(0);
+  const CacheEntry entry = shard_.lookup(key(0), MessageUtil::hash(key(0)));
+  ASSERT_NE(nullptr, entry.response_headers_);
+  EXPECT_EQ("200", entry.response_headers_->getStatusValue());
+  EXPECT_EQ(entry.body_, shard_.lookup(key(0), MessageUtil::hash(key(0))).body_);
+  EXPECT_EQ(1000, stats_.size_bytes_.value());
+  EXPECT_EQ(1, stats_.size_count_.value());
+  EXPECT_FALSE(lookup(1));
+}
+
+TEST_F(CacheShardTest, ReplaceEntry) {
+  insert(0);
+  insert(0);
+  EXPECT_TRUE(lookup(0));
+  EXPECT_EQ(1000, stats_.size_bytes_.value());
+  EXPECT_EQ(1, stats_.size_count_.value());
+}
+
+TEST_F(CacheShardTest, RejectsUnpopularEntries) {
+  for (int i = 0; i < 9; ++i) {
+    insert(i);
+  }
+  EXPECT_EQ(9, stats_.size_count_.value());
+
+  // Never requested, so not more popular than the entries it would replace.
+  insert(9);
+  EXPECT_EQ(1, stats_.admission_rejections_.value());
+  EXPECT_FALSE(lookup(9));
+
+  // Requested twice now, so it replaces the least recently used entry.
+  EXPECT_FALSE(lookup(9));
+  insert(9);
+  EXPECT_EQ(1, stats_.evictions_.value());
+  EXPECT_TRUE(lookup(9));
+  EXPECT_FALSE(lookup(0));
+  EXPECT_EQ(9, stats_.size_count_.value());
+  EXPECT_EQ(9000, stats_.size_bytes_.value());
+}
+
+TEST_F(CacheShardTest, ProtectsHitEntries) {
+  for (int i = 0; i < 9; ++i) {
+    insert(i);
+  }
+  // The least recently used entry is hit, so the next one is replaced instead.
+  EXPECT_TRUE(lookup(0));
+  EXPECT_FALSE(lookup(9));
+  EXPECT_FALSE(lookup(9));
+  insert(9);
+  EXPECT_TRUE(lookup(0));
+  EXPECT_FALSE(lookup(1));
+  EXPECT_TRUE(lookup(9));
+}
+
+TEST_F(CacheShardTest, UpdateHeaders) {
+  EXPECT_FALSE(shard_.updateHeaders(key(0), Http::TestResponseHeaderMapImpl{{"age", "1"}}, {}));
+  insert(0);
+  ASSERT_TRUE(shard_.updateHeaders(
+      key(0), Http::TestResponseHeaderMapImpl{{":status", "200"}, {"x-update", "updated"}}, {}));
+  const CacheEntry entry = shard_.lookup(key(0), MessageUtil::hash(key(0)));
+  ASSERT_NE(nullptr, entry.response_headers_);
+  EXPECT_EQ("updated", entry.response_headers_->get(Http::LowerCaseString("x-update"))[0]
+                           ->value()
+                           .getStringView());
+  EXPECT_LT(1000, stats_.size_bytes_.value());
+}
+
+} // namespace
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,152 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/cache/cache_custom_headers.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "test/extensions/filters/http/cache/common.h"
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+// Backs the tiered cache with another in-memory cache, so that the tests don't touch the disk.
+class TieredHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  TieredHttpCacheTestDelegate() {
+    InMemoryHttpCache::ConfigProto memory_config;
+    memory_config.set_max_cache_size_bytes(16 * 1024 * 1024);
+    cache_ = std::make_shared<TieredHttpCache>(
+        nullptr, config_,
+        std::make_shared<InMemoryHttpCache::InMemoryHttpCache>(nullptr, memory_config,
+                                                               *memory_store_.rootScope()),
+        std::make_shared<InMemoryHttpCache::InMemoryHttpCache>(nullptr, memory_config,
+                                                               *backing_store_.rootScope()),
+        time_system_, *store_.rootScope());
+  }
+
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+  TieredHttpCache& tieredCache() { return *cache_; }
+
+private:
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  Stats::IsolatedStoreImpl memory_store_;
+  Stats::IsolatedStoreImpl backing_store_;
+  ConfigProto config_;
+  std::shared_ptr<TieredHttpCache> cache_;
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+class TieredHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  TieredHttpCache& tieredCache() {
+    return static_cast<TieredHttpCacheTestDelegate&>(*delegate_).tieredCache();
+  }
+
+  Http::TestResponseHeaderMapImpl responseHeaders() {
+    return {{":status", "200"},
+            {"date", formatter_.fromTime(time_system_.systemTime())},
+            {"cache-control", "public,max-age=3600"}};
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, TieredHttpCacheTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>));
+
+TEST_P(TieredHttpCacheTest, PromotesRepeatedlyRequestedResponses) {
+  const std::string body("Value");
+  // The lookup preceding the insert is the first request.
+  ASSERT_TRUE(insert("/name", responseHeaders(), body).ok());
+  EXPECT_EQ(0, tieredCache().stats().promotions_.value());
+
+  // The second request is served from the backing tier, and promotes the response.
+  LookupContextPtr lookup_context = lookup("/name");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(lookup_context.get(), body));
+  EXPECT_EQ(1, tieredCache().stats().promotions_.value());
+  EXPECT_EQ(0, tieredCache().stats().memory_tier_hits_.value());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  lookup_context = lookup("/name");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(lookup_context.get(), body));
+  EXPECT_EQ("10", lookup_result_.headers_->getInlineValue(CacheCustomHeaders::age()));
+  EXPECT_EQ(1, tieredCache().stats().memory_tier_hits_.value());
+}
+
+TEST_P(TieredHttpCacheTest, ReinsertReplacesPromotedResponse) {
+  ASSERT_TRUE(insert("/name", responseHeaders(), "Value").ok());
+  LookupContextPtr lookup_context = lookup("/name");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(lookup_context.get(), "Value"));
+  EXPECT_EQ(1, tieredCache().stats().promotions_.value());
+
+  ASSERT_TRUE(insert(std::move(lookup_context), responseHeaders(), "NewValue").ok());
+  lookup_context = lookup("/name");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(lookup_context.get(), "NewValue"));
+  EXPECT_EQ(0, tieredCache().stats().memory_tier_hits_.value());
+}
+
+TEST_P(TieredHttpCacheTest, DoesNotPromotePartialReads) {
+  ASSERT_TRUE(insert("/name", responseHeaders(), "Value").ok());
+  LookupContextPtr lookup_context = lookup("/name");
+  EXPECT_EQ("Val", getBody(*lookup_context, 0, 3));
+  EXPECT_EQ(0, tieredCache().stats().promotions_.value());
+}
+
+envoy::extensions::filters::http::cache::v3::CacheConfig cacheConfig(const ConfigProto& config) {
+  envoy::extensions::filters::http::cache::v3::CacheConfig cache_config;
+  cache_config.mutable_typed_config()->PackFrom(config);
+  return cache_config;
+}
+
+TEST(Registration, GetFactory) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.tiered_http_cache.v3.TieredHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  ConfigProto config;
+  config.mutable_memory_tier()->set_max_cache_size_bytes(1024 * 1024);
+  InMemoryHttpCache::ConfigProto backing_config;
+  backing_config.set_max_cache_size_bytes(16 * 1024 * 1024);
+  config.mutable_backing_tier()->PackFrom(backing_config);
+  std::shared_ptr<HttpCache> cache = factory->getCache(cacheConfig(config), factory_context);
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.tiered");
+
+  // Equal configs share a cache.
+  EXPECT_EQ(cache, factory->getCache(cacheConfig(config), factory_context));
+  config.mutable_min_requests_to_promote()->set_value(4);
+  EXPECT_NE(cache, factory->getCache(cacheConfig(config), factory_context));
+
+  // The backing tier must be a registered cache.
+  config.mutable_backing_tier()->PackFrom(ProtobufWkt::Empty());
+  EXPECT_THROW_WITH_REGEX(factory->getCache(cacheConfig(config), factory_context), EnvoyException,
+                          "Didn't find a registered implementation");
+}
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -185,6 +185,18 @@ TEST_F(PathNormalizerTest, NormalizePathUriRootPreserveFragment) {
   EXPECT_TRUE(result.ok());
 }
 
+TEST_F(PathNormalizerTest, NormalizePathUriAlreadyNormalizedNotRewritten) {
+  ::Envoy::Http::TestRequestHeaderMapImpl headers{{":path", "/root/child?x=1#anchor"}};
+  const char* original_data = headers.Path()->value().getStringView().data();
+
+  auto normalizer = create(empty_config);
+  auto result = normalizer->normalizePathUri(headers);
+
+  EXPECT_EQ(headers.Path()->value().getStringView().data(), original_data);
+  EXPECT_EQ(headers.path(), "/root/child?x=1#anchor");
+  EXPECT_TRUE(result.ok());
+}
+
 TEST_F(PathNormalizerTest, NormalizePathUriDotDot) {
   ::Envoy::Http::TestRequestHeaderMapImpl headers{{":path", "/dir1/../dir2"}};
 
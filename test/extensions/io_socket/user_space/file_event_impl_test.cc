@@ -113,6 +113,59 @@ TEST_F(FileEventImplTest, ReadEventIsTriggeredWhenThePeerSetWriteEnd) {
   }
 }
 
+TEST_F(FileEventImplTest, EventsActivatedByPeerDeliveredInNextIteration) {
+  setReadable();
+  MockReadyCb peer_ready_cb;
+  auto peer_file_event = std::make_unique<FileEventImpl>(
+      *dispatcher_, [&peer_ready_cb](uint32_t arg) { peer_ready_cb.called(arg); }, 0, io_source_);
+  peer_file_event->setEnabled(Event::FileReadyType::Read);
+  EXPECT_CALL(peer_ready_cb, called(Event::FileReadyType::Read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&peer_ready_cb);
+
+  // An event activated by a callback is delivered once the dispatcher polls again.
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read));
+  EXPECT_CALL(peer_ready_cb, called(Event::FileReadyType::Read)).Times(0);
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_,
+      [this, &peer_file_event](uint32_t arg) {
+        ready_cb_.called(arg);
+        peer_file_event->activateIfEnabled(Event::FileReadyType::Read);
+      },
+      Event::FileReadyType::Read, io_source_);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&peer_ready_cb);
+
+  EXPECT_CALL(peer_ready_cb, called(Event::FileReadyType::Read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
+TEST_F(FileEventImplTest, EventsActivatedByPeerDeliveredInCurrentIteration) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.user_space_events_in_current_iteration", "true"}});
+  setReadable();
+  MockReadyCb peer_ready_cb;
+  auto peer_file_event = std::make_unique<FileEventImpl>(
+      *dispatcher_, [&peer_ready_cb](uint32_t arg) { peer_ready_cb.called(arg); }, 0, io_source_);
+  peer_file_event->setEnabled(Event::FileReadyType::Read);
+  EXPECT_CALL(peer_ready_cb, called(Event::FileReadyType::Read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&peer_ready_cb);
+
+  // The peer reads the data in the iteration it was written.
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read));
+  EXPECT_CALL(peer_ready_cb, called(Event::FileReadyType::Read));
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_,
+      [this, &peer_file_event](uint32_t arg) {
+        ready_cb_.called(arg);
+        peer_file_event->activateIfEnabled(Event::FileReadyType::Read);
+      },
+      Event::FileReadyType::Read, io_source_);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
 TEST_F(FileEventImplTest, ReadEventNotDeliveredAfterDisabledRead) {
   setWritable();
   setReadable();
@@ -149,6 +149,22 @@ TEST_F(KeyValueStoreTest, Persist) {
   EXPECT_FALSE(store_->get("bar").has_value());
 }
 
+TEST_F(KeyValueStoreTest, PeriodicFlushSkipsUnchangedStore) {
+  store_->addOrUpdate("foo", "bar", absl::nullopt);
+  flush_timer_->invokeCallback(); // flush
+  EXPECT_TRUE(Filesystem::fileSystemForTest().fileExists(filename_));
+
+  // Nothing changed, so the next periodic flush does not rewrite the file.
+  TestEnvironment::removePath(filename_);
+  flush_timer_->invokeCallback();
+  EXPECT_FALSE(Filesystem::fileSystemForTest().fileExists(filename_));
+  EXPECT_TRUE(flush_timer_->enabled_);
+
+  store_->remove("foo");
+  flush_timer_->invokeCallback(); // flush
+  EXPECT_TRUE(Filesystem::fileSystemForTest().fileExists(filename_));
+}
+
 TEST_F(KeyValueStoreTest, PersistWithTTL) {
   test_time_.setSystemTime(std::chrono::milliseconds(0));
   store_->addOrUpdate("foo", "bar", std::chrono::seconds(2));
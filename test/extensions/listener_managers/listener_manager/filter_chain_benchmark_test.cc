@@ -175,6 +175,22 @@ const char YamlSingleServer[] = R"EOF(
           session_ticket_keys:
             keys:
             - filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ticket_key_a")EOF";
+const char YamlSingleWildcardServerTop[] = R"EOF(
+    - filter_chain_match:
+        server_names: "*.server)EOF";
+const char YamlSingleWildcardServerBottom[] = R"EOF(.example.com"
+        transport_protocol: "tls"
+      transport_socket:
+        name: "envoy.transport_sockets.tls"
+        typed_config:
+          "@type": "type.googleapis.com/envoy.extensions.transport_sockets.tls.v3.DownstreamTlsContext"
+          common_tls_context:
+            tls_certificates:
+              - certificate_chain: { filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_cert.pem" }
+                private_key: { filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_key.pem" }
+          session_ticket_keys:
+            keys:
+            - filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ticket_key_a")EOF";
 const char YamlSingleDstPortTop[] = R"EOF(
     - filter_chain_match:
         destination_port: )EOF";
@@ -208,6 +224,21 @@ public:
     filter_chains_ = listener_config_.filter_chains();
   }
 
+  void initializeServerNames(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> server_chains;
+    server_chains.reserve(input_size);
+    for (int i = 0; i < input_size; i++) {
+      server_chains.push_back(
+          absl::StrCat(YamlSingleWildcardServerTop, i, YamlSingleWildcardServerBottom));
+    }
+    listener_yaml_config_ = TestEnvironment::substitute(
+        absl::StrCat(YamlHeader, absl::StrJoin(server_chains, "")),
+        Network::Address::IpVersion::v4);
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   Logger::Context logging_state_{spdlog::level::warn, Logger::Logger::DEFAULT_LOG_FORMAT, lock_,
                                  false};
@@ -267,6 +298,37 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// Finds filter chains by wildcard server names, which are matched after the exact server name.
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int i = 0; i < state.range(0); i++) {
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        443, "127.0.0.1", absl::StrCat("www.server", i, ".example.com"), "", "tls", {}, "8.8.8.8",
+        111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+
+  filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr, dummy_builder_,
+                                       filter_chain_manager);
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i], stream_info);
+    }
+  }
+}
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
@@ -279,6 +341,12 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         {1, 4096},
     })
     ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 4096},
+    })
+    ->Unit(::benchmark::kMillisecond);
 
 /*
 clang-format off
@@ -6436,6 +6436,36 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, MptcpNotSupported) {
       "listener mptcp-udp: enable_mptcp is set but MPTCP is not supported by the operating system");
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortCpuSteeringWithoutReusePort) {
+  envoy::config::listener::v3::Listener listener = parseListenerFromV3Yaml(R"EOF(
+      name: steering
+      enable_reuse_port: false
+      enable_reuse_port_cpu_steering: true
+      address:
+        socket_address:
+          address: 127.0.0.1
+          port_value: 1111
+      filter_chains:
+      - filters: []
+        name: foo
+    )EOF");
+  EXPECT_THROW_WITH_MESSAGE(
+      addOrUpdateListener(listener), EnvoyException,
+      "listener steering: enable_reuse_port_cpu_steering requires reuse_port to be enabled");
+}
+
+TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortCpuSteeringOnInternalListener) {
+  envoy::config::listener::v3::Listener listener = parseListenerFromV3Yaml(R"EOF(
+      name: steering
+      enable_reuse_port_cpu_steering: true
+      internal_listener: {}
+      filter_chains:
+      - filters: []
+        name: foo
+    )EOF");
+  EXPECT_THROW(addOrUpdateListener(listener), EnvoyException);
+}
+
 // Set the resolver to the default IP resolver. The address resolver logic is unit tested in
 // resolver_impl_test.cc.
 TEST_P(ListenerManagerImplWithRealFiltersTest, AddressResolver) {
@@ -7837,6 +7867,40 @@ TEST_P(ListenerManagerImplTest, TcpBacklogCustomConfig) {
   EXPECT_EQ(100U, manager_->listeners().back().get().tcpBacklogSize());
 }
 
+TEST_P(ListenerManagerImplTest, MaxConnectionsToAcceptPerSocketEvent) {
+  const std::string yaml = TestEnvironment::substitute(R"EOF(
+    name: MaxConnectionsToAcceptListener
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1111 }
+    max_connections_to_accept_per_socket_event: 4
+    filter_chains:
+    - filters:
+  )EOF",
+                                                       Network::Address::IpVersion::v4);
+
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _, _, _));
+  addOrUpdateListener(parseListenerFromV3Yaml(yaml));
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_EQ(4U, manager_->listeners().back().get().maxConnectionsToAcceptPerSocketEvent());
+}
+
+TEST_P(ListenerManagerImplTest, MaxConnectionsToAcceptPerSocketEventDefault) {
+  const std::string yaml = TestEnvironment::substitute(R"EOF(
+    name: MaxConnectionsToAcceptListener
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1111 }
+    filter_chains:
+    - filters:
+  )EOF",
+                                                       Network::Address::IpVersion::v4);
+
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _, _, _));
+  addOrUpdateListener(parseListenerFromV3Yaml(yaml));
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_EQ(Network::DefaultMaxConnectionsToAcceptPerSocketEvent,
+            manager_->listeners().back().get().maxConnectionsToAcceptPerSocketEvent());
+}
+
 TEST_P(ListenerManagerImplTest, WorkersStartedCallbackCalled) {
   InSequence s;
 
@@ -0,0 +1,202 @@
+#include <chrono>
+
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/mocks/upstream/priority_set.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+namespace {
+
+using testing::NiceMock;
+
+TEST(OrcaLoadReportTest, Parse) {
+  OrcaLoadReport report;
+  EXPECT_TRUE(OrcaLoadReport::parse(
+      "TEXT cpu_utilization=0.5, application_utilization=0.25,rps_fractional=10, eps=2", report));
+  EXPECT_DOUBLE_EQ(0.5, report.cpu_utilization_);
+  EXPECT_DOUBLE_EQ(0.25, report.application_utilization_);
+  EXPECT_DOUBLE_EQ(10, report.rps_fractional_);
+  EXPECT_DOUBLE_EQ(2, report.eps_);
+}
+
+TEST(OrcaLoadReportTest, ParseSkipsOtherMetrics) {
+  OrcaLoadReport report;
+  EXPECT_TRUE(
+      OrcaLoadReport::parse("TEXT named_metrics.foo=3, mem_utilization=0.7, qps=4", report));
+  EXPECT_DOUBLE_EQ(0, report.cpu_utilization_);
+  EXPECT_DOUBLE_EQ(0, report.rps_fractional_);
+}
+
+TEST(OrcaLoadReportTest, ParseFailures) {
+  OrcaLoadReport report;
+  EXPECT_FALSE(OrcaLoadReport::parse("JSON {\"cpu_utilization\": 0.5}", report));
+  EXPECT_FALSE(OrcaLoadReport::parse("TEXT cpu_utilization", report));
+  EXPECT_FALSE(OrcaLoadReport::parse("TEXT cpu_utilization=high", report));
+  EXPECT_FALSE(OrcaLoadReport::parse("TEXT cpu_utilization=-1", report));
+}
+
+class OrcaWeightHostDataTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  OrcaWeightHostData data_{simTime(), 1.0, std::chrono::seconds(10), std::chrono::minutes(3)};
+};
+
+TEST_F(OrcaWeightHostDataTest, Weight) {
+  EXPECT_DOUBLE_EQ(0, data_.weight(simTime().monotonicTime()));
+
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10, eps=5");
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  // 10 / (0.5 + 5 / 10 * 1.0)
+  EXPECT_DOUBLE_EQ(10, data_.weight(simTime().monotonicTime()));
+
+  // Application utilization takes precedence over CPU utilization.
+  data_.onLoadReport("TEXT cpu_utilization=0.5, application_utilization=0.1, rps_fractional=10");
+  EXPECT_DOUBLE_EQ(100, data_.weight(simTime().monotonicTime()));
+}
+
+TEST_F(OrcaWeightHostDataTest, IgnoresUnusableReports) {
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10");
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+
+  data_.onLoadReport("TEXT rps_fractional=10");
+  data_.onLoadReport("TEXT cpu_utilization=0.5");
+  data_.onLoadReport("cpu_utilization=0.1, rps_fractional=10");
+  EXPECT_DOUBLE_EQ(20, data_.weight(simTime().monotonicTime()));
+}
+
+TEST_F(OrcaWeightHostDataTest, BlackoutPeriod) {
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10");
+  simTime().advanceTimeWait(std::chrono::seconds(9));
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10");
+  EXPECT_DOUBLE_EQ(0, data_.weight(simTime().monotonicTime()));
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(20, data_.weight(simTime().monotonicTime()));
+}
+
+TEST_F(OrcaWeightHostDataTest, WeightExpiration) {
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10");
+  simTime().advanceTimeWait(std::chrono::minutes(3));
+  EXPECT_DOUBLE_EQ(0, data_.weight(simTime().monotonicTime()));
+
+  // Reports after the weight expired start a new blackout period.
+  data_.onLoadReport("TEXT cpu_utilization=0.5, rps_fractional=10");
+  EXPECT_DOUBLE_EQ(0, data_.weight(simTime().monotonicTime()));
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_DOUBLE_EQ(20, data_.weight(simTime().monotonicTime()));
+}
+
+class ClientSideWeightedRoundRobinLoadBalancerTest : public Event::TestUsingSimulatedTime,
+                                                     public testing::Test {
+protected:
+  ClientSideWeightedRoundRobinLoadBalancerTest()
+      : stat_names_(stats_store_.symbolTable()), stats_(stat_names_, *stats_store_.rootScope()) {
+    config_.mutable_blackout_period()->set_seconds(0);
+  }
+
+  void init(uint32_t num_hosts) {
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      host_set_.healthy_hosts_.push_back(
+          Upstream::makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 80 + i), simTime()));
+    }
+    host_set_.hosts_ = host_set_.healthy_hosts_;
+    lb_ = std::make_unique<ClientSideWeightedRoundRobinLoadBalancer>(
+        priority_set_, nullptr, stats_, runtime_, random_, 50, config_, simTime());
+    // The first pick installs the load report state of the hosts.
+    lb_->chooseHost(nullptr);
+  }
+
+  void report(uint32_t index, absl::string_view report) {
+    host_set_.healthy_hosts_[index]->lbPolicyData()->onLoadReport(report);
+  }
+
+  absl::flat_hash_map<Upstream::HostConstSharedPtr, uint32_t> pick(uint32_t count) {
+    absl::flat_hash_map<Upstream::HostConstSharedPtr, uint32_t> picks;
+    for (uint32_t i = 0; i < count; ++i) {
+      ++picks[lb_->chooseHost(nullptr)];
+    }
+    return picks;
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  Upstream::ClusterLbStatNames stat_names_;
+  Upstream::ClusterLbStats stats_;
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Upstream::MockPrioritySet> priority_set_;
+  Upstream::MockHostSet& host_set_ = *priority_set_.getMockHostSet(0);
+  std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+  envoy::extensions::load_balancing_policies::client_side_weighted_round_robin::v3::
+      ClientSideWeightedRoundRobin config_;
+  std::unique_ptr<ClientSideWeightedRoundRobinLoadBalancer> lb_;
+};
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, NoHosts) {
+  init(0);
+
+  EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr));
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, RoundRobinWithoutReports) {
+  init(2);
+
+  auto picks = pick(10);
+  EXPECT_EQ(5, picks[host_set_.healthy_hosts_[0]]);
+  EXPECT_EQ(5, picks[host_set_.healthy_hosts_[1]]);
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, WeighsHostsByReportedLoad) {
+  init(2);
+  report(0, "TEXT cpu_utilization=0.1, rps_fractional=30");
+  report(1, "TEXT cpu_utilization=0.1, rps_fractional=10");
+
+  // Weights only change once the weight update period elapsed.
+  auto picks = pick(10);
+  EXPECT_EQ(5, picks[host_set_.healthy_hosts_[0]]);
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  picks = pick(400);
+  EXPECT_NEAR(300, picks[host_set_.healthy_hosts_[0]], 2);
+  EXPECT_NEAR(100, picks[host_set_.healthy_hosts_[1]], 2);
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, HostsWithoutReportsGetMeanWeight) {
+  init(3);
+  report(0, "TEXT cpu_utilization=0.1, rps_fractional=30");
+  report(1, "TEXT cpu_utilization=0.1, rps_fractional=10");
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  auto picks = pick(600);
+  EXPECT_NEAR(300, picks[host_set_.healthy_hosts_[0]], 2);
+  EXPECT_NEAR(100, picks[host_set_.healthy_hosts_[1]], 2);
+  EXPECT_NEAR(200, picks[host_set_.healthy_hosts_[2]], 2);
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, ExpiredWeightsAreIgnored) {
+  init(2);
+  report(0, "TEXT cpu_utilization=0.1, rps_fractional=30");
+  report(1, "TEXT cpu_utilization=0.1, rps_fractional=10");
+
+  simTime().advanceTimeWait(std::chrono::minutes(3));
+  auto picks = pick(10);
+  EXPECT_EQ(5, picks[host_set_.healthy_hosts_[0]]);
+  EXPECT_EQ(5, picks[host_set_.healthy_hosts_[1]]);
+}
+
+} // namespace
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,185 @@
+#include <chrono>
+#include <cmath>
+
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/mocks/upstream/priority_set.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+namespace {
+
+using testing::NiceMock;
+using testing::Return;
+
+class PeakEwmaHostDataTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  PeakEwmaHostData data_{simTime(), std::chrono::seconds(10), std::chrono::milliseconds(30)};
+};
+
+TEST_F(PeakEwmaHostDataTest, DefaultLatencyDecays) {
+  EXPECT_DOUBLE_EQ(30000, data_.latency(simTime().monotonicTime()));
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_DOUBLE_EQ(30000 * std::exp(-1.0), data_.latency(simTime().monotonicTime()));
+}
+
+TEST_F(PeakEwmaHostDataTest, SlowResponsesArePickedUpImmediately) {
+  data_.onResponseTime(std::chrono::milliseconds(100));
+  EXPECT_DOUBLE_EQ(100000, data_.latency(simTime().monotonicTime()));
+}
+
+TEST_F(PeakEwmaHostDataTest, FastResponsesAreAveraged) {
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  data_.onResponseTime(std::chrono::milliseconds(10));
+
+  const double weight = std::exp(-1.0);
+  EXPECT_DOUBLE_EQ(30000 * weight + 10000 * (1 - weight),
+                   data_.latency(simTime().monotonicTime()));
+}
+
+class PeakEwmaLoadBalancerTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  PeakEwmaLoadBalancerTest()
+      : stat_names_(stats_store_.symbolTable()), stats_(stat_names_, *stats_store_.rootScope()) {}
+
+  void init() {
+    lb_ = std::make_unique<PeakEwmaLoadBalancer>(priority_set_, nullptr, stats_, runtime_, random_,
+                                                 50, config_, simTime());
+  }
+
+  void addHosts(uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      host_set_.healthy_hosts_.push_back(
+          Upstream::makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 80 + i), simTime()));
+    }
+    host_set_.hosts_ = host_set_.healthy_hosts_;
+    host_set_.runCallbacks({}, {});
+  }
+
+  PeakEwmaHostData& hostData(uint32_t index) {
+    const Upstream::HostSharedPtr& host = host_set_.healthy_hosts_[index];
+    if (host->lbPolicyData() == nullptr) {
+      host->setLbPolicyData(std::make_unique<PeakEwmaHostData>(
+          simTime(), std::chrono::seconds(10), std::chrono::milliseconds(30)));
+    }
+    return static_cast<PeakEwmaHostData&>(*host->lbPolicyData());
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  Upstream::ClusterLbStatNames stat_names_;
+  Upstream::ClusterLbStats stats_;
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Upstream::MockPrioritySet> priority_set_;
+  Upstream::MockHostSet& host_set_ = *priority_set_.getMockHostSet(0);
+  std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+  envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma config_;
+  std::unique_ptr<PeakEwmaLoadBalancer> lb_;
+};
+
+TEST_F(PeakEwmaLoadBalancerTest, NoHosts) {
+  init();
+
+  EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, InstallsHostData) {
+  init();
+  addHosts(2);
+
+  EXPECT_NE(nullptr, lb_->chooseHost(nullptr));
+  EXPECT_NE(nullptr, host_set_.healthy_hosts_[0]->lbPolicyData());
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, PrefersLowerLatency) {
+  init();
+  addHosts(2);
+  hostData(0).onResponseTime(std::chrono::milliseconds(100));
+  hostData(1).onResponseTime(std::chrono::milliseconds(50));
+
+  // The first random value selects the host set, the following values sample the hosts.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.healthy_hosts_[1], lb_->chooseHost(nullptr));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(host_set_.healthy_hosts_[1], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, WeighsLatencyByActiveRequests) {
+  init();
+  addHosts(2);
+  hostData(0).onResponseTime(std::chrono::milliseconds(10));
+  hostData(1).onResponseTime(std::chrono::milliseconds(30));
+  host_set_.healthy_hosts_[0]->stats().rq_active_.set(3);
+
+  // 10ms * 4 active requests is slower than 30ms * 1.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.healthy_hosts_[1], lb_->chooseHost(nullptr));
+
+  host_set_.healthy_hosts_[0]->stats().rq_active_.set(1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.healthy_hosts_[0], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, IdleHostsAreProbedAgain) {
+  init();
+  addHosts(2);
+  hostData(0).onResponseTime(std::chrono::milliseconds(500));
+  simTime().advanceTimeWait(std::chrono::seconds(30));
+  hostData(1).onResponseTime(std::chrono::milliseconds(30));
+
+  // 500ms decayed over three decay times is faster than a fresh 30ms.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.healthy_hosts_[0], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, ChoiceCount) {
+  config_.mutable_choice_count()->set_value(3);
+  init();
+  addHosts(3);
+  hostData(0).onResponseTime(std::chrono::milliseconds(100));
+  hostData(1).onResponseTime(std::chrono::milliseconds(100));
+  hostData(2).onResponseTime(std::chrono::milliseconds(10));
+
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(1))
+      .WillOnce(Return(2));
+  EXPECT_EQ(host_set_.healthy_hosts_[2], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, PeekAnotherHost) {
+  init();
+  addHosts(2);
+  hostData(0).onResponseTime(std::chrono::milliseconds(100));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(2));
+  EXPECT_EQ(host_set_.healthy_hosts_[0], lb_->peekAnotherHost(nullptr));
+  EXPECT_CALL(random_, random()).WillOnce(Return(3));
+  EXPECT_EQ(host_set_.healthy_hosts_[1], lb_->peekAnotherHost(nullptr));
+  // Only as many hosts as there are healthy hosts are peeked.
+  EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
+
+  // The stashed random values select the host set, the picks still compare latencies.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.healthy_hosts_[1], lb_->chooseHost(nullptr));
+}
+
+} // namespace
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
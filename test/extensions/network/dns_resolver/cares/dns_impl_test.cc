@@ -722,7 +722,9 @@ public:
     server_ = std::make_unique<TestDnsServer>(*dispatcher_);
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, *server_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(
+        socket_, *server_, runtime_, true, false,
+        Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     updateDnsResolverOptions();
 
     // Create a resolver options on stack here to emulate what actually happens in envoy bootstrap.
@@ -1365,6 +1367,59 @@ TEST_P(DnsImplTest, Cancel) {
              0 /*get_addr_failure*/, 0 /*timeouts*/);
 }
 
+// Validate that queries for a name and lookup family that is being resolved join the resolution
+// in flight, and that queries for another lookup family do not.
+TEST_P(DnsImplTest, CollapseInFlightQueries) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.cares_collapse_in_flight_queries", "true"}});
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  uint32_t completed = 0;
+  auto callback = [&](DnsResolver::ResolutionStatus status, std::list<DnsResponse>&& results) {
+    EXPECT_EQ(DnsResolver::ResolutionStatus::Success, status);
+    EXPECT_THAT(getAddressAsStringList(results), UnorderedElementsAreArray({"201.134.56.7"}));
+    if (++completed == 3) {
+      dispatcher_->exit();
+    }
+  };
+  EXPECT_NE(nullptr, resolver_->resolve("some.good.domain", DnsLookupFamily::Auto, callback));
+  EXPECT_NE(nullptr, resolver_->resolve("some.good.domain", DnsLookupFamily::Auto, callback));
+  EXPECT_NE(nullptr, resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only, callback));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(3, completed);
+  checkStats(3 /*resolve_total*/, 0 /*pending_resolutions*/, 1 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.collapsed_queries").value());
+}
+
+// Validate that cancelling the query that started a resolution does not cancel the queries that
+// joined it, and the other way around.
+TEST_P(DnsImplTest, CancelCollapsedQueries) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.cares_collapse_in_flight_queries", "true"}});
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  ActiveDnsQuery* query =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::Auto, false);
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::Auto,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  ActiveDnsQuery* collapsed_query =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::Auto, false);
+  ASSERT_NE(nullptr, query);
+  ASSERT_NE(nullptr, collapsed_query);
+  query->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  collapsed_query->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 1 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+  EXPECT_EQ(2, stats_store_.counter("dns.cares.collapsed_queries").value());
+}
+
 // Validate working of querying ttl of resource record.
 TEST_P(DnsImplTest, RecordTtlLookup) {
   uint64_t resolve_total = 0;
@@ -0,0 +1,226 @@
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+
+#include "source/extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/server/transport_socket_factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/test_time.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+constexpr absl::string_view Input = "handshake transcript";
+
+class TestPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  explicit TestPrivateKeyConnectionCallbacks(Event::Dispatcher& dispatcher)
+      : dispatcher_(dispatcher) {}
+
+  // Ssl::PrivateKeyConnectionCallbacks
+  void onPrivateKeyMethodComplete() override {
+    completed_ = true;
+    dispatcher_.exit();
+  }
+
+  Event::Dispatcher& dispatcher_;
+  bool completed_{};
+};
+
+class ThreadPoolPrivateKeyProviderTest : public testing::Test {
+public:
+  ThreadPoolPrivateKeyProviderTest()
+      : api_(Api::createApiForTest(store_, time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")), callbacks_(*dispatcher_),
+        ssl_ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ssl_ctx_.get())) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, scope()).WillByDefault(ReturnRef(*store_.rootScope()));
+    ON_CALL(factory_context_, sslContextManager()).WillByDefault(ReturnRef(context_manager_));
+    ON_CALL(context_manager_, privateKeyMethodManager())
+        .WillByDefault(ReturnRef(private_key_method_manager_));
+  }
+
+  Ssl::PrivateKeyMethodProviderSharedPtr createWithKey(const std::string& key_file) {
+    const std::string yaml = fmt::format(R"EOF(
+      provider_name: thread_pool
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.thread_pool.v3.ThreadPoolPrivateKeyMethodConfig
+        thread_count: 2
+        private_key: {{ "filename": "{}" }}
+)EOF",
+                                         keyPath(key_file));
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(yaml, config);
+    return factory_context_.sslContextManager()
+        .privateKeyMethodManager()
+        .createPrivateKeyMethodProvider(config, factory_context_);
+  }
+
+  static std::string keyPath(const std::string& key_file) {
+    return TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file);
+  }
+
+  // Sign the input through the provider and wait for the pool to finish.
+  std::vector<uint8_t> sign(Ssl::PrivateKeyMethodProvider& provider,
+                            uint16_t signature_algorithm) {
+    Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider.getBoringSslPrivateKeyMethod();
+    std::vector<uint8_t> out(1024);
+    size_t out_len = 0;
+    EXPECT_EQ(ssl_private_key_retry,
+              method->sign(ssl_.get(), out.data(), &out_len, out.size(), signature_algorithm,
+                           reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+    dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+    EXPECT_TRUE(callbacks_.completed_);
+    EXPECT_EQ(ssl_private_key_success,
+              method->complete(ssl_.get(), out.data(), &out_len, out.size()));
+    out.resize(out_len);
+    return out;
+  }
+
+  static void expectValidSignature(const std::string& key_file, uint16_t signature_algorithm,
+                                   const std::vector<uint8_t>& signature) {
+    const std::string key = TestEnvironment::readFileToStringForTest(keyPath(key_file));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(key.data(), key.size()));
+    bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+    ASSERT_NE(nullptr, pkey);
+
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx;
+    ASSERT_TRUE(EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                                     SSL_get_signature_algorithm_digest(signature_algorithm),
+                                     nullptr, pkey.get()));
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm)) {
+      ASSERT_TRUE(EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING));
+      ASSERT_TRUE(EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1));
+    }
+    EXPECT_TRUE(EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                                 reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+  }
+
+  Event::TestRealTimeSystem time_system_;
+  Stats::TestUtil::TestStore store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  TestPrivateKeyConnectionCallbacks callbacks_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  NiceMock<Ssl::MockContextManager> context_manager_;
+  TransportSockets::Tls::PrivateKeyMethodManagerImpl private_key_method_manager_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+};
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaSign) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithKey("unittest_key.pem");
+  ASSERT_NE(nullptr, provider);
+  EXPECT_TRUE(provider->checkFips());
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+
+  expectValidSignature("unittest_key.pem", SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                       sign(*provider, SSL_SIGN_RSA_PSS_RSAE_SHA256));
+  callbacks_.completed_ = false;
+  expectValidSignature("unittest_key.pem", SSL_SIGN_RSA_PKCS1_SHA256,
+                       sign(*provider, SSL_SIGN_RSA_PKCS1_SHA256));
+  EXPECT_EQ(2, TestUtility::findCounter(store_, "thread_pool_private_key_provider.operations")
+                   ->value());
+  EXPECT_EQ(0, TestUtility::findGauge(store_, "thread_pool_private_key_provider.queued_operations")
+                   ->value());
+
+  // The key can't make ECDSA signatures.
+  uint8_t out[512];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_failure,
+            provider->getBoringSslPrivateKeyMethod()->sign(
+                ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, EcdsaSign) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithKey("selfsigned_ecdsa_p256_key.pem");
+  ASSERT_NE(nullptr, provider);
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+
+  expectValidSignature("selfsigned_ecdsa_p256_key.pem", SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                       sign(*provider, SSL_SIGN_ECDSA_SECP256R1_SHA256));
+
+  // ECDSA keys can't decrypt.
+  uint8_t out[512];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_failure,
+            provider->getBoringSslPrivateKeyMethod()->decrypt(
+                ssl_.get(), out, &out_len, sizeof(out),
+                reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, CompleteBeforeDone) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithKey("unittest_key.pem");
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider->getBoringSslPrivateKeyMethod();
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+
+  uint8_t out[512];
+  size_t out_len;
+  // Nothing to complete yet.
+  EXPECT_EQ(ssl_private_key_failure, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  EXPECT_EQ(ssl_private_key_retry,
+            method->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                         reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+  // The result is only used once the worker thread was told about the completion.
+  EXPECT_EQ(ssl_private_key_retry, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(ssl_private_key_success, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, UnregisterBeforeDone) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithKey("unittest_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+
+  uint8_t out[512];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            provider->getBoringSslPrivateKeyMethod()->sign(
+                ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                reinterpret_cast<const uint8_t*>(Input.data()), Input.size()));
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+
+  // Joins the pool threads, so the completion has been posted.
+  provider.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(callbacks_.completed_);
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RegisterTwice) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithKey("unittest_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  EXPECT_THROW_WITH_MESSAGE(
+      provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Can't distinguish between two registered providers for the same SSL object.");
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, InvalidKey) {
+  EXPECT_THROW_WITH_MESSAGE(createWithKey("unittest_cert.pem"), EnvoyException,
+                            "Failed to read private key.");
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -188,6 +188,20 @@ TEST(UUIDRequestIDExtensionTest, SetTraceStatus) {
   EXPECT_EQ(request_headers.getRequestIdValue(), "");
 }
 
+TEST(UUIDRequestIDExtensionTest, SetTraceStatusUnchangedKeepsHeader) {
+  Random::RandomGeneratorImpl random;
+  UUIDRequestIDExtension uuid_utils(envoy::extensions::request_id::uuid::v3::UuidRequestIdConfig(),
+                                    random);
+  Http::TestRequestHeaderMapImpl request_headers;
+  request_headers.setRequestId(random.uuid());
+  const char* original_data = request_headers.RequestId()->value().getStringView().data();
+
+  // A generated UUID is already marked as not traceable, so the header isn't rewritten.
+  uuid_utils.setTraceReason(request_headers, Tracing::Reason::NotTraceable);
+  EXPECT_EQ(original_data, request_headers.RequestId()->value().getStringView().data());
+  EXPECT_EQ(Tracing::Reason::NotTraceable, uuid_utils.getTraceReason(request_headers));
+}
+
 TEST(UUIDRequestIDExtensionTest, SetTraceStatusPackingDisabled) {
   Random::RandomGeneratorImpl random;
   envoy::extensions::request_id::uuid::v3::UuidRequestIdConfig config;
@@ -0,0 +1,115 @@
+#include <chrono>
+
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_stats_reader.h"
+#include "source/extensions/resource_monitors/cpu_utilization/cpu_utilization_monitor.h"
+
+#include "test/mocks/filesystem/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CpuUtilizationMonitor {
+namespace {
+
+using testing::Return;
+using testing::Throw;
+
+class MockCpuStatsReader : public CpuStatsReader {
+public:
+  MOCK_METHOD(CpuTimes, read, ());
+};
+
+class ResourcePressure : public Server::ResourceUpdateCallbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+    error_.reset();
+  }
+
+  void onFailure(const EnvoyException& error) override {
+    error_ = error;
+    pressure_.reset();
+  }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+TEST(CpuUtilizationMonitorTest, ComputesUsageBetweenUpdates) {
+  Event::SimulatedTimeSystem time_system;
+  auto reader = std::make_unique<MockCpuStatsReader>();
+  EXPECT_CALL(*reader, read())
+      .WillOnce(Return(CpuTimes{1000000, 4}))
+      .WillOnce(Return(CpuTimes{3000000, 4}))
+      .WillOnce(Return(CpuTimes{9000000, 4}))
+      .WillOnce(Throw(EnvoyException("no stats")));
+  CpuUtilizationMonitor monitor(time_system, std::move(reader));
+  ResourcePressure resource;
+
+  // The first update has nothing to compare with.
+  monitor.updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_EQ(resource.pressure(), 0);
+
+  // 2s of CPU time over 1s on 4 CPUs.
+  time_system.advanceTimeWait(std::chrono::seconds(1));
+  monitor.updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(resource.pressure(), 0.5);
+
+  // The pressure is capped.
+  time_system.advanceTimeWait(std::chrono::seconds(1));
+  monitor.updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(resource.pressure(), 1.0);
+
+  monitor.updateResourceUsage(resource);
+  EXPECT_TRUE(resource.hasError());
+}
+
+TEST(CpuStatsReaderTest, ProcessStat) {
+  Filesystem::MockInstance file_system;
+  ProcessCpuStatsReader reader(file_system, 8, 100);
+  EXPECT_CALL(file_system, fileReadToEnd("/proc/self/stat"))
+      .WillOnce(Return("1 (envoy (x)) S 0 1 1 0 -1 4194560 10 0 0 0 250 50 0 0 20 0 9 0 1 2 3\n"))
+      .WillOnce(Return("garbage"));
+  const CpuTimes times = reader.read();
+  EXPECT_EQ(times.used_us_, 3000000);
+  EXPECT_EQ(times.cpus_, 8);
+  EXPECT_THROW(reader.read(), EnvoyException);
+}
+
+TEST(CpuStatsReaderTest, CgroupStat) {
+  Filesystem::MockInstance file_system;
+  CgroupCpuStatsReader reader(file_system, 8);
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/fs/cgroup/cpu.stat"))
+      .WillRepeatedly(Return("usage_usec 1234\nuser_usec 1000\nsystem_usec 234\n"));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/fs/cgroup/cpu.max"))
+      .WillOnce(Return("200000 100000\n"))
+      .WillOnce(Return("max 100000\n"));
+
+  CpuTimes times = reader.read();
+  EXPECT_EQ(times.used_us_, 1234);
+  EXPECT_EQ(times.cpus_, 2);
+
+  // Without a quota, all the CPUs of the host are available.
+  times = reader.read();
+  EXPECT_EQ(times.cpus_, 8);
+}
+
+} // namespace
+} // namespace CpuUtilizationMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
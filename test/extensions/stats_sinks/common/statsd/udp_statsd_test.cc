@@ -322,6 +322,56 @@ TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, CachedLines) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, true, getDefaultPrefix(), 1024);
+
+  NiceMock<Stats::MockCounter> counter;
+  counter.name_ = "test_counter";
+  counter.used_ = true;
+  snapshot.counters_.push_back({1, counter});
+  NiceMock<Stats::MockGauge> gauge;
+  gauge.name_ = "test_gauge";
+  gauge.value_ = 1;
+  gauge.used_ = true;
+  snapshot.gauges_.push_back(gauge);
+
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 1);
+  EXPECT_EQ(writer_ptr->buffer_writes.back(), "envoy.test_counter:1|c\nenvoy.test_gauge:1|g");
+
+  // Only the values are rendered for cached lines.
+  snapshot.counters_[0].delta_ = 7;
+  gauge.value_ = 3;
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 2);
+  EXPECT_EQ(writer_ptr->buffer_writes.back(), "envoy.test_counter:7|c\nenvoy.test_gauge:3|g");
+
+  // Lines are keyed by stat name.
+  counter.name_ = "other_counter";
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 3);
+  EXPECT_EQ(writer_ptr->buffer_writes.back(), "envoy.other_counter:7|c\nenvoy.test_gauge:3|g");
+
+  // The line of a metric that was not flushed for a while is evicted and rebuilt, picking up the
+  // tags which are assumed to be fixed for a given name.
+  std::vector<Stats::Tag> tags = {Stats::Tag{"key", "value"}};
+  gauge.setTags(tags);
+  snapshot.gauges_.clear();
+  for (uint64_t i = 0; i < 2 * UdpStatsdSink::MaxIdleFlushes; ++i) {
+    sink.flush(snapshot);
+  }
+  snapshot.gauges_.push_back(gauge);
+  sink.flush(snapshot);
+  EXPECT_EQ(writer_ptr->buffer_writes.back(),
+            "envoy.other_counter:7|c\nenvoy.test_gauge:3|g|#key:value");
+
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkTest, SiSuffix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
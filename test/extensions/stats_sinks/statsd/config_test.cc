@@ -155,6 +155,56 @@ TEST(StatsConfigTest, TcpSinkCustomPrefix) {
   EXPECT_EQ(tcp_sink->getPrefix(), prefix);
 }
 
+TEST(StatsConfigTest, ChangedMetricsOnly) {
+  envoy::config::metrics::v3::StatsdSink sink_config;
+  sink_config.set_tcp_cluster_name("fake_cluster");
+
+  Server::Configuration::StatsSinkFactory* factory =
+      Registry::FactoryRegistry<Server::Configuration::StatsSinkFactory>::getFactory(StatsdName);
+  ASSERT_NE(factory, nullptr);
+  NiceMock<Server::Configuration::MockServerFactoryContext> server;
+  server.cluster_manager_.initializeClusters({"fake_cluster"}, {});
+
+  ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+  TestUtility::jsonConvert(sink_config, *message);
+  EXPECT_FALSE(factory->createStatsSink(*message, server)->deltaSnapshots());
+
+  sink_config.set_emit_changed_metrics_only(true);
+  TestUtility::jsonConvert(sink_config, *message);
+  EXPECT_TRUE(factory->createStatsSink(*message, server)->deltaSnapshots());
+
+  sink_config.mutable_address()->mutable_socket_address()->set_protocol(
+      envoy::config::core::v3::SocketAddress::UDP);
+  sink_config.mutable_address()->mutable_socket_address()->set_address("127.0.0.1");
+  sink_config.mutable_address()->mutable_socket_address()->set_port_value(8125);
+  TestUtility::jsonConvert(sink_config, *message);
+  Stats::SinkPtr sink = factory->createStatsSink(*message, server);
+  EXPECT_NE(dynamic_cast<Common::Statsd::UdpStatsdSink*>(sink.get()), nullptr);
+  EXPECT_TRUE(sink->deltaSnapshots());
+}
+
+TEST(StatsConfigTest, UdpSinkMaxBytesPerDatagram) {
+  envoy::config::metrics::v3::StatsdSink sink_config;
+  envoy::config::core::v3::SocketAddress& socket_address =
+      *sink_config.mutable_address()->mutable_socket_address();
+  socket_address.set_protocol(envoy::config::core::v3::SocketAddress::UDP);
+  socket_address.set_address("127.0.0.1");
+  socket_address.set_port_value(8125);
+  sink_config.mutable_max_bytes_per_datagram()->set_value(1400);
+
+  Server::Configuration::StatsSinkFactory* factory =
+      Registry::FactoryRegistry<Server::Configuration::StatsSinkFactory>::getFactory(StatsdName);
+  ASSERT_NE(factory, nullptr);
+  ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+  TestUtility::jsonConvert(sink_config, *message);
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> server;
+  Stats::SinkPtr sink = factory->createStatsSink(*message, server);
+  auto udp_sink = dynamic_cast<Common::Statsd::UdpStatsdSink*>(sink.get());
+  ASSERT_NE(udp_sink, nullptr);
+  EXPECT_EQ(udp_sink->getBufferSizeForTest(), 1400);
+}
+
 class StatsConfigLoopbackTest : public testing::TestWithParam<Network::Address::IpVersion> {};
 INSTANTIATE_TEST_SUITE_P(IpVersions, StatsConfigLoopbackTest,
                          testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
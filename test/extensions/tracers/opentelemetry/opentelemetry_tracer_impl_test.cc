@@ -431,6 +431,49 @@ TEST_F(OpenTelemetryDriverTest, IgnoreNotSampledSpan) {
   EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_sent").value());
 }
 
+TEST_F(OpenTelemetryDriverTest, TailSampleNotSampledSpans) {
+  const std::string yaml_string = R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: fake-cluster
+      timeout: 0.250s
+    tail_sampling:
+      errors: true
+      min_duration: 1s
+    )EOF";
+  envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
+  TestUtility::loadFromYaml(yaml_string, opentelemetry_config);
+  setup(opentelemetry_config);
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _)).Times(2);
+
+  // A fast span without an error is dropped.
+  Tracing::SpanPtr span =
+      driver_->startSpan(mock_tracing_config_, request_headers, operation_name_,
+                         time_system_.systemTime(), {Tracing::Reason::Sampling, false});
+  span->finishSpan();
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+
+  // A span with an error is exported.
+  span = driver_->startSpan(mock_tracing_config_, request_headers, operation_name_,
+                            time_system_.systemTime(), {Tracing::Reason::Sampling, false});
+  span->setTag(Tracing::Tags::get().Error, Tracing::Tags::get().True);
+  span->finishSpan();
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+
+  // So is a span which lasted at least the minimum duration.
+  span = driver_->startSpan(mock_tracing_config_, request_headers, operation_name_,
+                            time_system_.systemTime() - std::chrono::seconds(2),
+                            {Tracing::Reason::Sampling, false});
+  span->finishSpan();
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_tail_sampled").value());
+}
+
 TEST_F(OpenTelemetryDriverTest, NoExportWithoutGrpcService) {
   const std::string yaml_string = "{}";
   envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
@@ -3,10 +3,12 @@
 
 #include "source/extensions/transport_sockets/tls/cert_validator/default_validator.h"
 #include "source/extensions/transport_sockets/tls/cert_validator/san_matcher.h"
+#include "source/extensions/transport_sockets/tls/utility.h"
 
 #include "test/extensions/transport_sockets/tls/cert_validator/test_common.h"
 #include "test/extensions/transport_sockets/tls/ssl_test_utility.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -289,6 +291,58 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+// A chain verified once is accepted without consulting the trust store until the cache entry
+// expires.
+TEST(DefaultCertValidatorTest, TrustChainVerificationCache) {
+  Event::SimulatedTimeSystem time_system;
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+
+  bssl::UniquePtr<STACK_OF(X509)> cert_chain = readCertChainFromFile(TestEnvironment::substitute(
+      "{{ test_rundir "
+      "}}/test/extensions/transport_sockets/tls/test_data/test_long_cert_chain.pem"));
+  bssl::UniquePtr<X509> cert = readCertFromFile(TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/test_random_cert.pem"));
+  const std::string ca_cert_str = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute(
+          "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ca_cert.pem"));
+  TestCertificateValidationContextConfigPtr test_config =
+      std::make_unique<TestCertificateValidationContextConfig>(
+          typed_conf, false,
+          std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>{},
+          ca_cert_str, absl::nullopt, std::chrono::hours(1));
+  DefaultCertValidator validator(test_config.get(), stats, time_system);
+  // Verify at a time at which the test certificates are valid.
+  const SystemTime verification_time = Utility::getExpirationTime(*cert) - std::chrono::hours(24);
+  time_system.setSystemTime(verification_time);
+  const time_t verification_time_t = std::chrono::system_clock::to_time_t(verification_time);
+
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  validator.initializeSslContexts({ssl_ctx.get()}, false);
+  X509StoreContextPtr store_ctx = X509_STORE_CTX_new();
+  ASSERT_TRUE(X509_STORE_CTX_init(store_ctx.get(), SSL_CTX_get_cert_store(ssl_ctx.get()),
+                                  cert.get(), cert_chain.get()));
+  X509_STORE_CTX_set_time(store_ctx.get(), 0, verification_time_t);
+  EXPECT_EQ(1, validator.doSynchronousVerifyCertChain(store_ctx.get(), nullptr, *cert, nullptr));
+
+  // The trust store of this context is empty, so only the cached verification can succeed.
+  SSLContextPtr untrusted_ssl_ctx = SSL_CTX_new(TLS_method());
+  auto verify_untrusted = [&]() {
+    X509StoreContextPtr untrusted_store_ctx = X509_STORE_CTX_new();
+    EXPECT_TRUE(X509_STORE_CTX_init(untrusted_store_ctx.get(),
+                                    SSL_CTX_get_cert_store(untrusted_ssl_ctx.get()), cert.get(),
+                                    cert_chain.get()));
+    X509_STORE_CTX_set_time(untrusted_store_ctx.get(), 0, verification_time_t);
+    return validator.doSynchronousVerifyCertChain(untrusted_store_ctx.get(), nullptr, *cert,
+                                                  nullptr);
+  };
+  EXPECT_EQ(1, verify_untrusted());
+
+  time_system.advanceTimeWait(std::chrono::hours(2));
+  EXPECT_EQ(0, verify_untrusted());
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() {
@@ -317,6 +371,9 @@ public:
   MOCK_METHOD(Api::Api&, api, (), (const override));
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  absl::optional<std::chrono::milliseconds> trustChainVerificationCacheTtl() const override {
+    return absl::nullopt;
+  }
 
 private:
   std::string s_;
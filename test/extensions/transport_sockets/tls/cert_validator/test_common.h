@@ -45,10 +45,11 @@ public:
       bool allow_expired_certificate = false,
       std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>
           san_matchers = {},
-      std::string ca_cert = "", absl::optional<uint32_t> verify_depth = absl::nullopt)
+      std::string ca_cert = "", absl::optional<uint32_t> verify_depth = absl::nullopt,
+      absl::optional<std::chrono::milliseconds> verification_cache_ttl = absl::nullopt)
       : allow_expired_certificate_(allow_expired_certificate), api_(Api::createApiForTest()),
         custom_validator_config_(custom_config), san_matchers_(san_matchers), ca_cert_(ca_cert),
-        max_verify_depth_(verify_depth){};
+        max_verify_depth_(verify_depth), verification_cache_ttl_(verification_cache_ttl){};
   TestCertificateValidationContextConfig()
       : api_(Api::createApiForTest()), custom_validator_config_(absl::nullopt){};
 
@@ -89,6 +90,10 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  absl::optional<std::chrono::milliseconds> trustChainVerificationCacheTtl() const override {
+    return verification_cache_ttl_;
+  }
+
 private:
   bool allow_expired_certificate_{false};
   Api::ApiPtr api_;
@@ -98,6 +103,7 @@ private:
   const std::string ca_cert_;
   const std::string ca_cert_path_{"TEST_CA_CERT_PATH"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
+  const absl::optional<std::chrono::milliseconds> verification_cache_ttl_{absl::nullopt};
 };
 
 } // namespace Tls
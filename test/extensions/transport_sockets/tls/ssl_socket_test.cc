@@ -359,8 +359,9 @@ void testUtil(const TestUtilOptions& options) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(options.version()));
   Network::MockTcpListenerCallbacks callbacks;
-  Network::ListenerPtr listener =
-      dispatcher->createListener(socket, callbacks, runtime, true, false);
+  Network::ListenerPtr listener = dispatcher->createListener(
+      socket, callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext client_tls_context;
   TestUtility::loadFromYaml(TestEnvironment::substitute(options.clientCtxYaml()),
@@ -701,8 +702,9 @@ void testUtilV2(const TestUtilOptionsV2& options) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(options.version()));
   NiceMock<Network::MockTcpListenerCallbacks> callbacks;
-  Network::ListenerPtr listener =
-      dispatcher->createListener(socket, callbacks, runtime, true, false);
+  Network::ListenerPtr listener = dispatcher->createListener(
+      socket, callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Stats::TestUtil::TestStore client_stats_store;
   Api::ApiPtr client_api = Api::createApiForTest(client_stats_store, time_system);
@@ -3012,8 +3014,9 @@ TEST_P(SslSocketTest, FlushCloseDuringHandshake) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ClientConnectionPtr client_connection = dispatcher_->createClientConnection(
       socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
@@ -3068,8 +3071,9 @@ TEST_P(SslSocketTest, HalfClose) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
   std::shared_ptr<Network::MockReadFilter> server_read_filter(new Network::MockReadFilter());
   std::shared_ptr<Network::MockReadFilter> client_read_filter(new Network::MockReadFilter());
 
@@ -3150,8 +3154,9 @@ TEST_P(SslSocketTest, ShutdownWithCloseNotify) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
   std::shared_ptr<Network::MockReadFilter> server_read_filter(new Network::MockReadFilter());
   std::shared_ptr<Network::MockReadFilter> client_read_filter(new Network::MockReadFilter());
 
@@ -3214,6 +3219,200 @@ TEST_P(SslSocketTest, ShutdownWithCloseNotify) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+// With kernel TLS transmit offload enabled, data and close_notify written by the server reach the
+// client whether or not the kernel supports kTLS.
+TEST_P(SslSocketTest, ShutdownWithCloseNotifyKernelTlsTx) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.tls_kernel_tx_offload", "true"}});
+
+
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"
+    validation_context:
+      trusted_ca:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ca_certificates.pem"
+)EOF";
+
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext server_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), server_tls_context);
+  auto server_cfg = std::make_unique<ServerContextConfigImpl>(server_tls_context, factory_context_);
+  ContextManagerImpl manager(time_system_);
+  Stats::TestUtil::TestStore server_stats_store;
+  ServerSslSocketFactory server_ssl_socket_factory(
+      std::move(server_cfg), manager, *server_stats_store.rootScope(), std::vector<std::string>{});
+
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version_));
+  Network::MockTcpListenerCallbacks listener_callbacks;
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
+  std::shared_ptr<Network::MockReadFilter> server_read_filter(new Network::MockReadFilter());
+  std::shared_ptr<Network::MockReadFilter> client_read_filter(new Network::MockReadFilter());
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+      tls_params:
+        tls_maximum_protocol_version: TLSv1_2
+        cipher_suites:
+        - ECDHE-RSA-AES128-GCM-SHA256
+  )EOF";
+
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml), tls_context);
+  auto client_cfg = std::make_unique<ClientContextConfigImpl>(tls_context, factory_context_);
+  Stats::TestUtil::TestStore client_stats_store;
+  ClientSslSocketFactory client_ssl_socket_factory(std::move(client_cfg), manager,
+                                                   *client_stats_store.rootScope());
+  Network::ClientConnectionPtr client_connection = dispatcher_->createClientConnection(
+      socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
+      client_ssl_socket_factory.createTransportSocket(nullptr, nullptr), nullptr, nullptr);
+  Network::MockConnectionCallbacks client_connection_callbacks;
+  client_connection->enableHalfClose(true);
+  client_connection->addReadFilter(client_read_filter);
+  client_connection->addConnectionCallbacks(client_connection_callbacks);
+  client_connection->connect();
+
+  Network::ConnectionPtr server_connection;
+  Network::MockConnectionCallbacks server_connection_callbacks;
+  EXPECT_CALL(listener_callbacks, onAccept_(_))
+      .WillOnce(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+        server_connection = dispatcher_->createServerConnection(
+            std::move(socket), server_ssl_socket_factory.createDownstreamTransportSocket(),
+            stream_info_);
+        server_connection->enableHalfClose(true);
+        server_connection->addReadFilter(server_read_filter);
+        server_connection->addConnectionCallbacks(server_connection_callbacks);
+      }));
+  EXPECT_CALL(*server_read_filter, onNewConnection());
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void {
+        Buffer::OwnedImpl data("hello");
+        server_connection->write(data, true);
+        EXPECT_EQ(data.length(), 0);
+      }));
+
+  EXPECT_CALL(*client_read_filter, onNewConnection())
+      .WillOnce(Return(Network::FilterStatus::Continue));
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::Connected));
+  EXPECT_CALL(*client_read_filter, onData(BufferStringEqual("hello"), true))
+      .WillOnce(Invoke([&](Buffer::Instance& read_buffer, bool) -> Network::FilterStatus {
+        read_buffer.drain(read_buffer.length());
+        client_connection->close(Network::ConnectionCloseType::NoFlush);
+        return Network::FilterStatus::StopIteration;
+      }));
+  EXPECT_CALL(*server_read_filter, onData(_, true));
+
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose));
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void {
+        server_connection->close(Network::ConnectionCloseType::NoFlush);
+        dispatcher_->exit();
+      }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
+// With dynamic record sizing, the server writes small records until initial_bytes were written,
+// then full size records.
+TEST_P(SslSocketTest, DynamicRecordSizing) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"
+  dynamic_record_sizing:
+    initial_record_size: 1000
+    initial_bytes: 3000
+)EOF";
+
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext server_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), server_tls_context);
+  auto server_cfg = std::make_unique<ServerContextConfigImpl>(server_tls_context, factory_context_);
+  ContextManagerImpl manager(time_system_);
+  Stats::TestUtil::TestStore server_stats_store;
+  ServerSslSocketFactory server_ssl_socket_factory(
+      std::move(server_cfg), manager, *server_stats_store.rootScope(), std::vector<std::string>{});
+
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version_));
+  Network::MockTcpListenerCallbacks listener_callbacks;
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
+  std::shared_ptr<Network::MockReadFilter> server_read_filter(new Network::MockReadFilter());
+  std::shared_ptr<Network::MockReadFilter> client_read_filter(new Network::MockReadFilter());
+
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  auto client_cfg = std::make_unique<ClientContextConfigImpl>(tls_context, factory_context_);
+  Stats::TestUtil::TestStore client_stats_store;
+  ClientSslSocketFactory client_ssl_socket_factory(std::move(client_cfg), manager,
+                                                   *client_stats_store.rootScope());
+  Network::ClientConnectionPtr client_connection = dispatcher_->createClientConnection(
+      socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
+      client_ssl_socket_factory.createTransportSocket(nullptr, nullptr), nullptr, nullptr);
+  Network::MockConnectionCallbacks client_connection_callbacks;
+  client_connection->enableHalfClose(true);
+  client_connection->addReadFilter(client_read_filter);
+  client_connection->addConnectionCallbacks(client_connection_callbacks);
+  client_connection->connect();
+
+  Network::ConnectionPtr server_connection;
+  Network::MockConnectionCallbacks server_connection_callbacks;
+  EXPECT_CALL(listener_callbacks, onAccept_(_))
+      .WillOnce(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+        server_connection = dispatcher_->createServerConnection(
+            std::move(socket), server_ssl_socket_factory.createDownstreamTransportSocket(),
+            stream_info_);
+        server_connection->enableHalfClose(true);
+        server_connection->addReadFilter(server_read_filter);
+        server_connection->addConnectionCallbacks(server_connection_callbacks);
+      }));
+  EXPECT_CALL(*server_read_filter, onNewConnection());
+  const std::string response(10000, 'a');
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void {
+        Buffer::OwnedImpl data(response);
+        server_connection->write(data, true);
+      }));
+
+  EXPECT_CALL(*client_read_filter, onNewConnection())
+      .WillOnce(Return(Network::FilterStatus::Continue));
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::Connected));
+  std::string received;
+  EXPECT_CALL(*client_read_filter, onData(_, _))
+      .WillRepeatedly(
+          Invoke([&](Buffer::Instance& read_buffer, bool end_stream) -> Network::FilterStatus {
+            received.append(read_buffer.toString());
+            read_buffer.drain(read_buffer.length());
+            if (end_stream) {
+              client_connection->close(Network::ConnectionCloseType::NoFlush);
+            }
+            return Network::FilterStatus::StopIteration;
+          }));
+  EXPECT_CALL(*server_read_filter, onData(_, true));
+
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose));
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void {
+        server_connection->close(Network::ConnectionCloseType::NoFlush);
+        dispatcher_->exit();
+      }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(response, received);
+  EXPECT_EQ(3UL, server_stats_store.counter("ssl.dynamic_record_sizing_small_records").value());
+  EXPECT_EQ(1UL, server_stats_store.counter("ssl.dynamic_record_sizing_full_records").value());
+}
+
 TEST_P(SslSocketTest, ShutdownWithoutCloseNotify) {
   const std::string server_ctx_yaml = R"EOF(
   common_tls_context:
@@ -3238,8 +3437,9 @@ TEST_P(SslSocketTest, ShutdownWithoutCloseNotify) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, listener_callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
   std::shared_ptr<Network::MockReadFilter> server_read_filter(new Network::MockReadFilter());
   std::shared_ptr<Network::MockReadFilter> client_read_filter(new Network::MockReadFilter());
 
@@ -3342,8 +3542,9 @@ TEST_P(SslSocketTest, ClientAuthMultipleCAs) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   const std::string client_ctx_yaml = R"EOF(
   common_tls_context:
@@ -3442,10 +3643,12 @@ void testTicketSessionResumption(const std::string& server_ctx_yaml1,
       Network::Test::getCanonicalLoopbackAddress(ip_version));
   NiceMock<Network::MockTcpListenerCallbacks> callbacks;
   Event::DispatcherPtr dispatcher(server_api->allocateDispatcher("test_thread"));
-  Network::ListenerPtr listener1 =
-      dispatcher->createListener(socket1, callbacks, runtime, true, false);
-  Network::ListenerPtr listener2 =
-      dispatcher->createListener(socket2, callbacks, runtime, true, false);
+  Network::ListenerPtr listener1 = dispatcher->createListener(
+      socket1, callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
+  Network::ListenerPtr listener2 = dispatcher->createListener(
+      socket2, callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext client_tls_context;
   TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml), client_tls_context);
@@ -3585,8 +3788,9 @@ void testSupportForStatelessSessionResumption(const std::string& server_ctx_yaml
       Network::Test::getCanonicalLoopbackAddress(ip_version));
   NiceMock<Network::MockTcpListenerCallbacks> callbacks;
   Event::DispatcherPtr dispatcher(server_api->allocateDispatcher("test_thread"));
-  Network::ListenerPtr listener =
-      dispatcher->createListener(tcp_socket, callbacks, runtime, true, false);
+  Network::ListenerPtr listener = dispatcher->createListener(
+      tcp_socket, callbacks, runtime, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext client_tls_context;
   TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml), client_tls_context);
@@ -3640,8 +3844,90 @@ void testSupportForStatelessSessionResumption(const std::string& server_ctx_yaml
   dispatcher->run(Event::Dispatcher::RunType::Block);
 }
 
+// A session cache that completes lookups on the next dispatcher iteration.
+class TestSessionCache : public Ssl::SessionCache {
+public:
+  class Lookup : public Ssl::SessionCacheLookup {
+  public:
+    void cancel() override { *cancelled_ = true; }
+
+    std::shared_ptr<bool> cancelled_{std::make_shared<bool>(false)};
+  };
+
+  void insert(absl::string_view session_id, absl::string_view session,
+              std::chrono::seconds) override {
+    sessions_[std::string(session_id)] = std::string(session);
+  }
+  Ssl::SessionCacheLookupPtr lookup(absl::string_view session_id, Event::Dispatcher& dispatcher,
+                                    Ssl::SessionCacheLookupCallbacks& callbacks) override {
+    lookups_++;
+    absl::optional<std::string> session;
+    auto it = sessions_.find(session_id);
+    if (it != sessions_.end()) {
+      session = it->second;
+    }
+    auto lookup = std::make_unique<Lookup>();
+    dispatcher.post([cancelled = lookup->cancelled_, &callbacks, session]() mutable {
+      if (!*cancelled) {
+        callbacks.onSessionCacheLookupComplete(std::move(session));
+      }
+    });
+    return lookup;
+  }
+  void remove(absl::string_view session_id) override { sessions_.erase(session_id); }
+
+  uint32_t lookups_{};
+  absl::flat_hash_map<std::string, std::string> sessions_;
+};
+
+class TestSessionCacheFactory : public Ssl::SessionCacheFactory {
+public:
+  std::string name() const override { return "envoy.tls.session_cache.test"; }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ProtobufWkt::Struct>();
+  }
+  Ssl::SessionCacheSharedPtr
+  createSessionCache(const Protobuf::Message&,
+                     Server::Configuration::TransportSocketFactoryContext&) override {
+    return cache_;
+  }
+
+  std::shared_ptr<TestSessionCache> cache_{std::make_shared<TestSessionCache>()};
+};
+
 } // namespace
 
+// Sessions stored by one server context can be resumed on another one sharing the cache.
+TEST_P(SslSocketTest, ExternalSessionCacheResumption) {
+  TestSessionCacheFactory factory;
+  Registry::InjectFactory<Ssl::SessionCacheFactory> registered_factory(factory);
+
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_maximum_protocol_version: TLSv1_2
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"
+  disable_stateless_session_resumption: true
+  session_cache:
+    name: envoy.tls.session_cache.test
+    typed_config:
+      "@type": type.googleapis.com/google.protobuf.Struct
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml, {}, server_ctx_yaml, {}, client_ctx_yaml, true,
+                              version_);
+  EXPECT_EQ(1UL, factory.cache_->sessions_.size());
+  EXPECT_EQ(1U, factory.cache_->lookups_);
+}
+
 TEST_P(SslSocketTest, TicketSessionResumption) {
   const std::string server_ctx_yaml = R"EOF(
   common_tls_context:
@@ -4187,10 +4473,12 @@ TEST_P(SslSocketTest, ClientAuthCrossListenerSessionResumption) {
   auto socket2 = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, callbacks, runtime_, true, false);
-  Network::ListenerPtr listener2 =
-      dispatcher_->createListener(socket2, callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
+  Network::ListenerPtr listener2 = dispatcher_->createListener(
+      socket2, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
   const std::string client_ctx_yaml = R"EOF(
   common_tls_context:
     tls_certificates:
@@ -4308,8 +4596,9 @@ void SslSocketTest::testClientSessionResumption(const std::string& server_ctx_ya
   NiceMock<Network::MockTcpListenerCallbacks> callbacks;
   Api::ApiPtr api = Api::createApiForTest(server_stats_store, time_system_);
   Event::DispatcherPtr dispatcher(server_api->allocateDispatcher("test_thread"));
-  Network::ListenerPtr listener =
-      dispatcher->createListener(socket, callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher->createListener(
+      socket, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ConnectionPtr server_connection;
   Network::MockConnectionCallbacks server_connection_callbacks;
@@ -4568,8 +4857,9 @@ TEST_P(SslSocketTest, SslError) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks callbacks;
-  Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, callbacks, runtime_, true, false);
+  Network::ListenerPtr listener = dispatcher_->createListener(
+      socket, callbacks, runtime_, true, false,
+      Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ClientConnectionPtr client_connection = dispatcher_->createClientConnection(
       socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
@@ -5582,6 +5872,108 @@ TEST_P(SslSocketTest, DownstreamNotReadySslSocket) {
   EXPECT_EQ("TLS error: Secret is not supplied by SDS", transport_socket->failureReason());
 }
 
+// Validate that lazily initialized contexts are only built for the first connection and that the
+// least recently used ones are released beyond the runtime limit.
+TEST_P(SslSocketTest, DownstreamLazyContextInitialization) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.tls.max_lazy_server_contexts", "1"}});
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"
+  lazy_context_initialization: true
+)EOF";
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), tls_context);
+
+  ContextManagerImpl manager(time_system_);
+  Stats::TestUtil::TestStore stats_store;
+  auto countContexts = [&manager]() {
+    uint32_t count = 0;
+    manager.iterateContexts([&count](const Ssl::Context&) { ++count; });
+    return count;
+  };
+  ServerSslSocketFactory factory1(
+      std::make_unique<ServerContextConfigImpl>(tls_context, factory_context_), manager,
+      *stats_store.rootScope(), std::vector<std::string>{});
+  ServerSslSocketFactory factory2(
+      std::make_unique<ServerContextConfigImpl>(tls_context, factory_context_), manager,
+      *stats_store.rootScope(), std::vector<std::string>{});
+  EXPECT_EQ(0, countContexts());
+
+  auto socket1 = factory1.createDownstreamTransportSocket();
+  EXPECT_NE(nullptr, socket1->ssl());
+  EXPECT_EQ(1, countContexts());
+  EXPECT_NE(nullptr, factory1.createDownstreamTransportSocket()->ssl());
+  EXPECT_EQ(1, countContexts());
+
+  // Building the second context releases the first one, which stays alive for its connection.
+  auto socket2 = factory2.createDownstreamTransportSocket();
+  EXPECT_NE(nullptr, socket2->ssl());
+  EXPECT_EQ(1, countContexts());
+  EXPECT_NE(nullptr, factory1.createDownstreamTransportSocket()->ssl());
+  EXPECT_EQ(1, countContexts());
+  EXPECT_EQ(0, stats_store.counterFromString("server.downstream_context_lazy_init_failed").value());
+}
+
+// Validate that a lazily initialized context that fails to build closes connections without
+// trying again until the secrets are updated.
+TEST_P(SslSocketTest, DownstreamLazyContextInitializationFailure) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+  lazy_context_initialization: true
+)EOF";
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), tls_context);
+
+  ContextManagerImpl manager(time_system_);
+  Stats::TestUtil::TestStore stats_store;
+  // The invalid key is not noticed upfront.
+  ServerSslSocketFactory factory(
+      std::make_unique<ServerContextConfigImpl>(tls_context, factory_context_), manager,
+      *stats_store.rootScope(), std::vector<std::string>{});
+
+  for (int i = 0; i < 2; ++i) {
+    auto transport_socket = factory.createDownstreamTransportSocket();
+    EXPECT_EQ(nullptr, transport_socket->ssl());
+    Buffer::OwnedImpl buffer;
+    EXPECT_EQ(Network::PostIoAction::Close, transport_socket->doRead(buffer).action_);
+  }
+  EXPECT_EQ(2, stats_store.counterFromString("server.downstream_context_lazy_init_failed").value());
+  EXPECT_EQ(0,
+            stats_store.counterFromString("server.downstream_context_secrets_not_ready").value());
+}
+
+// Validate that contexts with secrets from SDS are not lazily initialized.
+TEST_P(SslSocketTest, DownstreamLazyContextInitializationWithSds) {
+  Stats::TestUtil::TestStore stats_store;
+  NiceMock<LocalInfo::MockLocalInfo> local_info;
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context;
+  NiceMock<Init::MockManager> init_manager;
+  NiceMock<Event::MockDispatcher> dispatcher;
+  EXPECT_CALL(factory_context, mainThreadDispatcher()).WillRepeatedly(ReturnRef(dispatcher));
+  EXPECT_CALL(factory_context, localInfo()).WillOnce(ReturnRef(local_info));
+  EXPECT_CALL(factory_context, stats()).WillOnce(ReturnRef(stats_store));
+  EXPECT_CALL(factory_context, initManager()).WillRepeatedly(ReturnRef(init_manager));
+
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  auto sds_secret_configs =
+      tls_context.mutable_common_tls_context()->mutable_tls_certificate_sds_secret_configs()->Add();
+  sds_secret_configs->set_name("abc.com");
+  sds_secret_configs->mutable_sds_config();
+  tls_context.set_lazy_context_initialization(true);
+  ServerContextConfigImpl server_cfg(tls_context, factory_context);
+  EXPECT_FALSE(server_cfg.lazyContextInitialization());
+}
+
 // Validate that if upstream secrets are not yet downloaded from SDS server, Envoy creates
 // NotReadySslSocket object to handle upstream connection.
 TEST_P(SslSocketTest, UpstreamNotReadySslSocket) {
@@ -5666,7 +6058,9 @@ protected:
 
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(version_));
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(
+        socket_, listener_callbacks_, runtime_, true, false,
+        Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
     TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml_), upstream_tls_context_);
     auto client_cfg =
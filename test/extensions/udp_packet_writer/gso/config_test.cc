@@ -6,6 +6,8 @@
 
 #if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
 
+#include "quiche/quic/platform/api/quic_flags.h"
+
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -29,6 +31,21 @@ TEST(FactoryTest, CreateUdpPacketWriterFactory) {
   EXPECT_TRUE(factory.createUdpPacketWriterFactory(config) != nullptr);
 }
 
+TEST(FactoryTest, CreateUdpPacketWriterFactoryWithPacingOffload) {
+  UdpGsoBatchWriterFactoryFactory factory;
+  envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory writer_config;
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(writer_config);
+  EXPECT_TRUE(factory.createUdpPacketWriterFactory(config) != nullptr);
+  EXPECT_FALSE(GetQuicRestartFlag(quic_support_release_time_for_gso));
+
+  writer_config.set_enable_pacing_offload(true);
+  config.mutable_typed_config()->PackFrom(writer_config);
+  EXPECT_TRUE(factory.createUdpPacketWriterFactory(config) != nullptr);
+  EXPECT_TRUE(GetQuicRestartFlag(quic_support_release_time_for_gso));
+  SetQuicRestartFlag(quic_support_release_time_for_gso, false);
+}
+
 } // namespace Quic
 } // namespace Envoy
 
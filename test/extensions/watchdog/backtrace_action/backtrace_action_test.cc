@@ -0,0 +1,87 @@
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/extensions/watchdog/backtrace_action/v3/backtrace_action.pb.h"
+#include "envoy/server/guarddog_config.h"
+#include "envoy/thread/thread.h"
+
+#include "source/extensions/watchdog/backtrace_action/backtrace_action.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace BacktraceAction {
+namespace {
+
+#ifdef __linux__
+class BacktraceActionTest : public testing::Test {
+protected:
+  BacktraceActionTest()
+      : api_(Api::createApiForTest(stats_)),
+        context_({*api_, dispatcher_, *stats_.rootScope(), "test"}) {}
+
+  // Runs the action on a thread blocked until the end of the test.
+  void runOnStuckThread(uint32_t runs) {
+    absl::Notification started;
+    absl::Notification unblock;
+    absl::optional<Thread::ThreadId> tid;
+    Thread::ThreadPtr thread = api_->threadFactory().createThread([&]() -> void {
+      tid = api_->threadFactory().currentThreadId();
+      started.Notify();
+      unblock.WaitForNotification();
+    });
+    started.WaitForNotification();
+
+    const auto now = api_->timeSource().monotonicTime();
+    const std::vector<std::pair<Thread::ThreadId, MonotonicTime>> tid_ltt_pairs = {
+        {*tid, now - std::chrono::milliseconds(200)}};
+    for (uint32_t i = 0; i < runs; ++i) {
+      action_->run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::MISS, tid_ltt_pairs,
+                   now);
+    }
+    unblock.Notify();
+    thread->join();
+  }
+
+  Stats::TestUtil::TestStore stats_;
+  Api::ApiPtr api_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  Server::Configuration::GuardDogActionFactoryContext context_;
+  std::unique_ptr<Server::Configuration::GuardDogAction> action_;
+};
+
+TEST_F(BacktraceActionTest, CapturesStackOfStuckThread) {
+  envoy::extensions::watchdog::backtrace_action::v3::BacktraceActionConfig config;
+  config.mutable_wait_duration()->set_seconds(5);
+  action_ = std::make_unique<BacktraceAction>(config, context_);
+
+  runOnStuckThread(1);
+  EXPECT_EQ(stats_.counterFromString("test.backtrace_action.captured").value(), 1);
+  EXPECT_EQ(stats_.counterFromString("test.backtrace_action.timed_out").value(), 0);
+}
+
+TEST_F(BacktraceActionTest, LimitsNumberOfBacktraces) {
+  envoy::extensions::watchdog::backtrace_action::v3::BacktraceActionConfig config;
+  config.mutable_wait_duration()->set_seconds(5);
+  config.set_max_backtraces(2);
+  action_ = std::make_unique<BacktraceAction>(config, context_);
+
+  runOnStuckThread(3);
+  EXPECT_EQ(stats_.counterFromString("test.backtrace_action.captured").value(), 2);
+}
+#endif
+
+} // namespace
+} // namespace BacktraceAction
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
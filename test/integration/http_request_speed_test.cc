@@ -0,0 +1,53 @@
+// Measures the full request path of a server started in-process: a downstream HTTP/1 connection
+// through the HTTP connection manager and router to an autonomous upstream.
+
+#include "test/integration/autonomous_upstream.h"
+#include "test/integration/http_integration.h"
+#include "test/test_common/environment.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+class HttpRequestBenchmark : public HttpIntegrationTest {
+public:
+  explicit HttpRequestBenchmark(Http::CodecType upstream_protocol)
+      : HttpIntegrationTest(Http::CodecType::HTTP1,
+                            TestEnvironment::getIpVersionsForTest().front()) {
+    autonomous_upstream_ = true;
+    setUpstreamProtocol(upstream_protocol);
+  }
+
+  // Sends requests on one downstream connection, one at a time, until the benchmark is done.
+  void run(benchmark::State& state, uint64_t response_size) {
+    initialize();
+    codec_client_ = makeHttpConnection(lookupPort("http"));
+    Http::TestRequestHeaderMapImpl request_headers = default_request_headers_;
+    request_headers.addCopy(AutonomousStream::RESPONSE_SIZE_BYTES, absl::StrCat(response_size));
+
+    for (auto _ : state) { // NOLINT: Silences warning about dead store
+      IntegrationStreamDecoderPtr response = codec_client_->makeHeaderOnlyRequest(request_headers);
+      RELEASE_ASSERT(response->waitForEndStream(), "");
+      RELEASE_ASSERT(response->complete(), "");
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * response_size);
+  }
+};
+
+static void bmHttp1ToHttp1(benchmark::State& state) {
+  HttpRequestBenchmark test(Http::CodecType::HTTP1);
+  test.run(state, state.range(0));
+}
+BENCHMARK(bmHttp1ToHttp1)->Arg(0)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+static void bmHttp1ToHttp2(benchmark::State& state) {
+  HttpRequestBenchmark test(Http::CodecType::HTTP2);
+  test.run(state, state.range(0));
+}
+BENCHMARK(bmHttp1ToHttp2)->Arg(0)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Envoy
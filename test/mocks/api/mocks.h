@@ -141,6 +141,10 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, pipe2, (int pipefd[2], int flags));
+  MOCK_METHOD(SysCallSizeResult, splice,
+              (int fd_in, loff_t* off_in, int fd_out, loff_t* off_out, size_t len,
+               unsigned int flags));
 };
 #endif
 
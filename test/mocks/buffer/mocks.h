@@ -90,6 +90,7 @@ public:
 
   MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, createAccount, (Http::StreamResetHandler&));
   MOCK_METHOD(uint64_t, resetAccountsGivenPressure, (float));
+  void initializeScheduler(Event::CallbackScheduler&) override {}
 };
 
 MATCHER_P(BufferEqual, rhs, testing::PrintToString(*rhs)) {
@@ -0,0 +1,10 @@
+#include "test/mocks/io/mocks.h"
+
+namespace Envoy {
+namespace Io {
+
+MockIoUring::MockIoUring() = default;
+MockIoUring::~MockIoUring() = default;
+
+} // namespace Io
+} // namespace Envoy
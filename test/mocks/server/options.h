@@ -48,6 +48,7 @@ public:
   MOCK_METHOD(bool, mutexTracingEnabled, (), (const));
   MOCK_METHOD(bool, coreDumpEnabled, (), (const));
   MOCK_METHOD(bool, cpusetThreadsEnabled, (), (const));
+  MOCK_METHOD(bool, pinWorkerThreadsEnabled, (), (const));
   MOCK_METHOD(const std::vector<std::string>&, disabledExtensions, (), (const));
   MOCK_METHOD(Server::CommandLineOptionsPtr, toCommandLineOptions, (), (const));
   MOCK_METHOD(const std::string&, socketPath, (), (const));
@@ -75,6 +76,7 @@ public:
   bool mutex_tracing_enabled_{};
   bool core_dump_enabled_{};
   bool cpuset_threads_enabled_{};
+  bool pin_worker_threads_enabled_{};
   std::vector<std::string> disabled_extensions_;
   std::string socket_path_;
   mode_t socket_mode_;
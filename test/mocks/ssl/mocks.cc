@@ -25,7 +25,9 @@ MockClientContextConfig::MockClientContextConfig() {
 }
 MockClientContextConfig::~MockClientContextConfig() = default;
 
-MockServerContextConfig::MockServerContextConfig() = default;
+MockServerContextConfig::MockServerContextConfig() {
+  ON_CALL(*this, dynamicRecordSizing()).WillByDefault(testing::ReturnRef(dynamic_record_sizing_));
+}
 MockServerContextConfig::~MockServerContextConfig() = default;
 
 MockPrivateKeyMethodManager::MockPrivateKeyMethodManager() = default;
@@ -138,11 +138,16 @@ public:
   MOCK_METHOD(OcspStaplePolicy, ocspStaplePolicy, (), (const));
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
+  MOCK_METHOD(SessionCacheSharedPtr, sessionCache, (), (const));
+  MOCK_METHOD(bool, lazyContextInitialization, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
   MOCK_METHOD(bool, fullScanCertsOnSNIMismatch, (), (const));
+  MOCK_METHOD(const absl::optional<DynamicRecordSizing>&, dynamicRecordSizing, (), (const));
+
+  absl::optional<DynamicRecordSizing> dynamic_record_sizing_;
 };
 
 class MockTlsCertificateConfig : public TlsCertificateConfig {
@@ -183,6 +188,8 @@ public:
               trustChainVerification, (), (const));
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
+  MOCK_METHOD(absl::optional<std::chrono::milliseconds>, trustChainVerificationCacheTtl, (),
+              (const));
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -252,6 +252,9 @@ public:
   std::vector<std::reference_wrapper<const ParentHistogram>> histograms_;
   std::vector<std::reference_wrapper<const TextReadout>> text_readouts_;
   SystemTime snapshot_time_;
+  // Keeps the symbol table of the mock metrics alive for sinks that cache their stat names, as
+  // snapshots are usually declared before the sink.
+  TestUtil::TestSymbolTable symbol_table_;
 };
 
 class MockSink : public Sink {
@@ -77,6 +77,15 @@ public:
   MOCK_METHOD(void, setUnhealthy, (UnhealthyType));
 };
 
+class MockHostLbPolicyData : public HostLbPolicyData {
+public:
+  MockHostLbPolicyData();
+  ~MockHostLbPolicyData() override;
+
+  MOCK_METHOD(void, onResponseTime, (std::chrono::microseconds response_time));
+  MOCK_METHOD(void, onLoadReport, (absl::string_view report));
+};
+
 class MockHostDescription : public HostDescription {
 public:
   MockHostDescription();
@@ -103,6 +112,9 @@ public:
   MOCK_METHOD(uint32_t, priority, (), (const));
   MOCK_METHOD(void, priority, (uint32_t));
   MOCK_METHOD(absl::optional<MonotonicTime>, lastHcPassTime, (), (const));
+  MOCK_METHOD(HostLbPolicyData*, lbPolicyData, (), (const));
+  MOCK_METHOD(HostLbPolicyData&, setLbPolicyData, (HostLbPolicyDataPtr && lb_policy_data),
+              (const));
   Stats::StatName localityZoneStatName() const override {
     Stats::SymbolTable& symbol_table = *symbol_table_;
     locality_zone_stat_name_ =
@@ -215,6 +227,9 @@ public:
   MOCK_METHOD(void, priority, (uint32_t));
   MOCK_METHOD(bool, warmed, (), (const));
   MOCK_METHOD(absl::optional<MonotonicTime>, lastHcPassTime, (), (const));
+  MOCK_METHOD(HostLbPolicyData*, lbPolicyData, (), (const));
+  MOCK_METHOD(HostLbPolicyData&, setLbPolicyData, (HostLbPolicyDataPtr && lb_policy_data),
+              (const));
 
   testing::NiceMock<MockClusterInfo> cluster_;
   Network::UpstreamTransportSocketFactoryPtr socket_factory_;
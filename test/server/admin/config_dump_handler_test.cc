@@ -1,3 +1,5 @@
+#include "source/common/common/matchers.h"
+
 #include "test/integration/filters/test_listener_filter.pb.h"
 #include "test/server/admin/admin_instance.h"
 
@@ -858,5 +860,33 @@ TEST_P(AdminInstanceTest, ConfigDumpEcdsByResourceAndMask) {
   EXPECT_EQ(expected_json, output);
 }
 
+TEST_P(AdminInstanceTest, ConfigDumpEmpty) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, getCallback("/config_dump", header_map, response));
+  EXPECT_EQ("{}\n", response.toString());
+}
+
+// The configs are serialized one at a time, which must give the same JSON as printing the whole
+// ConfigDump, including for nested messages and strings which contain newlines.
+TEST_P(AdminInstanceTest, ConfigDumpMatchesJsonOfWholeDump) {
+  envoy::admin::v3::ConfigDump dump;
+  auto ecds_config = admin_.getConfigTracker().add("ecds", testDumpEcdsConfig);
+  dump.add_configs()->PackFrom(*testDumpEcdsConfig(Matchers::UniversalStringMatcher()));
+  auto entry = admin_.getConfigTracker().add("foo", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<ProtobufWkt::StringValue>();
+    msg->set_value("multi\nline \"value\"");
+    return msg;
+  });
+  ProtobufWkt::StringValue value;
+  value.set_value("multi\nline \"value\"");
+  dump.add_configs()->PackFrom(value);
+
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, getCallback("/config_dump", header_map, response));
+  EXPECT_EQ(MessageUtil::getJsonStringFromMessageOrError(dump, true), response.toString());
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -140,6 +140,15 @@ TEST_F(PrometheusStatsFormatterTest, SanitizeMetricNameDigitFirst) {
   EXPECT_EQ(expected, actual.value());
 }
 
+TEST_F(PrometheusStatsFormatterTest, SanitizeMetricNameUtf8) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  std::string raw = "caf\xc3\xa9.served";
+  std::string expected = "envoy_caf__served";
+  auto actual = PrometheusStatsFormatter::metricName(raw, custom_namespaces);
+  EXPECT_TRUE(actual.has_value());
+  EXPECT_EQ(expected, actual.value());
+}
+
 TEST_F(PrometheusStatsFormatterTest, CustomNamespace) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
   custom_namespaces.registerStatNamespace("promstattest");
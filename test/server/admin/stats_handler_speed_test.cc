@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "test/test_common/test_runtime.h"
@@ -36,13 +37,17 @@ public:
   /**
    * Issues an admin request against the stats saved in store_.
    */
-  uint64_t handlerStats(const StatsParams& params) {
+  uint64_t handlerStats(const StatsParams& params,
+                        PrometheusStatsRequest::Format prometheus_format =
+                            PrometheusStatsRequest::Format::Text) {
     Buffer::OwnedImpl data;
+    Admin::RequestPtr request;
     if (params.format_ == Envoy::Server::StatsFormat::Prometheus) {
-      Envoy::Server::StatsHandler::prometheusRender(store_, custom_namespaces_, params, data);
-      return data.length();
+      request = std::make_unique<PrometheusStatsRequest>(store_, params, custom_namespaces_,
+                                                         prometheus_format);
+    } else {
+      request = StatsHandler::makeRequest(store_, params);
     }
-    Admin::RequestPtr request = StatsHandler::makeRequest(store_, params);
     auto response_headers = Http::ResponseHeaderMapImpl::create();
     request->start(*response_headers);
     uint64_t count = 0;
@@ -55,6 +60,15 @@ public:
     return count;
   }
 
+  /**
+   * Renders the stats in prometheus format into a single buffer, without streaming.
+   */
+  uint64_t handlerPrometheusBuffered(const StatsParams& params) {
+    Buffer::OwnedImpl data;
+    StatsHandler::prometheusRender(store_, custom_namespaces_, params, data);
+    return data.length();
+  }
+
   Stats::SymbolTableImpl symbol_table_;
   Stats::AllocatorImpl alloc_;
   Stats::ThreadLocalStoreImpl store_;
@@ -210,6 +224,35 @@ static void BM_AllCountersPrometheus(benchmark::State& state) {
 }
 BENCHMARK(BM_AllCountersPrometheus)->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusBuffered(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus", response);
+
+  for (auto _ : state) { // NOLINT
+    uint64_t count = test_context.handlerPrometheusBuffered(params);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M"); // actual = 261,578,000
+  }
+}
+BENCHMARK(BM_AllCountersPrometheusBuffered)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusProtobuf(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus", response);
+
+  for (auto _ : state) { // NOLINT
+    uint64_t count = test_context.handlerStats(
+        params, Envoy::Server::PrometheusStatsRequest::Format::Protobuf);
+    RELEASE_ASSERT(count > 50 * 1000 * 1000, "expected count > 50M");
+  }
+}
+BENCHMARK(BM_AllCountersPrometheusProtobuf)->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_UsedCountersPrometheus(benchmark::State& state) {
   Envoy::Server::StatsHandlerTest& test_context = testContext();
@@ -225,6 +268,22 @@ static void BM_UsedCountersPrometheus(benchmark::State& state) {
 }
 BENCHMARK(BM_UsedCountersPrometheus)->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UsedCountersPrometheusProtobuf(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&usedonly", response);
+
+  for (auto _ : state) { // NOLINT
+    uint64_t count = test_context.handlerStats(
+        params, Envoy::Server::PrometheusStatsRequest::Format::Protobuf);
+    RELEASE_ASSERT(count > 500 * 1000, "expected count > 500K");
+    RELEASE_ASSERT(count < 3 * 1000 * 1000, "expected count < 3M");
+  }
+}
+BENCHMARK(BM_UsedCountersPrometheusProtobuf)->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FilteredCountersPrometheus(benchmark::State& state) {
   Envoy::Server::StatsHandlerTest& test_context = testContext();
@@ -4,6 +4,7 @@
 #include "source/common/common/regex.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
@@ -15,6 +16,9 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_join.h"
+#include "io/prometheus/client/metrics.pb.h"
+
 using testing::Combine;
 using testing::EndsWith;
 using testing::HasSubstr;
@@ -1387,5 +1391,103 @@ envoy_control_plane_identifier{cluster="c1",text_value="cp-1"} 0
   EXPECT_THAT(expected_response, code_response.second);
 }
 
+class StatsHandlerPrometheusStreamingTest : public StatsHandlerPrometheusTest,
+                                            public testing::Test {};
+
+TEST_F(StatsHandlerPrometheusStreamingTest, StatsHandlerPrometheusChunked) {
+  createTestStats();
+  const std::string expected_response = handlerStats("/stats?format=prometheus").second;
+
+  StatsParams params;
+  Buffer::OwnedImpl response;
+  ASSERT_EQ(Http::Code::OK, params.parse("/stats?format=prometheus", response));
+  PrometheusStatsRequest request(*store_, params, custom_namespaces_);
+  request.setChunkSize(1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+
+  // Each chunk holds a single line, as every line is longer than the chunk size.
+  std::vector<std::string> chunks;
+  Buffer::OwnedImpl data;
+  bool more;
+  do {
+    more = request.nextChunk(data);
+    if (data.length() > 0) {
+      chunks.push_back(data.toString());
+      data.drain(data.length());
+    }
+  } while (more);
+  EXPECT_EQ(6, chunks.size());
+  EXPECT_EQ(expected_response, absl::StrJoin(chunks, ""));
+}
+
+TEST_F(StatsHandlerPrometheusStreamingTest, StatsHandlerPrometheusProtobuf) {
+  createTestStats();
+  Stats::Histogram& histogram = store_->rootScope()->histogramFromString(
+      "cluster.upstream_rq_time", Stats::Histogram::Unit::Milliseconds);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(histogram), 5));
+  histogram.recordValue(5);
+  store_->mergeHistograms([]() -> void {});
+
+  request_headers_.setCopy(Http::CustomHeaders::get().Accept,
+                           "application/vnd.google.protobuf;"
+                           "proto=io.prometheus.client.MetricFamily;encoding=delimited;q=0.7,"
+                           "text/plain;version=0.0.4;q=0.3,*/*;q=0.1");
+  const CodeResponse code_response = handlerStats("/stats/prometheus?text_readouts");
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+
+  std::vector<io::prometheus::client::MetricFamily> families;
+  Protobuf::io::ArrayInputStream stream(code_response.second.data(), code_response.second.size());
+  Protobuf::io::CodedInputStream coded_stream(&stream);
+  uint64_t size;
+  while (coded_stream.ReadVarint64(&size)) {
+    const auto limit = coded_stream.PushLimit(size);
+    families.emplace_back();
+    ASSERT_TRUE(families.back().ParseFromCodedStream(&coded_stream));
+    coded_stream.PopLimit(limit);
+  }
+
+  ASSERT_EQ(4, families.size());
+  EXPECT_EQ("envoy_cluster_upstream_cx_total", families[0].name());
+  EXPECT_EQ(io::prometheus::client::MetricType::COUNTER, families[0].type());
+  ASSERT_EQ(2, families[0].metric_size());
+  EXPECT_EQ("cluster", families[0].metric(0).label(0).name());
+  EXPECT_EQ("c1", families[0].metric(0).label(0).value());
+  EXPECT_EQ(10, families[0].metric(0).counter().value());
+  EXPECT_EQ(20, families[0].metric(1).counter().value());
+
+  EXPECT_EQ("envoy_cluster_upstream_cx_active", families[1].name());
+  EXPECT_EQ(io::prometheus::client::MetricType::GAUGE, families[1].type());
+  ASSERT_EQ(2, families[1].metric_size());
+  EXPECT_EQ(11, families[1].metric(0).gauge().value());
+  EXPECT_EQ(12, families[1].metric(1).gauge().value());
+
+  EXPECT_EQ("envoy_control_plane_identifier", families[2].name());
+  EXPECT_EQ(io::prometheus::client::MetricType::GAUGE, families[2].type());
+  ASSERT_EQ(1, families[2].metric_size());
+  ASSERT_EQ(2, families[2].metric(0).label_size());
+  EXPECT_EQ("text_value", families[2].metric(0).label(1).name());
+  EXPECT_EQ("cp-1", families[2].metric(0).label(1).value());
+
+  EXPECT_EQ("envoy_cluster_upstream_rq_time", families[3].name());
+  EXPECT_EQ(io::prometheus::client::MetricType::HISTOGRAM, families[3].type());
+  ASSERT_EQ(1, families[3].metric_size());
+  EXPECT_EQ(1, families[3].metric(0).histogram().sample_count());
+  EXPECT_FALSE(families[3].metric(0).histogram().bucket().empty());
+}
+
+TEST(PrometheusStatsRequestTest, FormatFromAcceptHeader) {
+  EXPECT_EQ(PrometheusStatsRequest::Format::Text,
+            PrometheusStatsRequest::formatFromAcceptHeader(""));
+  EXPECT_EQ(PrometheusStatsRequest::Format::Text,
+            PrometheusStatsRequest::formatFromAcceptHeader("text/plain;version=0.0.4"));
+  EXPECT_EQ(PrometheusStatsRequest::Format::Text,
+            PrometheusStatsRequest::formatFromAcceptHeader("application/vnd.google.protobuf"));
+  EXPECT_EQ(PrometheusStatsRequest::Format::Protobuf,
+            PrometheusStatsRequest::formatFromAcceptHeader(
+                "application/vnd.google.protobuf;proto=io.prometheus.client.MetricFamily;"
+                "encoding=delimited"));
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -99,7 +99,7 @@ TEST_F(OptionsImplTest, All) {
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
       "--log-path "
       "/foo/bar "
-      "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
+      "--disable-hot-restart --cpuset-threads --pin-worker-threads --allow-unknown-static-fields "
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
@@ -123,6 +123,7 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
   EXPECT_TRUE(options->cpusetThreadsEnabled());
+  EXPECT_TRUE(options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ(5U, options->baseId());
@@ -161,6 +162,7 @@ TEST_F(OptionsImplTest, SetAll) {
   bool hot_restart_disabled = options->hotRestartDisabled();
   bool signal_handling_enabled = options->signalHandlingEnabled();
   bool cpuset_threads_enabled = options->cpusetThreadsEnabled();
+  bool pin_worker_threads_enabled = options->pinWorkerThreadsEnabled();
 
   options->setBaseId(109876);
   options->setUseDynamicBaseId(true);
@@ -188,6 +190,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setHotRestartDisabled(!options->hotRestartDisabled());
   options->setSignalHandling(!options->signalHandlingEnabled());
   options->setCpusetThreads(!options->cpusetThreadsEnabled());
+  options->setPinWorkerThreads(!options->pinWorkerThreadsEnabled());
   options->setAllowUnknownFields(true);
   options->setRejectUnknownFieldsDynamic(true);
   options->setSocketPath("/foo/envoy_domain_socket");
@@ -220,6 +223,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(!hot_restart_disabled, options->hotRestartDisabled());
   EXPECT_EQ(!signal_handling_enabled, options->signalHandlingEnabled());
   EXPECT_EQ(!cpuset_threads_enabled, options->cpusetThreadsEnabled());
+  EXPECT_EQ(!pin_worker_threads_enabled, options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
@@ -254,6 +258,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->coreDumpEnabled(), command_line_options->enable_core_dump());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());
+  EXPECT_EQ(options->pinWorkerThreadsEnabled(), command_line_options->pin_worker_threads());
   EXPECT_EQ(options->socketPath(), command_line_options->socket_path());
   EXPECT_EQ(options->socketMode(), command_line_options->socket_mode());
   EXPECT_EQ(1U, command_line_options->stats_tag().size());
@@ -274,6 +279,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_FALSE(options->pinWorkerThreadsEnabled());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -288,6 +294,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0, command_line_options->socket_mode());
   EXPECT_FALSE(command_line_options->disable_hot_restart());
   EXPECT_FALSE(command_line_options->cpuset_threads());
+  EXPECT_FALSE(command_line_options->pin_worker_threads());
   EXPECT_FALSE(command_line_options->allow_unknown_static_fields());
   EXPECT_FALSE(command_line_options->reject_unknown_dynamic_fields());
   EXPECT_EQ(0, options->statsTags().size());
@@ -306,6 +313,7 @@ TEST_F(OptionsImplTest, DefaultParamsNoConstructorArgs) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_FALSE(options->pinWorkerThreadsEnabled());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -320,6 +328,7 @@ TEST_F(OptionsImplTest, DefaultParamsNoConstructorArgs) {
   EXPECT_EQ(0, command_line_options->socket_mode());
   EXPECT_FALSE(command_line_options->disable_hot_restart());
   EXPECT_FALSE(command_line_options->cpuset_threads());
+  EXPECT_FALSE(command_line_options->pin_worker_threads());
   EXPECT_FALSE(command_line_options->allow_unknown_static_fields());
   EXPECT_FALSE(command_line_options->reject_unknown_dynamic_fields());
   EXPECT_EQ(0, options->statsTags().size());
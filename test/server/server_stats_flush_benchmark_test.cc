@@ -1,10 +1,13 @@
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
 
+#include "source/common/event/libevent.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/common/thread_local/thread_local_impl.h"
 #include "source/server/server.h"
 
 #include "test/benchmark/main.h"
@@ -76,7 +79,8 @@ public:
       UNREFERENCED_PARAMETER(_);
       std::list<Stats::SinkPtr> sinks;
       sinks.emplace_back(new testing::NiceMock<Stats::MockSink>());
-      Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, time_system_);
+      Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, time_system_,
+                                                flushed_gauge_values_);
     }
   }
 
@@ -86,8 +90,75 @@ private:
   Stats::AllocatorImpl stats_allocator_;
   Stats::ThreadLocalStoreImpl stats_store_;
   Event::SimulatedTimeSystem time_system_;
+  Server::FlushedGaugeValues flushed_gauge_values_;
 };
 
+// Measures the main thread merge of histograms when only some of them recorded values during the
+// flush interval, as is typical for large configurations.
+class HistogramMergeSpeedTest {
+public:
+  HistogramMergeSpeedTest(size_t num_histograms, size_t num_used)
+      : pool_(symbol_table_), stats_allocator_(symbol_table_), stats_store_(stats_allocator_),
+        api_(Api::createApiForTest(stats_store_, time_system_)), num_used_(num_used) {
+    if (!Event::Libevent::Global::initialized()) {
+      Event::Libevent::Global::initialize();
+    }
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+    tls_.registerThread(*dispatcher_, true);
+    stats_store_.initializeThreading(*dispatcher_, tls_);
+
+    for (uint64_t idx = 0; idx < num_histograms; ++idx) {
+      auto stat_name = pool_.add(absl::StrCat("histogram.", idx));
+      histograms_.push_back(&stats_store_.rootScope()->histogramFromStatName(
+          stat_name, Stats::Histogram::Unit::Unspecified));
+    }
+  }
+
+  ~HistogramMergeSpeedTest() {
+    tls_.shutdownGlobalThreading();
+    stats_store_.shutdownThreading();
+    tls_.shutdownThread();
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+
+  void test(::benchmark::State& state) {
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      for (size_t idx = 0; idx < num_used_; ++idx) {
+        histograms_[idx]->recordValue(idx);
+      }
+      bool merged = false;
+      stats_store_.mergeHistograms([&merged]() { merged = true; });
+      while (!merged) {
+        dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+      }
+    }
+  }
+
+private:
+  Stats::SymbolTableImpl symbol_table_;
+  Stats::StatNamePool pool_;
+  Stats::AllocatorImpl stats_allocator_;
+  Stats::ThreadLocalStoreImpl stats_store_;
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  ThreadLocal::InstanceImpl tls_;
+  std::vector<Stats::Histogram*> histograms_;
+  const size_t num_used_;
+};
+
+static void bmMergeHistograms(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  HistogramMergeSpeedTest speed_test(state.range(0), state.range(0) * state.range(1) / 100);
+  speed_test.test(state);
+}
+
 static void bmFlushToSinks(::benchmark::State& state) {
   // Skip expensive benchmarks for unit tests.
   if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
@@ -115,5 +186,12 @@ BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+// Arguments are the number of histograms and the percentage of them that recorded values.
+BENCHMARK(bmMergeHistograms)
+    ->Unit(::benchmark::kMillisecond)
+    ->Args({100, 100})
+    ->Args({150000, 1})
+    ->Args({150000, 10})
+    ->Args({150000, 100});
 
 } // namespace Envoy
@@ -64,8 +64,9 @@ TEST(ServerInstanceUtil, flushHelper) {
   store.histogram("histogram", Stats::Histogram::Unit::Unspecified);
   store.textReadout("text").set("is important");
 
+  FlushedGaugeValues flushed_gauge_values;
   std::list<Stats::SinkPtr> sinks;
-  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, flushed_gauge_values);
   // Make sure that counters have been latched even if there are no sinks.
   EXPECT_EQ(1UL, c.value());
   EXPECT_EQ(0, c.latch());
@@ -86,7 +87,7 @@ TEST(ServerInstanceUtil, flushHelper) {
     EXPECT_EQ(snapshot.textReadouts()[0].get().value(), "is important");
   }));
   c.inc();
-  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, flushed_gauge_values);
 
   // Histograms don't currently work with the isolated store so test those with a mock store.
   NiceMock<Stats::MockStore> mock_store;
@@ -108,7 +109,71 @@ TEST(ServerInstanceUtil, flushHelper) {
     EXPECT_EQ(snapshot.histograms().size(), 1);
     EXPECT_TRUE(snapshot.textReadouts().empty());
   }));
-  InstanceUtil::flushMetricsToSinks(sinks, mock_store, time_system);
+  InstanceUtil::flushMetricsToSinks(sinks, mock_store, time_system, flushed_gauge_values);
+}
+
+class DeltaSnapshotSink : public Stats::MockSink {
+public:
+  bool deltaSnapshots() const override { return true; }
+};
+
+TEST(ServerInstanceUtil, flushDeltaSnapshots) {
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& c1 = store.counter("c1");
+  Stats::Counter& c2 = store.counter("c2");
+  Stats::Gauge& g1 = store.gauge("g1", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& g2 = store.gauge("g2", Stats::Gauge::ImportMode::Accumulate);
+  store.gauge("unused", Stats::Gauge::ImportMode::Accumulate);
+  store.textReadout("text").set("is important");
+  c1.inc();
+  c2.inc();
+  g1.set(1);
+  g2.set(2);
+
+  FlushedGaugeValues flushed_gauge_values;
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* full_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(full_sink);
+  DeltaSnapshotSink* delta_sink = new StrictMock<DeltaSnapshotSink>();
+  sinks.emplace_back(delta_sink);
+
+  // Everything that is used is new on the first flush.
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 3);
+  }));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, flushed_gauge_values);
+
+  c2.inc();
+  g1.set(1);
+  g2.set(3);
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 3);
+  }));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "c2");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "g2");
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 3);
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, flushed_gauge_values);
+
+  EXPECT_CALL(*full_sink, flush(_));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, flushed_gauge_values);
 }
 
 class RunHelperTest : public testing::Test {
@@ -4,23 +4,27 @@
 #include "source/common/event/dispatcher_impl.h"
 #include "source/server/worker_impl.h"
 
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/server/guard_dog.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/overload_manager.h"
 #include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::DoAll;
 using testing::InSequence;
 using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::NiceMock;
 using testing::Return;
+using testing::SetArgPointee;
 using testing::Throw;
 
 namespace Envoy {
@@ -36,7 +40,7 @@ public:
         no_exit_timer_(dispatcher_->createTimer([]() -> void {})),
         stat_names_(api_->rootScope().symbolTable()),
         worker_(tls_, hooks_, std::move(dispatcher_), Network::ConnectionHandlerPtr{handler_},
-                overload_manager_, *api_, stat_names_) {
+                overload_manager_, *api_, stat_names_, absl::nullopt) {
     // In the real worker the watchdog has timers that prevent exit. Here we need to prevent event
     // loop exit since we use mock timers.
     no_exit_timer_->enableTimer(std::chrono::hours(1));
@@ -159,6 +163,56 @@ TEST_F(WorkerImplTest, WorkerInvokesProvidedCallback) {
   worker_.stop();
 }
 
+TEST(ProdWorkerFactoryTest, UnpinnedWorkers) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<ThreadLocal::MockInstance> tls;
+  DefaultListenerHooks hooks;
+  ProdWorkerFactory factory(tls, *api, hooks, false);
+  EXPECT_EQ(absl::nullopt, factory.workerCpu(0));
+  EXPECT_EQ(absl::nullopt, factory.workerCpu(3));
+}
+
+#if defined(__linux__)
+// Workers are pinned to the CPUs of the affinity mask, e.g. the CPUs of the NUMA node the process
+// was bound to, rather than to the CPUs numbered after the worker index.
+TEST(ProdWorkerFactoryTest, PinnedWorkersFollowAffinityMask) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  cpu_set_t test_set;
+  CPU_ZERO(&test_set);
+  CPU_SET(4, &test_set);
+  CPU_SET(5, &test_set);
+  CPU_SET(7, &test_set);
+  EXPECT_CALL(linux_os_sys_calls, sched_getaffinity(_, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(test_set), Return(Api::SysCallIntResult{0, 0})));
+
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<ThreadLocal::MockInstance> tls;
+  DefaultListenerHooks hooks;
+  ProdWorkerFactory factory(tls, *api, hooks, true);
+  EXPECT_EQ(4U, factory.workerCpu(0));
+  EXPECT_EQ(5U, factory.workerCpu(1));
+  EXPECT_EQ(7U, factory.workerCpu(2));
+  // More workers than CPUs wrap around.
+  EXPECT_EQ(4U, factory.workerCpu(3));
+}
+
+// Without an affinity mask worker N is pinned to CPU N.
+TEST(ProdWorkerFactoryTest, PinnedWorkersWithoutAffinityMask) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, sched_getaffinity(_, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, 0}));
+
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<ThreadLocal::MockInstance> tls;
+  DefaultListenerHooks hooks;
+  ProdWorkerFactory factory(tls, *api, hooks, true);
+  EXPECT_EQ(0U, factory.workerCpu(0));
+  EXPECT_EQ(3U, factory.workerCpu(3));
+}
+#endif
+
 } // namespace
 } // namespace Server
 } // namespace Envoy